@@ -18,6 +18,8 @@ namespace NR
         private Action<Entity> _triggerBeginCallbacks;
         private Action<Entity> _triggerEndCallbacks;
 
+        private Action<ContactEvent[]> _contactEventsCallbacks;
+
         private Action<Vector3, Vector3> _jointBreakCallbacks;
 
         private List<IEnumerator> coroutines = new List<IEnumerator>(); 
@@ -43,7 +45,7 @@ namespace NR
 
         public Entity Instantiate(Prefab prefab)
         {
-            ulong entityID = Instantiate_Native(prefab.ID);
+            ulong entityID = Instantiate_Native(ID, prefab.ID);
             if (entityID == 0)
             {
                 return null;
@@ -54,7 +56,7 @@ namespace NR
 
         public Entity Instantiate(Prefab prefab, Vector3 translation)
         {
-            ulong entityID = InstantiateWithTranslation_Native(ID, prefab.ID, ref translation);
+            ulong entityID = InstantiateWithPosition_Native(ID, prefab.ID, ref translation);
             if (entityID == 0)
             {
                 return null;
@@ -65,7 +67,7 @@ namespace NR
 
         public Entity Instantiate(Prefab prefab, Transform transform)
         {
-            ulong entityID = InstantiateWithTransform_Native(ID, prefab.ID, ref transform);
+            ulong entityID = InstantiateWithTransform_Native(ID, prefab.ID, ref transform.Position, ref transform.Rotation, ref transform.Scale);
             if (entityID == 0)
             {
                 return null;
@@ -253,16 +255,38 @@ namespace NR
             _triggerEndCallbacks += callback;
         }
 
-        public void AddJointBreakCallback(Action<Vector3, Vector3> callback) => _jointBreakCallbacks += callback;
-
-        private void CollisionBegin(ulong id)
+        // Receives every collision and trigger event of a physics step at once, after the individual callbacks
+        public void AddContactEventsCallback(Action<ContactEvent[]> callback)
         {
-            _collisionBeginCallbacks?.Invoke(new Entity(id));
+            _contactEventsCallbacks += callback;
         }
 
-        private void CollisionEnd(ulong id)
+        public void AddJointBreakCallback(Action<Vector3, Vector3> callback) => _jointBreakCallbacks += callback;
+
+        private void ContactEvents(ulong[] ids, int[] types)
         {
-            _collisionEndCallbacks?.Invoke(new Entity(id));
+            ContactEvent[] events = _contactEventsCallbacks != null ? new ContactEvent[ids.Length] : null;
+
+            for (int i = 0; i < ids.Length; i++)
+            {
+                Entity other = new Entity(ids[i]);
+                ContactEventType type = (ContactEventType)types[i];
+
+                switch (type)
+                {
+                    case ContactEventType.CollisionBegin: _collisionBeginCallbacks?.Invoke(other); break;
+                    case ContactEventType.CollisionEnd: _collisionEndCallbacks?.Invoke(other); break;
+                    case ContactEventType.TriggerBegin: _triggerBeginCallbacks?.Invoke(other); break;
+                    case ContactEventType.TriggerEnd: _triggerEndCallbacks?.Invoke(other); break;
+                }
+
+                if (events != null)
+                {
+                    events[i] = new ContactEvent { Type = type, Other = other };
+                }
+            }
+
+            _contactEventsCallbacks?.Invoke(events);
         }
 
         private void Collision2DBegin(ulong id)
@@ -275,16 +299,6 @@ namespace NR
             _collision2DEndCallbacks?.Invoke(new Entity(id));
         }
 
-        private void TriggerBegin(ulong id)
-        {
-            _triggerBeginCallbacks?.Invoke(new Entity(id));
-        }
-
-        private void TriggerEnd(ulong id)
-        {
-            _triggerEndCallbacks?.Invoke(new Entity(id));
-        }
-
         private void OnJointBreak(Vector3 linearForce, Vector3 angularForce)
         {
             _jointBreakCallbacks?.Invoke(linearForce, angularForce);
@@ -367,7 +381,7 @@ namespace NR
         private static extern ulong CreateEntity_Native();
         private static extern ulong Instantiate_Native(ulong entityID, ulong prefabID);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        private static extern ulong InstantiateWithTranslation_Native(ulong entityID, ulong prefabID, ref Vector3 translation);
+        private static extern ulong InstantiateWithPosition_Native(ulong entityID, ulong prefabID, ref Vector3 translation);
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern ulong InstantiateWithTransform_Native(ulong entityID, ulong prefabID, ref Vector3 translation, ref Vector3 rotation, ref Vector3 scale);
         [MethodImpl(MethodImplOptions.InternalCall)]
@@ -35,6 +35,19 @@ namespace NR
                 return _rigidBodyComponent;
             }
         }
+
+        // Colliders returned by the NonAlloc overlap queries are pooled by the engine and reset with the results of a later query
+        protected void ResetCollider(ulong entityID, bool isTrigger)
+        {
+            if (EntityID != entityID)
+            {
+                entity = null;
+                _rigidBodyComponent = null;
+            }
+
+            EntityID = entityID;
+            IsTrigger = isTrigger;
+        }
     }
 
     public class BoxCollider : Collider
@@ -44,10 +57,14 @@ namespace NR
         
 		internal BoxCollider(ulong entityID, Vector3 size, Vector3 offset, bool isTrigger)
         {
-            EntityID = entityID;
+            Reset(entityID, size, offset, isTrigger);
+        }
+
+        internal void Reset(ulong entityID, Vector3 size, Vector3 offset, bool isTrigger)
+        {
+            ResetCollider(entityID, isTrigger);
             Size = size;
             Offset = offset;
-            IsTrigger = isTrigger;
         }
     }
 
@@ -57,9 +74,13 @@ namespace NR
 
         internal SphereCollider(ulong entityID, float radius, bool isTrigger)
         {
-            EntityID = entityID;
+            Reset(entityID, radius, isTrigger);
+        }
+
+        internal void Reset(ulong entityID, float radius, bool isTrigger)
+        {
+            ResetCollider(entityID, isTrigger);
             Radius = radius;
-            IsTrigger = isTrigger;
         }
     }
 
@@ -70,10 +91,14 @@ namespace NR
 
         internal CapsuleCollider(ulong entityID, float radius, float height, bool isTrigger)
         {
-            EntityID = entityID;
+            Reset(entityID, radius, height, isTrigger);
+        }
+
+        internal void Reset(ulong entityID, float radius, float height, bool isTrigger)
+        {
+            ResetCollider(entityID, isTrigger);
             Radius = radius;
             Height = height;
-            IsTrigger = isTrigger;
         }
     }
 
@@ -83,8 +108,12 @@ namespace NR
 
         internal MeshCollider(ulong entityID, bool isTrigger, IntPtr mesh, bool isStatic)
         {
-            EntityID = entityID;
-            IsTrigger = isTrigger;
+            Reset(entityID, isTrigger, mesh, isStatic);
+        }
+
+        internal void Reset(ulong entityID, bool isTrigger, IntPtr mesh, bool isStatic)
+        {
+            ResetCollider(entityID, isTrigger);
             Mesh = new Mesh(mesh, isStatic);
         }
     }
@@ -32,16 +32,30 @@ namespace NR
     }
 
     public class RaycastHit2D
-
     {
-        public Entity Entity { get; internal set; }
-        public Vector2 Position { get; internal set; }
-        public Vector2 Normal { get; internal set; }
-        public float Distance { get; internal set; }
+        public ulong EntityID { get; private set; }
+        public Vector2 Position { get; private set; }
+        public Vector2 Normal { get; private set; }
+        public float Distance { get; private set; }
+
+        private Entity entity;
+
+        public Entity Entity
+        {
+            get
+            {
+                if (entity == null)
+                {
+                    entity = new Entity(EntityID);
+                }
+
+                return entity;
+            }
+        }
 
-        RaycastHit2D(Entity entity, Vector2 position, Vector2 normal, float distance)
+        internal RaycastHit2D(ulong entityID, Vector2 position, Vector2 normal, float distance)
         {
-            Entity = entity;
+            EntityID = entityID;
             Position = position;
             Normal = normal;
             Distance = distance;
@@ -72,6 +86,21 @@ namespace NR
 
     public enum EFalloffMode { Constant, Linear }
 
+    // Has to match NR::ContactType
+    public enum ContactEventType
+    {
+        CollisionBegin,
+        CollisionEnd,
+        TriggerBegin,
+        TriggerEnd
+    }
+
+    public struct ContactEvent
+    {
+        public ContactEventType Type { get; internal set; }
+        public Entity Other { get; internal set; }
+    }
+
     public static class Physics
     {
         public static Vector3 Gravity
@@ -125,6 +154,8 @@ namespace NR
             return OverlapCapsule_Native(ref origin, radius, halfHeight);
         }
 
+        // The colliders the NonAlloc queries write into the array are owned by the engine and reused by
+        // NonAlloc queries in later frames. Copy out what has to be kept for longer than a frame.
         public static int OverlapBoxNonAlloc(Vector3 origin, Vector3 halfSize, Collider[] colliders)
         {
             return OverlapBoxNonAlloc_Native(ref origin, ref halfSize, colliders);
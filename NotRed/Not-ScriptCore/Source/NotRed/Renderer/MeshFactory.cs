@@ -39,7 +39,7 @@ namespace NR
             return new Mesh(CreateCustomMesh_Native(
                 verticesList.ToArray(), vertexOffsets, 
                 indicesList.ToArray(), indexOffsets, 
-                materialNames)
+                materialNames), true
                 );
         }
 
@@ -0,0 +1,75 @@
+﻿using System.Runtime.CompilerServices;
+
+namespace NR
+{
+    // Transforms of a set of entities, read and written with one internal call for the whole set.
+    // Read() fills Transforms, Commit() writes them back. Entities that don't exist are skipped.
+    public sealed class TransformView
+    {
+        public ulong[] EntityIDs { get; }
+        public Transform[] Transforms { get; }
+
+        public int Count => EntityIDs.Length;
+
+        public TransformView(ulong[] entityIDs)
+        {
+            EntityIDs = entityIDs;
+            Transforms = new Transform[entityIDs.Length];
+        }
+
+        public TransformView(Entity[] entities)
+            : this(GetIDs(entities))
+        {
+        }
+
+        // Returns the number of entities that were found
+        public int Read() => Read_Native(EntityIDs, Transforms);
+        public int Commit() => Commit_Native(EntityIDs, Transforms);
+
+        internal static ulong[] GetIDs(Entity[] entities)
+        {
+            ulong[] ids = new ulong[entities.Length];
+            for (int i = 0; i < entities.Length; i++)
+                ids[i] = entities[i].ID;
+
+            return ids;
+        }
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern int Read_Native(ulong[] entityIDs, Transform[] outTransforms);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern int Commit_Native(ulong[] entityIDs, Transform[] inTransforms);
+    }
+
+    // Velocities of the dynamic rigid bodies of a set of entities, read and written with one internal call for the whole set.
+    // Entities without a body, or with a static or kinematic one, are skipped.
+    public sealed class RigidBodyView
+    {
+        public ulong[] EntityIDs { get; }
+        public Vector3[] LinearVelocities { get; }
+        public Vector3[] AngularVelocities { get; }
+
+        public int Count => EntityIDs.Length;
+
+        public RigidBodyView(ulong[] entityIDs)
+        {
+            EntityIDs = entityIDs;
+            LinearVelocities = new Vector3[entityIDs.Length];
+            AngularVelocities = new Vector3[entityIDs.Length];
+        }
+
+        public RigidBodyView(Entity[] entities)
+            : this(TransformView.GetIDs(entities))
+        {
+        }
+
+        // Returns the number of bodies that were found
+        public int Read() => Read_Native(EntityIDs, LinearVelocities, AngularVelocities);
+        public int Commit() => Commit_Native(EntityIDs, LinearVelocities, AngularVelocities);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern int Read_Native(ulong[] entityIDs, Vector3[] outLinearVelocities, Vector3[] outAngularVelocities);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern int Commit_Native(ulong[] entityIDs, Vector3[] inLinearVelocities, Vector3[] inAngularVelocities);
+    }
+}
@@ -6,5 +6,14 @@ namespace NR
     {
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern Entity[] GetEntities();
+
+        // Mesh entities whose bounds overlap the box, as of the last rendered frame
+        public static Entity[] GetEntitiesInBox(Vector3 min, Vector3 max)
+        {
+            return GetEntitiesInBox_Native(ref min, ref max);
+        }
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern Entity[] GetEntitiesInBox_Native(ref Vector3 min, ref Vector3 max);
     }
 }
\ No newline at end of file
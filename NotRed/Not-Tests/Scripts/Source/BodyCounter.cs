@@ -0,0 +1,17 @@
+using NR;
+
+namespace Tests
+{
+    // Reads and commits the velocities of every other entity of the scene through a RigidBodyView.
+    // Its own translation holds the number of bodies Read() and Commit() found.
+    public class BodyCounter : Entity
+    {
+        public void Update(float dt)
+        {
+            RigidBodyView view = new RigidBodyView(BulkMover.GetOtherEntityIDs(this));
+            int read = view.Read();
+            int committed = view.Commit();
+            Translation = new Vector3(read, committed, 0.0f);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+using System.Collections.Generic;
+using NR;
+
+namespace Tests
+{
+    // Moves every other entity of the scene along x by Speed units per second, through a TransformView made on its first update.
+    // An ID that belongs to no entity goes along with them. The tests read what Read() and Commit() returned from its own translation.
+    public class BulkMover : Entity
+    {
+        public float Speed = 1.0f;
+
+        private TransformView _view;
+
+        public void Update(float dt)
+        {
+            if (_view == null)
+                _view = new TransformView(GetOtherEntityIDs(this));
+
+            int read = _view.Read();
+            for (int i = 0; i < _view.Count; i++)
+                _view.Transforms[i].Position.x += Speed * dt;
+
+            int committed = _view.Commit();
+            Translation = new Vector3(read, committed, 0.0f);
+        }
+
+        // The IDs of every entity but the given one, followed by one that no entity has
+        public static ulong[] GetOtherEntityIDs(Entity self)
+        {
+            List<ulong> ids = new List<ulong>();
+            foreach (Entity entity in Scene.GetEntities())
+            {
+                if (entity.ID != self.ID)
+                    ids.Add(entity.ID);
+            }
+
+            ids.Add(0);
+            return ids.ToArray();
+        }
+    }
+}
@@ -0,0 +1,14 @@
+using NR;
+
+namespace Tests
+{
+    // Jumps to whatever it collides with, and back to the origin when the collision ends
+    public class Follower : Entity
+    {
+        public void Init()
+        {
+            AddCollision2DBeginCallback(other => Translation = other.Translation);
+            AddCollision2DEndCallback(other => Translation = Vector3.Zero);
+        }
+    }
+}
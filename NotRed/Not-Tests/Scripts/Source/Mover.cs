@@ -0,0 +1,15 @@
+using NR;
+
+namespace Tests
+{
+    // Moves along x by Speed units per second, the tests read the translation back to see what dt the script got
+    public class Mover : Entity
+    {
+        public float Speed = 1.0f;
+
+        public void Update(float dt)
+        {
+            Translation += new Vector3(Speed * dt, 0.0f, 0.0f);
+        }
+    }
+}
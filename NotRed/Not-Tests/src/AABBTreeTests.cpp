@@ -0,0 +1,213 @@
+#include "Test.h"
+
+#include <algorithm>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Math/AABBTree.h"
+
+// The linear versions are what the scene queries did before the tree, every mesh bounds tested one by one
+
+using namespace NR;
+
+namespace
+{
+	// Meshes scattered over a square of the given size, most of them a few units across like props
+	std::vector<AABB> CreateMeshBounds(uint32_t count, float worldSize, uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> position(-worldSize * 0.5f, worldSize * 0.5f);
+		std::uniform_real_distribution<float> size(0.5f, 4.0f);
+
+		std::vector<AABB> bounds(count);
+		for (AABB& aabb : bounds)
+		{
+			const glm::vec3 center = { position(random), size(random) * 0.5f, position(random) };
+			const glm::vec3 extents = glm::vec3(size(random), size(random), size(random)) * 0.5f;
+			aabb = AABB(center - extents, center + extents);
+		}
+		return bounds;
+	}
+
+	Frustum CreateCameraFrustum(const glm::vec3& position, const glm::vec3& target)
+	{
+		const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+		return Frustum(projection * glm::lookAt(position, target, glm::vec3(0.0f, 1.0f, 0.0f)));
+	}
+
+	bool Overlaps(const AABB& a, const AABB& b)
+	{
+		return glm::all(glm::lessThanEqual(a.Min, b.Max)) && glm::all(glm::greaterThanEqual(a.Max, b.Min));
+	}
+
+	AABB Moved(const AABB& aabb, const glm::vec3& offset)
+	{
+		return AABB(aabb.Min + offset, aabb.Max + offset);
+	}
+
+	std::vector<uint32_t> QueryTree(const AABBTree& tree, const Frustum& frustum)
+	{
+		std::vector<uint32_t> result;
+		tree.Query(frustum, [&result](uint32_t userData) { result.push_back(userData); return true; });
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+}
+
+NR_TEST(AABBTree, QueriesFindEveryOverlappingProxy)
+{
+	const std::vector<AABB> bounds = CreateMeshBounds(2000, 200.0f, 1);
+
+	AABBTree tree;
+	std::vector<int32_t> proxies;
+	for (uint32_t i = 0; i < (uint32_t)bounds.size(); ++i)
+	{
+		proxies.push_back(tree.CreateProxy(bounds[i], i));
+	}
+	NR_CHECK(tree.GetProxyCount() == 2000);
+	NR_CHECK(tree.GetHeight() < 32);
+
+	// The tree tests the fattened bounds, so it may report a few more proxies than the tight ones, but never fewer
+	const Frustum frustum = CreateCameraFrustum({ 0.0f, 10.0f, -50.0f }, { 0.0f, 0.0f, 0.0f });
+	const std::vector<uint32_t> visible = QueryTree(tree, frustum);
+	bool foundEveryVisible = true;
+	for (uint32_t i = 0; i < (uint32_t)bounds.size(); ++i)
+	{
+		if (frustum.IntersectsAABB(bounds[i]))
+		{
+			foundEveryVisible &= std::binary_search(visible.begin(), visible.end(), i);
+		}
+	}
+	NR_CHECK(foundEveryVisible);
+	NR_CHECK(visible.size() < bounds.size());
+
+	// Moving within the margin keeps the proxy where it is, moving further reinserts it
+	NR_CHECK(!tree.MoveProxy(proxies[0], Moved(bounds[0], glm::vec3(0.05f))));
+	const AABB farAway(glm::vec3(1000.0f), glm::vec3(1002.0f));
+	NR_CHECK(tree.MoveProxy(proxies[0], farAway));
+
+	std::vector<uint32_t> found;
+	tree.Query(AABB(glm::vec3(995.0f), glm::vec3(1005.0f)), [&found](uint32_t userData) { found.push_back(userData); return true; });
+	NR_CHECK((found == std::vector<uint32_t>{ 0 }));
+
+	uint32_t hit = 0xffffffff;
+	tree.Raycast(Ray(glm::vec3(1001.0f, 1001.0f, 900.0f), glm::vec3(0.0f, 0.0f, 1.0f)), [&hit](uint32_t userData, float) { hit = userData; return false; });
+	NR_CHECK(hit == 0);
+
+	for (int32_t proxy : proxies)
+	{
+		tree.DestroyProxy(proxy);
+	}
+	NR_CHECK(tree.GetProxyCount() == 0);
+	NR_CHECK(tree.GetHeight() == 0);
+}
+
+NR_BENCHMARK(AABBTree, InsertRefitAndQuery)
+{
+	for (uint32_t meshCount : { 1000u, 10000u })
+	{
+		const std::string count = std::to_string(meshCount) + " meshes";
+		const std::vector<AABB> bounds = CreateMeshBounds(meshCount, 1000.0f, meshCount);
+
+		AABBTree tree;
+		std::vector<int32_t> proxies(meshCount);
+		Test::Measure(count + ", insert all", 1, [&](uint64_t)
+			{
+				for (uint32_t i = 0; i < meshCount; ++i)
+				{
+					proxies[i] = tree.CreateProxy(bounds[i], i);
+				}
+			});
+
+		// What the scene update does every frame, every mesh is moved to its current bounds
+		constexpr uint64_t Frames = 100;
+		Test::Measure(count + ", refit with nothing moving", Frames, [&](uint64_t)
+			{
+				for (uint32_t i = 0; i < meshCount; ++i)
+				{
+					tree.MoveProxy(proxies[i], bounds[i]);
+				}
+			});
+
+		// One mesh in ten moves far enough each frame to leave its fattened bounds
+		Test::Measure(count + ", refit with 10% moving", Frames, [&](uint64_t frame)
+			{
+				const glm::vec3 offset = glm::vec3((frame % 2) * 0.5f, 0.0f, 0.0f);
+				for (uint32_t i = 0; i < meshCount; ++i)
+				{
+					tree.MoveProxy(proxies[i], i % 10 == 0 ? Moved(bounds[i], offset) : bounds[i]);
+				}
+			});
+
+		constexpr uint64_t Queries = 1000;
+		const Frustum frustum = CreateCameraFrustum({ 0.0f, 20.0f, -400.0f }, { 0.0f, 0.0f, -300.0f });
+		uint32_t visible = 0;
+		Test::Measure(count + ", frustum query, linear", Queries, [&](uint64_t)
+			{
+				visible = 0;
+				for (const AABB& aabb : bounds)
+				{
+					visible += frustum.IntersectsAABB(aabb) ? 1 : 0;
+				}
+			});
+		Test::DoNotOptimize(visible);
+
+		Test::Measure(count + ", frustum query, tree", Queries, [&](uint64_t)
+			{
+				visible = 0;
+				tree.Query(frustum, [&visible](uint32_t) { ++visible; return true; });
+			});
+		Test::DoNotOptimize(visible);
+
+		// Small boxes such as trigger volumes or explosion radii
+		const std::vector<AABB> regions = CreateMeshBounds((uint32_t)Queries, 1000.0f, 7);
+		uint32_t overlapping = 0;
+		Test::Measure(count + ", box query, linear", Queries, [&](uint64_t i)
+			{
+				for (const AABB& aabb : bounds)
+				{
+					overlapping += Overlaps(aabb, regions[i]) ? 1 : 0;
+				}
+			});
+		Test::DoNotOptimize(overlapping);
+
+		Test::Measure(count + ", box query, tree", Queries, [&](uint64_t i)
+			{
+				tree.Query(regions[i], [&overlapping](uint32_t) { ++overlapping; return true; });
+			});
+		Test::DoNotOptimize(overlapping);
+
+		// Picking, closest mesh bounds along a ray through the scene
+		std::mt19937 random(11);
+		std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+		std::vector<Ray> rays;
+		for (uint64_t i = 0; i < Queries; ++i)
+		{
+			rays.emplace_back(glm::vec3(position(random), 1.0f, -600.0f), glm::normalize(glm::vec3(position(random) * 0.001f, 0.0f, 1.0f)));
+		}
+
+		float closest = 0.0f;
+		Test::Measure(count + ", raycast, linear", Queries, [&](uint64_t i)
+			{
+				closest = FLT_MAX;
+				for (const AABB& aabb : bounds)
+				{
+					float t;
+					if (rays[i].IntersectsAABB(aabb, t) && t < closest)
+					{
+						closest = t;
+					}
+				}
+			});
+		Test::DoNotOptimize(closest);
+
+		Test::Measure(count + ", raycast, tree", Queries, [&](uint64_t i)
+			{
+				closest = FLT_MAX;
+				tree.Raycast(rays[i], [&closest](uint32_t, float t) { closest = glm::min(closest, t); return true; });
+			});
+		Test::DoNotOptimize(closest);
+	}
+}
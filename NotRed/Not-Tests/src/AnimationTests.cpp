@@ -0,0 +1,269 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <unordered_set>
+#include <vector>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Core/JobSystem.h"
+#include "NotRed/Renderer/Animation.h"
+#include "NotRed/Scene/Components.h"
+
+// Plays the stormtrooper clips of the sandbox project. The instances are acquired and updated the way Scene::UpdateAnimation does it.
+
+using namespace NR;
+
+namespace
+{
+	constexpr const char* SkeletonPath = "SandboxProject/Assets/Animation/Source/stormtrooper-skeleton.gltf";
+	constexpr const char* WalkPath = "SandboxProject/Assets/Animation/Source/mixamo/stormtrooper-walking.gltf";
+	constexpr const char* RunPath = "SandboxProject/Assets/Animation/Source/mixamo/stormtrooper-running.gltf";
+
+	constexpr float dt = 1.0f / 60.0f;
+
+	// Walks in its first state and runs in its second, every case shares it like entities share the asset
+	Ref<AnimationController> LoadController()
+	{
+		static Ref<AnimationController> sController;
+		if (sController)
+		{
+			return sController;
+		}
+
+		if (!Test::EnterEditorDirectory())
+		{
+			return nullptr;
+		}
+
+		for (const char* path : { SkeletonPath, WalkPath, RunPath })
+		{
+			if (!std::filesystem::exists(path))
+			{
+				std::printf("    %s not found\n", path);
+				return nullptr;
+			}
+		}
+
+		Ref<AnimationController> controller = Ref<AnimationController>::Create();
+		controller->SetSkeletonAsset(Ref<SkeletonAsset>::Create(SkeletonPath));
+		for (auto [name, path] : { std::pair{ "Walk", WalkPath }, std::pair{ "Run", RunPath } })
+		{
+			auto state = Ref<AnimationState>::Create();
+			state->SetAnimationAsset(Ref<AnimationAsset>::Create(path));
+			controller->SetAnimationState(name, state);
+			if (!state->GetAnimationAsset()->IsLoaded())
+			{
+				std::printf("    %s could not be loaded\n", path);
+				return nullptr;
+			}
+		}
+
+		sController = controller;
+		return sController;
+	}
+
+	bool SamePose(const AnimationInstance& a, const AnimationInstance& b)
+	{
+		const auto& poseA = a.GetModelSpaceTransforms();
+		const auto& poseB = b.GetModelSpaceTransforms();
+		return poseA.size() == poseB.size() && std::memcmp(poseA.data(), poseB.data(), poseA.size() * sizeof(ozz::math::Float4x4)) == 0;
+	}
+
+	bool SameRootMotion(const RootMotion& a, const RootMotion& b)
+	{
+		return a.Translation == b.Translation && a.Rotation == b.Rotation;
+	}
+}
+
+NR_TEST(AnimationInstanceHandle, ReleasedInstancesAreReused)
+{
+	Ref<AnimationController> controller = LoadController();
+	if (!controller)
+	{
+		return;
+	}
+
+	AnimationInstanceHandle first;
+	AnimationInstance* instance = first.Acquire(controller, 0.25f);
+	NR_CHECK(instance && first.Get() == instance);
+	NR_CHECK(instance->GetAnimationTime() == 0.25f);
+
+	// Acquiring it again every frame keeps the playback going
+	instance->SetStateIndex(1);
+	instance->SetAnimationTime(0.5f);
+	NR_CHECK(first.Acquire(controller, 0.0f) == instance);
+	NR_CHECK(instance->GetStateIndex() == 1 && instance->GetAnimationTime() == 0.5f);
+
+	// The next handle gets the released instance, restarted at its own start time
+	first.Release();
+	NR_CHECK(!first.Get());
+	AnimationInstanceHandle second;
+	NR_CHECK(second.Acquire(controller, 0.75f) == instance);
+	NR_CHECK(instance->GetController() == controller);
+	NR_CHECK(instance->GetStateIndex() == 0 && instance->GetAnimationTime() == 0.75f);
+
+	// Entities coming and going don't grow the pool
+	std::unordered_set<AnimationInstance*> used;
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		AnimationInstanceHandle handle;
+		used.insert(handle.Acquire(controller, 0.0f));
+	}
+	NR_CHECK(used.size() == 1);
+
+	// A copy starts without an instance, a move takes it along
+	AnimationInstanceHandle copy = second;
+	NR_CHECK(!copy.Get());
+	AnimationInstanceHandle moved = std::move(second);
+	NR_CHECK(moved.Get() == instance && !second.Get());
+
+	// Nothing to play, nothing taken from the pool
+	AnimationInstanceHandle empty;
+	NR_CHECK(!empty.Acquire(Ref<AnimationController>::Create(), 0.0f));
+	NR_CHECK(!empty.Get());
+}
+
+NR_TEST(Animation, EntitiesSharingAControllerPlayIndependently)
+{
+	Ref<AnimationController> controller = LoadController();
+	if (!controller)
+	{
+		return;
+	}
+
+	AnimationComponent walker;
+	AnimationComponent paused;
+	paused.AnimationTime = 0.5f;
+	paused.EnableAnimation = false;
+
+	AnimationInstance* walkerInstance = walker.Instance.Acquire(controller, walker.AnimationTime);
+	AnimationInstance* pausedInstance = paused.Instance.Acquire(controller, paused.AnimationTime);
+	NR_CHECK(walkerInstance && pausedInstance && walkerInstance != pausedInstance);
+
+	for (uint32_t frame = 0; frame < 30; ++frame)
+	{
+		walkerInstance->Update(dt, walker.EnableAnimation, walker.EnableRootMotion);
+		pausedInstance->Update(dt, paused.EnableAnimation, paused.EnableRootMotion);
+	}
+
+	// The play flag is the component's, pausing one entity leaves the other one playing
+	NR_CHECK(walkerInstance->GetAnimationTime() > 0.0f);
+	NR_CHECK(pausedInstance->GetAnimationTime() == 0.5f);
+
+	// And so is the state
+	walkerInstance->SetStateIndex(1);
+	walkerInstance->Update(dt, walker.EnableAnimation, walker.EnableRootMotion);
+	NR_CHECK(walkerInstance->GetStateIndex() == 1 && pausedInstance->GetStateIndex() == 0);
+
+	// The paused entity holds the pose of its start time, whatever the other one did with the controller
+	AnimationComponent reference;
+	reference.AnimationTime = 0.5f;
+	AnimationInstance* referenceInstance = reference.Instance.Acquire(controller, reference.AnimationTime);
+	referenceInstance->Update(0.0f, false, false);
+	NR_CHECK(SamePose(*pausedInstance, *referenceInstance));
+	NR_CHECK(!SamePose(*walkerInstance, *pausedInstance));
+
+	// A copied component plays from its own instance once it is first updated
+	AnimationComponent copy = walker;
+	NR_CHECK(!copy.Instance.Get());
+	AnimationInstance* copyInstance = copy.Instance.Acquire(controller, copy.AnimationTime);
+	NR_CHECK(copyInstance != walkerInstance && copyInstance->GetStateIndex() == 0);
+}
+
+NR_TEST(Animation, ParallelUpdateMatchesSerialUpdate)
+{
+	Ref<AnimationController> controller = LoadController();
+	if (!controller)
+	{
+		return;
+	}
+
+	constexpr uint32_t InstanceCount = 64;
+	constexpr uint32_t Frames = 20;
+
+	// Enough workers for the instances to be updated side by side, however few cores there are
+	JobSystem::Init(4);
+
+	// Spread over both states and the whole clip, a third of them extracting root motion
+	std::vector<AnimationInstanceHandle> serial(InstanceCount);
+	std::vector<AnimationInstanceHandle> parallel(InstanceCount);
+	for (uint32_t i = 0; i < InstanceCount; ++i)
+	{
+		const float startTime = (float)i / (float)InstanceCount;
+		for (auto* handles : { &serial, &parallel })
+		{
+			AnimationInstance* instance = (*handles)[i].Acquire(controller, startTime);
+			instance->SetStateIndex(i % 2);
+			instance->SetAnimationTime(startTime);
+		}
+	}
+
+	bool samePoses = true;
+	for (uint32_t frame = 0; frame < Frames; ++frame)
+	{
+		for (uint32_t i = 0; i < InstanceCount; ++i)
+		{
+			serial[i].Get()->Update(dt, true, i % 3 == 0);
+		}
+
+		JobSystem::ParallelFor(InstanceCount, [&parallel](uint32_t index)
+			{
+				parallel[index].Get()->Update(dt, true, index % 3 == 0);
+			}, 4, "AnimationTests-Update");
+
+		for (uint32_t i = 0; i < InstanceCount; ++i)
+		{
+			const AnimationInstance& serialInstance = *serial[i].Get();
+			const AnimationInstance& parallelInstance = *parallel[i].Get();
+			samePoses &= SamePose(serialInstance, parallelInstance);
+			samePoses &= SameRootMotion(serialInstance.GetRootMotion(), parallelInstance.GetRootMotion());
+			samePoses &= serialInstance.GetAnimationTime() == parallelInstance.GetAnimationTime();
+		}
+	}
+	NR_CHECK(samePoses);
+
+	serial.clear();
+	parallel.clear();
+	JobSystem::Shutdown();
+}
+
+NR_BENCHMARK(Animation, UpdateAThousandInstances)
+{
+	Ref<AnimationController> controller = LoadController();
+	if (!controller)
+	{
+		return;
+	}
+
+	constexpr uint32_t InstanceCount = 1000;
+	constexpr uint64_t Frames = 100;
+
+	JobSystem::Init();
+
+	std::vector<AnimationInstanceHandle> handles(InstanceCount);
+	for (uint32_t i = 0; i < InstanceCount; ++i)
+	{
+		handles[i].Acquire(controller, (float)i / (float)InstanceCount)->SetStateIndex(i % 2);
+	}
+
+	Test::Measure("Update, 1k instances, serial", Frames, [&handles](uint64_t)
+		{
+			for (AnimationInstanceHandle& handle : handles)
+			{
+				handle.Get()->Update(dt, true, false);
+			}
+		});
+
+	Test::Measure("Update, 1k instances, ParallelFor", Frames, [&handles](uint64_t)
+		{
+			JobSystem::ParallelFor((uint32_t)handles.size(), [&handles](uint32_t index)
+				{
+					handles[index].Get()->Update(dt, true, false);
+				}, 4, "AnimationTests-Update");
+		});
+
+	handles.clear();
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,325 @@
+#include "Test.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Core/JobSystem.h"
+#include "NotRed/Asset/AssetManager.h"
+
+// Runs without a project, the physics materials these load have no files. The serializer below creates them and
+// records every load, so the cases can see the order, the thread and how often each was loaded.
+
+using namespace NR;
+using namespace std::chrono_literals;
+
+namespace
+{
+	struct LoadRecord
+	{
+		std::string Name;
+		std::thread::id Thread;
+	};
+
+	struct LoaderState
+	{
+		std::mutex Mutex;
+		std::vector<LoadRecord> Loads;
+		std::unordered_map<std::string, AssetHandle> Dependencies;
+
+		// Assets named Gated* are held at the gate until it opens
+		std::atomic<bool> GateOpen = true;
+		std::atomic<uint32_t> AtGate = 0;
+		std::atomic<uint32_t> Started = 0;
+	};
+
+	LoaderState sState;
+
+	class RecordingSerializer : public AssetSerializer
+	{
+	public:
+		void Serialize(const AssetMetadata& metadata, const Ref<Asset>& asset) const override {}
+
+		bool TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const override
+		{
+			const std::string name = metadata.FilePath.stem().string();
+			++sState.Started;
+			if (name.rfind("Gated", 0) == 0)
+			{
+				++sState.AtGate;
+				while (!sState.GateOpen)
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			// A dependency is loaded through GetAsset like the real serializers do, the asset counts one more than it
+			float friction = 0.0f;
+			AssetHandle dependency = 0;
+			{
+				std::scoped_lock<std::mutex> lock(sState.Mutex);
+				auto it = sState.Dependencies.find(name);
+				dependency = it != sState.Dependencies.end() ? it->second : AssetHandle(0);
+			}
+			if (dependency)
+			{
+				Ref<PhysicsMaterial> dependencyAsset = AssetManager::GetAsset<PhysicsMaterial>(dependency);
+				friction = dependencyAsset ? dependencyAsset->StaticFriction + 1.0f : -1.0f;
+			}
+
+			{
+				std::scoped_lock<std::mutex> lock(sState.Mutex);
+				sState.Loads.push_back({ name, std::this_thread::get_id() });
+			}
+
+			asset = Ref<PhysicsMaterial>::Create(friction, 0.0f, 0.0f);
+			asset->Handle = metadata.Handle;
+			return true;
+		}
+	};
+
+	// Two workers leave a single loader job, four leave two
+	class ScopedAssetLoader
+	{
+	public:
+		explicit ScopedAssetLoader(uint32_t workerCount)
+		{
+			AssetImporter::SetSerializer(AssetType::PhysicsMat, CreateScope<RecordingSerializer>());
+			sState.Loads.clear();
+			sState.Dependencies.clear();
+			sState.GateOpen = true;
+			sState.AtGate = 0;
+			sState.Started = 0;
+
+			JobSystem::Init(workerCount);
+		}
+
+		~ScopedAssetLoader()
+		{
+			sState.GateOpen = true;
+			AssetManager::FinishPendingLoads();
+			JobSystem::Shutdown();
+		}
+	};
+
+	// Every case registers its own assets, the registry outlives the cases
+	AssetHandle Register(const std::string& testName, const std::string& name)
+	{
+		return AssetManager::ImportAsset("AsyncLoader/" + testName + "/" + name + ".nrpm");
+	}
+
+	void SetDependency(const std::string& name, AssetHandle dependency)
+	{
+		std::scoped_lock<std::mutex> lock(sState.Mutex);
+		sState.Dependencies[name] = dependency;
+	}
+
+	void WaitFor(const std::atomic<uint32_t>& counter, uint32_t count)
+	{
+		while (counter < count)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	std::vector<std::string> GetLoadOrder()
+	{
+		std::scoped_lock<std::mutex> lock(sState.Mutex);
+		std::vector<std::string> names;
+		for (const LoadRecord& load : sState.Loads)
+		{
+			names.push_back(load.Name);
+		}
+		return names;
+	}
+
+	uint32_t GetLoadCount(const std::string& name)
+	{
+		std::scoped_lock<std::mutex> lock(sState.Mutex);
+		uint32_t count = 0;
+		for (const LoadRecord& load : sState.Loads)
+		{
+			count += load.Name == name ? 1 : 0;
+		}
+		return count;
+	}
+
+	std::thread::id GetLoadThread(const std::string& name)
+	{
+		std::scoped_lock<std::mutex> lock(sState.Mutex);
+		for (const LoadRecord& load : sState.Loads)
+		{
+			if (load.Name == name)
+			{
+				return load.Thread;
+			}
+		}
+		return {};
+	}
+}
+
+NR_TEST(AssetLoader, QueuedRequestsLoadByPriorityThenOrder)
+{
+	ScopedAssetLoader loader(2);
+
+	// The only loader job is held in the first asset, everything after it is queued
+	sState.GateOpen = false;
+	AssetManager::RequestAsset(Register("Priority", "Gated"));
+	WaitFor(sState.AtGate, 1);
+
+	const AssetHandle a = Register("Priority", "A");
+	AssetManager::RequestAsset(a, AssetLoadPriority::Low);
+	AssetManager::RequestAsset(Register("Priority", "B"), AssetLoadPriority::Normal);
+	AssetManager::RequestAsset(Register("Priority", "C"), AssetLoadPriority::High);
+	AssetManager::RequestAsset(Register("Priority", "D"), AssetLoadPriority::Normal);
+	AssetManager::RequestAsset(Register("Priority", "E"), AssetLoadPriority::Low);
+	AssetManager::RequestAsset(Register("Priority", "F"), AssetLoadPriority::High);
+
+	// Requesting A again raises it, it keeps its place in the order
+	AssetManager::RequestAsset(a, AssetLoadPriority::High);
+	AssetManager::RequestAsset(a, AssetLoadPriority::Low);
+
+	sState.GateOpen = true;
+	AssetManager::FinishPendingLoads();
+
+	NR_CHECK(GetLoadOrder() == std::vector<std::string>({ "Gated", "A", "C", "F", "B", "D", "E" }));
+	NR_CHECK(AssetManager::IsAssetLoaded(a));
+}
+
+NR_TEST(AssetLoader, QueuedDependencyIsLoadedByTheWorkerWaitingForIt)
+{
+	ScopedAssetLoader loader(2);
+
+	sState.GateOpen = false;
+	AssetManager::RequestAsset(Register("TakeOver", "Gated"));
+	WaitFor(sState.AtGate, 1);
+
+	// The parent goes first, its worker takes the queued dependency over instead of waiting for another loader
+	const AssetHandle dependency = Register("TakeOver", "Dependency");
+	const AssetHandle parent = Register("TakeOver", "Parent");
+	SetDependency("Parent", dependency);
+	AssetManager::RequestAsset(dependency, AssetLoadPriority::Low);
+	AssetManager::RequestAsset(parent, AssetLoadPriority::High);
+
+	sState.GateOpen = true;
+	AssetManager::FinishPendingLoads();
+
+	NR_CHECK(GetLoadCount("Dependency") == 1);
+	NR_CHECK(GetLoadThread("Dependency") == GetLoadThread("Parent"));
+	NR_CHECK(GetLoadOrder() == std::vector<std::string>({ "Gated", "Dependency", "Parent" }));
+	NR_CHECK(AssetManager::GetAsset<PhysicsMaterial>(parent)->StaticFriction == 1.0f);
+	NR_CHECK(AssetManager::IsAssetLoaded(dependency));
+}
+
+NR_TEST(AssetLoader, WorkerWaitsForADependencyInFlightOnAnother)
+{
+	ScopedAssetLoader loader(4);
+
+	// One loader holds the dependency, the other one gets the parent and has to wait for it
+	sState.GateOpen = false;
+	const AssetHandle dependency = Register("InFlight", "GatedDependency");
+	AssetManager::RequestAsset(dependency, AssetLoadPriority::High);
+	WaitFor(sState.AtGate, 1);
+
+	const AssetHandle parent = Register("InFlight", "Parent");
+	SetDependency("Parent", dependency);
+	AssetManager::RequestAsset(parent);
+
+	// The second loader is in the parent before the dependency is released
+	WaitFor(sState.Started, 2);
+	std::this_thread::sleep_for(20ms);
+	NR_CHECK(GetLoadCount("Parent") == 0);
+	sState.GateOpen = true;
+	AssetManager::FinishPendingLoads();
+
+	NR_CHECK(GetLoadCount("GatedDependency") == 1);
+	NR_CHECK(GetLoadThread("GatedDependency") != GetLoadThread("Parent"));
+	NR_CHECK(GetLoadOrder() == std::vector<std::string>({ "GatedDependency", "Parent" }));
+	NR_CHECK(AssetManager::GetAsset<PhysicsMaterial>(parent)->StaticFriction == 1.0f);
+}
+
+NR_TEST(AssetLoader, GetAssetWaitsForTheLoadInFlight)
+{
+	ScopedAssetLoader loader(2);
+
+	sState.GateOpen = false;
+	const AssetHandle handle = Register("GetAsset", "Gated");
+	AssetManager::RequestAsset(handle);
+	WaitFor(sState.AtGate, 1);
+
+	NR_CHECK(AssetManager::IsAssetLoading(handle));
+	NR_CHECK(!AssetManager::IsAssetLoaded(handle));
+	// Without a placeholder for the type, GetAssetAsync has nothing to hand out yet
+	NR_CHECK(!AssetManager::GetAssetAsync<PhysicsMaterial>(handle));
+
+	// Released while the main thread is blocked in GetAsset below
+	std::thread opener([]()
+		{
+			std::this_thread::sleep_for(50ms);
+			sState.GateOpen = true;
+		});
+
+	Ref<PhysicsMaterial> asset = AssetManager::GetAsset<PhysicsMaterial>(handle);
+	opener.join();
+
+	NR_CHECK(asset && asset->Handle == handle);
+	NR_CHECK(GetLoadCount("Gated") == 1);
+	NR_CHECK(GetLoadThread("Gated") != std::this_thread::get_id());
+	NR_CHECK(AssetManager::IsAssetLoaded(handle) && !AssetManager::IsAssetLoading(handle));
+	NR_CHECK(AssetManager::GetAssetAsync<PhysicsMaterial>(handle) == asset);
+}
+
+NR_TEST(AssetLoader, CallbacksRunOnTheMainThread)
+{
+	ScopedAssetLoader loader(2);
+
+	struct CallbackRecord
+	{
+		std::atomic<uint32_t> Calls = 0;
+		std::atomic<bool> OnMainThread = true;
+		Ref<Asset> LoadedAsset;
+	};
+	auto record = [](CallbackRecord& callbackRecord)
+	{
+		return [&callbackRecord](Ref<Asset> asset)
+		{
+			callbackRecord.OnMainThread = callbackRecord.OnMainThread && JobSystem::IsMainThread();
+			callbackRecord.LoadedAsset = asset;
+			++callbackRecord.Calls;
+		};
+	};
+
+	const AssetHandle handle = Register("Callbacks", "Material");
+	CallbackRecord first;
+	AssetManager::RequestAsset(handle, AssetLoadPriority::Normal, record(first));
+
+	// The worker is done with the asset, but nothing is published or called back before the main thread runs its jobs
+	while (GetLoadCount("Material") == 0)
+	{
+		std::this_thread::yield();
+	}
+	std::this_thread::sleep_for(20ms);
+	NR_CHECK(first.Calls == 0);
+	NR_CHECK(AssetManager::IsAssetLoading(handle));
+
+	AssetManager::FinishPendingLoads();
+	NR_CHECK(first.Calls == 1);
+	NR_CHECK(first.OnMainThread);
+	NR_CHECK(first.LoadedAsset && first.LoadedAsset->Handle == handle);
+
+	// A loaded asset calls back with the next main thread jobs as well, a handle that isn't registered with nullptr
+	CallbackRecord loaded;
+	CallbackRecord unknown;
+	AssetManager::RequestAsset(handle, AssetLoadPriority::Normal, record(loaded));
+	AssetManager::RequestAsset(AssetHandle(), AssetLoadPriority::Normal, record(unknown));
+	NR_CHECK(loaded.Calls == 0 && unknown.Calls == 0);
+
+	JobSystem::RunMainThreadJobs();
+	NR_CHECK(loaded.Calls == 1 && loaded.OnMainThread && loaded.LoadedAsset == first.LoadedAsset);
+	NR_CHECK(unknown.Calls == 1 && unknown.OnMainThread && !unknown.LoadedAsset);
+	NR_CHECK(GetLoadCount("Material") == 1);
+}
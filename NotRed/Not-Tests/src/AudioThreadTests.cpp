@@ -0,0 +1,152 @@
+#include "Test.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Audio/AudioEngine.h"
+
+// The Audio Thread runs without an AudioEngine, its update does nothing besides executing the posted commands
+
+using namespace NR;
+using namespace std::chrono_literals;
+
+namespace
+{
+	struct ScopedAudioThread
+	{
+		ScopedAudioThread()
+		{
+			Audio::AudioThread::BindUpdateFunction([](TimeFrame) {});
+			Audio::AudioThread::Start();
+		}
+
+		~ScopedAudioThread()
+		{
+			Audio::AudioThread::Stop();
+
+			// The thread is detached, give it time to leave its last update before the next one starts
+			std::this_thread::sleep_for(50ms);
+		}
+	};
+
+	template<typename Func>
+	void RunProducers(uint32_t producerCount, Func&& func)
+	{
+		std::vector<std::thread> producers;
+		for (uint32_t i = 0; i < producerCount; ++i)
+		{
+			producers.emplace_back([&func, i]() { func(i); });
+		}
+		for (std::thread& producer : producers)
+		{
+			producer.join();
+		}
+	}
+
+	void WaitFor(const std::atomic<uint64_t>& counter, uint64_t value)
+	{
+		while (counter.load(std::memory_order_acquire) < value)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// Every thread that posts takes one of the fifo's producer slots for good, these take the rest
+	void UseUpAllLockFreeProducerSlots(std::atomic<uint64_t>& executed)
+	{
+		const uint64_t target = executed + Audio::AUDIO_THREAD_MAX_PRODUCERS;
+		RunProducers(Audio::AUDIO_THREAD_MAX_PRODUCERS, [&executed](uint32_t)
+			{
+				AudioEngine::ExecuteOnAudioThread([&executed] { executed.fetch_add(1, std::memory_order_release); });
+			});
+		WaitFor(executed, target);
+	}
+}
+
+NR_TEST(AudioThread, CommandsKeepTheirOrderAcrossTheOverflow)
+{
+	constexpr uint32_t ProducerCount = 4;
+	constexpr uint32_t CommandsPerProducer = Audio::AUDIO_THREAD_COMMAND_CAPACITY;
+
+	ScopedAudioThread audioThread;
+
+	// The Audio Thread is held in a command until every producer has posted, so the fifo fills up and the rest overflows
+	std::atomic<bool> release = false;
+	AudioEngine::ExecuteOnAudioThread([&release]
+		{
+			while (!release)
+			{
+				std::this_thread::yield();
+			}
+		});
+
+	std::vector<std::vector<uint32_t>> executedByProducer(ProducerCount);
+	std::atomic<uint64_t> executed = 0;
+	RunProducers(ProducerCount, [&](uint32_t producer)
+		{
+			for (uint32_t i = 0; i < CommandsPerProducer; ++i)
+			{
+				AudioEngine::ExecuteOnAudioThread([&, producer, i]
+					{
+						executedByProducer[producer].push_back(i);
+						executed.fetch_add(1, std::memory_order_release);
+					});
+			}
+		});
+	release = true;
+	WaitFor(executed, ProducerCount * CommandsPerProducer);
+
+	bool inOrder = true;
+	for (const std::vector<uint32_t>& commands : executedByProducer)
+	{
+		inOrder &= commands.size() == CommandsPerProducer;
+		for (uint32_t i = 0; i < commands.size(); ++i)
+		{
+			inOrder &= commands[i] == i;
+		}
+	}
+	NR_CHECK(inOrder);
+}
+
+NR_BENCHMARK(AudioThread, PostCommandsFromManyProducers)
+{
+	constexpr uint64_t CommandsPerProducer = 100000;
+
+	ScopedAudioThread audioThread;
+	std::atomic<uint64_t> executed = 0;
+
+	// Only the time the producers spend posting is reported, the Audio Thread drains the queue before the next run
+	auto post = [&executed](const std::string& path, uint32_t producerCount)
+	{
+		const std::string name = std::to_string(producerCount) + (producerCount == 1 ? " producer, " : " producers, ") + path;
+		const uint64_t target = executed + producerCount * CommandsPerProducer;
+		const auto start = std::chrono::steady_clock::now();
+		RunProducers(producerCount, [&executed](uint32_t)
+			{
+				for (uint64_t i = 0; i < CommandsPerProducer; ++i)
+				{
+					AudioEngine::ExecuteOnAudioThread([&executed] { executed.fetch_add(1, std::memory_order_release); });
+				}
+			});
+		const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		Test::ReportMeasurement(name, milliseconds, producerCount * CommandsPerProducer);
+
+		WaitFor(executed, target);
+	};
+
+	// These producers are among the first threads to post, they get a slot in the lock-free fifo.
+	// The fifo still spills into the overflow queue whenever the Audio Thread falls more than its capacity behind.
+	for (uint32_t producers : { 1u, 4u, 16u })
+	{
+		post("lock-free fifo", producers);
+	}
+
+	// From here on every new thread is past the producer limit and posts under the overflow lock
+	UseUpAllLockFreeProducerSlots(executed);
+	for (uint32_t producers : { 1u, 4u, 16u })
+	{
+		post("overflow queue", producers);
+	}
+}
@@ -0,0 +1,173 @@
+#include "Test.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Physics/3D/ContactListener.h"
+
+// The events are fed straight into the listener and dispatched to test handlers, so neither PhysX nor scripts are needed
+
+using namespace NR;
+
+namespace
+{
+	struct ReceivedEvents
+	{
+		std::vector<UUID> Others;
+		std::vector<ContactType> Types;
+		uint32_t BatchCount = 0;
+	};
+
+	struct TestHandlers
+	{
+		std::unordered_set<UUID> Scripted;
+		std::unordered_map<UUID, ReceivedEvents> Received;
+		std::unordered_map<UUID, uint32_t> IsScriptedCalls;
+
+		ContactListener::EventHandlers Get()
+		{
+			ContactListener::EventHandlers handlers;
+			handlers.IsScripted = [this](UUID entity)
+			{
+				++IsScriptedCalls[entity];
+				return Scripted.find(entity) != Scripted.end();
+			};
+			handlers.ContactEvents = [this](UUID entity, const std::vector<UUID>& others, const std::vector<ContactType>& types)
+			{
+				ReceivedEvents& received = Received[entity];
+				received.Others.insert(received.Others.end(), others.begin(), others.end());
+				received.Types.insert(received.Types.end(), types.begin(), types.end());
+				++received.BatchCount;
+			};
+			handlers.JointBreak = [](UUID, const glm::vec3&, const glm::vec3&) {};
+			return handlers;
+		}
+	};
+
+	constexpr uint32_t PairCount = 4000;
+	constexpr uint32_t SubstepCount = 4;
+
+	// Entity 1 touches every other entity, so its batch collects events of every pair
+	UUID GetOther(uint32_t pair) { return UUID(100 + pair); }
+}
+
+NR_TEST(ContactListener, SubstepsCoalesceToFirstAndLastEvent)
+{
+	ContactListener listener;
+	TestHandlers test;
+	test.Scripted.insert(UUID(1));
+	for (uint32_t pair = 0; pair < PairCount; ++pair)
+	{
+		test.Scripted.insert(GetOther(pair));
+	}
+
+	// Every substep reports begin and end for every pair. Even pairs start touching in the last substep instead.
+	for (uint32_t substep = 0; substep < SubstepCount; ++substep)
+	{
+		for (uint32_t pair = 0; pair < PairCount; ++pair)
+		{
+			const bool trigger = pair % 3 == 0;
+			listener.RecordContact(UUID(1), GetOther(pair), trigger, true);
+			if (pair % 2 == 1 || substep + 1 < SubstepCount)
+			{
+				listener.RecordContact(UUID(1), GetOther(pair), trigger, false);
+			}
+		}
+	}
+
+	listener.DispatchEvents(test.Get());
+
+	// A pair that ended is reported as begin and end, one that is touching again at the end of the step only as begin
+	const ReceivedEvents& shared = test.Received[UUID(1)];
+	NR_CHECK(shared.BatchCount == 1);
+	NR_CHECK(shared.Others.size() == PairCount + PairCount / 2);
+
+	bool everyPairCoalesced = true;
+	for (uint32_t pair = 0; pair < PairCount; ++pair)
+	{
+		const bool trigger = pair % 3 == 0;
+		const ContactType begin = trigger ? ContactType::TriggerBegin : ContactType::CollisionBegin;
+		const ContactType end = trigger ? ContactType::TriggerEnd : ContactType::CollisionEnd;
+
+		const ReceivedEvents& other = test.Received[GetOther(pair)];
+		everyPairCoalesced &= other.BatchCount == 1;
+		if (pair % 2)
+		{
+			everyPairCoalesced &= other.Others == std::vector<UUID>{ UUID(1), UUID(1) };
+			everyPairCoalesced &= other.Types == std::vector<ContactType>{ begin, end };
+		}
+		else
+		{
+			everyPairCoalesced &= other.Others == std::vector<UUID>{ UUID(1) };
+			everyPairCoalesced &= other.Types == std::vector<ContactType>{ begin };
+		}
+	}
+	NR_CHECK(everyPairCoalesced);
+
+	// Entities were only looked up once to build their batch and once more before it was sent
+	bool everyBatchBuiltOnce = true;
+	for (const auto& [entity, calls] : test.IsScriptedCalls)
+	{
+		everyBatchBuiltOnce &= calls == 2;
+	}
+	NR_CHECK(everyBatchBuiltOnce);
+	NR_CHECK(test.IsScriptedCalls.size() == PairCount + 1);
+
+	// Everything was handed out, the next step starts empty
+	test.Received.clear();
+	listener.DispatchEvents(test.Get());
+	NR_CHECK(test.Received.empty());
+}
+
+NR_TEST(ContactListener, UnscriptedEntitiesGetNoBatch)
+{
+	ContactListener listener;
+	TestHandlers test;
+	test.Scripted.insert(UUID(1));
+
+	for (uint32_t pair = 0; pair < PairCount; ++pair)
+	{
+		listener.RecordContact(UUID(1), GetOther(pair), false, true);
+	}
+	listener.DispatchEvents(test.Get());
+
+	NR_CHECK(test.Received.size() == 1);
+	NR_CHECK(test.Received[UUID(1)].Others.size() == PairCount);
+	NR_CHECK(test.IsScriptedCalls[GetOther(0)] == 1);
+}
+
+NR_TEST(ContactListener, EntitiesDestroyedMidDispatchAreSkipped)
+{
+	ContactListener listener;
+	TestHandlers test;
+	for (uint32_t pair = 0; pair < PairCount; ++pair)
+	{
+		test.Scripted.insert(GetOther(pair));
+		test.Scripted.insert(GetOther(pair + PairCount));
+	}
+
+	for (uint32_t pair = 0; pair < PairCount; ++pair)
+	{
+		listener.RecordContact(GetOther(pair), GetOther(pair + PairCount), false, true);
+	}
+
+	// The script of the first entity of a pair destroys the second one, which comes later in the dispatch order
+	ContactListener::EventHandlers handlers = test.Get();
+	auto contactEvents = handlers.ContactEvents;
+	handlers.ContactEvents = [&](UUID entity, const std::vector<UUID>& others, const std::vector<ContactType>& types)
+	{
+		contactEvents(entity, others, types);
+		test.Scripted.erase(others.front());
+	};
+	listener.DispatchEvents(handlers);
+
+	bool destroyedSkipped = true;
+	for (uint32_t pair = 0; pair < PairCount; ++pair)
+	{
+		destroyedSkipped &= test.Received.find(GetOther(pair)) != test.Received.end();
+		destroyedSkipped &= test.Received.find(GetOther(pair + PairCount)) == test.Received.end();
+	}
+	NR_CHECK(destroyedSkipped);
+	NR_CHECK(test.Received.size() == PairCount);
+}
@@ -0,0 +1,168 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Math/AABB.h"
+#include "NotRed/Math/Frustum.h"
+
+// The engine builds glm with [0, 1] clip space depth in nrpch.h, the tests define it for the whole project as well
+static_assert(GLM_CONFIG_CLIP_CONTROL & GLM_CLIP_CONTROL_ZO_BIT, "Frustum extracts its near plane assuming [0, 1] clip space depth");
+
+using namespace NR;
+
+namespace
+{
+	AABB Box(const glm::vec3& center, float halfSize)
+	{
+		return AABB(center - glm::vec3(halfSize), center + glm::vec3(halfSize));
+	}
+
+	// 90 degrees each way, looking down -Z from the origin, so the side planes at a depth of d are d units off the axis
+	Frustum CreateCameraFrustum()
+	{
+		return Frustum(glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 10.0f));
+	}
+
+	// Built like SceneRenderer::CalculateCascades does for a cascade of the given radius, with its default plane offsets
+	Frustum CreateCascadeFrustum(const glm::vec3& center, float radius, const glm::vec3& lightDirection)
+	{
+		constexpr float NearPlaneOffset = -50.0f;
+		constexpr float FarPlaneOffset = 50.0f;
+
+		const glm::mat4 lightView = glm::lookAt(center + lightDirection * radius, center, glm::vec3(0.0f, 0.0f, 1.0f));
+		const glm::mat4 lightOrtho = glm::ortho(-radius, radius, -radius, radius, 0.0f + NearPlaneOffset, radius * 2.0f + FarPlaneOffset);
+		return Frustum(lightOrtho * lightView);
+	}
+
+	bool Contains(const AABB& aabb, const glm::vec3& point)
+	{
+		return glm::all(glm::greaterThanEqual(point, aabb.Min - 1e-4f)) && glm::all(glm::lessThanEqual(point, aabb.Max + 1e-4f));
+	}
+}
+
+NR_TEST(Frustum, PlanesOfAPerspectiveCamera)
+{
+	const Frustum frustum = CreateCameraFrustum();
+
+	// Normalized and pointing inwards, the near plane sits at the near clip distance only with [0, 1] depth
+	const glm::vec4 expected[6] = {
+		{ glm::sqrt(0.5f), 0.0f, -glm::sqrt(0.5f), 0.0f },  // Left
+		{ -glm::sqrt(0.5f), 0.0f, -glm::sqrt(0.5f), 0.0f }, // Right
+		{ 0.0f, glm::sqrt(0.5f), -glm::sqrt(0.5f), 0.0f },  // Bottom
+		{ 0.0f, -glm::sqrt(0.5f), -glm::sqrt(0.5f), 0.0f }, // Top
+		{ 0.0f, 0.0f, -1.0f, -1.0f },                        // Near
+		{ 0.0f, 0.0f, 1.0f, 10.0f }                          // Far
+	};
+	for (uint32_t i = 0; i < 6; ++i)
+	{
+		NR_CHECK(glm::all(glm::lessThan(glm::abs(frustum.Planes[i] - expected[i]), glm::vec4(1e-4f))));
+	}
+}
+
+NR_TEST(Frustum, BoxesInsideOutsideAndStraddlingEachPlane)
+{
+	const Frustum frustum = CreateCameraFrustum();
+
+	NR_CHECK(frustum.IntersectsAABB(Box({ 0.0f, 0.0f, -5.0f }, 1.0f)));
+
+	// At a depth of 5 the side planes are 5 units off the axis
+	struct PlaneCase
+	{
+		const char* Plane;
+		glm::vec3 Outside;
+		glm::vec3 Straddling;
+	};
+	const PlaneCase cases[] = {
+		{ "Left", { -7.0f, 0.0f, -5.0f }, { -5.0f, 0.0f, -5.0f } },
+		{ "Right", { 7.0f, 0.0f, -5.0f }, { 5.0f, 0.0f, -5.0f } },
+		{ "Bottom", { 0.0f, -7.0f, -5.0f }, { 0.0f, -5.0f, -5.0f } },
+		{ "Top", { 0.0f, 7.0f, -5.0f }, { 0.0f, 5.0f, -5.0f } },
+		{ "Near", { 0.0f, 0.0f, -0.4f }, { 0.0f, 0.0f, -1.0f } },
+		{ "Far", { 0.0f, 0.0f, -11.0f }, { 0.0f, 0.0f, -10.0f } }
+	};
+	for (const PlaneCase& planeCase : cases)
+	{
+		const bool outsideCulled = !frustum.IntersectsAABB(Box(planeCase.Outside, 0.5f));
+		const bool straddlingKept = frustum.IntersectsAABB(Box(planeCase.Straddling, 0.5f));
+		if (!outsideCulled || !straddlingKept)
+		{
+			std::printf("    %s plane\n", planeCase.Plane);
+		}
+		NR_CHECK(outsideCulled);
+		NR_CHECK(straddlingKept);
+	}
+
+	NR_CHECK(!frustum.IntersectsAABB(Box({ 0.0f, 0.0f, 5.0f }, 0.5f)));
+
+	// Left of the far edge, each plane on its own sees part of the box on its inner side. The test is conservative there and keeps it.
+	NR_CHECK(frustum.IntersectsAABB(AABB({ -13.0f, -1.0f, -12.0f }, { -11.0f, 1.0f, -9.5f })));
+}
+
+NR_TEST(Frustum, ShadowCascadeCullsAroundTheSlice)
+{
+	const glm::vec3 center = { 20.0f, 0.0f, -30.0f };
+	const glm::vec3 lightDirection = glm::normalize(glm::vec3(0.3f, 1.0f, 0.2f));
+	const float radius = 8.0f;
+	const Frustum cascade = CreateCascadeFrustum(center, radius, lightDirection);
+
+	NR_CHECK(cascade.IntersectsAABB(Box(center, 1.0f)));
+
+	// Sideways from the light the slice ends at its radius
+	const glm::vec3 side = glm::normalize(glm::cross(lightDirection, glm::vec3(0.0f, 0.0f, 1.0f)));
+	NR_CHECK(!cascade.IntersectsAABB(Box(center + side * (radius + 2.0f), 1.0f)));
+	NR_CHECK(cascade.IntersectsAABB(Box(center + side * radius, 1.0f)));
+
+	// Towards the light the near plane is pulled back by 50 units, casters above the slice still throw shadows into it
+	NR_CHECK(cascade.IntersectsAABB(Box(center + lightDirection * (radius + 40.0f), 1.0f)));
+	NR_CHECK(!cascade.IntersectsAABB(Box(center + lightDirection * (radius + 60.0f), 1.0f)));
+
+	// Away from the light the far plane is pushed out by 50 as well, it ends 58 units below the center
+	NR_CHECK(cascade.IntersectsAABB(Box(center - lightDirection * 55.0f, 1.0f)));
+	NR_CHECK(!cascade.IntersectsAABB(Box(center - lightDirection * 62.0f, 1.0f)));
+}
+
+NR_TEST(AABB, TransformedBoundsContainTheTransformedBox)
+{
+	const AABB box({ -1.0f, -2.0f, -0.5f }, { 3.0f, 1.0f, 0.5f });
+
+	// Translation and scale keep the box axis aligned, the bounds are exact
+	const glm::mat4 scaled = glm::scale(glm::translate(glm::mat4(1.0f), { 10.0f, 0.0f, -4.0f }), { 2.0f, 0.5f, 1.0f });
+	const AABB scaledBounds = box.Transformed(scaled);
+	NR_CHECK(glm::all(glm::lessThan(glm::abs(scaledBounds.Min - glm::vec3(8.0f, -1.0f, -4.5f)), glm::vec3(1e-4f))));
+	NR_CHECK(glm::all(glm::lessThan(glm::abs(scaledBounds.Max - glm::vec3(16.0f, 0.5f, -3.5f)), glm::vec3(1e-4f))));
+
+	// A quarter turn around Y swaps the X and Z extents
+	const AABB turnedBounds = box.Transformed(glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), { 0.0f, 1.0f, 0.0f }));
+	NR_CHECK(glm::all(glm::lessThan(glm::abs(turnedBounds.Min - glm::vec3(-0.5f, -2.0f, -3.0f)), glm::vec3(1e-4f))));
+	NR_CHECK(glm::all(glm::lessThan(glm::abs(turnedBounds.Max - glm::vec3(0.5f, 1.0f, 1.0f)), glm::vec3(1e-4f))));
+
+	// Under any rotation the bounds contain every corner, and touch the furthest one on each axis
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	bool containsCorners = true;
+	bool tight = true;
+	for (uint32_t i = 0; i < 100; ++i)
+	{
+		const glm::vec3 axis = glm::normalize(glm::vec3(unit(random), unit(random), unit(random)) + glm::vec3(0.0f, 0.0f, 1e-3f));
+		const glm::mat4 transform = glm::scale(glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(unit(random), unit(random), unit(random)) * 20.0f),
+			unit(random) * glm::pi<float>(), axis), glm::vec3(1.0f + unit(random) * 0.5f, 1.0f, 2.0f));
+		const AABB bounds = box.Transformed(transform);
+
+		glm::vec3 cornerMin(FLT_MAX), cornerMax(-FLT_MAX);
+		for (uint32_t corner = 0; corner < 8; ++corner)
+		{
+			const glm::vec3 local = { corner & 1 ? box.Max.x : box.Min.x, corner & 2 ? box.Max.y : box.Min.y, corner & 4 ? box.Max.z : box.Min.z };
+			const glm::vec3 world = transform * glm::vec4(local, 1.0f);
+			containsCorners &= Contains(bounds, world);
+			cornerMin = glm::min(cornerMin, world);
+			cornerMax = glm::max(cornerMax, world);
+		}
+		tight &= glm::all(glm::lessThan(glm::abs(bounds.Min - cornerMin), glm::vec3(1e-3f))) && glm::all(glm::lessThan(glm::abs(bounds.Max - cornerMax), glm::vec3(1e-3f)));
+	}
+	NR_CHECK(containsCorners);
+	NR_CHECK(tight);
+}
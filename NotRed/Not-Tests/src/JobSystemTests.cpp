@@ -0,0 +1,97 @@
+#include "Test.h"
+
+#include <atomic>
+#include <thread>
+
+#include "NotRed/Core/JobSystem.h"
+
+using namespace NR;
+
+NR_TEST(JobSystem, ParallelForCallsEveryIndexOnce)
+{
+	JobSystem::Init(4);
+
+	std::vector<std::atomic<uint32_t>> calls(10000);
+	JobSystem::ParallelFor((uint32_t)calls.size(), [&calls](uint32_t i) { calls[i]++; }, 64);
+
+	bool everyIndexOnce = true;
+	for (auto& count : calls)
+	{
+		everyIndexOnce &= count.load() == 1;
+	}
+	NR_CHECK(everyIndexOnce);
+
+	JobSystem::Shutdown();
+}
+
+NR_TEST(JobSystem, MainThreadWaitSkipsOtherMainThreadJobs)
+{
+	JobSystem::Init(2);
+
+	bool mainThreadJobRan = false;
+	JobSystem::Schedule([&mainThreadJobRan]() { mainThreadJobRan = true; }, "MainThreadJob", nullptr, nullptr, JobAffinity::MainThread);
+
+	// The main thread runs out of batches first and waits for the workers, the main thread job stands in for an
+	// import or a load callback that has to wait for the frame boundary
+	JobSystem::ParallelFor(3, [](uint32_t)
+		{
+			if (!JobSystem::IsMainThread())
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			}
+		}, 1);
+	NR_CHECK(!mainThreadJobRan);
+
+	JobSystem::RunMainThreadJobs();
+	NR_CHECK(mainThreadJobRan);
+
+	JobSystem::Shutdown();
+}
+
+NR_TEST(JobSystem, MainThreadWaitRunsItsOwnMainThreadJobs)
+{
+	JobSystem::Init(2);
+
+	bool otherJobRan = false;
+	JobSystem::Schedule([&otherJobRan]() { otherJobRan = true; }, "OtherJob", nullptr, nullptr, JobAffinity::MainThread);
+
+	bool ownJobRan = false;
+	Ref<JobCounter> counter = Ref<JobCounter>::Create();
+	JobSystem::Schedule([&ownJobRan]() { ownJobRan = true; }, "OwnJob", counter, nullptr, JobAffinity::MainThread);
+
+	JobSystem::Wait(counter);
+	NR_CHECK(ownJobRan);
+	NR_CHECK(!otherJobRan);
+
+	JobSystem::RunMainThreadJobs();
+	NR_CHECK(otherJobRan);
+
+	JobSystem::Shutdown();
+}
+
+NR_TEST(JobSystem, MainThreadWaitDoesNotRunUnrelatedJobs)
+{
+	JobSystem::Init(1);
+
+	// Keeps the only worker busy, so the unrelated job stays queued unless the main thread takes it
+	std::atomic<bool> started = false;
+	std::atomic<bool> release = false;
+	Ref<JobCounter> blocker = Ref<JobCounter>::Create();
+	JobSystem::Schedule([&started, &release]() { started = true; while (!release) {} }, "Blocker", blocker);
+	while (!started)
+	{
+		std::this_thread::yield();
+	}
+
+	std::atomic<bool> unrelatedRanOnMainThread = false;
+	JobSystem::Schedule([&unrelatedRanOnMainThread]() { unrelatedRanOnMainThread = JobSystem::IsMainThread(); }, "Unrelated");
+
+	std::atomic<uint32_t> sum = 0;
+	JobSystem::ParallelFor(64, [&sum](uint32_t i) { sum += i; }, 1);
+	NR_CHECK(sum == 64 * 63 / 2);
+	NR_CHECK(!unrelatedRanOnMainThread);
+
+	release = true;
+	JobSystem::Wait(blocker);
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,97 @@
+#include "Test.h"
+
+#include <cstring>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Core/JobSystem.h"
+#include "NotRed/Platform/Vulkan/VKShader.h"
+#include "NotRed/Platform/Vulkan/VKMaterial.h"
+
+// The shader is only compiled and reflected, no device is needed to create materials and set their uniforms
+
+using namespace NR;
+
+namespace
+{
+	constexpr MaterialPropertyID Exposure("uUniforms.Exposure");
+	constexpr MaterialPropertyID BloomIntensity("uUniforms.BloomIntensity");
+
+	Ref<VKMaterial> CreateCompositeMaterial()
+	{
+		Ref<Shader> shader = Ref<VKShader>::Create("Resources/Shaders/SceneComposite", false, false);
+		return Ref<VKMaterial>::Create(shader, "Composite");
+	}
+}
+
+NR_TEST(Material, UniformHandlesWriteWhereTheIDsDo)
+{
+	if (!Test::EnterEditorDirectory())
+	{
+		return;
+	}
+
+	JobSystem::Init(2);
+	Ref<VKMaterial> material = CreateCompositeMaterial();
+
+	const MaterialUniformHandle exposure = material->GetUniformHandle(Exposure);
+	NR_CHECK(exposure.IsValid());
+	NR_CHECK(exposure.Size == sizeof(float));
+	NR_CHECK(!material->GetUniformHandle(MaterialPropertyID("uUniforms.DoesNotExist")).IsValid());
+
+	material->Set(exposure, 2.5f);
+	NR_CHECK(material->GetFloat(Exposure) == 2.5f);
+	material->Set(BloomIntensity, 0.5f);
+	NR_CHECK(material->GetFloat(BloomIntensity) == 0.5f);
+	NR_CHECK(material->GetFloat(Exposure) == 2.5f);
+
+	// A handle never writes outside of the uniform or the storage, even when the value is larger
+	const Buffer storage = material->GetUniformStorageBuffer();
+	std::vector<uint8_t> before((uint8_t*)storage.Data, (uint8_t*)storage.Data + storage.Size);
+	material->Set(exposure, glm::mat4(3.0f));
+	NR_CHECK(material->GetFloat(Exposure) == 3.0f);
+	NR_CHECK(std::memcmp(before.data() + exposure.Offset + exposure.Size, (uint8_t*)storage.Data + exposure.Offset + exposure.Size, storage.Size - exposure.Offset - exposure.Size) == 0);
+
+	MaterialUniformHandle outOfBounds = exposure;
+	outOfBounds.Offset = (uint32_t)storage.Size;
+	material->Set(outOfBounds, 1.0f);
+	NR_CHECK(material->GetFloat(Exposure) == 3.0f);
+
+	JobSystem::Shutdown();
+}
+
+NR_BENCHMARK(Material, SetUniformByNameIDAndHandle)
+{
+	if (!Test::EnterEditorDirectory())
+	{
+		return;
+	}
+
+	constexpr uint64_t Iterations = 1000000;
+
+	JobSystem::Init(2);
+	Ref<VKMaterial> material = CreateCompositeMaterial();
+	Material& base = *material;
+
+	// The string path is what every per-frame Set went through before the IDs, it hashes the name on each call
+	const std::string exposureName = "uUniforms.Exposure";
+	Test::Measure("Set(std::string, float)", Iterations, [&](uint64_t i)
+		{
+			base.Set(exposureName, (float)i);
+		});
+
+	Test::Measure("Set(MaterialPropertyID, float)", Iterations, [&](uint64_t i)
+		{
+			base.Set(Exposure, (float)i);
+		});
+
+	const MaterialUniformHandle exposure = base.GetUniformHandle(Exposure);
+	Test::Measure("Set(MaterialUniformHandle, float)", Iterations, [&](uint64_t i)
+		{
+			base.Set(exposure, (float)i);
+		});
+
+	NR_CHECK(material->GetFloat(Exposure) == (float)(Iterations - 1));
+	Test::DoNotOptimize(material->GetUniformStorageBuffer().Data);
+
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,129 @@
+#include "Test.h"
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Renderer/Mesh.h"
+#include "NotRed/Renderer/MeshCache.h"
+
+// Meshes are created without GPU resources, they are only imported or loaded from their cooked file
+
+using namespace NR;
+
+namespace
+{
+	// Runs a case in an empty directory, so the cooked meshes it writes to Resources/Cache/Mesh are its own
+	class ScopedTestDirectory
+	{
+	public:
+		explicit ScopedTestDirectory(const char* name)
+			: mPreviousPath(std::filesystem::current_path()), mPath(std::filesystem::temp_directory_path() / name)
+		{
+			std::filesystem::remove_all(mPath);
+			std::filesystem::create_directories(mPath);
+			std::filesystem::current_path(mPath);
+		}
+
+		~ScopedTestDirectory()
+		{
+			std::filesystem::current_path(mPreviousPath);
+			std::error_code error;
+			std::filesystem::remove_all(mPath, error);
+		}
+
+	private:
+		std::filesystem::path mPreviousPath;
+		std::filesystem::path mPath;
+	};
+
+	void WriteQuad(const char* path)
+	{
+		std::ofstream stream(path);
+		stream << "v -1 0 -1\nv 1 0 -1\nv 1 0 1\nv -1 0 1\nvn 0 1 0\nvt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n";
+		stream << "f 1/1/1 2/2/1 3/3/1\nf 1/1/1 3/3/1 4/4/1\n";
+	}
+}
+
+NR_TEST(MeshCache, ConcurrentStoresOfTheSameSourceLeaveOneValidFile)
+{
+	ScopedTestDirectory directory("NotRedMeshCacheTest");
+	WriteQuad("Quad.obj");
+
+	Ref<MeshSource> imported = Ref<MeshSource>::Create("Quad.obj", false);
+	NR_CHECK(imported->GetVertices().size() == 4);
+
+	// Every thread cooks the same source over and over, each write has to land as a whole
+	constexpr uint32_t ThreadCount = 8;
+	constexpr uint32_t StoresPerThread = 50;
+	std::vector<std::thread> threads;
+	for (uint32_t i = 0; i < ThreadCount; ++i)
+	{
+		threads.emplace_back([&imported]()
+			{
+				for (uint32_t store = 0; store < StoresPerThread; ++store)
+				{
+					MeshCache::Store("Quad.obj", *imported, { "Quad.obj" });
+				}
+			});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	const std::filesystem::path cookedPath = MeshCache::GetCookedPath("Quad.obj");
+	NR_CHECK(std::filesystem::exists(cookedPath));
+
+	uint32_t leftoverFiles = 0;
+	for (const auto& entry : std::filesystem::directory_iterator(cookedPath.parent_path()))
+	{
+		leftoverFiles += entry.path() != cookedPath ? 1 : 0;
+	}
+	NR_CHECK(leftoverFiles == 0);
+
+	Ref<MeshSource> cooked = Ref<MeshSource>::Create("Quad.obj", false);
+	NR_CHECK(cooked->GetVertices().size() == imported->GetVertices().size());
+	NR_CHECK(cooked->GetIndices().size() == imported->GetIndices().size());
+	NR_CHECK(cooked->GetSubmeshes().size() == imported->GetSubmeshes().size());
+}
+
+NR_BENCHMARK(MeshCache, ImportVersusCookedLoad)
+{
+	if (!Test::EnterEditorDirectory())
+	{
+		return;
+	}
+
+	// The editor's default meshes and the rigged mesh of the sandbox project
+	const char* meshes[] = {
+		"Resources/Meshes/Default/Cube.fbx",
+		"Resources/Meshes/Default/Sphere.fbx",
+		"Resources/Meshes/Default/Torus.fbx",
+		"SandboxProject/Assets/Meshes/Source/mosin/Mosin.fbx"
+	};
+
+	for (const char* mesh : meshes)
+	{
+		const std::string cookedPath = MeshCache::GetCookedPath(mesh);
+		size_t vertexCount = 0;
+
+		// Removing the cooked mesh makes every construction import the source with Assimp and cook it again
+		Test::Measure(std::string(mesh) + ": import and cook", 5, [&](uint64_t)
+			{
+				std::filesystem::remove(cookedPath);
+				Ref<MeshSource> source = Ref<MeshSource>::Create(mesh, false);
+				vertexCount = source->GetVertices().size();
+			});
+
+		bool sameAsImported = true;
+		Test::Measure(std::string(mesh) + ": load cooked", 20, [&](uint64_t)
+			{
+				Ref<MeshSource> source = Ref<MeshSource>::Create(mesh, false);
+				sameAsImported &= source->GetVertices().size() == vertexCount;
+			});
+		NR_CHECK(vertexCount > 0);
+		NR_CHECK(sameAsImported);
+	}
+}
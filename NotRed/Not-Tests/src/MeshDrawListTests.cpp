@@ -0,0 +1,242 @@
+#include "Test.h"
+
+#include <map>
+#include <random>
+
+#include <glm/glm.hpp>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Renderer/MeshDrawList.h"
+
+using namespace NR;
+
+namespace
+{
+	struct TransformVertexData
+	{
+		glm::vec4 MRow[3];
+	};
+
+	// A scene submits meshes in entity order, not grouped by mesh or material
+	struct Submit
+	{
+		AssetHandle MeshHandle;
+		AssetHandle MaterialHandle;
+		uint32_t SubmeshIndex;
+		bool Rigged;
+		TransformVertexData Transform;
+	};
+
+	std::vector<Submit> CreateSubmits(uint32_t instanceCount, uint32_t meshCount, uint32_t seed)
+	{
+		std::mt19937_64 random(seed);
+		std::vector<AssetHandle> meshes(meshCount);
+		std::vector<AssetHandle> materials(meshCount * 2);
+		for (AssetHandle& handle : meshes)
+		{
+			handle = AssetHandle(random());
+		}
+		for (AssetHandle& handle : materials)
+		{
+			handle = AssetHandle(random());
+		}
+
+		std::vector<Submit> submits(instanceCount);
+		for (uint32_t i = 0; i < instanceCount; ++i)
+		{
+			const uint32_t mesh = (uint32_t)(random() % meshCount);
+			Submit& submit = submits[i];
+			submit.MeshHandle = meshes[mesh];
+			submit.SubmeshIndex = (uint32_t)(random() % 3);
+			submit.MaterialHandle = materials[mesh * 2 + submit.SubmeshIndex % 2];
+			submit.Rigged = mesh % 10 == 0;
+			submit.Transform.MRow[0] = { 1.0f, 0.0f, 0.0f, (float)i };
+			submit.Transform.MRow[1] = { 0.0f, 1.0f, 0.0f, 0.0f };
+			submit.Transform.MRow[2] = { 0.0f, 0.0f, 1.0f, 0.0f };
+		}
+		return submits;
+	}
+
+	// What SceneRenderer::SubmitMesh and PreRender did before the flat lists, one std::map node per mesh, material and submesh
+	struct MapDrawList
+	{
+		struct MeshKey
+		{
+			AssetHandle MeshHandle;
+			AssetHandle MaterialHandle;
+			uint32_t SubmeshIndex;
+
+			bool operator<(const MeshKey& other) const
+			{
+				if (MeshHandle < other.MeshHandle)
+				{
+					return true;
+				}
+
+				if ((MeshHandle == other.MeshHandle) && (SubmeshIndex < other.SubmeshIndex))
+				{
+					return true;
+				}
+
+				return (MeshHandle == other.MeshHandle) && (SubmeshIndex == other.SubmeshIndex) && (MaterialHandle < other.MaterialHandle);
+			}
+		};
+
+		struct DrawCommand
+		{
+			uint32_t SubmeshIndex;
+			uint32_t InstanceCount = 0;
+		};
+
+		struct TransformMapData
+		{
+			std::vector<TransformVertexData> Transforms;
+			uint32_t TransformOffset = 0;
+		};
+
+		std::map<MeshKey, DrawCommand> DrawList;
+		std::map<MeshKey, TransformMapData> TransformMap;
+		std::vector<TransformVertexData> TransformData;
+
+		void Frame(const std::vector<Submit>& submits)
+		{
+			DrawList.clear();
+			TransformMap.clear();
+
+			for (const Submit& submit : submits)
+			{
+				const MeshKey key = { submit.MeshHandle, submit.MaterialHandle, submit.SubmeshIndex };
+				TransformMap[key].Transforms.push_back(submit.Transform);
+
+				DrawCommand& dc = DrawList[key];
+				dc.SubmeshIndex = submit.SubmeshIndex;
+				dc.InstanceCount++;
+			}
+
+			uint32_t index = 0;
+			for (auto& [key, transformData] : TransformMap)
+			{
+				transformData.TransformOffset = index * sizeof(TransformVertexData);
+				for (const auto& transform : transformData.Transforms)
+				{
+					TransformData[index++] = transform;
+				}
+			}
+		}
+	};
+
+	// What SceneRenderer does now, the transforms go straight into the upload array and the instances only refer to them
+	struct FlatDrawList
+	{
+		MeshDrawList DrawList;
+		std::vector<TransformVertexData> Transforms;
+		std::vector<InstanceVertexData> InstanceData;
+
+		void Frame(const std::vector<Submit>& submits)
+		{
+			DrawList.Clear();
+			Transforms.clear();
+			InstanceData.clear();
+
+			for (const Submit& submit : submits)
+			{
+				const uint32_t transformIndex = (uint32_t)Transforms.size();
+				Transforms.push_back(submit.Transform);
+
+				const uint32_t instanceIndex = (uint32_t)DrawList.Instances.size();
+				const uint32_t boneTransformsIndex = submit.Rigged ? transformIndex : DrawInstance::NoBoneTransforms;
+				const uint64_t sortKey = MeshDrawList::SortKey(submit.Rigged, submit.MeshHandle, submit.MaterialHandle, submit.SubmeshIndex);
+				DrawList.Instances.push_back({ sortKey, submit.MeshHandle, submit.MaterialHandle, 0, submit.SubmeshIndex, transformIndex, boneTransformsIndex });
+				DrawList.SortEntries.push_back({ sortKey, instanceIndex });
+			}
+
+			DrawList.BuildCommands(InstanceData);
+		}
+	};
+}
+
+NR_TEST(MeshDrawList, BatchesEveryMeshMaterialAndSubmeshOnce)
+{
+	const std::vector<Submit> submits = CreateSubmits(5000, 50, 1);
+
+	FlatDrawList flat;
+	flat.Frame(submits);
+	MapDrawList map;
+	map.TransformData.resize(submits.size());
+	map.Frame(submits);
+
+	// One draw per distinct key, like the map, covering every instance exactly once
+	NR_CHECK(flat.DrawList.Commands.size() == map.DrawList.size());
+	NR_CHECK(flat.InstanceData.size() == submits.size());
+
+	bool batchesAreConsistent = true;
+	std::vector<bool> drawn(submits.size(), false);
+	uint32_t expectedOffset = 0;
+	for (const DrawCommand& dc : flat.DrawList.Commands)
+	{
+		batchesAreConsistent &= dc.InstanceOffset == expectedOffset * sizeof(InstanceVertexData);
+
+		const uint32_t first = flat.InstanceData[expectedOffset].TransformIndex;
+		const Submit& batch = submits[first];
+		for (uint32_t i = expectedOffset; i < expectedOffset + dc.InstanceCount; ++i)
+		{
+			const uint32_t transformIndex = flat.InstanceData[i].TransformIndex;
+			const Submit& submit = submits[transformIndex];
+			batchesAreConsistent &= submit.MeshHandle == batch.MeshHandle && submit.MaterialHandle == batch.MaterialHandle && submit.SubmeshIndex == dc.SubmeshIndex;
+			batchesAreConsistent &= flat.InstanceData[i].BoneTransformsIndex == (submit.Rigged ? transformIndex : 0);
+			batchesAreConsistent &= !drawn[transformIndex];
+			drawn[transformIndex] = true;
+		}
+
+		// The sort is stable, instances of a batch keep their submission order
+		for (uint32_t i = expectedOffset + 1; i < expectedOffset + dc.InstanceCount; ++i)
+		{
+			batchesAreConsistent &= flat.InstanceData[i - 1].TransformIndex < flat.InstanceData[i].TransformIndex;
+		}
+
+		const MapDrawList::MeshKey key = { batch.MeshHandle, batch.MaterialHandle, batch.SubmeshIndex };
+		batchesAreConsistent &= map.DrawList.count(key) && map.DrawList.at(key).InstanceCount == dc.InstanceCount;
+		expectedOffset += dc.InstanceCount;
+	}
+	NR_CHECK(batchesAreConsistent);
+
+	// The rigged bit is the top of the key, so rigged batches come after every static one
+	bool riggedLast = true;
+	bool seenRigged = false;
+	for (const DrawCommand& dc : flat.DrawList.Commands)
+	{
+		const bool rigged = submits[flat.InstanceData[dc.InstanceOffset / sizeof(InstanceVertexData)].TransformIndex].Rigged;
+		riggedLast &= rigged || !seenRigged;
+		seenRigged |= rigged;
+	}
+	NR_CHECK(riggedLast);
+}
+
+NR_BENCHMARK(MeshDrawList, BuildDrawCommandsVersusStdMap)
+{
+	constexpr uint64_t Frames = 20;
+
+	// A few hundred distinct meshes, each with three submeshes and two materials
+	for (uint32_t instanceCount : { 10000u, 100000u })
+	{
+		const std::vector<Submit> submits = CreateSubmits(instanceCount, 300, instanceCount);
+		const std::string count = std::to_string(instanceCount / 1000) + "k instances";
+
+		MapDrawList map;
+		map.TransformData.resize(submits.size());
+		Test::Measure(count + ", std::map", Frames, [&](uint64_t)
+			{
+				map.Frame(submits);
+			});
+		Test::DoNotOptimize(map.TransformData);
+
+		FlatDrawList flat;
+		Test::Measure(count + ", sorted flat arrays", Frames, [&](uint64_t)
+			{
+				flat.Frame(submits);
+			});
+		Test::DoNotOptimize(flat.InstanceData);
+
+		NR_CHECK(flat.DrawList.Commands.size() == map.DrawList.size());
+	}
+}
@@ -0,0 +1,139 @@
+#include "Test.h"
+
+#include <string>
+#include <vector>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Core/JobSystem.h"
+#include "NotRed/Scene/Scene.h"
+#include "NotRed/Scene/Entity.h"
+#include "NotRed/Physics/3D/PhysicsManager.h"
+#include "NotRed/Physics/3D/PhysicsInternal.h"
+#include "NotRed/Physics/3D/PhysicsScene.h"
+
+// Entity scenes are created without initializing them, the physics scene is created and filled by the test instead
+
+using namespace NR;
+
+namespace
+{
+	bool Equal(const glm::mat4& a, const glm::mat4& b)
+	{
+		for (int column = 0; column < 4; ++column)
+		{
+			for (int row = 0; row < 4; ++row)
+			{
+				if (glm::abs(a[column][row] - b[column][row]) > 1e-4f)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	glm::mat4 Translation(const glm::vec3& translation)
+	{
+		return glm::translate(glm::mat4(1.0f), translation);
+	}
+
+	// Falling boxes far enough apart to never touch, each with a child entity that is drawn along with it
+	Ref<Scene> CreateFallingBoxes(uint32_t count, std::vector<Entity>& outChildren)
+	{
+		Ref<Scene> scene = Ref<Scene>::Create("Interpolation", false, false);
+
+		constexpr uint32_t RowLength = 100;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Entity body = scene->CreateEntity("Body");
+			body.Transform().Translation = { (float)(i % RowLength) * 2.0f, 10.0f, (float)(i / RowLength) * 2.0f };
+			body.MarkTransformDirty();
+			body.AddComponent<RigidBodyComponent>().BodyType = RigidBodyComponent::Type::Dynamic;
+			body.AddComponent<BoxColliderComponent>();
+
+			Entity child = scene->CreateChildEntity(body, "Child");
+			child.Transform().Translation = { 0.0f, 1.0f, 0.0f };
+			child.MarkTransformDirty();
+			outChildren.push_back(child);
+		}
+
+		return scene;
+	}
+}
+
+NR_TEST(PhysicsScene, RenderTransformFollowsTheInterpolatedAncestor)
+{
+	Ref<Scene> scene = Ref<Scene>::Create("Interpolation", false, false);
+
+	Entity body = scene->CreateEntity("Body");
+	body.Transform().Translation = { 1.0f, 0.0f, 0.0f };
+	body.MarkTransformDirty();
+	body.AddComponent<RigidBodyComponent>();
+
+	Entity child = scene->CreateChildEntity(body, "Child");
+	child.Transform().Translation = { 0.0f, 2.0f, 0.0f };
+	child.MarkTransformDirty();
+
+	Entity grandChild = scene->CreateChildEntity(child, "GrandChild");
+	grandChild.Transform().Translation = { 0.0f, 0.0f, 3.0f };
+	grandChild.MarkTransformDirty();
+
+	// The body is halfway between two steps, drawn four units ahead of its simulated pose
+	auto& interpolatedTransform = body.AddComponent<InterpolatedTransformComponent>();
+	interpolatedTransform.Transform = Translation({ 5.0f, 0.0f, 0.0f });
+	interpolatedTransform.Active = true;
+
+	NR_CHECK(Equal(scene->GetRenderTransformMatrix(body, true), Translation({ 5.0f, 0.0f, 0.0f })));
+	NR_CHECK(Equal(scene->GetRenderTransformMatrix(child, true), Translation({ 5.0f, 2.0f, 0.0f })));
+	NR_CHECK(Equal(scene->GetRenderTransformMatrix(grandChild, true), Translation({ 5.0f, 2.0f, 3.0f })));
+
+	// The editor draws the hierarchy as it is
+	NR_CHECK(Equal(scene->GetRenderTransformMatrix(grandChild, false), Translation({ 1.0f, 2.0f, 3.0f })));
+
+	// Once the body stops, the slot stays but everything is drawn at the simulated pose again
+	body.GetComponent<InterpolatedTransformComponent>().Active = false;
+	NR_CHECK(Equal(scene->GetRenderTransformMatrix(body, true), Translation({ 1.0f, 0.0f, 0.0f })));
+	NR_CHECK(Equal(scene->GetRenderTransformMatrix(grandChild, true), Translation({ 1.0f, 2.0f, 3.0f })));
+}
+
+NR_BENCHMARK(PhysicsScene, InterpolateTenThousandBodies)
+{
+	constexpr uint32_t BodyCount = 10000;
+	constexpr uint64_t Frames = 300;
+	constexpr float dt = 1.0f / 144.0f;
+
+	PhysicsManager::Init();
+	JobSystem::Init();
+
+	// Frames at 144Hz against 100Hz physics, so most frames land between two steps. Nothing collides, every body falls the whole time.
+	for (bool interpolate : { false, true })
+	{
+		const std::string mode = interpolate ? "interpolated" : "not interpolated";
+
+		std::vector<Entity> children;
+		Ref<Scene> scene = CreateFallingBoxes(BodyCount, children);
+
+		PhysicsSettings settings;
+		settings.InterpolateTransforms = interpolate;
+		{
+			Ref<PhysicsScene> physicsScene = Ref<PhysicsScene>::Create(settings);
+			physicsScene->InitializeScene(scene);
+
+			Test::Measure("Simulate, 10k bodies, " + mode, Frames, [&physicsScene](uint64_t)
+				{
+					physicsScene->Simulate(dt);
+				});
+
+			Test::Measure("GetRenderTransformMatrix, 10k children, " + mode, Frames, [&scene, &children](uint64_t)
+				{
+					for (Entity child : children)
+					{
+						Test::DoNotOptimize(scene->GetRenderTransformMatrix(child, true));
+					}
+				});
+		}
+	}
+
+	JobSystem::Shutdown();
+	PhysicsInternal::Shutdown();
+}
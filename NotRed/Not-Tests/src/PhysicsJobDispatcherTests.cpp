@@ -0,0 +1,161 @@
+#include "Test.h"
+
+#include <cmath>
+#include <thread>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Core/JobSystem.h"
+#include "NotRed/Physics/3D/PhysicsInternal.h"
+#include "NotRed/Physics/3D/PhysicsJobDispatcher.h"
+
+// Plain PhysX scenes of stacked boxes, without an entity scene or physics layers, so the dispatcher is the only difference
+
+using namespace NR;
+
+namespace
+{
+	constexpr float FixedDeltaTime = 1.0f / 60.0f;
+
+	// Stacks of unit boxes on a ground plane, laid out in a square grid
+	struct StackedBoxes
+	{
+		physx::PxScene* Scene = nullptr;
+		physx::PxMaterial* Material = nullptr;
+		std::vector<physx::PxRigidDynamic*> Boxes;
+
+		StackedBoxes(physx::PxCpuDispatcher* dispatcher, uint32_t stackCount, uint32_t stackHeight)
+		{
+			physx::PxPhysics& physics = PhysicsInternal::GetPhysicsSDK();
+
+			// The flags PhysicsScene creates its scenes with
+			physx::PxSceneDesc sceneDesc(physics.getTolerancesScale());
+			sceneDesc.flags |= physx::PxSceneFlag::eENABLE_PCM | physx::PxSceneFlag::eENABLE_ENHANCED_DETERMINISM;
+			sceneDesc.gravity = physx::PxVec3(0.0f, -9.81f, 0.0f);
+			sceneDesc.filterShader = physx::PxDefaultSimulationFilterShader;
+			sceneDesc.cpuDispatcher = dispatcher;
+			Scene = physics.createScene(sceneDesc);
+
+			Material = physics.createMaterial(0.6f, 0.6f, 0.0f);
+			Scene->addActor(*physx::PxCreatePlane(physics, physx::PxPlane(0.0f, 1.0f, 0.0f, 0.0f), *Material));
+
+			const uint32_t rowLength = (uint32_t)std::ceil(std::sqrt((float)stackCount));
+			for (uint32_t stack = 0; stack < stackCount; ++stack)
+			{
+				const float x = (float)(stack % rowLength) * 2.0f;
+				const float z = (float)(stack / rowLength) * 2.0f;
+				for (uint32_t level = 0; level < stackHeight; ++level)
+				{
+					// A small gap between the boxes, so the stacks settle before they sleep
+					const physx::PxTransform pose(physx::PxVec3(x, 0.5f + level * 1.05f, z));
+					physx::PxRigidDynamic* box = physx::PxCreateDynamic(physics, pose, physx::PxBoxGeometry(0.5f, 0.5f, 0.5f), *Material, 1.0f);
+					Scene->addActor(*box);
+					Boxes.push_back(box);
+				}
+			}
+		}
+
+		~StackedBoxes()
+		{
+			// The actors go with the scene, the dispatcher has to outlive it
+			Scene->release();
+			Material->release();
+		}
+
+		void Step()
+		{
+			Scene->simulate(FixedDeltaTime);
+			Scene->fetchResults(true);
+		}
+	};
+
+	std::vector<uint32_t> GetThreadCounts()
+	{
+		const uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		std::vector<uint32_t> threadCounts;
+		for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+		{
+			threadCounts.push_back(threads);
+		}
+		threadCounts.push_back(maxThreads);
+		return threadCounts;
+	}
+}
+
+NR_TEST(PhysicsJobDispatcher, StacksSettleLikeWithTheDefaultDispatcher)
+{
+	PhysicsInternal::Initialize();
+	JobSystem::Init(4);
+
+	PhysicsJobDispatcher jobDispatcher;
+	physx::PxDefaultCpuDispatcher* defaultDispatcher = physx::PxDefaultCpuDispatcherCreate(4);
+	NR_CHECK(jobDispatcher.getWorkerCount() == JobSystem::GetWorkerCount());
+	jobDispatcher.SetWorkerCount(2);
+	NR_CHECK(jobDispatcher.getWorkerCount() == 2);
+	jobDispatcher.SetWorkerCount(0);
+
+	{
+		StackedBoxes jobs(&jobDispatcher, 16, 10);
+		StackedBoxes reference(defaultDispatcher, 16, 10);
+		for (uint32_t step = 0; step < 120; ++step)
+		{
+			jobs.Step();
+			reference.Step();
+		}
+
+		// Every stack is still standing and every box is where the default dispatcher put it
+		bool standing = true;
+		bool sameAsReference = true;
+		for (size_t i = 0; i < jobs.Boxes.size(); ++i)
+		{
+			const physx::PxVec3 position = jobs.Boxes[i]->getGlobalPose().p;
+			standing &= position.y > 0.4f && position.y < 10.5f;
+			sameAsReference &= (position - reference.Boxes[i]->getGlobalPose().p).magnitude() < 0.01f;
+		}
+		NR_CHECK(standing);
+		NR_CHECK(sameAsReference);
+	}
+
+	defaultDispatcher->release();
+	JobSystem::Shutdown();
+	PhysicsInternal::Shutdown();
+}
+
+NR_BENCHMARK(PhysicsJobDispatcher, SimulateStackedBoxesPerThreadCount)
+{
+	constexpr uint32_t StackCount = 400;
+	constexpr uint32_t StackHeight = 10;
+	constexpr uint64_t Steps = 120;
+
+	PhysicsInternal::Initialize();
+
+	// Two seconds from the drop, the stacks collide and settle, most of them are asleep by the end
+	const std::string bodies = std::to_string(StackCount * StackHeight) + " boxes";
+	for (uint32_t threads : GetThreadCounts())
+	{
+		const std::string threadCount = std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+
+		JobSystem::Init(threads);
+		{
+			PhysicsJobDispatcher jobDispatcher;
+			StackedBoxes boxes(&jobDispatcher, StackCount, StackHeight);
+			Test::Measure(bodies + ", JobSystem, " + threadCount, Steps, [&](uint64_t)
+				{
+					boxes.Step();
+				});
+		}
+		JobSystem::Shutdown();
+
+		physx::PxDefaultCpuDispatcher* defaultDispatcher = physx::PxDefaultCpuDispatcherCreate(threads);
+		{
+			StackedBoxes boxes(defaultDispatcher, StackCount, StackHeight);
+			Test::Measure(bodies + ", PxDefaultCpuDispatcher, " + threadCount, Steps, [&](uint64_t)
+				{
+					boxes.Step();
+				});
+		}
+		defaultDispatcher->release();
+	}
+
+	PhysicsInternal::Shutdown();
+}
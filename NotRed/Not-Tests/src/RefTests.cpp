@@ -0,0 +1,171 @@
+#include "Test.h"
+
+#include <atomic>
+#include <thread>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Core/Ref.h"
+
+using namespace NR;
+
+namespace
+{
+	struct Counted : public RefCounted
+	{
+		std::atomic<uint32_t>* Destroyed = nullptr;
+
+		Counted() = default;
+		Counted(std::atomic<uint32_t>& destroyed)
+			: Destroyed(&destroyed)
+		{
+		}
+
+		~Counted()
+		{
+			if (Destroyed)
+			{
+				++*Destroyed;
+			}
+		}
+	};
+
+	template<typename Func>
+	void RunOnThreads(uint32_t threadCount, Func&& func)
+	{
+		std::vector<std::thread> threads;
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			threads.emplace_back([&func, i]() { func(i); });
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+}
+
+NR_TEST(Ref, ConcurrentCopiesKeepTheCountExact)
+{
+	std::atomic<uint32_t> destroyed = 0;
+	Ref<Counted> shared = Ref<Counted>::Create(destroyed);
+
+	RunOnThreads(4, [&shared](uint32_t)
+		{
+			for (uint32_t i = 0; i < 100000; ++i)
+			{
+				Ref<Counted> copy = shared;
+				Test::DoNotOptimize(copy);
+			}
+		});
+	NR_CHECK(shared->GetRefCount() == 1);
+	NR_CHECK(destroyed == 0);
+
+	shared = nullptr;
+	NR_CHECK(destroyed == 1);
+}
+
+NR_TEST(Ref, WeakRefNeverLocksADestroyedObject)
+{
+	std::atomic<uint32_t> destroyed = 0;
+	WeakRef<Counted> weak;
+	{
+		Ref<Counted> strong = Ref<Counted>::Create(destroyed);
+		weak = strong;
+		NR_CHECK(weak.IsValid());
+		NR_CHECK(weak.Lock() == strong);
+		NR_CHECK(strong->GetRefCount() == 1);
+	}
+	NR_CHECK(destroyed == 1);
+	NR_CHECK(!weak.IsValid());
+	NR_CHECK(!weak.Lock());
+
+	// The last strong reference is dropped while other threads keep locking, a lock either fails or sees a live object
+	for (uint32_t round = 0; round < 100; ++round)
+	{
+		Ref<Counted> strong = Ref<Counted>::Create(destroyed);
+		WeakRef<Counted> racing = strong;
+		const uint32_t destroyedBefore = destroyed;
+		std::atomic<bool> sawDestroyed = false;
+
+		RunOnThreads(4, [&](uint32_t thread)
+			{
+				if (thread == 0)
+				{
+					for (uint32_t i = 0; i < 100; ++i)
+					{
+						std::this_thread::yield();
+					}
+					strong = nullptr;
+					return;
+				}
+
+				for (uint32_t i = 0; i < 1000; ++i)
+				{
+					// Holding the locked reference, the object can't have been destroyed
+					if (Ref<Counted> locked = racing.Lock())
+					{
+						sawDestroyed = sawDestroyed || destroyed != destroyedBefore;
+					}
+				}
+			});
+
+		NR_CHECK(!sawDestroyed);
+		NR_CHECK(!racing.Lock());
+	}
+	NR_CHECK(destroyed == 101);
+}
+
+NR_BENCHMARK(Ref, CopyAndLockUnderContention)
+{
+	constexpr uint64_t Copies = 1000000;
+
+	Ref<Counted> shared = Ref<Counted>::Create();
+	WeakRef<Counted> weak = shared;
+
+	for (uint32_t threadCount : { 1u, 4u })
+	{
+		const std::string threads = std::to_string(threadCount) + (threadCount == 1 ? " thread" : " threads");
+
+		// Every thread copies the same Ref, so they all hit the same count
+		Test::Measure(threads + ", copy the same Ref 1M times each", 1, [&](uint64_t)
+			{
+				RunOnThreads(threadCount, [&shared](uint32_t)
+					{
+						for (uint64_t i = 0; i < Copies; ++i)
+						{
+							Ref<Counted> copy = shared;
+							Test::DoNotOptimize(copy);
+						}
+					});
+			});
+
+		// What every copy cost before the tracking became opt-in, the global live reference lock
+		Test::Measure(threads + ", copy the same Ref 1M times each, tracking live references", 1, [&](uint64_t)
+			{
+				RunOnThreads(threadCount, [&shared](uint32_t)
+					{
+						for (uint64_t i = 0; i < Copies; ++i)
+						{
+							Ref<Counted> copy = shared;
+							RefUtils::AddToLiveReferences(copy.Raw());
+							Test::DoNotOptimize(copy);
+						}
+					});
+			});
+		RefUtils::RemoveFromLiveReferences(shared.Raw());
+
+		Test::Measure(threads + ", lock the same WeakRef 1M times each", 1, [&](uint64_t)
+			{
+				RunOnThreads(threadCount, [&weak](uint32_t)
+					{
+						for (uint64_t i = 0; i < Copies; ++i)
+						{
+							Ref<Counted> locked = weak.Lock();
+							Test::DoNotOptimize(locked);
+						}
+					});
+			});
+	}
+
+	NR_CHECK(shared->GetRefCount() == 1);
+}
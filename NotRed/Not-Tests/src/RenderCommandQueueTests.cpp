@@ -0,0 +1,120 @@
+#include "Test.h"
+
+#include <cstdint>
+
+#include "NotRed/Renderer/Renderer.h"
+#include "NotRed/Renderer/RenderThread.h"
+#include "NotRed/Renderer/RenderCommandQueue.h"
+
+using namespace NR;
+
+namespace
+{
+	struct alignas(RenderCommandQueue::MaxCommandAlignment) OverAlignedPayload
+	{
+		uint64_t Values[8];
+	};
+
+	// Enough commands per frame to spill over several chunks
+	constexpr uint32_t CommandsPerFrame = 200000;
+	constexpr uint32_t FrameCount = 20;
+
+	template<typename SubmitFunc>
+	void MeasureFrames(const std::string& name, RenderThread& renderThread, SubmitFunc&& submit)
+	{
+		double submitMilliseconds = 0.0;
+		double executeMilliseconds = 0.0;
+		for (uint32_t frame = 0; frame < FrameCount; ++frame)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			for (uint32_t i = 0; i < CommandsPerFrame; ++i)
+			{
+				submit(i);
+			}
+			const auto submitted = std::chrono::steady_clock::now();
+			renderThread.NextFrame();
+			renderThread.Kick();
+			const auto executed = std::chrono::steady_clock::now();
+
+			submitMilliseconds += std::chrono::duration<double, std::milli>(submitted - start).count();
+			executeMilliseconds += std::chrono::duration<double, std::milli>(executed - submitted).count();
+		}
+
+		Test::ReportMeasurement(name + ": Submit", submitMilliseconds, (uint64_t)FrameCount * CommandsPerFrame);
+		Test::ReportMeasurement(name + ": swap and Execute", executeMilliseconds, (uint64_t)FrameCount * CommandsPerFrame);
+	}
+}
+
+NR_TEST(RenderCommandQueue, OverAlignedCommandsStayAlignedAcrossChunks)
+{
+	RenderCommandQueue queue;
+
+	uint32_t misaligned = 0;
+	uint64_t sum = 0;
+	auto command = [](void* ptr) { *(uint64_t*)ptr += 0; };
+	for (uint32_t i = 0; i < CommandsPerFrame; ++i)
+	{
+		// Alternate sizes so the padding in front of the payloads varies
+		const uint32_t size = i % 2 ? sizeof(OverAlignedPayload) : 8;
+		const uint32_t alignment = i % 2 ? RenderCommandQueue::MaxCommandAlignment : 8;
+		void* payload = queue.Allocate(command, size, alignment);
+		misaligned += ((uintptr_t)payload % alignment) ? 1 : 0;
+		*(uint64_t*)payload = i;
+	}
+
+	queue.Execute();
+
+	const RenderCommandQueue::Statistics& statistics = queue.GetStatistics();
+	NR_CHECK(misaligned == 0);
+	NR_CHECK(statistics.CommandCount == CommandsPerFrame);
+	NR_CHECK(statistics.ChunkCount > 1);
+
+	// The chunks are reused, a second frame of the same size doesn't grow the queue
+	for (uint32_t i = 0; i < CommandsPerFrame; ++i)
+	{
+		sum += (uintptr_t)queue.Allocate(command, sizeof(OverAlignedPayload), RenderCommandQueue::MaxCommandAlignment) % RenderCommandQueue::MaxCommandAlignment;
+	}
+	queue.Execute();
+	NR_CHECK(sum == 0);
+	NR_CHECK(queue.GetStatistics().ChunkCount == statistics.ChunkCount);
+}
+
+NR_BENCHMARK(RenderCommandQueue, SubmitAndExecute)
+{
+	RenderThread renderThread(ThreadingPolicy::SingleThreaded);
+	renderThread.Run();
+
+	// Grow both queues to their steady state size first
+	uint64_t counter = 0;
+	for (uint32_t frame = 0; frame < 2; ++frame)
+	{
+		for (uint32_t i = 0; i < CommandsPerFrame; ++i)
+		{
+			Renderer::Submit([&counter, payload = OverAlignedPayload{}]() { counter += payload.Values[0]; });
+		}
+		renderThread.Pump();
+	}
+
+	MeasureFrames("Small commands (200k per frame)", renderThread, [&counter](uint32_t i)
+		{
+			Renderer::Submit([&counter, i]() { counter += i; });
+		});
+	NR_CHECK(counter == (uint64_t)FrameCount * CommandsPerFrame * (CommandsPerFrame - 1) / 2);
+
+	counter = 0;
+	MeasureFrames("Over-aligned commands (200k per frame)", renderThread, [&counter](uint32_t i)
+		{
+			OverAlignedPayload payload{};
+			payload.Values[0] = 1;
+			Renderer::Submit([&counter, payload]() { counter += payload.Values[0]; });
+		});
+	NR_CHECK(counter == (uint64_t)FrameCount * CommandsPerFrame);
+
+	// Statistics are taken when the queues are swapped, the last over-aligned frame spans several chunks
+	renderThread.NextFrame();
+	NR_CHECK(Renderer::GetRenderCommandQueueStatistics().ChunkCount > 1);
+	renderThread.Kick();
+
+	Test::DoNotOptimize(counter);
+	renderThread.Terminate();
+}
@@ -0,0 +1,181 @@
+#include "Test.h"
+
+#include <atomic>
+#include <thread>
+
+#include "NotRed/Core/JobSystem.h"
+#include "NotRed/Renderer/Renderer.h"
+#include "NotRed/Renderer/RenderThread.h"
+
+// These run without a RendererAPI: the command queues and the kick/wait handshake don't need one as long as no command draws
+
+using namespace NR;
+
+NR_TEST(RenderThread, KickExecutesTheRecordedFrameOnce)
+{
+	RenderThread renderThread(ThreadingPolicy::SingleThreaded);
+	renderThread.Run();
+
+	std::vector<int> executed;
+	Renderer::Submit([&executed]() { executed.push_back(1); });
+	Renderer::Submit([&executed]() { executed.push_back(2); });
+
+	renderThread.NextFrame();
+	NR_CHECK(executed.empty());
+
+	renderThread.Kick();
+	NR_CHECK((executed == std::vector<int>{ 1, 2 }));
+	NR_CHECK(renderThread.GetState() == RenderThread::State::Idle);
+
+	renderThread.Pump();
+	NR_CHECK(executed.size() == 2);
+
+	renderThread.Terminate();
+}
+
+NR_TEST(RenderThread, NestedSubmitsRunInTheSameKick)
+{
+	RenderThread renderThread(ThreadingPolicy::SingleThreaded);
+	renderThread.Run();
+
+	std::vector<int> executed;
+	Renderer::Submit([&executed]()
+		{
+			executed.push_back(1);
+			Renderer::Submit([&executed]()
+				{
+					executed.push_back(3);
+					Renderer::Submit([&executed]() { executed.push_back(4); });
+				});
+		});
+	Renderer::Submit([&executed]() { executed.push_back(2); });
+
+	renderThread.NextFrame();
+	renderThread.Kick();
+	NR_CHECK((executed == std::vector<int>{ 1, 2, 3, 4 }));
+
+	// Nothing was left behind in the queue that records the next frame
+	renderThread.Pump();
+	NR_CHECK(executed.size() == 4);
+
+	renderThread.Terminate();
+}
+
+NR_TEST(RenderThread, StatisticsCoverTheExecutedFrame)
+{
+	RenderThread renderThread(ThreadingPolicy::SingleThreaded);
+	renderThread.Run();
+
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < 100; ++i)
+	{
+		Renderer::Submit([&count]() { ++count; });
+	}
+	Renderer::Submit([&count]() { Renderer::Submit([&count]() { ++count; }); });
+	renderThread.Pump();
+	NR_CHECK(count == 101);
+
+	// Statistics are taken when the queues are swapped, so they show up with the next frame
+	renderThread.NextFrame();
+	NR_CHECK(Renderer::GetRenderCommandQueueStatistics().CommandCount == 102);
+	renderThread.Kick();
+
+	renderThread.Terminate();
+}
+
+NR_TEST(RenderThread, MultiThreadedKickRunsOnTheRenderThread)
+{
+	RenderThread renderThread(ThreadingPolicy::MultiThreaded);
+	renderThread.Run();
+
+	const std::thread::id mainThreadID = std::this_thread::get_id();
+	std::vector<int> executed;
+	std::thread::id executedOn;
+	Renderer::Submit([&]()
+		{
+			executedOn = std::this_thread::get_id();
+			executed.push_back(1);
+			Renderer::Submit([&executed]() { executed.push_back(3); });
+		});
+	Renderer::Submit([&executed]() { executed.push_back(2); });
+
+	renderThread.NextFrame();
+	renderThread.Kick();
+	renderThread.BlockUntilRendering();
+	NR_CHECK((executed == std::vector<int>{ 1, 2, 3 }));
+	NR_CHECK(executedOn != mainThreadID);
+
+	renderThread.Terminate();
+}
+
+NR_TEST(RenderThread, MultiThreadedRecordsWhileThePreviousFrameExecutes)
+{
+	RenderThread renderThread(ThreadingPolicy::MultiThreaded);
+	renderThread.Run();
+
+	std::atomic<bool> release = false;
+	std::atomic<bool> started = false;
+	std::vector<int> executed;
+	Renderer::Submit([&]()
+		{
+			started = true;
+			while (!release)
+			{
+				std::this_thread::yield();
+			}
+			executed.push_back(1);
+			// Lands in the queue being executed, not the one the main thread is recording into
+			Renderer::Submit([&executed]() { executed.push_back(2); });
+		});
+
+	renderThread.NextFrame();
+	renderThread.Kick();
+	while (!started)
+	{
+		std::this_thread::yield();
+	}
+
+	// The render thread is still busy with the first frame, record the next one meanwhile
+	NR_CHECK(renderThread.GetState() == RenderThread::State::Busy);
+	for (int i = 0; i < 1000; ++i)
+	{
+		Renderer::Submit([&executed]() { executed.push_back(3); });
+	}
+	release = true;
+
+	renderThread.BlockUntilRendering();
+	NR_CHECK((executed == std::vector<int>{ 1, 2 }));
+
+	renderThread.NextFrame();
+	renderThread.Kick();
+	renderThread.BlockUntilRendering();
+	NR_CHECK(executed.size() == 1002);
+
+	renderThread.Terminate();
+}
+
+NR_TEST(RenderThread, JobsWithoutADeferredListSubmitAtTheNextSwap)
+{
+	JobSystem::Init(2);
+	RenderThread renderThread(ThreadingPolicy::SingleThreaded);
+	renderThread.Run();
+
+	std::vector<int> executed;
+	Renderer::Submit([&executed]() { executed.push_back(1); });
+
+	// The job never sets a deferred command list, its commands still reach the frame recorded on the main thread
+	Ref<JobCounter> counter = Ref<JobCounter>::Create();
+	JobSystem::Schedule([&executed]()
+		{
+			Renderer::Submit([&executed]() { executed.push_back(2); });
+			Renderer::Submit([&executed]() { executed.push_back(3); });
+		}, "SubmitWithoutList", counter);
+	JobSystem::Block(counter);
+	NR_CHECK(executed.empty());
+
+	renderThread.Pump();
+	NR_CHECK((executed == std::vector<int>{ 1, 2, 3 }));
+
+	renderThread.Terminate();
+	JobSystem::Shutdown();
+}
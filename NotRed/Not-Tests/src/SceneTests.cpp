@@ -0,0 +1,258 @@
+#include "Test.h"
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Scene/Scene.h"
+#include "NotRed/Scene/Entity.h"
+
+// Scenes are created without initializing them, which leaves out physics, scripting and rendering
+
+using namespace NR;
+
+namespace
+{
+	bool IsTransformDirty(Entity entity)
+	{
+		return entity.GetComponent<WorldTransformComponent>().Dirty;
+	}
+
+	bool Equal(const glm::mat4& a, const glm::mat4& b)
+	{
+		for (int column = 0; column < 4; ++column)
+		{
+			for (int row = 0; row < 4; ++row)
+			{
+				if (glm::abs(a[column][row] - b[column][row]) > 1e-4f)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// What GetWorldSpaceTransformMatrix did before the world transforms were cached, walks up the whole parent chain every time
+	glm::mat4 GetUncachedWorldTransform(Scene& scene, Entity entity)
+	{
+		glm::mat4 transform = entity.Transform().GetTransform();
+		for (Entity parent = scene.FindEntityByID(entity.GetParentID()); parent; parent = scene.FindEntityByID(parent.GetParentID()))
+		{
+			transform = parent.Transform().GetTransform() * transform;
+		}
+		return transform;
+	}
+}
+
+NR_TEST(Scene, MovingAParentMarksOnlyItsSubtreeDirty)
+{
+	Ref<Scene> scene = Ref<Scene>::Create("Transforms", false, false);
+
+	Entity root = scene->CreateEntity("Root");
+	Entity child = scene->CreateChildEntity(root, "Child");
+	Entity grandChild = scene->CreateChildEntity(child, "GrandChild");
+	Entity sibling = scene->CreateChildEntity(root, "Sibling");
+	grandChild.Transform().Translation = { 0.0f, 0.0f, 1.0f };
+	grandChild.MarkTransformDirty();
+
+	scene->UpdateWorldTransforms();
+	NR_CHECK(!IsTransformDirty(root) && !IsTransformDirty(child) && !IsTransformDirty(grandChild) && !IsTransformDirty(sibling));
+
+	child.Transform().Translation = { 2.0f, 0.0f, 0.0f };
+	child.MarkTransformDirty();
+	NR_CHECK(!IsTransformDirty(root));
+	NR_CHECK(IsTransformDirty(child) && IsTransformDirty(grandChild));
+	NR_CHECK(!IsTransformDirty(sibling));
+
+	// Reading rebuilds the entity and its dirty ancestors right away, without waiting for the next update
+	NR_CHECK(Equal(scene->GetWorldSpaceTransformMatrix(grandChild), glm::translate(glm::mat4(1.0f), { 2.0f, 0.0f, 1.0f })));
+	NR_CHECK(!IsTransformDirty(child) && !IsTransformDirty(grandChild));
+
+	root.Transform().Scale = { 2.0f, 2.0f, 2.0f };
+	root.MarkTransformDirty();
+	scene->UpdateWorldTransforms();
+	NR_CHECK(Equal(scene->GetWorldSpaceTransformMatrix(grandChild), GetUncachedWorldTransform(*scene, grandChild)));
+	NR_CHECK(Equal(scene->GetWorldSpaceTransformMatrix(sibling), GetUncachedWorldTransform(*scene, sibling)));
+}
+
+NR_TEST(Scene, ReparentingRebuildsTheWorldTransform)
+{
+	Ref<Scene> scene = Ref<Scene>::Create("Transforms", false, false);
+
+	Entity a = scene->CreateEntity("A");
+	Entity b = scene->CreateEntity("B");
+	Entity child = scene->CreateChildEntity(a, "Child");
+	a.Transform().Translation = { 1.0f, 0.0f, 0.0f };
+	b.Transform().Translation = { 0.0f, 5.0f, 0.0f };
+	a.MarkTransformDirty();
+	b.MarkTransformDirty();
+	scene->UpdateWorldTransforms();
+	NR_CHECK(Equal(scene->GetWorldSpaceTransformMatrix(child), glm::translate(glm::mat4(1.0f), { 1.0f, 0.0f, 0.0f })));
+
+	// ParentEntity keeps the world transform and adjusts the local one
+	scene->ParentEntity(child, b);
+	scene->UpdateWorldTransforms();
+	NR_CHECK(Equal(scene->GetWorldSpaceTransformMatrix(child), glm::translate(glm::mat4(1.0f), { 1.0f, 0.0f, 0.0f })));
+	NR_CHECK(Equal(scene->GetWorldSpaceTransformMatrix(child), GetUncachedWorldTransform(*scene, child)));
+
+	// Unparenting without converting keeps the local transform
+	scene->UnparentEntity(child, false);
+	NR_CHECK(Equal(scene->GetWorldSpaceTransformMatrix(child), glm::translate(glm::mat4(1.0f), { 1.0f, -5.0f, 0.0f })));
+}
+
+NR_BENCHMARK(Scene, WorldTransformsOfDeepAndWideHierarchies)
+{
+	constexpr uint32_t EntityCount = 100000;
+	constexpr uint32_t DeepChainLength = 1000;
+	constexpr uint32_t Iterations = 20;
+
+	struct Hierarchy
+	{
+		const char* Name;
+		Ref<Scene> SceneRef;
+		Entity Root;
+		std::vector<Entity> Leaves;
+	};
+
+	// Deep: 100 chains of 1000 entities. Wide: one root with 100k children.
+	Hierarchy deep{ "deep" , Ref<Scene>::Create("Deep", false, false) };
+	deep.Root = deep.SceneRef->CreateEntity("Root");
+	for (uint32_t chain = 0; chain < EntityCount / DeepChainLength; ++chain)
+	{
+		Entity parent = deep.Root;
+		for (uint32_t i = 0; i < DeepChainLength; ++i)
+		{
+			parent = deep.SceneRef->CreateChildEntity(parent);
+			parent.Transform().Translation = { 0.0f, 0.01f, 0.0f };
+		}
+		deep.Leaves.push_back(parent);
+	}
+
+	Hierarchy wide{ "wide", Ref<Scene>::Create("Wide", false, false) };
+	wide.Root = wide.SceneRef->CreateEntity("Root");
+	for (uint32_t i = 0; i < EntityCount; ++i)
+	{
+		Entity child = wide.SceneRef->CreateChildEntity(wide.Root);
+		child.Transform().Translation = { (float)i, 0.0f, 0.0f };
+		wide.Leaves.push_back(child);
+	}
+
+	for (Hierarchy* hierarchy : { &deep, &wide })
+	{
+		Scene& scene = *hierarchy->SceneRef;
+		const std::string name = std::string("100k entities, ") + hierarchy->Name;
+		scene.UpdateWorldTransforms();
+
+		Test::Measure(name + ": update, nothing moved", Iterations, [&](uint64_t)
+			{
+				scene.UpdateWorldTransforms();
+			});
+
+		Test::Measure(name + ": update after moving the root", Iterations, [&](uint64_t i)
+			{
+				hierarchy->Root.Transform().Translation.x = (float)i;
+				hierarchy->Root.MarkTransformDirty();
+				scene.UpdateWorldTransforms();
+			});
+
+		Test::Measure(name + ": update after moving one leaf", Iterations, [&](uint64_t i)
+			{
+				hierarchy->Leaves[i % hierarchy->Leaves.size()].Transform().Translation.z = (float)i;
+				hierarchy->Leaves[i % hierarchy->Leaves.size()].MarkTransformDirty();
+				scene.UpdateWorldTransforms();
+			});
+
+		// Walking the parents costs a lookup per level, so only a slice of the leaves is read
+		const uint32_t readCount = std::min<uint32_t>((uint32_t)hierarchy->Leaves.size(), 100);
+		glm::mat4 sum(0.0f);
+		Test::Measure(name + ": read 100 leaves, cached", Iterations, [&](uint64_t)
+			{
+				for (uint32_t i = 0; i < readCount; ++i)
+				{
+					sum += scene.GetWorldSpaceTransformMatrix(hierarchy->Leaves[i]);
+				}
+			});
+
+		Test::Measure(name + ": read 100 leaves, walking the parents", Iterations, [&](uint64_t)
+			{
+				for (uint32_t i = 0; i < readCount; ++i)
+				{
+					sum += GetUncachedWorldTransform(scene, hierarchy->Leaves[i]);
+				}
+			});
+
+		bool matchesUncached = true;
+		for (uint32_t i = 0; i < readCount; ++i)
+		{
+			matchesUncached &= Equal(scene.GetWorldSpaceTransformMatrix(hierarchy->Leaves[i]), GetUncachedWorldTransform(scene, hierarchy->Leaves[i]));
+		}
+		NR_CHECK(matchesUncached);
+		Test::DoNotOptimize(sum);
+	}
+}
+
+NR_TEST(Scene, FindEntityByIDFollowsCreateAndDestroy)
+{
+	Ref<Scene> scene = Ref<Scene>::Create("IDs", false, false);
+
+	Entity parent = scene->CreateEntity("Parent");
+	Entity child = scene->CreateChildEntity(parent, "Child");
+	Entity withID = scene->CreateEntityWithID(UUID(42), "WithID");
+	NR_CHECK(scene->FindEntityByID(parent.GetID()) == parent);
+	NR_CHECK(scene->FindEntityByID(child.GetID()) == child);
+	NR_CHECK(scene->FindEntityByID(UUID(42)) == withID);
+	NR_CHECK(!scene->FindEntityByID(UUID(43)));
+
+	// Destroying the parent takes its children out of the lookup as well
+	const UUID parentID = parent.GetID();
+	const UUID childID = child.GetID();
+	scene->DestroyEntity(parent);
+	NR_CHECK(!scene->FindEntityByID(parentID));
+	NR_CHECK(!scene->FindEntityByID(childID));
+	NR_CHECK(scene->FindEntityByID(UUID(42)) == withID);
+}
+
+NR_BENCHMARK(Scene, FindEntityByIDIn100kEntities)
+{
+	constexpr uint32_t EntityCount = 100000;
+	constexpr uint64_t Lookups = 1000;
+
+	Ref<Scene> scene = Ref<Scene>::Create("IDs", false, false);
+	std::vector<UUID> ids;
+	ids.reserve(EntityCount);
+	for (uint32_t i = 0; i < EntityCount; ++i)
+	{
+		ids.push_back(scene->CreateEntity().GetID());
+	}
+
+	// What FindEntityByID did before the ID map was authoritative, a walk over every IDComponent
+	auto findByWalking = [&scene](UUID id)
+	{
+		auto view = scene->GetAllEntitiesWith<IDComponent>();
+		for (auto entity : view)
+		{
+			if (view.get<IDComponent>(entity).ID == id)
+			{
+				return Entity(entity, scene.Raw());
+			}
+		}
+		return Entity{};
+	};
+
+	// Spread over the whole scene, so the walk stops halfway through on average
+	uint32_t found = 0;
+	Test::Measure("100k entities, walking the IDComponents", Lookups, [&](uint64_t i)
+		{
+			found += findByWalking(ids[(i * 7919) % EntityCount]) ? 1 : 0;
+		});
+
+	Test::Measure("100k entities, ID map", Lookups, [&](uint64_t i)
+		{
+			found += scene->FindEntityByID(ids[(i * 7919) % EntityCount]) ? 1 : 0;
+		});
+
+	Test::Measure("100k entities, ID map, missing ID", Lookups, [&](uint64_t i)
+		{
+			found += scene->FindEntityByID(UUID(i)) ? 1 : 0;
+		});
+
+	NR_CHECK(found == 2 * Lookups);
+}
@@ -0,0 +1,302 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Scene/Scene.h"
+#include "NotRed/Scene/Entity.h"
+#include "NotRed/Script/ScriptEngine.h"
+
+// Runs the scripts of Not-TestScripts, which builds into the editor's Resources/Scripts next to the core assembly.
+// Scenes are created without initializing them, the scripted entities are set up the way Scene::RuntimeStart does it.
+
+using namespace NR;
+
+namespace
+{
+	constexpr const char* CoreAssemblyPath = "Resources/Scripts/Not-ScriptCore.dll";
+	constexpr const char* TestAssemblyPath = "Resources/Scripts/Not-TestScripts.dll";
+
+	// Mono can only be started once per process, every case shares the runtime
+	bool LoadTestScripts()
+	{
+		static bool sLoaded = false;
+		if (sLoaded)
+		{
+			return true;
+		}
+
+		if (!Test::EnterEditorDirectory())
+		{
+			return false;
+		}
+
+		for (const char* path : { CoreAssemblyPath, TestAssemblyPath })
+		{
+			if (!std::filesystem::exists(path))
+			{
+				std::printf("    %s not found, build Not-TestScripts first\n", path);
+				return false;
+			}
+		}
+
+		ScriptEngine::Init(CoreAssemblyPath);
+		sLoaded = ScriptEngine::LoadAppAssembly(TestAssemblyPath);
+		return sLoaded;
+	}
+
+	Entity CreateScriptedEntity(const Ref<Scene>& scene, const std::string& moduleName)
+	{
+		Entity entity = scene->CreateEntity(moduleName);
+		entity.AddComponent<ScriptComponent>(moduleName);
+		ScriptEngine::InitScriptEntity(entity);
+		ScriptEngine::InstantiateEntityClass(entity);
+		return entity;
+	}
+
+	bool Near(const glm::vec3& a, const glm::vec3& b)
+	{
+		return glm::all(glm::lessThan(glm::abs(a - b), glm::vec3(1e-5f)));
+	}
+}
+
+NR_TEST(ScriptEngine, UpdateThunkPassesTheTimestep)
+{
+	if (!LoadTestScripts())
+	{
+		return;
+	}
+
+	Ref<Scene> scene = Ref<Scene>::Create("Scripts", true, false);
+	ScriptEngine::SetSceneContext(scene);
+
+	Entity mover = CreateScriptedEntity(scene, "Tests.Mover");
+	ScriptEngine::UpdateEntities(scene->GetID(), 0.25f);
+	ScriptEngine::UpdateEntities(scene->GetID(), 0.5f);
+	NR_CHECK(Near(mover.Transform().Translation, { 0.75f, 0.0f, 0.0f }));
+
+	// The single entity path calls the same thunk
+	ScriptEngine::UpdateEntity(mover, 0.25f);
+	NR_CHECK(Near(mover.Transform().Translation, { 1.0f, 0.0f, 0.0f }));
+
+	ScriptEngine::SetSceneContext(nullptr);
+}
+
+NR_TEST(ScriptEngine, Collision2DThunkPassesTheOtherEntity)
+{
+	if (!LoadTestScripts())
+	{
+		return;
+	}
+
+	Ref<Scene> scene = Ref<Scene>::Create("Scripts", true, false);
+	ScriptEngine::SetSceneContext(scene);
+
+	// Init registers the follower's collision callbacks, it goes through the Init thunk
+	Entity follower = CreateScriptedEntity(scene, "Tests.Follower");
+	ScriptEngine::CreateEntity(follower);
+
+	Entity other = scene->CreateEntity("Other");
+	other.Transform().Translation = { 7.0f, 8.0f, 9.0f };
+
+	// The follower looks the other entity up by the 64 bit ID it was called with
+	ScriptEngine::Collision2DBegin(follower, other);
+	NR_CHECK(Near(follower.Transform().Translation, { 7.0f, 8.0f, 9.0f }));
+
+	ScriptEngine::Collision2DEnd(follower, other);
+	NR_CHECK(Near(follower.Transform().Translation, glm::vec3(0.0f)));
+
+	ScriptEngine::SetSceneContext(nullptr);
+}
+
+NR_TEST(ScriptEngine, DestroyedScriptsLeaveTheUpdateList)
+{
+	if (!LoadTestScripts())
+	{
+		return;
+	}
+
+	Ref<Scene> scene = Ref<Scene>::Create("Scripts", true, false);
+	ScriptEngine::SetSceneContext(scene);
+
+	std::vector<Entity> movers;
+	for (uint32_t i = 0; i < 8; ++i)
+	{
+		movers.push_back(CreateScriptedEntity(scene, "Tests.Mover"));
+	}
+
+	scene->DestroyEntity(movers[1]);
+	scene->DestroyEntity(movers[4]);
+	movers.erase(movers.begin() + 4);
+	movers.erase(movers.begin() + 1);
+
+	// Instantiated after the removals, it is appended behind the holes they left
+	movers.push_back(CreateScriptedEntity(scene, "Tests.Mover"));
+
+	ScriptEngine::UpdateEntities(scene->GetID(), 1.0f);
+
+	// Every remaining script was updated once, and the list was packed in instantiation order
+	for (uint32_t i = 0; i < movers.size(); ++i)
+	{
+		NR_CHECK(Near(movers[i].Transform().Translation, { 1.0f, 0.0f, 0.0f }));
+		NR_CHECK(ScriptEngine::GetEntityInstanceData(scene->GetID(), movers[i].GetID()).Instance.ActiveIndex == i);
+	}
+
+	ScriptEngine::SetSceneContext(nullptr);
+}
+
+NR_TEST(ScriptEngine, TransformViewReadsAndCommitsTheEntitiesItFinds)
+{
+	if (!LoadTestScripts())
+	{
+		return;
+	}
+
+	Ref<Scene> scene = Ref<Scene>::Create("Scripts", true, false);
+	ScriptEngine::SetSceneContext(scene);
+
+	// Rotated and scaled differently, the whole TransformComponent crosses over as a C# Transform and back
+	std::vector<Entity> entities;
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		Entity entity = scene->CreateEntity("Moved");
+		entity.Transform().Translation = { (float)i, 2.0f, 3.0f };
+		entity.Transform().Rotation = { 0.1f * i, 0.2f, 0.3f };
+		entity.Transform().Scale = { 1.0f, 2.0f + i, 4.0f };
+		entities.push_back(entity);
+	}
+
+	Entity mover = CreateScriptedEntity(scene, "Tests.BulkMover");
+	ScriptEngine::UpdateEntities(scene->GetID(), 0.5f);
+
+	// The ID that belongs to no entity is skipped by both calls
+	NR_CHECK(Near(mover.Transform().Translation, { 4.0f, 4.0f, 0.0f }));
+	for (uint32_t i = 0; i < entities.size(); ++i)
+	{
+		const TransformComponent& transform = entities[i].Transform();
+		NR_CHECK(Near(transform.Translation, { i + 0.5f, 2.0f, 3.0f }));
+		NR_CHECK(Near(transform.Rotation, { 0.1f * i, 0.2f, 0.3f }));
+		NR_CHECK(Near(transform.Scale, { 1.0f, 2.0f + i, 4.0f }));
+	}
+
+	// The view keeps the ID of a destroyed entity, it is skipped from then on
+	scene->DestroyEntity(entities[1]);
+	entities.erase(entities.begin() + 1);
+	ScriptEngine::UpdateEntities(scene->GetID(), 0.5f);
+
+	NR_CHECK(Near(mover.Transform().Translation, { 3.0f, 3.0f, 0.0f }));
+	NR_CHECK(Near(entities[0].Transform().Translation, { 1.0f, 2.0f, 3.0f }));
+	NR_CHECK(Near(entities[1].Transform().Translation, { 3.0f, 2.0f, 3.0f }));
+	NR_CHECK(Near(entities[2].Transform().Translation, { 4.0f, 2.0f, 3.0f }));
+
+	ScriptEngine::SetSceneContext(nullptr);
+}
+
+NR_TEST(ScriptEngine, RigidBodyViewSkipsEntitiesWithoutABody)
+{
+	if (!LoadTestScripts())
+	{
+		return;
+	}
+
+	// Without a physics scene there are no bodies, the view must not find any or touch the transforms
+	Ref<Scene> scene = Ref<Scene>::Create("Scripts", true, false);
+	ScriptEngine::SetSceneContext(scene);
+
+	Entity entity = scene->CreateEntity("NoBody");
+	entity.Transform().Translation = { 1.0f, 2.0f, 3.0f };
+
+	Entity counter = CreateScriptedEntity(scene, "Tests.BodyCounter");
+	counter.Transform().Translation = { -1.0f, -1.0f, -1.0f };
+	ScriptEngine::UpdateEntities(scene->GetID(), 1.0f);
+
+	NR_CHECK(Near(counter.Transform().Translation, glm::vec3(0.0f)));
+	NR_CHECK(Near(entity.Transform().Translation, { 1.0f, 2.0f, 3.0f }));
+
+	ScriptEngine::SetSceneContext(nullptr);
+}
+
+NR_BENCHMARK(ScriptEngine, UpdateTenThousandScriptedEntities)
+{
+	if (!LoadTestScripts())
+	{
+		return;
+	}
+
+	constexpr uint32_t EntityCount = 10000;
+	constexpr uint64_t Frames = 100;
+	constexpr float dt = 1.0f / 60.0f;
+
+	Ref<Scene> scene = Ref<Scene>::Create("Scripts", true, false);
+	ScriptEngine::SetSceneContext(scene);
+
+	for (uint32_t i = 0; i < EntityCount; ++i)
+	{
+		CreateScriptedEntity(scene, "Tests.Mover");
+	}
+
+	Test::Measure("UpdateEntities, 10k scripts", Frames, [&scene](uint64_t)
+		{
+			ScriptEngine::UpdateEntities(scene->GetID(), dt);
+		});
+
+	// How the scene updated its scripts before they were kept in a list, a view and a lookup for every entity
+	auto view = scene->GetAllEntitiesWith<ScriptComponent>();
+	Test::Measure("UpdateEntity for each ScriptComponent, 10k scripts", Frames, [&scene, &view](uint64_t)
+		{
+			for (auto entity : view)
+			{
+				Entity e = { entity, scene.Raw() };
+				if (ScriptEngine::ModuleExists(e.GetComponent<ScriptComponent>().ModuleName))
+				{
+					ScriptEngine::UpdateEntity(e, dt);
+				}
+			}
+		});
+
+	ScriptEngine::SetSceneContext(nullptr);
+}
+
+NR_BENCHMARK(ScriptEngine, MoveTenThousandEntitiesThroughATransformView)
+{
+	if (!LoadTestScripts())
+	{
+		return;
+	}
+
+	constexpr uint32_t EntityCount = 10000;
+	constexpr uint64_t Frames = 100;
+	constexpr float dt = 1.0f / 60.0f;
+
+	// Every entity moving itself, a get and a set of its Translation each
+	Ref<Scene> perEntityScene = Ref<Scene>::Create("Scripts", true, false);
+	ScriptEngine::SetSceneContext(perEntityScene);
+	for (uint32_t i = 0; i < EntityCount; ++i)
+	{
+		CreateScriptedEntity(perEntityScene, "Tests.Mover");
+	}
+
+	Test::Measure("Translation per entity, 10k entities", Frames, [&perEntityScene](uint64_t)
+		{
+			ScriptEngine::UpdateEntities(perEntityScene->GetID(), dt);
+		});
+
+	// One script moving all of them, a Read and a Commit of the whole view
+	Ref<Scene> viewScene = Ref<Scene>::Create("Scripts", true, false);
+	ScriptEngine::SetSceneContext(viewScene);
+	for (uint32_t i = 0; i < EntityCount; ++i)
+	{
+		viewScene->CreateEntity("Moved");
+	}
+	Entity mover = CreateScriptedEntity(viewScene, "Tests.BulkMover");
+
+	Test::Measure("TransformView, 10k entities", Frames, [&viewScene](uint64_t)
+		{
+			ScriptEngine::UpdateEntities(viewScene->GetID(), dt);
+		});
+	NR_CHECK(Near(mover.Transform().Translation, { (float)EntityCount, (float)EntityCount, 0.0f }));
+
+	ScriptEngine::SetSceneContext(nullptr);
+}
@@ -0,0 +1,102 @@
+#include "Test.h"
+
+#include <filesystem>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Core/JobSystem.h"
+#include "NotRed/Platform/Vulkan/VKShader.h"
+
+// The shaders are only compiled and reflected, the same CPU work VKShader::Reload schedules as a job before its render command creates the Vulkan objects
+
+using namespace NR;
+
+namespace
+{
+	// Every directory holding a <name>.vert or <name>.comp is a shader, e.g. Resources/Shaders/PostProcessing/Bloom
+	std::vector<std::string> FindShippedShaders()
+	{
+		std::vector<std::string> shaders;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator("Resources/Shaders"))
+		{
+			if (!entry.is_directory())
+			{
+				continue;
+			}
+
+			const std::filesystem::path name = entry.path().filename();
+			if (std::filesystem::exists(entry.path() / name.string().append(".vert")) || std::filesystem::exists(entry.path() / name.string().append(".comp")))
+			{
+				shaders.push_back(entry.path().generic_string());
+			}
+		}
+		return shaders;
+	}
+
+	void CompileOneAtATime(const std::vector<std::string>& shaders, bool forceCompile, std::vector<Ref<VKShader>>& result)
+	{
+		for (size_t i = 0; i < shaders.size(); ++i)
+		{
+			result[i] = Ref<VKShader>::Create(shaders[i], forceCompile, false);
+		}
+	}
+
+	// What Renderer::Init does now, every shader of the library is scheduled before any of them is waited on
+	void CompileAllAtOnce(const std::vector<std::string>& shaders, bool forceCompile, std::vector<Ref<VKShader>>& result)
+	{
+		Ref<JobCounter> counter = Ref<JobCounter>::Create();
+		for (size_t i = 0; i < shaders.size(); ++i)
+		{
+			JobSystem::Schedule([&shaders, &result, forceCompile, i]()
+				{
+					result[i] = Ref<VKShader>::Create(shaders[i], forceCompile, false);
+				}, "CompileShader", counter);
+		}
+		JobSystem::Wait(counter);
+	}
+}
+
+NR_BENCHMARK(Shader, CompileAndReflectShippedShaders)
+{
+	if (!Test::EnterEditorDirectory())
+	{
+		return;
+	}
+
+	constexpr uint64_t Iterations = 3;
+
+	JobSystem::Init();
+	const std::vector<std::string> shaders = FindShippedShaders();
+	NR_CHECK(!shaders.empty());
+
+	std::vector<Ref<VKShader>> serial(shaders.size());
+	std::vector<Ref<VKShader>> parallel(shaders.size());
+	const std::string count = std::to_string(shaders.size()) + " shaders";
+
+	// Compiling from source, then loading the SPIR-V the compiles above cached. Both reflect every stage.
+	for (bool forceCompile : { true, false })
+	{
+		const std::string mode = forceCompile ? ", compiled" : ", cached";
+		Test::Measure(count + mode + ", one at a time", Iterations, [&](uint64_t)
+			{
+				CompileOneAtATime(shaders, forceCompile, serial);
+			});
+
+		Test::Measure(count + mode + ", all at once on " + std::to_string(JobSystem::GetWorkerCount()) + " workers", Iterations, [&](uint64_t)
+			{
+				CompileAllAtOnce(shaders, forceCompile, parallel);
+			});
+	}
+
+	// Both ways end up with the same reflection
+	bool sameReflection = true;
+	for (size_t i = 0; i < shaders.size(); ++i)
+	{
+		sameReflection &= serial[i]->GetShaderBuffers().size() == parallel[i]->GetShaderBuffers().size();
+		sameReflection &= serial[i]->GetResources().size() == parallel[i]->GetResources().size();
+	}
+	NR_CHECK(sameReflection);
+
+	serial.clear();
+	parallel.clear();
+	JobSystem::Shutdown();
+}
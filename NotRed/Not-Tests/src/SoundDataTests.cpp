@@ -0,0 +1,241 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Core/JobSystem.h"
+#include "NotRed/Audio/SoundData.h"
+
+// Decodes a WAV written by the test, no audio device or AudioEngine is needed. Every frame of it holds its own index,
+// so any frame read back shows where in the file it came from.
+
+using namespace NR;
+
+namespace
+{
+	constexpr uint32_t SampleRate = 48000;
+	constexpr uint32_t Channels = 2;
+
+	// A quarter of a second, the streaming buffer holds a whole second of it
+	constexpr uint32_t FrameCount = 12000;
+
+	int16_t GetSample(uint64_t frame, uint32_t channel)
+	{
+		const int16_t value = (int16_t)((int64_t)frame - 16384);
+		return channel == 0 ? value : (int16_t)-value;
+	}
+
+	// As the decoders convert it to f32, exactly
+	float GetExpectedSample(uint64_t frame, uint32_t channel)
+	{
+		return (float)GetSample(frame % FrameCount, channel) / 32768.0f;
+	}
+
+	class ScopedWavFile
+	{
+	public:
+		explicit ScopedWavFile(const char* name)
+			: mPath((std::filesystem::temp_directory_path() / name).string())
+		{
+			const uint32_t dataSize = FrameCount * Channels * sizeof(int16_t);
+			auto write32 = [](std::ofstream& out, uint32_t value) { out.write((const char*)&value, 4); };
+			auto write16 = [](std::ofstream& out, uint16_t value) { out.write((const char*)&value, 2); };
+
+			std::ofstream out(mPath, std::ios::binary);
+			out.write("RIFF", 4);
+			write32(out, 36 + dataSize);
+			out.write("WAVE", 4);
+			out.write("fmt ", 4);
+			write32(out, 16);
+			write16(out, 1);
+			write16(out, Channels);
+			write32(out, SampleRate);
+			write32(out, SampleRate * Channels * sizeof(int16_t));
+			write16(out, Channels * sizeof(int16_t));
+			write16(out, 16);
+			out.write("data", 4);
+			write32(out, dataSize);
+			for (uint32_t frame = 0; frame < FrameCount; ++frame)
+			{
+				for (uint32_t channel = 0; channel < Channels; ++channel)
+				{
+					const int16_t sample = GetSample(frame, channel);
+					out.write((const char*)&sample, sizeof(sample));
+				}
+			}
+		}
+
+		~ScopedWavFile()
+		{
+			std::error_code error;
+			std::filesystem::remove(mPath, error);
+		}
+
+		const std::string& GetPath() const { return mPath; }
+
+	private:
+		std::string mPath;
+	};
+
+	// Reads like the mixing thread, after letting the source refill its buffer like the Audio Thread
+	ma_result Read(Audio::StreamingSoundSource& source, std::vector<float>& frames, uint64_t frameCount, uint64_t& framesRead)
+	{
+		source.Update();
+		source.WaitForDecode();
+
+		frames.assign(frameCount * Channels, -2.0f);
+		ma_uint64 read = 0;
+		const ma_result result = ma_data_source_read_pcm_frames(source.GetDataSource(), frames.data(), frameCount, &read, MA_FALSE);
+		framesRead = read;
+		return result;
+	}
+
+	bool MatchesFile(const std::vector<float>& frames, uint64_t frameCount, uint64_t firstFrame)
+	{
+		for (uint64_t i = 0; i < frameCount; ++i)
+		{
+			for (uint32_t channel = 0; channel < Channels; ++channel)
+			{
+				if (frames[i * Channels + channel] != GetExpectedSample(firstFrame + i, channel))
+				{
+					std::printf("    frame %llu differs from frame %llu of the file\n", (unsigned long long)i, (unsigned long long)(firstFrame + i));
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	uint64_t GetCursor(Audio::StreamingSoundSource& source)
+	{
+		ma_uint64 cursor = 0;
+		ma_data_source_get_cursor_in_pcm_frames(source.GetDataSource(), &cursor);
+		return cursor;
+	}
+}
+
+NR_TEST(StreamingSoundSource, LoopingReadsAcrossTheLoopPoint)
+{
+	ScopedWavFile file("NotTests-StreamingLoop.wav");
+	JobSystem::Init(2);
+	{
+		Audio::StreamingSoundSource source;
+		NR_CHECK(source.Initialize(file.GetPath()));
+		source.SetLooping(true);
+
+		ma_uint64 length = 0;
+		ma_data_source_get_length_in_pcm_frames(source.GetDataSource(), &length);
+		NR_CHECK(length == FrameCount);
+
+		// Odd sized reads, so the loop point and the ring buffer's end land inside a read
+		constexpr uint64_t ReadSize = 1013;
+		std::vector<float> frames;
+		bool matches = true;
+		bool cursorFollows = true;
+		for (uint64_t position = 0; position < FrameCount * 3; position += ReadSize)
+		{
+			uint64_t framesRead = 0;
+			matches &= Read(source, frames, ReadSize, framesRead) == MA_SUCCESS && framesRead == ReadSize;
+			matches &= MatchesFile(frames, ReadSize, position);
+			cursorFollows &= GetCursor(source) == (position + ReadSize) % FrameCount;
+		}
+		NR_CHECK(matches);
+		NR_CHECK(cursorFollows);
+	}
+	JobSystem::Shutdown();
+}
+
+NR_TEST(StreamingSoundSource, EndsAfterTheLastFrameWithoutLooping)
+{
+	ScopedWavFile file("NotTests-StreamingEnd.wav");
+	JobSystem::Init(2);
+	{
+		Audio::StreamingSoundSource source;
+		NR_CHECK(source.Initialize(file.GetPath()));
+
+		std::vector<float> frames;
+		uint64_t framesRead = 0;
+		NR_CHECK(Read(source, frames, FrameCount - 100, framesRead) == MA_SUCCESS);
+		NR_CHECK(MatchesFile(frames, framesRead, 0));
+
+		// Only what is left of the file comes back, then the end
+		NR_CHECK(Read(source, frames, 1000, framesRead) == MA_AT_END);
+		NR_CHECK(framesRead == 100 && MatchesFile(frames, framesRead, FrameCount - 100));
+	}
+	JobSystem::Shutdown();
+}
+
+NR_TEST(StreamingSoundSource, SeekRefillsTheBufferFromTheTarget)
+{
+	ScopedWavFile file("NotTests-StreamingSeek.wav");
+	JobSystem::Init(2);
+	{
+		Audio::StreamingSoundSource source;
+		NR_CHECK(source.Initialize(file.GetPath()));
+		source.SetLooping(true);
+
+		std::vector<float> frames;
+		uint64_t framesRead = 0;
+		NR_CHECK(Read(source, frames, 2000, framesRead) == MA_SUCCESS && MatchesFile(frames, framesRead, 0));
+
+		// Until a decode job has moved the decoder, the mixing thread plays silence instead of stale frames
+		NR_CHECK(ma_data_source_seek_to_pcm_frame(source.GetDataSource(), 9000) == MA_SUCCESS);
+		ma_uint64 silentFrames = 0;
+		frames.assign(256 * Channels, -2.0f);
+		ma_data_source_read_pcm_frames(source.GetDataSource(), frames.data(), 256, &silentFrames, MA_FALSE);
+		bool silent = silentFrames == 256;
+		for (float sample : frames)
+		{
+			silent &= sample == 0.0f;
+		}
+		NR_CHECK(silent);
+
+		NR_CHECK(Read(source, frames, 4000, framesRead) == MA_SUCCESS);
+		NR_CHECK(framesRead == 4000 && MatchesFile(frames, framesRead, 9000));
+		NR_CHECK(GetCursor(source) == (9000 + 4000) % FrameCount);
+
+		// Back to the start, after the buffer had already wrapped around the loop point
+		NR_CHECK(ma_data_source_seek_to_pcm_frame(source.GetDataSource(), 0) == MA_SUCCESS);
+		NR_CHECK(Read(source, frames, 3000, framesRead) == MA_SUCCESS);
+		NR_CHECK(framesRead == 3000 && MatchesFile(frames, framesRead, 0));
+	}
+	JobSystem::Shutdown();
+}
+
+NR_TEST(DecodedSoundCache, UsersShareTheDecodedData)
+{
+	ScopedWavFile file("NotTests-Decoded.wav");
+	const AssetHandle handle;
+
+	Audio::DecodedSoundCache cache;
+	Ref<Audio::DecodedSoundData> first = cache.Get(handle, file.GetPath(), SampleRate);
+	Ref<Audio::DecodedSoundData> second = cache.Get(handle, file.GetPath(), SampleRate);
+
+	NR_CHECK(first && first == second);
+	NR_CHECK(first->FrameCount == FrameCount && first->Channels == Channels);
+	NR_CHECK(MatchesFile(first->Frames, FrameCount, 0));
+	NR_CHECK(cache.GetMemoryUsage() == first->GetSize());
+
+	// Nothing that is playing is freed, however far over budget the cache is
+	cache.Trim(0);
+	NR_CHECK(cache.GetMemoryUsage() == first->GetSize());
+	NR_CHECK(cache.Get(handle, file.GetPath(), SampleRate) == first);
+
+	// Once no Sound uses it, it goes, and the next user decodes the file again
+	const uint64_t size = first->GetSize();
+	first = nullptr;
+	cache.Trim(size);
+	NR_CHECK(cache.GetMemoryUsage() == size);
+	second = nullptr;
+	cache.Trim(0);
+	NR_CHECK(cache.GetMemoryUsage() == 0);
+
+	Ref<Audio::DecodedSoundData> decodedAgain = cache.Get(handle, file.GetPath(), SampleRate);
+	NR_CHECK(decodedAgain && MatchesFile(decodedAgain->Frames, FrameCount, 0));
+	NR_CHECK(cache.GetMemoryUsage() == decodedAgain->GetSize());
+
+	NR_CHECK(!cache.Get(AssetHandle(), file.GetPath() + ".missing", SampleRate));
+}
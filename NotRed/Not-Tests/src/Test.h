@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace NR::Test
+{
+	using TestFn = void(*)();
+
+	struct TestCase
+	{
+		const char* Suite;
+		const char* Name;
+		TestFn Function;
+		bool IsBenchmark;
+	};
+
+	std::vector<TestCase>& GetTestCases();
+
+	struct Registration
+	{
+		Registration(const char* suite, const char* name, TestFn function, bool isBenchmark)
+		{
+			GetTestCases().push_back({ suite, name, function, isBenchmark });
+		}
+	};
+
+	// A test keeps running after a failed check, every failure is reported
+	void ReportFailure(const char* expression, const char* file, int line);
+
+	// Benchmarks report their results through this, the runner prints them once the benchmark is done
+	void ReportMeasurement(const std::string& name, double totalMilliseconds, uint64_t iterations);
+
+	// Calls func iterations times and reports the total and per iteration time under name
+	template<typename Func>
+	double Measure(const std::string& name, uint64_t iterations, Func&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			func(i);
+		}
+		const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		ReportMeasurement(name, milliseconds, iterations);
+		return milliseconds;
+	}
+
+	// Cases that load the shipped assets run from the editor's directory, which holds the Resources folder.
+	// Changes the working directory to it, returns false when it can't be found from the current one.
+	bool EnterEditorDirectory();
+
+	// Keeps the compiler from optimizing away a benchmarked result
+	template<typename T>
+	void DoNotOptimize(const T& value)
+	{
+		static const void* volatile sSink;
+		sSink = &value;
+	}
+}
+
+#define NR_TEST_CASE(suite, name, isBenchmark) \
+	static void suite##_##name(); \
+	static ::NR::Test::Registration sRegistration_##suite##_##name(#suite, #name, &suite##_##name, isBenchmark); \
+	static void suite##_##name()
+
+#define NR_TEST(suite, name) NR_TEST_CASE(suite, name, false)
+#define NR_BENCHMARK(suite, name) NR_TEST_CASE(suite, name, true)
+
+#define NR_CHECK(expression) do { if (!(expression)) { ::NR::Test::ReportFailure(#expression, __FILE__, __LINE__); } } while (false)
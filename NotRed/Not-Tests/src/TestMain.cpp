@@ -0,0 +1,97 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include "NotRed/Core/Log.h"
+
+// Referenced by Application, which the engine library links in through the renderer
+bool gApplicationRunning = false;
+
+namespace NR::Test
+{
+	static uint32_t sFailureCount = 0;
+
+	std::vector<TestCase>& GetTestCases()
+	{
+		static std::vector<TestCase> sTestCases;
+		return sTestCases;
+	}
+
+	void ReportFailure(const char* expression, const char* file, int line)
+	{
+		std::printf("    FAILED: %s (%s:%d)\n", expression, file, line);
+		++sFailureCount;
+	}
+
+	void ReportMeasurement(const std::string& name, double totalMilliseconds, uint64_t iterations)
+	{
+		const double perIteration = iterations ? totalMilliseconds * 1000.0 / (double)iterations : 0.0;
+		std::printf("    %-56s %12.3f ms total %14.4f us/iteration (%llu iterations)\n", name.c_str(), totalMilliseconds, perIteration, (unsigned long long)iterations);
+	}
+
+	bool EnterEditorDirectory()
+	{
+		// The tests are started from their project or output directory, or from the solution directory
+		for (const char* candidate : { ".", "../NotEditor", "NotEditor", "../../../NotEditor" })
+		{
+			if (std::filesystem::exists(std::filesystem::path(candidate) / "Resources/Shaders"))
+			{
+				std::filesystem::current_path(candidate);
+				return true;
+			}
+		}
+
+		std::printf("    Resources/Shaders not found from %s\n", std::filesystem::current_path().string().c_str());
+		return false;
+	}
+}
+
+// Runs the tests, or the benchmarks with --benchmarks. Any other argument only runs the cases whose "Suite.Name" contains it.
+int main(int argc, char** argv)
+{
+	using namespace NR::Test;
+
+	bool runBenchmarks = false;
+	const char* filter = nullptr;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--benchmarks") == 0)
+		{
+			runBenchmarks = true;
+		}
+		else
+		{
+			filter = argv[i];
+		}
+	}
+
+	NR::Log::Init();
+
+	uint32_t caseCount = 0;
+	uint32_t failedCaseCount = 0;
+	for (const TestCase& testCase : GetTestCases())
+	{
+		const std::string fullName = std::string(testCase.Suite) + "." + testCase.Name;
+		if (testCase.IsBenchmark != runBenchmarks || (filter && fullName.find(filter) == std::string::npos))
+		{
+			continue;
+		}
+
+		std::printf("[ RUN  ] %s\n", fullName.c_str());
+		const uint32_t failuresBefore = sFailureCount;
+		testCase.Function();
+
+		const bool failed = sFailureCount != failuresBefore;
+		std::printf("[ %s ] %s\n", failed ? "FAIL" : " OK ", fullName.c_str());
+
+		++caseCount;
+		failedCaseCount += failed ? 1 : 0;
+	}
+
+	std::printf("%u of %u passed\n", caseCount - failedCaseCount, caseCount);
+
+	NR::Log::Shutdown();
+	return failedCaseCount == 0 ? 0 : 1;
+}
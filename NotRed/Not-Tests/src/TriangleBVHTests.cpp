@@ -0,0 +1,148 @@
+#include "Test.h"
+
+#include <random>
+
+#include <glm/gtc/constants.hpp>
+
+#include "NotRed/Core/Core.h"
+#include "NotRed/Math/TriangleBVH.h"
+
+// The linear raycast is what mesh picking did before the BVH, every triangle of the submesh tested one by one
+
+using namespace NR;
+
+namespace
+{
+	// Three positions per triangle, wound so the outside faces the rays
+	std::vector<glm::vec3> CreateSphere(uint32_t rings, uint32_t segments, float radius)
+	{
+		auto point = [=](uint32_t ring, uint32_t segment)
+		{
+			const float theta = glm::pi<float>() * ring / rings;
+			const float phi = glm::two_pi<float>() * segment / segments;
+			return radius * glm::vec3(glm::sin(theta) * glm::cos(phi), glm::cos(theta), glm::sin(theta) * glm::sin(phi));
+		};
+
+		std::vector<glm::vec3> positions;
+		positions.reserve((size_t)rings * segments * 6);
+		for (uint32_t ring = 0; ring < rings; ++ring)
+		{
+			for (uint32_t segment = 0; segment < segments; ++segment)
+			{
+				const glm::vec3 a = point(ring, segment), b = point(ring, segment + 1);
+				const glm::vec3 c = point(ring + 1, segment), d = point(ring + 1, segment + 1);
+				positions.insert(positions.end(), { a, b, c });
+				positions.insert(positions.end(), { b, d, c });
+			}
+		}
+		return positions;
+	}
+
+	bool RaycastLinear(const std::vector<glm::vec3>& positions, const Ray& ray, float& t)
+	{
+		float closest = FLT_MAX;
+		for (size_t i = 0; i < positions.size(); i += 3)
+		{
+			float triangleT;
+			if (ray.IntersectsTriangle(positions[i], positions[i + 1], positions[i + 2], triangleT) && triangleT < closest)
+			{
+				closest = triangleT;
+			}
+		}
+
+		if (closest == FLT_MAX)
+		{
+			return false;
+		}
+
+		t = closest;
+		return true;
+	}
+
+	// Rays from outside the sphere aimed near it, about half of them hit
+	std::vector<Ray> CreateRays(uint32_t count, float radius, uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> target(-radius * 1.4f, radius * 1.4f);
+
+		std::vector<Ray> rays;
+		rays.reserve(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const glm::vec3 origin = glm::normalize(glm::vec3(direction(random), direction(random), direction(random))) * radius * 3.0f;
+			rays.emplace_back(origin, glm::normalize(glm::vec3(target(random), target(random), target(random)) - origin));
+		}
+		return rays;
+	}
+}
+
+NR_TEST(TriangleBVH, RaycastFindsTheSameClosestHitAsTheLinearSearch)
+{
+	const std::vector<glm::vec3> sphere = CreateSphere(32, 64, 1.0f);
+
+	TriangleBVH bvh;
+	NR_CHECK(bvh.IsEmpty());
+	bvh.Build(sphere);
+	NR_CHECK(!bvh.IsEmpty());
+	NR_CHECK(bvh.GetTriangleCount() == sphere.size() / 3);
+
+	uint32_t hits = 0;
+	bool sameResults = true;
+	for (const Ray& ray : CreateRays(1000, 1.0f, 3))
+	{
+		float linearT = 0.0f, bvhT = 0.0f;
+		const bool linearHit = RaycastLinear(sphere, ray, linearT);
+		const bool bvhHit = bvh.Raycast(ray, bvhT);
+
+		sameResults &= linearHit == bvhHit && (!linearHit || glm::abs(linearT - bvhT) < 1e-5f);
+		hits += linearHit ? 1 : 0;
+	}
+	NR_CHECK(sameResults);
+	NR_CHECK(hits > 0 && hits < 1000);
+
+	// Rays pointing away from the mesh hit nothing
+	float t;
+	NR_CHECK(!bvh.Raycast(Ray(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, 1.0f)), t));
+
+	TriangleBVH empty;
+	empty.Build({});
+	NR_CHECK(empty.IsEmpty());
+	NR_CHECK(!empty.Raycast(Ray(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f)), t));
+}
+
+NR_BENCHMARK(TriangleBVH, RaycastVersusLinear)
+{
+	constexpr uint64_t Rays = 1000;
+
+	// About the triangle counts of a prop, a character and a detailed hero mesh
+	for (uint32_t rings : { 16u, 64u, 256u })
+	{
+		const std::vector<glm::vec3> sphere = CreateSphere(rings, rings * 2, 1.0f);
+		const std::string count = std::to_string(sphere.size() / 3) + " triangles";
+		const std::vector<Ray> rays = CreateRays((uint32_t)Rays, 1.0f, rings);
+
+		TriangleBVH bvh;
+		Test::Measure(count + ", build", 1, [&](uint64_t)
+			{
+				bvh.Build(sphere);
+			});
+
+		float t = 0.0f;
+		uint32_t hits = 0;
+		Test::Measure(count + ", raycast, linear", Rays, [&](uint64_t i)
+			{
+				hits += RaycastLinear(sphere, rays[i], t) ? 1 : 0;
+			});
+		Test::DoNotOptimize(t);
+
+		uint32_t bvhHits = 0;
+		Test::Measure(count + ", raycast, BVH", Rays, [&](uint64_t i)
+			{
+				bvhHits += bvh.Raycast(rays[i], t) ? 1 : 0;
+			});
+		Test::DoNotOptimize(t);
+
+		NR_CHECK(hits == bvhHits);
+	}
+}
@@ -18,10 +18,18 @@ layout(location = 2) in vec3 aTangent;
 layout(location = 3) in vec3 aBinormal;
 layout(location = 4) in vec2 aTexCoord;
 
-// Transform buffer
-layout(location = 5) in vec4 aMRow0;
-layout(location = 6) in vec4 aMRow1;
-layout(location = 7) in vec4 aMRow2;
+// Instance buffer, index into the instance transforms
+layout(location = 5) in int aTransformIndex;
+
+struct InstanceTransform
+{
+	vec4 MRow[3];
+};
+
+layout(std430, binding = 21) readonly buffer InstanceTransforms
+{
+	InstanceTransform transformsData[];
+};
 
 layout (std140, binding = 0) uniform Camera
 {
@@ -55,11 +63,14 @@ layout (location = 0) out VertexOutput Output;
 
 void main()
 {
+	vec4 mRow0 = transformsData[aTransformIndex].MRow[0];
+	vec4 mRow1 = transformsData[aTransformIndex].MRow[1];
+	vec4 mRow2 = transformsData[aTransformIndex].MRow[2];
 	mat4 transform = mat4(
-		vec4(aMRow0.x, aMRow1.x, aMRow2.x, 0.0),
-		vec4(aMRow0.y, aMRow1.y, aMRow2.y, 0.0),
-		vec4(aMRow0.z, aMRow1.z, aMRow2.z, 0.0),
-		vec4(aMRow0.w, aMRow1.w, aMRow2.w, 1.0)
+		vec4(mRow0.x, mRow1.x, mRow2.x, 0.0),
+		vec4(mRow0.y, mRow1.y, mRow2.y, 0.0),
+		vec4(mRow0.z, mRow1.z, mRow2.z, 0.0),
+		vec4(mRow0.w, mRow1.w, mRow2.w, 1.0)
 	);
 
 	//Output.WorldPosition = vec3(u_Renderer.Transform * vec4(aPosition, 1.0));
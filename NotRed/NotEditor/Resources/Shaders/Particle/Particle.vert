@@ -5,10 +5,18 @@
 layout(location = 0) in vec3 aPosition;
 layout(location = 1) in float aIndex;
 
-// Transform buffer
-layout(location = 2) in vec4 aMRow0;
-layout(location = 3) in vec4 aMRow1;
-layout(location = 4) in vec4 aMRow2;
+// Instance buffer, index into the instance transforms
+layout(location = 2) in int aTransformIndex;
+
+struct InstanceTransform
+{
+	vec4 MRow[3];
+};
+
+layout(std430, binding = 21) readonly buffer InstanceTransforms
+{
+	InstanceTransform transformsData[];
+};
 
 layout(location = 0) out vec2 o_texPos;
 layout(location = 1) out vec4 o_color;
@@ -337,11 +345,14 @@ void main()
 	o_color = vec4(color, particle.opacity);
 	o_type = type;
 	
+	vec4 mRow0 = transformsData[aTransformIndex].MRow[0];
+	vec4 mRow1 = transformsData[aTransformIndex].MRow[1];
+	vec4 mRow2 = transformsData[aTransformIndex].MRow[2];
 	mat4 transform = mat4(
-		vec4(aMRow0.x, aMRow1.x, aMRow2.x, 0.0),
-		vec4(aMRow0.y, aMRow1.y, aMRow2.y, 0.0),
-		vec4(aMRow0.z, aMRow1.z, aMRow2.z, 0.0),
-		vec4(aMRow0.w, aMRow1.w, aMRow2.w, 1.0)
+		vec4(mRow0.x, mRow1.x, mRow2.x, 0.0),
+		vec4(mRow0.y, mRow1.y, mRow2.y, 0.0),
+		vec4(mRow0.z, mRow1.z, mRow2.z, 0.0),
+		vec4(mRow0.w, mRow1.w, mRow2.w, 1.0)
 	);
 
 	gl_Position = uViewProjectionMatrix  * transform * vec4(worldspacePos / 100, 1.0);
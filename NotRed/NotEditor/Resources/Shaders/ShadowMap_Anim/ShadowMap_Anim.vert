@@ -6,14 +6,23 @@ layout(location = 2) in vec3 aTangent;
 layout(location = 3) in vec3 aBinormal;
 layout(location = 4) in vec2 aTexCoord;
 
-// Transform buffer
-layout(location = 5) in vec4 aMRow0;
-layout(location = 6) in vec4 aMRow1;
-layout(location = 7) in vec4 aMRow2;
+// Instance buffer, indices into the instance transforms and bone transforms
+layout(location = 5) in int aTransformIndex;
+layout(location = 6) in int aBoneTransformsIndex;
 
 // Bone influences
-layout(location = 8) in ivec4 aBoneIndices;
-layout(location = 9) in vec4 aBoneWeights;
+layout(location = 7) in ivec4 aBoneIndices;
+layout(location = 8) in vec4 aBoneWeights;
+
+struct InstanceTransform
+{
+	vec4 MRow[3];
+};
+
+layout(std430, binding = 21) readonly buffer InstanceTransforms
+{
+	InstanceTransform transformsData[];
+};
 
 layout (std140, binding = 1) uniform ShadowData
 {
@@ -21,32 +30,33 @@ layout (std140, binding = 1) uniform ShadowData
 };
 
 const int MAX_BONES = 100;
-const int MAX_ANIMATED_MESHES = 1024;
 
 layout (std140, set = 1, binding = 0) readonly buffer BoneTransforms
 {
-	mat4 BoneTransforms[MAX_BONES * MAX_ANIMATED_MESHES];
+	mat4 BoneTransforms[];
 } rBoneTransforms;
 
 layout(push_constant) uniform PushConstants
 {
 	uint Cascade;
-	uint BoneTransformBaseIndex;
 } uConstants;
 
 void main()
 {
+	vec4 mRow0 = transformsData[aTransformIndex].MRow[0];
+	vec4 mRow1 = transformsData[aTransformIndex].MRow[1];
+	vec4 mRow2 = transformsData[aTransformIndex].MRow[2];
 	mat4 transform = mat4(
-		vec4(aMRow0.x, aMRow1.x, aMRow2.x, 0.0),
-		vec4(aMRow0.y, aMRow1.y, aMRow2.y, 0.0),
-		vec4(aMRow0.z, aMRow1.z, aMRow2.z, 0.0),
-		vec4(aMRow0.w, aMRow1.w, aMRow2.w, 1.0)
+		vec4(mRow0.x, mRow1.x, mRow2.x, 0.0),
+		vec4(mRow0.y, mRow1.y, mRow2.y, 0.0),
+		vec4(mRow0.z, mRow1.z, mRow2.z, 0.0),
+		vec4(mRow0.w, mRow1.w, mRow2.w, 1.0)
 	);
 	
-	mat4 boneTransform = rBoneTransforms.BoneTransforms[(uConstants.BoneTransformBaseIndex + gl_InstanceIndex) * MAX_BONES + aBoneIndices[0]] * aBoneWeights[0];
-	boneTransform     += rBoneTransforms.BoneTransforms[(uConstants.BoneTransformBaseIndex + gl_InstanceIndex) * MAX_BONES + aBoneIndices[1]] * aBoneWeights[1];
-	boneTransform     += rBoneTransforms.BoneTransforms[(uConstants.BoneTransformBaseIndex + gl_InstanceIndex) * MAX_BONES + aBoneIndices[2]] * aBoneWeights[2];
-	boneTransform     += rBoneTransforms.BoneTransforms[(uConstants.BoneTransformBaseIndex + gl_InstanceIndex) * MAX_BONES + aBoneIndices[3]] * aBoneWeights[3];
+	mat4 boneTransform = rBoneTransforms.BoneTransforms[aBoneTransformsIndex * MAX_BONES + aBoneIndices[0]] * aBoneWeights[0];
+	boneTransform     += rBoneTransforms.BoneTransforms[aBoneTransformsIndex * MAX_BONES + aBoneIndices[1]] * aBoneWeights[1];
+	boneTransform     += rBoneTransforms.BoneTransforms[aBoneTransformsIndex * MAX_BONES + aBoneIndices[2]] * aBoneWeights[2];
+	boneTransform     += rBoneTransforms.BoneTransforms[aBoneTransformsIndex * MAX_BONES + aBoneIndices[3]] * aBoneWeights[3];
 
 	gl_Position = uViewProjectionMatrix[uConstants.Cascade] * transform * boneTransform * vec4(aPosition, 1.0);
 }
\ No newline at end of file
@@ -789,7 +789,6 @@ namespace NR
         }
         }
         AssetEditorPanel::Update(dt);
-        SceneRenderer::WaitForThreads();
     }
 
     void EditorLayer::SelectEntity(Entity entity)
@@ -805,8 +804,8 @@ namespace NR
         {
             auto& meshComp = entity.GetComponent<MeshComponent>();
 
-            auto mesh = AssetManager::GetAsset<Mesh>(meshComp.MeshHandle);
-            if (mesh && !mesh->IsFlagSet(AssetFlag::Missing))
+            auto mesh = AssetManager::GetAssetAsync<Mesh>(meshComp.MeshHandle);
+            if (mesh && !mesh->IsFlagSet(AssetFlag::Missing) && !AssetManager::IsPlaceholderAsset(mesh, meshComp.MeshHandle))
             {
                 selection.Mesh = &mesh->GetMeshSource()->GetSubmeshes()[0];
             }
@@ -844,7 +843,7 @@ namespace NR
                         auto& selection = mSelectionContext[0];
                         if (selection.EntityObj.HasComponent<MeshComponent>())
                         {
-                            auto mesh = AssetManager::GetAsset<Mesh>(selection.EntityObj.GetComponent<MeshComponent>().MeshHandle);
+                            auto mesh = AssetManager::GetAssetAsync<Mesh>(selection.EntityObj.GetComponent<MeshComponent>().MeshHandle);
                             if (mesh)
                             {
                                 if (mShowBoundingBoxSubmeshes)
@@ -876,7 +875,7 @@ namespace NR
                     {
                         Entity entity = { e, mCurrentScene.Raw() };
                         glm::mat4 transform = entity.GetComponent<TransformComponent>().GetTransform();
-                        auto mesh = AssetManager::GetAsset<Mesh>(entity.GetComponent<MeshComponent>().MeshHandle);
+                        auto mesh = AssetManager::GetAssetAsync<Mesh>(entity.GetComponent<MeshComponent>().MeshHandle);
                         if (mesh) 
                         {
                             const AABB& aabb = mesh->GetMeshSource()->GetBoundingBox();
@@ -1996,6 +1995,8 @@ namespace NR
                         entityTransform.Rotation += deltaRotation;
                         entityTransform.Scale = scale;
                     }
+
+                    selection.EntityObj.MarkTransformDirty();
                 }
             }
             else
@@ -2159,6 +2160,8 @@ namespace NR
                                 entityTransform.Rotation += deltaRotation;
                                 entityTransform.Scale = scale;
                             }
+
+                            selection.EntityObj.MarkTransformDirty();
                         }
                     }
                     else
@@ -2904,77 +2907,57 @@ namespace NR
 
                 mSelectionContext.clear();
                 mCurrentScene->SetSelectedEntity({});
-                auto meshEntities = mCurrentScene->GetAllEntitiesWith<MeshComponent>();
-                for (auto e : meshEntities)
-                {
-                    Entity entity = { e, mCurrentScene.Raw() };
-                    auto& mc = entity.GetComponent<MeshComponent>();
-                    auto mesh = AssetManager::GetAsset<Mesh>(mc.MeshHandle);
 
-                    if (!mesh || mesh->IsFlagSet(AssetFlag::Missing))
-                    {
-                        continue;
-                    }
-
-                    auto& submeshes = mesh->GetMeshSource()->GetSubmeshes();
-                    float lastT = std::numeric_limits<float>::max();
-                    auto& submesh = submeshes[mc.SubmeshIndex];
+                // Broad phase through the scene's spatial index, then the exact test against each submesh's triangle BVH
+                std::vector<Entity> candidates;
+                mCurrentScene->RaycastEntities(Ray(origin, direction), candidates);
+                for (Entity entity : candidates)
+                {
                     glm::mat4 transform = mCurrentScene->GetWorldSpaceTransformMatrix(entity);
-                    
-                    Ray ray = {
-                        glm::inverse(transform) * glm::vec4(origin, 1.0f),
-                        glm::inverse(glm::mat3(transform)) * direction
-                    };
-                    
-                    float t;
-                    bool intersects = ray.IntersectsAABB(submesh.BoundingBox, t);
-                    if (intersects)
+
+                    if (entity.HasComponent<MeshComponent>())
                     {
-                        const auto& triangleCache = mesh->GetMeshSource()->GetTriangleCache(mc.SubmeshIndex);
-                        for (const auto& triangle : triangleCache)
+                        auto& mc = entity.GetComponent<MeshComponent>();
+                        // Meshes that are still streaming in can't be picked yet
+                        auto mesh = AssetManager::GetAssetAsync<Mesh>(mc.MeshHandle);
+                        if (mesh && !mesh->IsFlagSet(AssetFlag::Missing) && !AssetManager::IsPlaceholderAsset(mesh, mc.MeshHandle))
                         {
-                            if (ray.IntersectsTriangle(triangle.V0.Position, triangle.V1.Position, triangle.V2.Position, t))
+                            auto meshSource = mesh->GetMeshSource();
+                            auto& submesh = meshSource->GetSubmeshes()[mc.SubmeshIndex];
+
+                            Ray ray = {
+                                glm::inverse(transform) * glm::vec4(origin, 1.0f),
+                                glm::inverse(glm::mat3(transform)) * direction
+                            };
+
+                            float t;
+                            if (ray.IntersectsAABB(submesh.BoundingBox, t) && meshSource->GetTriangleBVH(mc.SubmeshIndex).Raycast(ray, t))
                             {
                                 mSelectionContext.push_back({ entity, &submesh, t });
-                                break;
                             }
                         }
                     }
-                }
-                auto staticMeshEntities = mCurrentScene->GetAllEntitiesWith<StaticMeshComponent>();
-                for (auto e : staticMeshEntities)
-                {
-                    Entity entity = { e, mCurrentScene.Raw() };
-                    auto& smc = entity.GetComponent<StaticMeshComponent>();
-                    auto staticMesh = AssetManager::GetAsset<StaticMesh>(smc.StaticMesh);
-                    if (!staticMesh || staticMesh->IsFlagSet(AssetFlag::Missing))
-                    {
-                        continue;
-                    }
-
-                    auto& submeshes = staticMesh->GetMeshSource()->GetSubmeshes();
 
-                    constexpr float lastT = std::numeric_limits<float>::max();
-                    for (uint32_t i = 0; i < submeshes.size(); ++i)
+                    if (entity.HasComponent<StaticMeshComponent>())
                     {
-                        auto& submesh = submeshes[i];
-                        glm::mat4 transform = mCurrentScene->GetWorldSpaceTransformMatrix(entity);
-                        Ray ray = {
-                            glm::inverse(transform * submesh.Transform) * glm::vec4(origin, 1.0f),
-                            glm::inverse(glm::mat3(transform * submesh.Transform))* direction
-                        };
-
-                        float t;
-                        bool intersects = ray.IntersectsAABB(submesh.BoundingBox, t);
-                        if (intersects)
+                        auto& smc = entity.GetComponent<StaticMeshComponent>();
+                        auto staticMesh = AssetManager::GetAssetAsync<StaticMesh>(smc.StaticMesh);
+                        if (staticMesh && !staticMesh->IsFlagSet(AssetFlag::Missing) && !AssetManager::IsPlaceholderAsset(staticMesh, smc.StaticMesh))
                         {
-                            const auto& triangleCache = staticMesh->GetMeshSource()->GetTriangleCache(i);
-                            for (const auto& triangle : triangleCache)
+                            auto meshSource = staticMesh->GetMeshSource();
+                            auto& submeshes = meshSource->GetSubmeshes();
+                            for (uint32_t i : staticMesh->GetSubmeshes())
                             {
-                                if (ray.IntersectsTriangle(triangle.V0.Position, triangle.V1.Position, triangle.V2.Position, t))
+                                auto& submesh = submeshes[i];
+                                Ray ray = {
+                                    glm::inverse(transform * submesh.Transform) * glm::vec4(origin, 1.0f),
+                                    glm::inverse(glm::mat3(transform * submesh.Transform)) * direction
+                                };
+
+                                float t;
+                                if (ray.IntersectsAABB(submesh.BoundingBox, t) && meshSource->GetTriangleBVH(i).Raycast(ray, t))
                                 {
                                     mSelectionContext.push_back({ entity, &submesh, t });
-                                    break;
                                 }
                             }
                         }
@@ -144,6 +144,10 @@ namespace NR
                 UI::PropertySlider("Solver Iterations", (int&)settings.SolverIterations, 1, 512);
                 UI::PropertySlider("Solver Velocity Iterations", (int&)settings.SolverVelocityIterations, 1, 512);
 
+                UI::PropertySlider("Worker Threads (0: Automatic)", (int&)settings.WorkerThreadCount, 0, 64);
+                UI::Property("Use Job System", settings.UseJobSystem);
+                UI::Property("Interpolate Transforms", settings.InterpolateTransforms);
+
 #ifdef NR_DEBUG
                 UI::Property("Debug On Play", settings.DebugOnPlay);
 
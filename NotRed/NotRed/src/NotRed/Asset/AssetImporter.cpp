@@ -55,5 +55,10 @@ namespace NR
 		return sSerializers[metadata.Type]->TryLoadData(metadata, asset);
 	}
 
+	void AssetImporter::SetSerializer(AssetType type, Scope<AssetSerializer> serializer)
+	{
+		sSerializers[type] = std::move(serializer);
+	}
+
 	std::unordered_map<AssetType, Scope<AssetSerializer>> AssetImporter::sSerializers;
 }
\ No newline at end of file
@@ -12,6 +12,9 @@ namespace NR
 		static void Serialize(const Ref<Asset>& asset);
 		static bool TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset);
 
+		// Replaces the serializer assets of this type are loaded with, so the tests can load assets that have no files
+		static void SetSerializer(AssetType type, Scope<AssetSerializer> serializer);
+
 	private:
 		static std::unordered_map<AssetType, Scope<AssetSerializer>> sSerializers;
 	};
@@ -1,9 +1,15 @@
 #include "nrpch.h"
 #include "AssetManager.h"
 
+#include <condition_variable>
 #include <filesystem>
+#include <thread>
 
+#include "NotRed/Core/JobSystem.h"
 #include "NotRed/Renderer/Mesh.h"
+#include "NotRed/Renderer/MeshFactory.h"
+#include "NotRed/Renderer/MaterialAsset.h"
+#include "NotRed/Renderer/Renderer.h"
 #include "NotRed/Renderer/SceneRenderer.h"
 #include "NotRed/Project/Project.h"
 #include "NotRed/ImGui/ImGui.h"
@@ -14,11 +20,67 @@
 
 namespace NR
 {
+	namespace Utils
+	{
+		// Loading these touches the scene, the audio engine or records GPU work right away, so they are never loaded on a worker
+		static bool IsMainThreadAsset(AssetType type)
+		{
+			switch (type)
+			{
+			case AssetType::Scene:
+			case AssetType::Prefab:
+			case AssetType::EnvMap:
+			case AssetType::Audio:
+			case AssetType::SoundConfig:
+			case AssetType::SpatializationConfig:
+			case AssetType::SOULSound:
+				return true;
+			default:
+				return false;
+			}
+		}
+	}
+
+	struct AssetLoadRequest
+	{
+		AssetType Type = AssetType::None;
+		AssetLoadPriority Priority = AssetLoadPriority::Normal;
+		uint64_t Order = 0;
+
+		// Set once a loader job or a synchronous GetAsset has taken the request
+		bool Started = false;
+		std::thread::id LoadingThread;
+
+		std::vector<AssetManager::AssetLoadCallback> Callbacks;
+	};
+
+	// Everything in here is guarded by AssetManager::sAssetMutex
+	struct AssetLoaderData
+	{
+		// Queued and running loads, a handle is removed once its asset is in sLoadedAssets (or failed to load)
+		std::unordered_map<AssetHandle, AssetLoadRequest> Requests;
+		std::condition_variable_any LoadFinished;
+		uint64_t NextOrder = 0;
+		uint32_t ActiveLoaders = 0;
+
+		std::unordered_map<AssetType, Ref<Asset>> PlaceholderAssets;
+	};
+
+	static AssetLoaderData sLoaderData;
+
 	void AssetManager::Init()
 	{
 		sAssetRegistry.Clear();
 		AssetImporter::Init();
 
+		SetPlaceholderAsset(AssetType::Texture, Renderer::GetWhiteTexture());
+
+		// Meshes that are still streaming in are drawn as a unit box with the default material
+		Ref<StaticMesh> placeholderMesh = GetAsset<StaticMesh>(MeshFactory::CreateBox(glm::vec3(1.0f)));
+		SetPlaceholderAsset(AssetType::StaticMesh, placeholderMesh);
+		SetPlaceholderAsset(AssetType::Mesh, Ref<Mesh>::Create(placeholderMesh->GetMeshSource()));
+		SetPlaceholderAsset(AssetType::Material, Ref<MaterialAsset>::Create());
+
 		LoadAssetRegistry();
 		FileSystem::SetChangeCallback(AssetManager::FileSystemChanged);
 		ReloadAssets();
@@ -31,8 +93,24 @@ namespace NR
 
 	void AssetManager::Shutdown()
 	{
+		{
+			// Drop the loads that haven't started, the running ones still write to the maps cleared below
+			std::unique_lock<std::recursive_mutex> lock(sAssetMutex);
+			for (auto it = sLoaderData.Requests.begin(); it != sLoaderData.Requests.end();)
+			{
+				if (it->second.Started)
+					++it;
+				else
+					it = sLoaderData.Requests.erase(it);
+			}
+
+			WaitForLoads(lock, []() { return sLoaderData.Requests.empty(); });
+			sLoaderData.PlaceholderAssets.clear();
+		}
+
 		WriteRegistryToFile();
 
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
 		sMemoryAssets.clear();
 		sAssetRegistry.Clear();
 		sLoadedAssets.clear();
@@ -83,6 +161,7 @@ namespace NR
 	static AssetMetadata sNullMetadata;
 	AssetMetadata& AssetManager::GetMetadataInternal(AssetHandle handle)
 	{
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
 		for (auto& [filepath, metadata] : sAssetRegistry)
 		{
 			if (metadata.Handle == handle)
@@ -99,6 +178,7 @@ namespace NR
 
 	const AssetMetadata& AssetManager::GetMetadata(const std::filesystem::path& filepath)
 	{
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
 		if (sAssetRegistry.Contains(filepath))
 			return sAssetRegistry[filepath];
 
@@ -107,14 +187,16 @@ namespace NR
 
 	std::filesystem::path AssetManager::GetRelativePath(const std::filesystem::path& filepath)
 	{
+		// Without a project, e.g. in the tests, paths are kept as they are
 		std::string temp = filepath.string();
-		if (temp.find(Project::GetActive()->GetAssetDirectory().string()) != std::string::npos)
+		if (Project::GetActive() && temp.find(Project::GetActive()->GetAssetDirectory().string()) != std::string::npos)
 			return std::filesystem::relative(filepath, Project::GetActive()->GetAssetDirectory());
 		return filepath;
 	}
 
 	AssetHandle AssetManager::GetAssetHandleFromFilePath(const std::filesystem::path& filepath)
 	{
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
 		return sAssetRegistry.Contains(filepath) ? sAssetRegistry[filepath].Handle : AssetHandle(0);
 	}
 
@@ -124,9 +206,12 @@ namespace NR
 		if (!metadata.IsValid())
 			return;
 
-		sAssetRegistry.Remove(metadata.FilePath);
-		metadata.FilePath = sAssetRegistry.GetPathKey(newFilePath);
-		sAssetRegistry[metadata.FilePath] = metadata;
+		{
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+			sAssetRegistry.Remove(metadata.FilePath);
+			metadata.FilePath = sAssetRegistry.GetPathKey(newFilePath);
+			sAssetRegistry[metadata.FilePath] = metadata;
+		}
 		WriteRegistryToFile();
 	}
 
@@ -136,9 +221,12 @@ namespace NR
 		if (!metadata.IsValid())
 			return;
 
-		sAssetRegistry.Remove(metadata.FilePath);
-		metadata.FilePath = destinationPath / metadata.FilePath.filename();
-		sAssetRegistry[metadata.FilePath] = metadata;
+		{
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+			sAssetRegistry.Remove(metadata.FilePath);
+			metadata.FilePath = destinationPath / metadata.FilePath.filename();
+			sAssetRegistry[metadata.FilePath] = metadata;
+		}
 
 		WriteRegistryToFile();
 	}
@@ -149,8 +237,11 @@ namespace NR
 		if (!metadata.IsValid())
 			return;
 
-		sAssetRegistry.Remove(metadata.FilePath);
-		sLoadedAssets.erase(assetHandle);
+		{
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+			sAssetRegistry.Remove(metadata.FilePath);
+			sLoadedAssets.erase(assetHandle);
+		}
 		WriteRegistryToFile();
 	}
 
@@ -270,6 +361,7 @@ namespace NR
 	{
 		std::filesystem::path path = GetRelativePath(filepath);
 
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
 		if (sAssetRegistry.Contains(path))
 			return sAssetRegistry[path].Handle;
 
@@ -288,20 +380,316 @@ namespace NR
 
 	bool AssetManager::ReloadData(AssetHandle assetHandle)
 	{
-		auto& metadata = GetMetadataInternal(assetHandle);
-		if (!metadata.IsDataLoaded)
+		AssetMetadata metadata;
+		Ref<Asset> asset;
+		{
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+			metadata = GetMetadataInternal(assetHandle);
+			if (!metadata.IsDataLoaded)
+			{
+				NR_CORE_WARN("Trying to reload asset that was never loaded");
+			}
+			else
+			{
+				NR_CORE_ASSERT(sLoadedAssets.find(assetHandle) != sLoadedAssets.end());
+				asset = sLoadedAssets.at(assetHandle);
+			}
+		}
+
+		// Loaded without holding the lock, the serializer may get other assets
+		const bool loaded = AssetImporter::TryLoadData(metadata, asset);
+
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+		auto& registeredMetadata = GetMetadataInternal(assetHandle);
+		if (!registeredMetadata.IsValid())
+			return false;
+
+		registeredMetadata.IsDataLoaded = loaded;
+		if (loaded)
+			sLoadedAssets[assetHandle] = asset;
+
+		return loaded;
+	}
+
+	Ref<Asset> AssetManager::LoadAsset(AssetHandle assetHandle)
+	{
+		std::unique_lock<std::recursive_mutex> lock(sAssetMutex);
+
+		auto memoryAsset = sMemoryAssets.find(assetHandle);
+		if (memoryAsset != sMemoryAssets.end())
+			return memoryAsset->second;
+
+		const auto& metadata = GetMetadataInternal(assetHandle);
+		if (!metadata.IsValid())
+			return nullptr;
+
+		if (metadata.IsDataLoaded)
+			return sLoadedAssets[assetHandle];
+
+		auto request = sLoaderData.Requests.find(assetHandle);
+		if (request != sLoaderData.Requests.end() && request->second.Started)
+		{
+			NR_CORE_ASSERT(request->second.LoadingThread != std::this_thread::get_id(), "[AssetManager] Circular asset dependency");
+
+			// Loads never wait on the thread that waits for them here, so blocking is fine
+			WaitForLoads(lock, [assetHandle]() { return sLoaderData.Requests.find(assetHandle) == sLoaderData.Requests.end(); });
+
+			auto loadedAsset = sLoadedAssets.find(assetHandle);
+			return loadedAsset != sLoadedAssets.end() ? loadedAsset->second : nullptr;
+		}
+
+		// Queued loads are taken over, anybody else asking for the asset now waits for this thread
+		if (request == sLoaderData.Requests.end())
+		{
+			request = sLoaderData.Requests.try_emplace(assetHandle).first;
+			request->second.Type = metadata.Type;
+			request->second.Order = sLoaderData.NextOrder++;
+		}
+		request->second.Started = true;
+		request->second.LoadingThread = std::this_thread::get_id();
+		lock.unlock();
+
+		return LoadAndFinishAsset(assetHandle);
+	}
+
+	Ref<Asset> AssetManager::GetLoadedAsset(AssetHandle assetHandle)
+	{
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+
+		auto memoryAsset = sMemoryAssets.find(assetHandle);
+		if (memoryAsset != sMemoryAssets.end())
+			return memoryAsset->second;
+
+		auto loadedAsset = sLoadedAssets.find(assetHandle);
+		return loadedAsset != sLoadedAssets.end() ? loadedAsset->second : nullptr;
+	}
+
+	Ref<Asset> AssetManager::LoadAssetData(AssetHandle assetHandle)
+	{
+		NR_PROFILE_FUNC();
+
+		AssetMetadata metadata;
+		{
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+			metadata = GetMetadataInternal(assetHandle);
+		}
+
+		if (!metadata.IsValid())
+			return nullptr;
+
+		// Dependencies (a Mesh's MeshSource, its textures, ...) are loaded by the serializer through GetAsset on this thread
+		Ref<Asset> asset;
+		if (!AssetImporter::TryLoadData(metadata, asset))
+			return nullptr;
+
+		return asset;
+	}
+
+	Ref<Asset> AssetManager::LoadAndFinishAsset(AssetHandle assetHandle)
+	{
+		if (JobSystem::IsMainThread())
+		{
+			Ref<Asset> asset = LoadAssetData(assetHandle);
+			FinishAssetLoad(assetHandle, asset);
+			return asset;
+		}
+
+		// The asset is published once the render commands of its load are in the command queue, so nothing draws it
+		// before its GPU resources exist. Every load records into its own list, replayed in the order it was recorded.
+		auto commandList = std::make_shared<Renderer::DeferredCommandList>();
+		Renderer::DeferredCommandList* previousCommandList = Renderer::SetDeferredCommandList(commandList.get());
+		Ref<Asset> asset = LoadAssetData(assetHandle);
+		Renderer::SetDeferredCommandList(previousCommandList);
+
+		JobSystem::Schedule([assetHandle, asset, commandList]()
+			{
+				Renderer::SubmitDeferred(*commandList);
+				FinishAssetLoad(assetHandle, asset);
+			}, "AssetManager::FinishAssetLoad", nullptr, nullptr, JobAffinity::MainThread);
+
+		return asset;
+	}
+
+	void AssetManager::FinishAssetLoad(AssetHandle assetHandle, const Ref<Asset>& asset)
+	{
+		NR_CORE_ASSERT(JobSystem::IsMainThread(), "Assets are published on the main thread");
+
+		std::vector<AssetLoadCallback> callbacks;
+		{
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+
+			// The asset may have been deleted while it was loading
+			auto& metadata = GetMetadataInternal(assetHandle);
+			if (metadata.IsValid())
+			{
+				metadata.IsDataLoaded = asset != nullptr;
+				if (asset)
+					sLoadedAssets[assetHandle] = asset;
+			}
+
+			auto request = sLoaderData.Requests.find(assetHandle);
+			if (request != sLoaderData.Requests.end())
+			{
+				callbacks = std::move(request->second.Callbacks);
+				sLoaderData.Requests.erase(request);
+			}
+		}
+		sLoaderData.LoadFinished.notify_all();
+
+		if (callbacks.empty())
+			return;
+
+		JobSystem::Schedule([callbacks, asset]()
+			{
+				for (const auto& callback : callbacks)
+					callback(asset);
+			}, "AssetManager::LoadCallbacks", nullptr, nullptr, JobAffinity::MainThread);
+	}
+
+	void AssetManager::WaitForLoads(std::unique_lock<std::recursive_mutex>& lock, const std::function<bool()>& done)
+	{
+		if (!JobSystem::IsMainThread())
+		{
+			sLoaderData.LoadFinished.wait(lock, done);
+			return;
+		}
+
+		// Loads on workers are finished by main thread jobs, so they have to keep running while the main thread waits
+		while (!done())
+		{
+			lock.unlock();
+			JobSystem::RunMainThreadJobs();
+			std::this_thread::yield();
+			lock.lock();
+		}
+	}
+
+	void AssetManager::RequestAsset(AssetHandle assetHandle, AssetLoadPriority priority, const AssetLoadCallback& callback)
+	{
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+
+		Ref<Asset> asset = GetLoadedAsset(assetHandle);
+		const auto& metadata = GetMetadataInternal(assetHandle);
+		if (asset || !metadata.IsValid())
+		{
+			if (callback)
+				JobSystem::Schedule([callback, asset]() { callback(asset); }, "AssetManager::LoadCallbacks", nullptr, nullptr, JobAffinity::MainThread);
+			return;
+		}
+
+		auto [requestIt, inserted] = sLoaderData.Requests.try_emplace(assetHandle);
+		AssetLoadRequest& request = requestIt->second;
+		if (callback)
+			request.Callbacks.push_back(callback);
+
+		if (!inserted)
+		{
+			if (priority > request.Priority)
+				request.Priority = priority;
+			return;
+		}
+
+		request.Type = metadata.Type;
+		request.Priority = priority;
+		request.Order = sLoaderData.NextOrder++;
+
+		if (Utils::IsMainThreadAsset(request.Type))
+		{
+			JobSystem::Schedule([assetHandle]() { LoadRequestedAsset(assetHandle); }, "AssetManager::LoadAsset", nullptr, nullptr, JobAffinity::MainThread);
+			return;
+		}
+
+		// Half of the workers at most, the rest keep running the frame's jobs
+		const uint32_t workerCount = JobSystem::GetWorkerCount();
+		const uint32_t maxLoaders = workerCount > 1 ? workerCount / 2 : 1;
+		if (sLoaderData.ActiveLoaders < maxLoaders)
+		{
+			sLoaderData.ActiveLoaders++;
+			JobSystem::Schedule(AssetLoaderJob, "AssetManager::AssetLoader");
+		}
+	}
+
+	bool AssetManager::IsAssetLoading(AssetHandle assetHandle)
+	{
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+		return sLoaderData.Requests.find(assetHandle) != sLoaderData.Requests.end();
+	}
+
+	void AssetManager::FinishPendingLoads()
+	{
+		NR_CORE_ASSERT(JobSystem::IsMainThread(), "Pending loads are finished on the main thread");
+
+		{
+			std::unique_lock<std::recursive_mutex> lock(sAssetMutex);
+			WaitForLoads(lock, []() { return sLoaderData.Requests.empty(); });
+		}
+
+		// The callbacks of the last loads were scheduled by FinishAssetLoad
+		JobSystem::RunMainThreadJobs();
+	}
+
+	void AssetManager::SetPlaceholderAsset(AssetType type, const Ref<Asset>& asset)
+	{
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+		sLoaderData.PlaceholderAssets[type] = asset;
+	}
+
+	Ref<Asset> AssetManager::GetPlaceholderAsset(AssetType type)
+	{
+		std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+		auto placeholder = sLoaderData.PlaceholderAssets.find(type);
+		return placeholder != sLoaderData.PlaceholderAssets.end() ? placeholder->second : nullptr;
+	}
+
+	void AssetManager::LoadRequestedAsset(AssetHandle assetHandle)
+	{
 		{
-			NR_CORE_WARN("Trying to reload asset that was never loaded");
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+			auto request = sLoaderData.Requests.find(assetHandle);
+			if (request == sLoaderData.Requests.end() || request->second.Started)
+				return;
 
-			Ref<Asset> asset;
-			metadata.IsDataLoaded = AssetImporter::TryLoadData(metadata, asset);
-			return metadata.IsDataLoaded;
+			request->second.Started = true;
+			request->second.LoadingThread = std::this_thread::get_id();
 		}
 
-		NR_CORE_ASSERT(sLoadedAssets.find(assetHandle) != sLoadedAssets.end());
-		Ref<Asset>& asset = sLoadedAssets.at(assetHandle);
-		metadata.IsDataLoaded = AssetImporter::TryLoadData(metadata, asset);
-		return metadata.IsDataLoaded;
+		LoadAndFinishAsset(assetHandle);
+	}
+
+	void AssetManager::AssetLoaderJob()
+	{
+		// Keeps taking the most important queued request until there are none left
+		for (;;)
+		{
+			AssetHandle assetHandle = 0;
+			{
+				std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+
+				AssetLoadRequest* next = nullptr;
+				for (auto& [handle, request] : sLoaderData.Requests)
+				{
+					if (request.Started || Utils::IsMainThreadAsset(request.Type))
+						continue;
+
+					if (!next || request.Priority > next->Priority || (request.Priority == next->Priority && request.Order < next->Order))
+					{
+						next = &request;
+						assetHandle = handle;
+					}
+				}
+
+				if (!next)
+				{
+					sLoaderData.ActiveLoaders--;
+					return;
+				}
+
+				next->Started = true;
+				next->LoadingThread = std::this_thread::get_id();
+			}
+
+			LoadAndFinishAsset(assetHandle);
+		}
 	}
 
 	void AssetManager::ProcessDirectory(const std::filesystem::path& directoryPath)
@@ -330,6 +718,7 @@ namespace NR
 			AssetType Type;
 		};
 		std::map<UUID, AssetRegistryEntry> sortedMap;
+		std::unique_lock<std::recursive_mutex> lock(sAssetMutex);
 		for (auto& [filepath, metadata] : sAssetRegistry)
 		{
 			if (!FileSystem::Exists(GetFileSystemPath(metadata)))
@@ -341,6 +730,8 @@ namespace NR
 			sortedMap[metadata.Handle] = { pathToSerialize, metadata.Type };
 		}
 
+		lock.unlock();
+
 		NR_CORE_INFO("[AssetManager] serializing asset registry with {0} entries", sortedMap.size());
 
 		YAML::Emitter out;
@@ -383,6 +774,8 @@ namespace NR
 				columnWidth = textSize.x * 2.0f;
 				ImGui::SetColumnWidth(0, columnWidth);
 			}
+
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
 			for (const auto& [path, metadata] : sAssetRegistry)
 			{
 				std::string handle = fmt::format("{0}", metadata.Handle);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <unordered_map>
 
 #include "NotRed/Project/Project.h"
@@ -24,10 +25,18 @@ namespace NR
 		std::string MeshSourcePath = "Assets/Meshes/Source/";
 	};
 
+	enum class AssetLoadPriority : uint8_t
+	{
+		Low = 0,
+		Normal,
+		High
+	};
+
 	class AssetManager
 	{
 	public:
 		using AssetsChangeEventFn = std::function<void(const std::vector<FileSystemChangedEvent>&)>;
+		using AssetLoadCallback = std::function<void(Ref<Asset>)>;
 	public:
 		static void Init();
 		static void SetAssetChangeCallback(const AssetsChangeEventFn& callback);
@@ -89,45 +98,27 @@ namespace NR
 				}
 			}
 
-			sAssetRegistry[metadata.FilePath.string()] = metadata;
-
-			WriteRegistryToFile();
-
 			Ref<T> asset = Ref<T>::Create(std::forward<Args>(args)...);
 			asset->Handle = metadata.Handle;
-			sLoadedAssets[asset->Handle] = asset;
+			{
+				std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+				sAssetRegistry[metadata.FilePath.string()] = metadata;
+				sLoadedAssets[asset->Handle] = asset;
+			}
+
+			WriteRegistryToFile();
 			AssetImporter::Serialize(metadata, asset);
 
 			return asset;
 		}
 
+		// Loads the asset on the calling thread if needed, waits for it instead if it is already being loaded asynchronously
 		template<typename T>
 		static Ref<T> GetAsset(AssetHandle assetHandle)
 		{
 			NR_PROFILE_FUNC();
 
-			if (IsMemoryAsset(assetHandle))
-				return sMemoryAssets[assetHandle].As<T>();
-
-			auto& metadata = GetMetadataInternal(assetHandle);
-			if (!metadata.IsValid())
-				return nullptr;
-
-			Ref<Asset> asset = nullptr;
-			if (!metadata.IsDataLoaded)
-			{
-				metadata.IsDataLoaded = AssetImporter::TryLoadData(metadata, asset);
-				if (!metadata.IsDataLoaded)
-					return nullptr;
-
-				sLoadedAssets[assetHandle] = asset;
-			}
-			else
-			{
-				asset = sLoadedAssets[assetHandle];
-			}
-
-			return asset.As<T>();
+			return LoadAsset(assetHandle).As<T>();
 		}
 
 		template<typename T>
@@ -136,12 +127,51 @@ namespace NR
 			return GetAsset<T>(GetAssetHandleFromFilePath(filepath));
 		}
 
+		// Returns the asset if it's loaded, otherwise requests it and returns the placeholder of its type until it is
+		template<typename T>
+		static Ref<T> GetAssetAsync(AssetHandle assetHandle, AssetLoadPriority priority = AssetLoadPriority::Normal)
+		{
+			if (Ref<Asset> asset = GetLoadedAsset(assetHandle))
+				return asset.As<T>();
+
+			RequestAsset(assetHandle, priority);
+
+			Ref<Asset> placeholder = GetPlaceholderAsset(T::GetStaticType());
+			return placeholder.As<T>();
+		}
+
+		// Queues the asset for the loader jobs. Assets it depends on are loaded along with it, the callback runs on the main
+		// thread once it is done and gets nullptr if the asset couldn't be loaded. Requesting an asset that is already
+		// queued only raises its priority.
+		static void RequestAsset(AssetHandle assetHandle, AssetLoadPriority priority = AssetLoadPriority::Normal, const AssetLoadCallback& callback = nullptr);
+
+		static bool IsAssetLoaded(AssetHandle assetHandle) { return GetLoadedAsset(assetHandle) != nullptr; }
+		static bool IsAssetLoading(AssetHandle assetHandle);
+
+		// Returned by GetAssetAsync while an asset of this type is still loading
+		static void SetPlaceholderAsset(AssetType type, const Ref<Asset>& asset);
+		static Ref<Asset> GetPlaceholderAsset(AssetType type);
+
+		// Placeholders have a handle of their own, so an asset from GetAssetAsync is one if its handle isn't the requested one
+		template<typename T>
+		static bool IsPlaceholderAsset(const Ref<T>& asset, AssetHandle assetHandle) { return asset && asset->Handle != assetHandle; }
+
+		// Blocks until every requested asset is loaded and the load callbacks ran, e.g. before saving what they fill in
+		static void FinishPendingLoads();
+
 		static bool FileExists(AssetMetadata& metadata)
 		{
 			return FileSystem::Exists(Project::GetActive()->GetAssetDirectory() / metadata.FilePath);
 		}
 
-		static const std::unordered_map<AssetHandle, Ref<Asset>>& GetLoadedAssets() { return sLoadedAssets; }
+		// Calls func(handle, asset) for every loaded asset with the asset lock held, so func must not wait for an asset load
+		template<typename Func>
+		static void ForEachLoadedAsset(Func&& func)
+		{
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
+			for (const auto& [handle, asset] : sLoadedAssets)
+				func(handle, asset);
+		}
 		static const AssetRegistry& GetAssetRegistry() { return sAssetRegistry; }
 
 		template<typename TAsset, typename... TArgs>
@@ -152,12 +182,14 @@ namespace NR
 			Ref<TAsset> asset = Ref<TAsset>::Create(std::forward<TArgs>(args)...);
 			asset->Handle = AssetHandle();
 
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
 			sMemoryAssets[asset->Handle] = asset;
 			return asset->Handle;
 		}
 
 		static bool IsMemoryAsset(AssetHandle handle)
 		{
+			std::scoped_lock<std::recursive_mutex> lock(sAssetMutex);
 			return sMemoryAssets.find(handle) != sMemoryAssets.end();
 		}
 
@@ -171,6 +203,15 @@ namespace NR
 
 		static AssetMetadata& GetMetadataInternal(AssetHandle handle);
 
+		static Ref<Asset> LoadAsset(AssetHandle assetHandle);
+		static Ref<Asset> GetLoadedAsset(AssetHandle assetHandle);
+		static Ref<Asset> LoadAssetData(AssetHandle assetHandle);
+		static Ref<Asset> LoadAndFinishAsset(AssetHandle assetHandle);
+		static void FinishAssetLoad(AssetHandle assetHandle, const Ref<Asset>& asset);
+		static void WaitForLoads(std::unique_lock<std::recursive_mutex>& lock, const std::function<bool()>& done);
+		static void LoadRequestedAsset(AssetHandle assetHandle);
+		static void AssetLoaderJob();
+
 		static void FileSystemChanged(const std::vector<FileSystemChangedEvent>& events);
 		static void AssetRenamed(AssetHandle assetHandle, const std::filesystem::path& newFilePath);
 		static void AssetMoved(AssetHandle assetHandle, const std::filesystem::path& destinationPath);
@@ -181,6 +222,9 @@ namespace NR
 		static std::unordered_map<AssetHandle, Ref<Asset>> sMemoryAssets;
 		static AssetsChangeEventFn sAssetsChangeCallback;
 		inline static AssetRegistry sAssetRegistry;
+
+		// Guards the registry and the asset maps, recursive since the public getters are used by the locked paths as well
+		inline static std::recursive_mutex sAssetMutex;
 	private:
 		friend class ContentBrowserPanel;
 		friend class ContentBrowserAsset;
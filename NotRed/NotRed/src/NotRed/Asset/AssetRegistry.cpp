@@ -14,6 +14,12 @@ namespace NR
 
 	std::filesystem::path AssetRegistry::GetPathKey(const std::filesystem::path& path) const
 	{
+		// Without a project, e.g. in the tests, paths are kept as they are
+		if (!Project::GetActive())
+		{
+			return path.lexically_normal();
+		}
+
 		auto key = std::filesystem::relative(path, Project::GetAssetDirectory());
 		if (key.empty())
 		{
@@ -243,6 +243,7 @@ namespace NR
 		NR_SERIALIZE_PROPERTY(MasterReverbSend, soundConfig->MasterReverbSend, out);
 		NR_SERIALIZE_PROPERTY(LPFilterValue, soundConfig->LPFilterValue, out);
 		NR_SERIALIZE_PROPERTY(HPFilterValue, soundConfig->HPFilterValue, out);
+		NR_SERIALIZE_PROPERTY(Streaming, (int)soundConfig->Streaming, out);
 
 		// TODO: move Spatialization to its own asset type
 		out << YAML::Key << "Spatialization";
@@ -301,6 +302,7 @@ namespace NR
 		NR_DESERIALIZE_PROPERTY(MasterReverbSend, soundConfig->MasterReverbSend, data, 0.0f);
 		NR_DESERIALIZE_PROPERTY(LPFilterValue, soundConfig->LPFilterValue, data, 20000.0f);
 		NR_DESERIALIZE_PROPERTY(HPFilterValue, soundConfig->HPFilterValue, data, 0.0f);
+		soundConfig->Streaming = data["Streaming"] ? static_cast<StreamingMode>(data["Streaming"].as<int>()) : StreamingMode::Auto;
 
 		auto spConfigData = data["Spatialization"];
 		if (spConfigData)
@@ -426,7 +428,6 @@ namespace NR
 		{
 			out << YAML::BeginMap;
 			out << YAML::Key << "AssetHandle" << YAML::Value << animationController->Handle;
-			out << YAML::Key << "IsPlaying" << YAML::Value << animationController->IsAnimationPlaying();
 			out << YAML::Key << "SkeletonAsset" << YAML::Value << animationController->GetSkeletonAsset()->Handle;
 			out << YAML::Key << "States" << YAML::Value;
 			out << YAML::BeginSeq;
@@ -472,7 +473,6 @@ namespace NR
 		YAML::Node animationControllerNode = data["AnimationController"];
 
 		Ref<AnimationController> animationController = Ref<AnimationController>::Create();
-		animationController->SetAnimationPlaying(animationControllerNode["IsPlaying"].as<bool>());
 		animationController->SetSkeletonAsset(AssetManager::GetAsset<SkeletonAsset>(animationControllerNode["SkeletonAsset"].as<uint64_t>()));
 		for (const auto& stateNode : animationControllerNode["States"]) 
 		{
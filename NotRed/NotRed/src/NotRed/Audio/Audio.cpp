@@ -2,6 +2,9 @@
 #include "Audio.h"
 
 #include <chrono>
+#include <condition_variable>
+
+#include "farbot/fifo.hpp"
 
 #include "NotRed/Debug/Profiler.h"
 
@@ -9,7 +12,45 @@ using namespace std::chrono_literals;
 
 namespace NR::Audio
 {
-    static std::queue<AudioFunctionCallback*> sAudioThreadJobsLocal;
+    // The fifo keeps a slot for every thread that ever pushed to it and makes threads share the first one once they run out,
+    // so only the first AUDIO_THREAD_MAX_PRODUCERS threads to post a command get to use it
+    using AudioCommandQueue = farbot::fifo<AudioCommand,
+        farbot::fifo_options::concurrency::single,
+        farbot::fifo_options::concurrency::multiple,
+        farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty,
+        farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty,
+        AUDIO_THREAD_MAX_PRODUCERS>;
+
+    struct AudioThreadData
+    {
+        AudioCommandQueue Commands{ AUDIO_THREAD_COMMAND_CAPACITY };
+
+        // Used only once Commands is full. While it holds anything, new commands go here too to keep them in order.
+        std::queue<AudioCommand> Overflow;
+        std::atomic<bool> bOverflowing = false;
+        std::mutex OverflowLock;
+
+        std::atomic<size_t> ProducerCount = 0;
+
+        std::mutex WakeUpLock;
+        std::condition_variable WakeUp;
+        std::atomic<bool> bWakeUpPending = false;
+    };
+
+    static AudioThreadData sData;
+
+    static bool CanPushToCommandQueue()
+    {
+        enum class ProducerState : uint8_t { Unknown, LockFree, Locked };
+        thread_local ProducerState state = ProducerState::Unknown;
+
+        if (state == ProducerState::Unknown)
+        {
+            state = sData.ProducerCount.fetch_add(1, std::memory_order_relaxed) < AUDIO_THREAD_MAX_PRODUCERS ? ProducerState::LockFree : ProducerState::Locked;
+        }
+
+        return state == ProducerState::LockFree;
+    }
 
     bool AudioThread::Start()
     {
@@ -52,6 +93,7 @@ namespace NR::Audio
         }
 
         sThreadActive = false;
+        sData.WakeUp.notify_one();
         return true;
     }
 
@@ -70,12 +112,21 @@ namespace NR::Audio
         return sAudioThreadID;
     }
 
-    void AudioThread::AddTask(AudioFunctionCallback*&& funcCb)
+    void AudioThread::AddTask(AudioCommand&& command)
     {
         NR_PROFILE_FUNC();
 
-        std::scoped_lock lock(sAudioThreadJobsLock);
-        sAudioThreadJobs.emplace(std::move(funcCb));
+        if (!CanPushToCommandQueue() || sData.bOverflowing.load(std::memory_order_acquire) || !sData.Commands.push(std::move(command)))
+        {
+            std::scoped_lock lock(sData.OverflowLock);
+            sData.Overflow.push(std::move(command));
+            sData.bOverflowing.store(true, std::memory_order_release);
+        }
+
+        // Only the first command since the last update needs to notify.
+        // A notification missed while the Audio Thread is about to wait only delays it until the wait times out.
+        if (!sData.bWakeUpPending.exchange(true, std::memory_order_acq_rel))
+            sData.WakeUp.notify_one();
     }
 
     void AudioThread::Update()
@@ -88,23 +139,37 @@ namespace NR::Audio
         {
             NR_PROFILE_FUNC("AudioThread::Update - Execution");
 
-            auto& jobs = sAudioThreadJobsLocal;
+            sData.bWakeUpPending.store(false, std::memory_order_release);
+
+            // Commands posted while these execute are handled in this update as well
+            AudioCommand command;
+            while (sData.Commands.pop(command))
             {
-                std::scoped_lock lock(sAudioThreadJobsLock);
-                sAudioThreadJobsLocal = sAudioThreadJobs;
-                sAudioThreadJobs = std::queue<AudioFunctionCallback*>();
+                command.Execute();
+                command.Reset();
             }
 
-            if (!jobs.empty())
+            if (sData.bOverflowing.load(std::memory_order_acquire))
             {
-                for (int i = (int)jobs.size() - 1; i >= 0; --i)
+                std::queue<AudioCommand> overflow;
                 {
-                    auto job = jobs.front();
+                    std::scoped_lock lock(sData.OverflowLock);
 
-                    job->Execute();
+                    // Anything that made it into Commands before the overflow started has been executed above
+                    while (sData.Commands.pop(command))
+                    {
+                        command.Execute();
+                        command.Reset();
+                    }
 
-                    jobs.pop();
-                    delete job;
+                    overflow.swap(sData.Overflow);
+                    sData.bOverflowing.store(false, std::memory_order_release);
+                }
+
+                while (!overflow.empty())
+                {
+                    overflow.front().Execute();
+                    overflow.pop();
                 }
             }
         }
@@ -112,7 +177,12 @@ namespace NR::Audio
 
         mUpdateCallback(sTimeFrame); 
         
-        std::this_thread::sleep_for(1ms);
+        // Wait out the rest of the update period, unless a command comes in
+        {
+            std::unique_lock lock(sData.WakeUpLock);
+            sData.WakeUp.wait_for(lock, 1ms, [] { return sData.bWakeUpPending.load(std::memory_order_acquire) || !sThreadActive; });
+        }
+
         sTimeFrame = sTimer.Elapsed();
         sLastFrameTime = sTimeFrame.GetMilliseconds();
     }
@@ -121,8 +191,6 @@ namespace NR::Audio
     std::atomic<bool> AudioThread::sThreadActive = false;
     std::atomic<std::thread::id> AudioThread::sAudioThreadID = std::thread::id();
 
-    std::queue<AudioFunctionCallback*> AudioThread::sAudioThreadJobs;
-    std::mutex AudioThread::sAudioThreadJobsLock;
     std::function<void(TimeFrame)> AudioThread::mUpdateCallback = nullptr;
 
     Timer AudioThread::sTimer;
@@ -3,6 +3,8 @@
 #include <thread>
 #include <atomic>
 #include <queue>
+#include <functional>
+#include <type_traits>
 
 #include "NotRed/Core/Timer.h"
 #include "NotRed/Core/TimeFrame.h"
@@ -18,24 +20,143 @@ namespace NR::Audio
     static constexpr auto STOPPING_FADE_MS = 28;
     static constexpr float SPEED_OF_SOUND = 343.3f;
 
+    // Files larger than this on disk are streamed when their SoundConfig leaves the choice to the engine
+    static constexpr uint64_t STREAMING_FILE_SIZE_THRESHOLD = 1024 * 1024;
+    static constexpr auto STREAMING_BUFFER_MS = 1000;
+    static constexpr auto STREAMING_PREFILL_MS = 100;
+
+    // Decoded sounds that aren't playing are freed once the cache grows past this
+    static constexpr uint64_t DECODED_CACHE_BUDGET = 64 * 1024 * 1024;
+
+    // Commands posted to the Audio Thread faster than it drains them spill into a locked overflow queue
+    static constexpr auto AUDIO_THREAD_COMMAND_CAPACITY = 1024;
+    // Threads that post through the lock-free queue, any further ones always take the overflow queue
+    static constexpr size_t AUDIO_THREAD_MAX_PRODUCERS = 64;
+
     using AudioThreadCallbackFunction = std::function<void()>;
 
-    class AudioFunctionCallback
+    /* ==============================================
+        Fixed size command for the Audio Thread.
+
+        Callables that fit the inline buffer are stored
+        in place, so posting a command doesn't allocate.
+        Larger ones fall back to the heap.
+        ----------------------------------------------
+    */
+    class AudioCommand
     {
     public:
-        AudioFunctionCallback(AudioThreadCallbackFunction f, const char* jobID = "None")
-            : mFunc(std::move(f)), mJobID(jobID) {}
+        static constexpr size_t INLINE_SIZE = 112;
+
+    public:
+        AudioCommand() = default;
+
+        template<typename FuncT, typename = std::enable_if_t<!std::is_same_v<std::decay_t<FuncT>, AudioCommand>>>
+        AudioCommand(FuncT&& func, const char* jobID = "None")
+            : mJobID(jobID)
+        {
+            using Callable = std::decay_t<FuncT>;
+            if constexpr (IsInline<Callable>())
+            {
+                new (mStorage) Callable(std::forward<FuncT>(func));
+                mOperations = &sInlineOperations<Callable>;
+            }
+            else
+            {
+                *reinterpret_cast<Callable**>(mStorage) = new Callable(std::forward<FuncT>(func));
+                mOperations = &sHeapOperations<Callable>;
+            }
+        }
+
+        AudioCommand(AudioCommand&& other) noexcept
+        {
+            MoveFrom(other);
+        }
+
+        AudioCommand& operator=(AudioCommand&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        AudioCommand(const AudioCommand&) = delete;
+        AudioCommand& operator=(const AudioCommand&) = delete;
+
+        ~AudioCommand()
+        {
+            Reset();
+        }
 
         void Execute()
         {
-            mFunc();
+            mOperations->Invoke(mStorage);
         }
 
-        const char* GetID() { return mJobID; }
+        void Reset()
+        {
+            if (mOperations)
+            {
+                mOperations->Destroy(mStorage);
+                mOperations = nullptr;
+            }
+        }
+
+        const char* GetID() const { return mJobID; }
+        explicit operator bool() const { return mOperations != nullptr; }
+
+    private:
+        struct Operations
+        {
+            void (*Invoke)(void* storage);
+            void (*Move)(void* destination, void* source); // Leaves the source destroyed
+            void (*Destroy)(void* storage);
+        };
+
+        template<typename Callable>
+        static constexpr bool IsInline()
+        {
+            return sizeof(Callable) <= INLINE_SIZE
+                && alignof(Callable) <= alignof(std::max_align_t)
+                && std::is_nothrow_move_constructible_v<Callable>;
+        }
+
+        template<typename Callable>
+        static constexpr Operations sInlineOperations{
+            [](void* storage) { (*static_cast<Callable*>(storage))(); },
+            [](void* destination, void* source)
+            {
+                new (destination) Callable(std::move(*static_cast<Callable*>(source)));
+                static_cast<Callable*>(source)->~Callable();
+            },
+            [](void* storage) { static_cast<Callable*>(storage)->~Callable(); }
+        };
+
+        template<typename Callable>
+        static constexpr Operations sHeapOperations{
+            [](void* storage) { (**static_cast<Callable**>(storage))(); },
+            [](void* destination, void* source) { *static_cast<Callable**>(destination) = *static_cast<Callable**>(source); },
+            [](void* storage) { delete *static_cast<Callable**>(storage); }
+        };
+
+        void MoveFrom(AudioCommand& other)
+        {
+            mJobID = other.mJobID;
+            mOperations = other.mOperations;
+            if (mOperations)
+            {
+                mOperations->Move(mStorage, other.mStorage);
+                other.mOperations = nullptr;
+            }
+        }
 
     private:
-        AudioThreadCallbackFunction const mFunc;
-        const char* mJobID;
+        alignas(std::max_align_t) std::byte mStorage[INLINE_SIZE];
+        const Operations* mOperations = nullptr;
+        const char* mJobID = "None";
     };
 
     class AudioThread
@@ -49,13 +170,7 @@ namespace NR::Audio
 
         static std::thread::id GetThreadID();
 
-    private:
-        static void AddTask(AudioFunctionCallback*&& funcCb);
-
-        static void Update();
-
-        static float GetFrameTime() { return sLastFrameTime.load(); }
-
+        /* Called every update after the commands ran. Has to be bound before Start, the AudioEngine binds its own Update. */
         template<typename C, void (C::* Function)(TimeFrame)>
         static void BindUpdateFunction(C* instance)
         {
@@ -68,13 +183,19 @@ namespace NR::Audio
             mUpdateCallback = [func](TimeFrame dt) { func(dt); };
         }
 
+    private:
+        /* Lock-free unless the command queue is full. Wakes the Audio Thread up if it is waiting for its next update. */
+        static void AddTask(AudioCommand&& command);
+
+        static void Update();
+
+        static float GetFrameTime() { return sLastFrameTime.load(); }
+
     private:
         static std::thread* sAudioThread;
         static std::atomic<bool> sThreadActive;
         static std::atomic<std::thread::id> sAudioThreadID;
 
-        static std::queue<AudioFunctionCallback*> sAudioThreadJobs;
-        static std::mutex sAudioThreadJobsLock;
         static std::function<void(TimeFrame)> mUpdateCallback;
 
         static Timer sTimer;
@@ -35,11 +35,6 @@ namespace NR
 
 	Audio::Stats AudioEngine::sStats;
 
-	void AudioEngine::ExecuteOnAudioThread(AudioThreadCallbackFunction func, const char* jobID)
-	{
-		AudioThread::AddTask(new AudioFunctionCallback(std::move(func), jobID));
-	}
-
 	void MemFreeCallback(void* p, void* pUserData)
 	{
 		if (p == NULL)
@@ -254,6 +249,7 @@ namespace NR
 
 		mSourceManager.UninitializeEffects();
 		mMasterReverb.reset();
+		mDecodedSoundCache.Clear();
 
 		ma_engine_uninit(&mEngine);
 
@@ -1640,6 +1636,12 @@ namespace NR
 
 	void AudioEngine::SceneDestruct(UUID sceneID)
 	{
+		// Scenes can be created without an audio engine (e.g. by the tests)
+		if (!sInstance)
+		{
+			return;
+		}
+
 		auto& instance = Get();
 
 		if (auto sceneObjects = instance.mComponentObjectMap.Get(sceneID))
@@ -57,6 +57,11 @@ namespace NR
                 TotalSources = other.TotalSources;
                 MemEngine = other.MemEngine;
                 MemResManager = other.MemResManager;
+                MemDecodedCache = other.MemDecodedCache;
+                MemStreaming = other.MemStreaming;
+                NumStreamingSounds = other.NumStreamingSounds;
+                StartLatency = other.StartLatency;
+                MaxStartLatency = other.MaxStartLatency;
                 FrameTime = other.FrameTime;
                 NumAudioComps = other.NumAudioComps;
             }
@@ -67,7 +72,14 @@ namespace NR
             uint32_t TotalSources = 0;
             uint64_t MemEngine = 0;
             uint64_t MemResManager = 0;
+            uint64_t MemDecodedCache = 0;
+            uint64_t MemStreaming = 0;
+            uint32_t NumStreamingSounds = 0;
             float FrameTime = 0.0f;
+
+            // Time it took to set up the data source of the last sound started, in milliseconds
+            float StartLatency = 0.0f;
+            float MaxStartLatency = 0.0f;
             uint64_t NumAudioComps = 0;
 
             mutable std::shared_mutex mutex;
@@ -239,6 +251,8 @@ namespace NR
 
         Audio::DSP::Reverb* GetMasterReverb() { return mMasterReverb.get(); }
 
+        Audio::DecodedSoundCache mDecodedSoundCache;
+
 
         //==================================================================================
 
@@ -298,7 +312,11 @@ namespace NR
 
         // TODO: add blocking vs async versions
         /* Execute arbitrary function on Audio Thread. Used to synchronize updates between Game Thread and Audio Thread */
-        static void ExecuteOnAudioThread(Audio::AudioThreadCallbackFunction func, /*void* parameter, */const char* jobID = "NONE");
+        template<typename FuncT>
+        static void ExecuteOnAudioThread(FuncT&& func, const char* jobID = "NONE")
+        {
+            Audio::AudioThread::AddTask(Audio::AudioCommand(std::forward<FuncT>(func), jobID));
+        }
 
         /* Add AudioComponent to AudioComponentRegistry for easy access from AduioEngine. */
         void RegisterAudioComponent(Entity entity);
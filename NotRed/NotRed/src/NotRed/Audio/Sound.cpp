@@ -4,6 +4,7 @@
 #include "AudioEngine.h"
 
 #include "NotRed/Asset/AssetManager.h"
+#include "NotRed/Core/Timer.h"
 
 namespace NR
 {
@@ -64,12 +65,11 @@ namespace NR
         NR_CORE_ASSERT(!IsPlaying());
         NR_CORE_ASSERT(!bIsReadyToPlay);
 
+        Timer startTimer;
+
         // Reset Finished flag so that we don't accidentally release this voice again while it's starting for the new source
         bFinished = false;
 
-        // TODO: handle passing in different flags for decoding (from data source asset)
-        // TODO: and handle decoding somewhere else, in some other way
-
         if (!config->FileAsset)
             return false;
 
@@ -78,13 +78,53 @@ namespace NR
         std::string filepath = AssetManager::GetFileSystemPathString(assetMetadata);
         mDebugName = Utils::GetFilename(filepath);
 
+        bool streaming = config->Streaming == StreamingMode::Stream;
+        if (config->Streaming == StreamingMode::Auto)
+        {
+            std::error_code error;
+            const uintmax_t fileSize = std::filesystem::file_size(filepath, error);
+            streaming = !error && fileSize > STREAMING_FILE_SIZE_THRESHOLD;
+        }
+
+        ma_data_source* dataSource = nullptr;
+        if (streaming)
+        {
+            if (!mStream)
+                mStream = CreateScope<StreamingSoundSource>();
+
+            if (!mStream->Initialize(filepath))
+                return false;
+
+            // Counted as soon as the stream exists, ReleaseDataSource takes it off again on every path
+            {
+                std::scoped_lock lock{ AudioEngine::sStats.mutex };
+                AudioEngine::sStats.MemStreaming += mStream->GetBufferSize();
+                AudioEngine::sStats.NumStreamingSounds++;
+            }
+
+            mStream->SetLooping(config->bLooping);
+            dataSource = mStream->GetDataSource();
+        }
+        else
+        {
+            mDecodedData = audioEngine->mDecodedSoundCache.Get(config->FileAsset, filepath, ma_engine_get_sample_rate(&audioEngine->mEngine));
+            if (!mDecodedData)
+                return false;
+
+            ma_audio_buffer_ref_init(ma_format_f32, mDecodedData->Channels, mDecodedData->Frames.data(), mDecodedData->FrameCount, &mDecodedBuffer);
+            dataSource = &mDecodedBuffer;
+        }
+
         ma_result result;
 
-        ma_uint32 flags = MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_NO_SPATIALIZATION;
-        result = ma_sound_init_from_file(&audioEngine->mEngine, filepath.c_str(), flags, nullptr, nullptr, &mSound);
+        ma_uint32 flags = MA_SOUND_FLAG_NO_SPATIALIZATION;
+        result = ma_sound_init_from_data_source(&audioEngine->mEngine, dataSource, flags, nullptr, &mSound);
 
         if (result != MA_SUCCESS)
+        {
+            ReleaseDataSource();
             return false;
+        }
 
         InitializeEffects(config);
 
@@ -99,10 +139,46 @@ namespace NR
 
         SetLooping(config->bLooping);
 
+        {
+            const float startLatency = startTimer.ElapsedMillis();
+
+            auto& stats = AudioEngine::sStats;
+            std::scoped_lock lock{ stats.mutex };
+            stats.MemDecodedCache = audioEngine->mDecodedSoundCache.GetMemoryUsage();
+            stats.StartLatency = startLatency;
+            stats.MaxStartLatency = std::max(stats.MaxStartLatency, startLatency);
+        }
+
         bIsReadyToPlay = result == MA_SUCCESS;
         return result == MA_SUCCESS;
     }
 
+    void Sound::ReleaseDataSource()
+    {
+        auto& audioEngine = AudioEngine::Get();
+
+        if (mStream && mStream->IsInitialized())
+        {
+            {
+                std::scoped_lock lock{ AudioEngine::sStats.mutex };
+                AudioEngine::sStats.MemStreaming -= mStream->GetBufferSize();
+                AudioEngine::sStats.NumStreamingSounds--;
+            }
+            mStream->Uninitialize();
+        }
+
+        if (mDecodedData)
+        {
+            ma_audio_buffer_ref_uninit(&mDecodedBuffer);
+            mDecodedData = nullptr;
+
+            audioEngine.mDecodedSoundCache.Trim(DECODED_CACHE_BUDGET);
+
+            std::scoped_lock lock{ AudioEngine::sStats.mutex };
+            AudioEngine::sStats.MemDecodedCache = audioEngine.mDecodedSoundCache.GetMemoryUsage();
+        }
+    }
+
     void Sound::InitializeEffects(const Ref<SoundConfig>& config)
     {
         ma_node_base* currentHeaderNode = &mSound.engineNode.baseNode;
@@ -168,6 +244,9 @@ namespace NR
             if (mSound.engineNode.baseNode.pCachedData != NULL && mSound.pDataSource != NULL)
                 ma_sound_uninit(&mSound);
 
+            // The mixing thread no longer reads from the data source once the sound is uninitialized
+            ReleaseDataSource();
+
             if (mMasterSplitter.base.pCachedData != NULL && mMasterSplitter.base._pHeap != NULL)
             {
                 ma_allocation_callbacks* allocationCallbacks = &mSound.engineNode.pEngine->pResourceManager->config.allocationCallbacks;
@@ -387,6 +466,9 @@ namespace NR
     {
         bLooping = looping;
         ma_sound_set_looping(&mSound, bLooping);
+
+        if (mStream && mStream->IsInitialized())
+            mStream->SetLooping(bLooping);
     }
 
     float Sound::GetVolume()
@@ -435,6 +517,9 @@ namespace NR
 
         mStopFadeTime = std::max(0.0, mStopFadeTime - (double)dt);
 
+        if (mStream)
+            mStream->Update();
+
         switch (mPlayState)
         {
         case ESoundPlayState::Stopped:
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SoundObject.h"
+#include "SoundData.h"
 #include "miniaudioInc.h"
 
 #include <glm/glm.hpp>
@@ -26,6 +27,13 @@ namespace NR
         // TODO: CusomCurve
     };
 
+    enum class StreamingMode
+    {
+        Auto,          // Stream files larger than Audio::STREAMING_FILE_SIZE_THRESHOLD, decode the rest.
+        Decode,        // Decode the whole file before playing. Decoded data is shared by every Sound playing the file.
+        Stream         // Decode while playing. For music and long ambience loops.
+    };
+
     /* ==============================================
         Configuration for 3D spatialization behavior
         ---------------------------------------------
@@ -70,6 +78,8 @@ namespace NR
         float VolumeMultiplier = 1.0f;
         float PitchMultiplier = 1.0f;
 
+        StreamingMode Streaming = StreamingMode::Auto;
+
         bool bSpatializationEnabled = false;
         Ref<SpatializationConfig> Spatialization{ new SpatializationConfig() };        // Configuration for 3D spatialization behavior
 
@@ -179,6 +189,9 @@ namespace NR
 
         void InitializeEffects(const Ref<SoundConfig>& config);
 
+        /* Release the decoded data, or the stream, the sound was reading from */
+        void ReleaseDataSource();
+
 
     private:
         friend class AudioEngine;
@@ -213,6 +226,11 @@ namespace NR
         ma_sound mSound;
         ma_splitter_node mMasterSplitter;
 
+        /* Exactly one of these feeds mSound */
+        Ref<Audio::DecodedSoundData> mDecodedData;
+        ma_audio_buffer_ref mDecodedBuffer;
+        Scope<Audio::StreamingSoundSource> mStream;
+
         bool bIsReadyToPlay = false;
 
         // TODO
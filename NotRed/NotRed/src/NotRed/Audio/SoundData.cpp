@@ -0,0 +1,302 @@
+#include <nrpch.h>
+#include "SoundData.h"
+
+#include "Audio.h"
+
+#include "NotRed/Debug/Profiler.h"
+
+namespace NR::Audio
+{
+    //==============================================================================
+    /// DecodedSoundCache
+
+    Ref<DecodedSoundData> DecodedSoundCache::Get(AssetHandle fileAsset, const std::string& filepath, uint32_t sampleRate)
+    {
+        auto entry = mEntries.find(fileAsset);
+        if (entry != mEntries.end())
+            return entry->second;
+
+        NR_PROFILE_FUNC();
+
+        ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 0, sampleRate);
+        ma_decoder decoder;
+        if (ma_decoder_init_file(filepath.c_str(), &config, &decoder) != MA_SUCCESS)
+            return nullptr;
+
+        Ref<DecodedSoundData> data = Ref<DecodedSoundData>::Create();
+        data->Channels = decoder.outputChannels;
+
+        // Not every format knows its length up front, those grow chunk by chunk
+        ma_uint64 length = 0;
+        if (ma_decoder_get_length_in_pcm_frames(&decoder, &length) == MA_SUCCESS && length > 0)
+            data->Frames.reserve(length * data->Channels);
+
+        std::vector<float> chunk(PCM_FRAME_CHUNK_SIZE * data->Channels);
+        for (;;)
+        {
+            ma_uint64 framesRead = 0;
+            ma_result result = ma_decoder_read_pcm_frames(&decoder, chunk.data(), PCM_FRAME_CHUNK_SIZE, &framesRead);
+            data->Frames.insert(data->Frames.end(), chunk.begin(), chunk.begin() + framesRead * data->Channels);
+
+            if (result != MA_SUCCESS || framesRead < PCM_FRAME_CHUNK_SIZE)
+                break;
+        }
+        ma_decoder_uninit(&decoder);
+
+        data->FrameCount = data->Frames.size() / data->Channels;
+        if (data->FrameCount == 0)
+            return nullptr;
+
+        data->Frames.shrink_to_fit();
+        mMemoryUsage += data->GetSize();
+        mEntries[fileAsset] = data;
+
+        return data;
+    }
+
+    void DecodedSoundCache::Trim(uint64_t budget)
+    {
+        for (auto it = mEntries.begin(); it != mEntries.end() && mMemoryUsage > budget;)
+        {
+            // The cache holds the only reference, nothing is playing it
+            if (it->second->GetRefCount() == 1)
+            {
+                mMemoryUsage -= it->second->GetSize();
+                it = mEntries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void DecodedSoundCache::Clear()
+    {
+        mEntries.clear();
+        mMemoryUsage = 0;
+    }
+
+    //==============================================================================
+    /// StreamingSoundSource
+
+    ma_data_source_vtable StreamingSoundSource::sVTable = {
+        StreamingSoundSource::OnRead,
+        StreamingSoundSource::OnSeek,
+        StreamingSoundSource::OnGetDataFormat,
+        StreamingSoundSource::OnGetCursor,
+        StreamingSoundSource::OnGetLength
+    };
+
+    StreamingSoundSource::~StreamingSoundSource()
+    {
+        Uninitialize();
+    }
+
+    bool StreamingSoundSource::Initialize(const std::string& filepath)
+    {
+        NR_CORE_ASSERT(!bInitialized);
+        NR_PROFILE_FUNC();
+
+        // Decoding at the file's own sample rate, the sound's resampler converts it
+        ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, 0, 0);
+        if (ma_decoder_init_file(filepath.c_str(), &decoderConfig, &mDecoder) != MA_SUCCESS)
+            return false;
+
+        mChannels = mDecoder.outputChannels;
+        if (ma_decoder_get_length_in_pcm_frames(&mDecoder, &mLength) != MA_SUCCESS)
+            mLength = 0;
+
+        const ma_uint32 bufferFrames = (mDecoder.outputSampleRate * STREAMING_BUFFER_MS) / 1000;
+        if (ma_pcm_rb_init(ma_format_f32, mChannels, bufferFrames, nullptr, nullptr, &mBuffer) != MA_SUCCESS)
+        {
+            ma_decoder_uninit(&mDecoder);
+            return false;
+        }
+
+        mBufferSize = (uint64_t)bufferFrames * ma_get_bytes_per_frame(ma_format_f32, mChannels);
+
+        ma_data_source_config dataSourceConfig = ma_data_source_config_init();
+        dataSourceConfig.vtable = &sVTable;
+        ma_data_source_init(&dataSourceConfig, &mDataSource.base);
+        mDataSource.owner = this;
+
+        if (!mDecodeJob)
+            mDecodeJob = Ref<JobCounter>::Create();
+
+        mCursor = 0;
+        mSeekTarget = 0;
+        bSeekPending = false;
+        bDecoderAtEnd = false;
+        bInitialized = true;
+
+        // Enough to start playing right away, Update() schedules the rest
+        Decode((mDecoder.outputSampleRate * STREAMING_PREFILL_MS) / 1000);
+
+        return true;
+    }
+
+    void StreamingSoundSource::Uninitialize()
+    {
+        if (!bInitialized)
+            return;
+
+        WaitForDecode();
+
+        ma_data_source_uninit(&mDataSource.base);
+        ma_pcm_rb_uninit(&mBuffer);
+        ma_decoder_uninit(&mDecoder);
+
+        bInitialized = false;
+    }
+
+    void StreamingSoundSource::Update()
+    {
+        if (!bInitialized || !mDecodeJob->IsDone())
+            return;
+
+        const bool needsData = !bDecoderAtEnd && ma_pcm_rb_available_write(&mBuffer) >= ma_pcm_rb_get_subbuffer_size(&mBuffer) / 2;
+        if (!needsData && !bSeekPending)
+            return;
+
+        JobSystem::Schedule([this]() { Decode(ma_pcm_rb_get_subbuffer_size(&mBuffer)); }, "StreamingSoundSource::Decode", mDecodeJob);
+    }
+
+    void StreamingSoundSource::WaitForDecode()
+    {
+        // The decode job is short, not worth running other jobs on the Audio Thread for
+        while (mDecodeJob && !mDecodeJob->IsDone())
+            std::this_thread::yield();
+    }
+
+    void StreamingSoundSource::Decode(uint32_t maxFrames)
+    {
+        NR_PROFILE_FUNC();
+
+        // Nothing reads from the buffer while a seek is pending, so it can be reset here
+        if (bSeekPending.load(std::memory_order_acquire))
+        {
+            const uint64_t target = mSeekTarget.load();
+            ma_pcm_rb_reset(&mBuffer);
+            ma_decoder_seek_to_pcm_frame(&mDecoder, target);
+
+            mCursor = target;
+            bDecoderAtEnd = false;
+            bSeekPending.store(false, std::memory_order_release);
+        }
+
+        uint32_t framesDecoded = 0;
+        bool emptyLoop = false;
+        while (framesDecoded < maxFrames && !bDecoderAtEnd)
+        {
+            ma_uint32 framesToWrite = maxFrames - framesDecoded;
+            void* buffer = nullptr;
+            if (ma_pcm_rb_acquire_write(&mBuffer, &framesToWrite, &buffer) != MA_SUCCESS || framesToWrite == 0)
+                break;
+
+            ma_uint64 framesRead = 0;
+            ma_decoder_read_pcm_frames(&mDecoder, buffer, framesToWrite, &framesRead);
+            ma_pcm_rb_commit_write(&mBuffer, (ma_uint32)framesRead);
+            framesDecoded += (uint32_t)framesRead;
+
+            if (framesRead < framesToWrite)
+            {
+                // A file with no frames in it would loop forever
+                if (!bLooping || (framesRead == 0 && emptyLoop))
+                {
+                    bDecoderAtEnd = true;
+                    break;
+                }
+
+                emptyLoop = framesRead == 0;
+                ma_decoder_seek_to_pcm_frame(&mDecoder, 0);
+            }
+        }
+    }
+
+    ma_result StreamingSoundSource::OnRead(ma_data_source* pDataSource, void* pFramesOut, ma_uint64 frameCount, ma_uint64* pFramesRead)
+    {
+        auto* source = static_cast<stream_data_source*>(pDataSource)->owner;
+        const ma_uint32 bytesPerFrame = ma_get_bytes_per_frame(ma_format_f32, source->mChannels);
+
+        if (source->bSeekPending.load(std::memory_order_acquire))
+        {
+            if (pFramesOut)
+                ma_silence_pcm_frames(pFramesOut, frameCount, ma_format_f32, source->mChannels);
+
+            *pFramesRead = frameCount;
+            return MA_SUCCESS;
+        }
+
+        ma_uint64 totalFramesRead = 0;
+        while (totalFramesRead < frameCount)
+        {
+            ma_uint32 framesToRead = (ma_uint32)(frameCount - totalFramesRead);
+            void* buffer = nullptr;
+            if (ma_pcm_rb_acquire_read(&source->mBuffer, &framesToRead, &buffer) != MA_SUCCESS || framesToRead == 0)
+                break;
+
+            if (pFramesOut)
+                memcpy((uint8_t*)pFramesOut + totalFramesRead * bytesPerFrame, buffer, (size_t)framesToRead * bytesPerFrame);
+
+            ma_pcm_rb_commit_read(&source->mBuffer, framesToRead);
+            totalFramesRead += framesToRead;
+        }
+
+        uint64_t cursor = source->mCursor.load() + totalFramesRead;
+        if (source->mLength > 0 && cursor >= source->mLength)
+            cursor %= source->mLength;
+        source->mCursor = cursor;
+
+        if (totalFramesRead < frameCount)
+        {
+            if (source->bDecoderAtEnd && ma_pcm_rb_available_read(&source->mBuffer) == 0)
+            {
+                *pFramesRead = totalFramesRead;
+                return MA_AT_END;
+            }
+
+            // The decode job fell behind, fill the gap with silence rather than ending the sound
+            if (pFramesOut)
+                ma_silence_pcm_frames((uint8_t*)pFramesOut + totalFramesRead * bytesPerFrame, frameCount - totalFramesRead, ma_format_f32, source->mChannels);
+            totalFramesRead = frameCount;
+        }
+
+        *pFramesRead = totalFramesRead;
+        return MA_SUCCESS;
+    }
+
+    ma_result StreamingSoundSource::OnSeek(ma_data_source* pDataSource, ma_uint64 frameIndex)
+    {
+        auto* source = static_cast<stream_data_source*>(pDataSource)->owner;
+
+        // Restarting a sound that hasn't played yet doesn't need the buffer refilled
+        if (!source->bSeekPending && frameIndex == source->mCursor)
+            return MA_SUCCESS;
+
+        source->mSeekTarget = frameIndex;
+        source->bSeekPending.store(true, std::memory_order_release);
+        return MA_SUCCESS;
+    }
+
+    ma_result StreamingSoundSource::OnGetDataFormat(ma_data_source* pDataSource, ma_format* pFormat, ma_uint32* pChannels, ma_uint32* pSampleRate, ma_channel* pChannelMap, size_t channelMapCap)
+    {
+        auto* source = static_cast<stream_data_source*>(pDataSource)->owner;
+        return ma_data_source_get_data_format(&source->mDecoder, pFormat, pChannels, pSampleRate, pChannelMap, channelMapCap);
+    }
+
+    ma_result StreamingSoundSource::OnGetCursor(ma_data_source* pDataSource, ma_uint64* pCursor)
+    {
+        auto* source = static_cast<stream_data_source*>(pDataSource)->owner;
+        *pCursor = source->mCursor;
+        return MA_SUCCESS;
+    }
+
+    ma_result StreamingSoundSource::OnGetLength(ma_data_source* pDataSource, ma_uint64* pLength)
+    {
+        auto* source = static_cast<stream_data_source*>(pDataSource)->owner;
+        *pLength = source->mLength;
+        return source->mLength > 0 ? MA_SUCCESS : MA_NOT_IMPLEMENTED;
+    }
+
+} // namespace NR::Audio
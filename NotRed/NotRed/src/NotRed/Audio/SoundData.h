@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+#include "MiniAudio/include/miniaudioInc.h"
+
+#include "NotRed/Asset/Asset.h"
+#include "NotRed/Core/JobSystem.h"
+
+namespace NR::Audio
+{
+    /* ==============================================
+        PCM data of a fully decoded file.
+
+        Shared by every Sound playing the same file
+        ----------------------------------------------
+    */
+    struct DecodedSoundData : public RefCounted
+    {
+        std::vector<float> Frames;      // Interleaved, at the engine's sample rate
+        uint64_t FrameCount = 0;
+        uint32_t Channels = 0;
+
+        uint64_t GetSize() const { return Frames.size() * sizeof(float); }
+    };
+
+    /* ==============================================
+        Keeps decoded files around between plays, so
+        short sounds are decoded once, not every time
+        they are triggered.
+
+        Only used from the Audio Thread
+        ----------------------------------------------
+    */
+    class DecodedSoundCache
+    {
+    public:
+        /* Decodes the file the first time it is requested.
+           @param sampleRate - sample rate to decode to, should be the engine's
+
+           @returns nullptr - if the file couldn't be decoded
+        */
+        Ref<DecodedSoundData> Get(AssetHandle fileAsset, const std::string& filepath, uint32_t sampleRate);
+
+        /* Free data no Sound is using until the cache is within budget */
+        void Trim(uint64_t budget);
+        void Clear();
+
+        uint64_t GetMemoryUsage() const { return mMemoryUsage; }
+
+    private:
+        std::unordered_map<AssetHandle, Ref<DecodedSoundData>> mEntries;
+        uint64_t mMemoryUsage = 0;
+    };
+
+    /* ==============================================
+        Data source decoding a file incrementally.
+
+        Decoded frames go through a ring buffer that
+        the mixing thread reads from, jobs scheduled
+        from the Audio Thread keep it filled.
+        ----------------------------------------------
+    */
+    class StreamingSoundSource
+    {
+    public:
+        struct stream_data_source
+        {
+            ma_data_source_base base;
+            StreamingSoundSource* owner;
+        };
+
+    public:
+        StreamingSoundSource() = default;
+        ~StreamingSoundSource();
+
+        /* Open the file and decode the first STREAMING_PREFILL_MS of it on the calling thread.
+           @returns true - if the file could be opened
+        */
+        bool Initialize(const std::string& filepath);
+
+        /* Waits for the decode job in flight */
+        void Uninitialize();
+
+        /* Schedule a decode job if the buffer is running low, or a seek is pending. Called from the Audio Thread. */
+        void Update();
+
+        /* Returns once the job scheduled by the last Update() has decoded its frames */
+        void WaitForDecode();
+
+        /* Looping is handled while decoding, so that there is no gap at the loop point */
+        void SetLooping(bool looping) { bLooping = looping; }
+
+        bool IsInitialized() const { return bInitialized; }
+        ma_data_source* GetDataSource() { return &mDataSource; }
+        uint64_t GetBufferSize() const { return bInitialized ? mBufferSize : 0; }
+
+    private:
+        void Decode(uint32_t maxFrames);
+
+        static ma_result OnRead(ma_data_source* pDataSource, void* pFramesOut, ma_uint64 frameCount, ma_uint64* pFramesRead);
+        static ma_result OnSeek(ma_data_source* pDataSource, ma_uint64 frameIndex);
+        static ma_result OnGetDataFormat(ma_data_source* pDataSource, ma_format* pFormat, ma_uint32* pChannels, ma_uint32* pSampleRate, ma_channel* pChannelMap, size_t channelMapCap);
+        static ma_result OnGetCursor(ma_data_source* pDataSource, ma_uint64* pCursor);
+        static ma_result OnGetLength(ma_data_source* pDataSource, ma_uint64* pLength);
+
+    private:
+        stream_data_source mDataSource{};
+        ma_decoder mDecoder;
+        ma_pcm_rb mBuffer;
+
+        uint32_t mChannels = 0;
+        uint64_t mLength = 0;
+        uint64_t mBufferSize = 0;
+
+        Ref<JobCounter> mDecodeJob;
+
+        std::atomic<bool> bLooping = false;
+        std::atomic<bool> bDecoderAtEnd = false;
+
+        /* Seeks come from the mixing thread. It plays silence until a decode job has moved the decoder and refilled the buffer. */
+        std::atomic<bool> bSeekPending = false;
+        std::atomic<uint64_t> mSeekTarget = 0;
+
+        /* Read position of the mixing thread */
+        std::atomic<uint64_t> mCursor = 0;
+
+        bool bInitialized = false;
+
+        static ma_data_source_vtable sVTable;
+    };
+
+} // namespace NR::Audio
@@ -32,6 +32,8 @@
 
 #include "NotRed/Debug/Profiler.h"
 
+#include "JobSystem.h"
+
 extern bool gApplicationRunning;
 extern ImGuiContext* GImGui;
 
@@ -42,7 +44,7 @@ namespace NR
     Application* Application::sInstance = nullptr;
 
     Application::Application(const ApplicationSpecification& specification)
-        : mSpecification(specification)
+        : mSpecification(specification), mRenderThread(specification.CoreThreadingPolicy)
     {
         sInstance = this;
 
@@ -53,6 +55,8 @@ namespace NR
 
         mProfiler = new PerformanceProfiler();
 
+        JobSystem::Init();
+
         WindowSpecification windowSpec;
         windowSpec.Title = specification.Name;
         windowSpec.Width = specification.WindowWidth;
@@ -78,6 +82,9 @@ namespace NR
         Renderer::Init();
         Renderer::WaitAndRender();
 
+        // Everything from here on is executed when the render thread is kicked
+        mRenderThread.Run();
+
         if (mSpecification.EnableImGui)
         {
             mImGuiLayer = ImGuiLayer::Create();
@@ -92,6 +99,8 @@ namespace NR
 
     Application::~Application()
     {
+        mRenderThread.Terminate();
+
         mWindow->SetEventCallback([](Event& e) {});
 
         for (Layer* layer : mLayerStack)
@@ -117,6 +126,8 @@ namespace NR
         }
         Renderer::Shutdown();
 
+        JobSystem::Shutdown();
+
         delete mProfiler;
         mProfiler = nullptr;
     }
@@ -156,6 +167,9 @@ namespace NR
                 std::string numAC = std::to_string(audioStats.NumAudioComps);
                 std::string ramEn = Utils::BytesToString(audioStats.MemEngine);
                 std::string ramRM = Utils::BytesToString(audioStats.MemResManager);
+                std::string ramDecoded = Utils::BytesToString(audioStats.MemDecodedCache);
+                std::string ramStreaming = Utils::BytesToString(audioStats.MemStreaming);
+                std::string streaming = std::to_string(audioStats.NumStreamingSounds);
 
                 ImGui::Text("Audio Objects: %s", objects.c_str());
                 ImGui::Text("Active Events: %s", events.c_str());
@@ -167,6 +181,12 @@ namespace NR
                 ImGui::Text("Frame Time: %.3fms\n", audioStats.FrameTime);
                 ImGui::Text("Used RAM (Engine - backend): %s", ramEn.c_str());
                 ImGui::Text("Used RAM (Resource Manager): %s", ramRM.c_str());
+                ImGui::Text("Used RAM (Decoded Sounds): %s", ramDecoded.c_str());
+                ImGui::Text("Used RAM (Streaming Buffers): %s", ramStreaming.c_str());
+                ImGui::Separator();
+
+                ImGui::Text("Streaming Sounds: %s", streaming.c_str());
+                ImGui::Text("Start Latency: %.3fms (max %.3fms)", audioStats.StartLatency, audioStats.MaxStartLatency);
                 ImGui::End();
             }
             {
@@ -190,6 +210,18 @@ namespace NR
                     ImGui::Text("Descriptor Allocs: %d", VKRenderer::GetDescriptorAllocationCount(Renderer::GetCurrentFrameIndex()));
                 }
 
+                ImGui::Separator();
+                {
+                    const auto queueStats = Renderer::GetRenderCommandQueueStatistics();
+                    std::string used = Utils::BytesToString(queueStats.BytesUsed);
+                    std::string peak = Utils::BytesToString(queueStats.PeakBytesUsed);
+                    std::string allocated = Utils::BytesToString(queueStats.BytesAllocated);
+                    ImGui::Text("Render Commands: %u (peak %u)", queueStats.CommandCount, queueStats.PeakCommandCount);
+                    ImGui::Text("Command Queue: %s (peak %s)", used.c_str(), peak.c_str());
+                    ImGui::Text("Command Queue Allocated: %s in %u chunks", allocated.c_str(), queueStats.ChunkCount);
+                }
+                ImGui::Separator();
+
                 bool vsync = mWindow->IsVSync();
                 if (ImGui::Checkbox("Vsync", &vsync))
                 {
@@ -200,7 +232,7 @@ namespace NR
 
             ImGui::Begin("Performance");
             ImGui::Text("Frame Time: %.2fms\n", mTimeFrame.GetMilliseconds());
-            const auto& perFrameData = mProfiler->GetPerFrameData();
+            const auto perFrameData = mProfiler->GetPerFrameData();
             for (auto&& [name, time] : perFrameData)
             {
                 ImGui::Text("%s: %.3fms\n", name, time);
@@ -234,15 +266,34 @@ namespace NR
     {
         Init();
 
+        // Everything submitted while the application and its layers were set up (e.g. the ImGui backend) is done
+        // before the first frame is recorded
+        mRenderThread.Pump();
+
+        const bool multiThreaded = mRenderThread.GetPolicy() == ThreadingPolicy::MultiThreaded;
         while (mRunning)
         {
             NR_PROFILE_FRAME("MainThread");
 
             static uint64_t frameCounter = 0;
+
+            mRenderThread.BlockUntilRendering();
+
             mWindow->ProcessEvents();
+            JobSystem::RunMainThreadJobs();
+
+            if (multiThreaded)
+            {
+                // Hand the frame recorded last iteration to the render thread and record the next one meanwhile
+                mRenderThread.NextFrame();
+                mRenderThread.Kick();
+            }
 
             if (!mMinimized)
             {
+                Window* window = mWindow.get();
+                Renderer::Submit([window]() { window->GetSwapChain().BeginFrame(); });
+
                 Renderer::BeginFrame();
                 {
                     NR_SCOPE_PERF("Application Layer::Update");
@@ -256,14 +307,28 @@ namespace NR
 
                 if (mSpecification.EnableImGui)
                 {
-                    Renderer::Submit([app]() { app->RenderImGui(); });
-                    Renderer::Submit([=]() {mImGuiLayer->End(); });
+                    if (multiThreaded)
+                    {
+                        // The panels are built here, the render thread only draws a snapshot of their draw data
+                        RenderImGui();
+                        mImGuiLayer->End();
+                    }
+                    else
+                    {
+                        Renderer::Submit([app]() { app->RenderImGui(); });
+                        Renderer::Submit([=]() {mImGuiLayer->End(); });
+                    }
                 }
                 Renderer::EndFrame();
 
-                mWindow->GetSwapChain().BeginFrame();
-                Renderer::WaitAndRender();
-                mWindow->SwapBuffers();
+                Renderer::Submit([window]() { window->SwapBuffers(); });
+            }
+
+            if (!multiThreaded)
+            {
+                // Execute the frame that was just recorded, commands it submits run in the same kick
+                mRenderThread.NextFrame();
+                mRenderThread.Kick();
             }
 
             float time = GetTime();
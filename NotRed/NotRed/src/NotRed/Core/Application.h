@@ -10,6 +10,8 @@
 
 #include "NotRed/ImGui/ImGuiLayer.h"
 
+#include "NotRed/Renderer/RenderThread.h"
+
 namespace NR
 {
     struct ApplicationSpecification
@@ -24,6 +26,10 @@ namespace NR
         bool StartMaximized = true;
         bool Resizable = true;
         bool EnableImGui = true;
+
+        // MultiThreaded lets frame N+1 update while the render thread executes frame N. ImGui is then built on the
+        // main thread and drawn from a snapshot, without multi-viewport windows.
+        ThreadingPolicy CoreThreadingPolicy = ThreadingPolicy::SingleThreaded;
     };
 
     class Application
@@ -57,6 +63,7 @@ namespace NR
         inline Window& GetWindow() { return *mWindow; }
 
         static inline Application& Get() { return *sInstance; }
+        static inline bool HasInstance() { return sInstance != nullptr; }
 
         float GetTime() const;
         float GetTimeFrame() const;
@@ -70,6 +77,8 @@ namespace NR
         
         ImGuiLayer* GetImGuiLayer() { return mImGuiLayer; }
 
+        RenderThread& GetRenderThread() { return mRenderThread; }
+
     private:
         bool OnWindowResize(WindowResizeEvent& e);
         bool OnWindowClose(WindowCloseEvent& e);
@@ -80,6 +89,7 @@ namespace NR
         std::unique_ptr<Window> mWindow;
 
         ApplicationSpecification mSpecification;
+        RenderThread mRenderThread;
 
         bool mRunning = true, mMinimized = false;
 
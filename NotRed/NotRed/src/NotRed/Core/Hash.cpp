@@ -21,4 +21,22 @@ namespace NR
 	{
 		return GenerateFNVHash(string.c_str());
 	}
+
+	uint64_t Hash::GenerateFNVHash64(const void* data, size_t size, uint64_t seed)
+	{
+		constexpr uint64_t FNV_PRIME = 1099511628211ull;
+		const uint8_t* bytes = (const uint8_t*)data;
+		uint64_t hash = seed;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= FNV_PRIME;
+		}
+		return hash;
+	}
+
+	uint64_t Hash::GenerateFNVHash64(const std::string& string)
+	{
+		return GenerateFNVHash64(string.data(), string.size());
+	}
 }
\ No newline at end of file
@@ -10,6 +10,10 @@ namespace NR
 		static uint32_t GenerateFNVHash(const char* str);
 		static uint32_t GenerateFNVHash(const std::string& string);
 
+		// 64 bit FNV-1a over raw bytes, for content hashes where 32 bits collide too easily
+		static uint64_t GenerateFNVHash64(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+		static uint64_t GenerateFNVHash64(const std::string& string);
+
 		static uint32_t CRC32(const char* str);
 		static uint32_t CRC32(const std::string& string);
 	};
@@ -0,0 +1,350 @@
+#include "nrpch.h"
+#include "JobSystem.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+#include "NotRed/Debug/Profiler.h"
+
+namespace NR
+{
+	struct JobSystemData
+	{
+		// The owner works from the back, thieves take the oldest jobs from the front
+		struct WorkStealingQueue
+		{
+			std::mutex Mutex;
+			std::deque<JobSystem::Job> Jobs;
+
+			void Push(JobSystem::Job&& job)
+			{
+				std::lock_guard<std::mutex> lock(Mutex);
+				Jobs.push_back(std::move(job));
+			}
+
+			bool Pop(JobSystem::Job& job)
+			{
+				std::lock_guard<std::mutex> lock(Mutex);
+				if (Jobs.empty())
+					return false;
+
+				job = std::move(Jobs.back());
+				Jobs.pop_back();
+				return true;
+			}
+
+			bool Steal(JobSystem::Job& job)
+			{
+				std::lock_guard<std::mutex> lock(Mutex);
+				if (Jobs.empty())
+					return false;
+
+				job = std::move(Jobs.front());
+				Jobs.pop_front();
+				return true;
+			}
+
+			// Takes the oldest job that was scheduled with counter, wherever it is in the deque
+			bool Take(const JobCounter* counter, JobSystem::Job& job)
+			{
+				std::lock_guard<std::mutex> lock(Mutex);
+				for (auto it = Jobs.begin(); it != Jobs.end(); ++it)
+				{
+					if (it->Counter.Raw() != counter)
+						continue;
+
+					job = std::move(*it);
+					Jobs.erase(it);
+					return true;
+				}
+				return false;
+			}
+		};
+
+		// Queue 0 is shared by the main thread and every other thread that isn't a worker
+		std::vector<std::unique_ptr<WorkStealingQueue>> Queues;
+		std::vector<std::thread> Workers;
+
+		std::mutex MainThreadMutex;
+		std::vector<JobSystem::Job> MainThreadJobs;
+		std::thread::id MainThreadID;
+
+		std::atomic<uint32_t> QueuedJobs = 0;
+		std::atomic<bool> Running = false;
+		std::mutex SleepMutex;
+		std::condition_variable SleepCondition;
+	};
+
+	static JobSystemData* sData = nullptr;
+	static thread_local uint32_t sQueueIndex = 0;
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		NR_CORE_ASSERT(!sData, "JobSystem already initialized");
+
+		if (workerCount == 0)
+		{
+			const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		sData = new JobSystemData();
+		sData->MainThreadID = std::this_thread::get_id();
+		sData->Running = true;
+
+		for (uint32_t i = 0; i < workerCount + 1; ++i)
+			sData->Queues.emplace_back(std::make_unique<JobSystemData::WorkStealingQueue>());
+
+		sData->Workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i)
+			sData->Workers.emplace_back(WorkerThreadFunc, i + 1);
+
+		NR_CORE_INFO("JobSystem: {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		// Finish whatever is still queued so no counter is left waiting
+		while (TryRunJob())
+			;
+		RunMainThreadJobs();
+
+		{
+			std::lock_guard<std::mutex> lock(sData->SleepMutex);
+			sData->Running = false;
+		}
+		sData->SleepCondition.notify_all();
+
+		for (auto& worker : sData->Workers)
+			worker.join();
+
+		delete sData;
+		sData = nullptr;
+	}
+
+	void JobSystem::Schedule(JobFunction function, const char* name, const Ref<JobCounter>& counter, const Ref<JobCounter>& dependency, JobAffinity affinity)
+	{
+		if (counter)
+			counter->mValue.fetch_add(1, std::memory_order_acq_rel);
+
+		if (dependency)
+		{
+			// Whoever finishes the dependency's last job takes the pending jobs under the same lock
+			std::lock_guard<std::mutex> lock(dependency->mPendingMutex);
+			if (!dependency->IsDone())
+			{
+				dependency->mPendingJobs.push_back({ std::move(function), name, counter, affinity });
+				return;
+			}
+		}
+
+		Enqueue({ std::move(function), name, counter }, affinity);
+	}
+
+	void JobSystem::Wait(const Ref<JobCounter>& counter)
+	{
+		NR_PROFILE_FUNC();
+
+		if (!counter)
+			return;
+
+		// Other threads share queue 0 with the main thread, running jobs from it would execute
+		// main thread work (e.g. Renderer::Submit calls) on them
+		const bool mainThread = IsMainThread();
+		if (!mainThread && !IsWorkerThread())
+		{
+			Block(counter);
+			return;
+		}
+
+		// The main thread is usually inside a frame here, with workers reading the scene. Running main thread jobs or
+		// unrelated work would run imports, load callbacks and their submits in the middle of it.
+		const JobCounter* ownJobs = mainThread ? counter.Raw() : nullptr;
+		while (!counter->IsDone())
+		{
+			if (TryRunJob(ownJobs))
+				continue;
+
+			if (mainThread && TryRunMainThreadJob(ownJobs))
+				continue;
+
+			std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::Block(const Ref<JobCounter>& counter)
+	{
+		NR_PROFILE_FUNC();
+
+		if (!counter)
+			return;
+
+		while (!counter->IsDone())
+			std::this_thread::yield();
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function, uint32_t batchSize, const char* name)
+	{
+		NR_PROFILE_FUNC();
+
+		if (count == 0)
+			return;
+
+		if (batchSize == 0)
+			batchSize = 1;
+
+		// Batches are claimed as they go, so uneven work balances out without splitting up front
+		const uint32_t batchCount = (count + batchSize - 1) / batchSize;
+		std::atomic<uint32_t> nextBatch = 0;
+		auto runBatches = [&]()
+		{
+			uint32_t batch;
+			while ((batch = nextBatch.fetch_add(1)) < batchCount)
+			{
+				const uint32_t begin = batch * batchSize;
+				const uint32_t end = begin + batchSize < count ? begin + batchSize : count;
+				for (uint32_t i = begin; i < end; ++i)
+					function(i);
+			}
+		};
+
+		const uint32_t workerCount = GetWorkerCount();
+		const uint32_t helperCount = workerCount < batchCount - 1 ? workerCount : batchCount - 1;
+
+		// Helpers capture the caller's stack, Wait below keeps it alive until every one of them ran
+		Ref<JobCounter> counter = Ref<JobCounter>::Create();
+		for (uint32_t i = 0; i < helperCount; ++i)
+			Schedule(runBatches, name, counter);
+
+		runBatches();
+		Wait(counter);
+	}
+
+	void JobSystem::RunMainThreadJobs()
+	{
+		NR_PROFILE_FUNC();
+		NR_CORE_ASSERT(IsMainThread(), "Main thread jobs can only run on the main thread");
+
+		std::vector<Job> jobs;
+		{
+			std::lock_guard<std::mutex> lock(sData->MainThreadMutex);
+			jobs.swap(sData->MainThreadJobs);
+		}
+
+		for (Job& job : jobs)
+			Execute(job);
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return (uint32_t)sData->Workers.size();
+	}
+
+	bool JobSystem::IsMainThread()
+	{
+		return std::this_thread::get_id() == sData->MainThreadID;
+	}
+
+	bool JobSystem::IsWorkerThread()
+	{
+		return sQueueIndex != 0;
+	}
+
+	void JobSystem::Enqueue(Job&& job, JobAffinity affinity)
+	{
+		if (affinity == JobAffinity::MainThread)
+		{
+			std::lock_guard<std::mutex> lock(sData->MainThreadMutex);
+			sData->MainThreadJobs.push_back(std::move(job));
+			return;
+		}
+
+		sData->QueuedJobs.fetch_add(1, std::memory_order_acq_rel);
+		sData->Queues[sQueueIndex]->Push(std::move(job));
+
+		// Taking the lock orders this with a worker that is about to go to sleep
+		{
+			std::lock_guard<std::mutex> lock(sData->SleepMutex);
+		}
+		sData->SleepCondition.notify_one();
+	}
+
+	bool JobSystem::TryRunJob(const JobCounter* counter)
+	{
+		const uint32_t queueCount = (uint32_t)sData->Queues.size();
+
+		Job job;
+		bool found = counter ? sData->Queues[sQueueIndex]->Take(counter, job) : sData->Queues[sQueueIndex]->Pop(job);
+		for (uint32_t i = 1; !found && i < queueCount; ++i)
+		{
+			auto& queue = sData->Queues[(sQueueIndex + i) % queueCount];
+			found = counter ? queue->Take(counter, job) : queue->Steal(job);
+		}
+
+		if (!found)
+			return false;
+
+		sData->QueuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+		Execute(job);
+		return true;
+	}
+
+	bool JobSystem::TryRunMainThreadJob(const JobCounter* counter)
+	{
+		Job job;
+		{
+			std::lock_guard<std::mutex> lock(sData->MainThreadMutex);
+			auto it = std::find_if(sData->MainThreadJobs.begin(), sData->MainThreadJobs.end(), [counter](const Job& queued) { return queued.Counter.Raw() == counter; });
+			if (it == sData->MainThreadJobs.end())
+				return false;
+
+			job = std::move(*it);
+			sData->MainThreadJobs.erase(it);
+		}
+
+		Execute(job);
+		return true;
+	}
+
+	void JobSystem::Execute(Job& job)
+	{
+		{
+			NR_PROFILE_SCOPE_DYNAMIC(job.Name);
+			job.Function();
+		}
+
+		if (!job.Counter)
+			return;
+
+		JobCounter& counter = *job.Counter;
+		if (counter.mValue.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		std::vector<JobCounter::PendingJob> pendingJobs;
+		{
+			std::lock_guard<std::mutex> lock(counter.mPendingMutex);
+			pendingJobs.swap(counter.mPendingJobs);
+		}
+
+		for (auto& pending : pendingJobs)
+			Enqueue({ std::move(pending.Function), pending.Name, std::move(pending.Counter) }, pending.Affinity);
+	}
+
+	void JobSystem::WorkerThreadFunc(uint32_t queueIndex)
+	{
+		sQueueIndex = queueIndex;
+
+		const std::string name = "Job Worker " + std::to_string(queueIndex);
+		NR_PROFILE_THREAD(name.c_str());
+
+		while (sData->Running)
+		{
+			if (TryRunJob())
+				continue;
+
+			std::unique_lock<std::mutex> lock(sData->SleepMutex);
+			sData->SleepCondition.wait(lock, []() { return sData->QueuedJobs.load() > 0 || !sData->Running; });
+		}
+	}
+}
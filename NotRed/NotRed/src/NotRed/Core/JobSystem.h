@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "NotRed/Core/Ref.h"
+
+namespace NR
+{
+	using JobFunction = std::function<void()>;
+
+	enum class JobAffinity
+	{
+		Any = 0,
+
+		// Only runs inside JobSystem::RunMainThreadJobs, or a JobSystem::Wait on the main thread for the job's own counter
+		MainThread
+	};
+
+	//
+	// Number of unfinished jobs that were scheduled with this counter.
+	// Jobs scheduled with a dependency on it start once it drops to zero.
+	//
+	class JobCounter : public RefCounted
+	{
+	public:
+		bool IsDone() const { return mValue.load(std::memory_order_acquire) == 0; }
+		uint32_t GetValue() const { return mValue.load(std::memory_order_acquire); }
+
+	private:
+		struct PendingJob
+		{
+			JobFunction Function;
+			const char* Name;
+			Ref<JobCounter> Counter;
+			JobAffinity Affinity;
+		};
+
+		// Mutable so jobs can be scheduled through a const Ref, same as the ref count on RefCounted
+		mutable std::atomic<uint32_t> mValue = 0;
+
+		mutable std::mutex mPendingMutex;
+		mutable std::vector<PendingJob> mPendingJobs;
+
+		friend class JobSystem;
+	};
+
+	//
+	// Engine wide worker pool. Every worker owns a deque it pushes to and pops from the back of,
+	// idle workers steal from the front of the other deques. Threads that aren't workers push to the
+	// main thread's deque, which the workers steal from as well.
+	//
+	class JobSystem
+	{
+	public:
+		// A worker count of 0 uses one worker per hardware thread besides the main thread
+		static void Init(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		// The counter is incremented until the job has finished, the job doesn't start before dependency is done
+		static void Schedule(JobFunction function, const char* name = "Job", const Ref<JobCounter>& counter = nullptr, const Ref<JobCounter>& dependency = nullptr, JobAffinity affinity = JobAffinity::Any);
+
+		// Runs other jobs on the calling thread until the counter is done.
+		// The main thread only runs the jobs of that counter, so a ParallelFor on it can't end up running an
+		// asset import or a load callback in the middle of the loop. Threads that are neither a worker nor
+		// the main thread only block, see Block.
+		static void Wait(const Ref<JobCounter>& counter);
+
+		// Blocks until the counter is done without running any jobs on the calling thread.
+		// For code that must not run arbitrary jobs while it waits, like render commands.
+		static void Block(const Ref<JobCounter>& counter);
+
+		// Calls function(index) for every index in [0, count) in batches of batchSize and returns once all calls have finished.
+		// The calling thread works on the loop as well, so this is safe to call from inside a job.
+		static void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function, uint32_t batchSize = 1, const char* name = "ParallelFor");
+
+		// Executes the jobs with JobAffinity::MainThread, called once per frame by the application
+		static void RunMainThreadJobs();
+
+		static uint32_t GetWorkerCount();
+		static bool IsMainThread();
+		static bool IsWorkerThread();
+
+	private:
+		struct Job
+		{
+			JobFunction Function;
+			const char* Name = nullptr;
+			Ref<JobCounter> Counter;
+		};
+
+		static void Enqueue(Job&& job, JobAffinity affinity);
+		// Runs any queued job, or only one that belongs to counter when it isn't null
+		static bool TryRunJob(const JobCounter* counter = nullptr);
+		static bool TryRunMainThreadJob(const JobCounter* counter);
+		static void Execute(Job& job);
+		static void WorkerThreadFunc(uint32_t queueIndex);
+
+		friend struct JobSystemData;
+	};
+}
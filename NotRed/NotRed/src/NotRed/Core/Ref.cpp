@@ -26,8 +26,58 @@ namespace NR
 
 		bool IsLive(void* instance)
 		{
+			std::scoped_lock<std::mutex> lock(sLiveReferenceMutex);
 			NR_CORE_ASSERT(instance);
 			return sLiveReferences.find(instance) != sLiveReferences.end();
 		}
+
+		void ReleaseWeakControlBlock(WeakControlBlock* block)
+		{
+			if (block->References.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				delete block;
+		}
+	}
+
+	RefCounted::~RefCounted()
+	{
+		RefUtils::WeakControlBlock* block = mWeakControlBlock.load(std::memory_order_acquire);
+		if (!block)
+			return;
+
+		{
+			// Waits for a WeakRef::Lock that is looking at the ref count right now
+			std::lock_guard<std::mutex> lock(block->Mutex);
+			block->Alive.store(false, std::memory_order_release);
+		}
+
+		RefUtils::ReleaseWeakControlBlock(block);
+	}
+
+	bool RefCounted::TryIncRefCount() const
+	{
+		uint32_t count = mRefCount.load(std::memory_order_relaxed);
+		while (count != 0)
+		{
+			if (mRefCount.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+				return true;
+		}
+		return false;
+	}
+
+	RefUtils::WeakControlBlock* RefCounted::AcquireWeakControlBlock() const
+	{
+		RefUtils::WeakControlBlock* block = mWeakControlBlock.load(std::memory_order_acquire);
+		if (!block)
+		{
+			// Two threads can race to create the first block, the loser throws its own away
+			RefUtils::WeakControlBlock* created = new RefUtils::WeakControlBlock();
+			if (mWeakControlBlock.compare_exchange_strong(block, created, std::memory_order_acq_rel, std::memory_order_acquire))
+				block = created;
+			else
+				delete created;
+		}
+
+		block->References.fetch_add(1, std::memory_order_relaxed);
+		return block;
 	}
-}
\ No newline at end of file
+}
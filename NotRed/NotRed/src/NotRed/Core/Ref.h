@@ -2,34 +2,66 @@
 
 #include <stdint.h>
 #include <atomic>
+#include <mutex>
+
+// Keeps a global set of every instance that is referenced by a Ref, for tracking down lifetime issues.
+// Every Ref copy takes a global lock while this is defined, so it's off by default.
+// #define NR_TRACK_LIVE_REFERENCES
 
 namespace NR
 {
+	namespace RefUtils 
+	{
+		void AddToLiveReferences(void* instance);
+		void RemoveFromLiveReferences(void* instance);
+		bool IsLive(void* instance);
+
+		// Shared by an object and its WeakRefs, it outlives the object until the last WeakRef is gone
+		struct WeakControlBlock
+		{
+			// One for the object itself plus one per WeakRef
+			std::atomic<uint32_t> References = 1;
+			std::atomic<bool> Alive = true;
+
+			// Orders WeakRef::Lock with the object being destroyed
+			std::mutex Mutex;
+		};
+
+		void ReleaseWeakControlBlock(WeakControlBlock* block);
+	}
+
 	class RefCounted
 	{
 	public:
+		RefCounted() = default;
+		~RefCounted();
+
 		void IncRefCount() const
 		{
-			++mRefCount;
+			mRefCount.fetch_add(1, std::memory_order_relaxed);
 		}
-		void DecRefCount() const
+
+		// Returns true when this released the last reference
+		bool DecRefCount() const
 		{
-			--mRefCount;
+			return mRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
 		}
 
-		uint32_t GetRefCount() const { return mRefCount.load(); }
+		uint32_t GetRefCount() const { return mRefCount.load(std::memory_order_relaxed); }
+
+	private:
+		// Only succeeds while another reference still keeps the object alive
+		bool TryIncRefCount() const;
+		RefUtils::WeakControlBlock* AcquireWeakControlBlock() const;
+
+		template<class T>
+		friend class WeakRef;
 
 	private:
 		mutable std::atomic<uint32_t> mRefCount = 0;
+		mutable std::atomic<RefUtils::WeakControlBlock*> mWeakControlBlock = nullptr;
 	};
 
-	namespace RefUtils 
-	{
-		void AddToLiveReferences(void* instance);
-		void RemoveFromLiveReferences(void* instance);
-		bool IsLive(void* instance);
-	}
-
 	template<typename T>
 	class Ref
 	{
@@ -171,12 +203,22 @@ namespace NR
 		}
 
 	private:
+		struct AdoptReference {};
+
+		// Takes over a reference that was already counted
+		Ref(T* instance, AdoptReference)
+			: mInstance(instance)
+		{
+		}
+
 		void IncRef() const
 		{
 			if (mInstance)
 			{
 				mInstance->IncRefCount();
+#ifdef NR_TRACK_LIVE_REFERENCES
 				RefUtils::AddToLiveReferences((void*)mInstance);
+#endif
 			}
 		}
 
@@ -184,11 +226,12 @@ namespace NR
 		{
 			if (mInstance)
 			{
-				mInstance->DecRefCount();
-				if (mInstance->GetRefCount() == 0)
+				if (mInstance->DecRefCount())
 				{
-					delete mInstance;
+#ifdef NR_TRACK_LIVE_REFERENCES
 					RefUtils::RemoveFromLiveReferences((void*)mInstance);
+#endif
+					delete mInstance;
 					mInstance = nullptr;
 				}
 			}
@@ -196,6 +239,8 @@ namespace NR
 
 		template<class T2>
 		friend class Ref;
+		template<class T2>
+		friend class WeakRef;
 		mutable T* mInstance;
 	};
 
@@ -205,19 +250,75 @@ namespace NR
 	public:
 		WeakRef() = default;
 
-		WeakRef(Ref<T> ref)
+		WeakRef(const Ref<T>& ref)
+			: WeakRef(ref.mInstance)
 		{
-			mInstance = ref.Raw();
 		}
 
 		WeakRef(T* instance)
+			: mInstance(instance), mControlBlock(instance ? instance->AcquireWeakControlBlock() : nullptr)
 		{
-			mInstance = instance;
 		}
-		bool IsValid() const { return mInstance ? RefUtils::IsLive(mInstance) : false; }
+
+		WeakRef(const WeakRef<T>& other)
+			: mInstance(other.mInstance), mControlBlock(other.mControlBlock)
+		{
+			if (mControlBlock)
+				mControlBlock->References.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		WeakRef(WeakRef<T>&& other) noexcept
+			: mInstance(other.mInstance), mControlBlock(other.mControlBlock)
+		{
+			other.mInstance = nullptr;
+			other.mControlBlock = nullptr;
+		}
+
+		~WeakRef()
+		{
+			if (mControlBlock)
+				RefUtils::ReleaseWeakControlBlock(mControlBlock);
+		}
+
+		WeakRef& operator=(const WeakRef<T>& other)
+		{
+			WeakRef<T> copy(other);
+			Swap(copy);
+			return *this;
+		}
+
+		WeakRef& operator=(WeakRef<T>&& other) noexcept
+		{
+			WeakRef<T> moved(std::move(other));
+			Swap(moved);
+			return *this;
+		}
+
+		bool IsValid() const { return mControlBlock ? mControlBlock->Alive.load(std::memory_order_acquire) : false; }
 		operator bool() const { return IsValid(); }
 
+		// Returns a strong reference, or null once the object is being destroyed
+		Ref<T> Lock() const
+		{
+			if (!mControlBlock)
+				return nullptr;
+
+			std::lock_guard<std::mutex> lock(mControlBlock->Mutex);
+			if (!mControlBlock->Alive.load(std::memory_order_relaxed) || !mInstance->TryIncRefCount())
+				return nullptr;
+
+			return Ref<T>(mInstance, typename Ref<T>::AdoptReference());
+		}
+
+	private:
+		void Swap(WeakRef<T>& other)
+		{
+			std::swap(mInstance, other.mInstance);
+			std::swap(mControlBlock, other.mControlBlock);
+		}
+
 	private:
 		T* mInstance = nullptr;
+		RefUtils::WeakControlBlock* mControlBlock = nullptr;
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <mutex>
 
 #include "Log.h"
 
@@ -53,8 +54,11 @@ namespace NR
 	class PerformanceProfiler
 	{
 	public:
+		// Timings can come from both the main and the render thread
 		void SetPerFrameTiming(const char* name, float time)
 		{
+			std::scoped_lock<std::mutex> lock(mPerFrameDataMutex);
+
 			if (mPerFrameData.find(name) == mPerFrameData.end())
 			{
 				mPerFrameData[name] = 0.0f;
@@ -62,12 +66,21 @@ namespace NR
 			mPerFrameData[name] += time;
 		}
 
-		void Clear() { mPerFrameData.clear(); }
+		void Clear()
+		{
+			std::scoped_lock<std::mutex> lock(mPerFrameDataMutex);
+			mPerFrameData.clear();
+		}
 
-		const std::unordered_map<const char*, float>& GetPerFrameData() const { return mPerFrameData; }
+		std::unordered_map<const char*, float> GetPerFrameData() const
+		{
+			std::scoped_lock<std::mutex> lock(mPerFrameDataMutex);
+			return mPerFrameData;
+		}
 
 	private:
 		std::unordered_map<const char*, float> mPerFrameData;
+		mutable std::mutex mPerFrameDataMutex;
 	};
 
 	class ScopePerformanceTimer
@@ -78,8 +91,11 @@ namespace NR
 
 		~ScopePerformanceTimer()
 		{
-			float time = mTimer.ElapsedMillis();
-			mProfiler->SetPerFrameTiming(mName, time);
+			if (mProfiler)
+			{
+				float time = mTimer.ElapsedMillis();
+				mProfiler->SetPerFrameTiming(mName, time);
+			}
 		}
 
 	private:
@@ -89,7 +105,7 @@ namespace NR
 	};
 
 #define NR_SCOPE_PERF(name)\
-	ScopePerformanceTimer timer__LINE__(name, Application::Get().GetPerformanceProfiler());
+	ScopePerformanceTimer timer__LINE__(name, Application::HasInstance() ? Application::Get().GetPerformanceProfiler() : nullptr);
 
 #define NR_SCOPE_TIMER(name)\
 	ScopedTimer timer__LINE__(name);
@@ -586,6 +586,13 @@ namespace NR
 
 			UI::Property("Looping", soundConfig.bLooping);
 
+			const auto& streamingModeStr = std::vector<std::string>{ "Auto", "Decode", "Stream" };
+			int32_t selectedStreamingMode = static_cast<int32_t>(soundConfig.Streaming);
+			if (UI::PropertyDropdown("Streaming", streamingModeStr, (int32_t)streamingModeStr.size(), &selectedStreamingMode))
+			{
+				soundConfig.Streaming = static_cast<StreamingMode>(selectedStreamingMode);
+			}
+
 			singleColumnSeparator();
 			propertyGridSpacing();
 			propertyGridSpacing();
@@ -1,7 +1,6 @@
 #include "nrpch.h"
 #include "MeshViewerPanel.h"
 
-#include <assimp/scene.h>
 #include <filesystem>
 
 #include <imgui/imgui.h>
@@ -20,11 +19,6 @@
 
 namespace NR
 {
-	namespace Utils 
-	{
-		glm::mat4 Mat4FromAIMatrix4x4(const aiMatrix4x4& matrix);
-	}
-
 	MeshViewerPanel::MeshViewerPanel()
 		: AssetEditor("MeshViewerPanel")
 	{}
@@ -304,8 +298,7 @@ namespace NR
 	void MeshViewerPanel::DrawMeshNode(const Ref<MeshSource>& meshAsset, const Ref<Mesh>& mesh)
 	{
 		// Mesh Hierarchy
-		auto rootNode = meshAsset->mScene->mRootNode;
-		MeshNodeHierarchy(meshAsset, mesh, rootNode);
+		MeshNodeHierarchy(meshAsset, mesh, meshAsset->GetRootNode());
 		if (ImGui::Button("Create Mesh"))
 		{
 			std::filesystem::path meshPath = meshAsset->GetFilePath();			
@@ -316,16 +309,15 @@ namespace NR
 		}
 	}
 
-	void MeshViewerPanel::MeshNodeHierarchy(const Ref<MeshSource>& meshAsset, Ref<Mesh> mesh, aiNode* node, const glm::mat4& parentTransform, uint32_t level)
+	void MeshViewerPanel::MeshNodeHierarchy(const Ref<MeshSource>& meshAsset, Ref<Mesh> mesh, const MeshNode& node, const glm::mat4& parentTransform, uint32_t level)
 	{
-		glm::mat4 localTransform = Utils::Mat4FromAIMatrix4x4(node->mTransformation);
+		glm::mat4 localTransform = node.LocalTransform;
 		glm::mat4 transform = parentTransform * localTransform;
 
-		NR_CORE_ASSERT(meshAsset->mNodeMap.find(node) != meshAsset->mNodeMap.end());
-		auto& meshIndices = meshAsset->mNodeMap.at(node);
+		auto& meshIndices = node.Submeshes;
 		if (!meshIndices.empty())
 		{
-			ImGui::PushID(node->mName.C_Str());
+			ImGui::PushID(node.Name.c_str());
 
 			uint32_t meshIndex = meshIndices.front();
 			auto& submeshes = mesh->GetSubmeshes();
@@ -349,12 +341,12 @@ namespace NR
 
 		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_OpenOnDoubleClick;
 		
-		if (node->mNumChildren == 0)
+		if (node.Children.empty())
 		{
 			flags |= ImGuiTreeNodeFlags_Leaf;
 		}
 
-		if (ImGui::TreeNodeEx(node->mName.C_Str(), flags))
+		if (ImGui::TreeNodeEx(node.Name.c_str(), flags))
 		{
 #if TRANSFORM_INFO
 		{
@@ -374,9 +366,9 @@ namespace NR
 			}
 #endif
 
-			for (uint32_t i = 0; i < node->mNumChildren; ++i)
+			for (uint32_t child : node.Children)
 			{
-				MeshNodeHierarchy(meshAsset, mesh, node->mChildren[i], transform, level + 1);
+				MeshNodeHierarchy(meshAsset, mesh, meshAsset->GetNodes()[child], transform, level + 1);
 			}
 
 			ImGui::TreePop();
@@ -54,7 +54,7 @@ namespace NR
 	private:
 		void RenderMeshTab(ImGuiID dockspaceID, const std::shared_ptr<MeshScene>& sceneData);
 		void DrawMeshNode(const Ref<MeshSource>& meshAsset, const Ref<Mesh>& mesh);
-		void MeshNodeHierarchy(const Ref<MeshSource>& meshAsset, Ref<Mesh> mesh, aiNode* node, const glm::mat4& parentTransform = glm::mat4(1.0f), uint32_t level = 0);
+		void MeshNodeHierarchy(const Ref<MeshSource>& meshAsset, Ref<Mesh> mesh, const MeshNode& node, const glm::mat4& parentTransform = glm::mat4(1.0f), uint32_t level = 0);
 
 	private:
 		bool mResetDockspace = true;
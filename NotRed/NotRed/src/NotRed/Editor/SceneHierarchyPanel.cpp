@@ -1205,7 +1205,7 @@ namespace NR
 			}
 		}
 
-		DrawComponent<TransformComponent>("Transform", entity, [](TransformComponent& component)
+		DrawComponent<TransformComponent>("Transform", entity, [&entity](TransformComponent& component)
 			{
 				UI::ScopedStyle spacing(ImGuiStyleVar_ItemSpacing, ImVec2(8.0f, 8.0f));
 				UI::ScopedStyle padding(ImGuiStyleVar_FramePadding, ImVec2(4.0f, 4.0f));
@@ -1214,19 +1214,26 @@ namespace NR
 				ImGui::TableSetupColumn("label_column", 0, 100.0f);
 				ImGui::TableSetupColumn("value_column", ImGuiTableColumnFlags_IndentEnable | ImGuiTableColumnFlags_NoClip, ImGui::GetContentRegionAvail().x - 100.0f);
 
+				bool modified = false;
+
 				ImGui::TableNextRow();
-				DrawVec3Control("Translation", component.Translation);
+				modified |= DrawVec3Control("Translation", component.Translation);
 
 				ImGui::TableNextRow();
 				glm::vec3 rotation = glm::degrees(component.Rotation);
-				DrawVec3Control("Rotation", rotation);
+				modified |= DrawVec3Control("Rotation", rotation);
 				component.Rotation = glm::radians(rotation);
 
 				ImGui::TableNextRow();
-				DrawVec3Control("Scale", component.Scale, 1.0f);
+				modified |= DrawVec3Control("Scale", component.Scale, 1.0f);
 
 				ImGui::EndTable();
 
+				if (modified)
+				{
+					entity.MarkTransformDirty();
+				}
+
 				UI::ShiftCursorY(-8.0f);
 				UI::Draw::Underline();
 
@@ -1477,19 +1484,29 @@ namespace NR
 				if (AssetManager::IsAssetHandleValid(anim.AnimationController))
 				{
 					auto animationController = AssetManager::GetAsset<AnimationController>(anim.AnimationController);
+					AnimationInstance* animationInstance = anim.Instance.Acquire(animationController, anim.AnimationTime);
 
 					////////////////////////////
 					// TEMPORARY:  Move to animation preview panel (if we ever have such a thing)
 					//
-					int stateIndex = animationController->GetStateIndex();
-					if (UI::Property("State", stateIndex)) {
-						animationController->SetStateIndex(std::clamp(stateIndex, 0, static_cast<int>(animationController->GetNumStates()) - 1));
+					if (animationInstance)
+					{
+						int stateIndex = animationInstance->GetStateIndex();
+						if (UI::Property("State", stateIndex)) {
+							animationInstance->SetStateIndex(std::clamp(stateIndex, 0, static_cast<int>(animationController->GetNumStates()) - 1));
+						}
 					}
 
 					UI::Property("Play Animation", anim.EnableAnimation);
+					if (animationInstance)
 					{
 						UI::ScopedItemFlags flags(ImGuiItemFlags_Disabled, anim.EnableAnimation);
-						UI::PropertySlider("Animation Time", anim.AnimationTime, 0.0f, 1.0f);
+						float animationTime = animationInstance->GetAnimationTime();
+						if (UI::PropertySlider("Animation Time", animationTime, 0.0f, 1.0f))
+						{
+							animationInstance->SetAnimationTime(animationTime);
+							anim.AnimationTime = animationTime;
+						}
 					}
 
 					/////////////////////////////
@@ -1503,6 +1520,8 @@ namespace NR
 							anim.RootMotionTarget = rootMotionTarget.GetID();
 						}
 					}
+
+					UI::Property("Sync Bone Entities", anim.SyncBoneEntities);
 				}
 				UI::EndPropertyGrid();
 			}, sGearIcon);
@@ -1805,7 +1805,6 @@ namespace NR::UI
             preview = "Null";
         }
 
-        auto& assets = AssetManager::GetLoadedAssets();
         AssetHandle current = *selected;
 
         if (IsItemDisabled())
@@ -1818,11 +1817,11 @@ namespace NR::UI
         {
             ImGui::SetKeyboardFocusHere(0);
 
-            for (auto& [handle, asset] : assets)
+            AssetManager::ForEachLoadedAsset([&](AssetHandle handle, const Ref<Asset>& asset)
             {
                 if (asset->GetAssetType() != TAssetType::GetStaticType())
                 {
-                    continue;
+                    return;
                 }
 
                 auto& metadata = AssetManager::GetMetadata(handle);
@@ -1838,7 +1837,7 @@ namespace NR::UI
                 {
                     ImGui::SetItemDefaultFocus();
                 }
-            }
+            });
 
             UI::EndPopup();
         }
@@ -3,6 +3,7 @@
 
 #include "NotRed/Renderer/RendererAPI.h"
 #include "NotRed/Platform/Vulkan/VKTexture.h"
+#include "NotRed/Platform/Vulkan/VKImGuiLayer.h"
 
 #include "imgui/examples/imgui_impl_vulkan_with_textures.h"
 
@@ -19,7 +20,7 @@ namespace NR::UI
                 return nullptr;
             }
 
-            return ImGui_ImplVulkan_AddTexture(imageInfo.sampler, imageInfo.imageView, imageInfo.imageLayout);
+            return VKImGuiLayer::AddTexture([vulkanTexture]() { return vulkanTexture->GetVulkanDescriptorInfo(); });
         }
     }
 }
\ No newline at end of file
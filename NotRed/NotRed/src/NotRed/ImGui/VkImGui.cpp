@@ -5,6 +5,7 @@
 
 #include "NotRed/Platform/Vulkan/VkTexture.h"
 #include "NotRed/Platform/Vulkan/VkImage.h"
+#include "NotRed/Platform/Vulkan/VKImGuiLayer.h"
 
 #include "imgui/examples/imgui_impl_vulkan_with_textures.h"
 
@@ -26,7 +27,7 @@ namespace NR::UI
 				return;
 			}
 
-			const auto textureID = ImGui_ImplVulkan_AddTexture(imageInfo.Sampler, imageInfo.ImageView, vkImage->GetDescriptor().imageLayout);
+			const auto textureID = VKImGuiLayer::AddTexture([vkImage]() { return VkDescriptorImageInfo{ vkImage->GetImageInfo().Sampler, vkImage->GetImageInfo().ImageView, vkImage->GetDescriptor().imageLayout }; });
 			ImGui::Image(textureID, size, uv0, uv1, tint_col, border_col);
 		}
 	}
@@ -43,7 +44,7 @@ namespace NR::UI
 			{
 				return;
 			}
-			const auto textureID = ImGui_ImplVulkan_AddTexture(imageInfo.Sampler, imageInfo.ImageView, vulkanImage->GetDescriptor().imageLayout);
+			const auto textureID = VKImGuiLayer::AddTexture([vulkanImage, imageLayer]() { return VkDescriptorImageInfo{ vulkanImage->GetImageInfo().Sampler, vulkanImage->GetLayerImageView(imageLayer), vulkanImage->GetDescriptor().imageLayout }; });
 			ImGui::Image(textureID, size, uv0, uv1, tint_col, border_col);
 		}
 	}
@@ -59,7 +60,7 @@ namespace NR::UI
 				return;
 			}
 
-			const auto textureID = ImGui_ImplVulkan_AddTexture(imageInfo.sampler, imageInfo.imageView, imageInfo.imageLayout);
+			const auto textureID = VKImGuiLayer::AddTexture([VkTexture]() { return VkTexture->GetVulkanDescriptorInfo(); });
 			ImGui::Image(textureID, size, uv0, uv1, tint_col, border_col);
 		}
 	}
@@ -75,7 +76,7 @@ namespace NR::UI
 			return;
 		}
 
-		const auto textureID = ImGui_ImplVulkan_AddTexture(imageInfo.Sampler, imageInfo.ImageView, vulkanImage->GetDescriptor().imageLayout);
+		const auto textureID = VKImGuiLayer::AddTexture([vulkanImage, mip]() { return VkDescriptorImageInfo{ vulkanImage->GetImageInfo().Sampler, vulkanImage->GetMipImageView(mip), vulkanImage->GetDescriptor().imageLayout }; });
 		ImGui::Image(textureID, size, uv0, uv1, tint_col, border_col);
 	}
 
@@ -94,7 +95,7 @@ namespace NR::UI
 			{
 				return false;
 			}
-			const auto textureID = ImGui_ImplVulkan_AddTexture(imageInfo.Sampler, imageInfo.ImageView, VkImage->GetDescriptor().imageLayout);
+			const auto textureID = VKImGuiLayer::AddTexture([VkImage]() { return VkDescriptorImageInfo{ VkImage->GetImageInfo().Sampler, VkImage->GetImageInfo().ImageView, VkImage->GetDescriptor().imageLayout }; });
 			ImGuiID id = (ImGuiID)((((uint64_t)imageInfo.ImageView) >> 32) ^ (uint32_t)imageInfo.ImageView);
 			if (stringID)
 			{
@@ -129,7 +130,7 @@ namespace NR::UI
 			}
 
 			const VkDescriptorImageInfo& imageInfo = vkTexture->GetVulkanDescriptorInfo();
-			const auto textureID = ImGui_ImplVulkan_AddTexture(imageInfo.sampler, imageInfo.imageView, imageInfo.imageLayout);
+			const auto textureID = VKImGuiLayer::AddTexture([vkTexture]() { return vkTexture->GetVulkanDescriptorInfo(); });
 
 			ImGuiID id = (ImGuiID)((((uint64_t)imageInfo.imageView) >> 32) ^ (uint32_t)imageInfo.imageView);
 			if (stringID)
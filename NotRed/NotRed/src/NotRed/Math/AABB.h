@@ -13,5 +13,19 @@ namespace NR
 
 		AABB(const glm::vec3& min, const glm::vec3& max)
 			: Min(min), Max(max) {}
+
+		// Bounds of this box after transformation, larger than the tight bounds for rotated boxes
+		AABB Transformed(const glm::mat4& transform) const
+		{
+			const glm::vec3 center = (Min + Max) * 0.5f;
+			const glm::vec3 extents = (Max - Min) * 0.5f;
+
+			const glm::vec3 newCenter = transform * glm::vec4(center, 1.0f);
+			const glm::vec3 newExtents = glm::abs(glm::vec3(transform[0])) * extents.x
+				+ glm::abs(glm::vec3(transform[1])) * extents.y
+				+ glm::abs(glm::vec3(transform[2])) * extents.z;
+
+			return AABB(newCenter - newExtents, newCenter + newExtents);
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,338 @@
+#include "nrpch.h"
+#include "AABBTree.h"
+
+namespace NR
+{
+	namespace Utils {
+
+		static AABB Union(const AABB& a, const AABB& b)
+		{
+			return AABB(glm::min(a.Min, b.Min), glm::max(a.Max, b.Max));
+		}
+
+		static float Perimeter(const AABB& aabb)
+		{
+			const glm::vec3 size = aabb.Max - aabb.Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		static bool Contains(const AABB& outer, const AABB& inner)
+		{
+			return glm::all(glm::lessThanEqual(outer.Min, inner.Min)) && glm::all(glm::greaterThanEqual(outer.Max, inner.Max));
+		}
+
+	}
+
+	AABBTree::AABBTree(float margin)
+		: mMargin(margin)
+	{
+		mStack.reserve(64);
+	}
+
+	int32_t AABBTree::CreateProxy(const AABB& aabb, uint32_t userData)
+	{
+		const int32_t proxy = AllocateNode();
+
+		Node& node = mNodes[proxy];
+		node.Bounds = AABB(aabb.Min - glm::vec3(mMargin), aabb.Max + glm::vec3(mMargin));
+		node.UserData = userData;
+		node.Height = 0;
+
+		InsertLeaf(proxy);
+		++mProxyCount;
+
+		return proxy;
+	}
+
+	void AABBTree::DestroyProxy(int32_t proxy)
+	{
+		NR_CORE_ASSERT(proxy >= 0 && proxy < (int32_t)mNodes.size() && mNodes[proxy].IsLeaf());
+
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		--mProxyCount;
+	}
+
+	bool AABBTree::MoveProxy(int32_t proxy, const AABB& aabb)
+	{
+		NR_CORE_ASSERT(proxy >= 0 && proxy < (int32_t)mNodes.size() && mNodes[proxy].IsLeaf());
+
+		if (Utils::Contains(mNodes[proxy].Bounds, aabb))
+			return false;
+
+		RemoveLeaf(proxy);
+		mNodes[proxy].Bounds = AABB(aabb.Min - glm::vec3(mMargin), aabb.Max + glm::vec3(mMargin));
+		InsertLeaf(proxy);
+
+		return true;
+	}
+
+	void AABBTree::Clear()
+	{
+		mNodes.clear();
+		mRoot = NullNode;
+		mFreeList = NullNode;
+		mProxyCount = 0;
+	}
+
+	bool AABBTree::Overlaps(const AABB& a, const AABB& b)
+	{
+		return glm::all(glm::lessThanEqual(a.Min, b.Max)) && glm::all(glm::greaterThanEqual(a.Max, b.Min));
+	}
+
+	int32_t AABBTree::AllocateNode()
+	{
+		if (mFreeList == NullNode)
+		{
+			mNodes.emplace_back();
+			return (int32_t)mNodes.size() - 1;
+		}
+
+		const int32_t node = mFreeList;
+		mFreeList = mNodes[node].Parent;
+		mNodes[node] = Node();
+		return node;
+	}
+
+	void AABBTree::FreeNode(int32_t node)
+	{
+		mNodes[node].Parent = mFreeList;
+		mNodes[node].Child1 = NullNode;
+		mNodes[node].Child2 = NullNode;
+		mNodes[node].Height = -1;
+		mFreeList = node;
+	}
+
+	void AABBTree::InsertLeaf(int32_t leaf)
+	{
+		if (mRoot == NullNode)
+		{
+			mRoot = leaf;
+			mNodes[leaf].Parent = NullNode;
+			return;
+		}
+
+		// Find the cheapest sibling by the surface area heuristic
+		const AABB leafBounds = mNodes[leaf].Bounds;
+		int32_t index = mRoot;
+		while (!mNodes[index].IsLeaf())
+		{
+			const Node& node = mNodes[index];
+
+			const float area = Utils::Perimeter(node.Bounds);
+			const float combinedArea = Utils::Perimeter(Utils::Union(node.Bounds, leafBounds));
+
+			// Cost of creating a new parent for this node and the leaf
+			const float cost = 2.0f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree
+			const float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](int32_t child)
+			{
+				const Node& childNode = mNodes[child];
+				const float unionArea = Utils::Perimeter(Utils::Union(leafBounds, childNode.Bounds));
+				return (childNode.IsLeaf() ? unionArea : unionArea - Utils::Perimeter(childNode.Bounds)) + inheritanceCost;
+			};
+
+			const float cost1 = descendCost(node.Child1);
+			const float cost2 = descendCost(node.Child2);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? node.Child1 : node.Child2;
+		}
+
+		const int32_t sibling = index;
+		const int32_t oldParent = mNodes[sibling].Parent;
+		const int32_t newParent = AllocateNode();
+
+		mNodes[newParent].Parent = oldParent;
+		mNodes[newParent].Bounds = Utils::Union(leafBounds, mNodes[sibling].Bounds);
+		mNodes[newParent].Height = mNodes[sibling].Height + 1;
+		mNodes[newParent].Child1 = sibling;
+		mNodes[newParent].Child2 = leaf;
+		mNodes[sibling].Parent = newParent;
+		mNodes[leaf].Parent = newParent;
+
+		if (oldParent != NullNode)
+		{
+			if (mNodes[oldParent].Child1 == sibling)
+				mNodes[oldParent].Child1 = newParent;
+			else
+				mNodes[oldParent].Child2 = newParent;
+		}
+		else
+		{
+			mRoot = newParent;
+		}
+
+		// Refit and rebalance the ancestors
+		index = mNodes[leaf].Parent;
+		while (index != NullNode)
+		{
+			index = Balance(index);
+
+			Node& node = mNodes[index];
+			node.Height = 1 + glm::max(mNodes[node.Child1].Height, mNodes[node.Child2].Height);
+			node.Bounds = Utils::Union(mNodes[node.Child1].Bounds, mNodes[node.Child2].Bounds);
+
+			index = node.Parent;
+		}
+	}
+
+	void AABBTree::RemoveLeaf(int32_t leaf)
+	{
+		if (leaf == mRoot)
+		{
+			mRoot = NullNode;
+			return;
+		}
+
+		const int32_t parent = mNodes[leaf].Parent;
+		const int32_t grandParent = mNodes[parent].Parent;
+		const int32_t sibling = mNodes[parent].Child1 == leaf ? mNodes[parent].Child2 : mNodes[parent].Child1;
+
+		if (grandParent == NullNode)
+		{
+			mRoot = sibling;
+			mNodes[sibling].Parent = NullNode;
+			FreeNode(parent);
+			return;
+		}
+
+		// Replace the parent with the sibling
+		if (mNodes[grandParent].Child1 == parent)
+			mNodes[grandParent].Child1 = sibling;
+		else
+			mNodes[grandParent].Child2 = sibling;
+		mNodes[sibling].Parent = grandParent;
+		FreeNode(parent);
+
+		int32_t index = grandParent;
+		while (index != NullNode)
+		{
+			index = Balance(index);
+
+			Node& node = mNodes[index];
+			node.Height = 1 + glm::max(mNodes[node.Child1].Height, mNodes[node.Child2].Height);
+			node.Bounds = Utils::Union(mNodes[node.Child1].Bounds, mNodes[node.Child2].Bounds);
+
+			index = node.Parent;
+		}
+	}
+
+	// Rotates the taller child of A up if the subtree is imbalanced, returns the new subtree root
+	int32_t AABBTree::Balance(int32_t iA)
+	{
+		Node& A = mNodes[iA];
+		if (A.IsLeaf() || A.Height < 2)
+			return iA;
+
+		const int32_t iB = A.Child1;
+		const int32_t iC = A.Child2;
+		Node& B = mNodes[iB];
+		Node& C = mNodes[iC];
+
+		const int32_t balance = C.Height - B.Height;
+
+		// Rotate C up
+		if (balance > 1)
+		{
+			const int32_t iF = C.Child1;
+			const int32_t iG = C.Child2;
+			Node& F = mNodes[iF];
+			Node& G = mNodes[iG];
+
+			C.Child1 = iA;
+			C.Parent = A.Parent;
+			A.Parent = iC;
+
+			if (C.Parent != NullNode)
+			{
+				if (mNodes[C.Parent].Child1 == iA)
+					mNodes[C.Parent].Child1 = iC;
+				else
+					mNodes[C.Parent].Child2 = iC;
+			}
+			else
+			{
+				mRoot = iC;
+			}
+
+			if (F.Height > G.Height)
+			{
+				C.Child2 = iF;
+				A.Child2 = iG;
+				G.Parent = iA;
+				A.Bounds = Utils::Union(B.Bounds, G.Bounds);
+				C.Bounds = Utils::Union(A.Bounds, F.Bounds);
+				A.Height = 1 + glm::max(B.Height, G.Height);
+				C.Height = 1 + glm::max(A.Height, F.Height);
+			}
+			else
+			{
+				C.Child2 = iG;
+				A.Child2 = iF;
+				F.Parent = iA;
+				A.Bounds = Utils::Union(B.Bounds, F.Bounds);
+				C.Bounds = Utils::Union(A.Bounds, G.Bounds);
+				A.Height = 1 + glm::max(B.Height, F.Height);
+				C.Height = 1 + glm::max(A.Height, G.Height);
+			}
+
+			return iC;
+		}
+
+		// Rotate B up
+		if (balance < -1)
+		{
+			const int32_t iD = B.Child1;
+			const int32_t iE = B.Child2;
+			Node& D = mNodes[iD];
+			Node& E = mNodes[iE];
+
+			B.Child1 = iA;
+			B.Parent = A.Parent;
+			A.Parent = iB;
+
+			if (B.Parent != NullNode)
+			{
+				if (mNodes[B.Parent].Child1 == iA)
+					mNodes[B.Parent].Child1 = iB;
+				else
+					mNodes[B.Parent].Child2 = iB;
+			}
+			else
+			{
+				mRoot = iB;
+			}
+
+			if (D.Height > E.Height)
+			{
+				B.Child2 = iD;
+				A.Child1 = iE;
+				E.Parent = iA;
+				A.Bounds = Utils::Union(C.Bounds, E.Bounds);
+				B.Bounds = Utils::Union(A.Bounds, D.Bounds);
+				A.Height = 1 + glm::max(C.Height, E.Height);
+				B.Height = 1 + glm::max(A.Height, D.Height);
+			}
+			else
+			{
+				B.Child2 = iE;
+				A.Child1 = iD;
+				D.Parent = iA;
+				A.Bounds = Utils::Union(C.Bounds, D.Bounds);
+				B.Bounds = Utils::Union(A.Bounds, E.Bounds);
+				A.Height = 1 + glm::max(C.Height, D.Height);
+				B.Height = 1 + glm::max(A.Height, E.Height);
+			}
+
+			return iB;
+		}
+
+		return iA;
+	}
+}
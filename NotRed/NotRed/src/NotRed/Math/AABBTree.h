@@ -0,0 +1,128 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AABB.h"
+#include "Frustum.h"
+#include "Ray.h"
+
+namespace NR
+{
+	//
+	// Dynamic bounding volume hierarchy over fattened AABBs.
+	// Leaves are kept balanced with tree rotations, moving a proxy only touches the tree
+	// when its new bounds escape the fattened ones.
+	//
+	class AABBTree
+	{
+	public:
+		static constexpr int32_t NullNode = -1;
+
+		AABBTree(float margin = 0.1f);
+
+		int32_t CreateProxy(const AABB& aabb, uint32_t userData);
+		void DestroyProxy(int32_t proxy);
+
+		// Returns true if the proxy had to be reinserted
+		bool MoveProxy(int32_t proxy, const AABB& aabb);
+
+		uint32_t GetUserData(int32_t proxy) const { return mNodes[proxy].UserData; }
+		const AABB& GetFatAABB(int32_t proxy) const { return mNodes[proxy].Bounds; }
+
+		uint32_t GetProxyCount() const { return mProxyCount; }
+		int32_t GetHeight() const { return mRoot == NullNode ? 0 : mNodes[mRoot].Height; }
+
+		void Clear();
+
+		// The callbacks return false to stop the query early
+		template<typename Fn>
+		void Query(const AABB& aabb, Fn&& callback) const
+		{
+			Traverse([&aabb](const AABB& bounds) { return Overlaps(aabb, bounds); },
+				[&callback](const Node& node) { return callback(node.UserData); });
+		}
+
+		template<typename Fn>
+		void Query(const Frustum& frustum, Fn&& callback) const
+		{
+			Traverse([&frustum](const AABB& bounds) { return frustum.IntersectsAABB(bounds); },
+				[&callback](const Node& node) { return callback(node.UserData); });
+		}
+
+		// The callback receives the distance along the ray to the proxy bounds
+		template<typename Fn>
+		void Raycast(const Ray& ray, Fn&& callback) const
+		{
+			float t;
+			Traverse([&ray, &t](const AABB& bounds) { return ray.IntersectsAABB(bounds, t); },
+				[&callback, &t](const Node& node) { return callback(node.UserData, t); });
+		}
+
+	private:
+		struct Node
+		{
+			AABB Bounds;
+			uint32_t UserData = 0;
+
+			// Doubles as the free list link
+			int32_t Parent = NullNode;
+			int32_t Child1 = NullNode;
+			int32_t Child2 = NullNode;
+
+			// Leaves are 0, free nodes are -1
+			int32_t Height = -1;
+
+			bool IsLeaf() const { return Child1 == NullNode; }
+		};
+
+		int32_t AllocateNode();
+		void FreeNode(int32_t node);
+
+		void InsertLeaf(int32_t leaf);
+		void RemoveLeaf(int32_t leaf);
+		int32_t Balance(int32_t node);
+
+		static bool Overlaps(const AABB& a, const AABB& b);
+
+		template<typename TestFn, typename LeafFn>
+		void Traverse(TestFn&& test, LeafFn&& leaf) const
+		{
+			if (mRoot == NullNode)
+				return;
+
+			mStack.clear();
+			mStack.push_back(mRoot);
+			while (!mStack.empty())
+			{
+				const Node& node = mNodes[mStack.back()];
+				mStack.pop_back();
+
+				if (!test(node.Bounds))
+					continue;
+
+				if (node.IsLeaf())
+				{
+					if (!leaf(node))
+						return;
+				}
+				else
+				{
+					mStack.push_back(node.Child1);
+					mStack.push_back(node.Child2);
+				}
+			}
+		}
+
+	private:
+		std::vector<Node> mNodes;
+		int32_t mRoot = NullNode;
+		int32_t mFreeList = NullNode;
+		uint32_t mProxyCount = 0;
+		float mMargin;
+
+		// Traversal scratch, queries are not reentrant
+		mutable std::vector<int32_t> mStack;
+	};
+}
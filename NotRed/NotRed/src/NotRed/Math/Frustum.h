@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "AABB.h"
+
+namespace NR
+{
+    struct Frustum
+    {
+        // Plane equations (xyz = normal, w = distance), normals point inwards
+        glm::vec4 Planes[6];
+
+        Frustum()
+        {
+            for (auto& plane : Planes)
+                plane = glm::vec4(0.0f);
+        }
+
+        // Extracts the planes from a view-projection matrix with [0, 1] clip space depth
+        Frustum(const glm::mat4& viewProjection)
+        {
+            const glm::vec4 row0 = { viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0] };
+            const glm::vec4 row1 = { viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1] };
+            const glm::vec4 row2 = { viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2] };
+            const glm::vec4 row3 = { viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3] };
+
+            Planes[0] = row3 + row0; // Left
+            Planes[1] = row3 - row0; // Right
+            Planes[2] = row3 + row1; // Bottom
+            Planes[3] = row3 - row1; // Top
+            Planes[4] = row2;        // Near
+            Planes[5] = row3 - row2; // Far
+
+            for (auto& plane : Planes)
+                plane /= glm::length(glm::vec3(plane));
+        }
+
+        // Conservative test, boxes straddling a frustum corner may be reported as visible
+        bool IntersectsAABB(const AABB& aabb) const
+        {
+            for (const auto& plane : Planes)
+            {
+                // The box corner furthest along the plane normal
+                const glm::vec3 positive = {
+                    plane.x >= 0.0f ? aabb.Max.x : aabb.Min.x,
+                    plane.y >= 0.0f ? aabb.Max.y : aabb.Min.y,
+                    plane.z >= 0.0f ? aabb.Max.z : aabb.Min.z
+                };
+
+                if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+                    return false;
+            }
+
+            return true;
+        }
+    };
+}
@@ -0,0 +1,141 @@
+#include "nrpch.h"
+#include "TriangleBVH.h"
+
+namespace NR
+{
+	static constexpr uint32_t MaxLeafTriangles = 4;
+
+	void TriangleBVH::Build(std::vector<glm::vec3> positions)
+	{
+		NR_CORE_ASSERT(positions.size() % 3 == 0);
+
+		mNodes.clear();
+		mPositions.clear();
+
+		const uint32_t triangleCount = (uint32_t)positions.size() / 3;
+		if (triangleCount == 0)
+			return;
+
+		std::vector<uint32_t> triangles(triangleCount);
+		std::vector<glm::vec3> centroids(triangleCount);
+		for (uint32_t i = 0; i < triangleCount; ++i)
+		{
+			triangles[i] = i;
+			centroids[i] = (positions[i * 3] + positions[i * 3 + 1] + positions[i * 3 + 2]) / 3.0f;
+		}
+
+		mNodes.reserve(triangleCount * 2);
+		Node& root = mNodes.emplace_back();
+		root.LeftFirst = 0;
+		root.Count = triangleCount;
+		Subdivide(0, triangles, centroids, positions);
+
+		// Store the triangles in leaf order so leaves reference contiguous ranges
+		mPositions.resize(positions.size());
+		for (uint32_t i = 0; i < triangleCount; ++i)
+		{
+			mPositions[i * 3] = positions[triangles[i] * 3];
+			mPositions[i * 3 + 1] = positions[triangles[i] * 3 + 1];
+			mPositions[i * 3 + 2] = positions[triangles[i] * 3 + 2];
+		}
+	}
+
+	void TriangleBVH::Subdivide(uint32_t nodeIndex, std::vector<uint32_t>& triangles, const std::vector<glm::vec3>& centroids, const std::vector<glm::vec3>& positions)
+	{
+		const uint32_t first = mNodes[nodeIndex].LeftFirst;
+		const uint32_t count = mNodes[nodeIndex].Count;
+
+		AABB bounds(glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+		AABB centroidBounds = bounds;
+		for (uint32_t i = first; i < first + count; ++i)
+		{
+			const uint32_t triangle = triangles[i];
+			for (uint32_t v = 0; v < 3; ++v)
+			{
+				bounds.Min = glm::min(bounds.Min, positions[triangle * 3 + v]);
+				bounds.Max = glm::max(bounds.Max, positions[triangle * 3 + v]);
+			}
+			centroidBounds.Min = glm::min(centroidBounds.Min, centroids[triangle]);
+			centroidBounds.Max = glm::max(centroidBounds.Max, centroids[triangle]);
+		}
+		mNodes[nodeIndex].Bounds = bounds;
+
+		if (count <= MaxLeafTriangles)
+			return;
+
+		// Median split along the longest centroid axis
+		const glm::vec3 extent = centroidBounds.Max - centroidBounds.Min;
+		int axis = 0;
+		if (extent.y > extent.x)
+			axis = 1;
+		if (extent.z > extent[axis])
+			axis = 2;
+
+		if (extent[axis] <= 0.0f)
+			return;
+
+		const uint32_t half = count / 2;
+		std::nth_element(triangles.begin() + first, triangles.begin() + first + half, triangles.begin() + first + count, [&centroids, axis](uint32_t a, uint32_t b)
+			{
+				return centroids[a][axis] < centroids[b][axis];
+			});
+
+		const uint32_t leftIndex = (uint32_t)mNodes.size();
+		mNodes.emplace_back();
+		mNodes.emplace_back();
+
+		mNodes[leftIndex].LeftFirst = first;
+		mNodes[leftIndex].Count = half;
+		mNodes[leftIndex + 1].LeftFirst = first + half;
+		mNodes[leftIndex + 1].Count = count - half;
+
+		mNodes[nodeIndex].LeftFirst = leftIndex;
+		mNodes[nodeIndex].Count = 0;
+
+		Subdivide(leftIndex, triangles, centroids, positions);
+		Subdivide(leftIndex + 1, triangles, centroids, positions);
+	}
+
+	bool TriangleBVH::Raycast(const Ray& ray, float& t) const
+	{
+		if (mNodes.empty())
+			return false;
+
+		float closest = FLT_MAX;
+
+		uint32_t stack[64];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const Node& node = mNodes[stack[--stackSize]];
+
+			float boundsT;
+			if (!ray.IntersectsAABB(node.Bounds, boundsT) || boundsT > closest)
+				continue;
+
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.Count; ++i)
+				{
+					float triangleT;
+					if (ray.IntersectsTriangle(mPositions[i * 3], mPositions[i * 3 + 1], mPositions[i * 3 + 2], triangleT) && triangleT < closest)
+						closest = triangleT;
+				}
+			}
+			else
+			{
+				NR_CORE_ASSERT(stackSize + 2 <= 64, "TriangleBVH is too deep");
+				stack[stackSize++] = node.LeftFirst;
+				stack[stackSize++] = node.LeftFirst + 1;
+			}
+		}
+
+		if (closest == FLT_MAX)
+			return false;
+
+		t = closest;
+		return true;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AABB.h"
+#include "Ray.h"
+
+namespace NR
+{
+	//
+	// Static bounding volume hierarchy over a triangle soup, built once and only read afterwards
+	//
+	class TriangleBVH
+	{
+	public:
+		// Three vertex positions per triangle
+		void Build(std::vector<glm::vec3> positions);
+
+		// Finds the closest front facing triangle along the ray
+		bool Raycast(const Ray& ray, float& t) const;
+
+		bool IsEmpty() const { return mNodes.empty(); }
+		uint32_t GetTriangleCount() const { return (uint32_t)mPositions.size() / 3; }
+
+	private:
+		struct Node
+		{
+			AABB Bounds;
+
+			// First triangle for leaves, first child for interior nodes (the second child follows it)
+			uint32_t LeftFirst = 0;
+			uint32_t Count = 0;
+
+			bool IsLeaf() const { return Count > 0; }
+		};
+
+		void Subdivide(uint32_t nodeIndex, std::vector<uint32_t>& triangles, const std::vector<glm::vec3>& centroids, const std::vector<glm::vec3>& positions);
+
+	private:
+		std::vector<Node> mNodes;
+		std::vector<glm::vec3> mPositions;
+	};
+}
@@ -8,6 +8,8 @@
 #include "NotRed/Script/ScriptEngine.h"
 #include "PhysicsJoints.h"
 
+#include "NotRed/Debug/Profiler.h"
+
 namespace NR
 {
 	void ContactListener::onConstraintBreak(physx::PxConstraintInfo* constraints, physx::PxU32 count)
@@ -17,24 +19,12 @@ namespace NR
 			physx::PxJoint* nativeJoint = (physx::PxJoint*)constraints[i].externalReference;
 			Ref<JointBase> joint = (JointBase*)nativeJoint->userData;
 
-			Entity entity = joint->GetEntity();
-			Entity connectedEntity = joint->GetConnectedEntity();
-
-			bool actorAScriptModuleValid = ScriptEngine::IsEntityModuleValid(entity);
-			bool actorBScriptModuleValid = ScriptEngine::IsEntityModuleValid(connectedEntity);
-
-			glm::vec3 linearForce = joint->GetLastReportedLinearForce();
-			glm::vec3 angularForce = joint->GetLastReportedAngularForce();
-
-			if (actorAScriptModuleValid)
-			{
-				ScriptEngine::JointBreak(entity, linearForce, angularForce);
-			}
-
-			if (actorBScriptModuleValid)
-			{
-				ScriptEngine::JointBreak(connectedEntity, linearForce, angularForce);
-			}
+			mJointBreakEvents.push_back({
+				joint->GetEntity().GetID(),
+				joint->GetConnectedEntity().GetID(),
+				joint->GetLastReportedLinearForce(),
+				joint->GetLastReportedAngularForce()
+			});
 		}
 	}
 
@@ -60,11 +50,6 @@ namespace NR
 
 	void ContactListener::onContact(const physx::PxContactPairHeader& pairHeader, const physx::PxContactPair* pairs, physx::PxU32 nbPairs)
 	{
-		if (!ScriptEngine::GetCurrentSceneContext()->IsPlaying())
-		{
-			return;
-		}
-
 		auto removedActorA = pairHeader.flags & physx::PxContactPairHeaderFlag::eREMOVED_ACTOR_0;
 		auto removedActorB = pairHeader.flags & physx::PxContactPairHeaderFlag::eREMOVED_ACTOR_1;
 
@@ -81,44 +66,25 @@ namespace NR
 			return;
 		}
 
-		bool actorAScriptModuleValid = ScriptEngine::IsEntityModuleValid(actorA->GetEntity());
-		bool actorBScriptModuleValid = ScriptEngine::IsEntityModuleValid(actorB->GetEntity());
-		if (!actorAScriptModuleValid && !actorBScriptModuleValid)
-		{
-			return;
-		}
+		UUID entityA = actorA->GetEntity().GetID();
+		UUID entityB = actorB->GetEntity().GetID();
 
-		if (pairs->flags == physx::PxContactPairFlag::eACTOR_PAIR_HAS_FIRST_TOUCH)
+		// The actor pair flags are repeated on every shape pair that reports them, RecordContact drops the duplicates
+		for (uint32_t i = 0; i < nbPairs; ++i)
 		{
-			if (actorAScriptModuleValid)
+			if (pairs[i].flags & physx::PxContactPairFlag::eACTOR_PAIR_HAS_FIRST_TOUCH)
 			{
-				ScriptEngine::CollisionBegin(actorA->GetEntity(), actorB->GetEntity());
+				RecordContact(entityA, entityB, false, true);
 			}
-			if (actorBScriptModuleValid)
+			else if (pairs[i].flags & physx::PxContactPairFlag::eACTOR_PAIR_LOST_TOUCH)
 			{
-				ScriptEngine::CollisionBegin(actorB->GetEntity(), actorA->GetEntity());
-			}
-		}
-		else if (pairs->flags == physx::PxContactPairFlag::eACTOR_PAIR_LOST_TOUCH)
-		{
-			if (actorAScriptModuleValid)
-			{
-				ScriptEngine::CollisionEnd(actorA->GetEntity(), actorB->GetEntity());
-			}
-			if (actorBScriptModuleValid)
-			{
-				ScriptEngine::CollisionEnd(actorB->GetEntity(), actorA->GetEntity());
+				RecordContact(entityA, entityB, false, false);
 			}
 		}
 	}
 
 	void ContactListener::onTrigger(physx::PxTriggerPair* pairs, physx::PxU32 count)
 	{
-		if (!ScriptEngine::GetCurrentSceneContext()->IsPlaying())
-		{
-			return;
-		}
-
 		for (uint32_t i = 0; i < count; i++)
 		{
 			if (pairs[i].flags & (physx::PxTriggerPairFlag::eREMOVED_SHAPE_TRIGGER | physx::PxTriggerPairFlag::eREMOVED_SHAPE_OTHER))
@@ -134,42 +100,156 @@ namespace NR
 				continue;
 			}
 
-			bool triggerActorScriptModuleValid = ScriptEngine::IsEntityModuleValid(triggerActor->GetEntity());
-			bool otherActorScriptModuleValid = ScriptEngine::IsEntityModuleValid(otherActor->GetEntity());
-			if (!triggerActorScriptModuleValid && !otherActorScriptModuleValid)
+			if (pairs[i].status == physx::PxPairFlag::eNOTIFY_TOUCH_FOUND)
 			{
-				continue;
+				RecordContact(triggerActor->GetEntity().GetID(), otherActor->GetEntity().GetID(), true, true);
 			}
+			else if (pairs[i].status == physx::PxPairFlag::eNOTIFY_TOUCH_LOST)
+			{
+				RecordContact(triggerActor->GetEntity().GetID(), otherActor->GetEntity().GetID(), true, false);
+			}
+		}
+	}
 
-			if (pairs[i].status == physx::PxPairFlag::eNOTIFY_TOUCH_FOUND)
+	void ContactListener::onAdvance(const physx::PxRigidBody* const* bodyBuffer, const physx::PxTransform* poseBuffer, const physx::PxU32 count)
+	{
+		PX_UNUSED(bodyBuffer);
+		PX_UNUSED(poseBuffer);
+		PX_UNUSED(count);
+	}
+
+	void ContactListener::RecordContact(UUID entityA, UUID entityB, bool trigger, bool begin)
+	{
+		ContactType type;
+		if (trigger)
+		{
+			type = begin ? ContactType::TriggerBegin : ContactType::TriggerEnd;
+		}
+		else
+		{
+			type = begin ? ContactType::CollisionBegin : ContactType::CollisionEnd;
+		}
+
+		auto [it, inserted] = mContactEventIndices.try_emplace({ entityA, entityB, trigger }, (uint32_t)mContactEvents.size());
+		if (inserted)
+		{
+			mContactEvents.push_back({ entityA, entityB, type, type });
+		}
+		else
+		{
+			mContactEvents[it->second].Last = type;
+		}
+	}
+
+	void ContactListener::DispatchEvents(Scene* scene)
+	{
+		EventHandlers handlers;
+		handlers.IsScripted = [scene](UUID entityID)
+		{
+			Entity entity = scene->FindEntityByID(entityID);
+			return entity && ScriptEngine::IsEntityModuleValid(entity);
+		};
+
+		if (scene->IsPlaying())
+		{
+			handlers.ContactEvents = [scene](UUID entityID, const std::vector<UUID>& others, const std::vector<ContactType>& types)
+			{
+				ScriptEngine::ContactEvents(scene->FindEntityByID(entityID), others, types);
+			};
+		}
+
+		handlers.JointBreak = [scene](UUID entityID, const glm::vec3& linearForce, const glm::vec3& angularForce)
+		{
+			ScriptEngine::JointBreak(scene->FindEntityByID(entityID), linearForce, angularForce);
+		};
+
+		DispatchEvents(handlers);
+	}
+
+	void ContactListener::DispatchEvents(const EventHandlers& handlers)
+	{
+		NR_PROFILE_FUNC();
+
+		if (handlers.ContactEvents && !mContactEvents.empty())
+		{
+			mScriptEventIndices.clear();
+			mScriptEventCount = 0;
+
+			auto addScriptEvent = [&](UUID entityID, UUID otherID, ContactType type)
 			{
-				if (triggerActorScriptModuleValid)
+				auto [it, inserted] = mScriptEventIndices.try_emplace(entityID, std::numeric_limits<uint32_t>::max());
+				if (inserted)
 				{
-					ScriptEngine::TriggerBegin(triggerActor->GetEntity(), otherActor->GetEntity());
+					if (!handlers.IsScripted(entityID))
+					{
+						return;
+					}
+
+					if (mScriptEventCount == mScriptEvents.size())
+					{
+						mScriptEvents.emplace_back();
+					}
+
+					ScriptContactEvents& events = mScriptEvents[mScriptEventCount];
+					events.Entity = entityID;
+					events.Others.clear();
+					events.Types.clear();
+
+					it->second = mScriptEventCount++;
 				}
-				if (otherActorScriptModuleValid)
+
+				if (it->second == std::numeric_limits<uint32_t>::max())
 				{
-					ScriptEngine::TriggerBegin(otherActor->GetEntity(), triggerActor->GetEntity());
+					return;
 				}
-			}
-			else if (pairs[i].status == physx::PxPairFlag::eNOTIFY_TOUCH_LOST)
+
+				ScriptContactEvents& events = mScriptEvents[it->second];
+				events.Others.push_back(otherID);
+				events.Types.push_back(type);
+			};
+
+			for (const auto& event : mContactEvents)
 			{
-				if (triggerActorScriptModuleValid)
+				addScriptEvent(event.EntityA, event.EntityB, event.First);
+				addScriptEvent(event.EntityB, event.EntityA, event.First);
+
+				if (event.Last != event.First)
 				{
-					ScriptEngine::TriggerEnd(triggerActor->GetEntity(), otherActor->GetEntity());
+					addScriptEvent(event.EntityA, event.EntityB, event.Last);
+					addScriptEvent(event.EntityB, event.EntityA, event.Last);
 				}
-				if (otherActorScriptModuleValid)
+			}
+
+			for (uint32_t i = 0; i < mScriptEventCount; ++i)
+			{
+				// A script handling an earlier event might have destroyed this entity
+				if (handlers.IsScripted(mScriptEvents[i].Entity))
 				{
-					ScriptEngine::TriggerEnd(otherActor->GetEntity(), triggerActor->GetEntity());
+					handlers.ContactEvents(mScriptEvents[i].Entity, mScriptEvents[i].Others, mScriptEvents[i].Types);
 				}
 			}
 		}
+
+		for (const auto& event : mJointBreakEvents)
+		{
+			if (handlers.IsScripted(event.Entity))
+			{
+				handlers.JointBreak(event.Entity, event.LinearForce, event.AngularForce);
+			}
+
+			if (handlers.IsScripted(event.ConnectedEntity))
+			{
+				handlers.JointBreak(event.ConnectedEntity, event.LinearForce, event.AngularForce);
+			}
+		}
+
+		ClearEvents();
 	}
 
-	void ContactListener::onAdvance(const physx::PxRigidBody* const* bodyBuffer, const physx::PxTransform* poseBuffer, const physx::PxU32 count)
+	void ContactListener::ClearEvents()
 	{
-		PX_UNUSED(bodyBuffer);
-		PX_UNUSED(poseBuffer);
-		PX_UNUSED(count);
+		mContactEvents.clear();
+		mContactEventIndices.clear();
+		mJointBreakEvents.clear();
 	}
-}
\ No newline at end of file
+}
@@ -1,9 +1,25 @@
 #pragma once
 
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
 #include <PxPhysicsAPI.h>
 
+#include "NotRed/Core/UUID.h"
+
+#include "PhysicsTypes.h"
+
 namespace NR
 {
+	class Scene;
+
+	//
+	// PhysX reports events from inside fetchResults, so they are only recorded here and handed to scripts
+	// by DispatchEvents once the step is over. Events of the same pair from different substeps are coalesced.
+	//
 	class ContactListener : public physx::PxSimulationEventCallback
 	{
 	public:
@@ -16,5 +32,79 @@ namespace NR
 		void onTrigger(physx::PxTriggerPair* pairs, physx::PxU32 count) override;
 
 		void onAdvance(const physx::PxRigidBody* const* bodyBuffer, const physx::PxTransform* poseBuffer, const physx::PxU32 count) override;
+
+		// Where DispatchEvents delivers the recorded events, the scene overload sends them to the entities' scripts
+		struct EventHandlers
+		{
+			// Whether the entity (still) exists and has a script that receives events
+			std::function<bool(UUID entity)> IsScripted;
+			// Left empty to drop the contact events (e.g. while the scene isn't playing)
+			std::function<void(UUID entity, const std::vector<UUID>& others, const std::vector<ContactType>& types)> ContactEvents;
+			std::function<void(UUID entity, const glm::vec3& linearForce, const glm::vec3& angularForce)> JointBreak;
+		};
+
+		// Every entity with a script gets one call with all of its events, in the order they were first reported
+		void DispatchEvents(Scene* scene);
+		void DispatchEvents(const EventHandlers& handlers);
+		void ClearEvents();
+
+		// Called by the PhysX callbacks for every begin/end of a pair, which can happen several times per step with substeps
+		void RecordContact(UUID entityA, UUID entityB, bool trigger, bool begin);
+
+	private:
+		struct ContactPairKey
+		{
+			uint64_t EntityA;
+			uint64_t EntityB;
+			bool Trigger;
+
+			bool operator==(const ContactPairKey& other) const
+			{
+				return EntityA == other.EntityA && EntityB == other.EntityB && Trigger == other.Trigger;
+			}
+		};
+
+		struct ContactPairKeyHash
+		{
+			size_t operator()(const ContactPairKey& key) const
+			{
+				size_t hash = std::hash<uint64_t>()(key.EntityA);
+				hash ^= std::hash<uint64_t>()(key.EntityB) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+				return hash ^ (size_t)key.Trigger;
+			}
+		};
+
+		// A pair's events within one step collapse to the first and last one. If both are the same only one is sent.
+		struct ContactEvent
+		{
+			UUID EntityA;
+			UUID EntityB;
+			ContactType First;
+			ContactType Last;
+		};
+
+		struct JointBreakEvent
+		{
+			UUID Entity;
+			UUID ConnectedEntity;
+			glm::vec3 LinearForce;
+			glm::vec3 AngularForce;
+		};
+
+		struct ScriptContactEvents
+		{
+			UUID Entity;
+			std::vector<UUID> Others;
+			std::vector<ContactType> Types;
+		};
+
+		std::vector<ContactEvent> mContactEvents;
+		std::unordered_map<ContactPairKey, uint32_t, ContactPairKeyHash> mContactEventIndices;
+		std::vector<JointBreakEvent> mJointBreakEvents;
+
+		// Reused between steps so dispatching doesn't allocate once the buffers have grown
+		std::vector<ScriptContactEvents> mScriptEvents;
+		std::unordered_map<UUID, uint32_t> mScriptEventIndices;
+		uint32_t mScriptEventCount = 0;
 	};
-}
\ No newline at end of file
+}
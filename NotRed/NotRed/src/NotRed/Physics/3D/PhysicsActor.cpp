@@ -18,6 +18,7 @@ namespace NR
 		: PhysicsActorBase(PhysicsActorBase::Type::Actor, entity), mRigidBodyData(entity.GetComponent<RigidBodyComponent>())
 	{
 		CreateRigidActor();
+		ResetPose();
 	}
 
 	PhysicsActor::~PhysicsActor()
@@ -30,6 +31,7 @@ namespace NR
 		physx::PxTransform transform = mRigidActor->getGlobalPose();
 		transform.p = PhysicsUtils::ToPhysicsVector(translation);
 		mRigidActor->setGlobalPose(transform, autowake);
+		ResetPose();
 
 		if (mRigidBodyData.BodyType == RigidBodyComponent::Type::Static)
 		{
@@ -42,6 +44,7 @@ namespace NR
 		physx::PxTransform transform = mRigidActor->getGlobalPose();
 		transform.q = PhysicsUtils::ToPhysicsQuat(glm::quat(rotation));
 		mRigidActor->setGlobalPose(transform, autowake);
+		ResetPose();
 
 		if (mRigidBodyData.BodyType == RigidBodyComponent::Type::Static)
 		{
@@ -56,6 +59,7 @@ namespace NR
 			* physx::PxQuat(glm::radians(rotation.y), { 0.0f, 1.0f, 0.0f })
 			* physx::PxQuat(glm::radians(rotation.z), { 0.0f, 0.0f, 1.0f }));
 		mRigidActor->setGlobalPose(transform, autowake);
+		ResetPose();
 
 		if (mRigidBodyData.BodyType == RigidBodyComponent::Type::Static)
 		{
@@ -550,5 +554,45 @@ namespace NR
 		physx::PxTransform actorPose = mRigidActor->getGlobalPose();
 		transform.Translation = PhysicsUtils::FromPhysicsVector(actorPose.p);
 		transform.Rotation = glm::eulerAngles(PhysicsUtils::FromPhysicsQuat(actorPose.q));
+		mEntity.MarkTransformDirty();
 	}
-}
\ No newline at end of file
+
+	void PhysicsActor::StorePose(uint64_t step)
+	{
+		// The actor didn't move since its last stored pose, otherwise it would have been stored then
+		mPreviousPose = mCurrentPose;
+		mCurrentPose = mRigidActor->getGlobalPose();
+		mPoseStep = step;
+	}
+
+	void PhysicsActor::ResetPose()
+	{
+		mCurrentPose = mRigidActor->getGlobalPose();
+		mPreviousPose = mCurrentPose;
+	}
+
+	void PhysicsActor::InterpolateTransform(float alpha)
+	{
+		const glm::vec3 previousPosition = PhysicsUtils::FromPhysicsVector(mPreviousPose.p);
+		const glm::vec3 currentPosition = PhysicsUtils::FromPhysicsVector(mCurrentPose.p);
+		const glm::quat previousRotation = PhysicsUtils::FromPhysicsQuat(mPreviousPose.q);
+		const glm::quat currentRotation = PhysicsUtils::FromPhysicsQuat(mCurrentPose.q);
+
+		// Only rendering uses the blended pose, the TransformComponent stays at the simulated one
+		const glm::mat4 interpolatedTransform = glm::translate(glm::mat4(1.0f), glm::mix(previousPosition, currentPosition, alpha))
+			* glm::toMat4(glm::slerp(previousRotation, currentRotation, alpha))
+			* glm::scale(glm::mat4(1.0f), mEntity.Transform().Scale);
+
+		auto& renderTransform = mEntity.GetComponent<InterpolatedTransformComponent>();
+		renderTransform.Transform = interpolatedTransform;
+		renderTransform.Active = true;
+	}
+
+	void PhysicsActor::ClearInterpolatedTransform()
+	{
+		if (mEntity.HasComponent<InterpolatedTransformComponent>())
+		{
+			mEntity.GetComponent<InterpolatedTransformComponent>().Active = false;
+		}
+	}
+}
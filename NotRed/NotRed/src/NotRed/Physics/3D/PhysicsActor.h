@@ -85,6 +85,13 @@ namespace NR
 		void FixedUpdate(float fixedDeltaTime);
 		void SynchronizeTransform() override;
 
+		// Called after every substep this actor moved in
+		void StorePose(uint64_t step);
+		// Teleports shouldn't be blended from the old pose
+		void ResetPose();
+		void InterpolateTransform(float alpha);
+		void ClearInterpolatedTransform();
+
 	private:
 		RigidBodyComponent mRigidBodyData;
 		uint32_t mLockFlags = 0;
@@ -92,6 +99,12 @@ namespace NR
 		physx::PxRigidActor* mRigidActor = nullptr;
 		std::vector<Ref<ColliderShape>> mColliders;
 
+		// Poses before and after the last substep the actor moved in
+		physx::PxTransform mPreviousPose = physx::PxTransform(physx::PxIdentity);
+		physx::PxTransform mCurrentPose = physx::PxTransform(physx::PxIdentity);
+		uint64_t mPoseStep = 0;
+		bool mInterpolating = false;
+
 	private:
 		friend class PhysicsScene;
 	};
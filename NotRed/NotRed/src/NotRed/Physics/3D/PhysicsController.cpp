@@ -135,5 +135,6 @@ namespace NR
 	{
 		TransformComponent& transform = mEntity.Transform();
 		transform.Translation = GetPosition();
+		mEntity.MarkTransformDirty();
 	}
 }
\ No newline at end of file
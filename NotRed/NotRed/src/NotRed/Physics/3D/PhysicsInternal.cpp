@@ -1,6 +1,8 @@
 #include "nrpch.h"
 #include "PhysicsInternal.h"
 
+#include <thread>
+
 #include "CookingFactory.h"
 
 #include "NotRed/Math/Math.h"
@@ -12,7 +14,6 @@ namespace NR
 	struct PhysicsData
 	{
 		physx::PxFoundation* Foundation;
-		physx::PxDefaultCpuDispatcher* CPUDispatcher;
 		physx::PxPhysics* PhysicsSDK;
 
 		physx::PxDefaultAllocator Allocator;
@@ -98,8 +99,6 @@ namespace NR
 		bool extentionsLoaded = PxInitExtensions(*sPhysicsData->PhysicsSDK, PhysicsDebugger::GetDebugger());
 		NR_CORE_ASSERT(extentionsLoaded, "Failed to initialize Physics Extensions.");
 
-		sPhysicsData->CPUDispatcher = physx::PxDefaultCpuDispatcherCreate(1);
-
 		CookingFactory::Initialize();
 	}
 
@@ -107,9 +106,6 @@ namespace NR
 	{
 		CookingFactory::Shutdown();
 
-		sPhysicsData->CPUDispatcher->release();
-		sPhysicsData->CPUDispatcher = nullptr;
-
 		PxCloseExtensions();
 
 		PhysicsDebugger::StopDebugging();
@@ -136,9 +132,13 @@ namespace NR
 		return *sPhysicsData->PhysicsSDK; 
 	
 	}
-	physx::PxCpuDispatcher* PhysicsInternal::GetCPUDispatcher() 
-	{ 
-		return sPhysicsData->CPUDispatcher; 
+	uint32_t PhysicsInternal::GetWorkerThreadCount(const PhysicsSettings& settings)
+	{
+		if (settings.WorkerThreadCount > 0)
+			return settings.WorkerThreadCount;
+
+		const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
 	}
 
 	physx::PxDefaultAllocator& PhysicsInternal::GetAllocator()
@@ -20,9 +20,11 @@ namespace NR
 
 		static physx::PxFoundation& GetFoundation();
 		static physx::PxPhysics& GetPhysicsSDK();
-		static physx::PxCpuDispatcher* GetCPUDispatcher();
 		static physx::PxDefaultAllocator& GetAllocator();
 
+		// Resolves PhysicsSettings::WorkerThreadCount, 0 becomes the hardware thread count minus the main thread
+		static uint32_t GetWorkerThreadCount(const PhysicsSettings& settings);
+
 		static physx::PxFilterFlags FilterShader(
 			physx::PxFilterObjectAttributes attributes0, 
 			physx::PxFilterData filterData0, 
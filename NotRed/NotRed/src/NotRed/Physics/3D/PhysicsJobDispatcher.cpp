@@ -0,0 +1,25 @@
+#include "nrpch.h"
+#include "PhysicsJobDispatcher.h"
+
+#include <task/PxTask.h>
+
+#include "NotRed/Core/JobSystem.h"
+
+namespace NR
+{
+	void PhysicsJobDispatcher::submitTask(physx::PxBaseTask& task)
+	{
+		// PhysX owns the task, release hands it back to its task manager once it ran
+		JobSystem::Schedule([&task]()
+			{
+				task.run();
+				task.release();
+			}, task.getName());
+	}
+
+	uint32_t PhysicsJobDispatcher::getWorkerCount() const
+	{
+		const uint32_t jobWorkers = JobSystem::GetWorkerCount();
+		return mWorkerCount > 0 && mWorkerCount < jobWorkers ? mWorkerCount : jobWorkers;
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <task/PxCpuDispatcher.h>
+
+namespace NR
+{
+	// Runs PhysX simulation tasks on the engine's JobSystem instead of a separate PhysX thread pool
+	class PhysicsJobDispatcher : public physx::PxCpuDispatcher
+	{
+	public:
+		// PhysX splits its work by the reported worker count, it's capped by the JobSystem's worker count
+		void SetWorkerCount(uint32_t workerCount) { mWorkerCount = workerCount; }
+
+		void submitTask(physx::PxBaseTask& task) override;
+		uint32_t getWorkerCount() const override;
+
+	private:
+		uint32_t mWorkerCount = 0;
+	};
+}
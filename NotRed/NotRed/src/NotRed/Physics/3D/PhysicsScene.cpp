@@ -8,7 +8,6 @@
 #include "PhysicsManager.h"
 #include "PhysicsInternal.h"
 #include "PhysicsUtils.h"
-#include "ContactListener.h"
 
 #include "NotRed/Debug/Profiler.h"
 
@@ -16,10 +15,8 @@
 
 namespace NR
 {
-	static ContactListener sContactListener;
-
 	PhysicsScene::PhysicsScene(const PhysicsSettings& settings)
-		: mSubStepSize(settings.FixedDeltaTime)
+		: mSubStepSize(settings.FixedDeltaTime), mInterpolateTransforms(settings.InterpolateTransforms)
 	{
 		physx::PxSceneDesc sceneDesc(PhysicsInternal::GetPhysicsSDK().getTolerancesScale());
 		sceneDesc.flags |= physx::PxSceneFlag::eENABLE_CCD | physx::PxSceneFlag::eENABLE_PCM;
@@ -30,8 +27,20 @@ namespace NR
 		sceneDesc.broadPhaseType = PhysicsUtils::ToPhysicsBroadphaseType(settings.BroadphaseAlgorithm);
 		sceneDesc.frictionType = PhysicsUtils::ToPhysicsFrictionType(settings.FrictionModel);
 		sceneDesc.filterShader = (physx::PxSimulationFilterShader)PhysicsInternal::FilterShader;
-		sceneDesc.cpuDispatcher = PhysicsInternal::GetCPUDispatcher();
-		sceneDesc.simulationEventCallback = &sContactListener;
+
+		const uint32_t workerCount = PhysicsInternal::GetWorkerThreadCount(settings);
+		if (settings.UseJobSystem)
+		{
+			mJobDispatcher.SetWorkerCount(workerCount);
+			sceneDesc.cpuDispatcher = &mJobDispatcher;
+		}
+		else
+		{
+			mDefaultDispatcher = physx::PxDefaultCpuDispatcherCreate(workerCount);
+			sceneDesc.cpuDispatcher = mDefaultDispatcher;
+		}
+
+		sceneDesc.simulationEventCallback = &mContactListener;
 
 		NR_CORE_ASSERT(sceneDesc.isValid());
 
@@ -49,6 +58,13 @@ namespace NR
 		mPhysicsControllerManager->release();
 		mPhysicsScene->release();
 		mPhysicsScene = nullptr;
+
+		// The scene has to be gone before its dispatcher
+		if (mDefaultDispatcher)
+		{
+			mDefaultDispatcher->release();
+			mDefaultDispatcher = nullptr;
+		}
 	}
 
 	void PhysicsScene::Simulate(float dt)
@@ -80,7 +96,15 @@ namespace NR
 					actor->SynchronizeTransform();
 				}
 			}
+		}
 
+		if (mInterpolateTransforms)
+		{
+			InterpolateTransforms();
+		}
+
+		if (advanced)
+		{
 			for (auto& controller : mControllers)
 			{
 				controller->SynchronizeTransform();
@@ -90,6 +114,9 @@ namespace NR
 			{
 				joint->PostSimulation();
 			}
+
+			// Scripts only run once every substep is done and the transforms are synchronized
+			mContactListener.DispatchEvents(mEntityScene.Raw());
 		}
 	}
 
@@ -107,11 +134,73 @@ namespace NR
 				NR_PROFILE_FUNC("PxScene::fetchResults");
 				mPhysicsScene->fetchResults(true);
 			}
+
+			if (mInterpolateTransforms)
+			{
+				StoreActivePoses();
+			}
 		}
 
 		return mNumSubSteps != 0;
 	}
 
+	void PhysicsScene::StoreActivePoses()
+	{
+		NR_PROFILE_FUNC();
+
+		++mStepCount;
+
+		uint32_t nbActiveActors;
+		physx::PxActor** activeActors = mPhysicsScene->getActiveActors(nbActiveActors);
+		for (uint32_t i = 0; i < nbActiveActors; ++i)
+		{
+			PhysicsActor* actor = (PhysicsActor*)activeActors[i]->userData;
+			if (!actor || actor->IsSleeping())
+			{
+				continue;
+			}
+
+			actor->StorePose(mStepCount);
+			if (!actor->mInterpolating)
+			{
+				actor->mInterpolating = true;
+				mInterpolatedActors.push_back(actor);
+			}
+		}
+	}
+
+	void PhysicsScene::InterpolateTransforms()
+	{
+		NR_PROFILE_FUNC();
+
+		// The remainder left in the accumulator is how far the frame is into the next substep
+		const float alpha = glm::clamp(mAccumulator / mSubStepSize, 0.0f, 1.0f);
+
+		for (size_t i = 0; i < mInterpolatedActors.size();)
+		{
+			Ref<PhysicsActor>& actor = mInterpolatedActors[i];
+
+			// Actors that didn't move in the last substep are drawn at their simulated pose again and dropped
+			const bool moving = actor->mRigidActor && actor->mPoseStep == mStepCount;
+			if (moving)
+			{
+				actor->InterpolateTransform(alpha);
+				++i;
+				continue;
+			}
+
+			if (actor->mRigidActor)
+			{
+				actor->SynchronizeTransform();
+				actor->ClearInterpolatedTransform();
+			}
+
+			actor->mInterpolating = false;
+			std::swap(actor, mInterpolatedActors.back());
+			mInterpolatedActors.pop_back();
+		}
+	}
+
 	void PhysicsScene::SubstepStrategy(float dt)
 	{
 		if (mAccumulator > mSubStepSize)
@@ -132,28 +221,16 @@ namespace NR
 
 	Ref<PhysicsActor> PhysicsScene::GetActor(Entity entity)
 	{
-		for (auto& actor : mActors)
-		{
-			if (actor->GetEntity() == entity)
-			{
-				return actor;
-			}
-		}
-
-		return nullptr;
+		auto it = mActorMap.find(entity.GetID());
+		return it != mActorMap.end() ? it->second : nullptr;
 	}
 
 	const Ref<PhysicsActor>& PhysicsScene::GetActor(Entity entity) const
 	{
-		for (const auto& actor : mActors)
-		{
-			if (actor->GetEntity() == entity)
-			{
-				return actor;
-			}
-		}
+		static const Ref<PhysicsActor> sNullActor = nullptr;
 
-		return nullptr;
+		auto it = mActorMap.find(entity.GetID());
+		return it != mActorMap.end() ? it->second : sNullActor;
 	}
 
 	Ref<PhysicsActor> PhysicsScene::CreateActor(Entity entity)
@@ -200,7 +277,14 @@ namespace NR
 
 		actor->SetSimulationData(entity.GetComponent<RigidBodyComponent>().Layer);
 
+		// The blended pose is written into this every frame the body moves, it stays for as long as the body does
+		if (mInterpolateTransforms && actor->IsDynamic() && !entity.HasComponent<InterpolatedTransformComponent>())
+		{
+			entity.AddComponent<InterpolatedTransformComponent>();
+		}
+
 		mActors.push_back(actor);
+		mActorMap[entity.GetID()] = actor;
 		mPhysicsScene->addActor(*actor->mRigidActor);
 
 		return actor;
@@ -221,10 +305,12 @@ namespace NR
 			collider->Release();
 		}
 
+		actor->ClearInterpolatedTransform();
 		mPhysicsScene->removeActor(*actor->mRigidActor);
 		actor->mRigidActor->release();
 		actor->mRigidActor = nullptr;
 
+		mActorMap.erase(actor->GetEntity().GetID());
 		for (auto it = mActors.begin(); it != mActors.end(); it++)
 		{
 			if ((*it)->GetEntity() == actor->GetEntity())
@@ -237,13 +323,8 @@ namespace NR
 
 	Ref<PhysicsController> PhysicsScene::GetController(Entity entity)
 	{
-		for (auto& controller : mControllers)
-		{
-			if (controller->GetEntity() == entity)
-				return controller;
-		}
-
-		return nullptr;
+		auto it = mControllerMap.find(entity.GetID());
+		return it != mControllerMap.end() ? it->second : nullptr;
 	}
 
 	Ref<PhysicsController> PhysicsScene::CreateController(Entity entity)
@@ -320,6 +401,7 @@ namespace NR
 		controller->SetSimulationData(entity.GetComponent<CharacterControllerComponent>().Layer);
 
 		mControllers.push_back(controller);
+		mControllerMap[entity.GetID()] = controller;
 		return controller;
 	}
 
@@ -333,6 +415,7 @@ namespace NR
 		controller->mController->release();
 		controller->mController = nullptr;
 
+		mControllerMap.erase(controller->GetEntity().GetID());
 		for (auto it = mControllers.begin(); it != mControllers.end(); it++)
 		{
 			if ((*it)->GetEntity() == controller->GetEntity())
@@ -345,15 +428,8 @@ namespace NR
 
 	Ref<JointBase> PhysicsScene::GetJoint(Entity entity)
 	{
-		for (auto& joint : mJoints)
-		{
-			if (joint->GetEntity() == entity)
-			{
-				return joint;
-			}
-		}
-
-		return nullptr;
+		auto it = mJointMap.find(entity.GetID());
+		return it != mJointMap.end() ? it->second : nullptr;
 	}
 
 	Ref<JointBase> PhysicsScene::CreateJoint(Entity entity)
@@ -381,6 +457,7 @@ namespace NR
 		}
 
 		mJoints.push_back(joint);
+		mJointMap[entity.GetID()] = joint;
 		return joint;
 	}
 
@@ -393,6 +470,7 @@ namespace NR
 
 		joint->Release();
 
+		mJointMap.erase(joint->GetEntity().GetID());
 		for (auto it = mJoints.begin(); it != mJoints.end(); it++)
 		{
 			if ((*it)->GetEntity() == joint->GetEntity())
@@ -720,24 +798,34 @@ namespace NR
 	{
 		NR_CORE_ASSERT(mPhysicsScene);
 
-		for (auto& joint : mJoints)
+		// The Remove functions erase from these lists, so they can't be iterated directly
+		for (auto joint : std::vector<Ref<JointBase>>(mJoints))
 		{
 			RemoveJoint(joint);
 		}
 
-		for (auto& controller : mControllers)
+		for (auto controller : std::vector<Ref<PhysicsController>>(mControllers))
 		{
 			RemoveController(controller);
 		}
 
-		for (auto& actor : mActors)
+		for (auto actor : std::vector<Ref<PhysicsActor>>(mActors))
 		{
 			RemoveActor(actor);
 		}
 
+		mJoints.clear();
 		mControllers.clear();
 		mActors.clear();
 
+		mJointMap.clear();
+		mControllerMap.clear();
+		mActorMap.clear();
+
+		mInterpolatedActors.clear();
+
+		mContactListener.ClearEvents();
+
 		mEntityScene = nullptr;
 	}
 
@@ -8,6 +8,8 @@
 #include "PhysicsActor.h"
 #include "PhysicsController.h"
 #include "PhysicsJoints.h"
+#include "PhysicsJobDispatcher.h"
+#include "ContactListener.h"
 
 namespace NR
 {
@@ -53,6 +55,8 @@ namespace NR
 		void RemoveJoint(Ref<JointBase> joint);
 		const std::vector<Ref<JointBase>>& GetJoints() const { return mJoints; }
 
+		bool IsInterpolatingTransforms() const { return mInterpolateTransforms; }
+
 		glm::vec3 GetGravity() const { return PhysicsUtils::FromPhysicsVector(mPhysicsScene->getGravity()); }
 		void SetGravity(const glm::vec3& gravity) { mPhysicsScene->setGravity(PhysicsUtils::ToPhysicsVector(gravity)); }
 
@@ -70,8 +74,10 @@ namespace NR
 
 		void ImGuiRender(bool& show);
 
-	private:
+		// Creates the actors, controllers and joints of the scene's entities, Scene::RuntimeStart calls it when the scene starts playing
 		void InitializeScene(const Ref<Scene>& scene);
+
+	private:
 		void Clear();
 
 		void CreateRegions();
@@ -79,6 +85,9 @@ namespace NR
 		bool Advance(float dt);
 		void SubstepStrategy(float dt);
 
+		void StoreActivePoses();
+		void InterpolateTransforms();
+
 		bool OverlapGeometry(const glm::vec3& origin, const physx::PxGeometry& geometry, std::array<OverlapHit, OVERLAP_MAX_COLLIDERS>& buffer, uint32_t& count);
 
 	private:
@@ -86,10 +95,27 @@ namespace NR
 		physx::PxScene* mPhysicsScene;
 		physx::PxControllerManager* mPhysicsControllerManager;
 
+		// Only one of them is used, depending on PhysicsSettings::UseJobSystem
+		PhysicsJobDispatcher mJobDispatcher;
+		physx::PxDefaultCpuDispatcher* mDefaultDispatcher = nullptr;
+
+		ContactListener mContactListener;
+
 		std::vector<Ref<PhysicsActor>> mActors;
 		std::vector<Ref<PhysicsController>> mControllers;
 		std::vector<Ref<JointBase>> mJoints;
 
+		// Keyed by entity ID, so scripts looking up their actor don't walk the lists above
+		std::unordered_map<UUID, Ref<PhysicsActor>> mActorMap;
+		std::unordered_map<UUID, Ref<PhysicsController>> mControllerMap;
+		std::unordered_map<UUID, Ref<JointBase>> mJointMap;
+
+		// Blends the transforms of moving actors between their last two substep poses, so rendering doesn't stutter
+		// when the frame rate and the fixed step don't line up
+		bool mInterpolateTransforms = false;
+		std::vector<Ref<PhysicsActor>> mInterpolatedActors;
+		uint64_t mStepCount = 0;
+
 		float mSubStepSize;
 		float mAccumulator = 0.0f;
 		uint32_t mNumSubSteps = 0;
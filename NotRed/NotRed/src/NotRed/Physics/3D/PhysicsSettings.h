@@ -30,6 +30,15 @@ namespace NR
 		uint32_t SolverIterations = 8;
 		uint32_t SolverVelocityIterations = 2;
 
+		// 0 uses one worker per hardware thread besides the main thread
+		uint32_t WorkerThreadCount = 0;
+
+		// Runs the simulation tasks on the engine's JobSystem instead of a PhysX owned thread pool
+		bool UseJobSystem = true;
+
+		// Renders moving bodies between their last two fixed step poses instead of snapping to the latest one
+		bool InterpolateTransforms = false;
+
 #ifdef NR_DEBUG
 		bool DebugOnPlay = true;
 		DebugType DebugType = DebugType::LiveDebug;
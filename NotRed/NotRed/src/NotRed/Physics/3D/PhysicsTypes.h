@@ -27,6 +27,15 @@ namespace NR
 		Failure
 	};
 
+	// Passed to scripts as int, has to match NR.ContactEventType
+	enum class ContactType : int32_t
+	{
+		CollisionBegin,
+		CollisionEnd,
+		TriggerBegin,
+		TriggerEnd
+	};
+
 	enum class ForceMode : uint8_t
 	{
 		Force,
@@ -1,6 +1,8 @@
 #include "nrpch.h"
 #include "VKImGuiLayer.h"
 
+#include <deque>
+
 #include <GLFW/glfw3.h>
 
 #include "imgui.h"
@@ -22,6 +24,83 @@ namespace NR
 {
     static std::vector<VkCommandBuffer> sImGuiCommandBuffers;
 
+    struct DeferredTexture
+    {
+        std::function<VkDescriptorImageInfo()> GetImageInfo;
+    };
+
+    // Set while ImGui is built on the main thread, the textures it draws are collected instead of allocating their
+    // descriptor sets from the render thread's per-frame pools. Their IDs point at the collected entries.
+    static bool sDeferTextures = false;
+    static std::deque<DeferredTexture> sDeferredTextures;
+
+    // Copy of one frame's draw data for the render thread, the ImGui context rebuilds its draw lists with the next frame
+    struct ImGuiFrame : public RefCounted
+    {
+        ImDrawData DrawData;
+        ImVector<ImDrawList*> DrawLists;
+        std::deque<DeferredTexture> Textures;
+        ImTextureID FontTextureID;
+
+        ImGuiFrame(const ImDrawData* drawData)
+            : DrawData(*drawData), FontTextureID(ImGui::GetIO().Fonts->TexID)
+        {
+            DrawLists.resize(drawData->CmdListsCount);
+            for (int i = 0; i < drawData->CmdListsCount; ++i)
+            {
+                DrawLists[i] = drawData->CmdLists[i]->CloneOutput();
+            }
+
+            // The main viewport stays, its render buffers are only used by the render thread
+            DrawData.CmdLists = DrawLists.Data;
+        }
+
+        ~ImGuiFrame()
+        {
+            for (ImDrawList* drawList : DrawLists)
+            {
+                IM_DELETE(drawList);
+            }
+        }
+
+        // Runs on the render thread, replaces the IDs of the collected textures with this frame's descriptor sets
+        void ResolveTextures()
+        {
+            if (Textures.empty())
+            {
+                return;
+            }
+
+            // Images without a view (e.g. released since the frame was built) aren't drawn, their commands keep a valid
+            // descriptor set bound but draw nothing
+            std::unordered_map<ImTextureID, ImTextureID> descriptorSets;
+            descriptorSets.reserve(Textures.size());
+            for (const DeferredTexture& texture : Textures)
+            {
+                const VkDescriptorImageInfo imageInfo = texture.GetImageInfo();
+                descriptorSets[(ImTextureID)&texture] = imageInfo.imageView ? ImGui_ImplVulkan_AddTexture(imageInfo.sampler, imageInfo.imageView, imageInfo.imageLayout) : nullptr;
+            }
+
+            for (ImDrawList* drawList : DrawLists)
+            {
+                for (ImDrawCmd& command : drawList->CmdBuffer)
+                {
+                    auto it = descriptorSets.find(command.TextureId);
+                    if (it != descriptorSets.end())
+                    {
+                        command.TextureId = it->second ? it->second : FontTextureID;
+                        command.ElemCount = it->second ? command.ElemCount : 0;
+                    }
+                }
+            }
+        }
+    };
+
+    static bool IsImGuiBuiltOnMainThread()
+    {
+        return Application::Get().GetRenderThread().GetPolicy() == ThreadingPolicy::MultiThreaded;
+    }
+
     VKImGuiLayer::VKImGuiLayer()
     {
     }
@@ -44,7 +123,11 @@ namespace NR
         io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;       // Enable Keyboard Controls
         //io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
         io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
-        io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;         // Enable Multi-Viewport / Platform Windows
+        // Platform windows are created and drawn by ImGui in one go, which can't be split between the main and the render thread
+        if (!IsImGuiBuiltOnMainThread())
+        {
+            io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;     // Enable Multi-Viewport / Platform Windows
+        }
         io.FontGlobalScale = 1.0f;  								// Set Global font size
         //io.ConfigViewportsNoAutoMerge = true;
         //io.ConfigViewportsNoTaskBarIcon = true;
@@ -169,12 +252,13 @@ namespace NR
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
         ImGuizmo::BeginFrame();
+
+        sDeferTextures = IsImGuiBuiltOnMainThread();
     }
 
-    void VKImGuiLayer::End()
+    // Records the main viewport's draw data into the swap chain's command buffer
+    static void RenderDrawData(ImDrawData* drawData)
     {
-        ImGui::Render();
-
         VKSwapChain& swapChain = Application::Get().GetWindow().GetSwapChain();
 
         VkClearValue clearValues[2];
@@ -235,8 +319,7 @@ namespace NR
         scissor.offset.y = 0;
         vkCmdSetScissor(sImGuiCommandBuffers[commandBufferIndex], 0, 1, &scissor);
 
-        ImDrawData* main_draw_data = ImGui::GetDrawData();
-        ImGui_ImplVulkan_RenderDrawData(main_draw_data, sImGuiCommandBuffers[commandBufferIndex]);
+        ImGui_ImplVulkan_RenderDrawData(drawData, sImGuiCommandBuffers[commandBufferIndex]);
 
         VK_CHECK_RESULT(vkEndCommandBuffer(sImGuiCommandBuffers[commandBufferIndex]));
 
@@ -248,6 +331,29 @@ namespace NR
         vkCmdEndRenderPass(drawCommandBuffer);
 
         VK_CHECK_RESULT(vkEndCommandBuffer(drawCommandBuffer));
+    }
+
+    void VKImGuiLayer::End()
+    {
+        ImGui::Render();
+
+        if (sDeferTextures)
+        {
+            sDeferTextures = false;
+
+            Ref<ImGuiFrame> frame = Ref<ImGuiFrame>::Create(ImGui::GetDrawData());
+            frame->Textures = std::move(sDeferredTextures);
+            sDeferredTextures.clear();
+
+            Renderer::Submit([frame]()
+                {
+                    frame->ResolveTextures();
+                    RenderDrawData(&frame->DrawData);
+                });
+            return;
+        }
+
+        RenderDrawData(ImGui::GetDrawData());
 
         ImGuiIO& io = ImGui::GetIO(); (void)io;
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
@@ -261,4 +367,16 @@ namespace NR
     {
     }
 
+    ImTextureID VKImGuiLayer::AddTexture(std::function<VkDescriptorImageInfo()> getImageInfo)
+    {
+        if (!sDeferTextures)
+        {
+            const VkDescriptorImageInfo imageInfo = getImageInfo();
+            return ImGui_ImplVulkan_AddTexture(imageInfo.sampler, imageInfo.imageView, imageInfo.imageLayout);
+        }
+
+        DeferredTexture& texture = sDeferredTextures.emplace_back(DeferredTexture{ std::move(getImageInfo) });
+        return (ImTextureID)&texture;
+    }
+
 }
\ No newline at end of file
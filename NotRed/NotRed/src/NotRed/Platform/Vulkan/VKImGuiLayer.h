@@ -1,5 +1,11 @@
 #pragma once
 
+#include <functional>
+
+#include <imgui.h>
+
+#include "vulkan/vulkan.h"
+
 #include "NotRed/ImGui/ImGuiLayer.h"
 #include "NotRed/Renderer/RenderCommandBuffer.h"
 
@@ -19,6 +25,10 @@ namespace NR
 		void Detach() override;
 		void ImGuiRender() override;
 
+		// Texture ID for an image drawn by ImGui this frame. While ImGui is built on the main thread the image info is
+		// only read, and the descriptor set allocated, once the render thread draws the frame.
+		static ImTextureID AddTexture(std::function<VkDescriptorImageInfo()> getImageInfo);
+
 	private:
 		Ref<RenderCommandBuffer> mRenderCommandBuffer;
 	};
@@ -36,13 +36,19 @@ namespace NR
         auto vulkanMaterial = material.As<VKMaterial>();
 
         mUniformStorageBuffer = Buffer::Copy(vulkanMaterial->mUniformStorageBuffer.Data, vulkanMaterial->mUniformStorageBuffer.Size);
-        mResidentDescriptors = vulkanMaterial->mResidentDescriptors;
-        mResidentDescriptorArrays = vulkanMaterial->mResidentDescriptorArrays;
-        mPendingDescriptors = vulkanMaterial->mPendingDescriptors;
         mTextures = vulkanMaterial->mTextures;
         mTextureArrays = vulkanMaterial->mTextureArrays;
         mImages = vulkanMaterial->mImages;
         mImageHashes = vulkanMaterial->mImageHashes;
+
+        // The descriptors are owned by the render thread, which can still be using the source material's
+        Ref<VKMaterial> instance = this;
+        Renderer::Submit([instance, vulkanMaterial]() mutable
+            {
+                instance->mResidentDescriptors = vulkanMaterial->mResidentDescriptors;
+                instance->mResidentDescriptorArrays = vulkanMaterial->mResidentDescriptorArrays;
+                instance->mPendingDescriptors = vulkanMaterial->mPendingDescriptors;
+            });
     }
      
     VKMaterial::~VKMaterial()
@@ -109,39 +115,49 @@ namespace NR
         AllocateStorage();
     }
 
-    const ShaderUniform* VKMaterial::FindUniformDeclaration(const std::string& name)
+    const ShaderUniform* VKMaterial::FindUniformDeclaration(MaterialPropertyID id)
     {
-        const auto& shaderBuffers = mShader->GetShaderBuffers();
-
-        NR_CORE_ASSERT(shaderBuffers.size() <= 1, "We currently only support ONE material buffer!");
+        NR_CORE_ASSERT(mShader->GetShaderBuffers().size() <= 1, "We currently only support ONE material buffer!");
+        return mShader.As<VKShader>()->FindUniform(id);
+    }
 
-        if (shaderBuffers.size() > 0)
+    MaterialUniformHandle VKMaterial::GetUniformHandle(MaterialPropertyID id)
+    {
+        const ShaderUniform* decl = FindUniformDeclaration(id);
+        if (!decl)
         {
-            const ShaderBuffer& buffer = (*shaderBuffers.begin()).second;
-            if (buffer.Uniforms.find(name) == buffer.Uniforms.end())
-            {
-                return nullptr;
-            }
-
-            return &buffer.Uniforms.at(name);
+            return {};
         }
-        return nullptr;
+
+        return { decl->GetOffset(), decl->GetSize() };
     }
 
-    const ShaderResourceDeclaration* VKMaterial::FindResourceDeclaration(const std::string& name)
+    void VKMaterial::SetUniformData(const MaterialUniformHandle& handle, const void* data, uint32_t size)
     {
-        auto& resources = mShader->GetResources();
-        for (const auto& [n, resource] : resources)
+        if (!handle.IsValid())
+        {
+            return;
+        }
+
+        // Never read past the value or write past the storage, whatever the reflected size says
+        size = std::min(size, handle.Size);
+        if (handle.Offset + size > mUniformStorageBuffer.Size)
         {
-            if (resource.GetName() == name)
-                return &resource;
+            NR_CORE_ASSERT(false, "Uniform is outside of the material's storage!");
+            return;
         }
-        return nullptr;
+
+        memcpy((byte*)mUniformStorageBuffer.Data + handle.Offset, data, size);
+    }
+
+    const ShaderResourceDeclaration* VKMaterial::FindResourceDeclaration(MaterialPropertyID id)
+    {
+        return mShader.As<VKShader>()->FindResource(id);
     }
 
-    void VKMaterial::SetVulkanDescriptor(const std::string& name, const Ref<Texture2D>& texture, uint32_t arrayIndex)
+    void VKMaterial::SetVulkanDescriptor(MaterialPropertyID id, const Ref<Texture2D>& texture, uint32_t arrayIndex)
     {
-        const ShaderResourceDeclaration* resource = FindResourceDeclaration(name);
+        const ShaderResourceDeclaration* resource = FindResourceDeclaration(id);
         NR_CORE_ASSERT(resource);
 
         uint32_t binding = resource->GetRegister();
@@ -162,28 +178,32 @@ namespace NR
         }
 
         mTextureArrays[binding][arrayIndex] = texture;
-        const VkWriteDescriptorSet* wds = mShader.As<VKShader>()->GetDescriptorSet(name);
+        const VkWriteDescriptorSet* wds = mShader.As<VKShader>()->GetDescriptorSet(id);
         NR_CORE_ASSERT(wds);
 
-        if (mResidentDescriptorArrays.find(binding) == mResidentDescriptorArrays.end())
-        {
-            mResidentDescriptorArrays[binding] = std::make_shared<PendingDescriptorArray>(PendingDescriptorArray{ PendingDescriptorType::Texture2D, *wds, {}, {}, {} });
-        }
+        Ref<VKMaterial> instance = this;
+        Renderer::Submit([instance, binding, arrayIndex, wds = *wds, texture]() mutable
+            {
+                if (instance->mResidentDescriptorArrays.find(binding) == instance->mResidentDescriptorArrays.end())
+                {
+                    instance->mResidentDescriptorArrays[binding] = std::make_shared<PendingDescriptorArray>(PendingDescriptorArray{ PendingDescriptorType::Texture2D, wds, {}, {}, {} });
+                }
 
-        auto& residentDesriptorArray = mResidentDescriptorArrays.at(binding);
-        if (arrayIndex >= residentDesriptorArray->Textures.size())
-        {
-            residentDesriptorArray->Textures.resize(arrayIndex + 1);
-        }
+                auto& residentDesriptorArray = instance->mResidentDescriptorArrays.at(binding);
+                if (arrayIndex >= residentDesriptorArray->Textures.size())
+                {
+                    residentDesriptorArray->Textures.resize(arrayIndex + 1);
+                }
+
+                residentDesriptorArray->Textures[arrayIndex] = texture;
 
-        residentDesriptorArray->Textures[arrayIndex] = texture;
-        
-        InvalidateDescriptorSets();
+                instance->InvalidateDescriptorSets();
+            });
     }
 
-    void VKMaterial::SetVulkanDescriptor(const std::string& name, const Ref<TextureCube>& texture)
+    void VKMaterial::SetVulkanDescriptor(MaterialPropertyID id, const Ref<TextureCube>& texture)
     {
-        const ShaderResourceDeclaration* resource = FindResourceDeclaration(name);
+        const ShaderResourceDeclaration* resource = FindResourceDeclaration(id);
         NR_CORE_ASSERT(resource);
 
         uint32_t binding = resource->GetRegister();
@@ -198,17 +218,22 @@ namespace NR
         }
         mTextures[binding] = texture;
 
-        const VkWriteDescriptorSet* wds = mShader.As<VKShader>()->GetDescriptorSet(name);
+        const VkWriteDescriptorSet* wds = mShader.As<VKShader>()->GetDescriptorSet(id);
         NR_CORE_ASSERT(wds);
-        mResidentDescriptors[binding] = std::make_shared<PendingDescriptor>(PendingDescriptor{ PendingDescriptorType::TextureCube, *wds, {}, texture.As<Texture>(), nullptr });
-        mPendingDescriptors.push_back(mResidentDescriptors.at(binding));
-        
-        InvalidateDescriptorSets();
+
+        Ref<VKMaterial> instance = this;
+        Renderer::Submit([instance, binding, wds = *wds, texture]() mutable
+            {
+                instance->mResidentDescriptors[binding] = std::make_shared<PendingDescriptor>(PendingDescriptor{ PendingDescriptorType::TextureCube, wds, {}, texture.As<Texture>(), nullptr });
+                instance->mPendingDescriptors.push_back(instance->mResidentDescriptors.at(binding));
+
+                instance->InvalidateDescriptorSets();
+            });
     }
 
-    void VKMaterial::SetVulkanDescriptor(const std::string& name, const Ref<Image2D>& image)
+    void VKMaterial::SetVulkanDescriptor(MaterialPropertyID id, const Ref<Image2D>& image)
     {
-        const ShaderResourceDeclaration* resource = FindResourceDeclaration(name);
+        const ShaderResourceDeclaration* resource = FindResourceDeclaration(id);
         NR_CORE_ASSERT(resource);
 
         uint32_t binding = resource->GetRegister();
@@ -224,17 +249,22 @@ namespace NR
         mImages[resource->GetRegister()] = image;
         mImageHashes[resource->GetRegister()] = image->GetHash();
 
-        const VkWriteDescriptorSet* wds = mShader.As<VKShader>()->GetDescriptorSet(name);
+        const VkWriteDescriptorSet* wds = mShader.As<VKShader>()->GetDescriptorSet(id);
         NR_CORE_ASSERT(wds);
-        mResidentDescriptors[binding] = std::make_shared<PendingDescriptor>(PendingDescriptor{ PendingDescriptorType::Image2D, *wds, {}, nullptr, image.As<Image>() });
-        mPendingDescriptors.push_back(mResidentDescriptors.at(binding));
-        
-        InvalidateDescriptorSets();
+
+        Ref<VKMaterial> instance = this;
+        Renderer::Submit([instance, binding, wds = *wds, image]() mutable
+            {
+                instance->mResidentDescriptors[binding] = std::make_shared<PendingDescriptor>(PendingDescriptor{ PendingDescriptorType::Image2D, wds, {}, nullptr, image.As<Image>() });
+                instance->mPendingDescriptors.push_back(instance->mResidentDescriptors.at(binding));
+
+                instance->InvalidateDescriptorSets();
+            });
     }
 
-    void VKMaterial::SetVulkanDescriptor(const std::string& name, const Ref<Texture2D>& texture)
+    void VKMaterial::SetVulkanDescriptor(MaterialPropertyID id, const Ref<Texture2D>& texture)
     {
-        const ShaderResourceDeclaration* resource = FindResourceDeclaration(name);
+        const ShaderResourceDeclaration* resource = FindResourceDeclaration(id);
         NR_CORE_ASSERT(resource);
 
         uint32_t binding = resource->GetRegister();
@@ -249,157 +279,162 @@ namespace NR
         }
         mTextures[binding] = texture;
 
-        const VkWriteDescriptorSet* wds = mShader.As<VKShader>()->GetDescriptorSet(name);
+        const VkWriteDescriptorSet* wds = mShader.As<VKShader>()->GetDescriptorSet(id);
         NR_CORE_ASSERT(wds);
-        mResidentDescriptors[binding] = std::make_shared<PendingDescriptor>(PendingDescriptor{ PendingDescriptorType::Texture2D, *wds, {}, texture.As<Texture>(), nullptr });
-        mPendingDescriptors.push_back(mResidentDescriptors.at(binding));
 
-        InvalidateDescriptorSets();
+        Ref<VKMaterial> instance = this;
+        Renderer::Submit([instance, binding, wds = *wds, texture]() mutable
+            {
+                instance->mResidentDescriptors[binding] = std::make_shared<PendingDescriptor>(PendingDescriptor{ PendingDescriptorType::Texture2D, wds, {}, texture.As<Texture>(), nullptr });
+                instance->mPendingDescriptors.push_back(instance->mResidentDescriptors.at(binding));
+
+                instance->InvalidateDescriptorSets();
+            });
     }
 
-    void VKMaterial::Set(const std::string& name, uint32_t value)
+    void VKMaterial::Set(MaterialPropertyID id, uint32_t value)
     {
-        Set<uint32_t>(name, value);
+        Set<uint32_t>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, bool value)
+    void VKMaterial::Set(MaterialPropertyID id, bool value)
     {
-        Set<int>(name, (int)value);
+        Set<int>(id, (int)value);
     }
 
-    void VKMaterial::Set(const std::string& name, int value)
+    void VKMaterial::Set(MaterialPropertyID id, int value)
     {
-        Set<int>(name, value);
+        Set<int>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, float value)
+    void VKMaterial::Set(MaterialPropertyID id, float value)
     {
-        Set<float>(name, value);
+        Set<float>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, const glm::ivec2& value)
+    void VKMaterial::Set(MaterialPropertyID id, const glm::ivec2& value)
     {
-        Set<glm::ivec2>(name, value);
+        Set<glm::ivec2>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, const glm::ivec3& value)
+    void VKMaterial::Set(MaterialPropertyID id, const glm::ivec3& value)
     {
-        Set<glm::ivec3>(name, value);
+        Set<glm::ivec3>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, const glm::ivec4& value)
+    void VKMaterial::Set(MaterialPropertyID id, const glm::ivec4& value)
     {
-        Set<glm::ivec4>(name, value);
+        Set<glm::ivec4>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, const glm::vec2& value)
+    void VKMaterial::Set(MaterialPropertyID id, const glm::vec2& value)
     {
-        Set<glm::vec2>(name, value);
+        Set<glm::vec2>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, const glm::vec3& value)
+    void VKMaterial::Set(MaterialPropertyID id, const glm::vec3& value)
     {
-        Set<glm::vec3>(name, value);
+        Set<glm::vec3>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, const glm::vec4& value)
+    void VKMaterial::Set(MaterialPropertyID id, const glm::vec4& value)
     {
-        Set<glm::vec4>(name, value);
+        Set<glm::vec4>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, const glm::mat3& value)
+    void VKMaterial::Set(MaterialPropertyID id, const glm::mat3& value)
     {
-        Set<glm::mat3>(name, value);
+        Set<glm::mat3>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, const glm::mat4& value)
+    void VKMaterial::Set(MaterialPropertyID id, const glm::mat4& value)
     {
-        Set<glm::mat4>(name, value);
+        Set<glm::mat4>(id, value);
     }
 
-    void VKMaterial::Set(const std::string& name, const Ref<Texture2D>& texture)
+    void VKMaterial::Set(MaterialPropertyID id, const Ref<Texture2D>& texture)
     {
-        SetVulkanDescriptor(name, texture);
+        SetVulkanDescriptor(id, texture);
     }
 
-    void VKMaterial::Set(const std::string& name, const Ref<TextureCube>& texture)
+    void VKMaterial::Set(MaterialPropertyID id, const Ref<TextureCube>& texture)
     {
-        SetVulkanDescriptor(name, texture);
+        SetVulkanDescriptor(id, texture);
     }
 
-    void VKMaterial::Set(const std::string& name, const Ref<Image2D>& image)
+    void VKMaterial::Set(MaterialPropertyID id, const Ref<Image2D>& image)
     {
-        SetVulkanDescriptor(name, image);
+        SetVulkanDescriptor(id, image);
     }
 
-    void VKMaterial::Set(const std::string& name, const Ref<Texture2D>& texture, uint32_t arrayIndex)
+    void VKMaterial::Set(MaterialPropertyID id, const Ref<Texture2D>& texture, uint32_t arrayIndex)
     {
-        SetVulkanDescriptor(name, texture, arrayIndex);
+        SetVulkanDescriptor(id, texture, arrayIndex);
     }
 
-    uint32_t& VKMaterial::GetUInt(const std::string& name)
+    uint32_t& VKMaterial::GetUInt(MaterialPropertyID id)
     {
-        return Get<uint32_t>(name);
+        return Get<uint32_t>(id);
     }
 
-    int32_t& VKMaterial::GetInt(const std::string& name)
+    int32_t& VKMaterial::GetInt(MaterialPropertyID id)
     {
-        return Get<int32_t>(name);
+        return Get<int32_t>(id);
     }
 
-    bool& VKMaterial::GetBool(const std::string& name)
+    bool& VKMaterial::GetBool(MaterialPropertyID id)
     {
-        return Get<bool>(name);
+        return Get<bool>(id);
     }
 
-    float& VKMaterial::GetFloat(const std::string& name)
+    float& VKMaterial::GetFloat(MaterialPropertyID id)
     {
-        return Get<float>(name);
+        return Get<float>(id);
     }
 
-    glm::vec2& VKMaterial::GetVector2(const std::string& name)
+    glm::vec2& VKMaterial::GetVector2(MaterialPropertyID id)
     {
-        return Get<glm::vec2>(name);
+        return Get<glm::vec2>(id);
     }
 
-    glm::vec3& VKMaterial::GetVector3(const std::string& name)
+    glm::vec3& VKMaterial::GetVector3(MaterialPropertyID id)
     {
-        return Get<glm::vec3>(name);
+        return Get<glm::vec3>(id);
     }
 
-    glm::vec4& VKMaterial::GetVector4(const std::string& name)
+    glm::vec4& VKMaterial::GetVector4(MaterialPropertyID id)
     {
-        return Get<glm::vec4>(name);
+        return Get<glm::vec4>(id);
     }
 
-    glm::mat3& VKMaterial::GetMatrix3(const std::string& name)
+    glm::mat3& VKMaterial::GetMatrix3(MaterialPropertyID id)
     {
-        return Get<glm::mat3>(name);
+        return Get<glm::mat3>(id);
     }
 
-    glm::mat4& VKMaterial::GetMatrix4(const std::string& name)
+    glm::mat4& VKMaterial::GetMatrix4(MaterialPropertyID id)
     {
-        return Get<glm::mat4>(name);
+        return Get<glm::mat4>(id);
     }
 
-    Ref<Texture2D> VKMaterial::GetTexture2D(const std::string& name)
+    Ref<Texture2D> VKMaterial::GetTexture2D(MaterialPropertyID id)
     {
-        return GetResource<Texture2D>(name);
+        return GetResource<Texture2D>(id);
     }
 
-    Ref<TextureCube> VKMaterial::TryGetTextureCube(const std::string& name)
+    Ref<TextureCube> VKMaterial::TryGetTextureCube(MaterialPropertyID id)
     {
-        return TryGetResource<TextureCube>(name);
+        return TryGetResource<TextureCube>(id);
     }
 
-    Ref<Texture2D> VKMaterial::TryGetTexture2D(const std::string& name)
+    Ref<Texture2D> VKMaterial::TryGetTexture2D(MaterialPropertyID id)
     {
-        return TryGetResource<Texture2D>(name);
+        return TryGetResource<Texture2D>(id);
     }
 
-    Ref<TextureCube> VKMaterial::GetTextureCube(const std::string& name)
+    Ref<TextureCube> VKMaterial::GetTextureCube(MaterialPropertyID id)
     {
-        return GetResource<TextureCube>(name);
+        return GetResource<TextureCube>(id);
     }
 
     void VKMaterial::RT_UpdateForRendering(const std::vector<std::vector<VkWriteDescriptorSet>>& uniformBufferWriteDescriptors)
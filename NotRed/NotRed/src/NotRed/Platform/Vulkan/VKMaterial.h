@@ -15,67 +15,80 @@ namespace NR
 
         void Invalidate() override;
 
-        void Set(const std::string& name, uint32_t value) override;
-        void Set(const std::string& name, bool value) override;
-        void Set(const std::string& name, int value) override;
-        void Set(const std::string& name, float value) override;
-        void Set(const std::string& name, const glm::ivec2& value) override;
-        void Set(const std::string& name, const glm::ivec3& value) override;
-        void Set(const std::string& name, const glm::ivec4& value) override;
-        void Set(const std::string& name, const glm::vec2& value) override;
-        void Set(const std::string& name, const glm::vec3& value) override;
-        void Set(const std::string& name, const glm::vec4& value) override;
-        void Set(const std::string& name, const glm::mat3& value) override;
-        void Set(const std::string& name, const glm::mat4& value) override;
-
-        void Set(const std::string& name, const Ref<Texture2D>& texture) override;
-        void Set(const std::string& name, const Ref<TextureCube>& texture) override;
-        void Set(const std::string& name, const Ref<Image2D>& image) override;
-        void Set(const std::string& name, const Ref<Texture2D>& texture, uint32_t arrayIndex) override;
-
-        uint32_t& GetUInt(const std::string& name) override;
-        bool& GetBool(const std::string& name) override;
-        int32_t& GetInt(const std::string& name) override;
-        float& GetFloat(const std::string& name) override;
-        glm::vec2& GetVector2(const std::string& name) override;
-        glm::vec3& GetVector3(const std::string& name) override;
-        glm::vec4& GetVector4(const std::string& name) override;
-        glm::mat3& GetMatrix3(const std::string& name) override;
-        glm::mat4& GetMatrix4(const std::string& name) override;
-
-        Ref<Texture2D> GetTexture2D(const std::string& name) override;
-        Ref<TextureCube> GetTextureCube(const std::string& name) override;
-
-        Ref<Texture2D> TryGetTexture2D(const std::string& name) override;
-        Ref<TextureCube> TryGetTextureCube(const std::string& name) override;
+        // Keep the name based wrappers from Material visible next to the overrides
+        using Material::Set;
+        using Material::GetUInt;
+        using Material::GetBool;
+        using Material::GetInt;
+        using Material::GetFloat;
+        using Material::GetVector2;
+        using Material::GetVector3;
+        using Material::GetVector4;
+        using Material::GetMatrix3;
+        using Material::GetMatrix4;
+        using Material::GetTexture2D;
+        using Material::GetTextureCube;
+        using Material::TryGetTexture2D;
+        using Material::TryGetTextureCube;
+
+        MaterialUniformHandle GetUniformHandle(MaterialPropertyID id) override;
+        void SetUniformData(const MaterialUniformHandle& handle, const void* data, uint32_t size) override;
+
+        void Set(MaterialPropertyID id, uint32_t value) override;
+        void Set(MaterialPropertyID id, bool value) override;
+        void Set(MaterialPropertyID id, int value) override;
+        void Set(MaterialPropertyID id, float value) override;
+        void Set(MaterialPropertyID id, const glm::ivec2& value) override;
+        void Set(MaterialPropertyID id, const glm::ivec3& value) override;
+        void Set(MaterialPropertyID id, const glm::ivec4& value) override;
+        void Set(MaterialPropertyID id, const glm::vec2& value) override;
+        void Set(MaterialPropertyID id, const glm::vec3& value) override;
+        void Set(MaterialPropertyID id, const glm::vec4& value) override;
+        void Set(MaterialPropertyID id, const glm::mat3& value) override;
+        void Set(MaterialPropertyID id, const glm::mat4& value) override;
+
+        void Set(MaterialPropertyID id, const Ref<Texture2D>& texture) override;
+        void Set(MaterialPropertyID id, const Ref<TextureCube>& texture) override;
+        void Set(MaterialPropertyID id, const Ref<Image2D>& image) override;
+        void Set(MaterialPropertyID id, const Ref<Texture2D>& texture, uint32_t arrayIndex) override;
+
+        uint32_t& GetUInt(MaterialPropertyID id) override;
+        bool& GetBool(MaterialPropertyID id) override;
+        int32_t& GetInt(MaterialPropertyID id) override;
+        float& GetFloat(MaterialPropertyID id) override;
+        glm::vec2& GetVector2(MaterialPropertyID id) override;
+        glm::vec3& GetVector3(MaterialPropertyID id) override;
+        glm::vec4& GetVector4(MaterialPropertyID id) override;
+        glm::mat3& GetMatrix3(MaterialPropertyID id) override;
+        glm::mat4& GetMatrix4(MaterialPropertyID id) override;
+
+        Ref<Texture2D> GetTexture2D(MaterialPropertyID id) override;
+        Ref<TextureCube> GetTextureCube(MaterialPropertyID id) override;
+
+        Ref<Texture2D> TryGetTexture2D(MaterialPropertyID id) override;
+        Ref<TextureCube> TryGetTextureCube(MaterialPropertyID id) override;
 
         template <typename T>
-        void Set(const std::string& name, const T& value)
+        void Set(MaterialPropertyID id, const T& value)
         {
-            auto decl = FindUniformDeclaration(name);
-            NR_CORE_ASSERT(decl, "Could not find uniform!");
-            if (!decl)
-            {
-                return;
-            }
-
-            auto& buffer = mUniformStorageBuffer;
-            buffer.Write((byte*)&value, decl->GetSize(), decl->GetOffset());
+            MaterialUniformHandle handle = GetUniformHandle(id);
+            NR_CORE_ASSERT(handle.IsValid(), "Could not find uniform!");
+            SetUniformData(handle, &value, (uint32_t)sizeof(T));
         }
 
         template<typename T>
-        T& Get(const std::string& name)
+        T& Get(MaterialPropertyID id)
         {
-            auto decl = FindUniformDeclaration(name);
+            auto decl = FindUniformDeclaration(id);
             NR_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
             auto& buffer = mUniformStorageBuffer;
             return buffer.Read<T>(decl->GetOffset());
         }
 
         template<typename T>
-        Ref<T> GetResource(const std::string& name)
+        Ref<T> GetResource(MaterialPropertyID id)
         {
-            auto decl = FindResourceDeclaration(name);
+            auto decl = FindResourceDeclaration(id);
             NR_CORE_ASSERT(decl, "Could not find uniform with name 'x'");
             uint32_t slot = decl->GetRegister();
             NR_CORE_ASSERT(slot < mTextures.size(), "Texture slot is invalid!");
@@ -83,9 +96,9 @@ namespace NR
         }
 
         template<typename T>
-        Ref<T> TryGetResource(const std::string& name)
+        Ref<T> TryGetResource(MaterialPropertyID id)
         {
-            auto decl = FindResourceDeclaration(name);
+            auto decl = FindResourceDeclaration(id);
             if (!decl)
             {
                 return nullptr;
@@ -129,13 +142,13 @@ namespace NR
         void AllocateStorage();
         void ShaderReloaded();
 
-        void SetVulkanDescriptor(const std::string& name, const Ref<Texture2D>& texture);
-        void SetVulkanDescriptor(const std::string& name, const Ref<TextureCube>& texture);
-        void SetVulkanDescriptor(const std::string& name, const Ref<Image2D>& image);
-        void SetVulkanDescriptor(const std::string& name, const Ref<Texture2D>& texture, uint32_t arrayIndex);
+        void SetVulkanDescriptor(MaterialPropertyID id, const Ref<Texture2D>& texture);
+        void SetVulkanDescriptor(MaterialPropertyID id, const Ref<TextureCube>& texture);
+        void SetVulkanDescriptor(MaterialPropertyID id, const Ref<Image2D>& image);
+        void SetVulkanDescriptor(MaterialPropertyID id, const Ref<Texture2D>& texture, uint32_t arrayIndex);
 
-        const ShaderUniform* FindUniformDeclaration(const std::string& name);
-        const ShaderResourceDeclaration* FindResourceDeclaration(const std::string& name);
+        const ShaderUniform* FindUniformDeclaration(MaterialPropertyID id);
+        const ShaderResourceDeclaration* FindResourceDeclaration(MaterialPropertyID id);
 
     private:
         enum class PendingDescriptorType
@@ -170,6 +183,7 @@ namespace NR
         Ref<Shader> mShader;
         std::string mName;
 
+        // Render thread only, the setters submit their changes
         std::unordered_map<uint32_t, std::shared_ptr<PendingDescriptor>> mResidentDescriptors;
         std::unordered_map<uint32_t, std::shared_ptr<PendingDescriptorArray>> mResidentDescriptorArrays;
         std::vector<std::shared_ptr<PendingDescriptor>> mPendingDescriptors;
@@ -281,6 +281,13 @@ namespace NR
 		}
 	}
 
+	// Frames can execute while the next one is recorded, so draws carry a copy of the material's uniforms from when they were submitted
+	static Buffer CopyUniformStorage(const Ref<VKMaterial>& material)
+	{
+		Buffer uniformStorageBuffer = material->GetUniformStorageBuffer();
+		return uniformStorageBuffer ? Buffer::Copy(uniformStorageBuffer.Data, uniformStorageBuffer.Size) : Buffer();
+	}
+
 	VkSampler VKRenderer::GetClampSampler()
 	{
 		if (sData->SamplerClamp)
@@ -316,13 +323,22 @@ namespace NR
 		NR_CORE_VERIFY(mesh);
 		NR_CORE_VERIFY(materialTable);
 
-		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, materialTable, transformBuffer, transformOffset, instanceCount]() mutable
+		// The material table can change while the render thread executes the frame, resolve the material now
+		const Submesh& drawnSubmesh = mesh->GetMeshSource()->GetSubmeshes()[submeshIndex];
+		Ref<MaterialAsset> material = materialTable->HasMaterial(drawnSubmesh.MaterialIndex) ? materialTable->GetMaterial(drawnSubmesh.MaterialIndex) : mesh->GetMaterials()->GetMaterial(drawnSubmesh.MaterialIndex);
+		Ref<VKMaterial> vulkanMaterial = material->GetMaterial().As<VKMaterial>();
+		Buffer uniformStorageBuffer = CopyUniformStorage(vulkanMaterial);
+
+		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, vulkanMaterial, uniformStorageBuffer, transformBuffer, transformOffset, instanceCount]() mutable
 			{
 				NR_PROFILE_FUNC("VKRenderer::RenderMesh");
 				NR_SCOPE_PERF("VKRenderer::RenderMesh");
 
 				if (sData->SelectedDrawCall != -1 && sData->DrawCallCount > sData->SelectedDrawCall)
+				{
+					uniformStorageBuffer.Release();
 					return;
+				}
 
 				uint32_t frameIndex = Renderer::GetCurrentFrameIndex();
 				VkCommandBuffer commandBuffer = renderCommandBuffer.As<VKRenderCommandBuffer>()->GetCommandBuffer(frameIndex);
@@ -350,14 +366,13 @@ namespace NR
 
 				const auto& submeshes = meshSource->GetSubmeshes();
 				const Submesh& submesh = submeshes[submeshIndex];
-				const auto& meshMaterialTable = mesh->GetMaterials();
-				uint32_t materialCount = meshMaterialTable->GetMaterialCount();
-				Ref<MaterialAsset> material = materialTable->HasMaterial(submesh.MaterialIndex) ? materialTable->GetMaterial(submesh.MaterialIndex) : meshMaterialTable->GetMaterial(submesh.MaterialIndex);
-				Ref<VKMaterial> vulkanMaterial = material->GetMaterial().As<VKMaterial>();
 				RT_UpdateMaterialForRendering(vulkanMaterial, uniformBufferSet, storageBufferSet);
 
 				if (sData->SelectedDrawCall != -1 && sData->DrawCallCount > sData->SelectedDrawCall)
+				{
+					uniformStorageBuffer.Release();
 					return;
+				}
 
 				// NOTE: Descriptor Set 1 is owned by the renderer
 				std::array<VkDescriptorSet, 2> descriptorSets = {
@@ -368,25 +383,33 @@ namespace NR
 				VkPipelineLayout layout = vulkanPipeline->GetVulkanPipelineLayout();
 				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, (uint32_t)descriptorSets.size(), descriptorSets.data(), 0, nullptr);
 
-				Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
 				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, uniformStorageBuffer.Size, uniformStorageBuffer.Data);
 				vkCmdDrawIndexed(commandBuffer, submesh.IndexCount, instanceCount, submesh.BaseIndex, submesh.BaseVertex, 0);
 				sData->DrawCallCount++;
+
+				uniformStorageBuffer.Release();
 			});
 	}
 
-	void VKRenderer::RenderSubmeshInstanced(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformStorageBuffers, uint32_t boneTransformsOffset, uint32_t instanceCount)
+	void VKRenderer::RenderSubmeshInstanced(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformStorageBuffers, uint32_t instanceCount)
 	{
 		NR_CORE_VERIFY(mesh);
 		NR_CORE_VERIFY(materialTable);
 
-		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, materialTable, transformBuffer, transformOffset, boneTransformStorageBuffers, boneTransformsOffset, instanceCount]() mutable
+		// The material table can change while the render thread executes the frame, resolve the material now
+		const Submesh& drawnSubmesh = mesh->GetMeshSource()->GetSubmeshes()[submeshIndex];
+		Ref<MaterialAsset> material = materialTable->HasMaterial(drawnSubmesh.MaterialIndex) ? materialTable->GetMaterial(drawnSubmesh.MaterialIndex) : mesh->GetMaterials()->GetMaterial(drawnSubmesh.MaterialIndex);
+		Ref<VKMaterial> vulkanMaterial = material->GetMaterial().As<VKMaterial>();
+		Buffer uniformStorageBuffer = CopyUniformStorage(vulkanMaterial);
+
+		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, vulkanMaterial, uniformStorageBuffer, transformBuffer, transformOffset, boneTransformStorageBuffers, instanceCount]() mutable
 			{
 				NR_PROFILE_FUNC("VKRenderer::RenderMesh");
 				NR_SCOPE_PERF("VKRenderer::RenderMesh");
 
 				if (sData->SelectedDrawCall != -1 && sData->DrawCallCount > sData->SelectedDrawCall)
 				{
+					uniformStorageBuffer.Release();
 					return;
 				}
 
@@ -438,14 +461,13 @@ namespace NR
 
 				const auto& submeshes = meshSource->GetSubmeshes();
 				const auto& submesh = submeshes[submeshIndex];
-				const auto& meshMaterialTable = mesh->GetMaterials();
-				uint32_t materialCount = meshMaterialTable->GetMaterialCount();
-				Ref<MaterialAsset> material = materialTable->HasMaterial(submesh.MaterialIndex) ? materialTable->GetMaterial(submesh.MaterialIndex) : meshMaterialTable->GetMaterial(submesh.MaterialIndex);
-				Ref<VKMaterial> vulkanMaterial = material->GetMaterial().As<VKMaterial>();
 				RT_UpdateMaterialForRendering(vulkanMaterial, uniformBufferSet, storageBufferSet);
 
 				if (sData->SelectedDrawCall != -1 && sData->DrawCallCount > sData->SelectedDrawCall)
+				{
+					uniformStorageBuffer.Release();
 					return;
+				}
 
 				VkDescriptorSet descriptorSet = vulkanMaterial->GetDescriptorSet(frameIndex);
 
@@ -460,47 +482,33 @@ namespace NR
 				VkPipelineLayout layout = vulkanPipeline->GetVulkanPipelineLayout();
 				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, (uint32_t)descriptorSets.size(), descriptorSets.data(), 0, nullptr);
 
-				Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
-				uint32_t pushConstantOffset = 0;
-
-				if (mesh->IsRigged())
-				{
-					vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, pushConstantOffset, sizeof(uint32_t), &boneTransformsOffset);
-					pushConstantOffset += 16;
-				}
-
 				if (uniformStorageBuffer)
 				{
-					vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, pushConstantOffset, uniformStorageBuffer.Size, uniformStorageBuffer.Data);
+					vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, uniformStorageBuffer.Size, uniformStorageBuffer.Data);
 				}
 
 				vkCmdDrawIndexed(commandBuffer, submesh.IndexCount, instanceCount, submesh.BaseIndex, submesh.BaseVertex, 0);
 				sData->DrawCallCount++;
+
+				uniformStorageBuffer.Release();
 			});
 	}
 
-	void VKRenderer::RenderMeshWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<Material> material, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformStorageBuffers, uint32_t boneTransformsOffset, uint32_t instanceCount, Buffer additionalUniforms)
+	void VKRenderer::RenderMeshWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<Material> material, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformStorageBuffers, uint32_t instanceCount, Buffer additionalUniforms)
 	{
 		NR_CORE_ASSERT(mesh);
 		NR_CORE_ASSERT(mesh->GetMeshSource());
 
 		Buffer pushConstantBuffer;
-		if (additionalUniforms.Size || mesh->IsRigged())
+		if (additionalUniforms.Size)
 		{
-			pushConstantBuffer.Allocate(additionalUniforms.Size + (mesh->IsRigged() ? sizeof(uint32_t) : 0));
-			if (additionalUniforms.Size)
-			{
-				pushConstantBuffer.Write(additionalUniforms.Data, additionalUniforms.Size);
-			}			
-			
-			if (mesh->IsRigged())
-			{
-				pushConstantBuffer.Write(&boneTransformsOffset, sizeof(uint32_t), additionalUniforms.Size);
-			}
+			pushConstantBuffer.Allocate(additionalUniforms.Size);
+			pushConstantBuffer.Write(additionalUniforms.Data, additionalUniforms.Size);
 		}
 
 		Ref<VKMaterial> vulkanMaterial = material.As<VKMaterial>();
-		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, vulkanMaterial, transformBuffer, transformOffset, boneTransformStorageBuffers, instanceCount, pushConstantBuffer]() mutable
+		Buffer uniformStorageBuffer = CopyUniformStorage(vulkanMaterial);
+		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, vulkanMaterial, uniformStorageBuffer, transformBuffer, transformOffset, boneTransformStorageBuffers, instanceCount, pushConstantBuffer]() mutable
 			{
 				NR_PROFILE_FUNC("VKRenderer::RenderMeshWithMaterial");
 				NR_SCOPE_PERF("VKRenderer::RenderMeshWithMaterial");
@@ -573,7 +581,6 @@ namespace NR
 				VkPipelineLayout layout = vulkanPipeline->GetVulkanPipelineLayout();
 				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
 
-				Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
 				uint32_t pushConstantOffset = 0;
 				if (pushConstantBuffer.Size)
 				{
@@ -592,6 +599,7 @@ namespace NR
 				vkCmdDrawIndexed(commandBuffer, submesh.IndexCount, instanceCount, submesh.BaseIndex, submesh.BaseVertex, 0);
 
 				pushConstantBuffer.Release();
+				uniformStorageBuffer.Release();
 			});
 	}
 
@@ -609,7 +617,8 @@ namespace NR
 		}
 
 		Ref<VKMaterial> vulkanMaterial = material.As<VKMaterial>();
-		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, staticMesh, submeshIndex, vulkanMaterial, transformBuffer, transformOffset, instanceCount, pushConstantBuffer]() mutable
+		Buffer uniformStorageBuffer = CopyUniformStorage(vulkanMaterial);
+		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, staticMesh, submeshIndex, vulkanMaterial, uniformStorageBuffer, transformBuffer, transformOffset, instanceCount, pushConstantBuffer]() mutable
 			{
 				NR_PROFILE_FUNC("VKRenderer::RenderMeshWithMaterial");
 				NR_SCOPE_PERF("VKRenderer::RenderMeshWithMaterial");
@@ -648,7 +657,6 @@ namespace NR
 				if (descriptorSet)
 					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
 
-				Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
 				uint32_t pushConstantOffset = 0;
 				if (pushConstantBuffer.Size)
 				{
@@ -668,6 +676,7 @@ namespace NR
 				vkCmdDrawIndexed(commandBuffer, submesh.IndexCount, instanceCount, submesh.BaseIndex, submesh.BaseVertex, 0);
 
 				pushConstantBuffer.Release();
+				uniformStorageBuffer.Release();
 			});
 	}
 
@@ -695,7 +704,8 @@ namespace NR
 		NR_CORE_ASSERT(particles);
 
 		Ref<VKMaterial> vulkanMaterial = material.As<VKMaterial>();
-		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, vulkanMaterial, particles, transformBuffer, transformOffset]() mutable
+		Buffer uniformStorageBuffer = CopyUniformStorage(vulkanMaterial);
+		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, vulkanMaterial, uniformStorageBuffer, particles, transformBuffer, transformOffset]() mutable
 			{
 				NR_PROFILE_FUNC("VKRenderer::RenderParticles");
 				NR_SCOPE_PERF("VKRenderer::RenderMeshParticles");
@@ -737,7 +747,6 @@ namespace NR
 					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
 				}
 
-				Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
 				uint32_t pushConstantOffset = 0;
 
 				if (uniformStorageBuffer)
@@ -747,13 +756,15 @@ namespace NR
 				}
 
 				vkCmdDrawIndexed(commandBuffer, particles->GetIndexCount(), 1, 0, 0, 0);
+				uniformStorageBuffer.Release();
 			});
 	}
 
 	void VKRenderer::RenderQuad(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Material> material, const glm::mat4& transform)
 	{
 		Ref<VKMaterial> vulkanMaterial = material.As<VKMaterial>();
-		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, vulkanMaterial, transform]() mutable
+		Buffer uniformStorageBuffer = CopyUniformStorage(vulkanMaterial);
+		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, vulkanMaterial, uniformStorageBuffer, transform]() mutable
 			{
 				NR_PROFILE_FUNC("VKRenderer::RenderQuad");
 
@@ -785,21 +796,22 @@ namespace NR
 					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
 				}
 
-				Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
 
 				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &transform);
 				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(glm::mat4), uniformStorageBuffer.Size, uniformStorageBuffer.Data);
 				vkCmdDrawIndexed(commandBuffer, sData->QuadIndexBuffer->GetCount(), 1, 0, 0, 0);
+				uniformStorageBuffer.Release();
 			});
 	}
 
 	void VKRenderer::RenderGeometry(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Material> material, Ref<VertexBuffer> vertexBuffer, Ref<IndexBuffer> indexBuffer, const glm::mat4& transform, uint32_t indexCount /*= 0*/)
 	{
 		Ref<VKMaterial> vulkanMaterial = material.As<VKMaterial>();
+		Buffer uniformStorageBuffer = CopyUniformStorage(vulkanMaterial);
 		if (indexCount == 0)
 			indexCount = indexBuffer->GetCount();
 
-		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, vulkanMaterial, vertexBuffer, indexBuffer, transform, indexCount]() mutable
+		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, vulkanMaterial, uniformStorageBuffer, vertexBuffer, indexBuffer, transform, indexCount]() mutable
 			{
 				NR_PROFILE_FUNC("VKRenderer::RenderGeometry");
 
@@ -831,11 +843,11 @@ namespace NR
 					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
 
 				vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &transform);
-				Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
 				if (uniformStorageBuffer)
 					vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(glm::mat4), uniformStorageBuffer.Size, uniformStorageBuffer.Data);
 
 				vkCmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
+				uniformStorageBuffer.Release();
 			});
 	}
 
@@ -954,7 +966,8 @@ namespace NR
 		Ref<StorageBufferSet> storageBufferSet, Ref<Material> material)
 	{
 		Ref<VKMaterial> vulkanMaterial = material.As<VKMaterial>();
-		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, vulkanMaterial]() mutable
+		Buffer uniformStorageBuffer = CopyUniformStorage(vulkanMaterial);
+		Renderer::Submit([renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, vulkanMaterial, uniformStorageBuffer]() mutable
 			{
 				NR_PROFILE_FUNC("VKRenderer::SubmitFullscreenQuad");
 
@@ -984,11 +997,11 @@ namespace NR
 				if (descriptorSet)
 					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
 
-				Buffer uniformStorageBuffer = vulkanMaterial->GetUniformStorageBuffer();
 				if (uniformStorageBuffer.Size)
 					vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, uniformStorageBuffer.Size, uniformStorageBuffer.Data);
 
 				vkCmdDrawIndexed(commandBuffer, sData->QuadIndexBuffer->GetCount(), 1, 0, 0, 0);
+				uniformStorageBuffer.Release();
 			});
 	}
 
@@ -10,6 +10,11 @@
 #include "NotRed/Renderer/Renderer.h"
 #include "NotRed/Renderer/ShaderCache.h"
 
+#include "NotRed/Core/JobSystem.h"
+#include "NotRed/Core/Timer.h"
+
+#include "NotRed/Debug/Profiler.h"
+
 #include "VKContext.h"
 #include "VKRenderer.h"
 
@@ -62,9 +67,10 @@ namespace NR
 
     static std::unordered_map<uint32_t, std::unordered_map<uint32_t, VKShader::UniformBuffer*>> sUniformBuffers; // set -> binding point -> buffer
     static std::unordered_map<uint32_t, std::unordered_map<uint32_t, VKShader::StorageBuffer*>> sStorageBuffers; // set -> binding point -> buffer
+    static std::mutex sGlobalBuffersMutex;
 
-    VKShader::VKShader(const std::string& path, bool forceCompile)
-        : mAssetPath(path)
+    VKShader::VKShader(const std::string& path, bool forceCompile, bool createVulkanObjects)
+        : mAssetPath(path), mCreateVulkanObjects(createVulkanObjects)
     {
         size_t fileName = path.find_last_of("/\\");
         mName = fileName != std::string::npos ? path.substr(fileName + 1) : path;
@@ -78,6 +84,7 @@ namespace NR
 
     void VKShader::ClearUniformBuffers()
     {
+        std::lock_guard<std::mutex> lock(sGlobalBuffersMutex);
         sUniformBuffers.clear();
         sStorageBuffers.clear();
     }
@@ -104,56 +111,106 @@ namespace NR
 
     void VKShader::Reload(bool forceCompile)
     {
+        Utils::CreateCacheDirectoryIfNeeded();
+
+        if (!mCreateVulkanObjects)
+        {
+            ShaderCompilation compilation;
+            Compile(compilation, forceCompile);
+            ApplyCompilation(compilation);
+            BuildPropertyLookups();
+            return;
+        }
+
+        // Compiling and reflecting only needs the CPU, so every shader that is (re)loaded at the same time compiles
+        // in parallel on the job system. The render command blocks until its result is ready and only creates the Vulkan objects.
+        // It must not help out with jobs, those could submit render commands while the queue is executing.
+        // The job can use this without a reference, the render command holds one until the job is done.
+        const VKShader* shader = this;
+        auto compilation = std::make_shared<ShaderCompilation>();
+        Ref<JobCounter> compileJob = Ref<JobCounter>::Create();
+        JobSystem::Schedule([shader, compilation, forceCompile]()
+            {
+                shader->Compile(*compilation, forceCompile);
+            }, "VKShader::Compile", compileJob);
+
         Ref<VKShader> instance = this;
-        Renderer::Submit([instance, forceCompile]() mutable
-            {
-                // Clear old shader
-                instance->mShaderDescriptorSets.clear();
-                instance->mResources.clear();
-                instance->mPushConstantRanges.clear();
-                instance->mPipelineShaderStageCreateInfos.clear();
-                instance->mDescriptorSetLayouts.clear();
-                instance->mShaderSource.clear();
-                instance->mBuffers.clear();
-                instance->mTypeCounts.clear();
-
-                Utils::CreateCacheDirectoryIfNeeded();
-
-                // Vertex and Fragment for now
-                std::string compute = "";
-                std::string path = instance->mAssetPath + "/" + instance->mName + ".comp";
-                instance->ParseFile(path, compute, true);
-
-                if (compute == "")
-                {
-                    path = instance->mAssetPath + "/" + instance->mName + ".vert";
-                    std::string vert = "";
-                    instance->ParseFile(path, vert);
-                    instance->mShaderSource.insert({ VK_SHADER_STAGE_VERTEX_BIT, vert });
-                    ShaderCache::HasChanged(path, vert);
-
-                    path = instance->mAssetPath + "/" + instance->mName + ".frag";
-                    std::string frag = "";
-                    instance->ParseFile(path, frag);
-                    instance->mShaderSource.insert({ VK_SHADER_STAGE_FRAGMENT_BIT, frag });
-                    ShaderCache::HasChanged(path, frag);
-                }
-                else
-                {
-                    instance->mShaderSource.insert({ VK_SHADER_STAGE_COMPUTE_BIT, compute });
-                    ShaderCache::HasChanged(path, compute);
-                }
+        Renderer::Submit([instance, compilation, compileJob]()
+            {
+                JobSystem::Block(compileJob);
+                RegisterGlobalBuffers(*compilation);
 
-                std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>> shaderData;
-                instance->CompileOrGetVulkanBinary(shaderData, forceCompile);
-                instance->LoadAndCreateShaders(shaderData);
-                instance->ReflectAllShaderStages(shaderData);
+                instance->ApplyCompilation(*compilation);
+                instance->LoadAndCreateShaders(compilation->ShaderData);
                 instance->CreateDescriptors();
+                instance->BuildPropertyLookups();
 
                 Renderer::ShaderReloaded(instance->GetHash());
             });
     }
 
+    void VKShader::Compile(ShaderCompilation& compilation, bool forceCompile) const
+    {
+        NR_PROFILE_FUNC();
+
+        // Vertex and Fragment for now
+        bool sourceChanged = false;
+        std::string compute = "";
+        std::string path = mAssetPath + "/" + mName + ".comp";
+        ParseFile(path, compute, true);
+
+        if (compute == "")
+        {
+            path = mAssetPath + "/" + mName + ".vert";
+            std::string vert = "";
+            ParseFile(path, vert);
+            sourceChanged |= ShaderCache::HasChanged(path, vert);
+            compilation.ShaderSource.insert({ VK_SHADER_STAGE_VERTEX_BIT, std::move(vert) });
+
+            path = mAssetPath + "/" + mName + ".frag";
+            std::string frag = "";
+            ParseFile(path, frag);
+            sourceChanged |= ShaderCache::HasChanged(path, frag);
+            compilation.ShaderSource.insert({ VK_SHADER_STAGE_FRAGMENT_BIT, std::move(frag) });
+        }
+        else
+        {
+            sourceChanged |= ShaderCache::HasChanged(path, compute);
+            compilation.ShaderSource.insert({ VK_SHADER_STAGE_COMPUTE_BIT, std::move(compute) });
+        }
+
+        // Cached binaries of a changed source are stale
+        const bool compile = forceCompile || sourceChanged;
+
+        Timer timer;
+        CompileOrGetVulkanBinary(compilation.ShaderSource, compilation.ShaderData, compile);
+        ShaderCache::RecordLoad(!compile, timer.ElapsedMillis());
+
+        ReflectAllShaderStages(compilation);
+    }
+
+    void VKShader::ApplyCompilation(ShaderCompilation& compilation)
+    {
+        // Clear old shader
+        mShaderDescriptorSets.clear();
+        mResources.clear();
+        mPushConstantRanges.clear();
+        mPipelineShaderStageCreateInfos.clear();
+        mDescriptorSetLayouts.clear();
+        mShaderSource.clear();
+        mBuffers.clear();
+        mTypeCounts.clear();
+        mUniformLookup.clear();
+        mResourceLookup.clear();
+        mWriteDescriptorLookup.clear();
+
+        mShaderSource = std::move(compilation.ShaderSource);
+        mShaderDescriptorSets = std::move(compilation.ShaderDescriptorSets);
+        mPushConstantRanges = std::move(compilation.PushConstantRanges);
+        mResources = std::move(compilation.Resources);
+        mBuffers = std::move(compilation.Buffers);
+    }
+
     size_t VKShader::GetHash() const
     {
         return std::hash<std::string>{}(mAssetPath);
@@ -183,20 +240,64 @@ namespace NR
         }
     }
 
-    void VKShader::ReflectAllShaderStages(const std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData)
+    void VKShader::ReflectAllShaderStages(ShaderCompilation& compilation) const
     {
-        mResources.clear();
-
-        for (auto [stage, data] : shaderData)
+        for (const auto& [stage, data] : compilation.ShaderData)
         {
-            Reflect(stage, data);
+            Reflect(stage, data, compilation);
         }
     }
 
-    void VKShader::Reflect(VkShaderStageFlagBits shaderStage, const std::vector<uint32_t>& shaderData)
+    void VKShader::RegisterGlobalBuffers(ShaderCompilation& compilation)
     {
-        VkDevice device = VKContext::GetCurrentDevice()->GetVulkanDevice();
+        // Shaders reflect on worker threads, so the buffers they share are only created and grown here on the render thread
+        std::lock_guard<std::mutex> lock(sGlobalBuffersMutex);
 
+        for (const GlobalBufferDeclaration& declaration : compilation.UniformBuffers)
+        {
+            auto& buffers = sUniformBuffers[declaration.Set];
+            auto it = buffers.find(declaration.Binding);
+            if (it == buffers.end())
+            {
+                UniformBuffer* uniformBuffer = new UniformBuffer();
+                uniformBuffer->BindingPoint = declaration.Binding;
+                uniformBuffer->Size = declaration.Size;
+                uniformBuffer->Name = declaration.Name;
+                uniformBuffer->ShaderStage = VK_SHADER_STAGE_ALL;
+                it = buffers.emplace(declaration.Binding, uniformBuffer).first;
+            }
+            else if (declaration.Size > it->second->Size)
+            {
+                it->second->Size = declaration.Size;
+            }
+
+            compilation.ShaderDescriptorSets[declaration.Set].UniformBuffers[declaration.Binding] = it->second;
+        }
+
+        for (const GlobalBufferDeclaration& declaration : compilation.StorageBuffers)
+        {
+            auto& buffers = sStorageBuffers[declaration.Set];
+            auto it = buffers.find(declaration.Binding);
+            if (it == buffers.end())
+            {
+                StorageBuffer* storageBuffer = new StorageBuffer();
+                storageBuffer->BindingPoint = declaration.Binding;
+                storageBuffer->Size = declaration.Size;
+                storageBuffer->Name = declaration.Name;
+                storageBuffer->ShaderStage = VK_SHADER_STAGE_ALL;
+                it = buffers.emplace(declaration.Binding, storageBuffer).first;
+            }
+            else if (declaration.Size > it->second->Size)
+            {
+                it->second->Size = declaration.Size;
+            }
+
+            compilation.ShaderDescriptorSets[declaration.Set].StorageBuffers[declaration.Binding] = it->second;
+        }
+    }
+
+    void VKShader::Reflect(VkShaderStageFlagBits shaderStage, const std::vector<uint32_t>& shaderData, ShaderCompilation& compilation) const
+    {
         NR_CORE_TRACE("===========================");
         NR_CORE_TRACE(" Vulkan Shader Reflection");
         NR_CORE_TRACE(" {0}", mAssetPath);
@@ -216,31 +317,12 @@ namespace NR
             uint32_t descriptorSet = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
             uint32_t size = (uint32_t)compiler.get_declared_struct_size(bufferType);
 
-            if (descriptorSet >= mShaderDescriptorSets.size())
+            if (descriptorSet >= compilation.ShaderDescriptorSets.size())
             {
-                mShaderDescriptorSets.resize(descriptorSet + 1);
+                compilation.ShaderDescriptorSets.resize(descriptorSet + 1);
             }
 
-            ShaderDescriptorSet& shaderDescriptorSet = mShaderDescriptorSets[descriptorSet];
-            if (sUniformBuffers[descriptorSet].find(binding) == sUniformBuffers[descriptorSet].end())
-            {
-                UniformBuffer* uniformBuffer = new UniformBuffer();
-                uniformBuffer->BindingPoint = binding;
-                uniformBuffer->Size = size;
-                uniformBuffer->Name = name;
-                uniformBuffer->ShaderStage = VK_SHADER_STAGE_ALL;
-                sUniformBuffers.at(descriptorSet)[binding] = uniformBuffer;
-            }
-            else
-            {
-                UniformBuffer* uniformBuffer = sUniformBuffers.at(descriptorSet).at(binding);
-                if (size > uniformBuffer->Size)
-                {
-                    uniformBuffer->Size = size;
-                }
-            }
-
-            shaderDescriptorSet.UniformBuffers[binding] = sUniformBuffers.at(descriptorSet).at(binding);
+            compilation.UniformBuffers.push_back({ descriptorSet, binding, size, name });
 
             NR_CORE_TRACE("  {0} ({1}, {2})", name, descriptorSet, binding);
             NR_CORE_TRACE("  Member Count: {0}", memberCount);
@@ -259,31 +341,13 @@ namespace NR
             uint32_t descriptorSet = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
             uint32_t size = (uint32_t)compiler.get_declared_struct_size(bufferType);
             
-            if (descriptorSet >= mShaderDescriptorSets.size())
+            if (descriptorSet >= compilation.ShaderDescriptorSets.size())
             {
-                mShaderDescriptorSets.resize(descriptorSet + 1);
+                compilation.ShaderDescriptorSets.resize(descriptorSet + 1);
             }
 
-            ShaderDescriptorSet& shaderDescriptorSet = mShaderDescriptorSets[descriptorSet];
-            
-            if (sStorageBuffers[descriptorSet].find(binding) == sStorageBuffers[descriptorSet].end())
-            {
-                StorageBuffer* storageBuffer = new StorageBuffer();
-                storageBuffer->BindingPoint = binding;
-                storageBuffer->Size = size;
-                storageBuffer->Name = name;
-                storageBuffer->ShaderStage = VK_SHADER_STAGE_ALL;
-                sStorageBuffers.at(descriptorSet)[binding] = storageBuffer;
-            }
-            else
-            {
-                StorageBuffer* storageBuffer = sStorageBuffers.at(descriptorSet).at(binding);
-                if (size > storageBuffer->Size)
-                {
-                    storageBuffer->Size = size;
-                }
-            }
-            shaderDescriptorSet.StorageBuffers[binding] = sStorageBuffers.at(descriptorSet).at(binding);
+            compilation.StorageBuffers.push_back({ descriptorSet, binding, size, name });
+
             NR_CORE_TRACE("  {0} ({1}, {2})", name, descriptorSet, binding);
             NR_CORE_TRACE("  Member Count: {0}", memberCount);
             NR_CORE_TRACE("  Size: {0}", size);
@@ -299,12 +363,12 @@ namespace NR
             uint32_t memberCount = uint32_t(bufferType.member_types.size());
             uint32_t bufferOffset = 0;
 
-            if (mPushConstantRanges.size())
+            if (compilation.PushConstantRanges.size())
             {
-                bufferOffset = mPushConstantRanges.back().Offset + mPushConstantRanges.back().Size;
+                bufferOffset = compilation.PushConstantRanges.back().Offset + compilation.PushConstantRanges.back().Size;
             }
 
-            auto& pushConstantRange = mPushConstantRanges.emplace_back();
+            auto& pushConstantRange = compilation.PushConstantRanges.emplace_back();
             pushConstantRange.ShaderStage = shaderStage;
             pushConstantRange.Size = bufferSize - bufferOffset;
             pushConstantRange.Offset = bufferOffset;
@@ -315,7 +379,7 @@ namespace NR
                 continue;
             }
 
-            ShaderBuffer& buffer = mBuffers[bufferName];
+            ShaderBuffer& buffer = compilation.Buffers[bufferName];
             buffer.Name = bufferName;
             buffer.Size = bufferSize - bufferOffset;
 
@@ -344,19 +408,19 @@ namespace NR
             uint32_t descriptorSet = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
             uint32_t dimension = type.image.dim;
 
-            if (descriptorSet >= mShaderDescriptorSets.size())
+            if (descriptorSet >= compilation.ShaderDescriptorSets.size())
             {
-                mShaderDescriptorSets.resize(descriptorSet + 1);
+                compilation.ShaderDescriptorSets.resize(descriptorSet + 1);
             }
 
-            ShaderDescriptorSet& shaderDescriptorSet = mShaderDescriptorSets[descriptorSet];
+            ShaderDescriptorSet& shaderDescriptorSet = compilation.ShaderDescriptorSets[descriptorSet];
             auto& imageSampler = shaderDescriptorSet.ImageSamplers[binding];
             imageSampler.BindingPoint = binding;
             imageSampler.DescriptorSet = descriptorSet;
             imageSampler.Name = name;
             imageSampler.ShaderStage = shaderStage;
 
-            mResources[name] = ShaderResourceDeclaration(name, binding, 1);
+            compilation.Resources[name] = ShaderResourceDeclaration(name, binding, 1);
 
             NR_CORE_TRACE("  {0} ({1}, {2})", name, descriptorSet, binding);
         }
@@ -370,17 +434,17 @@ namespace NR
             uint32_t descriptorSet = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
             uint32_t dimension = type.image.dim;
 
-            if (descriptorSet >= mShaderDescriptorSets.size())
-                mShaderDescriptorSets.resize(descriptorSet + 1);
+            if (descriptorSet >= compilation.ShaderDescriptorSets.size())
+                compilation.ShaderDescriptorSets.resize(descriptorSet + 1);
 
-            ShaderDescriptorSet& shaderDescriptorSet = mShaderDescriptorSets[descriptorSet];
+            ShaderDescriptorSet& shaderDescriptorSet = compilation.ShaderDescriptorSets[descriptorSet];
             auto& imageSampler = shaderDescriptorSet.StorageImages[binding];
             imageSampler.BindingPoint = binding;
             imageSampler.DescriptorSet = descriptorSet;
             imageSampler.Name = name;
             imageSampler.ShaderStage = shaderStage;
 
-            mResources[name] = ShaderResourceDeclaration(name, binding, 1);
+            compilation.Resources[name] = ShaderResourceDeclaration(name, binding, 1);
 
             NR_CORE_TRACE("  {0} ({1}, {2})", name, descriptorSet, binding);
         }
@@ -656,6 +720,69 @@ namespace NR
         return &mShaderDescriptorSets.at(set).WriteDescriptorSets.at(name);
     }
 
+    const ShaderUniform* VKShader::FindUniform(MaterialPropertyID id) const
+    {
+        auto it = mUniformLookup.find(id.GetHash());
+        return it != mUniformLookup.end() ? it->second : nullptr;
+    }
+
+    const ShaderResourceDeclaration* VKShader::FindResource(MaterialPropertyID id) const
+    {
+        auto it = mResourceLookup.find(id.GetHash());
+        return it != mResourceLookup.end() ? it->second : nullptr;
+    }
+
+    const VkWriteDescriptorSet* VKShader::GetDescriptorSet(MaterialPropertyID id) const
+    {
+        auto it = mWriteDescriptorLookup.find(id.GetHash());
+        if (it == mWriteDescriptorLookup.end())
+        {
+            NR_CORE_WARN("Shader {0} does not contain requested descriptor set {1}", mName, id.GetHash());
+            return nullptr;
+        }
+        return it->second;
+    }
+
+    void VKShader::BuildPropertyLookups()
+    {
+        mUniformLookup.clear();
+        mResourceLookup.clear();
+        mWriteDescriptorLookup.clear();
+
+        for (const auto& [bufferName, buffer] : mBuffers)
+        {
+            for (const auto& [name, uniform] : buffer.Uniforms)
+            {
+                auto [it, inserted] = mUniformLookup.emplace(MaterialPropertyID(name).GetHash(), &uniform);
+                if (!inserted)
+                {
+                    NR_CORE_ERROR("Shader '{}': uniforms '{}' and '{}' have the same material property hash, '{}' can't be set", mName, it->second->GetName(), name, name);
+                }
+            }
+        }
+
+        for (const auto& [name, resource] : mResources)
+        {
+            auto [it, inserted] = mResourceLookup.emplace(MaterialPropertyID(name).GetHash(), &resource);
+            if (!inserted)
+            {
+                NR_CORE_ERROR("Shader '{}': resources '{}' and '{}' have the same material property hash, '{}' can't be set", mName, it->second->GetName(), name, name);
+            }
+        }
+
+        if (!mShaderDescriptorSets.empty())
+        {
+            for (const auto& [name, writeDescriptor] : mShaderDescriptorSets[0].WriteDescriptorSets)
+            {
+                auto [it, inserted] = mWriteDescriptorLookup.emplace(MaterialPropertyID(name).GetHash(), &writeDescriptor);
+                if (!inserted)
+                {
+                    NR_CORE_ERROR("Shader '{}': descriptor '{}' has the same material property hash as another one and can't be set", mName, name);
+                }
+            }
+        }
+    }
+
     std::vector<VkDescriptorSetLayout> VKShader::GetAllDescriptorSetLayouts()
     {
         std::vector<VkDescriptorSetLayout> result;
@@ -705,11 +832,24 @@ namespace NR
         }
     }
 
-    void VKShader::CompileOrGetVulkanBinary(std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputBinary, bool forceCompile)
+    void VKShader::CompileOrGetVulkanBinary(const std::unordered_map<VkShaderStageFlagBits, std::string>& shaderSource, std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputBinary, bool forceCompile) const
     {
         std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
-        for (auto [stage, source] : mShaderSource)
+
+        // Every stage gets its entry up front so the stages can fill them in parallel
+        std::vector<VkShaderStageFlagBits> stages;
+        stages.reserve(shaderSource.size());
+        for (const auto& [stage, source] : shaderSource)
         {
+            stages.push_back(stage);
+            outputBinary[stage];
+        }
+
+        JobSystem::ParallelFor((uint32_t)stages.size(), [&](uint32_t index)
+        {
+            const VkShaderStageFlagBits stage = stages[index];
+            std::vector<uint32_t>& binary = outputBinary.at(stage);
+
             auto extension = VkShaderStageCachedFileExtension(stage);
             std::string fullShaderPath = mAssetPath + "/" + mName;
             std::filesystem::path shaderPath = GetVKShaderFileExtension(stage, fullShaderPath);
@@ -725,13 +865,13 @@ namespace NR
                     fseek(f, 0, SEEK_END);
                     uint64_t size = ftell(f);
                     fseek(f, 0, SEEK_SET);
-                    outputBinary[stage] = std::vector<uint32_t>(size / sizeof(uint32_t));
-                    fread(outputBinary[stage].data(), sizeof(uint32_t), outputBinary[stage].size(), f);
+                    binary = std::vector<uint32_t>(size / sizeof(uint32_t));
+                    fread(binary.data(), sizeof(uint32_t), binary.size(), f);
                     fclose(f);
                 }
             }
 
-            if (outputBinary[stage].size() == 0)
+            if (binary.size() == 0)
             {
                 shaderc::Compiler compiler;
                 shaderc::CompileOptions options;
@@ -747,9 +887,9 @@ namespace NR
 
                 // Compile shader
                 {
-                    auto& shaderSource = mShaderSource.at(stage);
+                    const std::string& source = shaderSource.at(stage);
                     shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
-                        shaderSource,
+                        source,
                         VkShaderStageToShaderC(stage),
                         shaderPath.string().c_str(),
                         options);
@@ -764,7 +904,7 @@ namespace NR
                     const uint8_t* end = (const uint8_t*)module.cend();
                     const ptrdiff_t size = end - begin;
 
-                    outputBinary[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
+                    binary = std::vector<uint32_t>(module.cbegin(), module.cend());
                 }
 
                 // Cache compiled shader
@@ -774,11 +914,11 @@ namespace NR
 
                     FILE* f;
                     fopen_s(&f, cachedFilePath.c_str(), "wb");
-                    fwrite(outputBinary[stage].data(), sizeof(uint32_t), outputBinary[stage].size(), f);
+                    fwrite(binary.data(), sizeof(uint32_t), binary.size(), f);
                     fclose(f);
                 }
             }
-        }
+        }, 1, "VKShader::CompileStage");
     }
 
     void VKShader::ParseFile(const std::string& filepath, std::string& output, bool isCompute) const
@@ -63,7 +63,9 @@ namespace NR
         };
 
     public:
-        VKShader(const std::string& path, bool forceCompile);
+        // Without Vulkan objects the shader is only compiled and reflected, on the calling thread. Materials can be created
+        // for it and their properties set, but it can't be used in a pipeline. For tools and tests that run without a device.
+        VKShader(const std::string& path, bool forceCompile, bool createVulkanObjects = true);
         ~VKShader() override;
 
         void Reload(bool forceCompile = false) override;
@@ -109,16 +111,51 @@ namespace NR
         ShaderMaterialDescriptorSet CreateDescriptorSets(uint32_t set, uint32_t numberOfSets);
         const VkWriteDescriptorSet* GetDescriptorSet(const std::string& name, uint32_t set = 0) const;
 
+        // Hashed lookups for materials, resources and write descriptors are from set 0
+        const ShaderUniform* FindUniform(MaterialPropertyID id) const;
+        const ShaderResourceDeclaration* FindResource(MaterialPropertyID id) const;
+        const VkWriteDescriptorSet* GetDescriptorSet(MaterialPropertyID id) const;
+
         static void ClearUniformBuffers();
 
     private:
+        // Uniform and storage buffer found by reflection, merged into the buffers shared by all shaders on the render thread
+        struct GlobalBufferDeclaration
+        {
+            uint32_t Set = 0;
+            uint32_t Binding = 0;
+            uint32_t Size = 0;
+            std::string Name;
+        };
+
+        // CPU side result of compiling and reflecting, built on a worker thread and moved into the shader on the render thread
+        struct ShaderCompilation
+        {
+            std::unordered_map<VkShaderStageFlagBits, std::string> ShaderSource;
+            std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>> ShaderData;
+
+            std::vector<ShaderDescriptorSet> ShaderDescriptorSets;
+            std::vector<PushConstantRange> PushConstantRanges;
+            std::unordered_map<std::string, ShaderResourceDeclaration> Resources;
+            std::unordered_map<std::string, ShaderBuffer> Buffers;
+
+            std::vector<GlobalBufferDeclaration> UniformBuffers;
+            std::vector<GlobalBufferDeclaration> StorageBuffers;
+        };
+
+        void Compile(ShaderCompilation& compilation, bool forceCompile) const;
+        // Replaces the reflection data of the shader with the compilation's
+        void ApplyCompilation(ShaderCompilation& compilation);
+
         void ParseFile(const std::string& filepath, std::string& output, bool isCompute = false) const;
-        void CompileOrGetVulkanBinary(std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputBinary, bool forceCompile);
+        void CompileOrGetVulkanBinary(const std::unordered_map<VkShaderStageFlagBits, std::string>& shaderSource, std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputBinary, bool forceCompile) const;
         void LoadAndCreateShaders(const std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData);
-        void Reflect(VkShaderStageFlagBits shaderStage, const std::vector<uint32_t>& shaderData);
-        void ReflectAllShaderStages(const std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& shaderData);
+        void Reflect(VkShaderStageFlagBits shaderStage, const std::vector<uint32_t>& shaderData, ShaderCompilation& compilation) const;
+        void ReflectAllShaderStages(ShaderCompilation& compilation) const;
+        static void RegisterGlobalBuffers(ShaderCompilation& compilation);
 
         void CreateDescriptors();
+        void BuildPropertyLookups();
 
         void AllocateUniformBuffer(UniformBuffer& dst);
         void AllocateStorageBuffer(StorageBuffer& dst);
@@ -128,6 +165,7 @@ namespace NR
         std::unordered_map<VkShaderStageFlagBits, std::string> mShaderSource;
         std::string mAssetPath;
         std::string mName;
+        bool mCreateVulkanObjects = true;
 
         std::vector<ShaderDescriptorSet> mShaderDescriptorSets;
 
@@ -136,6 +174,11 @@ namespace NR
 
         std::unordered_map<std::string, ShaderBuffer> mBuffers;
 
+        // MaterialPropertyID hash -> reflection data, rebuilt whenever the shader is reflected
+        std::unordered_map<uint32_t, const ShaderUniform*> mUniformLookup;
+        std::unordered_map<uint32_t, const ShaderResourceDeclaration*> mResourceLookup;
+        std::unordered_map<uint32_t, const VkWriteDescriptorSet*> mWriteDescriptorLookup;
+
         std::vector<VkDescriptorSetLayout> mDescriptorSetLayouts;
         VkDescriptorSet mDescriptorSet;
 
@@ -57,11 +57,13 @@ namespace NR
 
 	void VKStorageBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
 	{
-		memcpy(mLocalStorage, data, size);
+		// Copied, the render thread can upload it while the next frame is recorded
+		Buffer buffer = Buffer::Copy(data, size);
 		Ref<VKStorageBuffer> instance = this;
-		Renderer::Submit([instance, size, offset]() mutable
+		Renderer::Submit([instance, buffer, offset]() mutable
 			{
-				instance->RT_SetData(instance->mLocalStorage, size, offset);
+				instance->RT_SetData(buffer.Data, buffer.Size, offset);
+				buffer.Release();
 			});
 	}
 
@@ -35,7 +35,5 @@ namespace NR
 		std::string mName;
 
 		VkShaderStageFlagBits mShaderStage = VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM;
-
-		uint8_t* mLocalStorage = nullptr;
 	};
 }
\ No newline at end of file
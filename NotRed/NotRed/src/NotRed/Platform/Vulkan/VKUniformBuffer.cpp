@@ -8,8 +8,6 @@ namespace NR
 	VKUniformBuffer::VKUniformBuffer(uint32_t size, uint32_t binding)
 		: mSize(size), mBinding(binding)
 	{
-		mLocalStorage = new uint8_t[size];
-
 		Ref<VKUniformBuffer> instance = this;
 		Renderer::Submit([instance]() mutable
 			{
@@ -19,7 +17,6 @@ namespace NR
 
 	VKUniformBuffer::~VKUniformBuffer()
 	{
-		delete[] mLocalStorage;
 	}
 
 	void VKUniformBuffer::RT_Invalidate()
@@ -49,11 +46,13 @@ namespace NR
 
 	void VKUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
 	{
-		memcpy(mLocalStorage, data, size);
+		// Copied, the render thread can upload it while the next frame is recorded
+		Buffer buffer = Buffer::Copy((const uint8_t*)data + offset, size);
 		Ref<VKUniformBuffer> instance = this;
-		Renderer::Submit([instance, size, offset]() mutable
+		Renderer::Submit([instance, buffer]() mutable
 			{
-				instance->RT_SetData(instance->mLocalStorage, size, offset);
+				instance->RT_SetData(buffer.Data, buffer.Size);
+				buffer.Release();
 			});
 	}
 
@@ -29,7 +29,5 @@ namespace NR
 		uint32_t mSize = 0;
 		uint32_t mBinding = 0;
 		VkShaderStageFlagBits mShaderStage = VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM;
-
-		uint8_t* mLocalStorage = nullptr;
 	};
 }
\ No newline at end of file
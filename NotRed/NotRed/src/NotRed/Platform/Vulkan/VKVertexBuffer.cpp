@@ -102,12 +102,15 @@ namespace NR
     {
         NR_CORE_ASSERT(size <= mLocalData.Size);
         
-        memcpy(mLocalData.Data, (uint8_t*)buffer + offset, size);;
+        memcpy(mLocalData.Data, (uint8_t*)buffer + offset, size);
 
+        // The upload gets its own copy, the render thread can execute it while the next frame overwrites mLocalData
+        Buffer data = Buffer::Copy((uint8_t*)buffer + offset, size);
         Ref<VKVertexBuffer> instance = this;
-        Renderer::Submit([instance, size, offset]() mutable
+        Renderer::Submit([instance, data]() mutable
             {
-                instance->RT_SetData(instance->mLocalData.Data, size, offset);
+                instance->RT_SetData(data.Data, data.Size);
+                data.Release();
             });
     }
 
@@ -55,6 +55,9 @@ namespace NR
 				out << YAML::Key << "FrictionModel" << YAML::Value << (int)physicsSettings.FrictionModel;
 				out << YAML::Key << "SolverPositionIterations" << YAML::Value << physicsSettings.SolverIterations;
 				out << YAML::Key << "SolverVelocityIterations" << YAML::Value << physicsSettings.SolverVelocityIterations;
+				out << YAML::Key << "WorkerThreadCount" << YAML::Value << physicsSettings.WorkerThreadCount;
+				out << YAML::Key << "UseJobSystem" << YAML::Value << physicsSettings.UseJobSystem;
+				out << YAML::Key << "InterpolateTransforms" << YAML::Value << physicsSettings.InterpolateTransforms;
 
 #ifdef NR_DEBUG
 				out << YAML::Key << "DebugOnPlay" << YAML::Value << physicsSettings.DebugOnPlay;
@@ -161,6 +164,9 @@ namespace NR
 			physicsSettings.FrictionModel = physicsNode["FrictionModel"] ? (FrictionType)physicsNode["FrictionModel"].as<int>() : FrictionType::Patch;
 			physicsSettings.SolverIterations = physicsNode["SolverPositionIterations"] ? physicsNode["SolverPositionIterations"].as<uint32_t>() : 8;
 			physicsSettings.SolverVelocityIterations = physicsNode["SolverVelocityIterations"] ? physicsNode["SolverVelocityIterations"].as<uint32_t>() : 2;
+			physicsSettings.WorkerThreadCount = physicsNode["WorkerThreadCount"] ? physicsNode["WorkerThreadCount"].as<uint32_t>() : 0;
+			physicsSettings.UseJobSystem = physicsNode["UseJobSystem"] ? physicsNode["UseJobSystem"].as<bool>() : true;
+			physicsSettings.InterpolateTransforms = physicsNode["InterpolateTransforms"] ? physicsNode["InterpolateTransforms"].as<bool>() : false;
 
 #ifdef NR_DEBUG
 			physicsSettings.DebugOnPlay = physicsNode["DebugOnPlay"] ? physicsNode["DebugOnPlay"].as<bool>() : true;
@@ -21,7 +21,9 @@
 #include <ozz/animation/runtime/sampling_job.h>
 #include <ozz/base/span.h>
 
+#include <deque>
 #include <filesystem>
+#include <mutex>
 
 namespace NR
 {
@@ -190,11 +192,80 @@ namespace NR
 	}
 
 
-	const RootMotion& AnimationController::Update(float dt, bool isRootMotionEnabled)
+	void AnimationController::SetAnimationState(const std::string_view stateName, Ref<AnimationState> state)
+	{
+		// Load animation if it isn't already (we could not do this when animation asset was first de-serialized, since there is no way to pass parameters to the asset manager)
+		if (mSkeletonAsset && mSkeletonAsset->IsValid() && state && state->GetAnimationAsset() && state->GetAnimationAsset()->IsValid() && !state->GetAnimationAsset()->IsLoaded())
+		{
+			state->GetAnimationAsset()->Load(mSkeletonAsset);
+		}
+
+		size_t existingIndex = ~0;
+		for (size_t i = 0; i < GetNumStates(); ++i)
+		{
+			if (mStateNames[i] == stateName)
+			{
+				existingIndex = i;
+				break;
+			}
+		}
+
+		if (existingIndex != ~0)
+		{
+			mAnimationStates[existingIndex] = state;
+		}
+		else
+		{
+			mStateNames.emplace_back(stateName);
+			mAnimationStates.emplace_back(state);
+		}
+	}
+
+
+	void AnimationInstance::Initialize(const Ref<AnimationController>& controller)
+	{
+		NR_CORE_ASSERT(controller && controller->CanPlay());
+		mController = controller;
+
+		const ozz::animation::Skeleton& skeleton = mController->GetSkeletonAsset()->GetSkeleton();
+		if (mSamplingContext.max_tracks() < skeleton.num_joints())
+		{
+			mSamplingContext.Resize(skeleton.num_joints());
+		}
+		else
+		{
+			// The context may still point at a clip of the previous controller
+			mSamplingContext.Invalidate();
+		}
+
+		mLocalSpaceSoaTransforms.resize(skeleton.num_soa_joints());
+		mLocalTranslations.resize(skeleton.num_joints());
+		mLocalScales.resize(skeleton.num_joints());
+		mLocalRotations.resize(skeleton.num_joints());
+		mModelSpaceTransforms.resize(skeleton.num_joints());
+
+		mRootMotion = {};
+		mStateIndex = ~0;
+		SetStateIndex(0);
+	}
+
+
+	void AnimationInstance::Reset()
+	{
+		mController = nullptr;
+		mSamplingContext.Invalidate();
+		mRootMotion = {};
+		mPreviousAnimationTime = -FLT_MAX;
+		mAnimationTime = 0.0f;
+		mStateIndex = ~0;
+	}
+
+
+	const RootMotion& AnimationInstance::Update(float dt, bool isPlaying, bool isRootMotionEnabled)
 	{
 		NR_PROFILE_FUNC();
-		auto state = mAnimationStates[mStateIndex];
-		if (state && state->GetAnimationAsset() && mAnimationPlaying)
+		auto state = mController->GetAnimationState(mStateIndex);
+		if (state && state->GetAnimationAsset() && isPlaying)
 		{
 			mAnimationTime = mAnimationTime + dt * state->GetPlaybackSpeed() / state->GetAnimationAsset()->GetAnimation().duration();
 			if (state->IsLooping())
@@ -216,7 +287,7 @@ namespace NR
 
 		if (mAnimationTime != mPreviousAnimationTime)
 		{
-			SampleAnimation();
+			SampleAnimation(isPlaying);
 
 			if (isRootMotionEnabled)
 			{
@@ -248,8 +319,19 @@ namespace NR
 				// put the modified root transform back into the bone transforms
 				mLocalTranslations[0] = translation;
 				mLocalRotations[0] = rotation;
+
+				// ... and into the SoA transforms the model space ones are built from (joint 0 is the x lane of the first one)
+				ozz::math::SoaTransform& root = mLocalSpaceSoaTransforms[0];
+				root.translation.x = ozz::math::SetX(root.translation.x, ozz::math::simd_float4::Load1(translation.x));
+				root.translation.y = ozz::math::SetX(root.translation.y, ozz::math::simd_float4::Load1(translation.y));
+				root.translation.z = ozz::math::SetX(root.translation.z, ozz::math::simd_float4::Load1(translation.z));
+				root.rotation.x = ozz::math::SetX(root.rotation.x, ozz::math::simd_float4::Load1(rotation.x));
+				root.rotation.y = ozz::math::SetX(root.rotation.y, ozz::math::simd_float4::Load1(rotation.y));
+				root.rotation.z = ozz::math::SetX(root.rotation.z, ozz::math::simd_float4::Load1(rotation.z));
+				root.rotation.w = ozz::math::SetX(root.rotation.w, ozz::math::simd_float4::Load1(rotation.w));
 			}
 
+			UpdateModelSpaceTransforms();
 			mPreviousAnimationTime = mAnimationTime;
 		}
 
@@ -257,68 +339,43 @@ namespace NR
 	}
 
 
-	void AnimationController::SetStateIndex(const uint32_t stateIndex)
+	void AnimationInstance::SetStateIndex(const uint32_t stateIndex)
 	{
-		if (stateIndex != mStateIndex) {
+		if (stateIndex != mStateIndex && stateIndex < mController->GetNumStates()) {
 			mPreviousAnimationTime = 0.0f;
 			mAnimationTime = 1.0f;
 			mStateIndex = stateIndex;
 
-			SampleAnimation();
+			SampleAnimation(false);
 			mRootPoseEnd = { mLocalTranslations[0], mLocalRotations[0] };
 
 			mAnimationTime = 0.0;
-			SampleAnimation();
+			SampleAnimation(false);
 			mRootPoseStart = { mLocalTranslations[0], mLocalRotations[0] };
 			mRootPose = mRootPoseStart;
-		}
-	}
 
-
-	void AnimationController::SetSkeletonAsset(Ref<SkeletonAsset> skeletonAsset)
-	{
-		mSkeletonAsset = skeletonAsset;
-		if (mSkeletonAsset && mSkeletonAsset->IsValid())
-		{
-			mSamplingContext.Resize(mSkeletonAsset->GetSkeleton().num_joints());
-			mLocalSpaceSoaTransforms.resize(mSkeletonAsset->GetSkeleton().num_soa_joints());
-			mLocalTranslations.resize(mSkeletonAsset->GetSkeleton().num_joints());
-			mLocalScales.resize(mSkeletonAsset->GetSkeleton().num_joints());
-			mLocalRotations.resize(mSkeletonAsset->GetSkeleton().num_joints());
+			// Update() won't sample again until the time moves, so the model space pose has to be valid now
+			UpdateModelSpaceTransforms();
 		}
 	}
 
 
-	void AnimationController::SetAnimationState(const std::string_view stateName, Ref<AnimationState> state)
+	void AnimationInstance::UpdateModelSpaceTransforms()
 	{
-		// Load animation if it isn't already (we could not do this when animation asset was first de-serialized, since there is no way to pass parameters to the asset manager)
-		if (mSkeletonAsset && mSkeletonAsset->IsValid() && state && state->GetAnimationAsset() && state->GetAnimationAsset()->IsValid() && !state->GetAnimationAsset()->IsLoaded())
+		ozz::animation::LocalToModelJob ltm_job;
+		ltm_job.skeleton = &mController->GetSkeletonAsset()->GetSkeleton();
+		ltm_job.input = ozz::make_span(mLocalSpaceSoaTransforms);
+		ltm_job.output = ozz::make_span(mModelSpaceTransforms);
+		if (!ltm_job.Run())
 		{
-			state->GetAnimationAsset()->Load(mSkeletonAsset);
-		}
-
-		size_t existingIndex = ~0;
-		for (size_t i = 0; i < GetNumStates(); ++i) if (mStateNames[i] == stateName) break;
-
-		if (existingIndex != ~0)
-		{
-			mAnimationStates[existingIndex] = state;
-		}
-		else
-		{
-			mStateNames.emplace_back(stateName);
-			mAnimationStates.emplace_back(state);
-		}
-		if (mStateIndex == ~0)
-		{
-			SetStateIndex(0);
+			NR_CORE_ERROR("ozz animation convertion to model space failed!");
 		}
 	}
 
 
-	void AnimationController::SampleAnimation()
+	void AnimationInstance::SampleAnimation(bool isPlaying)
 	{
-		auto state = mAnimationStates[mStateIndex];
+		auto state = mController->GetAnimationState(mStateIndex);
 		ozz::animation::SamplingJob sampling_job;
 		sampling_job.animation = &state->GetAnimationAsset()->GetAnimation();
 		sampling_job.context = &mSamplingContext;
@@ -363,9 +420,8 @@ namespace NR
 		// 2) We might be playing the animation backwards.
 		// 3) We might have paused the animation, and be "debugging" it, stepping backwards (or forwards) deliberately.
 
-		if (mAnimationPlaying)
+		if (isPlaying)
 		{
-			const auto& skeleton = GetSkeletonAsset();
 			if (state->GetPlaybackSpeed() >= 0.0f)
 			{
 				// Animation is playing forwards
@@ -420,4 +476,91 @@ namespace NR
 
 		mRootPose = rootPoseNew;
 	}
-}
\ No newline at end of file
+
+
+	// Instances go back to the pool rather than being freed, so their buffers are reused by the next entity.
+	// Never destroyed, components of scenes that outlive static destruction may still return instances to it.
+	struct AnimationInstancePool
+	{
+		std::deque<AnimationInstance> Instances;
+		std::vector<AnimationInstance*> FreeInstances;
+		std::mutex Lock;
+	};
+
+	// Destroyed at exit before ozz's default allocator, which asserts that everything it handed out was freed
+	static AnimationInstancePool& GetInstancePool()
+	{
+		static AnimationInstancePool pool;
+		return pool;
+	}
+
+
+	AnimationInstanceHandle& AnimationInstanceHandle::operator=(const AnimationInstanceHandle& other)
+	{
+		if (this != &other)
+		{
+			Release();
+		}
+		return *this;
+	}
+
+
+	AnimationInstanceHandle& AnimationInstanceHandle::operator=(AnimationInstanceHandle&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			mInstance = other.mInstance;
+			other.mInstance = nullptr;
+		}
+		return *this;
+	}
+
+
+	AnimationInstance* AnimationInstanceHandle::Acquire(const Ref<AnimationController>& controller, float startTime)
+	{
+		if (!controller || !controller->CanPlay())
+		{
+			return nullptr;
+		}
+
+		if (!mInstance)
+		{
+			AnimationInstancePool& pool = GetInstancePool();
+			std::scoped_lock lock(pool.Lock);
+			if (pool.FreeInstances.empty())
+			{
+				mInstance = &pool.Instances.emplace_back();
+			}
+			else
+			{
+				mInstance = pool.FreeInstances.back();
+				pool.FreeInstances.pop_back();
+			}
+		}
+
+		if (mInstance->GetController() != controller)
+		{
+			mInstance->Initialize(controller);
+			mInstance->SetAnimationTime(startTime);
+		}
+
+		return mInstance;
+	}
+
+
+	void AnimationInstanceHandle::Release()
+	{
+		if (!mInstance)
+		{
+			return;
+		}
+
+		mInstance->Reset();
+
+		AnimationInstancePool& pool = GetInstancePool();
+		std::scoped_lock lock(pool.Lock);
+		pool.FreeInstances.push_back(mInstance);
+		mInstance = nullptr;
+	}
+}
@@ -8,6 +8,7 @@
 #include <ozz/animation/runtime/sampling_job.h>
 #include <ozz/animation/runtime/skeleton.h>
 #include <ozz/base/containers/vector.h>
+#include <ozz/base/maths/simd_math.h>
 #include <ozz/base/maths/soa_transform.h>
 #include <ozz/base/memory/unique_ptr.h>
 
@@ -130,53 +131,83 @@ namespace NR
 	};
 
 
-	// Controls which animation (or animations) is playing on a mesh.
+	// Which animations can be played on a mesh, and how.
+	// Shared by every entity referencing the asset, the playback state of each of those is in its AnimationInstance.
 	class AnimationController : public Asset
 	{
 	public:
 		virtual ~AnimationController() = default;
 
-		// Updates model space matrices (aka bone transforms) and returns root motion (will be identity if root motion is not being extracted)
-		const RootMotion& Update(float dt, bool extractRootMotion);
-
-		// animation time is a ratio. 0.0 = the start of the animation (for current state),  1.0 = the end of the animation (for current state)
-		float GetAnimationTime() const { return mAnimationTime; }
-		void SetAnimationTime(const float time) { mAnimationTime = time; }
-
-		bool IsAnimationPlaying() const { return mAnimationPlaying; }
-		void SetAnimationPlaying(const bool value) { mAnimationPlaying = value; }
-
-		uint32_t GetStateIndex() { return static_cast<uint32_t>(mStateIndex); }
-		void SetStateIndex(const uint32_t stateIndex);
-
 		Ref<SkeletonAsset> GetSkeletonAsset() { return mSkeletonAsset; }
 		Ref<SkeletonAsset> GetSkeletonAsset() const { return mSkeletonAsset; }
-		void SetSkeletonAsset(Ref<SkeletonAsset> skeletonAsset);
+		void SetSkeletonAsset(Ref<SkeletonAsset> skeletonAsset) { mSkeletonAsset = skeletonAsset; }
 
 		size_t GetNumStates() const { return mStateNames.size(); }
-		const std::string& GetStateName(const size_t stateIndex) { return mStateNames[stateIndex]; }
+		const std::string& GetStateName(const size_t stateIndex) const { return mStateNames[stateIndex]; }
 
 		Ref<AnimationState> GetAnimationState(const size_t stateIndex) { return mAnimationStates[stateIndex]; }
 		Ref<AnimationState> GetAnimationState(const size_t stateIndex) const { return mAnimationStates[stateIndex]; }
 		void SetAnimationState(const std::string_view stateName, Ref<AnimationState> state);
 
+		// True if there is a skeleton and at least one state to play on it
+		bool CanPlay() const { return mSkeletonAsset && mSkeletonAsset->IsValid() && !mAnimationStates.empty(); }
+
+		static AssetType GetStaticType() { return AssetType::AnimationController; }
+		virtual AssetType GetAssetType() const override { return GetStaticType(); }
+
+	private:
+		ozz::vector<std::string> mStateNames;
+		ozz::vector<Ref<AnimationState>> mAnimationStates;
+
+		Ref<SkeletonAsset> mSkeletonAsset;
+	};
+
+
+	// Playback of an AnimationController for one entity: current state, time, sampled pose and root motion.
+	// The controller and its clips are only read from, so any number of instances can play the same ones.
+	class AnimationInstance
+	{
+	public:
+		// Sizes the buffers for the controller's skeleton, keeping any that are already big enough, and starts its first state
+		void Initialize(const Ref<AnimationController>& controller);
+		// Lets go of the controller, the buffers are kept for the next one
+		void Reset();
+
+		const Ref<AnimationController>& GetController() const { return mController; }
+
+		// Updates local and model space bone transforms and returns root motion (will be identity if root motion is not being extracted).
+		// Only touches this instance, so instances can be updated in parallel.
+		const RootMotion& Update(float dt, bool isPlaying, bool extractRootMotion);
+
+		// animation time is a ratio. 0.0 = the start of the animation (for current state),  1.0 = the end of the animation (for current state)
+		float GetAnimationTime() const { return mAnimationTime; }
+		void SetAnimationTime(const float time) { mAnimationTime = time; }
+
+		uint32_t GetStateIndex() const { return static_cast<uint32_t>(mStateIndex); }
+		void SetStateIndex(const uint32_t stateIndex);
+
 		// Returns the motion of root bone (aka joint 0)
 		// This is the difference in pose between the most recent call to SampleAnimation() and the one before that.
 		// Only the components of root motion per the root motion mask of the current animation state are returned.
 		const RootMotion& GetRootMotion() const { return mRootMotion; }
 
+		size_t GetNumJoints() const { return mLocalTranslations.size(); }
 		glm::vec3 GetTranslation(size_t jointIndex) const { return mLocalTranslations[jointIndex]; }
 		glm::vec3 GetScale(size_t jointIndex) const { return mLocalScales[jointIndex]; }
 		glm::quat GetRotation(size_t jointIndex) const { return mLocalRotations[jointIndex]; }
 
-		static AssetType GetStaticType() { return AssetType::AnimationController; }
-		virtual AssetType GetAssetType() const override { return GetStaticType(); }
+		// Bone transforms relative to the skeleton root, in joint order of the controller's skeleton.
+		// This is what the renderer needs to build the skinning palette of a mesh with the same skeleton.
+		const ozz::vector<ozz::math::Float4x4>& GetModelSpaceTransforms() const { return mModelSpaceTransforms; }
 
 	private:
 		// sample current animation clip (aka "state") at current animation time
-		void SampleAnimation();
+		void SampleAnimation(bool isPlaying);
+		void UpdateModelSpaceTransforms();
 
 	private:
+		Ref<AnimationController> mController;
+
 		ozz::animation::SamplingJob::Context mSamplingContext;
 		ozz::vector<ozz::math::SoaTransform> mLocalSpaceSoaTransforms;
 
@@ -184,19 +215,45 @@ namespace NR
 		std::vector<glm::vec3> mLocalScales;
 		std::vector<glm::quat> mLocalRotations;
 
+		ozz::vector<ozz::math::Float4x4> mModelSpaceTransforms;
+
 		RootPose mRootPoseStart; // root pose at start of animation (for current state)
 		RootPose mRootPoseEnd;   // root pose and end of animation (for current state)
 		RootPose mRootPose;      // last sampled root pose
 		RootMotion mRootMotion;  // "motion" of root (i.e the difference between current sampled root pose and previous sampled root pose)
 
-		ozz::vector<std::string> mStateNames;
-		ozz::vector<Ref<AnimationState>> mAnimationStates;
-
-		Ref<SkeletonAsset> mSkeletonAsset;
-
 		float mPreviousAnimationTime = -FLT_MAX;
 		float mAnimationTime = 0.0f;
 		size_t mStateIndex = ~0;
-		bool mAnimationPlaying = true;
 	};
-}
\ No newline at end of file
+
+
+	// Owns a pooled AnimationInstance, this is what AnimationComponent holds.
+	// Copying a component doesn't copy its playback state, the copy gets an instance of its own when it's first used.
+	class AnimationInstanceHandle
+	{
+	public:
+		AnimationInstanceHandle() = default;
+		AnimationInstanceHandle(const AnimationInstanceHandle&) {}
+		AnimationInstanceHandle(AnimationInstanceHandle&& other) noexcept
+			: mInstance(other.mInstance)
+		{
+			other.mInstance = nullptr;
+		}
+		~AnimationInstanceHandle() { Release(); }
+
+		AnimationInstanceHandle& operator=(const AnimationInstanceHandle& other);
+		AnimationInstanceHandle& operator=(AnimationInstanceHandle&& other) noexcept;
+
+		// nullptr until the instance has been created by Acquire
+		AnimationInstance* Get() const { return mInstance; }
+
+		// Creates the instance on first use, and restarts it at startTime whenever the controller has changed.
+		// Returns nullptr if the controller has nothing to play.
+		AnimationInstance* Acquire(const Ref<AnimationController>& controller, float startTime);
+		void Release();
+
+	private:
+		AnimationInstance* mInstance = nullptr;
+	};
+}
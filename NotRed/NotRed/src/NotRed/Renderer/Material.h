@@ -17,6 +17,16 @@ namespace NR
 		TwoSided = 1 << 3
 	};
 
+	// A uniform of the material buffer resolved once by Material::GetUniformHandle. Setting a value through it is a
+	// bounds-checked copy into the material's storage, without looking the property up again.
+	struct MaterialUniformHandle
+	{
+		uint32_t Offset = 0;
+		uint32_t Size = 0;
+
+		bool IsValid() const { return Size != 0; }
+	};
+
 	class Material : public RefCounted
 	{
 		friend class Material;
@@ -27,43 +37,92 @@ namespace NR
 
 		virtual void Invalidate() = 0;
 
-		virtual void Set(const std::string& name, uint32_t value) = 0;
-
-		virtual void Set(const std::string& name, bool value) = 0;
-		virtual void Set(const std::string& name, int value) = 0;
-		virtual void Set(const std::string& name, float value) = 0;
-
-		virtual void Set(const std::string& name, const glm::ivec2& value) = 0;
-		virtual void Set(const std::string& name, const glm::ivec3& value) = 0;
-		virtual void Set(const std::string& name, const glm::ivec4& value) = 0;
-		virtual void Set(const std::string& name, const glm::vec2& value) = 0;
-		virtual void Set(const std::string& name, const glm::vec3& value) = 0;
-		virtual void Set(const std::string& name, const glm::vec4& value) = 0;
-		virtual void Set(const std::string& name, const glm::mat3& value) = 0;
-		virtual void Set(const std::string& name, const glm::mat4& value) = 0;
-
-		virtual void Set(const std::string& name, const Ref<Texture2D>& texture) = 0;
-		virtual void Set(const std::string& name, const Ref<TextureCube>& texture) = 0;
-		virtual void Set(const std::string& name, const Ref<Image2D>& image) = 0;
-		virtual void Set(const std::string& name, const Ref<Texture2D>& texture, uint32_t arrayIndex) = 0;
-
-		virtual uint32_t& GetUInt(const std::string& name) = 0;
-
-		virtual bool& GetBool(const std::string& name) = 0;
-		virtual float& GetFloat(const std::string& name) = 0;
-		virtual int32_t& GetInt(const std::string& name) = 0;
-
-		virtual glm::vec2& GetVector2(const std::string& name) = 0;
-		virtual glm::vec3& GetVector3(const std::string& name) = 0;
-		virtual glm::vec4& GetVector4(const std::string& name) = 0;
-		virtual glm::mat3& GetMatrix3(const std::string& name) = 0;
-		virtual glm::mat4& GetMatrix4(const std::string& name) = 0;
-
-		virtual Ref<Texture2D> GetTexture2D(const std::string& name) = 0;
-		virtual Ref<TextureCube> GetTextureCube(const std::string& name) = 0;
-
-		virtual Ref<Texture2D> TryGetTexture2D(const std::string& name) = 0;
-		virtual Ref<TextureCube> TryGetTextureCube(const std::string& name) = 0;
+		virtual MaterialUniformHandle GetUniformHandle(MaterialPropertyID id) = 0;
+		virtual void SetUniformData(const MaterialUniformHandle& handle, const void* data, uint32_t size) = 0;
+
+		template<typename T>
+		void Set(const MaterialUniformHandle& handle, const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be copied into a uniform");
+			SetUniformData(handle, &value, (uint32_t)sizeof(T));
+		}
+
+		virtual void Set(MaterialPropertyID id, uint32_t value) = 0;
+
+		virtual void Set(MaterialPropertyID id, bool value) = 0;
+		virtual void Set(MaterialPropertyID id, int value) = 0;
+		virtual void Set(MaterialPropertyID id, float value) = 0;
+
+		virtual void Set(MaterialPropertyID id, const glm::ivec2& value) = 0;
+		virtual void Set(MaterialPropertyID id, const glm::ivec3& value) = 0;
+		virtual void Set(MaterialPropertyID id, const glm::ivec4& value) = 0;
+		virtual void Set(MaterialPropertyID id, const glm::vec2& value) = 0;
+		virtual void Set(MaterialPropertyID id, const glm::vec3& value) = 0;
+		virtual void Set(MaterialPropertyID id, const glm::vec4& value) = 0;
+		virtual void Set(MaterialPropertyID id, const glm::mat3& value) = 0;
+		virtual void Set(MaterialPropertyID id, const glm::mat4& value) = 0;
+
+		virtual void Set(MaterialPropertyID id, const Ref<Texture2D>& texture) = 0;
+		virtual void Set(MaterialPropertyID id, const Ref<TextureCube>& texture) = 0;
+		virtual void Set(MaterialPropertyID id, const Ref<Image2D>& image) = 0;
+		virtual void Set(MaterialPropertyID id, const Ref<Texture2D>& texture, uint32_t arrayIndex) = 0;
+
+		virtual uint32_t& GetUInt(MaterialPropertyID id) = 0;
+
+		virtual bool& GetBool(MaterialPropertyID id) = 0;
+		virtual float& GetFloat(MaterialPropertyID id) = 0;
+		virtual int32_t& GetInt(MaterialPropertyID id) = 0;
+
+		virtual glm::vec2& GetVector2(MaterialPropertyID id) = 0;
+		virtual glm::vec3& GetVector3(MaterialPropertyID id) = 0;
+		virtual glm::vec4& GetVector4(MaterialPropertyID id) = 0;
+		virtual glm::mat3& GetMatrix3(MaterialPropertyID id) = 0;
+		virtual glm::mat4& GetMatrix4(MaterialPropertyID id) = 0;
+
+		virtual Ref<Texture2D> GetTexture2D(MaterialPropertyID id) = 0;
+		virtual Ref<TextureCube> GetTextureCube(MaterialPropertyID id) = 0;
+
+		virtual Ref<Texture2D> TryGetTexture2D(MaterialPropertyID id) = 0;
+		virtual Ref<TextureCube> TryGetTextureCube(MaterialPropertyID id) = 0;
+
+		// Name based overloads, these hash the name on every call
+		void Set(const std::string& name, uint32_t value) { Set(MaterialPropertyID(name), value); }
+
+		void Set(const std::string& name, bool value) { Set(MaterialPropertyID(name), value); }
+		void Set(const std::string& name, int value) { Set(MaterialPropertyID(name), value); }
+		void Set(const std::string& name, float value) { Set(MaterialPropertyID(name), value); }
+
+		void Set(const std::string& name, const glm::ivec2& value) { Set(MaterialPropertyID(name), value); }
+		void Set(const std::string& name, const glm::ivec3& value) { Set(MaterialPropertyID(name), value); }
+		void Set(const std::string& name, const glm::ivec4& value) { Set(MaterialPropertyID(name), value); }
+		void Set(const std::string& name, const glm::vec2& value) { Set(MaterialPropertyID(name), value); }
+		void Set(const std::string& name, const glm::vec3& value) { Set(MaterialPropertyID(name), value); }
+		void Set(const std::string& name, const glm::vec4& value) { Set(MaterialPropertyID(name), value); }
+		void Set(const std::string& name, const glm::mat3& value) { Set(MaterialPropertyID(name), value); }
+		void Set(const std::string& name, const glm::mat4& value) { Set(MaterialPropertyID(name), value); }
+
+		void Set(const std::string& name, const Ref<Texture2D>& texture) { Set(MaterialPropertyID(name), texture); }
+		void Set(const std::string& name, const Ref<TextureCube>& texture) { Set(MaterialPropertyID(name), texture); }
+		void Set(const std::string& name, const Ref<Image2D>& image) { Set(MaterialPropertyID(name), image); }
+		void Set(const std::string& name, const Ref<Texture2D>& texture, uint32_t arrayIndex) { Set(MaterialPropertyID(name), texture, arrayIndex); }
+
+		uint32_t& GetUInt(const std::string& name) { return GetUInt(MaterialPropertyID(name)); }
+
+		bool& GetBool(const std::string& name) { return GetBool(MaterialPropertyID(name)); }
+		float& GetFloat(const std::string& name) { return GetFloat(MaterialPropertyID(name)); }
+		int32_t& GetInt(const std::string& name) { return GetInt(MaterialPropertyID(name)); }
+
+		glm::vec2& GetVector2(const std::string& name) { return GetVector2(MaterialPropertyID(name)); }
+		glm::vec3& GetVector3(const std::string& name) { return GetVector3(MaterialPropertyID(name)); }
+		glm::vec4& GetVector4(const std::string& name) { return GetVector4(MaterialPropertyID(name)); }
+		glm::mat3& GetMatrix3(const std::string& name) { return GetMatrix3(MaterialPropertyID(name)); }
+		glm::mat4& GetMatrix4(const std::string& name) { return GetMatrix4(MaterialPropertyID(name)); }
+
+		Ref<Texture2D> GetTexture2D(const std::string& name) { return GetTexture2D(MaterialPropertyID(name)); }
+		Ref<TextureCube> GetTextureCube(const std::string& name) { return GetTextureCube(MaterialPropertyID(name)); }
+
+		Ref<Texture2D> TryGetTexture2D(const std::string& name) { return TryGetTexture2D(MaterialPropertyID(name)); }
+		Ref<TextureCube> TryGetTextureCube(const std::string& name) { return TryGetTextureCube(MaterialPropertyID(name)); }
 
 		virtual uint32_t GetFlags() const = 0;
 		virtual bool GetFlag(MaterialFlag flag) const = 0;
@@ -13,6 +13,7 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/Importer.hpp>
+#include <assimp/DefaultIOSystem.h>
 
 #include <ozz/animation/offline/raw_skeleton.h>
 #include <ozz/animation/offline/skeleton_builder.h>
@@ -25,9 +26,12 @@
 
 #include "imgui/imgui.h"
 
+#include "NotRed/Renderer/MeshCache.h"
 #include "NotRed/Renderer/Renderer.h"
 #include "NotRed/Renderer/VertexBuffer.h"
 
+#include "NotRed/Core/Timer.h"
+
 #include "NotRed/Debug/Profiler.h"
 
 namespace NR 
@@ -84,6 +88,27 @@ namespace NR
 			return result;
 		}
 
+		// Texture paths are stored as the mesh file references them, relative to the mesh file
+		static Ref<Texture2D> LoadMaterialTexture(const std::string& meshPath, const std::string& texturePath, bool standardRGB = false)
+		{
+			if (texturePath.empty())
+				return nullptr;
+
+			// TODO: Temp - this should be handled by NR's filesystem
+			std::filesystem::path path = std::filesystem::path(meshPath).parent_path() / texturePath;
+
+			TextureProperties props;
+			props.StandardRGB = standardRGB;
+			auto texture = Texture2D::Create(path.string(), props);
+			if (!texture->Loaded())
+			{
+				NR_CORE_ERROR("Could not load texture: {0}", path.string());
+				return nullptr;
+			}
+
+			return texture;
+		}
+
 #if MESH_DEBUG_LOG
 		void PrintNode(aiNode* node, size_t depth)
 		{
@@ -110,6 +135,29 @@ namespace NR
 
 	}
 
+	// Remembers every file the importer opens, the cooked mesh is outdated once one of them changes
+	class RecordingIOSystem : public Assimp::DefaultIOSystem
+	{
+	public:
+		RecordingIOSystem(std::vector<std::string>& openedFiles)
+			: mOpenedFiles(openedFiles)
+		{}
+
+		Assimp::IOStream* Open(const char* file, const char* mode = "rb") override
+		{
+			Assimp::IOStream* stream = Assimp::DefaultIOSystem::Open(file, mode);
+			if (stream)
+			{
+				mOpenedFiles.emplace_back(file);
+			}
+
+			return stream;
+		}
+
+	private:
+		std::vector<std::string>& mOpenedFiles;
+	};
+
 	struct LogStream : public Assimp::LogStream
 	{
 		static void Initialize()
@@ -131,24 +179,165 @@ namespace NR
 	// MeshSource //////////////////////////////////////////
 	////////////////////////////////////////////////////////
 
-	MeshSource::MeshSource(const std::string& filename)
+	MeshSource::MeshSource(const std::string& filename, bool createGPUResources)
 		: mFilePath(filename)
 	{
-		LogStream::Initialize();
-
 		NR_CORE_INFO("Loading mesh: {0}", filename.c_str());
 
-		mImporter = std::make_unique<Assimp::Importer>();
+		Timer timer;
+		if (MeshCache::Load(filename, *this))
+		{
+			NR_CORE_INFO("Loaded cooked mesh '{0}' in {1:.2f}ms", filename, timer.ElapsedMillis());
+		}
+		else
+		{
+			std::vector<std::string> importedFiles;
+			if (!Import(filename, importedFiles))
+			{
+				ModifyFlags(AssetFlag::Invalid);
+				return;
+			}
 
-		const aiScene* scene = mImporter->ReadFile(filename, s_MeshImportFlags);
-		if (!scene || !scene->HasMeshes())
+			MeshCache::Store(filename, *this, importedFiles);
+			NR_CORE_INFO("Imported mesh '{0}' in {1:.2f}ms", filename, timer.ElapsedMillis());
+		}
+
+		BuildTriangleCache();
+		if (!createGPUResources)
 		{
-			NR_CORE_ERROR("Failed to load mesh file: {0}", filename);
-			ModifyFlags(AssetFlag::Invalid);
 			return;
 		}
 
-		mScene = scene;
+		CreateMaterials();
+
+		mVertexBuffer = VertexBuffer::Create(mVertices.data(), (uint32_t)(mVertices.size() * sizeof(Vertex)));
+		if (IsRigged())
+		{
+			mBoneInfluenceBuffer = VertexBuffer::Create(mBoneInfluences.data(), (uint32_t)(mBoneInfluences.size() * sizeof(BoneInfluence)));
+		}
+
+		mIndexBuffer = IndexBuffer::Create(mIndices.data(), (uint32_t)(mIndices.size() * sizeof(Index)));
+	}
+
+	MeshSource::MeshSource(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, const glm::mat4& transform)
+		: mVertices(vertices), mIndices(indices)
+	{
+		Submesh submesh;
+		submesh.BaseVertex = 0;
+		submesh.BaseIndex = 0;
+		submesh.IndexCount = (uint32_t)indices.size() * 3u;
+		submesh.Transform = transform;
+		mSubmeshes.push_back(submesh);
+
+		mVertexBuffer = VertexBuffer::Create(mVertices.data(), (uint32_t)(mVertices.size() * sizeof(Vertex)));
+		mIndexBuffer = IndexBuffer::Create(mIndices.data(), (uint32_t)(mIndices.size() * sizeof(Index)));
+	}
+
+
+	MeshSource::MeshSource(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, const std::vector<Submesh>& submeshes)
+		: mVertices(vertices), mIndices(indices), mSubmeshes(submeshes)
+	{
+		mVertexBuffer = VertexBuffer::Create(mVertices.data(), (uint32_t)(mVertices.size() * sizeof(Vertex)));
+		mIndexBuffer = IndexBuffer::Create(mIndices.data(), (uint32_t)(mIndices.size() * sizeof(Index)));
+	}
+
+	MeshSource::MeshSource(int squaresCount)
+	{
+		/*{ TODO
+			for (uint32_t i = 0; i < particleCount; ++i)
+			{
+				ParticleVertex leftBot;
+				leftBot.Position = { -0.5f, 0.0f, -0.5f };
+				leftBot.Index = (float)i;
+				mParticleVertices.push_back(leftBot);
+
+				ParticleVertex rightBot;
+				rightBot.Position = { 0.5f, 0.0f, -0.5f };
+				rightBot.Index = (float)i;
+				mParticleVertices.push_back(rightBot);
+
+				ParticleVertex leftTop;
+				leftTop.Position = { -0.5f, 0.0f,  0.5f };
+				leftTop.Index = (float)i;
+				mParticleVertices.push_back(leftTop);
+
+				ParticleVertex rightTop;
+				rightTop.Position = { 0.5f, 0.0f,  0.5f };
+				rightTop.Index = (float)i;
+				mParticleVertices.push_back(rightTop);
+
+				unsigned int index = i * 4;
+				Index indexA = { index + 0, index + 1, index + 2 };
+				Index indexB = { index + 1, index + 3, index + 2 };
+				mIndices.push_back(indexA);
+				mIndices.push_back(indexB);
+			}
+		}
+
+		auto mi = Material::Create(Renderer::GetShaderLibrary()->Get("Particle"), "Particle-Effect");
+		mi->Set("uGalaxySpecs.StarColor", glm::vec3(1.0f, 1.0f, 1.0f));
+		mi->Set("uGalaxySpecs.DustColor", glm::vec3(0.388f, 0.333f, 1.0f));
+		mi->Set("uGalaxySpecs.h2RegionColor", glm::vec3(0.8f, 0.071f, 0.165f));
+		mMaterials.push_back(mi);
+
+		Submesh& submesh = mSubmeshes.emplace_back();
+		submesh.BaseVertex = 0;
+		submesh.BaseIndex = 0;
+		submesh.IndexCount = mIndices.size() * 3;
+		submesh.VertexCount = mParticleVertices.size();
+		submesh.Transform = glm::mat4(1.0f);
+		submesh.MaterialIndex = 0;
+		submesh.MeshName = "Particles";
+
+		mVertexBuffer = VertexBuffer::Create(mParticleVertices.data(), mParticleVertices.size() * sizeof(ParticleVertex));
+		mIndexBuffer = IndexBuffer::Create(mIndices.data(), mIndices.size() * sizeof(Index));*/
+	}
+
+	MeshSource::~MeshSource()
+	{
+	}
+
+	const TriangleBVH& MeshSource::GetTriangleBVH(uint32_t index) const
+	{
+		std::scoped_lock<std::mutex> lock(mTriangleBVHMutex);
+
+		auto it = mTriangleBVHs.find(index);
+		if (it != mTriangleBVHs.end())
+			return it->second;
+
+		std::vector<glm::vec3> positions;
+		auto triangles = mTriangleCache.find(index);
+		if (triangles != mTriangleCache.end())
+		{
+			positions.reserve(triangles->second.size() * 3);
+			for (const auto& triangle : triangles->second)
+			{
+				positions.push_back(triangle.V0.Position);
+				positions.push_back(triangle.V1.Position);
+				positions.push_back(triangle.V2.Position);
+			}
+		}
+
+		TriangleBVH& bvh = mTriangleBVHs[index];
+		bvh.Build(std::move(positions));
+		return bvh;
+	}
+
+	bool MeshSource::Import(const std::string& filename, std::vector<std::string>& importedFiles)
+	{
+		NR_PROFILE_FUNC();
+
+		LogStream::Initialize();
+
+		// Everything the importer produced is copied out, so the scene is released once the import is done
+		Assimp::Importer importer;
+		importer.SetIOHandler(new RecordingIOSystem(importedFiles));
+		const aiScene* scene = importer.ReadFile(filename, s_MeshImportFlags);
+		if (!scene || !scene->HasMeshes())
+		{
+			NR_CORE_ERROR("Failed to load mesh file: {0}", filename);
+			return false;
+		}
 
 		ozz::animation::offline::RawSkeleton rawSkeleton;
 		if (OZZImporterAssimp::ExtractRawSkeleton(scene, rawSkeleton))
@@ -226,8 +415,6 @@ namespace NR
 				NR_CORE_ASSERT(mesh->mFaces[i].mNumIndices == 3, "Must have 3 indices.");
 				Index index = { mesh->mFaces[i].mIndices[0], mesh->mFaces[i].mIndices[1], mesh->mFaces[i].mIndices[2] };
 				mIndices.push_back(index);
-
-				mTriangleCache[m].emplace_back(mVertices[index.V1 + submesh.BaseVertex], mVertices[index.V2 + submesh.BaseVertex], mVertices[index.V3 + submesh.BaseVertex]);
 			}
 		}
 
@@ -236,7 +423,8 @@ namespace NR
 		Utils::PrintNode(scene->mRootNode, 0);
 #endif
 
-		TraverseNodes(scene->mRootNode);
+		mNodes.emplace_back();
+		TraverseNodes(scene->mRootNode, 0);
 
 		for (const auto& submesh : mSubmeshes)
 		{
@@ -324,41 +512,35 @@ namespace NR
 		}
 
 		// Materials
-		Ref<Texture2D> whiteTexture = Renderer::GetWhiteTexture();
 		if (scene->HasMaterials())
 		{
 			NR_MESH_LOG("---- Materials - {0} ----", filename);
 
-			mMaterials.resize(scene->mNumMaterials);
+			mMaterialDescriptions.resize(scene->mNumMaterials);
 
 			for (uint32_t i = 0; i < scene->mNumMaterials; ++i)
 			{
 				auto aiMaterial = scene->mMaterials[i];
 				auto aiMaterialName = aiMaterial->GetName();
-				NR::Ref<Material> mi = Material::Create(Renderer::GetShaderLibrary()->Get("PBR_Static"), aiMaterialName.data);
-				mMaterials[i] = mi;
+				MeshMaterialDescription& material = mMaterialDescriptions[i];
+				material.Name = aiMaterialName.data;
 
 				NR_MESH_LOG("  {0} (Index = {1})", aiMaterialName.data, i);
 				aiString aiTexPath;
 				uint32_t textureCount = aiMaterial->GetTextureCount(aiTextureType_DIFFUSE);
 				NR_MESH_LOG("    TextureCount = {0}", textureCount);
 
-				glm::vec3 albedoColor(0.8f);
-				float emission = 0.0f;
 				aiColor3D aiColor, aiEmission;
 				if (aiMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aiColor) == AI_SUCCESS)
 				{
-					albedoColor = { aiColor.r, aiColor.g, aiColor.b };
+					material.AlbedoColor = { aiColor.r, aiColor.g, aiColor.b };
 				}
 
 				if (aiMaterial->Get(AI_MATKEY_COLOR_EMISSIVE, aiEmission) == AI_SUCCESS)
 				{
-					emission = aiEmission.r;
+					material.Emission = aiEmission.r;
 				}
 
-				mi->Set("uMaterialUniforms.AlbedoColor", albedoColor);
-				mi->Set("uMaterialUniforms.Emission", emission);
-
 				float shininess, metalness;
 				if (aiMaterial->Get(AI_MATKEY_SHININESS, shininess) != aiReturn_SUCCESS)
 					shininess = 80.0f; // Default value
@@ -366,330 +548,134 @@ namespace NR
 				if (aiMaterial->Get(AI_MATKEY_REFLECTIVITY, metalness) != aiReturn_SUCCESS)
 					metalness = 0.0f;
 
-				float roughness = 1.0f - glm::sqrt(shininess / 100.0f);
+				material.Roughness = 1.0f - glm::sqrt(shininess / 100.0f);
+				material.Metalness = metalness;
 				NR_MESH_LOG("    COLOR = {0}, {1}, {2}", aiColor.r, aiColor.g, aiColor.b);
-				NR_MESH_LOG("    ROUGHNESS = {0}", roughness);
-				NR_MESH_LOG("    METALNESS = {0}", metalness);
-				bool hasAlbedoMap = aiMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &aiTexPath) == AI_SUCCESS;
-				bool fallback = !hasAlbedoMap;
-				if (hasAlbedoMap)
-				{
-					// TODO: Temp - this should be handled by NR's filesystem
-					std::filesystem::path path = filename;
-					auto parentPath = path.parent_path();
-					parentPath /= std::string(aiTexPath.data);
-					std::string texturePath = parentPath.string();
-					NR_MESH_LOG("    Albedo map path = {0}", texturePath);
-					TextureProperties props;
-					props.StandardRGB = true;
-					auto texture = Texture2D::Create(texturePath, props);
-					if (texture->Loaded())
-					{
-						mi->Set("uAlbedoTexture", texture);
-						mi->Set("uMaterialUniforms.AlbedoColor", glm::vec3(1.0f));
-					}
-					else
-					{
-						NR_CORE_ERROR("Could not load texture: {0}", texturePath);
-						fallback = true;
-					}
-				}
+				NR_MESH_LOG("    ROUGHNESS = {0}", material.Roughness);
+				NR_MESH_LOG("    METALNESS = {0}", material.Metalness);
 
-				if (fallback)
+				if (aiMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &aiTexPath) == AI_SUCCESS)
 				{
-					NR_MESH_LOG("    No albedo map");
-					mi->Set("uAlbedoTexture", whiteTexture);
+					material.AlbedoTexturePath = aiTexPath.data;
+					NR_MESH_LOG("    Albedo map path = {0}", material.AlbedoTexturePath);
 				}
 
-				// Normal maps
-				bool hasNormalMap = aiMaterial->GetTexture(aiTextureType_NORMALS, 0, &aiTexPath) == AI_SUCCESS;
-				fallback = !hasNormalMap;
-				if (hasNormalMap)
+				if (aiMaterial->GetTexture(aiTextureType_NORMALS, 0, &aiTexPath) == AI_SUCCESS)
 				{
-					// TODO: Temp - this should be handled by NR's filesystem
-					std::filesystem::path path = filename;
-					auto parentPath = path.parent_path();
-					parentPath /= std::string(aiTexPath.data);
-					std::string texturePath = parentPath.string();
-					NR_MESH_LOG("    Normal map path = {0}", texturePath);
-					auto texture = Texture2D::Create(texturePath);
-					if (texture->Loaded())
-					{
-						mi->Set("uNormalTexture", texture);
-						mi->Set("uMaterialUniforms.UseNormalMap", true);
-					}
-					else
-					{
-						NR_CORE_ERROR("    Could not load texture: {0}", texturePath);
-						fallback = true;
-					}
+					material.NormalTexturePath = aiTexPath.data;
+					NR_MESH_LOG("    Normal map path = {0}", material.NormalTexturePath);
 				}
 
-				if (fallback)
+				if (aiMaterial->GetTexture(aiTextureType_SHININESS, 0, &aiTexPath) == AI_SUCCESS)
 				{
-					NR_MESH_LOG("    No normal map");
-					mi->Set("uNormalTexture", whiteTexture);
-					mi->Set("uMaterialUniforms.UseNormalMap", false);
+					material.RoughnessTexturePath = aiTexPath.data;
+					NR_MESH_LOG("    Roughness map path = {0}", material.RoughnessTexturePath);
 				}
 
-				// Roughness map
-				bool hasRoughnessMap = aiMaterial->GetTexture(aiTextureType_SHININESS, 0, &aiTexPath) == AI_SUCCESS;
-				fallback = !hasRoughnessMap;
-				if (hasRoughnessMap)
-				{
-					// TODO: Temp - this should be handled by NR's filesystem
-					std::filesystem::path path = filename;
-					auto parentPath = path.parent_path();
-					parentPath /= std::string(aiTexPath.data);
-					std::string texturePath = parentPath.string();
-					NR_MESH_LOG("    Roughness map path = {0}", texturePath);
-					auto texture = Texture2D::Create(texturePath);
-					if (texture->Loaded())
-					{
-						mi->Set("uRoughnessTexture", texture);
-						mi->Set("uMaterialUniforms.Roughness", 1.0f);
-					}
-					else
-					{
-						NR_CORE_ERROR("    Could not load texture: {0}", texturePath);
-						fallback = true;
-					}
-				}
-
-				if (fallback)
-				{
-					NR_MESH_LOG("    No roughness map");
-					mi->Set("uRoughnessTexture", whiteTexture);
-					mi->Set("uMaterialUniforms.Roughness", roughness);
-				}
-
-#if 0
 				// Metalness map (or is it??)
-				if (aiMaterial->Get("$raw.ReflectionFactor|file", aiPTI_String, 0, aiTexPath) == AI_SUCCESS)
-				{
-					// TODO: Temp - this should be handled by NR's filesystem
-					std::filesystem::path path = filename;
-					auto parentPath = path.parent_path();
-					parentPath /= std::string(aiTexPath.data);
-					std::string texturePath = parentPath.string();
-
-					auto texture = Texture2D::Create(texturePath);
-					if (texture->Loaded())
-					{
-						NR_MESH_LOG("    Metalness map path = {0}", texturePath);
-						mi->Set("uMetalnessTexture", texture);
-						mi->Set("uMetalnessTexToggle", 1.0f);
-					}
-					else
-					{
-						NR_CORE_ERROR("Could not load texture: {0}", texturePath);
-					}
-				}
-				else
-				{
-					NR_MESH_LOG("    No metalness texture");
-					mi->Set("uMetalness", metalness);
-				}
-#endif
-
-				bool metalnessTextureFound = false;
 				for (uint32_t p = 0; p < aiMaterial->mNumProperties; p++)
 				{
 					auto prop = aiMaterial->mProperties[p];
-
-#if DEBUG_PRINT_ALL_PROPS
-					NR_MESH_LOG("Material Property:");
-					NR_MESH_LOG("  Name = {0}", prop->mKey.data);
-					// NR_MESH_LOG("  Type = {0}", prop->mType);
-					// NR_MESH_LOG("  Size = {0}", prop->mDataLength);
-					float data = *(float*)prop->mData;
-					NR_MESH_LOG("  Value = {0}", data);
-
-					switch (prop->mSemantic)
-					{
-					case aiTextureType_NONE:
-						NR_MESH_LOG("  Semantic = aiTextureType_NONE");
-						break;
-					case aiTextureType_DIFFUSE:
-						NR_MESH_LOG("  Semantic = aiTextureType_DIFFUSE");
-						break;
-					case aiTextureType_SPECULAR:
-						NR_MESH_LOG("  Semantic = aiTextureType_SPECULAR");
-						break;
-					case aiTextureType_AMBIENT:
-						NR_MESH_LOG("  Semantic = aiTextureType_AMBIENT");
-						break;
-					case aiTextureType_EMISSIVE:
-						NR_MESH_LOG("  Semantic = aiTextureType_EMISSIVE");
-						break;
-					case aiTextureType_HEIGHT:
-						NR_MESH_LOG("  Semantic = aiTextureType_HEIGHT");
-						break;
-					case aiTextureType_NORMALS:
-						NR_MESH_LOG("  Semantic = aiTextureType_NORMALS");
-						break;
-					case aiTextureType_SHININESS:
-						NR_MESH_LOG("  Semantic = aiTextureType_SHININESS");
-						break;
-					case aiTextureType_OPACITY:
-						NR_MESH_LOG("  Semantic = aiTextureType_OPACITY");
-						break;
-					case aiTextureType_DISPLACEMENT:
-						NR_MESH_LOG("  Semantic = aiTextureType_DISPLACEMENT");
-						break;
-					case aiTextureType_LIGHTMAP:
-						NR_MESH_LOG("  Semantic = aiTextureType_LIGHTMAP");
-						break;
-					case aiTextureType_REFLECTION:
-						NR_MESH_LOG("  Semantic = aiTextureType_REFLECTION");
-						break;
-					case aiTextureType_UNKNOWN:
-						NR_MESH_LOG("  Semantic = aiTextureType_UNKNOWN");
-						break;
-					}
-#endif
-
-					if (prop->mType == aiPTI_String)
+					if (prop->mType == aiPTI_String && std::string(prop->mKey.data) == "$raw.ReflectionFactor|file")
 					{
 						uint32_t strLength = *(uint32_t*)prop->mData;
-						std::string str(prop->mData + 4, strLength);
-
-						std::string key = prop->mKey.data;
-						if (key == "$raw.ReflectionFactor|file")
-						{
-							// TODO: Temp - this should be handled by NR's filesystem
-							std::filesystem::path path = filename;
-							auto parentPath = path.parent_path();
-							parentPath /= str;
-							std::string texturePath = parentPath.string();
-							NR_MESH_LOG("    Metalness map path = {0}", texturePath);
-							auto texture = Texture2D::Create(texturePath);
-							if (texture->Loaded())
-							{
-								metalnessTextureFound = true;
-								mi->Set("uMetalnessTexture", texture);
-								mi->Set("uMaterialUniforms.Metalness", 1.0f);
-							}
-							else
-							{
-								NR_CORE_ERROR("    Could not load texture: {0}", texturePath);
-							}
-							break;
-						}
+						material.MetalnessTexturePath = std::string(prop->mData + 4, strLength);
+						NR_MESH_LOG("    Metalness map path = {0}", material.MetalnessTexturePath);
+						break;
 					}
 				}
-
-				fallback = !metalnessTextureFound;
-				if (fallback)
-				{
-					NR_MESH_LOG("    No metalness map");
-					mi->Set("uMetalnessTexture", whiteTexture);
-					mi->Set("uMaterialUniforms.Metalness", metalness);
-
-				}
 			}
 			NR_MESH_LOG("------------------------");
 		}
 		else
 		{
-			auto mi = Material::Create(Renderer::GetShaderLibrary()->Get("PBR_Static"), "NR-Default");
-			mi->Set("uMaterialUniforms.AlbedoColor", glm::vec3(0.8f));
-			mi->Set("uMaterialUniforms.Emission", 0.0f);
-			mi->Set("uMaterialUniforms.Metalness", 0.0f);
-			mi->Set("uMaterialUniforms.Roughness", 0.8f);
-			mi->Set("uMaterialUniforms.UseNormalMap", false);
-
-			mi->Set("uAlbedoTexture", whiteTexture);
-			mi->Set("uMetalnessTexture", whiteTexture);
-			mi->Set("uRoughnessTexture", whiteTexture);
-			mMaterials.push_back(mi);
-		}
-
-		mVertexBuffer = VertexBuffer::Create(mVertices.data(), (uint32_t)(mVertices.size() * sizeof(Vertex)));
-		if (IsRigged())
-		{
-			mBoneInfluenceBuffer = VertexBuffer::Create(mBoneInfluences.data(), (uint32_t)(mBoneInfluences.size() * sizeof(BoneInfluence)));
+			MeshMaterialDescription& material = mMaterialDescriptions.emplace_back();
+			material.Name = "NR-Default";
 		}
 
-		mIndexBuffer = IndexBuffer::Create(mIndices.data(), (uint32_t)(mIndices.size() * sizeof(Index)));
+		return true;
 	}
 
-	MeshSource::MeshSource(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, const glm::mat4& transform)
-		: mVertices(vertices), mIndices(indices)
+	void MeshSource::BuildTriangleCache()
 	{
-		Submesh submesh;
-		submesh.BaseVertex = 0;
-		submesh.BaseIndex = 0;
-		submesh.IndexCount = (uint32_t)indices.size() * 3u;
-		submesh.Transform = transform;
-		mSubmeshes.push_back(submesh);
+		mTriangleCache.clear();
+		for (uint32_t m = 0; m < (uint32_t)mSubmeshes.size(); ++m)
+		{
+			const Submesh& submesh = mSubmeshes[m];
+			// Cooked meshes are validated when they are loaded, imported ones could still reference data outside the mesh
+			if ((uint64_t)submesh.BaseVertex + submesh.VertexCount > mVertices.size())
+			{
+				NR_CORE_WARN("Submesh {0} of '{1}' references vertices outside the mesh, it has no triangle cache", m, mFilePath);
+				continue;
+			}
 
-		mVertexBuffer = VertexBuffer::Create(mVertices.data(), (uint32_t)(mVertices.size() * sizeof(Vertex)));
-		mIndexBuffer = IndexBuffer::Create(mIndices.data(), (uint32_t)(mIndices.size() * sizeof(Index)));
-	}
+			const uint32_t firstTriangle = submesh.BaseIndex / 3;
+			const uint32_t triangleCount = std::min(submesh.IndexCount / 3, firstTriangle < mIndices.size() ? (uint32_t)mIndices.size() - firstTriangle : 0u);
+			if (triangleCount == 0)
+				continue;
 
+			auto& triangles = mTriangleCache[m];
+			triangles.reserve(triangleCount);
+			uint32_t invalidTriangles = 0;
+			for (uint32_t i = firstTriangle; i < firstTriangle + triangleCount; ++i)
+			{
+				const Index& index = mIndices[i];
+				if (index.V1 >= submesh.VertexCount || index.V2 >= submesh.VertexCount || index.V3 >= submesh.VertexCount)
+				{
+					invalidTriangles++;
+					continue;
+				}
 
-	MeshSource::MeshSource(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, const std::vector<Submesh>& submeshes)
-		: mVertices(vertices), mIndices(indices), mSubmeshes(submeshes)
-	{
-		mVertexBuffer = VertexBuffer::Create(mVertices.data(), (uint32_t)(mVertices.size() * sizeof(Vertex)));
-		mIndexBuffer = IndexBuffer::Create(mIndices.data(), (uint32_t)(mIndices.size() * sizeof(Index)));
+				triangles.emplace_back(mVertices[index.V1 + submesh.BaseVertex], mVertices[index.V2 + submesh.BaseVertex], mVertices[index.V3 + submesh.BaseVertex]);
+			}
+
+			if (invalidTriangles > 0)
+			{
+				NR_CORE_WARN("Submesh {0} of '{1}' has {2} triangles with indices outside of it, they were skipped", m, mFilePath, invalidTriangles);
+			}
+		}
 	}
 
-	MeshSource::MeshSource(int squaresCount)
+	void MeshSource::CreateMaterials()
 	{
-		/*{ TODO
-			for (uint32_t i = 0; i < particleCount; ++i)
-			{
-				ParticleVertex leftBot;
-				leftBot.Position = { -0.5f, 0.0f, -0.5f };
-				leftBot.Index = (float)i;
-				mParticleVertices.push_back(leftBot);
+		NR_PROFILE_FUNC();
 
-				ParticleVertex rightBot;
-				rightBot.Position = { 0.5f, 0.0f, -0.5f };
-				rightBot.Index = (float)i;
-				mParticleVertices.push_back(rightBot);
+		Ref<Texture2D> whiteTexture = Renderer::GetWhiteTexture();
 
-				ParticleVertex leftTop;
-				leftTop.Position = { -0.5f, 0.0f,  0.5f };
-				leftTop.Index = (float)i;
-				mParticleVertices.push_back(leftTop);
+		mMaterials.resize(mMaterialDescriptions.size());
+		for (size_t i = 0; i < mMaterialDescriptions.size(); ++i)
+		{
+			const MeshMaterialDescription& description = mMaterialDescriptions[i];
 
-				ParticleVertex rightTop;
-				rightTop.Position = { 0.5f, 0.0f,  0.5f };
-				rightTop.Index = (float)i;
-				mParticleVertices.push_back(rightTop);
+			Ref<Material> mi = Material::Create(Renderer::GetShaderLibrary()->Get("PBR_Static"), description.Name);
+			mMaterials[i] = mi;
 
-				unsigned int index = i * 4;
-				Index indexA = { index + 0, index + 1, index + 2 };
-				Index indexB = { index + 1, index + 3, index + 2 };
-				mIndices.push_back(indexA);
-				mIndices.push_back(indexB);
-			}
-		}
+			mi->Set("uMaterialUniforms.AlbedoColor", description.AlbedoColor);
+			mi->Set("uMaterialUniforms.Emission", description.Emission);
 
-		auto mi = Material::Create(Renderer::GetShaderLibrary()->Get("Particle"), "Particle-Effect");
-		mi->Set("uGalaxySpecs.StarColor", glm::vec3(1.0f, 1.0f, 1.0f));
-		mi->Set("uGalaxySpecs.DustColor", glm::vec3(0.388f, 0.333f, 1.0f));
-		mi->Set("uGalaxySpecs.h2RegionColor", glm::vec3(0.8f, 0.071f, 0.165f));
-		mMaterials.push_back(mi);
+			Ref<Texture2D> albedoTexture = Utils::LoadMaterialTexture(mFilePath, description.AlbedoTexturePath, true);
+			if (albedoTexture)
+			{
+				mi->Set("uAlbedoTexture", albedoTexture);
+				mi->Set("uMaterialUniforms.AlbedoColor", glm::vec3(1.0f));
+			}
+			else
+			{
+				mi->Set("uAlbedoTexture", whiteTexture);
+			}
 
-		Submesh& submesh = mSubmeshes.emplace_back();
-		submesh.BaseVertex = 0;
-		submesh.BaseIndex = 0;
-		submesh.IndexCount = mIndices.size() * 3;
-		submesh.VertexCount = mParticleVertices.size();
-		submesh.Transform = glm::mat4(1.0f);
-		submesh.MaterialIndex = 0;
-		submesh.MeshName = "Particles";
+			Ref<Texture2D> normalTexture = Utils::LoadMaterialTexture(mFilePath, description.NormalTexturePath);
+			mi->Set("uNormalTexture", normalTexture ? normalTexture : whiteTexture);
+			mi->Set("uMaterialUniforms.UseNormalMap", (bool)normalTexture);
 
-		mVertexBuffer = VertexBuffer::Create(mParticleVertices.data(), mParticleVertices.size() * sizeof(ParticleVertex));
-		mIndexBuffer = IndexBuffer::Create(mIndices.data(), mIndices.size() * sizeof(Index));*/
-	}
+			Ref<Texture2D> roughnessTexture = Utils::LoadMaterialTexture(mFilePath, description.RoughnessTexturePath);
+			mi->Set("uRoughnessTexture", roughnessTexture ? roughnessTexture : whiteTexture);
+			mi->Set("uMaterialUniforms.Roughness", roughnessTexture ? 1.0f : description.Roughness);
 
-	MeshSource::~MeshSource()
-	{
+			Ref<Texture2D> metalnessTexture = Utils::LoadMaterialTexture(mFilePath, description.MetalnessTexturePath);
+			mi->Set("uMetalnessTexture", metalnessTexture ? metalnessTexture : whiteTexture);
+			mi->Set("uMaterialUniforms.Metalness", metalnessTexture ? 1.0f : description.Metalness);
+		}
 	}
 
 	static std::string LevelToSpaces(uint32_t level)
@@ -719,25 +705,40 @@ namespace NR
 		NR_MESH_LOG("------------------------------------------------------");
 	}
 
-	void MeshSource::TraverseNodes(aiNode* node, const glm::mat4& parentTransform, uint32_t level)
+	void MeshSource::TraverseNodes(aiNode* node, uint32_t nodeIndex, const glm::mat4& parentTransform, uint32_t level)
 	{
 		glm::mat4 localTransform = Utils::Mat4FromAIMatrix4x4(node->mTransformation);
 		glm::mat4 transform = parentTransform * localTransform;
-		mNodeMap[node].resize(node->mNumMeshes);
-		for (uint32_t i = 0; i < node->mNumMeshes; ++i)
+
 		{
-			uint32_t mesh = node->mMeshes[i];
-			auto& submesh = mSubmeshes[mesh];
-			submesh.NodeName = node->mName.C_Str();
-			submesh.Transform = transform;
-			submesh.LocalTransform = localTransform;
-			mNodeMap[node][i] = mesh;
+			MeshNode& meshNode = mNodes[nodeIndex];
+			meshNode.Name = node->mName.C_Str();
+			meshNode.LocalTransform = localTransform;
+			meshNode.Submeshes.resize(node->mNumMeshes);
+			for (uint32_t i = 0; i < node->mNumMeshes; ++i)
+			{
+				uint32_t mesh = node->mMeshes[i];
+				auto& submesh = mSubmeshes[mesh];
+				submesh.NodeName = node->mName.C_Str();
+				submesh.Transform = transform;
+				submesh.LocalTransform = localTransform;
+				meshNode.Submeshes[i] = mesh;
+			}
 		}
 
 		// NR_MESH_LOG("{0} {1}", LevelToSpaces(level), node->mName.C_Str());
 
+		// Children are allocated together, which moves the nodes, so only indices are held on to
+		const uint32_t firstChild = (uint32_t)mNodes.size();
+		mNodes.resize(firstChild + node->mNumChildren);
+		for (uint32_t i = 0; i < node->mNumChildren; ++i)
+		{
+			mNodes[nodeIndex].Children.push_back(firstChild + i);
+			mNodes[firstChild + i].Parent = nodeIndex;
+		}
+
 		for (uint32_t i = 0; i < node->mNumChildren; ++i)
-			TraverseNodes(node->mChildren[i], transform, level + 1);
+			TraverseNodes(node->mChildren[i], firstChild + i, transform, level + 1);
 	}
 
 	Mesh::Mesh(Ref<MeshSource> meshSource)
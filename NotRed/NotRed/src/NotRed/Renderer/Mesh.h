@@ -8,6 +8,7 @@
 #include "NotRed/Asset/Asset.h"
 
 #include "NotRed/Math/AABB.h"
+#include "NotRed/Math/TriangleBVH.h"
 
 #include "NotRed/Renderer/Animation.h"
 #include "NotRed/Renderer/IndexBuffer.h"
@@ -22,10 +23,6 @@ struct aiAnimation;
 struct aiNodeAnim;
 struct aiScene;
 
-namespace Assimp {
-	class Importer;
-}
-
 namespace NR
 {
 	struct Vertex
@@ -133,6 +130,38 @@ namespace NR
 		std::string NodeName, MeshName;
 	};
 
+	// Node of the imported scene hierarchy, the root is always the first node
+	struct MeshNode
+	{
+		static constexpr uint32_t NoParent = 0xffffffff;
+
+		uint32_t Parent = NoParent;
+		std::vector<uint32_t> Children;
+		std::vector<uint32_t> Submeshes;
+
+		std::string Name;
+		glm::mat4 LocalTransform{ 1.0f };
+
+		bool IsRoot() const { return Parent == NoParent; }
+	};
+
+	// Material parameters as imported, the materials are created from these so imported and cooked meshes share that path
+	struct MeshMaterialDescription
+	{
+		std::string Name;
+
+		glm::vec3 AlbedoColor{ 0.8f };
+		float Emission = 0.0f;
+		float Roughness = 0.8f;
+		float Metalness = 0.0f;
+
+		// Empty when the material has no such map
+		std::string AlbedoTexturePath;
+		std::string NormalTexturePath;
+		std::string RoughnessTexturePath;
+		std::string MetalnessTexturePath;
+	};
+
 	//
 	// MeshSource is a representation of an actual asset file on disk
 	// Meshes are created from MeshSource
@@ -140,7 +169,8 @@ namespace NR
 	class MeshSource : public Asset
 	{
 	public:
-		MeshSource(const std::string& filename);
+		// Without GPU resources the mesh is only imported or loaded cooked, it has no buffers or materials. For tools and tests that run without a device.
+		MeshSource(const std::string& filename, bool createGPUResources = true);
 		MeshSource(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, const glm::mat4& transform);
 		MeshSource(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, const std::vector<Submesh>& submeshes);
 		MeshSource(int squareCount);
@@ -158,11 +188,17 @@ namespace NR
 		const ozz::animation::Skeleton* GetSkeleton() const { NR_CORE_ASSERT(mSkeleton, "Attempted to access null skeleton!"); return mSkeleton.get(); }
 		const std::vector<BoneInfluence>& GetBoneInfluences() const { return mBoneInfluences; }
 
+		const std::vector<MeshNode>& GetNodes() const { return mNodes; }
+		const MeshNode& GetRootNode() const { return mNodes[0]; }
+
 		std::vector<Ref<Material>>& GetMaterials() { return mMaterials; }
 		const std::vector<Ref<Material>>& GetMaterials() const { return mMaterials; }
 		const std::string& GetFilePath() const { return mFilePath; }
 
-		const std::vector<Triangle> GetTriangleCache(uint32_t index) const { return mTriangleCache.at(index); }
+		const std::vector<Triangle>& GetTriangleCache(uint32_t index) const { return mTriangleCache.at(index); }
+
+		// Built on first use from the triangle cache, in the same space as Submesh::BoundingBox
+		const TriangleBVH& GetTriangleBVH(uint32_t index) const;
 
 		Ref<VertexBuffer> GetVertexBuffer() { return mVertexBuffer; }
 		Ref<VertexBuffer> GetBoneInfluenceBuffer() { return mBoneInfluenceBuffer; }
@@ -174,12 +210,15 @@ namespace NR
 		const AABB& GetBoundingBox() const { return mBoundingBox; }
 
 	private:
-		void TraverseNodes(aiNode* node, const glm::mat4& parentTransform = glm::mat4(1.0f), uint32_t level = 0);
+		bool Import(const std::string& filename, std::vector<std::string>& importedFiles);
+		void TraverseNodes(aiNode* node, uint32_t nodeIndex, const glm::mat4& parentTransform = glm::mat4(1.0f), uint32_t level = 0);
+
+		void BuildTriangleCache();
+		void CreateMaterials();
 
 	private:
 		std::vector<Submesh> mSubmeshes;
-
-		std::unique_ptr<Assimp::Importer> mImporter; // note: the importer owns data pointed to by mScene, and mNodeMap and hence must stay in scope for lifetime of MeshSource.
+		std::vector<MeshNode> mNodes;
 
 		Ref<VertexBuffer> mVertexBuffer;
 		Ref<VertexBuffer> mBoneInfluenceBuffer;
@@ -187,16 +226,17 @@ namespace NR
 
 		std::vector<Vertex> mVertices;
 		std::vector<Index> mIndices;
-		std::unordered_map<aiNode*, std::vector<uint32_t>> mNodeMap;
-		const aiScene* mScene;
 
 		std::vector<BoneInfluence> mBoneInfluences;
 		std::vector<BoneInfo> mBoneInfo;
 		ozz::unique_ptr<ozz::animation::Skeleton> mSkeleton;
 
+		std::vector<MeshMaterialDescription> mMaterialDescriptions;
 		std::vector<Ref<Material>> mMaterials;
 
 		std::unordered_map<uint32_t, std::vector<Triangle>> mTriangleCache;
+		mutable std::unordered_map<uint32_t, TriangleBVH> mTriangleBVHs;
+		mutable std::mutex mTriangleBVHMutex;
 
 		AABB mBoundingBox;
 
@@ -209,6 +249,7 @@ namespace NR
 		friend class SceneHierarchyPanel;
 		friend class MeshViewerPanel;
 		friend class Mesh;
+		friend class MeshCache;
 	};
 
 	// Dynamic Mesh - supports skeletal animation and retains hierarchy
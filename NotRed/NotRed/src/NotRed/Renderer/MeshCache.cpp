@@ -0,0 +1,572 @@
+#include "nrpch.h"
+#include "MeshCache.h"
+
+#include <filesystem>
+#include <type_traits>
+
+#include <ozz/animation/runtime/skeleton.h>
+#include <ozz/base/io/archive.h>
+#include <ozz/base/io/stream.h>
+#include <ozz/base/memory/unique_ptr.h>
+
+#include "NotRed/Core/Hash.h"
+#include "NotRed/Core/UUID.h"
+#include "NotRed/Renderer/Mesh.h"
+#include "NotRed/Util/FileSystem.h"
+
+#include "NotRed/Debug/Profiler.h"
+
+namespace NR
+{
+	static const char* sMeshCacheDirectory = "Resources/Cache/Mesh";
+
+	// "NRCM" followed by the format version. Bump the version whenever the layout or the import settings change,
+	// older cooked meshes are imported again. Values are stored little-endian, the byte order of every supported platform.
+	static constexpr uint32_t sCookedMeshMagic = 0x4D43524E;
+	static constexpr uint32_t sCookedMeshVersion = 2;
+
+	namespace Utils
+	{
+		static std::filesystem::path GetCookedMeshPath(const std::string& filepath)
+		{
+			// The stem keeps the cache readable, the path hash keeps meshes with the same name apart
+			const std::filesystem::path path = filepath;
+			const std::string filename = fmt::format("{0}_{1:016x}.nrcmesh", path.stem().string(), Hash::GenerateFNVHash64(path.generic_string()));
+			return std::filesystem::path(sMeshCacheDirectory) / filename;
+		}
+
+		class CookedMeshWriter
+		{
+		public:
+			template<typename T>
+			void Write(const T& value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				WriteBytes(&value, sizeof(T));
+			}
+
+			template<typename T>
+			void WriteArray(const std::vector<T>& values)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				Write((uint32_t)values.size());
+				WriteBytes(values.data(), values.size() * sizeof(T));
+			}
+
+			void WriteString(const std::string& string)
+			{
+				Write((uint32_t)string.size());
+				WriteBytes(string.data(), string.size());
+			}
+
+			void WriteMatrix(const ozz::math::Float4x4& matrix)
+			{
+				float values[16];
+				for (int i = 0; i < 4; ++i)
+					ozz::math::StorePtrU(matrix.cols[i], values + i * 4);
+				WriteBytes(values, sizeof(values));
+			}
+
+			void WriteBytes(const void* data, size_t size)
+			{
+				const byte* bytes = (const byte*)data;
+				mData.insert(mData.end(), bytes, bytes + size);
+			}
+
+			const std::vector<byte>& GetData() const { return mData; }
+
+		private:
+			std::vector<byte> mData;
+		};
+
+		// Every read is bounds checked, a truncated or corrupt file fails the load instead of reading past the end
+		class CookedMeshReader
+		{
+		public:
+			CookedMeshReader(const byte* data, uint64_t size)
+				: mData(data), mSize((size_t)size)
+			{}
+
+			template<typename T>
+			bool Read(T& value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				return ReadBytes(&value, sizeof(T));
+			}
+
+			template<typename T>
+			bool ReadArray(std::vector<T>& values)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				uint32_t count = 0;
+				if (!Read(count) || count > GetRemaining() / sizeof(T))
+					return false;
+
+				values.resize(count);
+				return ReadBytes(values.data(), count * sizeof(T));
+			}
+
+			bool ReadString(std::string& string)
+			{
+				uint32_t length = 0;
+				if (!Read(length) || length > GetRemaining())
+					return false;
+
+				string.assign((const char*)mData + mPosition, length);
+				mPosition += length;
+				return true;
+			}
+
+			bool ReadMatrix(ozz::math::Float4x4& matrix)
+			{
+				float values[16];
+				if (!ReadBytes(values, sizeof(values)))
+					return false;
+
+				for (int i = 0; i < 4; ++i)
+					matrix.cols[i] = ozz::math::simd_float4::LoadPtrU(values + i * 4);
+				return true;
+			}
+
+			bool ReadBytes(void* data, size_t size)
+			{
+				if (size > GetRemaining())
+					return false;
+
+				memcpy(data, mData + mPosition, size);
+				mPosition += size;
+				return true;
+			}
+
+			// Returns the next size bytes without copying them, nullptr if the file is too short
+			const byte* Skip(size_t size)
+			{
+				if (size > GetRemaining())
+					return nullptr;
+
+				const byte* data = mData + mPosition;
+				mPosition += size;
+				return data;
+			}
+
+			size_t GetPosition() const { return mPosition; }
+			size_t GetRemaining() const { return mSize - mPosition; }
+
+		private:
+			const byte* mData;
+			size_t mSize;
+			size_t mPosition = 0;
+		};
+
+		static bool GetSourceFile(const std::string& filepath, MeshCache::SourceFile& sourceFile)
+		{
+			std::error_code error;
+			const uintmax_t size = std::filesystem::file_size(filepath, error);
+			if (error)
+				return false;
+
+			const auto writeTime = std::filesystem::last_write_time(filepath, error);
+			if (error)
+				return false;
+
+			sourceFile.Path = filepath;
+			sourceFile.Size = (uint64_t)size;
+			sourceFile.WriteTime = (int64_t)writeTime.time_since_epoch().count();
+			return true;
+		}
+
+		// Hash of the contents of all files in order, 0 if one of them can't be read
+		static uint64_t HashSourceFiles(const std::vector<MeshCache::SourceFile>& sourceFiles)
+		{
+			NR_PROFILE_FUNC();
+
+			uint64_t hash = 14695981039346656037ull;
+			for (const MeshCache::SourceFile& sourceFile : sourceFiles)
+			{
+				if (sourceFile.Size == 0)
+					continue;
+
+				MappedFile file(sourceFile.Path);
+				if (!file.IsValid())
+					return 0;
+
+				hash = Hash::GenerateFNVHash64(file.GetData(), (size_t)file.GetSize(), hash);
+			}
+
+			return hash == 0 ? 1 : hash;
+		}
+	}
+
+	bool MeshCache::Load(const std::string& sourcePath, MeshSource& meshSource)
+	{
+		NR_PROFILE_FUNC();
+
+		std::vector<SourceFile> sourceFiles;
+		uint64_t contentHash = 0;
+		bool changed = false;
+
+		// The cooked mesh is mapped and parsed in place, only the pages that are read get loaded. Everything is copied
+		// out of it, so the mapping is released before the file is written again.
+		{
+			MappedFile file(Utils::GetCookedMeshPath(sourcePath));
+			if (!file.IsValid())
+				return false;
+
+			Utils::CookedMeshReader reader(file.GetData(), file.GetSize());
+
+			uint32_t magic = 0, version = 0;
+			if (!reader.Read(magic) || magic != sCookedMeshMagic || !reader.Read(version) || version != sCookedMeshVersion)
+			{
+				NR_CORE_WARN("[MeshCache] Cooked mesh for '{0}' is outdated, importing it again.", sourcePath);
+				return false;
+			}
+
+			uint32_t sourceFileCount = 0;
+			if (!reader.Read(sourceFileCount) || sourceFileCount == 0 || sourceFileCount > reader.GetRemaining())
+				return false;
+
+			// Files that still have the size and write time they were cooked with aren't read at all
+			sourceFiles.resize(sourceFileCount);
+			for (SourceFile& cookedFile : sourceFiles)
+			{
+				if (!reader.ReadString(cookedFile.Path) || !reader.Read(cookedFile.Size) || !reader.Read(cookedFile.WriteTime))
+					return false;
+
+				SourceFile sourceFile;
+				if (!Utils::GetSourceFile(cookedFile.Path, sourceFile))
+					return false;
+
+				changed = changed || sourceFile.Size != cookedFile.Size || sourceFile.WriteTime != cookedFile.WriteTime;
+				cookedFile = sourceFile;
+			}
+
+			if (!reader.Read(contentHash))
+				return false;
+
+			// A touched file with the same contents (a checkout, a copy) keeps the cooked mesh
+			if (changed && Utils::HashSourceFiles(sourceFiles) != contentHash)
+				return false;
+
+			const size_t headerSize = reader.GetPosition();
+			if (!Read(file.GetData() + headerSize, file.GetSize() - headerSize, meshSource))
+			{
+				NR_CORE_ERROR("[MeshCache] Cooked mesh for '{0}' is invalid, importing it again.", sourcePath);
+				Clear(meshSource);
+				return false;
+			}
+		}
+
+		// The new write times are stored, so the contents aren't hashed again on the next load
+		if (changed)
+		{
+			Write(sourcePath, meshSource, sourceFiles, contentHash);
+		}
+
+		return true;
+	}
+
+	bool MeshCache::Read(const byte* data, uint64_t size, MeshSource& meshSource)
+	{
+		NR_PROFILE_FUNC();
+
+		Utils::CookedMeshReader reader(data, size);
+
+		bool valid = reader.ReadArray(meshSource.mVertices)
+			&& reader.ReadArray(meshSource.mIndices)
+			&& reader.ReadArray(meshSource.mBoneInfluences)
+			&& reader.Read(meshSource.mBoundingBox);
+
+		uint32_t count = 0;
+		valid = valid && reader.Read(count);
+		for (uint32_t i = 0; valid && i < count; ++i)
+		{
+			Submesh& submesh = meshSource.mSubmeshes.emplace_back();
+			valid = reader.Read(submesh.BaseVertex)
+				&& reader.Read(submesh.BaseIndex)
+				&& reader.Read(submesh.MaterialIndex)
+				&& reader.Read(submesh.IndexCount)
+				&& reader.Read(submesh.VertexCount)
+				&& reader.Read(submesh.Transform)
+				&& reader.Read(submesh.LocalTransform)
+				&& reader.Read(submesh.BoundingBox)
+				&& reader.ReadString(submesh.NodeName)
+				&& reader.ReadString(submesh.MeshName);
+
+			valid = valid && (uint64_t)submesh.BaseVertex + submesh.VertexCount <= meshSource.mVertices.size()
+				&& submesh.BaseIndex % 3 == 0 && (uint64_t)submesh.BaseIndex + submesh.IndexCount <= meshSource.mIndices.size() * 3;
+		}
+
+		valid = valid && reader.Read(count);
+		for (uint32_t i = 0; valid && i < count; ++i)
+		{
+			MeshNode& node = meshSource.mNodes.emplace_back();
+			valid = reader.Read(node.Parent)
+				&& reader.ReadArray(node.Children)
+				&& reader.ReadArray(node.Submeshes)
+				&& reader.ReadString(node.Name)
+				&& reader.Read(node.LocalTransform);
+		}
+
+		// The hierarchy is walked by index, so every reference has to stay inside the mesh
+		const uint32_t nodeCount = (uint32_t)meshSource.mNodes.size();
+		const uint32_t submeshCount = (uint32_t)meshSource.mSubmeshes.size();
+		for (const MeshNode& node : meshSource.mNodes)
+		{
+			valid = valid && (node.IsRoot() || node.Parent < nodeCount)
+				&& std::all_of(node.Children.begin(), node.Children.end(), [nodeCount](uint32_t child) { return child < nodeCount; })
+				&& std::all_of(node.Submeshes.begin(), node.Submeshes.end(), [submeshCount](uint32_t submesh) { return submesh < submeshCount; });
+		}
+
+		valid = valid && reader.Read(count);
+		for (uint32_t i = 0; valid && i < count; ++i)
+		{
+			MeshMaterialDescription& material = meshSource.mMaterialDescriptions.emplace_back();
+			valid = reader.ReadString(material.Name)
+				&& reader.Read(material.AlbedoColor)
+				&& reader.Read(material.Emission)
+				&& reader.Read(material.Roughness)
+				&& reader.Read(material.Metalness)
+				&& reader.ReadString(material.AlbedoTexturePath)
+				&& reader.ReadString(material.NormalTexturePath)
+				&& reader.ReadString(material.RoughnessTexturePath)
+				&& reader.ReadString(material.MetalnessTexturePath);
+		}
+
+		valid = valid && reader.Read(count);
+		for (uint32_t i = 0; valid && i < count; ++i)
+		{
+			ozz::math::Float4x4 subMeshInverseTransform, inverseBindPose;
+			uint32_t subMeshIndex = 0, jointIndex = 0;
+			valid = reader.ReadMatrix(subMeshInverseTransform)
+				&& reader.ReadMatrix(inverseBindPose)
+				&& reader.Read(subMeshIndex)
+				&& reader.Read(jointIndex);
+
+			if (valid)
+				meshSource.mBoneInfo.emplace_back(subMeshInverseTransform, inverseBindPose, subMeshIndex, jointIndex);
+		}
+
+		uint32_t skeletonSize = 0;
+		valid = valid && reader.Read(skeletonSize);
+		if (valid && skeletonSize > 0)
+		{
+			const byte* skeletonData = reader.Skip(skeletonSize);
+			valid = skeletonData != nullptr;
+			if (valid)
+			{
+				ozz::io::MemoryStream stream;
+				stream.Write(skeletonData, skeletonSize);
+				stream.Seek(0, ozz::io::Stream::kSet);
+
+				ozz::io::IArchive archive(&stream);
+				valid = archive.TestTag<ozz::animation::Skeleton>();
+				if (valid)
+				{
+					meshSource.mSkeleton = ozz::make_unique<ozz::animation::Skeleton>();
+					archive >> *meshSource.mSkeleton;
+				}
+			}
+		}
+
+		// Everything the renderer, the triangle cache and skinning index with has to stay inside the mesh as well
+		const uint32_t materialCount = (uint32_t)meshSource.mMaterialDescriptions.size();
+		for (const Submesh& submesh : meshSource.mSubmeshes)
+		{
+			valid = valid && submesh.MaterialIndex < materialCount;
+
+			const uint32_t firstTriangle = submesh.BaseIndex / 3;
+			for (uint32_t i = firstTriangle; valid && i < firstTriangle + submesh.IndexCount / 3; ++i)
+			{
+				const Index& index = meshSource.mIndices[i];
+				valid = index.V1 < submesh.VertexCount && index.V2 < submesh.VertexCount && index.V3 < submesh.VertexCount;
+			}
+		}
+
+		const uint32_t boneCount = (uint32_t)meshSource.mBoneInfo.size();
+		valid = valid && (meshSource.mBoneInfluences.empty() || meshSource.mBoneInfluences.size() == meshSource.mVertices.size());
+		for (size_t i = 0; valid && i < meshSource.mBoneInfluences.size(); ++i)
+		{
+			const BoneInfluence& influence = meshSource.mBoneInfluences[i];
+			for (uint32_t j = 0; valid && j < 4; ++j)
+				valid = influence.Weights[j] == 0.0f || influence.IDs[j] < boneCount;
+		}
+
+		const uint32_t jointCount = meshSource.mSkeleton ? (uint32_t)meshSource.mSkeleton->num_joints() : 0;
+		for (const BoneInfo& boneInfo : meshSource.mBoneInfo)
+		{
+			valid = valid && boneInfo.SubMeshIndex < submeshCount && (!meshSource.mSkeleton || boneInfo.JointIndex < jointCount);
+		}
+
+		return valid && !meshSource.mSubmeshes.empty() && !meshSource.mNodes.empty() && !meshSource.mMaterialDescriptions.empty();
+	}
+
+	void MeshCache::Store(const std::string& sourcePath, const MeshSource& meshSource, const std::vector<std::string>& importedFiles)
+	{
+		NR_PROFILE_FUNC();
+
+		std::vector<SourceFile> sourceFiles(1);
+		if (!Utils::GetSourceFile(sourcePath, sourceFiles[0]))
+			return;
+
+		const std::filesystem::path source = std::filesystem::path(sourcePath).lexically_normal();
+		for (const std::string& importedFile : importedFiles)
+		{
+			const std::filesystem::path path = std::filesystem::path(importedFile).lexically_normal();
+			const bool known = path == source || std::any_of(sourceFiles.begin() + 1, sourceFiles.end(),
+				[&path](const SourceFile& sourceFile) { return std::filesystem::path(sourceFile.Path).lexically_normal() == path; });
+
+			SourceFile sourceFile;
+			if (!known && Utils::GetSourceFile(importedFile, sourceFile))
+				sourceFiles.push_back(sourceFile);
+		}
+
+		const uint64_t contentHash = Utils::HashSourceFiles(sourceFiles);
+		if (contentHash == 0)
+			return;
+
+		Write(sourcePath, meshSource, sourceFiles, contentHash);
+	}
+
+	void MeshCache::Write(const std::string& sourcePath, const MeshSource& meshSource, const std::vector<SourceFile>& sourceFiles, uint64_t contentHash)
+	{
+		NR_PROFILE_FUNC();
+
+		Utils::CookedMeshWriter writer;
+		writer.Write(sCookedMeshMagic);
+		writer.Write(sCookedMeshVersion);
+
+		writer.Write((uint32_t)sourceFiles.size());
+		for (const SourceFile& sourceFile : sourceFiles)
+		{
+			writer.WriteString(sourceFile.Path);
+			writer.Write(sourceFile.Size);
+			writer.Write(sourceFile.WriteTime);
+		}
+		writer.Write(contentHash);
+
+		writer.WriteArray(meshSource.mVertices);
+		writer.WriteArray(meshSource.mIndices);
+		writer.WriteArray(meshSource.mBoneInfluences);
+		writer.Write(meshSource.mBoundingBox);
+
+		writer.Write((uint32_t)meshSource.mSubmeshes.size());
+		for (const Submesh& submesh : meshSource.mSubmeshes)
+		{
+			writer.Write(submesh.BaseVertex);
+			writer.Write(submesh.BaseIndex);
+			writer.Write(submesh.MaterialIndex);
+			writer.Write(submesh.IndexCount);
+			writer.Write(submesh.VertexCount);
+			writer.Write(submesh.Transform);
+			writer.Write(submesh.LocalTransform);
+			writer.Write(submesh.BoundingBox);
+			writer.WriteString(submesh.NodeName);
+			writer.WriteString(submesh.MeshName);
+		}
+
+		writer.Write((uint32_t)meshSource.mNodes.size());
+		for (const MeshNode& node : meshSource.mNodes)
+		{
+			writer.Write(node.Parent);
+			writer.WriteArray(node.Children);
+			writer.WriteArray(node.Submeshes);
+			writer.WriteString(node.Name);
+			writer.Write(node.LocalTransform);
+		}
+
+		writer.Write((uint32_t)meshSource.mMaterialDescriptions.size());
+		for (const MeshMaterialDescription& material : meshSource.mMaterialDescriptions)
+		{
+			writer.WriteString(material.Name);
+			writer.Write(material.AlbedoColor);
+			writer.Write(material.Emission);
+			writer.Write(material.Roughness);
+			writer.Write(material.Metalness);
+			writer.WriteString(material.AlbedoTexturePath);
+			writer.WriteString(material.NormalTexturePath);
+			writer.WriteString(material.RoughnessTexturePath);
+			writer.WriteString(material.MetalnessTexturePath);
+		}
+
+		writer.Write((uint32_t)meshSource.mBoneInfo.size());
+		for (const BoneInfo& boneInfo : meshSource.mBoneInfo)
+		{
+			writer.WriteMatrix(boneInfo.SubMeshInverseTransform);
+			writer.WriteMatrix(boneInfo.InverseBindPose);
+			writer.Write(boneInfo.SubMeshIndex);
+			writer.Write(boneInfo.JointIndex);
+		}
+
+		if (meshSource.mSkeleton)
+		{
+			ozz::io::MemoryStream stream;
+			{
+				ozz::io::OArchive archive(&stream, ozz::Endianness::kLittleEndian);
+				archive << *meshSource.mSkeleton;
+			}
+
+			std::vector<byte> skeletonData(stream.Size());
+			stream.Seek(0, ozz::io::Stream::kSet);
+			stream.Read(skeletonData.data(), skeletonData.size());
+
+			writer.Write((uint32_t)skeletonData.size());
+			writer.WriteBytes(skeletonData.data(), skeletonData.size());
+		}
+		else
+		{
+			writer.Write((uint32_t)0);
+		}
+
+		// Written next to the cooked mesh and moved over it, so a crash never leaves a half written file behind.
+		// Every writer gets its own temporary file, the same source can be cooked by several imports (or editors) at once.
+		const std::filesystem::path cookedPath = Utils::GetCookedMeshPath(sourcePath);
+		std::filesystem::path tempPath = cookedPath;
+		tempPath += fmt::format(".{:016x}.tmp", (uint64_t)UUID());
+
+		std::filesystem::create_directories(cookedPath.parent_path());
+
+		{
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+			if (!stream)
+			{
+				NR_CORE_ERROR("[MeshCache] Could not write {0}", tempPath.string());
+				return;
+			}
+
+			const auto& data = writer.GetData();
+			stream.write((const char*)data.data(), data.size());
+			if (!stream)
+			{
+				NR_CORE_ERROR("[MeshCache] Could not write {0}", tempPath.string());
+			}
+		}
+
+		// The last writer wins, every one of them cooked the same source. Replacing fails while the cooked mesh is
+		// mapped by a load on some platforms, the mesh is cooked again next time then.
+		std::error_code error;
+		std::filesystem::rename(tempPath, cookedPath, error);
+		if (error)
+		{
+			NR_CORE_WARN("[MeshCache] Could not replace {0}: {1}", cookedPath.string(), error.message());
+			std::filesystem::remove(tempPath, error);
+		}
+	}
+
+	std::string MeshCache::GetCookedPath(const std::string& sourcePath)
+	{
+		return Utils::GetCookedMeshPath(sourcePath).string();
+	}
+
+	void MeshCache::Clear(MeshSource& meshSource)
+	{
+		meshSource.mVertices.clear();
+		meshSource.mIndices.clear();
+		meshSource.mBoneInfluences.clear();
+		meshSource.mSubmeshes.clear();
+		meshSource.mNodes.clear();
+		meshSource.mMaterialDescriptions.clear();
+		meshSource.mBoneInfo.clear();
+		meshSource.mSkeleton.reset();
+		meshSource.mBoundingBox = AABB();
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace NR
+{
+	class MeshSource;
+
+	//
+	// Cooked meshes hold everything a MeshSource imports (vertices, indices, submeshes, nodes, bone data, materials and
+	// the skeleton) in one binary file per source and load without Assimp. They remember the size and write time of the
+	// source and of the files it references (the buffers of a .gltf, the material library of an .obj), and a hash of
+	// their contents. The files are only read and hashed again once one of them changed on disk.
+	//
+	class MeshCache
+	{
+	public:
+		// A file the cooked mesh was made from, the source itself comes first
+		struct SourceFile
+		{
+			std::string Path;
+			uint64_t Size = 0;
+			int64_t WriteTime = 0;
+		};
+
+		// Returns false and leaves the mesh source empty if there is no up to date cooked mesh for the source
+		static bool Load(const std::string& sourcePath, MeshSource& meshSource);
+		// importedFiles are the files the importer opened, the ones besides the source are tracked as well
+		static void Store(const std::string& sourcePath, const MeshSource& meshSource, const std::vector<std::string>& importedFiles);
+
+		// Where the cooked mesh of the source is stored, whether it exists or not
+		static std::string GetCookedPath(const std::string& sourcePath);
+
+	private:
+		static bool Read(const byte* data, uint64_t size, MeshSource& meshSource);
+		static void Write(const std::string& sourcePath, const MeshSource& meshSource, const std::vector<SourceFile>& sourceFiles, uint64_t contentHash);
+		static void Clear(MeshSource& meshSource);
+	};
+}
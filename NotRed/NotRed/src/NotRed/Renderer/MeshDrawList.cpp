@@ -0,0 +1,100 @@
+#include "nrpch.h"
+#include "MeshDrawList.h"
+
+#include "NotRed/Debug/Profiler.h"
+
+namespace NR
+{
+    namespace Utils {
+
+        // Stable LSD radix sort on a 64 bit Key, bytes every entry shares are skipped
+        template<typename T>
+        static void RadixSortByKey(std::vector<T>& entries, std::vector<T>& scratch)
+        {
+            const size_t count = entries.size();
+            if (count < 2)
+                return;
+
+            scratch.resize(count);
+
+            uint32_t histograms[8][256] = {};
+            for (const T& entry : entries)
+            {
+                for (uint32_t pass = 0; pass < 8; ++pass)
+                    histograms[pass][(entry.Key >> (pass * 8)) & 0xFF]++;
+            }
+
+            T* source = entries.data();
+            T* destination = scratch.data();
+            for (uint32_t pass = 0; pass < 8; ++pass)
+            {
+                const uint32_t shift = pass * 8;
+                uint32_t* histogram = histograms[pass];
+                if (histogram[(source[0].Key >> shift) & 0xFF] == count)
+                    continue;
+
+                uint32_t offset = 0;
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    const uint32_t bucketSize = histogram[i];
+                    histogram[i] = offset;
+                    offset += bucketSize;
+                }
+
+                for (size_t i = 0; i < count; ++i)
+                    destination[histogram[(source[i].Key >> shift) & 0xFF]++] = source[i];
+
+                std::swap(source, destination);
+            }
+
+            if (source != entries.data())
+                entries.swap(scratch);
+        }
+
+    }
+
+    // [63] rigged | [62..40] material | [39..12] mesh | [11..0] submesh
+    uint64_t MeshDrawList::SortKey(bool rigged, AssetHandle meshHandle, AssetHandle materialHandle, uint32_t submeshIndex)
+    {
+        return ((uint64_t)rigged << 63)
+            | (((uint64_t)materialHandle & 0x7FFFFF) << 40)
+            | (((uint64_t)meshHandle & 0xFFFFFFF) << 12)
+            | ((uint64_t)submeshIndex & 0xFFF);
+    }
+
+    void MeshDrawList::BuildCommands(std::vector<InstanceVertexData>& instanceData)
+    {
+        NR_PROFILE_FUNC();
+
+        Commands.clear();
+        if (Instances.empty())
+            return;
+
+        Utils::RadixSortByKey(SortEntries, SortScratch);
+
+        // Equal keys are adjacent after sorting, the full handles decide where a batch ends.
+        // Instances only carry indices, the transforms and palettes they refer to are shared by all lists.
+        DrawCommand* dc = nullptr;
+        uint64_t batchKey = 0;
+        const DrawInstance* batchInstance = nullptr;
+        for (const DrawSortEntry& entry : SortEntries)
+        {
+            const DrawInstance& instance = Instances[entry.Instance];
+            if (!dc || entry.Key != batchKey || instance.MeshHandle != batchInstance->MeshHandle || instance.MaterialHandle != batchInstance->MaterialHandle || instance.SubmeshIndex != batchInstance->SubmeshIndex)
+            {
+                dc = &Commands.emplace_back();
+                dc->SubmeshIndex = instance.SubmeshIndex;
+                dc->InstanceOffset = (uint32_t)(instanceData.size() * sizeof(InstanceVertexData));
+
+                batchKey = entry.Key;
+                batchInstance = &instance;
+            }
+
+            dc->Submission = instance.Submission;
+            dc->InstanceCount++;
+
+            const uint32_t boneTransformsIndex = instance.BoneTransformsIndex != DrawInstance::NoBoneTransforms ? instance.BoneTransformsIndex : 0;
+            instanceData.push_back({ instance.TransformIndex, boneTransformsIndex });
+        }
+    }
+}
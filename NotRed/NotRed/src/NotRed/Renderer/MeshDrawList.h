@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+
+#include "NotRed/Asset/Asset.h"
+
+namespace NR
+{
+	// Per instance vertex stream of a draw, the indices refer to the transform and bone transform storage buffers
+	struct InstanceVertexData
+	{
+		uint32_t TransformIndex;
+		uint32_t BoneTransformsIndex;
+	};
+
+	struct DrawInstance
+	{
+		static constexpr uint32_t NoBoneTransforms = ~0u;
+
+		uint64_t SortKey;
+		AssetHandle MeshHandle;
+		AssetHandle MaterialHandle;
+		uint32_t Submission;
+		uint32_t SubmeshIndex;
+		uint32_t TransformIndex; // Into the transforms of the submission buffer
+		uint32_t BoneTransformsIndex; // Into the bone transforms of the submission buffer, NoBoneTransforms if not rigged
+	};
+
+	struct DrawSortEntry
+	{
+		uint64_t Key;
+		uint32_t Instance;
+	};
+
+	// Instances sorted by key into consecutive runs, every run is one instanced draw
+	struct DrawCommand
+	{
+		uint32_t Submission;
+		uint32_t SubmeshIndex;
+
+		uint32_t InstanceCount = 0;
+		uint32_t InstanceOffset = 0; // Byte offset into the instance vertex buffer
+	};
+
+	// Flat per-frame arrays, cleared without releasing their memory
+	struct MeshDrawList
+	{
+		std::vector<DrawInstance> Instances;
+		std::vector<DrawSortEntry> SortEntries;
+		std::vector<DrawSortEntry> SortScratch;
+		std::vector<DrawCommand> Commands;
+
+		void Clear()
+		{
+			Instances.clear();
+			SortEntries.clear();
+			Commands.clear();
+		}
+
+		// Handles are truncated, so equal keys still have to be compared exactly when batching
+		static uint64_t SortKey(bool rigged, AssetHandle meshHandle, AssetHandle materialHandle, uint32_t submeshIndex);
+
+		// Sorts the entries by key and collapses equal runs into instanced draws, their instance data is appended to instanceData
+		void BuildCommands(std::vector<InstanceVertexData>& instanceData);
+	};
+}
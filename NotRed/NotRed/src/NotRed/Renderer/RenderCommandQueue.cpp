@@ -1,53 +1,116 @@
 #include "nrpch.h"
 #include "RenderCommandQueue.h"
 
+#include "NotRed/Debug/Profiler.h"
+
 #define NR_RENDER_TRACE(...) NR_CORE_TRACE(__VA_ARGS__)
 
 namespace NR
 {
+	namespace Utils
+	{
+		static inline uint32_t AlignUp(uint32_t value, uint32_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
 	RenderCommandQueue::RenderCommandQueue()
 	{
-		mCommandBuffer = new uint8_t[10 * 1024 * 1024];
-		mCommandBufferPtr = mCommandBuffer;
-		memset(mCommandBuffer, 0, 10 * 1024 * 1024);
 	}
 
 	RenderCommandQueue::~RenderCommandQueue()
 	{
-		delete[] mCommandBuffer;
+		for (Chunk& chunk : mChunks)
+		{
+			::operator delete[](chunk.Data, std::align_val_t(MaxCommandAlignment));
+		}
+
+		mChunks.clear();
+	}
+
+	RenderCommandQueue::Chunk& RenderCommandQueue::AllocateChunk(uint32_t index, uint32_t minimumSize)
+	{
+		Chunk chunk;
+		chunk.Capacity = Utils::AlignUp(std::max(minimumSize, ChunkSize), ChunkSize);
+		chunk.Data = static_cast<uint8_t*>(::operator new[](chunk.Capacity, std::align_val_t(MaxCommandAlignment)));
+
+		return *mChunks.insert(mChunks.begin() + index, chunk);
 	}
 
-	void* RenderCommandQueue::Allocate(RenderCommandFn fn, uint32_t size)
+	void* RenderCommandQueue::Allocate(RenderCommandFn fn, uint32_t size, uint32_t alignment)
 	{
-		*(RenderCommandFn*)mCommandBufferPtr = fn;
-		mCommandBufferPtr += sizeof(RenderCommandFn);
+		NR_CORE_ASSERT(alignment && (alignment & (alignment - 1)) == 0, "Command alignment must be a power of two!");
+		NR_CORE_ASSERT(alignment <= MaxCommandAlignment, "Command alignment is larger than the chunk alignment!");
 
-		*(uint32_t*)mCommandBufferPtr = size;
-		mCommandBufferPtr += sizeof(uint32_t);
+		if (mChunks.empty())
+		{
+			AllocateChunk(0, ChunkSize);
+		}
 
-		void* memory = mCommandBufferPtr;
-		mCommandBufferPtr += size;
+		uint32_t headerOffset = Utils::AlignUp(mChunks[mCurrentChunk].Used, alignof(CommandHeader));
+		uint32_t payloadOffset = Utils::AlignUp(headerOffset + sizeof(CommandHeader), alignment);
+
+		if (payloadOffset + size > mChunks[mCurrentChunk].Capacity)
+		{
+			// Move on to the next chunk, growing the queue if there is none (or it is too small for this command)
+			++mCurrentChunk;
+
+			const uint32_t requiredSize = Utils::AlignUp(sizeof(CommandHeader), alignment) + size;
+			if (mCurrentChunk == mChunks.size() || mChunks[mCurrentChunk].Capacity < requiredSize)
+			{
+				AllocateChunk(mCurrentChunk, requiredSize);
+			}
+
+			headerOffset = 0;
+			payloadOffset = Utils::AlignUp(sizeof(CommandHeader), alignment);
+		}
+
+		Chunk& chunk = mChunks[mCurrentChunk];
+
+		CommandHeader* header = reinterpret_cast<CommandHeader*>(chunk.Data + headerOffset);
+		header->Function = fn;
+		header->PayloadOffset = payloadOffset - headerOffset;
+		header->NextOffset = std::min(Utils::AlignUp(payloadOffset + size, alignof(CommandHeader)), chunk.Capacity);
+
+		chunk.Used = header->NextOffset;
 
 		++mCommandCount;
-		return memory;
+		return chunk.Data + payloadOffset;
 	}
 
 	void RenderCommandQueue::Execute()
 	{
-		byte* buffer = mCommandBuffer;
+		NR_PROFILE_FUNC();
 
-		for (uint32_t i = 0; i < mCommandCount; ++i)
+		// NOTE: indices and sizes are re-read every iteration since a command is allowed to submit into the queue that executes it
+		for (uint32_t chunkIndex = 0; chunkIndex < mChunks.size() && chunkIndex <= mCurrentChunk; ++chunkIndex)
 		{
-			RenderCommandFn function = *(RenderCommandFn*)buffer;
-			buffer += sizeof(RenderCommandFn);
+			uint32_t offset = 0;
+			while (offset < mChunks[chunkIndex].Used)
+			{
+				uint8_t* data = mChunks[chunkIndex].Data;
+				CommandHeader* header = reinterpret_cast<CommandHeader*>(data + offset);
+				header->Function(data + offset + header->PayloadOffset);
+				offset = header->NextOffset;
+			}
+		}
 
-			uint32_t size = *(uint32_t*)buffer;
-			buffer += sizeof(uint32_t);
-			function(buffer);
-			buffer += size;
+		mStatistics.CommandCount = mCommandCount;
+		mStatistics.BytesUsed = 0;
+		mStatistics.BytesAllocated = 0;
+		mStatistics.ChunkCount = (uint32_t)mChunks.size();
+		for (Chunk& chunk : mChunks)
+		{
+			mStatistics.BytesUsed += chunk.Used;
+			mStatistics.BytesAllocated += chunk.Capacity;
+			chunk.Used = 0;
 		}
 
-		mCommandBufferPtr = mCommandBuffer;
+		mStatistics.PeakCommandCount = std::max(mStatistics.PeakCommandCount, mStatistics.CommandCount);
+		mStatistics.PeakBytesUsed = std::max(mStatistics.PeakBytesUsed, mStatistics.BytesUsed);
+
+		mCurrentChunk = 0;
 		mCommandCount = 0;
 	}
-}
\ No newline at end of file
+}
@@ -9,15 +9,54 @@ namespace NR
 	public:
 		typedef void(*RenderCommandFn)(void*);
 
+		struct Statistics
+		{
+			uint32_t CommandCount = 0;
+			uint32_t BytesUsed = 0;
+			uint32_t BytesAllocated = 0;
+			uint32_t ChunkCount = 0;
+
+			uint32_t PeakCommandCount = 0;
+			uint32_t PeakBytesUsed = 0;
+		};
+
+	public:
 		RenderCommandQueue();
 		~RenderCommandQueue();
 
-		void* Allocate(RenderCommandFn func, uint32_t size);
+		void* Allocate(RenderCommandFn func, uint32_t size, uint32_t alignment = alignof(std::max_align_t));
 		void Execute();
 
+		// Counters of the last executed batch of commands
+		const Statistics& GetStatistics() const { return mStatistics; }
+
+	public:
+		// Commands are recorded into fixed-size chunks that are kept and reused for the next frame
+		static constexpr uint32_t ChunkSize = 1024 * 1024;
+		static constexpr uint32_t MaxCommandAlignment = 64;
+
 	private:
-		uint8_t* mCommandBuffer;
-		uint8_t* mCommandBufferPtr;
+		struct CommandHeader
+		{
+			RenderCommandFn Function;
+			uint32_t PayloadOffset; // from the start of the header
+			uint32_t NextOffset;    // of the next header, from the start of the chunk
+		};
+
+		struct Chunk
+		{
+			uint8_t* Data = nullptr;
+			uint32_t Capacity = 0;
+			uint32_t Used = 0;
+		};
+
+		Chunk& AllocateChunk(uint32_t index, uint32_t minimumSize);
+
+	private:
+		std::vector<Chunk> mChunks;
+		uint32_t mCurrentChunk = 0;
 		uint32_t mCommandCount = 0;
+
+		Statistics mStatistics;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,103 @@
+#include "nrpch.h"
+#include "RenderThread.h"
+
+#include "Renderer.h"
+
+#include "NotRed/Debug/Profiler.h"
+
+namespace NR
+{
+	RenderThread::RenderThread(ThreadingPolicy policy)
+		: mThreadingPolicy(policy)
+	{
+	}
+
+	RenderThread::~RenderThread()
+	{
+		NR_CORE_ASSERT(!mIsRunning, "Render thread was not terminated!");
+	}
+
+	void RenderThread::Run()
+	{
+		mIsRunning = true;
+		if (mThreadingPolicy == ThreadingPolicy::MultiThreaded)
+		{
+			mRenderThread = std::thread(Renderer::RenderThreadFunc, this);
+		}
+	}
+
+	void RenderThread::Terminate()
+	{
+		// The render thread samples IsRunning before going idle, so it must only be cleared once
+		// the current frame is done - otherwise the final Pump could kick a thread that already exited
+		BlockUntilRendering();
+		mIsRunning = false;
+		Pump();
+
+		if (mRenderThread.joinable())
+		{
+			mRenderThread.join();
+		}
+	}
+
+	void RenderThread::Wait(State waitForState)
+	{
+		std::unique_lock<std::mutex> lock(mStateMutex);
+		mStateCondition.wait(lock, [this, waitForState]() { return mState == waitForState; });
+	}
+
+	void RenderThread::WaitAndSet(State waitForState, State setToState)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mStateMutex);
+			mStateCondition.wait(lock, [this, waitForState]() { return mState == waitForState; });
+			mState = setToState;
+		}
+		mStateCondition.notify_all();
+	}
+
+	void RenderThread::Set(State setToState)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mStateMutex);
+			mState = setToState;
+		}
+		mStateCondition.notify_all();
+	}
+
+	RenderThread::State RenderThread::GetState()
+	{
+		std::lock_guard<std::mutex> lock(mStateMutex);
+		return mState;
+	}
+
+	void RenderThread::NextFrame()
+	{
+		NR_PROFILE_FUNC();
+
+		Renderer::SwapQueues();
+	}
+
+	void RenderThread::BlockUntilRendering()
+	{
+		NR_PROFILE_FUNC();
+
+		Wait(State::Idle);
+	}
+
+	void RenderThread::Kick()
+	{
+		Set(State::Kick);
+		if (mThreadingPolicy != ThreadingPolicy::MultiThreaded)
+		{
+			Renderer::WaitAndRender(this);
+		}
+	}
+
+	void RenderThread::Pump()
+	{
+		NextFrame();
+		Kick();
+		BlockUntilRendering();
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace NR
+{
+	enum class ThreadingPolicy
+	{
+		// MultiThreaded will create a render thread that executes the previous frame's
+		// command queue while the main thread records the next one
+		None = 0, SingleThreaded, MultiThreaded
+	};
+
+	class RenderThread
+	{
+	public:
+		enum class State
+		{
+			Idle = 0,
+			Busy,
+			Kick
+		};
+
+	public:
+		RenderThread(ThreadingPolicy policy);
+		~RenderThread();
+
+		void Run();
+		bool IsRunning() const { return mIsRunning; }
+		void Terminate();
+
+		void Wait(State waitForState);
+		void WaitAndSet(State waitForState, State setToState);
+		void Set(State setToState);
+		State GetState();
+
+		// Swaps the submission/execution queues, must only be called while rendering is idle
+		void NextFrame();
+		void BlockUntilRendering();
+		// Executes the frame recorded before the last NextFrame, on the render thread when multi-threaded.
+		// Commands those commands submit run in the same kick.
+		void Kick();
+
+		// Renders everything that has been submitted so far and waits for it to finish
+		void Pump();
+
+		ThreadingPolicy GetPolicy() const { return mThreadingPolicy; }
+
+	private:
+		ThreadingPolicy mThreadingPolicy;
+
+		std::thread mRenderThread;
+		std::atomic<bool> mIsRunning = false;
+
+		std::mutex mStateMutex;
+		std::condition_variable mStateCondition;
+		State mState = State::Idle;
+	};
+}
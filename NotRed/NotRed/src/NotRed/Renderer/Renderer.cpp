@@ -9,6 +9,7 @@
 #include "RendererAPI.h"
 #include "SceneRenderer.h"
 #include "Renderer2D.h"
+#include "ShaderCache.h"
 
 #include "NotRed/Core/Timer.h"
 #include "NotRed/Debug/Profiler.h"
@@ -35,24 +36,30 @@ namespace NR
 		std::vector<Ref<Material>> Materials;
 	};
 	static std::unordered_map<size_t, ShaderDependencies> sShaderDependencies;
+	// Materials are also created by asset loads on the job system
+	static std::mutex sShaderDependenciesMutex;
 
 	void Renderer::RegisterShaderDependency(Ref<Shader> shader, Ref<PipelineCompute> computePipeline)
 	{
+		std::scoped_lock<std::mutex> lock(sShaderDependenciesMutex);
 		sShaderDependencies[shader->GetHash()].ComputePipelines.push_back(computePipeline);
 	}
 
 	void Renderer::RegisterShaderDependency(Ref<Shader> shader, Ref<Pipeline> pipeline)
 	{
+		std::scoped_lock<std::mutex> lock(sShaderDependenciesMutex);
 		sShaderDependencies[shader->GetHash()].Pipelines.push_back(pipeline);
 	}
 
 	void Renderer::RegisterShaderDependency(Ref<Shader> shader, Ref<Material> material)
 	{
+		std::scoped_lock<std::mutex> lock(sShaderDependenciesMutex);
 		sShaderDependencies[shader->GetHash()].Materials.push_back(material);
 	}
 
 	void Renderer::ShaderReloaded(size_t hash)
 	{
+		std::scoped_lock<std::mutex> lock(sShaderDependenciesMutex);
 		if (sShaderDependencies.find(hash) != sShaderDependencies.end())
 		{
 			auto& dependencies = sShaderDependencies.at(hash);
@@ -96,9 +103,35 @@ namespace NR
 	};
 
 	static RendererData* sData = nullptr;
-	static RenderCommandQueue* sCommandQueue = nullptr;
+
+	// The main thread records into one queue while the other one is executed
+	constexpr static uint32_t sRenderCommandQueueCount = 2;
+	static RenderCommandQueue sCommandQueue[sRenderCommandQueueCount];
+	static std::atomic<uint32_t> sRenderCommandQueueSubmissionIndex = 0;
 	static RenderCommandQueue sResourceFreeQueue[3];
 
+	// Taken in SwapQueues, the render thread is idle then and the queue it executed last is finished
+	static RenderCommandQueue::Statistics sRenderCommandQueueStatistics;
+
+	static thread_local Renderer::DeferredCommandList* sDeferredCommandList = nullptr;
+
+	// Commands of jobs that submitted without setting a deferred command list, any worker may append to it
+	static std::mutex sUnownedDeferredCommandsMutex;
+	static Renderer::DeferredCommandList sUnownedDeferredCommands;
+	static std::atomic<bool> sUnownedDeferredCommandsReported = false;
+
+	// Commands submitted by a command are appended to the queue executing it, so they run in the same Execute. Only the
+	// thread executing a queue writes to it, the main thread keeps recording into the other one.
+	static thread_local RenderCommandQueue* sExecutingCommandQueue = nullptr;
+
+	static void ExecuteCommandQueue(RenderCommandQueue& queue)
+	{
+		RenderCommandQueue* previousQueue = sExecutingCommandQueue;
+		sExecutingCommandQueue = &queue;
+		queue.Execute();
+		sExecutingCommandQueue = previousQueue;
+	}
+
 	static RendererAPI* InitRendererAPI()
 	{
 		switch (RendererAPI::Current())
@@ -112,7 +145,6 @@ namespace NR
 	void Renderer::Init()
 	{
 		sData = new RendererData();
-		sCommandQueue = new RenderCommandQueue();
 
 		// Make sure we don't have more frames in flight than swapchain images
 		Renderer::GetConfig().FramesInFlight = glm::min<uint32_t>(Renderer::GetConfig().FramesInFlight, Application::Get().GetWindow().GetSwapChain().GetImageCount());
@@ -121,6 +153,9 @@ namespace NR
 
 		sData->mShaderLibrary = Ref<ShaderLibrary>::Create();
 
+		// The shader registry is written once after all shaders below are compiled
+		ShaderCache::BeginBatch();
+
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/PBR_Static");
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/PBR_Anim");
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/Grid");
@@ -174,6 +209,7 @@ namespace NR
 
 		// Compile shaders
 		Renderer::WaitAndRender();
+		ShaderCache::EndBatch();
 
 		uint32_t whiteTextureData = 0xffffffff;
 		sData->WhiteTexture = Texture2D::Create(ImageFormat::RGBA, 1, 1, &whiteTextureData);
@@ -200,7 +236,6 @@ namespace NR
 		sRendererAPI->Shutdown();
 
 		delete sData;
-		delete sCommandQueue;
 	}
 
 	RendererCapabilities& Renderer::GetCapabilities()
@@ -217,7 +252,78 @@ namespace NR
 	{
 		NR_PROFILE_FUNC();
 		NR_SCOPE_PERF("Renderer::WaitAndRender");
-		sCommandQueue->Execute();
+		ExecuteCommandQueue(sCommandQueue[GetRenderQueueSubmissionIndex()]);
+	}
+
+	void Renderer::WaitAndRender(RenderThread* renderThread)
+	{
+		NR_PROFILE_FUNC();
+
+		// Wait for kick, then set rendering to busy
+		{
+			NR_PROFILE_FUNC("Wait");
+			renderThread->WaitAndSet(RenderThread::State::Kick, RenderThread::State::Busy);
+		}
+
+		{
+			NR_SCOPE_PERF("Renderer::WaitAndRender");
+			ExecuteCommandQueue(sCommandQueue[GetRenderQueueIndex()]);
+		}
+
+		// Rendering has completed, set state to idle
+		renderThread->Set(RenderThread::State::Idle);
+	}
+
+	void Renderer::RenderThreadFunc(RenderThread* renderThread)
+	{
+		NR_PROFILE_THREAD("Render Thread");
+
+		bool running = true;
+		while (running)
+		{
+			renderThread->WaitAndSet(RenderThread::State::Kick, RenderThread::State::Busy);
+
+			{
+				NR_PROFILE_FUNC("Renderer::WaitAndRender");
+				ExecuteCommandQueue(sCommandQueue[GetRenderQueueIndex()]);
+			}
+
+			// Sample this before going idle, Terminate only clears it once it has seen the thread idle
+			running = renderThread->IsRunning();
+			renderThread->Set(RenderThread::State::Idle);
+		}
+	}
+
+	void Renderer::SwapQueues()
+	{
+		// Still part of the frame that is about to be handed to the render thread
+		DeferredCommandList unownedCommands;
+		{
+			std::scoped_lock<std::mutex> lock(sUnownedDeferredCommandsMutex);
+			unownedCommands.swap(sUnownedDeferredCommands);
+		}
+		if (!unownedCommands.empty())
+		{
+			SubmitDeferred(unownedCommands);
+		}
+
+		// Peaks are tracked per queue, so combine both of them
+		sRenderCommandQueueStatistics = sCommandQueue[GetRenderQueueIndex()].GetStatistics();
+		const RenderCommandQueue::Statistics& other = sCommandQueue[GetRenderQueueSubmissionIndex()].GetStatistics();
+		sRenderCommandQueueStatistics.PeakCommandCount = std::max(sRenderCommandQueueStatistics.PeakCommandCount, other.PeakCommandCount);
+		sRenderCommandQueueStatistics.PeakBytesUsed = std::max(sRenderCommandQueueStatistics.PeakBytesUsed, other.PeakBytesUsed);
+
+		sRenderCommandQueueSubmissionIndex = (sRenderCommandQueueSubmissionIndex + 1) % sRenderCommandQueueCount;
+	}
+
+	uint32_t Renderer::GetRenderQueueIndex()
+	{
+		return (sRenderCommandQueueSubmissionIndex + 1) % sRenderCommandQueueCount;
+	}
+
+	uint32_t Renderer::GetRenderQueueSubmissionIndex()
+	{
+		return sRenderCommandQueueSubmissionIndex;
 	}
 
 	void Renderer::BeginRenderPass(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<RenderPass> renderPass, bool explicitClear)
@@ -272,14 +378,14 @@ namespace NR
 		sRendererAPI->RenderStaticMesh(renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, materialTable, transformBuffer, transformOffset, instanceCount);
 	}
 
-	void Renderer::RenderSubmeshInstanced(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformUBs, uint32_t boneTransformsOffset, uint32_t instanceCount)
+	void Renderer::RenderSubmeshInstanced(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformUBs, uint32_t instanceCount)
 	{
-		sRendererAPI->RenderSubmeshInstanced(renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, materialTable, transformBuffer, transformOffset, boneTransformUBs, boneTransformsOffset, instanceCount);
+		sRendererAPI->RenderSubmeshInstanced(renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, materialTable, transformBuffer, transformOffset, boneTransformUBs, instanceCount);
 	}
 
-	void Renderer::RenderMeshWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformUBs, uint32_t boneTransformsOffset, uint32_t instanceCount, Ref<Material> material, Buffer additionalUniforms)
+	void Renderer::RenderMeshWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformUBs, uint32_t instanceCount, Ref<Material> material, Buffer additionalUniforms)
 	{
-		sRendererAPI->RenderMeshWithMaterial(renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, material, transformBuffer, transformOffset, boneTransformUBs, boneTransformsOffset, instanceCount, additionalUniforms);
+		sRendererAPI->RenderMeshWithMaterial(renderCommandBuffer, pipeline, uniformBufferSet, storageBufferSet, mesh, submeshIndex, material, transformBuffer, transformOffset, boneTransformUBs, instanceCount, additionalUniforms);
 	}
 
 	void Renderer::RenderStaticMeshWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<StaticMesh> mesh, uint32_t submeshIndex, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, uint32_t instanceCount, Ref<Material> material, Buffer additionalUniforms)
@@ -408,7 +514,50 @@ namespace NR
 
 	RenderCommandQueue& Renderer::GetRenderCommandQueue()
 	{
-		return *sCommandQueue;
+		if (sExecutingCommandQueue)
+		{
+			return *sExecutingCommandQueue;
+		}
+
+		return sCommandQueue[sRenderCommandQueueSubmissionIndex];
+	}
+
+	RenderCommandQueue::Statistics Renderer::GetRenderCommandQueueStatistics()
+	{
+		// The queues themselves can't be read here, the render thread may be executing one of them
+		return sRenderCommandQueueStatistics;
+	}
+
+	Renderer::DeferredCommandList* Renderer::SetDeferredCommandList(DeferredCommandList* commandList)
+	{
+		DeferredCommandList* previous = sDeferredCommandList;
+		sDeferredCommandList = commandList;
+		return previous;
+	}
+
+	Renderer::DeferredCommandList* Renderer::GetDeferredCommandList()
+	{
+		return sDeferredCommandList;
+	}
+
+	void Renderer::SubmitUnownedDeferred(std::function<void()>&& command)
+	{
+		if (!sUnownedDeferredCommandsReported.exchange(true))
+		{
+			NR_CORE_ERROR("Render commands were submitted from a job without a deferred command list, they are delayed to the next queue swap");
+		}
+
+		std::scoped_lock<std::mutex> lock(sUnownedDeferredCommandsMutex);
+		sUnownedDeferredCommands.push_back(std::move(command));
+	}
+
+	void Renderer::SubmitDeferred(DeferredCommandList& commandList)
+	{
+		NR_CORE_ASSERT(JobSystem::IsMainThread(), "Deferred render commands are submitted on the main thread");
+
+		for (auto& command : commandList)
+			command();
+		commandList.clear();
 	}
 
 	RenderCommandQueue& Renderer::GetRenderResourceReleaseQueue(uint32_t index)
@@ -2,6 +2,7 @@
 
 #include "RendererContext.h"
 #include "RenderCommandQueue.h"
+#include "RenderThread.h"
 #include "RenderPass.h"
 #include "RenderCommandBuffer.h"
 #include "PipelineCompute.h"
@@ -11,6 +12,7 @@
 #include "StorageBufferSet.h"
 
 #include "NotRed/Core/Application.h"
+#include "NotRed/Core/JobSystem.h"
 
 #include "RendererCapabilities.h"
 
@@ -37,6 +39,9 @@ namespace NR
 	public:
 		typedef void(*RenderCommandFn)(void*);
 
+		// Render commands recorded on a job worker, replayed into the command queue on the main thread by SubmitDeferred
+		using DeferredCommandList = std::vector<std::function<void()>>;
+
 		static Ref<RendererContext> GetContext()
 		{
 			return Application::Get().GetWindow().GetRenderContext();
@@ -52,6 +57,34 @@ namespace NR
 		template<typename FuncT>
 		static void Submit(FuncT&& func)
 		{
+			// The command queue is recorded on the main thread. Jobs that render (e.g. async asset loads) record into their
+			// deferred command list, which is replayed on the main thread once the job is done.
+			if (JobSystem::IsWorkerThread())
+			{
+				using CommandT = std::decay_t<FuncT>;
+				std::function<void()> deferredCommand;
+				if constexpr (std::is_copy_constructible_v<CommandT>)
+				{
+					deferredCommand = [command = CommandT(std::forward<FuncT>(func))]() mutable { Submit(std::move(command)); };
+				}
+				else
+				{
+					// std::function needs a copyable target
+					auto command = std::make_shared<CommandT>(std::forward<FuncT>(func));
+					deferredCommand = [command]() { Submit(std::move(*command)); };
+				}
+
+				if (DeferredCommandList* commandList = GetDeferredCommandList())
+				{
+					commandList->push_back(std::move(deferredCommand));
+				}
+				else
+				{
+					SubmitUnownedDeferred(std::move(deferredCommand));
+				}
+				return;
+			}
+
 			auto renderCmd = [](void* ptr) {
 				auto pFunc = (FuncT*)ptr;
 				(*pFunc)();
@@ -61,7 +94,7 @@ namespace NR
 				// static_assert(std::is_trivially_destructible_v<FuncT>, "FuncT must be trivially destructible");
 				pFunc->~FuncT();
 				};
-			auto storageBuffer = GetRenderCommandQueue().Allocate(renderCmd, sizeof(func));
+			auto storageBuffer = GetRenderCommandQueue().Allocate(renderCmd, sizeof(func), alignof(FuncT));
 			new (storageBuffer) FuncT(std::forward<FuncT>(func));
 		}
 
@@ -81,7 +114,7 @@ namespace NR
 			Submit([renderCmd, func]()
 				{
 					const uint32_t index = Renderer::GetCurrentFrameIndex();
-					auto storageBuffer = GetRenderResourceReleaseQueue(index).Allocate(renderCmd, sizeof(func));
+					auto storageBuffer = GetRenderResourceReleaseQueue(index).Allocate(renderCmd, sizeof(func), alignof(FuncT));
 					new (storageBuffer) FuncT(std::forward<FuncT>((FuncT&&)func));
 				});
 		}
@@ -91,7 +124,14 @@ namespace NR
 			return s_Instance->m_CommandQueue.Allocate(fn, size);
 		}*/
 
+		// Executes everything submitted so far on the calling thread. Only valid while the render thread is idle (init/shutdown)
 		static void WaitAndRender();
+		static void WaitAndRender(RenderThread* renderThread);
+		static void RenderThreadFunc(RenderThread* renderThread);
+		static void SwapQueues();
+
+		static uint32_t GetRenderQueueIndex();
+		static uint32_t GetRenderQueueSubmissionIndex();
 
 		// ~Actual~ Renderer here... TODO: remove confusion later
 		static void BeginRenderPass(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<RenderPass> renderPass, bool explicitClear = false);
@@ -106,8 +146,8 @@ namespace NR
 
 		static void RenderStaticMesh(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<StaticMesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, uint32_t instanceCount);
 		// static void RenderSubmesh(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, const glm::mat4& transform);
-		static void RenderSubmeshInstanced(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformUBs, uint32_t boneTransformsOffset, uint32_t instanceCount);
-		static void RenderMeshWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformUBs, uint32_t boneTransformsOffset, uint32_t instanceCount, Ref<Material> material, Buffer additionalUniforms = Buffer());
+		static void RenderSubmeshInstanced(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformUBs, uint32_t instanceCount);
+		static void RenderMeshWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Mesh> mesh, uint32_t submeshIndex, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, const std::vector<Ref<StorageBuffer>>& boneTransformUBs, uint32_t instanceCount, Ref<Material> material, Buffer additionalUniforms = Buffer());
 		static void RenderStaticMeshWithMaterial(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<StaticMesh> mesh, uint32_t submeshIndex, Ref<VertexBuffer> transformBuffer, uint32_t transformOffset, uint32_t instanceCount, Ref<Material> material, Buffer additionalUniforms = Buffer());
 		static void RenderQuad(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<StorageBufferSet> storageBufferSet, Ref<Material> material, const glm::mat4& transform);
 		static void SubmitFullscreenQuad(Ref<RenderCommandBuffer> renderCommandBuffer, Ref<Pipeline> pipeline, Ref<UniformBufferSet> uniformBufferSet, Ref<Material> material);
@@ -137,8 +177,19 @@ namespace NR
 		static RendererConfig& GetConfig();
 
 		static RenderCommandQueue& GetRenderResourceReleaseQueue(uint32_t index);
+
+		// Statistics of the command queue of the most recently executed frame, as of the last queue swap
+		static RenderCommandQueue::Statistics GetRenderCommandQueueStatistics();
+
+		// Submit calls on this worker thread record into commandList until it is reset, returns the list that was set before
+		static DeferredCommandList* SetDeferredCommandList(DeferredCommandList* commandList);
+		// Submits the recorded commands in order, main thread only
+		static void SubmitDeferred(DeferredCommandList& commandList);
 	private:
 		static RenderCommandQueue& GetRenderCommandQueue();
+		static DeferredCommandList* GetDeferredCommandList();
+		// For jobs that submit without a deferred command list, the commands are replayed on the main thread by SwapQueues
+		static void SubmitUnownedDeferred(std::function<void()>&& command);
 	};
 
 
@@ -44,22 +44,53 @@ enum Binding : uint32_t
     StarsData = 18,
     StarsEnvironmentData = 19,
     StarsBuffer = 20,
+
+    InstanceTransforms = 21,
 };
 
 namespace NR
 {
-    static std::vector<std::thread> sThreadPool;
+    static thread_local uint32_t sSubmissionBufferIndex = 0;
+
+    // Material properties that are set every frame, hashed once up front
+    namespace MaterialProperties
+    {
+        static constexpr MaterialPropertyID GridScale("uSettings.Scale");
+        static constexpr MaterialPropertyID GridSize("uSettings.Size");
+        static constexpr MaterialPropertyID Color("uMaterialUniforms.Color");
+        static constexpr MaterialPropertyID PreDepthMap("uPreDepthMap");
+        static constexpr MaterialPropertyID ScreenSize("uScreenData.uScreenSize");
+        static constexpr MaterialPropertyID TextureLod("uUniforms.TextureLod");
+        static constexpr MaterialPropertyID Intensity("uUniforms.Intensity");
+        static constexpr MaterialPropertyID Texture("uTexture");
+        static constexpr MaterialPropertyID LinearDepthTex("uLinearDepthTex");
+        static constexpr MaterialPropertyID UVOffset("uInfo.UVOffset");
+        static constexpr MaterialPropertyID LinearDepthTexArray("uLinearDepthTexArray");
+        static constexpr MaterialPropertyID ViewNormalsTex("uViewNormalsTex");
+        static constexpr MaterialPropertyID ViewPositionTex("uViewPositionTex");
+        static constexpr MaterialPropertyID OutputColor("oColor");
+        static constexpr MaterialPropertyID TexResultsArray("uTexResultsArray");
+        static constexpr MaterialPropertyID InvResDirection("uInfo.InvResDirection");
+        static constexpr MaterialPropertyID Sharpness("uInfo.Sharpness");
+        static constexpr MaterialPropertyID InputTex("uInputTex");
+        static constexpr MaterialPropertyID OutputImage("oImage");
+        static constexpr MaterialPropertyID BloomTexture("uBloomTexture");
+        static constexpr MaterialPropertyID Exposure("uUniforms.Exposure");
+        static constexpr MaterialPropertyID BloomIntensity("uUniforms.BloomIntensity");
+        static constexpr MaterialPropertyID BloomDirtIntensity("uUniforms.BloomDirtIntensity");
+        static constexpr MaterialPropertyID BloomDirtTexture("uBloomDirtTexture");
+        static constexpr MaterialPropertyID DepthTexture("uDepthTexture");
+    }
 
     SceneRenderer::SceneRenderer(Ref<Scene> scene, SceneRendererSpecification specification)
         : mScene(scene), mSpecification(specification)
     {
+        mSubmissionBuffers.resize(1);
         Init();
     }
 
     SceneRenderer::~SceneRenderer()
     {
-        delete[] mTransformVertexData;
-        delete[] mBoneTransformsData;
     }
 
     void SceneRenderer::Init()
@@ -89,6 +120,9 @@ namespace NR
 
         mCompositeShader = Renderer::GetShaderLibrary()->Get("SceneComposite");
         CompositeMaterial = Material::Create(mCompositeShader);
+        mMaterialUniforms.CompositeExposure = CompositeMaterial->GetUniformHandle(MaterialProperties::Exposure);
+        mMaterialUniforms.CompositeBloomIntensity = CompositeMaterial->GetUniformHandle(MaterialProperties::BloomIntensity);
+        mMaterialUniforms.CompositeBloomDirtIntensity = CompositeMaterial->GetUniformHandle(MaterialProperties::BloomDirtIntensity);
 
         //Light culling compute pipeline
         {
@@ -111,9 +145,8 @@ namespace NR
         };
 
         VertexBufferLayout instanceLayout = {
-            { ShaderDataType::Float4, "aMRow0" },
-            { ShaderDataType::Float4, "aMRow1" },
-            { ShaderDataType::Float4, "aMRow2" },
+            { ShaderDataType::Int, "aTransformIndex" },
+            { ShaderDataType::Int, "aBoneTransformsIndex" },
         };
 
         VertexBufferLayout boneInfluenceLayout = {
@@ -326,6 +359,7 @@ namespace NR
                 mDeinterleavingPipelines[rp] = Pipeline::Create(pipelineSpec);
             }
             mDeinterleavingMaterial = Material::Create(pipelineSpec.Shader, pipelineSpec.DebugName);
+            mMaterialUniforms.DeinterleavingUVOffset = mDeinterleavingMaterial->GetUniformHandle(MaterialProperties::UVOffset);
 
         }
 
@@ -409,6 +443,8 @@ namespace NR
                 pipelineSpecification.DebugName = "HBAOBlur";
                 mHBAOBlurPipelines[0] = Pipeline::Create(pipelineSpecification);
                 mHBAOBlurMaterials[0] = Material::Create(pipelineSpecification.Shader, pipelineSpecification.DebugName);
+                mMaterialUniforms.HBAOBlurInvResDirection[0] = mHBAOBlurMaterials[0]->GetUniformHandle(MaterialProperties::InvResDirection);
+                mMaterialUniforms.HBAOBlurSharpness[0] = mHBAOBlurMaterials[0]->GetUniformHandle(MaterialProperties::Sharpness);
             }
 
             //HBAO second blur pass
@@ -431,6 +467,8 @@ namespace NR
                 pipelineSpecification.DebugName = "HBAOBlur2";
                 mHBAOBlurPipelines[1] = Pipeline::Create(pipelineSpecification);
                 mHBAOBlurMaterials[1] = Material::Create(pipelineSpecification.Shader, pipelineSpecification.DebugName);
+                mMaterialUniforms.HBAOBlurInvResDirection[1] = mHBAOBlurMaterials[1]->GetUniformHandle(MaterialProperties::InvResDirection);
+                mMaterialUniforms.HBAOBlurSharpness[1] = mHBAOBlurMaterials[1]->GetUniformHandle(MaterialProperties::Sharpness);
             }
         }
 
@@ -657,8 +695,8 @@ namespace NR
             const float gridScale = 16.025f;
             const float gridSize = 0.025f;
             mGridMaterial = Material::Create(pipelineSpec.Shader, pipelineSpec.DebugName);
-            mGridMaterial->Set("uSettings.Scale", gridScale);
-            mGridMaterial->Set("uSettings.Size", gridSize);
+            mGridMaterial->Set(MaterialProperties::GridScale, gridScale);
+            mGridMaterial->Set(MaterialProperties::GridSize, gridSize);
         }
 
         // Collider
@@ -667,10 +705,11 @@ namespace NR
         //ColliderMaterial->ModifyFlags(MaterialFlag::DepthTest, false);
 
         mWireframeMaterial = Material::Create(Renderer::GetShaderLibrary()->Get("Wireframe"), "Wireframe");
-        mWireframeMaterial->Set("uMaterialUniforms.Color", glm::vec4{ 1.0f, 0.5f, 0.0f, 1.0f });
+        mWireframeMaterial->Set(MaterialProperties::Color, glm::vec4{ 1.0f, 0.5f, 0.0f, 1.0f });
 
         mColliderMaterial = Material::Create(Renderer::GetShaderLibrary()->Get("Wireframe"), "Collider");
-        mColliderMaterial->Set("uMaterialUniforms.Color", mOptions.PhysicsCollidersColor);
+        mMaterialUniforms.ColliderColor = mColliderMaterial->GetUniformHandle(MaterialProperties::Color);
+        mColliderMaterial->Set(mMaterialUniforms.ColliderColor, mOptions.PhysicsCollidersColor);
 
         // Skybox
         {
@@ -687,19 +726,23 @@ namespace NR
             mSkyboxPipeline = Pipeline::Create(pipelineSpec);
             mSkyboxMaterial = Material::Create(pipelineSpec.Shader, pipelineSpec.DebugName);
             mSkyboxMaterial->ModifyFlags(MaterialFlag::DepthTest, false);
+            mMaterialUniforms.SkyboxTextureLod = mSkyboxMaterial->GetUniformHandle(MaterialProperties::TextureLod);
+            mMaterialUniforms.SkyboxIntensity = mSkyboxMaterial->GetUniformHandle(MaterialProperties::Intensity);
         }
 
-        const size_t TransformBufferCount = 100 * 1024; // 10240 transforms
-        mSubmeshTransformBuffer = VertexBuffer::Create(sizeof(TransformVertexData) * TransformBufferCount);
-        mTransformVertexData = new TransformVertexData[TransformBufferCount];
+        // Initial capacities, UploadInstanceData grows the buffers when a frame needs more
+        mTransformBufferCapacity = 10 * 1024;
+        mStorageBufferSet->Create(static_cast<uint32_t>(sizeof(TransformVertexData) * mTransformBufferCapacity), Binding::InstanceTransforms);
+
+        mInstanceVertexBufferCapacity = 20 * 1024;
+        mInstanceVertexBuffer = VertexBuffer::Create(static_cast<uint32_t>(sizeof(InstanceVertexData) * mInstanceVertexBufferCapacity));
 
-        const size_t BoneTransformBufferCount = 1 * 1024; // basically means limited to 1024 animated meshes
+        mBoneTransformBufferCapacity = 64;
         mBoneTransformStorageBuffers.resize(Renderer::GetConfig().FramesInFlight);
         for (auto& buffer : mBoneTransformStorageBuffers)
         {
-            buffer = StorageBuffer::Create(static_cast<uint32_t>(sizeof(BoneTransforms) * BoneTransformBufferCount), 0);
+            buffer = StorageBuffer::Create(static_cast<uint32_t>(sizeof(BoneTransforms) * mBoneTransformBufferCapacity), 0);
         }
-        mBoneTransformsData = new BoneTransforms[BoneTransformBufferCount];
 
         Ref<SceneRenderer> instance = this;
         Renderer::Submit([instance]() mutable
@@ -858,11 +901,15 @@ namespace NR
         const std::vector<PointLight>& pointLightsVec = mSceneData.SceneLightEnvironment.PointLights;
         pointLightData.Count = uint32_t(pointLightsVec.size());
         std::memcpy(pointLightData.PointLights, pointLightsVec.data(), sizeof PointLight * pointLightsVec.size()); //(Karim) Do we really have to copy that?
-        Renderer::Submit([instance, &pointLightData]() mutable
+
+        // Only the lights in use are copied into the command, PointLightsUB is rewritten by the next frame
+        Buffer pointLights = Buffer::Copy(&pointLightData, 16u + (uint32_t)sizeof(PointLight) * pointLightData.Count);
+        Renderer::Submit([instance, pointLights]() mutable
             {
                 const uint32_t bufferIndex = Renderer::GetCurrentFrameIndex();
                 Ref<UniformBuffer> bufferSet = instance->mUniformBufferSet->Get(Binding::PointLightData, 0, bufferIndex);
-                bufferSet->RT_SetData(&pointLightData, 16ull + sizeof PointLight * pointLightData.Count);
+                bufferSet->RT_SetData(pointLights.Data, pointLights.Size);
+                pointLights.Release();
             });
 
         const auto& directionalLight = mSceneData.SceneLightEnvironment.DirectionalLights[0];
@@ -901,7 +948,10 @@ namespace NR
         {
             CascadeSplits[i] = cascades[i].SplitDepth;
             shadowData.ViewProjection[i] = cascades[i].ViewProj;
+            mCullingData.CascadeFrustums[i] = Frustum(cascades[i].ViewProj);
         }
+        mCullingData.CameraFrustum = Frustum(viewProjection);
+        mCullingData.CastShadows = directionalLight.Multiplier != 0.0f && directionalLight.CastShadows;
         Renderer::Submit([instance, shadowData]() mutable
             {
                 const uint32_t bufferIndex = Renderer::GetCurrentFrameIndex();
@@ -924,224 +974,238 @@ namespace NR
         NR_PROFILE_FUNC();
 
         NR_CORE_ASSERT(mActive);
-#if MULTI_THREAD
-        Ref<SceneRenderer> instance = this;
-        sThreadPool.emplace_back(([instance]() mutable
-            {
-                instance->FlushDrawList();
-            }));
-#else 
         FlushDrawList();
-#endif
 
         mActive = false;
     }
 
-    void SceneRenderer::WaitForThreads()
+    void SceneRenderer::ReserveSubmissionBuffers(uint32_t count)
     {
-        for (uint32_t i = 0; i < sThreadPool.size(); ++i)
-            sThreadPool[i].join();
+        if (mSubmissionBuffers.size() < count)
+            mSubmissionBuffers.resize(count);
+    }
 
-        sThreadPool.clear();
+    void SceneRenderer::SetThreadSubmissionBuffer(uint32_t index)
+    {
+        sSubmissionBufferIndex = index;
     }
 
-    void SceneRenderer::SubmitMesh(Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, const glm::mat4& transform, const ozz::vector<ozz::math::Float4x4>& boneTransforms, Ref<Material> overrideMaterial)
+    SceneRenderer::SubmissionBuffer& SceneRenderer::GetSubmissionBuffer()
+    {
+        NR_CORE_ASSERT(sSubmissionBufferIndex < mSubmissionBuffers.size(), "Submission buffer was not reserved");
+        return mSubmissionBuffers[sSubmissionBufferIndex];
+    }
+
+    void SceneRenderer::SubmissionBuffer::Clear()
+    {
+        Submissions.clear();
+        Transforms.clear();
+        BoneTransformsStaging.clear();
+        BoneTransformsKeys.clear();
+        BoneTransformsLookup.Clear();
+
+        DrawList.clear();
+        SelectedMeshDrawList.clear();
+        ShadowPassDrawList.clear();
+
+        StaticMeshDrawList.clear();
+        SelectedStaticMeshDrawList.clear();
+        StaticMeshShadowPassDrawList.clear();
+
+        StaticColliderDrawList.clear();
+        ColliderDrawList.clear();
+
+        Submitted = 0;
+        Visible = 0;
+        ShadowCasters = 0;
+    }
+
+    uint8_t SceneRenderer::GetSubmeshVisibility(const AABB& localBounds, const glm::mat4& transform) const
+    {
+        const AABB worldBounds = localBounds.Transformed(transform);
+
+        uint8_t visibility = (uint8_t)MeshVisibility::None;
+        if (mCullingData.CameraFrustum.IntersectsAABB(worldBounds))
+        {
+            visibility |= (uint8_t)MeshVisibility::Camera;
+        }
+
+        if (mCullingData.CastShadows)
+        {
+            for (const Frustum& cascadeFrustum : mCullingData.CascadeFrustums)
+            {
+                if (cascadeFrustum.IntersectsAABB(worldBounds))
+                {
+                    visibility |= (uint8_t)MeshVisibility::Shadow;
+                    break;
+                }
+            }
+        }
+
+        return visibility;
+    }
+
+    void SceneRenderer::CountSubmission(SubmissionBuffer& buffer, uint8_t visibility)
+    {
+        buffer.Submitted++;
+        if (visibility & (uint8_t)MeshVisibility::Camera)
+            buffer.Visible++;
+        if (visibility & (uint8_t)MeshVisibility::Shadow)
+            buffer.ShadowCasters++;
+    }
+
+    void SceneRenderer::SubmitMesh(Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, const glm::mat4& transform, const ozz::vector<ozz::math::Float4x4>& boneTransforms, Ref<Material> overrideMaterial, uint8_t visibility)
     {
         NR_PROFILE_FUNC();
 
+        SubmissionBuffer& buffer = GetSubmissionBuffer();
+
+        CountSubmission(buffer, visibility);
+        if (visibility == (uint8_t)MeshVisibility::None)
+            return;
+
         const auto meshSource = mesh->GetMeshSource();
         const auto& submeshes = meshSource->GetSubmeshes();
         uint32_t materialIndex = submeshes[submeshIndex].MaterialIndex;
         AssetHandle materialHandle = materialTable->HasMaterial(materialIndex) ? materialTable->GetMaterial(materialIndex)->Handle : mesh->GetMaterials()->GetMaterial(materialIndex)->Handle;
 
-        MeshKey meshKey = { mesh->Handle, materialHandle, submeshIndex };
-        auto& transformStorage = mMeshTransformMap[meshKey].Transforms.emplace_back();
+        const uint32_t transformIndex = AddTransform(buffer, transform);
+        const uint32_t boneTransformsIndex = mesh->IsRigged() ? CopyToBoneTransformStorage(buffer, meshSource, boneTransforms) : NoBoneTransforms;
 
-        transformStorage.MRow[0] = { transform[0][0], transform[1][0], transform[2][0], transform[3][0] };
-        transformStorage.MRow[1] = { transform[0][1], transform[1][1], transform[2][1], transform[3][1] };
-        transformStorage.MRow[2] = { transform[0][2], transform[1][2], transform[2][2], transform[3][2] };
-
-        if (mesh->IsRigged())
-        {
-            CopyToBoneTransformStorage(meshKey, meshSource, boneTransforms);
-        }
+        const AssetHandle meshHandle = mesh->Handle;
+        const uint32_t submission = (uint32_t)buffer.Submissions.size();
+        buffer.Submissions.push_back({ std::move(mesh), nullptr, std::move(materialTable), std::move(overrideMaterial) });
 
         // Main geo
+        if (visibility & (uint8_t)MeshVisibility::Camera)
         {
-            auto& dc = mDrawList[meshKey];
-            dc.Mesh = mesh;
-            dc.SubmeshIndex = submeshIndex;
-            dc.MaterialTable = materialTable;
-            dc.OverrideMaterial = overrideMaterial;
-            dc.InstanceCount++;
+            AddDrawInstance(buffer.DrawList, submission, meshHandle, materialHandle, submeshIndex, transformIndex, boneTransformsIndex);
         }
 
         // Shadow pass
+        if (visibility & (uint8_t)MeshVisibility::Shadow)
         {
-            auto& dc = mShadowPassDrawList[meshKey];
-            dc.Mesh = mesh;
-            dc.SubmeshIndex = submeshIndex;
-            dc.MaterialTable = materialTable;
-            dc.OverrideMaterial = overrideMaterial;
-            dc.InstanceCount++;
+            AddDrawInstance(buffer.ShadowPassDrawList, submission, meshHandle, materialHandle, submeshIndex, transformIndex, boneTransformsIndex);
         }
     }
 
-    void SceneRenderer::SubmitStaticMesh(Ref<StaticMesh> staticMesh, Ref<MaterialTable> materialTable, const glm::mat4& transform, Ref<Material> overrideMaterial)
+    void SceneRenderer::SubmitStaticMesh(Ref<StaticMesh> staticMesh, Ref<MaterialTable> materialTable, const glm::mat4& transform, Ref<Material> overrideMaterial, const uint8_t* submeshVisibility)
     {
         NR_PROFILE_FUNC();
 
+        SubmissionBuffer& buffer = GetSubmissionBuffer();
+
         Ref<MeshSource> meshSource = staticMesh->GetMeshSource();
         const auto& submeshData = meshSource->GetSubmeshes();
-        for (uint32_t submeshIndex : staticMesh->GetSubmeshes())
-        {
-            glm::mat4 submeshTransform = transform * submeshData[submeshIndex].Transform;
+        const auto& staticSubmeshes = staticMesh->GetSubmeshes();
+        const AssetHandle meshHandle = staticMesh->Handle;
+        const Ref<MaterialTable> meshMaterials = staticMesh->GetMaterials();
 
-            const auto& submeshes = staticMesh->GetMeshSource()->GetSubmeshes();
-            uint32_t materialIndex = submeshes[submeshIndex].MaterialIndex;
-            AssetHandle materialHandle = materialTable->HasMaterial(materialIndex) ? materialTable->GetMaterial(materialIndex)->Handle : staticMesh->GetMaterials()->GetMaterial(materialIndex)->Handle;
+        const uint32_t submission = (uint32_t)buffer.Submissions.size();
+        buffer.Submissions.push_back({ nullptr, std::move(staticMesh), materialTable, std::move(overrideMaterial) });
 
-            MeshKey meshKey = { staticMesh->Handle, materialHandle, submeshIndex };
-            auto& transformStorage = mMeshTransformMap[meshKey].Transforms.emplace_back();
+        for (size_t i = 0; i < staticSubmeshes.size(); ++i)
+        {
+            const uint32_t submeshIndex = staticSubmeshes[i];
+            const uint8_t visibility = submeshVisibility ? submeshVisibility[i] : (uint8_t)MeshVisibility::All;
+            CountSubmission(buffer, visibility);
+            if (visibility == (uint8_t)MeshVisibility::None)
+                continue;
+
+            uint32_t materialIndex = submeshData[submeshIndex].MaterialIndex;
+            AssetHandle materialHandle = materialTable->HasMaterial(materialIndex) ? materialTable->GetMaterial(materialIndex)->Handle : meshMaterials->GetMaterial(materialIndex)->Handle;
 
-            transformStorage.MRow[0] = { submeshTransform[0][0], submeshTransform[1][0], submeshTransform[2][0], submeshTransform[3][0] };
-            transformStorage.MRow[1] = { submeshTransform[0][1], submeshTransform[1][1], submeshTransform[2][1], submeshTransform[3][1] };
-            transformStorage.MRow[2] = { submeshTransform[0][2], submeshTransform[1][2], submeshTransform[2][2], submeshTransform[3][2] };
+            const uint32_t transformIndex = AddTransform(buffer, transform * submeshData[submeshIndex].Transform);
 
             // Main geo
+            if (visibility & (uint8_t)MeshVisibility::Camera)
             {
-                auto& dc = mStaticMeshDrawList[meshKey];
-                dc.StaticMesh = staticMesh;
-                dc.SubmeshIndex = submeshIndex;
-                dc.MaterialTable = materialTable;
-                dc.OverrideMaterial = overrideMaterial;
-                dc.InstanceCount++;
+                AddDrawInstance(buffer.StaticMeshDrawList, submission, meshHandle, materialHandle, submeshIndex, transformIndex, NoBoneTransforms);
             }
 
             // Shadow pass
+            if (visibility & (uint8_t)MeshVisibility::Shadow)
             {
-                auto& dc = mStaticMeshShadowPassDrawList[meshKey];
-                dc.StaticMesh = staticMesh;
-                dc.SubmeshIndex = submeshIndex;
-                dc.MaterialTable = materialTable;
-                dc.OverrideMaterial = overrideMaterial;
-                dc.InstanceCount++;
+                AddDrawInstance(buffer.StaticMeshShadowPassDrawList, submission, meshHandle, materialHandle, submeshIndex, transformIndex, NoBoneTransforms);
             }
         }
-
     }
 
-    void SceneRenderer::SubmitSelectedMesh(Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, const glm::mat4& transform, const ozz::vector<ozz::math::Float4x4>& boneTransforms, Ref<Material> overrideMaterial)
+    void SceneRenderer::SubmitSelectedMesh(Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, const glm::mat4& transform, const ozz::vector<ozz::math::Float4x4>& boneTransforms, Ref<Material> overrideMaterial, uint8_t visibility)
     {
         NR_PROFILE_FUNC();
 
+        SubmissionBuffer& buffer = GetSubmissionBuffer();
+
+        CountSubmission(buffer, visibility);
+        if (visibility == (uint8_t)MeshVisibility::None)
+            return;
+
         const auto meshSource = mesh->GetMeshSource();
         const auto& submeshes = meshSource->GetSubmeshes();
         uint32_t materialIndex = submeshes[submeshIndex].MaterialIndex;
         AssetHandle materialHandle = materialTable->HasMaterial(materialIndex) ? materialTable->GetMaterial(materialIndex)->Handle : mesh->GetMaterials()->GetMaterial(materialIndex)->Handle;
 
-        MeshKey meshKey = { mesh->Handle, materialHandle, submeshIndex };
-        auto& transformStorage = mMeshTransformMap[meshKey].Transforms.emplace_back();
-
-        transformStorage.MRow[0] = { transform[0][0], transform[1][0], transform[2][0], transform[3][0] };
-        transformStorage.MRow[1] = { transform[0][1], transform[1][1], transform[2][1], transform[3][1] };
-        transformStorage.MRow[2] = { transform[0][2], transform[1][2], transform[2][2], transform[3][2] };
-
-        if (mesh->IsRigged())
-        {
-            CopyToBoneTransformStorage(meshKey, meshSource, boneTransforms);
-        }
+        const uint32_t transformIndex = AddTransform(buffer, transform);
+        const uint32_t boneTransformsIndex = mesh->IsRigged() ? CopyToBoneTransformStorage(buffer, meshSource, boneTransforms) : NoBoneTransforms;
 
-        uint32_t instanceIndex = 0;
+        const AssetHandle meshHandle = mesh->Handle;
+        const uint32_t submission = (uint32_t)buffer.Submissions.size();
+        buffer.Submissions.push_back({ std::move(mesh), nullptr, std::move(materialTable), std::move(overrideMaterial) });
 
-        // Main geo
+        if (visibility & (uint8_t)MeshVisibility::Camera)
         {
-            auto& dc = mDrawList[meshKey];
-            dc.Mesh = mesh;
-            dc.SubmeshIndex = submeshIndex;
-            dc.MaterialTable = materialTable;
-            dc.OverrideMaterial = overrideMaterial;
-
-            instanceIndex = dc.InstanceCount;
-            dc.InstanceCount++;
-        }
-
-        // Selected mesh list
-        {
-            auto& dc = mSelectedMeshDrawList[meshKey];
-            dc.Mesh = mesh;
-            dc.SubmeshIndex = submeshIndex;
-            dc.MaterialTable = materialTable;
-            dc.OverrideMaterial = overrideMaterial;
-            dc.InstanceCount++;
-            dc.InstanceBaseIndex = instanceIndex;
+            // Main geo and selected mesh list
+            AddDrawInstance(buffer.DrawList, submission, meshHandle, materialHandle, submeshIndex, transformIndex, boneTransformsIndex);
+            AddDrawInstance(buffer.SelectedMeshDrawList, submission, meshHandle, materialHandle, submeshIndex, transformIndex, boneTransformsIndex);
         }
 
         // Shadow pass
+        if (visibility & (uint8_t)MeshVisibility::Shadow)
         {
-            auto& dc = mShadowPassDrawList[meshKey];
-            dc.Mesh = mesh;
-            dc.SubmeshIndex = submeshIndex;
-            dc.MaterialTable = materialTable;
-            dc.OverrideMaterial = overrideMaterial;
-            dc.InstanceCount++;
+            AddDrawInstance(buffer.ShadowPassDrawList, submission, meshHandle, materialHandle, submeshIndex, transformIndex, boneTransformsIndex);
         }
     }
 
-    void SceneRenderer::SubmitSelectedStaticMesh(Ref<StaticMesh> staticMesh, Ref<MaterialTable> materialTable, const glm::mat4& transform, Ref<Material> overrideMaterial)
+    void SceneRenderer::SubmitSelectedStaticMesh(Ref<StaticMesh> staticMesh, Ref<MaterialTable> materialTable, const glm::mat4& transform, Ref<Material> overrideMaterial, const uint8_t* submeshVisibility)
     {
         NR_PROFILE_FUNC();
 
+        SubmissionBuffer& buffer = GetSubmissionBuffer();
+
         Ref<MeshSource> meshSource = staticMesh->GetMeshSource();
         const auto& submeshData = meshSource->GetSubmeshes();
-        for (uint32_t submeshIndex : staticMesh->GetSubmeshes())
-        {
-            glm::mat4 submeshTransform = transform * submeshData[submeshIndex].Transform;
+        const auto& staticSubmeshes = staticMesh->GetSubmeshes();
+        const AssetHandle meshHandle = staticMesh->Handle;
+        const Ref<MaterialTable> meshMaterials = staticMesh->GetMaterials();
 
-            const auto& submeshes = staticMesh->GetMeshSource()->GetSubmeshes();
-            uint32_t materialIndex = submeshes[submeshIndex].MaterialIndex;
-            AssetHandle materialHandle = materialTable->HasMaterial(materialIndex) ? materialTable->GetMaterial(materialIndex)->Handle : staticMesh->GetMaterials()->GetMaterial(materialIndex)->Handle;
+        const uint32_t submission = (uint32_t)buffer.Submissions.size();
+        buffer.Submissions.push_back({ nullptr, std::move(staticMesh), materialTable, std::move(overrideMaterial) });
 
-            MeshKey meshKey = { staticMesh->Handle, materialHandle, submeshIndex };
-            auto& transformStorage = mMeshTransformMap[meshKey].Transforms.emplace_back();
-
-            transformStorage.MRow[0] = { submeshTransform[0][0], submeshTransform[1][0], submeshTransform[2][0], submeshTransform[3][0] };
-            transformStorage.MRow[1] = { submeshTransform[0][1], submeshTransform[1][1], submeshTransform[2][1], submeshTransform[3][1] };
-            transformStorage.MRow[2] = { submeshTransform[0][2], submeshTransform[1][2], submeshTransform[2][2], submeshTransform[3][2] };
+        for (size_t i = 0; i < staticSubmeshes.size(); ++i)
+        {
+            const uint32_t submeshIndex = staticSubmeshes[i];
+            const uint8_t visibility = submeshVisibility ? submeshVisibility[i] : (uint8_t)MeshVisibility::All;
+            CountSubmission(buffer, visibility);
+            if (visibility == (uint8_t)MeshVisibility::None)
+                continue;
 
-            uint32_t instanceIndex = 0;
+            uint32_t materialIndex = submeshData[submeshIndex].MaterialIndex;
+            AssetHandle materialHandle = materialTable->HasMaterial(materialIndex) ? materialTable->GetMaterial(materialIndex)->Handle : meshMaterials->GetMaterial(materialIndex)->Handle;
 
-            // Main geo
-            {
-                auto& dc = mStaticMeshDrawList[meshKey];
-                dc.StaticMesh = staticMesh;
-                dc.SubmeshIndex = submeshIndex;
-                dc.MaterialTable = materialTable;
-                dc.OverrideMaterial = overrideMaterial;
-
-                instanceIndex = dc.InstanceCount;
-                dc.InstanceCount++;
-            }
+            const uint32_t transformIndex = AddTransform(buffer, transform * submeshData[submeshIndex].Transform);
 
-            // Selected mesh list
+            if (visibility & (uint8_t)MeshVisibility::Camera)
             {
-                auto& dc = mSelectedStaticMeshDrawList[meshKey];
-                dc.StaticMesh = staticMesh;
-                dc.SubmeshIndex = submeshIndex;
-                dc.MaterialTable = materialTable;
-                dc.OverrideMaterial = overrideMaterial;
-                dc.InstanceCount++;
-                dc.InstanceBaseIndex = instanceIndex;
+                // Main geo and selected mesh list
+                AddDrawInstance(buffer.StaticMeshDrawList, submission, meshHandle, materialHandle, submeshIndex, transformIndex, NoBoneTransforms);
+                AddDrawInstance(buffer.SelectedStaticMeshDrawList, submission, meshHandle, materialHandle, submeshIndex, transformIndex, NoBoneTransforms);
             }
 
             // Shadow pass
+            if (visibility & (uint8_t)MeshVisibility::Shadow)
             {
-                auto& dc = mStaticMeshShadowPassDrawList[meshKey];
-                dc.StaticMesh = staticMesh;
-                dc.SubmeshIndex = submeshIndex;
-                dc.MaterialTable = materialTable;
-                dc.OverrideMaterial = overrideMaterial;
-                dc.InstanceCount++;
+                AddDrawInstance(buffer.StaticMeshShadowPassDrawList, submission, meshHandle, materialHandle, submeshIndex, transformIndex, NoBoneTransforms);
             }
         }
     }
@@ -1163,44 +1227,50 @@ namespace NR
 
     void SceneRenderer::SubmitPhysicsDebugMesh(Ref<Mesh> mesh, uint32_t submeshIndex, const glm::mat4& transform)
     {
-        MeshKey meshKey = { mesh->Handle, 5, submeshIndex };
-        auto& transformStorage = mMeshTransformMap[meshKey].Transforms.emplace_back();
+        SubmissionBuffer& buffer = GetSubmissionBuffer();
 
-        transformStorage.MRow[0] = { transform[0][0], transform[1][0], transform[2][0], transform[3][0] };
-        transformStorage.MRow[1] = { transform[0][1], transform[1][1], transform[2][1], transform[3][1] };
-        transformStorage.MRow[2] = { transform[0][2], transform[1][2], transform[2][2], transform[3][2] };
+        const uint32_t transformIndex = AddTransform(buffer, transform);
 
-        {
-            auto& dc = mColliderDrawList[meshKey];
-            dc.Mesh = mesh;
-            dc.SubmeshIndex = submeshIndex;
-            dc.InstanceCount++;
-        }
+        const AssetHandle meshHandle = mesh->Handle;
+        const uint32_t submission = (uint32_t)buffer.Submissions.size();
+        buffer.Submissions.push_back({ std::move(mesh), nullptr, nullptr, nullptr });
+
+        AddDrawInstance(buffer.ColliderDrawList, submission, meshHandle, 0, submeshIndex, transformIndex, NoBoneTransforms);
     }
 
     void SceneRenderer::SubmitPhysicsStaticDebugMesh(Ref<StaticMesh> staticMesh, const glm::mat4& transform)
     {
+        SubmissionBuffer& buffer = GetSubmissionBuffer();
+
         Ref<MeshSource> meshSource = staticMesh->GetMeshSource();
         const auto& submeshData = meshSource->GetSubmeshes();
-        for (uint32_t submeshIndex : staticMesh->GetSubmeshes())
-        {
-            glm::mat4 submeshTransform = transform * submeshData[submeshIndex].Transform;
+        const auto& staticSubmeshes = staticMesh->GetSubmeshes();
+        const AssetHandle meshHandle = staticMesh->Handle;
 
-            MeshKey meshKey = { staticMesh->Handle, 5, submeshIndex };
-            auto& transformStorage = mMeshTransformMap[meshKey].Transforms.emplace_back();
+        const uint32_t submission = (uint32_t)buffer.Submissions.size();
+        buffer.Submissions.push_back({ nullptr, std::move(staticMesh), nullptr, nullptr });
 
-            transformStorage.MRow[0] = { submeshTransform[0][0], submeshTransform[1][0], submeshTransform[2][0], submeshTransform[3][0] };
-            transformStorage.MRow[1] = { submeshTransform[0][1], submeshTransform[1][1], submeshTransform[2][1], submeshTransform[3][1] };
-            transformStorage.MRow[2] = { submeshTransform[0][2], submeshTransform[1][2], submeshTransform[2][2], submeshTransform[3][2] };
+        for (uint32_t submeshIndex : staticSubmeshes)
+        {
+            const uint32_t transformIndex = AddTransform(buffer, transform * submeshData[submeshIndex].Transform);
+            AddDrawInstance(buffer.StaticColliderDrawList, submission, meshHandle, 0, submeshIndex, transformIndex, NoBoneTransforms);
+        }
+    }
 
-            {
-                auto& dc = mStaticColliderDrawList[meshKey];
-                dc.StaticMesh = staticMesh;
-                dc.SubmeshIndex = submeshIndex;
-                dc.InstanceCount++;
-            }
+    uint32_t SceneRenderer::AddTransform(SubmissionBuffer& buffer, const glm::mat4& transform)
+    {
+        const uint32_t index = (uint32_t)buffer.Transforms.size();
+        TransformVertexData& transformData = buffer.Transforms.emplace_back();
+        transformData.MRow[0] = { transform[0][0], transform[1][0], transform[2][0], transform[3][0] };
+        transformData.MRow[1] = { transform[0][1], transform[1][1], transform[2][1], transform[3][1] };
+        transformData.MRow[2] = { transform[0][2], transform[1][2], transform[2][2], transform[3][2] };
+        return index;
+    }
 
-        }
+    void SceneRenderer::AddDrawInstance(std::vector<DrawInstance>& instances, uint32_t submission, AssetHandle meshHandle, AssetHandle materialHandle, uint32_t submeshIndex, uint32_t transformIndex, uint32_t boneTransformsIndex)
+    {
+        const uint64_t sortKey = MeshDrawList::SortKey(boneTransformsIndex != NoBoneTransforms, meshHandle, materialHandle, submeshIndex);
+        instances.push_back({ sortKey, meshHandle, materialHandle, submission, submeshIndex, transformIndex, boneTransformsIndex });
     }
 
     void SceneRenderer::ClearPass(Ref<RenderPass> renderPass, bool explicitClear)
@@ -1238,24 +1308,21 @@ namespace NR
 
             // Render entities
             const Buffer cascade(&i, sizeof(uint32_t));
-            for (auto& [mk, dc] : mStaticMeshShadowPassDrawList)
+            for (const auto& dc : mStaticMeshShadowPassDrawList.Commands)
             {
-                NR_CORE_VERIFY(mMeshTransformMap.find(mk) != mMeshTransformMap.end());
-                const auto& transformData = mMeshTransformMap.at(mk);
-                Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, mShadowPassPipelines[i], mUniformBufferSet, nullptr, dc.StaticMesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, dc.InstanceCount, mShadowPassMaterial, cascade);
+                const auto& submission = mDrawSubmissions[dc.Submission];
+                Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, mShadowPassPipelines[i], mUniformBufferSet, mStorageBufferSet, submission.StaticMesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, dc.InstanceCount, mShadowPassMaterial, cascade);
             }
-            for (auto& [mk, dc] : mShadowPassDrawList)
+            for (const auto& dc : mShadowPassDrawList.Commands)
             {
-                NR_CORE_VERIFY(mMeshTransformMap.find(mk) != mMeshTransformMap.end());
-                const auto& transformData = mMeshTransformMap.at(mk);
-                if (dc.Mesh->IsRigged())
+                const auto& submission = mDrawSubmissions[dc.Submission];
+                if (submission.Mesh->IsRigged())
                 {
-                    const auto& boneTransformsData = mMeshBoneTransformsMap.at(mk);
-                    Renderer::RenderMeshWithMaterial(mCommandBuffer, mShadowPassPipelinesAnim[i], mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, mBoneTransformStorageBuffers, boneTransformsData.BoneTransformsBaseIndex, dc.InstanceCount, mShadowPassMaterial, cascade);
+                    Renderer::RenderMeshWithMaterial(mCommandBuffer, mShadowPassPipelinesAnim[i], mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, mBoneTransformStorageBuffers, dc.InstanceCount, mShadowPassMaterial, cascade);
                 }
                 else
                 {
-                    Renderer::RenderMeshWithMaterial(mCommandBuffer, mShadowPassPipelines[i], mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, {}, 0, dc.InstanceCount, mShadowPassMaterial, cascade);
+                    Renderer::RenderMeshWithMaterial(mCommandBuffer, mShadowPassPipelines[i], mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, {}, dc.InstanceCount, mShadowPassMaterial, cascade);
                 }
             }
 
@@ -1270,40 +1337,38 @@ namespace NR
         // PreDepth Pass, only used for light culling for now
         mGPUTimeQueries.DepthPrePassQuery = mCommandBuffer->BeginTimestampQuery();
         Renderer::BeginRenderPass(mCommandBuffer, mPreDepthPipeline->GetSpecification().RenderPass);
-        for (auto& [mk, dc] : mStaticMeshDrawList)
+        for (const auto& dc : mStaticMeshDrawList.Commands)
         {
-            const auto& transformData = mMeshTransformMap.at(mk);
-            Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, mPreDepthPipeline, mUniformBufferSet, nullptr, dc.StaticMesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, dc.InstanceCount, mPreDepthMaterial);
+            const auto& submission = mDrawSubmissions[dc.Submission];
+            Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, mPreDepthPipeline, mUniformBufferSet, mStorageBufferSet, submission.StaticMesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, dc.InstanceCount, mPreDepthMaterial);
         }
-        for (auto& [mk, dc] : mDrawList)
+        for (const auto& dc : mDrawList.Commands)
         {
-            const auto& transformData = mMeshTransformMap.at(mk);
-            if (dc.Mesh->IsRigged())
+            const auto& submission = mDrawSubmissions[dc.Submission];
+            if (submission.Mesh->IsRigged())
             {
-                const auto& boneTransformsData = mMeshBoneTransformsMap.at(mk);
-                Renderer::RenderMeshWithMaterial(mCommandBuffer, mPreDepthPipelineAnim, mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, mBoneTransformStorageBuffers, boneTransformsData.BoneTransformsBaseIndex, dc.InstanceCount, mPreDepthMaterial);
+                Renderer::RenderMeshWithMaterial(mCommandBuffer, mPreDepthPipelineAnim, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, mBoneTransformStorageBuffers, dc.InstanceCount, mPreDepthMaterial);
             }
             else
             {
-                Renderer::RenderMeshWithMaterial(mCommandBuffer, mPreDepthPipeline, mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, {}, 0, dc.InstanceCount, mPreDepthMaterial);
+                Renderer::RenderMeshWithMaterial(mCommandBuffer, mPreDepthPipeline, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, {}, dc.InstanceCount, mPreDepthMaterial);
             }
         }
-        for (auto& [mk, dc] : mSelectedStaticMeshDrawList)
+        for (const auto& dc : mSelectedStaticMeshDrawList.Commands)
         {
-            const auto& transformData = mMeshTransformMap.at(mk);
-            Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, mPreDepthPipeline, mUniformBufferSet, nullptr, dc.StaticMesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, dc.InstanceCount, mPreDepthMaterial);
+            const auto& submission = mDrawSubmissions[dc.Submission];
+            Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, mPreDepthPipeline, mUniformBufferSet, mStorageBufferSet, submission.StaticMesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, dc.InstanceCount, mPreDepthMaterial);
         }
-        for (auto& [mk, dc] : mSelectedMeshDrawList)
+        for (const auto& dc : mSelectedMeshDrawList.Commands)
         {
-            const auto& transformData = mMeshTransformMap.at(mk);
-            if (dc.Mesh->IsRigged())
+            const auto& submission = mDrawSubmissions[dc.Submission];
+            if (submission.Mesh->IsRigged())
             {
-                const auto& boneTransformsData = mMeshBoneTransformsMap.at(mk);
-                Renderer::RenderMeshWithMaterial(mCommandBuffer, mPreDepthPipelineAnim, mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, mBoneTransformStorageBuffers, boneTransformsData.BoneTransformsBaseIndex, dc.InstanceCount, mPreDepthMaterial);
+                Renderer::RenderMeshWithMaterial(mCommandBuffer, mPreDepthPipelineAnim, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, mBoneTransformStorageBuffers, dc.InstanceCount, mPreDepthMaterial);
             }
             else
             {
-                Renderer::RenderMeshWithMaterial(mCommandBuffer, mPreDepthPipeline, mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, {}, 0, dc.InstanceCount, mPreDepthMaterial);
+                Renderer::RenderMeshWithMaterial(mCommandBuffer, mPreDepthPipeline, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, {}, dc.InstanceCount, mPreDepthMaterial);
             }
         }
         Renderer::EndRenderPass(mCommandBuffer);
@@ -1334,8 +1399,8 @@ namespace NR
 
     void SceneRenderer::LightCullingPass()
     {
-        mLightCullingMaterial->Set("uPreDepthMap", mPreDepthPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetDepthImage());
-        mLightCullingMaterial->Set("uScreenData.uScreenSize", glm::ivec2{ mViewportWidth, mViewportHeight });
+        mLightCullingMaterial->Set(MaterialProperties::PreDepthMap, mPreDepthPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetDepthImage());
+        mLightCullingMaterial->Set(MaterialProperties::ScreenSize, glm::ivec2{ mViewportWidth, mViewportHeight });
 
         mGPUTimeQueries.LightCullingPassQuery = mCommandBuffer->BeginTimestampQuery();
         Renderer::LightCulling(mCommandBuffer, mLightCullingPipeline, mUniformBufferSet, mStorageBufferSet, mLightCullingMaterial, glm::ivec2{ mViewportWidth, mViewportHeight }, mLightCullingWorkGroups);
@@ -1349,54 +1414,53 @@ namespace NR
         mGPUTimeQueries.GeometryPassQuery = mCommandBuffer->BeginTimestampQuery();
 
         Renderer::BeginRenderPass(mCommandBuffer, mSelectedGeometryPipeline->GetSpecification().RenderPass);
-        for (auto& [mk, dc] : mSelectedStaticMeshDrawList)
+        for (const auto& dc : mSelectedStaticMeshDrawList.Commands)
         {
-            const auto& transformData = mMeshTransformMap.at(mk);
-            Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, mSelectedGeometryPipeline, mUniformBufferSet, nullptr, dc.StaticMesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset + dc.InstanceBaseIndex * sizeof(TransformVertexData), dc.InstanceCount, mSelectedGeometryMaterial);
+            const auto& submission = mDrawSubmissions[dc.Submission];
+            Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, mSelectedGeometryPipeline, mUniformBufferSet, mStorageBufferSet, submission.StaticMesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, dc.InstanceCount, mSelectedGeometryMaterial);
         }
-        for (auto& [mk, dc] : mSelectedMeshDrawList)
+        for (const auto& dc : mSelectedMeshDrawList.Commands)
         {
-            const auto& transformData = mMeshTransformMap.at(mk);
-            if (dc.Mesh->IsRigged())
+            const auto& submission = mDrawSubmissions[dc.Submission];
+            if (submission.Mesh->IsRigged())
             {
-                const auto& boneTransformsData = mMeshBoneTransformsMap.at(mk);
-                Renderer::RenderMeshWithMaterial(mCommandBuffer, mSelectedGeometryPipelineAnim, mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset + dc.InstanceBaseIndex * sizeof(TransformVertexData), mBoneTransformStorageBuffers, boneTransformsData.BoneTransformsBaseIndex + dc.InstanceBaseIndex, dc.InstanceCount, mSelectedGeometryMaterial);
+                Renderer::RenderMeshWithMaterial(mCommandBuffer, mSelectedGeometryPipelineAnim, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, mBoneTransformStorageBuffers, dc.InstanceCount, mSelectedGeometryMaterial);
             }
             else
             {
-                Renderer::RenderMeshWithMaterial(mCommandBuffer, mSelectedGeometryPipeline, mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset + dc.InstanceBaseIndex * sizeof(TransformVertexData), {}, 0, dc.InstanceCount, mSelectedGeometryMaterial);
+                Renderer::RenderMeshWithMaterial(mCommandBuffer, mSelectedGeometryPipeline, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, {}, dc.InstanceCount, mSelectedGeometryMaterial);
             }
         }
         Renderer::EndRenderPass(mCommandBuffer);
 
         Renderer::BeginRenderPass(mCommandBuffer, mGeometryPipeline->GetSpecification().RenderPass);
         // Skybox
-        mSkyboxMaterial->Set("uUniforms.TextureLod", mSceneData.SkyboxLod);
-        mSkyboxMaterial->Set("uUniforms.Intensity", mSceneData.SceneEnvironmentIntensity);
+        mSkyboxMaterial->Set(mMaterialUniforms.SkyboxTextureLod, mSceneData.SkyboxLod);
+        mSkyboxMaterial->Set(mMaterialUniforms.SkyboxIntensity, mSceneData.SceneEnvironmentIntensity);
 
         const Ref<TextureCube> radianceMap = mSceneData.SceneEnvironment ? mSceneData.SceneEnvironment->RadianceMap : Renderer::GetBlackCubeTexture();
-        mSkyboxMaterial->Set("uTexture", radianceMap);
+        mSkyboxMaterial->Set(MaterialProperties::Texture, radianceMap);
         Renderer::SubmitFullscreenQuad(mCommandBuffer, mSkyboxPipeline, mUniformBufferSet, nullptr, mSkyboxMaterial);
 
         // Render static meshes
-        for (auto& [mk, dc] : mStaticMeshDrawList)
+        for (const auto& dc : mStaticMeshDrawList.Commands)
         {
-            const auto& transformData = mMeshTransformMap.at(mk);
-            Renderer::RenderStaticMesh(mCommandBuffer, mGeometryPipeline, mUniformBufferSet, mStorageBufferSet, dc.StaticMesh, dc.SubmeshIndex, dc.MaterialTable ? dc.MaterialTable : dc.StaticMesh->GetMaterials(), mSubmeshTransformBuffer, transformData.TransformOffset, dc.InstanceCount);
+            const auto& submission = mDrawSubmissions[dc.Submission];
+            Renderer::RenderStaticMesh(mCommandBuffer, mGeometryPipeline, mUniformBufferSet, mStorageBufferSet, submission.StaticMesh, dc.SubmeshIndex, submission.MaterialTable ? submission.MaterialTable : submission.StaticMesh->GetMaterials(), mInstanceVertexBuffer, dc.InstanceOffset, dc.InstanceCount);
         }
 
         // Render dynamic meshes
-        for (auto& [mk, dc] : mDrawList)
+        for (const auto& dc : mDrawList.Commands)
         {
-            const auto& transformData = mMeshTransformMap.at(mk);
-            if (dc.Mesh->IsRigged())
+            const auto& submission = mDrawSubmissions[dc.Submission];
+            const Ref<MaterialTable>& materialTable = submission.MaterialTable ? submission.MaterialTable : submission.Mesh->GetMaterials();
+            if (submission.Mesh->IsRigged())
             {
-                const auto& boneTransformsData = mMeshBoneTransformsMap.at(mk);
-                Renderer::RenderSubmeshInstanced(mCommandBuffer, mGeometryPipelineAnim, mUniformBufferSet, mStorageBufferSet, dc.Mesh, dc.SubmeshIndex, dc.MaterialTable ? dc.MaterialTable : dc.Mesh->GetMaterials(), mSubmeshTransformBuffer, transformData.TransformOffset, mBoneTransformStorageBuffers, boneTransformsData.BoneTransformsBaseIndex, dc.InstanceCount);
+                Renderer::RenderSubmeshInstanced(mCommandBuffer, mGeometryPipelineAnim, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, materialTable, mInstanceVertexBuffer, dc.InstanceOffset, mBoneTransformStorageBuffers, dc.InstanceCount);
             }
             else
             {
-                Renderer::RenderSubmeshInstanced(mCommandBuffer, mGeometryPipeline, mUniformBufferSet, mStorageBufferSet, dc.Mesh, dc.SubmeshIndex, dc.MaterialTable ? dc.MaterialTable : dc.Mesh->GetMaterials(), mSubmeshTransformBuffer, transformData.TransformOffset, {}, 0, dc.InstanceCount);
+                Renderer::RenderSubmeshInstanced(mCommandBuffer, mGeometryPipeline, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, materialTable, mInstanceVertexBuffer, dc.InstanceOffset, {}, dc.InstanceCount);
             }
         }
 
@@ -1420,7 +1484,7 @@ namespace NR
         for (auto& particlesData : mParticlesDrawList)
         {
             const auto& transformData = mParticlesTransformMap.at(particlesData);
-            Renderer::RenderParticles(mCommandBuffer, mParticlesPipeline, mUniformBufferSet, mStorageBufferSet, particlesData.ParticlesRef, particlesData.Material, mSubmeshTransformBuffer, transformData.TransformOffset);
+            Renderer::RenderParticles(mCommandBuffer, mParticlesPipeline, mUniformBufferSet, mStorageBufferSet, particlesData.ParticlesRef, particlesData.Material, mInstanceVertexBuffer, transformData.InstanceOffset);
         }
 
         Renderer::EndRenderPass(mCommandBuffer);
@@ -1440,12 +1504,12 @@ namespace NR
             return;
         }
 
-        mDeinterleavingMaterial->Set("uLinearDepthTex", mPreDepthPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage());
+        mDeinterleavingMaterial->Set(MaterialProperties::LinearDepthTex, mPreDepthPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage());
 
         constexpr static glm::vec2 offsets[2]{ { 0.5f, 0.5f }, { 0.5f, 2.5f } };
         for (int i = 0; i < 2; ++i)
         {
-            mDeinterleavingMaterial->Set("uInfo.UVOffset", offsets[i]);
+            mDeinterleavingMaterial->Set(mMaterialUniforms.DeinterleavingUVOffset, offsets[i]);
             Renderer::BeginRenderPass(mCommandBuffer, mDeinterleavingPipelines[i]->GetSpecification().RenderPass);
             Renderer::SubmitFullscreenQuad(mCommandBuffer, mDeinterleavingPipelines[i], mUniformBufferSet, nullptr, mDeinterleavingMaterial);
             Renderer::EndRenderPass(mCommandBuffer);
@@ -1459,10 +1523,10 @@ namespace NR
             Renderer::ClearImage(mCommandBuffer, mHBAOOutputImage);
             return;
         }
-        mHBAOMaterial->Set("uLinearDepthTexArray", mDeinterleavingPipelines[0]->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage());
-        mHBAOMaterial->Set("uViewNormalsTex", mGeometryPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage(1));
-        mHBAOMaterial->Set("uViewPositionTex", mGeometryPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage(2));
-        mHBAOMaterial->Set("oColor", mHBAOOutputImage);
+        mHBAOMaterial->Set(MaterialProperties::LinearDepthTexArray, mDeinterleavingPipelines[0]->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage());
+        mHBAOMaterial->Set(MaterialProperties::ViewNormalsTex, mGeometryPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage(1));
+        mHBAOMaterial->Set(MaterialProperties::ViewPositionTex, mGeometryPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage(2));
+        mHBAOMaterial->Set(MaterialProperties::OutputColor, mHBAOOutputImage);
 
         Renderer::DispatchComputeShader(mCommandBuffer, mHBAOPipeline, mUniformBufferSet, nullptr, mHBAOMaterial, mHBAOWorkGroups);
     }
@@ -1475,7 +1539,7 @@ namespace NR
             return;
         }
         Renderer::BeginRenderPass(mCommandBuffer, mReinterleavingPipeline->GetSpecification().RenderPass);
-        mReinterleavingMaterial->Set("uTexResultsArray", mHBAOOutputImage);
+        mReinterleavingMaterial->Set(MaterialProperties::TexResultsArray, mHBAOOutputImage);
         Renderer::SubmitFullscreenQuad(mCommandBuffer, mReinterleavingPipeline, nullptr, nullptr, mReinterleavingMaterial);
         Renderer::EndRenderPass(mCommandBuffer);
     }
@@ -1489,18 +1553,18 @@ namespace NR
         }
         {
             Renderer::BeginRenderPass(mCommandBuffer, mHBAOBlurPipelines[0]->GetSpecification().RenderPass);
-            mHBAOBlurMaterials[0]->Set("uInfo.InvResDirection", glm::vec2{ mInvViewportWidth, 0.0f });
-            mHBAOBlurMaterials[0]->Set("uInfo.Sharpness", mOptions.HBAOBlurSharpness);
-            mHBAOBlurMaterials[0]->Set("uInputTex", mReinterleavingPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage());
+            mHBAOBlurMaterials[0]->Set(mMaterialUniforms.HBAOBlurInvResDirection[0], glm::vec2{ mInvViewportWidth, 0.0f });
+            mHBAOBlurMaterials[0]->Set(mMaterialUniforms.HBAOBlurSharpness[0], mOptions.HBAOBlurSharpness);
+            mHBAOBlurMaterials[0]->Set(MaterialProperties::InputTex, mReinterleavingPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage());
             Renderer::SubmitFullscreenQuad(mCommandBuffer, mHBAOBlurPipelines[0], nullptr, nullptr, mHBAOBlurMaterials[0]);
             Renderer::EndRenderPass(mCommandBuffer);
         }
 
         {
             Renderer::BeginRenderPass(mCommandBuffer, mHBAOBlurPipelines[1]->GetSpecification().RenderPass);
-            mHBAOBlurMaterials[1]->Set("uInfo.InvResDirection", glm::vec2{ 0.0f, mInvViewportHeight });
-            mHBAOBlurMaterials[1]->Set("uInfo.Sharpness", mOptions.HBAOBlurSharpness);
-            mHBAOBlurMaterials[1]->Set("uInputTex", mHBAOBlurPipelines[0]->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage());
+            mHBAOBlurMaterials[1]->Set(mMaterialUniforms.HBAOBlurInvResDirection[1], glm::vec2{ 0.0f, mInvViewportHeight });
+            mHBAOBlurMaterials[1]->Set(mMaterialUniforms.HBAOBlurSharpness[1], mOptions.HBAOBlurSharpness);
+            mHBAOBlurMaterials[1]->Set(MaterialProperties::InputTex, mHBAOBlurPipelines[0]->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage());
             Renderer::SubmitFullscreenQuad(mCommandBuffer, mHBAOBlurPipelines[1], nullptr, nullptr, mHBAOBlurMaterials[1]);
             Renderer::EndRenderPass(mCommandBuffer);
         }
@@ -1514,13 +1578,13 @@ namespace NR
         Renderer::BeginRenderPass(mCommandBuffer, mJumpFloodInitPipeline->GetSpecification().RenderPass);
 
         auto frameBuffer = mSelectedGeometryPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer;
-        mJumpFloodInitMaterial->Set("uTexture", frameBuffer->GetImage());
+        mJumpFloodInitMaterial->Set(MaterialProperties::Texture, frameBuffer->GetImage());
 
         Renderer::SubmitFullscreenQuad(mCommandBuffer, mJumpFloodInitPipeline, nullptr, mJumpFloodInitMaterial);
         Renderer::EndRenderPass(mCommandBuffer);
 
-        mJumpFloodPassMaterial[0]->Set("uTexture", mTempFrameBuffers[0]->GetImage());
-        mJumpFloodPassMaterial[1]->Set("uTexture", mTempFrameBuffers[1]->GetImage());
+        mJumpFloodPassMaterial[0]->Set(MaterialProperties::Texture, mTempFrameBuffers[0]->GetImage());
+        mJumpFloodPassMaterial[1]->Set(MaterialProperties::Texture, mTempFrameBuffers[1]->GetImage());
 
         int steps = 2;
         int step = std::round(std::pow(steps - 1, 2));
@@ -1544,7 +1608,7 @@ namespace NR
 
         vertexOverrides.Release();
 
-        mJumpFloodCompositeMaterial->Set("uTexture", mTempFrameBuffers[1]->GetImage());
+        mJumpFloodCompositeMaterial->Set(MaterialProperties::Texture, mTempFrameBuffers[1]->GetImage());
         mCommandBuffer->EndTimestampQuery(mGPUTimeQueries.JumpFloodPassQuery);
     }
 
@@ -1618,16 +1682,16 @@ namespace NR
 
                 // Output image
                 VkDescriptorSet descriptorSet = VKRenderer::RT_AllocateDescriptorSet(allocInfo);
-                writeDescriptors[0] = *shader->GetDescriptorSet("oImage");
+                writeDescriptors[0] = *shader->GetDescriptorSet(MaterialProperties::OutputImage);
                 writeDescriptors[0].dstSet = descriptorSet;
                 writeDescriptors[0].pImageInfo = &descriptorImageInfo;
 
                 // Input image
-                writeDescriptors[1] = *shader->GetDescriptorSet("uTexture");
+                writeDescriptors[1] = *shader->GetDescriptorSet(MaterialProperties::Texture);
                 writeDescriptors[1].dstSet = descriptorSet;
                 writeDescriptors[1].pImageInfo = &inputTexture->GetDescriptor();
 
-                writeDescriptors[2] = *shader->GetDescriptorSet("uBloomTexture");
+                writeDescriptors[2] = *shader->GetDescriptorSet(MaterialProperties::BloomTexture);
                 writeDescriptors[2].dstSet = descriptorSet;
                 writeDescriptors[2].pImageInfo = &inputTexture->GetDescriptor();
 
@@ -1674,18 +1738,18 @@ namespace NR
                         descriptorImageInfo.imageView = images[1]->RT_GetMipImageView(i);
 
                         descriptorSet = VKRenderer::RT_AllocateDescriptorSet(allocInfo);
-                        writeDescriptors[0] = *shader->GetDescriptorSet("oImage");
+                        writeDescriptors[0] = *shader->GetDescriptorSet(MaterialProperties::OutputImage);
                         writeDescriptors[0].dstSet = descriptorSet;
                         writeDescriptors[0].pImageInfo = &descriptorImageInfo;
 
                         // Input image
-                        writeDescriptors[1] = *shader->GetDescriptorSet("uTexture");
+                        writeDescriptors[1] = *shader->GetDescriptorSet(MaterialProperties::Texture);
                         writeDescriptors[1].dstSet = descriptorSet;
                         auto descriptor = bloomTextures[0]->GetImage().As<VKImage2D>()->GetDescriptor();
                         //descriptor.sampler = samplerClamp;
                         writeDescriptors[1].pImageInfo = &descriptor;
 
-                        writeDescriptors[2] = *shader->GetDescriptorSet("uBloomTexture");
+                        writeDescriptors[2] = *shader->GetDescriptorSet(MaterialProperties::BloomTexture);
                         writeDescriptors[2].dstSet = descriptorSet;
                         writeDescriptors[2].pImageInfo = &inputTexture->GetDescriptor();
 
@@ -1720,18 +1784,18 @@ namespace NR
 
                         // Output image
                         descriptorSet = VKRenderer::RT_AllocateDescriptorSet(allocInfo);
-                        writeDescriptors[0] = *shader->GetDescriptorSet("oImage");
+                        writeDescriptors[0] = *shader->GetDescriptorSet(MaterialProperties::OutputImage);
                         writeDescriptors[0].dstSet = descriptorSet;
                         writeDescriptors[0].pImageInfo = &descriptorImageInfo;
 
                         // Input image
-                        writeDescriptors[1] = *shader->GetDescriptorSet("uTexture");
+                        writeDescriptors[1] = *shader->GetDescriptorSet(MaterialProperties::Texture);
                         writeDescriptors[1].dstSet = descriptorSet;
                         auto descriptor = bloomTextures[1]->GetImage().As<VKImage2D>()->GetDescriptor();
                         //descriptor.sampler = samplerClamp;
                         writeDescriptors[1].pImageInfo = &descriptor;
 
-                        writeDescriptors[2] = *shader->GetDescriptorSet("uBloomTexture");
+                        writeDescriptors[2] = *shader->GetDescriptorSet(MaterialProperties::BloomTexture);
                         writeDescriptors[2].dstSet = descriptorSet;
                         writeDescriptors[2].pImageInfo = &inputTexture->GetDescriptor();
 
@@ -1770,16 +1834,16 @@ namespace NR
                 descriptorSet = VKRenderer::RT_AllocateDescriptorSet(allocInfo);
                 descriptorImageInfo.imageView = images[2]->RT_GetMipImageView(mips - 2);
 
-                writeDescriptors[0] = *shader->GetDescriptorSet("oImage");
+                writeDescriptors[0] = *shader->GetDescriptorSet(MaterialProperties::OutputImage);
                 writeDescriptors[0].dstSet = descriptorSet;
                 writeDescriptors[0].pImageInfo = &descriptorImageInfo;
 
                 // Input image
-                writeDescriptors[1] = *shader->GetDescriptorSet("uTexture");
+                writeDescriptors[1] = *shader->GetDescriptorSet(MaterialProperties::Texture);
                 writeDescriptors[1].dstSet = descriptorSet;
                 writeDescriptors[1].pImageInfo = &bloomTextures[0]->GetImage().As<VKImage2D>()->GetDescriptor();
 
-                writeDescriptors[2] = *shader->GetDescriptorSet("uBloomTexture");
+                writeDescriptors[2] = *shader->GetDescriptorSet(MaterialProperties::BloomTexture);
                 writeDescriptors[2].dstSet = descriptorSet;
                 writeDescriptors[2].pImageInfo = &inputTexture->GetDescriptor();
 
@@ -1824,16 +1888,16 @@ namespace NR
                     // Output image
                     descriptorImageInfo.imageView = images[2]->RT_GetMipImageView(mip);
                     auto descriptorSet = VKRenderer::RT_AllocateDescriptorSet(allocInfo);
-                    writeDescriptors[0] = *shader->GetDescriptorSet("oImage");
+                    writeDescriptors[0] = *shader->GetDescriptorSet(MaterialProperties::OutputImage);
                     writeDescriptors[0].dstSet = descriptorSet;
                     writeDescriptors[0].pImageInfo = &descriptorImageInfo;
 
                     // Input image
-                    writeDescriptors[1] = *shader->GetDescriptorSet("uTexture");
+                    writeDescriptors[1] = *shader->GetDescriptorSet(MaterialProperties::Texture);
                     writeDescriptors[1].dstSet = descriptorSet;
                     writeDescriptors[1].pImageInfo = &bloomTextures[0]->GetImage().As<VKImage2D>()->GetDescriptor();
 
-                    writeDescriptors[2] = *shader->GetDescriptorSet("uBloomTexture");
+                    writeDescriptors[2] = *shader->GetDescriptorSet(MaterialProperties::BloomTexture);
                     writeDescriptors[2].dstSet = descriptorSet;
                     writeDescriptors[2].pImageInfo = &images[2]->GetDescriptor();
 
@@ -1880,23 +1944,23 @@ namespace NR
         float exposure = mSceneData.SceneCamera.Camera.GetExposure();
         int textureSamples = frameBuffer->GetSpecification().Samples;
 
-        CompositeMaterial->Set("uUniforms.Exposure", exposure);
+        CompositeMaterial->Set(mMaterialUniforms.CompositeExposure, exposure);
         if (mBloomSettings.Enabled)
         {
-            CompositeMaterial->Set("uUniforms.BloomIntensity", mBloomSettings.Intensity);
-            CompositeMaterial->Set("uUniforms.BloomDirtIntensity", mBloomSettings.DirtIntensity);
+            CompositeMaterial->Set(mMaterialUniforms.CompositeBloomIntensity, mBloomSettings.Intensity);
+            CompositeMaterial->Set(mMaterialUniforms.CompositeBloomDirtIntensity, mBloomSettings.DirtIntensity);
         }
         else
         {
-            CompositeMaterial->Set("uUniforms.BloomIntensity", 0.0f);
-            CompositeMaterial->Set("uUniforms.BloomDirtIntensity", 0.0f);
+            CompositeMaterial->Set(mMaterialUniforms.CompositeBloomIntensity, 0.0f);
+            CompositeMaterial->Set(mMaterialUniforms.CompositeBloomDirtIntensity, 0.0f);
         }
 
         // CompositeMaterial->Set("uUniforms.TextureSamples", textureSamples);
 
-        CompositeMaterial->Set("uTexture", frameBuffer->GetImage());
-        CompositeMaterial->Set("uBloomTexture", mBloomComputeTextures[2]);
-        CompositeMaterial->Set("uBloomDirtTexture", mBloomDirtTexture);
+        CompositeMaterial->Set(MaterialProperties::Texture, frameBuffer->GetImage());
+        CompositeMaterial->Set(MaterialProperties::BloomTexture, mBloomComputeTextures[2]);
+        CompositeMaterial->Set(MaterialProperties::BloomDirtTexture, mBloomDirtTexture);
 
         Renderer::SubmitFullscreenQuad(mCommandBuffer, mCompositePipeline, nullptr, CompositeMaterial);
         Renderer::SubmitFullscreenQuad(mCommandBuffer, mJumpFloodCompositePipeline, nullptr, mJumpFloodCompositeMaterial);
@@ -1907,8 +1971,8 @@ namespace NR
 #if 0 // WIP
         // DOF
         Renderer::BeginRenderPass(mCommandBuffer, mDOFPipeline->GetSpecification().RenderPass);
-        mDOFMaterial->Set("uTexture", mCompositePipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage());
-        mDOFMaterial->Set("uDepthTexture", mPreDepthPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetDepthImage());
+        mDOFMaterial->Set(MaterialProperties::Texture, mCompositePipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetImage());
+        mDOFMaterial->Set(MaterialProperties::DepthTexture, mPreDepthPipeline->GetSpecification().RenderPass->GetSpecification().TargetFrameBuffer->GetDepthImage());
         Renderer::SubmitFullscreenQuad(mCommandBuffer, mDOFPipeline, nullptr, mDOFMaterial);
         Renderer::EndRenderPass(mCommandBuffer);
 #endif
@@ -1921,23 +1985,22 @@ namespace NR
         {
             Renderer::BeginRenderPass(mCommandBuffer, mExternalCompositeRenderPass);
 
-            for (auto& [mk, dc] : mSelectedStaticMeshDrawList)
+            for (const auto& dc : mSelectedStaticMeshDrawList.Commands)
             {
-                const auto& transformData = mMeshTransformMap.at(mk);
-                Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, mGeometryWireframePipeline, mUniformBufferSet, nullptr, dc.StaticMesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset + dc.InstanceBaseIndex * sizeof(TransformVertexData), dc.InstanceCount, mWireframeMaterial);
+                const auto& submission = mDrawSubmissions[dc.Submission];
+                Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, mGeometryWireframePipeline, mUniformBufferSet, mStorageBufferSet, submission.StaticMesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, dc.InstanceCount, mWireframeMaterial);
             }
 
-            for (auto& [mk, dc] : mSelectedMeshDrawList)
+            for (const auto& dc : mSelectedMeshDrawList.Commands)
             {
-                const auto& transformData = mMeshTransformMap.at(mk);
-                if (dc.Mesh->IsRigged())
+                const auto& submission = mDrawSubmissions[dc.Submission];
+                if (submission.Mesh->IsRigged())
                 {
-                    const auto& boneTransformsData = mMeshBoneTransformsMap.at(mk);
-                    Renderer::RenderMeshWithMaterial(mCommandBuffer, mGeometryWireframePipelineAnim, mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset + dc.InstanceBaseIndex * sizeof(TransformVertexData), mBoneTransformStorageBuffers, boneTransformsData.BoneTransformsBaseIndex + dc.InstanceBaseIndex, dc.InstanceCount, mWireframeMaterial);
+                    Renderer::RenderMeshWithMaterial(mCommandBuffer, mGeometryWireframePipelineAnim, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, mBoneTransformStorageBuffers, dc.InstanceCount, mWireframeMaterial);
                 }
                 else
                 {
-                    Renderer::RenderMeshWithMaterial(mCommandBuffer, mGeometryWireframePipeline, mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset + dc.InstanceBaseIndex * sizeof(TransformVertexData), {}, 0, dc.InstanceCount, mWireframeMaterial);
+                    Renderer::RenderMeshWithMaterial(mCommandBuffer, mGeometryWireframePipeline, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, {}, dc.InstanceCount, mWireframeMaterial);
                 }
             }
 
@@ -1948,29 +2011,19 @@ namespace NR
         {
             Renderer::BeginRenderPass(mCommandBuffer, mExternalCompositeRenderPass);
             auto pipeline = mOptions.ShowPhysicsColliders == SceneRendererOptions::PhysicsColliderView::Normal ? mGeometryWireframePipeline : mGeometryWireframeOnTopPipeline;
-            auto pipelineAnim = mOptions.ShowPhysicsColliders == SceneRendererOptions::PhysicsColliderView::Normal ? mGeometryWireframePipelineAnim : mGeometryWireframeOnTopPipelineAnim;
-            mColliderMaterial->Set("uMaterialUniforms.Color", mOptions.PhysicsCollidersColor);
+            mColliderMaterial->Set(mMaterialUniforms.ColliderColor, mOptions.PhysicsCollidersColor);
 
-            for (auto& [mk, dc] : mStaticColliderDrawList)
+            for (const auto& dc : mStaticColliderDrawList.Commands)
             {
-                NR_CORE_VERIFY(mMeshTransformMap.find(mk) != mMeshTransformMap.end());
-                const auto& transformData = mMeshTransformMap.at(mk);
-                Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, pipeline, mUniformBufferSet, nullptr, dc.StaticMesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, dc.InstanceCount, mColliderMaterial);
+                const auto& submission = mDrawSubmissions[dc.Submission];
+                Renderer::RenderStaticMeshWithMaterial(mCommandBuffer, pipeline, mUniformBufferSet, mStorageBufferSet, submission.StaticMesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, dc.InstanceCount, mColliderMaterial);
             }
 
-            for (auto& [mk, dc] : mColliderDrawList)
+            // Collider meshes are never skinned, no bone transforms are staged for them
+            for (const auto& dc : mColliderDrawList.Commands)
             {
-                NR_CORE_VERIFY(mMeshTransformMap.find(mk) != mMeshTransformMap.end());
-                const auto& transformData = mMeshTransformMap.at(mk);
-                if (dc.Mesh->IsRigged())
-                {
-                    const auto& boneTransformsData = mMeshBoneTransformsMap.at(mk);
-                    Renderer::RenderMeshWithMaterial(mCommandBuffer, pipelineAnim, mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, mBoneTransformStorageBuffers, boneTransformsData.BoneTransformsBaseIndex, dc.InstanceCount, mColliderMaterial);
-                }
-                else
-                {
-                    Renderer::RenderMeshWithMaterial(mCommandBuffer, pipeline, mUniformBufferSet, nullptr, dc.Mesh, dc.SubmeshIndex, mSubmeshTransformBuffer, transformData.TransformOffset, {}, 0, dc.InstanceCount, mColliderMaterial);
-                }
+                const auto& submission = mDrawSubmissions[dc.Submission];
+                Renderer::RenderMeshWithMaterial(mCommandBuffer, pipeline, mUniformBufferSet, mStorageBufferSet, submission.Mesh, dc.SubmeshIndex, mInstanceVertexBuffer, dc.InstanceOffset, {}, dc.InstanceCount, mColliderMaterial);
             }
 
             Renderer::EndRenderPass(mCommandBuffer);
@@ -1979,6 +2032,8 @@ namespace NR
 
     void SceneRenderer::FlushDrawList()
     {
+        MergeSubmissionBuffers();
+
         if (mResourcesCreated && mViewportWidth > 0 && mViewportHeight > 0)
         {
             PreRender();
@@ -2020,143 +2075,249 @@ namespace NR
 
         UpdateStatistics();
 
-        mDrawList.clear();
-        mSelectedMeshDrawList.clear();
-        mShadowPassDrawList.clear();
+        mDrawList.Clear();
+        mSelectedMeshDrawList.Clear();
+        mShadowPassDrawList.Clear();
 
-        mStaticMeshDrawList.clear();
-        mSelectedStaticMeshDrawList.clear();
-        mStaticMeshShadowPassDrawList.clear();
+        mStaticMeshDrawList.Clear();
+        mSelectedStaticMeshDrawList.Clear();
+        mStaticMeshShadowPassDrawList.Clear();
 
         mParticlesDrawList.clear();
 
-        mColliderDrawList.clear();
-        mStaticColliderDrawList.clear();
+        mColliderDrawList.Clear();
+        mStaticColliderDrawList.Clear();
         mSceneData = {};
 
-        mMeshTransformMap.clear();
+        for (auto& buffer : mSubmissionBuffers)
+            buffer.Clear();
+
+        mDrawSubmissions.clear();
+        mTransformData.clear();
+        mInstanceVertexData.clear();
+        mBoneTransformsData.clear();
         mParticlesTransformMap.clear();
-        mMeshBoneTransformsMap.clear();
     }
 
     void SceneRenderer::PreRender()
     {
         NR_PROFILE_FUNC();
 
-#if 0
-        uint32_t offset = 0;
+        mStaticMeshDrawList.BuildCommands(mInstanceVertexData);
+        mDrawList.BuildCommands(mInstanceVertexData);
+        mSelectedStaticMeshDrawList.BuildCommands(mInstanceVertexData);
+        mSelectedMeshDrawList.BuildCommands(mInstanceVertexData);
+        mStaticMeshShadowPassDrawList.BuildCommands(mInstanceVertexData);
+        mShadowPassDrawList.BuildCommands(mInstanceVertexData);
+        mStaticColliderDrawList.BuildCommands(mInstanceVertexData);
+        mColliderDrawList.BuildCommands(mInstanceVertexData);
 
-        for (size_t i = 0; i < mStaticMeshShadowPassDrawList.size(); ++i)
+        for (auto& [key, transformData] : mParticlesTransformMap)
         {
-            auto& dc = mStaticMeshShadowPassDrawList[i];
-
-            // Copy transform data
-            mTransformVertexData[offset].MRow[0] = { dc.Transform[0][0], dc.Transform[1][0], dc.Transform[2][0], dc.Transform[3][0] };
-            mTransformVertexData[offset].MRow[1] = { dc.Transform[0][1], dc.Transform[1][1], dc.Transform[2][1], dc.Transform[3][1] };
-            mTransformVertexData[offset].MRow[2] = { dc.Transform[0][2], dc.Transform[1][2], dc.Transform[2][2], dc.Transform[3][2] };
-
-            dc.TransformOffset = offset * sizeof(TransformVertexData);
-            offset++;
+            transformData.InstanceOffset = (uint32_t)(mInstanceVertexData.size() * sizeof(InstanceVertexData));
+            for (const auto& transform : transformData.Transforms)
+            {
+                mInstanceVertexData.push_back({ (uint32_t)mTransformData.size(), 0 });
+                mTransformData.push_back(transform);
+            }
         }
 
-        for (size_t i = 0; i < mShadowPassDrawList.size(); ++i)
-        {
-            auto& dc = mShadowPassDrawList[i];
+        UploadInstanceData();
+    }
 
-            // Copy transform data
-            mTransformVertexData[offset].MRow[0] = { dc.Transform[0][0], dc.Transform[1][0], dc.Transform[2][0], dc.Transform[3][0] };
-            mTransformVertexData[offset].MRow[1] = { dc.Transform[0][1], dc.Transform[1][1], dc.Transform[2][1], dc.Transform[3][1] };
-            mTransformVertexData[offset].MRow[2] = { dc.Transform[0][2], dc.Transform[1][2], dc.Transform[2][2], dc.Transform[3][2] };
+    void SceneRenderer::UploadInstanceData()
+    {
+        NR_PROFILE_FUNC();
 
-            dc.TransformOffset = offset * sizeof(TransformVertexData);
-            offset++;
+        // Grow geometrically so a growing scene doesn't reallocate every frame, the old buffers are freed once the GPU is done with them
+        const uint32_t transformCount = (uint32_t)mTransformData.size();
+        if (transformCount > mTransformBufferCapacity)
+        {
+            mTransformBufferCapacity = std::max(transformCount, mTransformBufferCapacity * 2);
+            mStorageBufferSet->Resize(Binding::InstanceTransforms, 0, static_cast<uint32_t>(sizeof(TransformVertexData) * mTransformBufferCapacity));
         }
 
-        for (size_t i = 0; i < mStaticMeshDrawList.size(); ++i)
+        const uint32_t instanceCount = (uint32_t)mInstanceVertexData.size();
+        if (instanceCount > mInstanceVertexBufferCapacity)
         {
-            auto& dc = mStaticMeshDrawList[i];
+            mInstanceVertexBufferCapacity = std::max(instanceCount, mInstanceVertexBufferCapacity * 2);
+            mInstanceVertexBuffer = VertexBuffer::Create(static_cast<uint32_t>(sizeof(InstanceVertexData) * mInstanceVertexBufferCapacity));
+        }
 
-            // Copy transform data
-            mTransformVertexData[offset].MRow[0] = { dc.Transform[0][0], dc.Transform[1][0], dc.Transform[2][0], dc.Transform[3][0] };
-            mTransformVertexData[offset].MRow[1] = { dc.Transform[0][1], dc.Transform[1][1], dc.Transform[2][1], dc.Transform[3][1] };
-            mTransformVertexData[offset].MRow[2] = { dc.Transform[0][2], dc.Transform[1][2], dc.Transform[2][2], dc.Transform[3][2] };
+        const uint32_t boneTransformsCount = (uint32_t)mBoneTransformsData.size();
+        if (boneTransformsCount > mBoneTransformBufferCapacity)
+        {
+            mBoneTransformBufferCapacity = std::max(boneTransformsCount, mBoneTransformBufferCapacity * 2);
+            for (auto& buffer : mBoneTransformStorageBuffers)
+            {
+                buffer->Resize(static_cast<uint32_t>(sizeof(BoneTransforms) * mBoneTransformBufferCapacity));
+            }
+        }
 
-            dc.TransformOffset = offset * sizeof(TransformVertexData);
-            offset++;
+        if (instanceCount)
+        {
+            mInstanceVertexBuffer->SetData(mInstanceVertexData.data(), instanceCount * sizeof(InstanceVertexData));
         }
 
-        /*for (size_t i = 0; i < mDrawList.size(); ++i)
+        // Copied, the render thread uploads them while the next frame is being submitted
+        Buffer transformData = transformCount ? Buffer::Copy(mTransformData.data(), transformCount * sizeof(TransformVertexData)) : Buffer();
+        Buffer boneTransformsData = boneTransformsCount ? Buffer::Copy(mBoneTransformsData.data(), static_cast<uint32_t>(boneTransformsCount * sizeof(BoneTransforms))) : Buffer();
+        if (!transformData && !boneTransformsData)
         {
-            auto& dc = mDrawList[i];
+            return;
+        }
 
-            // Copy transform data
-            mTransformVertexData[offset].MRow[0] = { dc.Transform[0][0], dc.Transform[1][0], dc.Transform[2][0], dc.Transform[3][0] };
-            mTransformVertexData[offset].MRow[1] = { dc.Transform[0][1], dc.Transform[1][1], dc.Transform[2][1], dc.Transform[3][1] };
-            mTransformVertexData[offset].MRow[2] = { dc.Transform[0][2], dc.Transform[1][2], dc.Transform[2][2], dc.Transform[3][2] };
+        Ref<SceneRenderer> instance = this;
+        Renderer::Submit([instance, transformData, boneTransformsData]() mutable
+            {
+                const uint32_t frameIndex = Renderer::GetCurrentFrameIndex();
+                if (transformData)
+                {
+                    instance->mStorageBufferSet->Get(Binding::InstanceTransforms, 0, frameIndex)->RT_SetData(transformData.Data, transformData.Size);
+                }
+                if (boneTransformsData)
+                {
+                    instance->mBoneTransformStorageBuffers[frameIndex]->RT_SetData(boneTransformsData.Data, boneTransformsData.Size);
+                }
 
-            dc.TransformOffset = offset * sizeof(TransformVertexData);
-            offset++;
-        }*/
-#endif
+                transformData.Release();
+                boneTransformsData.Release();
+            });
+    }
 
-        uint32_t index = 0;
-        for (auto& [key, transformData] : mMeshTransformMap)
-        {
-            transformData.TransformOffset = index * sizeof(TransformVertexData);
-            for (const auto& transform : transformData.Transforms)
-            {
-                mTransformVertexData[index++] = transform;
-            }
+    void SceneRenderer::MergeSubmissionBuffers()
+    {
+        NR_PROFILE_FUNC();
 
-        }
-        for (auto& [key, transformData] : mParticlesTransformMap)
+        mSubmissionBases.clear();
+        mTransformBases.clear();
+        mBoneTransformsKeys.clear();
+        mBoneTransformsLookup.Clear();
+        mCullingData.Submitted = 0;
+        mCullingData.Visible = 0;
+        mCullingData.ShadowCasters = 0;
+
+        for (auto& buffer : mSubmissionBuffers)
         {
-            transformData.TransformOffset = index * sizeof(TransformVertexData);
-            for (const auto& transform : transformData.Transforms)
+            mSubmissionBases.push_back((uint32_t)mDrawSubmissions.size());
+            mTransformBases.push_back((uint32_t)mTransformData.size());
+
+            mDrawSubmissions.insert(mDrawSubmissions.end(), std::make_move_iterator(buffer.Submissions.begin()), std::make_move_iterator(buffer.Submissions.end()));
+            mTransformData.insert(mTransformData.end(), buffer.Transforms.begin(), buffer.Transforms.end());
+
+            // A pose whose submeshes were split over several buffers still gets a single palette
+            buffer.BoneTransformsRemap.clear();
+            for (size_t i = 0; i < buffer.BoneTransformsStaging.size(); ++i)
             {
-                mTransformVertexData[index++] = transform;
+                // The merged keys and palettes grow together, a key's index is its palette's
+                auto [index, inserted] = mBoneTransformsLookup.Insert(mBoneTransformsKeys, buffer.BoneTransformsKeys[i]);
+                if (inserted)
+                {
+                    mBoneTransformsData.push_back(buffer.BoneTransformsStaging[i]);
+                }
+                buffer.BoneTransformsRemap.push_back(index);
             }
+
+            mCullingData.Submitted += buffer.Submitted;
+            mCullingData.Visible += buffer.Visible;
+            mCullingData.ShadowCasters += buffer.ShadowCasters;
         }
 
-        mSubmeshTransformBuffer->SetData(mTransformVertexData, index * sizeof(TransformVertexData));
-        index = 0;
-        for (auto& [key, boneTransformsData] : mMeshBoneTransformsMap)
+        MergeDrawList(mDrawList, &SubmissionBuffer::DrawList);
+        MergeDrawList(mSelectedMeshDrawList, &SubmissionBuffer::SelectedMeshDrawList);
+        MergeDrawList(mShadowPassDrawList, &SubmissionBuffer::ShadowPassDrawList);
+
+        MergeDrawList(mStaticMeshDrawList, &SubmissionBuffer::StaticMeshDrawList);
+        MergeDrawList(mSelectedStaticMeshDrawList, &SubmissionBuffer::SelectedStaticMeshDrawList);
+        MergeDrawList(mStaticMeshShadowPassDrawList, &SubmissionBuffer::StaticMeshShadowPassDrawList);
+
+        MergeDrawList(mStaticColliderDrawList, &SubmissionBuffer::StaticColliderDrawList);
+        MergeDrawList(mColliderDrawList, &SubmissionBuffer::ColliderDrawList);
+    }
+
+    void SceneRenderer::MergeDrawList(MeshDrawList& drawList, std::vector<DrawInstance> SubmissionBuffer::* instances)
+    {
+        for (size_t i = 0; i < mSubmissionBuffers.size(); ++i)
         {
-            boneTransformsData.BoneTransformsBaseIndex = index;
-            for (const auto& boneTransforms : boneTransformsData.BoneTransformsData)
+            const SubmissionBuffer& buffer = mSubmissionBuffers[i];
+            for (const DrawInstance& source : buffer.*instances)
             {
-                mBoneTransformsData[index++] = boneTransforms;
+                const uint32_t instanceIndex = (uint32_t)drawList.Instances.size();
+                DrawInstance& instance = drawList.Instances.emplace_back(source);
+                instance.Submission += mSubmissionBases[i];
+                instance.TransformIndex += mTransformBases[i];
+                if (instance.BoneTransformsIndex != NoBoneTransforms)
+                    instance.BoneTransformsIndex = buffer.BoneTransformsRemap[instance.BoneTransformsIndex];
+
+                drawList.SortEntries.push_back({ instance.SortKey, instanceIndex });
             }
         }
-
-        if (index)
-        {
-            Ref<SceneRenderer> instance = this;
-            Renderer::Submit([instance, index]() mutable
-                {
-                    instance->mBoneTransformStorageBuffers[Renderer::GetCurrentFrameIndex()]->RT_SetData(instance->mBoneTransformsData, static_cast<uint32_t>(index * sizeof(BoneTransforms)));
-                });
-        }
     }
 
-    void SceneRenderer::CopyToBoneTransformStorage(const MeshKey& meshKey, const Ref<MeshSource>& meshSource, const ozz::vector<ozz::math::Float4x4>& boneTransforms)
+    uint32_t SceneRenderer::CopyToBoneTransformStorage(SubmissionBuffer& buffer, const Ref<MeshSource>& meshSource, const ozz::vector<ozz::math::Float4x4>& boneTransforms)
     {
-        auto& boneTransformStorage = mMeshBoneTransformsMap[meshKey].BoneTransformsData.emplace_back();
+        // Every submesh of an animated instance passes the same pose, they share the palette
+        const BoneTransformsKey key(meshSource.Raw(), boneTransforms.data());
+        auto [index, inserted] = buffer.BoneTransformsLookup.Insert(buffer.BoneTransformsKeys, key);
+        if (!inserted)
+            return index;
+
+        auto& boneTransformStorage = buffer.BoneTransformsStaging.emplace_back();
+
+        const auto& boneInfo = meshSource->mBoneInfo;
+        NR_CORE_ASSERT(boneInfo.size() <= boneTransformStorage.size(), "Mesh has more bones than the skinning shaders support");
         if (boneTransforms.empty())
         {
             boneTransformStorage.fill(ozz::math::Float4x4::identity());
         }
         else
         {
-            for (size_t i = 0; i < meshSource->mBoneInfo.size(); ++i)
+            const size_t boneCount = std::min(boneInfo.size(), boneTransformStorage.size());
+            for (size_t i = 0; i < boneCount; ++i)
             {
-                auto submeshInvTransform = meshSource->mBoneInfo[i].SubMeshInverseTransform;
-                auto boneTransform = boneTransforms[meshSource->mBoneInfo[i].JointIndex];
-                auto invBindPose = meshSource->mBoneInfo[i].InverseBindPose;
-                auto result = submeshInvTransform * boneTransform * invBindPose;
-                boneTransformStorage[i] = meshSource->mBoneInfo[i].SubMeshInverseTransform * boneTransforms[meshSource->mBoneInfo[i].JointIndex] * meshSource->mBoneInfo[i].InverseBindPose;
+                const uint32_t jointIndex = boneInfo[i].JointIndex;
+                boneTransformStorage[i] = jointIndex < boneTransforms.size() ? boneInfo[i].SubMeshInverseTransform * boneTransforms[jointIndex] * boneInfo[i].InverseBindPose : ozz::math::Float4x4::identity();
             }
         }
+
+        return index;
+    }
+
+    void SceneRenderer::BoneTransformsTable::Clear()
+    {
+        std::fill(Slots.begin(), Slots.end(), 0u);
+    }
+
+    std::pair<uint32_t, bool> SceneRenderer::BoneTransformsTable::Insert(std::vector<BoneTransformsKey>& keys, const BoneTransformsKey& key)
+    {
+        // Kept at most half full so the probes stay short, growing puts the keys back in
+        if ((keys.size() + 1) * 2 > Slots.size())
+        {
+            Slots.assign(std::max<size_t>(Slots.size() * 2, 64), 0u);
+            for (size_t i = 0; i < keys.size(); ++i)
+                FindSlot(keys, keys[i]) = (uint32_t)i + 1;
+        }
+
+        uint32_t& slot = FindSlot(keys, key);
+        if (slot)
+            return { slot - 1, false };
+
+        keys.push_back(key);
+        slot = (uint32_t)keys.size();
+        return { slot - 1, true };
+    }
+
+    uint32_t& SceneRenderer::BoneTransformsTable::FindSlot(const std::vector<BoneTransformsKey>& keys, const BoneTransformsKey& key)
+    {
+        // Both are heap addresses, their low bits are alignment
+        const uint64_t hash = (((uint64_t)(uintptr_t)key.first >> 4) * 31 + ((uint64_t)(uintptr_t)key.second >> 4)) * 0x9E3779B97F4A7C15ull;
+
+        const size_t mask = Slots.size() - 1;
+        for (size_t i = (size_t)(hash >> 32) & mask;; i = (i + 1) & mask)
+        {
+            if (!Slots[i] || keys[Slots[i] - 1] == key)
+                return Slots[i];
+        }
     }
 
     void SceneRenderer::ClearPass()
@@ -2305,35 +2466,22 @@ namespace NR
         mStatistics.Instances = 0;
         mStatistics.Meshes = 0;
 
-        for (auto& [mk, dc] : mSelectedStaticMeshDrawList)
-        {
-            mStatistics.Instances += dc.InstanceCount;
-            mStatistics.DrawCalls++;
-            mStatistics.Meshes++;
-        }
-
-        for (auto& [mk, dc] : mStaticMeshDrawList)
-        {
-            mStatistics.Instances += dc.InstanceCount;
-            mStatistics.DrawCalls++;
-            mStatistics.Meshes++;
-        }
-
-        for (auto& [mk, dc] : mSelectedMeshDrawList)
+        for (const MeshDrawList* drawList : { &mSelectedStaticMeshDrawList, &mStaticMeshDrawList, &mSelectedMeshDrawList, &mDrawList })
         {
-            mStatistics.Instances += dc.InstanceCount;
-            mStatistics.DrawCalls++;
-            mStatistics.Meshes++;
-        }
-
-        for (auto& [mk, dc] : mDrawList)
-        {
-            mStatistics.Instances += dc.InstanceCount;
-            mStatistics.DrawCalls++;
-            mStatistics.Meshes++;
+            for (const auto& dc : drawList->Commands)
+            {
+                mStatistics.Instances += dc.InstanceCount;
+                mStatistics.DrawCalls++;
+                mStatistics.Meshes++;
+            }
         }
 
         mStatistics.SavedDraws = mStatistics.Instances - mStatistics.DrawCalls;
+
+        mStatistics.VisibleInstances = mCullingData.Visible;
+        mStatistics.CulledInstances = mCullingData.Submitted - mCullingData.Visible;
+        mStatistics.ShadowCasters = mCullingData.ShadowCasters;
+        mStatistics.CulledShadowCasters = mCullingData.Submitted - mCullingData.ShadowCasters;
     }
 
     void SceneRenderer::SetLineWidth(float width)
@@ -2506,6 +2654,10 @@ namespace NR
                 ImGui::Text("Instances: %d", mStatistics.Instances);
                 ImGui::Text("Actual instances: %d", mStatistics.Instances - mStatistics.DrawCalls);
                 ImGui::Text("Draws saved (by instancing): %d", mStatistics.SavedDraws);
+                ImGui::Text("Visible instances: %d", mStatistics.VisibleInstances);
+                ImGui::Text("Culled instances: %d", mStatistics.CulledInstances);
+                ImGui::Text("Shadow casters: %d", mStatistics.ShadowCasters);
+                ImGui::Text("Culled shadow casters: %d", mStatistics.CulledShadowCasters);
                 UI::EndTreeNode();
             }
 
@@ -5,6 +5,8 @@
 #include "NotRed/Scene/Scene.h"
 #include "NotRed/Scene/Components.h"
 #include "NotRed/Renderer/Mesh.h"
+#include "NotRed/Renderer/MeshDrawList.h"
+#include "NotRed/Math/Frustum.h"
 #include "RenderPass.h"
 
 #include "NotRed/Renderer/UniformBufferSet.h"
@@ -37,6 +39,15 @@ namespace NR
 		float HBAOBlurSharpness = 1.0f;
 	};
 
+	// Which passes a submitted submesh instance survives CPU culling for
+	enum class MeshVisibility : uint8_t
+	{
+		None = 0 << 0,
+		Camera = 1 << 0,
+		Shadow = 1 << 1,
+		All = Camera | Shadow
+	};
+
 	struct SceneRendererCamera
 	{
 		NR::Camera Camera;
@@ -76,11 +87,22 @@ namespace NR
 		void BeginScene(const SceneRendererCamera& camera);
 		void EndScene();
 
-		void SubmitMesh(Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, const glm::mat4& transform = glm::mat4(1.0f), const ozz::vector<ozz::math::Float4x4>& boneTransforms = {}, Ref<Material> overrideMaterial = nullptr);
-		void SubmitStaticMesh(Ref<StaticMesh> staticMesh, Ref<MaterialTable> materialTable, const glm::mat4& transform = glm::mat4(1.0f), Ref<Material> overrideMaterial = nullptr);
+		// Tests a submesh against the camera and shadow cascade frusta of the current scene.
+		// Only reads state set up by BeginScene, so it may be called from several threads at once.
+		uint8_t GetSubmeshVisibility(const AABB& localBounds, const glm::mat4& transform) const;
 
-		void SubmitSelectedMesh(Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, const glm::mat4& transform = glm::mat4(1.0f), const ozz::vector<ozz::math::Float4x4>& boneTransforms = {}, Ref<Material> overrideMaterial = nullptr);
-		void SubmitSelectedStaticMesh(Ref<StaticMesh> staticMesh, Ref<MaterialTable> materialTable, const glm::mat4& transform = glm::mat4(1.0f), Ref<Material> overrideMaterial = nullptr);
+		// Culling frusta of the current scene, the cascade frusta are null when the directional light casts no shadows
+		const Frustum& GetCameraFrustum() const { return mCullingData.CameraFrustum; }
+		const Frustum* GetShadowCascadeFrustums() const { return mCullingData.CastShadows ? mCullingData.CascadeFrustums : nullptr; }
+
+		// visibility/submeshVisibility come from GetSubmeshVisibility, submeshVisibility is indexed like StaticMesh::GetSubmeshes()
+		// Submissions passing the same boneTransforms vector for the same mesh source share one bone palette,
+		// so the vector has to stay alive and unchanged until the end of the scene.
+		void SubmitMesh(Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, const glm::mat4& transform = glm::mat4(1.0f), const ozz::vector<ozz::math::Float4x4>& boneTransforms = {}, Ref<Material> overrideMaterial = nullptr, uint8_t visibility = (uint8_t)MeshVisibility::All);
+		void SubmitStaticMesh(Ref<StaticMesh> staticMesh, Ref<MaterialTable> materialTable, const glm::mat4& transform = glm::mat4(1.0f), Ref<Material> overrideMaterial = nullptr, const uint8_t* submeshVisibility = nullptr);
+
+		void SubmitSelectedMesh(Ref<Mesh> mesh, uint32_t submeshIndex, Ref<MaterialTable> materialTable, const glm::mat4& transform = glm::mat4(1.0f), const ozz::vector<ozz::math::Float4x4>& boneTransforms = {}, Ref<Material> overrideMaterial = nullptr, uint8_t visibility = (uint8_t)MeshVisibility::All);
+		void SubmitSelectedStaticMesh(Ref<StaticMesh> staticMesh, Ref<MaterialTable> materialTable, const glm::mat4& transform = glm::mat4(1.0f), Ref<Material> overrideMaterial = nullptr, const uint8_t* submeshVisibility = nullptr);
 
 		void SubmitParticles(Ref<Particles> particles, const glm::mat4& transform);
 
@@ -107,38 +129,26 @@ namespace NR
 
 		void ImGuiRender();
 
-		static void WaitForThreads();
+		// Submit* calls record into the calling thread's submission buffer (0 unless set otherwise).
+		// FlushDrawList merges the buffers in index order, so the draw lists don't depend on how submission was scheduled.
+		// Buffers have to be reserved before other threads start submitting.
+		void ReserveSubmissionBuffers(uint32_t count);
+		static void SetThreadSubmissionBuffer(uint32_t index);
+
 	private:
 		void FlushDrawList();
 
 		void PreRender();
 
-		struct MeshKey
-		{
-			AssetHandle MeshHandle;
-			AssetHandle MaterialHandle;
-			uint32_t SubmeshIndex;
-
-			MeshKey(AssetHandle meshHandle, AssetHandle materialHandle, uint32_t submeshIndex)
-				: MeshHandle(meshHandle), MaterialHandle(materialHandle), SubmeshIndex(submeshIndex) {}
-
-			bool operator<(const MeshKey& other) const
-			{
-				if (MeshHandle < other.MeshHandle)
-				{
-					return true;
-				}
-
-				if ((MeshHandle == other.MeshHandle) && (SubmeshIndex < other.SubmeshIndex))
-				{
-					return true;
-				}
-
-				return (MeshHandle == other.MeshHandle) && (SubmeshIndex == other.SubmeshIndex) && (MaterialHandle < other.MaterialHandle);
-			}
-		};
-
-		void CopyToBoneTransformStorage(const MeshKey& meshKey, const Ref<MeshSource>& meshSource, const ozz::vector<ozz::math::Float4x4>& boneTransforms);
+		struct SubmissionBuffer;
+		SubmissionBuffer& GetSubmissionBuffer();
+		uint32_t AddTransform(SubmissionBuffer& buffer, const glm::mat4& transform);
+		void AddDrawInstance(std::vector<DrawInstance>& instances, uint32_t submission, AssetHandle meshHandle, AssetHandle materialHandle, uint32_t submeshIndex, uint32_t transformIndex, uint32_t boneTransformsIndex);
+		void MergeSubmissionBuffers();
+		void MergeDrawList(MeshDrawList& drawList, std::vector<DrawInstance> SubmissionBuffer::* instances);
+		void UploadInstanceData();
+		uint32_t CopyToBoneTransformStorage(SubmissionBuffer& buffer, const Ref<MeshSource>& meshSource, const ozz::vector<ozz::math::Float4x4>& boneTransforms);
+		void CountSubmission(SubmissionBuffer& buffer, uint8_t visibility);
 
 		void ClearPass();
 		void DeinterleavingPass();
@@ -294,6 +304,20 @@ namespace NR
 		Ref<Material> CompositeMaterial;
 		Ref<Material> mLightCullingMaterial;
 
+		// Uniforms set every frame, resolved once when their materials are created
+		struct MaterialUniformHandles
+		{
+			MaterialUniformHandle DeinterleavingUVOffset;
+			MaterialUniformHandle HBAOBlurInvResDirection[2];
+			MaterialUniformHandle HBAOBlurSharpness[2];
+			MaterialUniformHandle CompositeExposure;
+			MaterialUniformHandle CompositeBloomIntensity;
+			MaterialUniformHandle CompositeBloomDirtIntensity;
+			MaterialUniformHandle SkyboxTextureLod;
+			MaterialUniformHandle SkyboxIntensity;
+			MaterialUniformHandle ColliderColor;
+		} mMaterialUniforms;
+
 		Ref<Pipeline> mGeometryPipeline;
 		Ref<Pipeline> mGeometryPipelineAnim;
 
@@ -343,16 +367,39 @@ namespace NR
 		Ref<Material> mParticleGenMaterial;
 		Ref<Pipeline> mParticlesPipeline;
 
+		// One per submitted instance, shared by all passes drawing it (InstanceTransforms storage buffer)
 		struct TransformVertexData
 		{
 			glm::vec4 MRow[3];
 		};
-		Ref<VertexBuffer> mSubmeshTransformBuffer;
-		TransformVertexData* mTransformVertexData = nullptr;
+		std::vector<TransformVertexData> mTransformData;
+		uint32_t mTransformBufferCapacity = 0;
+
+		Ref<VertexBuffer> mInstanceVertexBuffer;
+		std::vector<InstanceVertexData> mInstanceVertexData;
+		uint32_t mInstanceVertexBufferCapacity = 0;
 
 		using BoneTransforms = std::array<ozz::math::Float4x4, 100>;
+		using BoneTransformsKey = std::pair<const MeshSource*, const ozz::math::Float4x4*>;
+
+		// Open addressed index over a vector of keys the caller owns, both are cleared every frame but keep their memory
+		struct BoneTransformsTable
+		{
+			std::vector<uint32_t> Slots; // Index into the keys + 1, 0 for an empty slot
+
+			void Clear();
+			// Index of the key, appended to the keys if it wasn't in them yet
+			std::pair<uint32_t, bool> Insert(std::vector<BoneTransformsKey>& keys, const BoneTransformsKey& key);
+
+		private:
+			uint32_t& FindSlot(const std::vector<BoneTransformsKey>& keys, const BoneTransformsKey& key);
+		};
+
 		std::vector<Ref<StorageBuffer>> mBoneTransformStorageBuffers;
-		BoneTransforms* mBoneTransformsData = nullptr;
+		std::vector<BoneTransforms> mBoneTransformsData;
+		std::vector<BoneTransformsKey> mBoneTransformsKeys;
+		BoneTransformsTable mBoneTransformsLookup;
+		uint32_t mBoneTransformBufferCapacity = 0;
 
 		Ref<Material> mSelectedGeometryMaterial;
 		Ref<Material> mSelectedGeometryMaterialAnim;
@@ -361,38 +408,21 @@ namespace NR
 
 		Ref<RenderPass> mExternalCompositeRenderPass;
 
-		struct DrawCommand
+		// Resources of a single Submit* call, instances refer to it by index so the Refs are only moved once
+		struct DrawSubmission
 		{
 			Ref<Mesh> Mesh;
-			uint32_t SubmeshIndex;
-			Ref<MaterialTable> MaterialTable;
-			Ref<Material> OverrideMaterial;
-
-			uint32_t InstanceCount = 0;
-			uint32_t InstanceBaseIndex = 0;
-		};
-
-		struct StaticDrawCommand
-		{
 			Ref<StaticMesh> StaticMesh;
-			uint32_t SubmeshIndex;
 			Ref<MaterialTable> MaterialTable;
 			Ref<Material> OverrideMaterial;
-
-			uint32_t InstanceCount = 0;
-			uint32_t InstanceBaseIndex = 0;
 		};
 
+		static constexpr uint32_t NoBoneTransforms = DrawInstance::NoBoneTransforms;
+
 		struct TransformMapData
 		{
 			std::vector<TransformVertexData> Transforms;
-			uint32_t TransformOffset = 0;
-		};
-
-		struct BoneTransformsMapData
-		{
-			std::vector<BoneTransforms> BoneTransformsData;
-			uint32_t BoneTransformsBaseIndex = 0;
+			uint32_t InstanceOffset = 0;
 		};
 
 		struct ParticleData
@@ -406,24 +436,54 @@ namespace NR
 			}
 		};
 
-		std::map<MeshKey, TransformMapData> mMeshTransformMap;
-		std::map<MeshKey, BoneTransformsMapData> mMeshBoneTransformsMap;
+		// What the Submit* calls of one thread recorded, indices are local to the buffer until merged
+		struct SubmissionBuffer
+		{
+			std::vector<DrawSubmission> Submissions;
+			std::vector<TransformVertexData> Transforms;
+			std::vector<BoneTransforms> BoneTransformsStaging;
+			std::vector<BoneTransformsKey> BoneTransformsKeys;
+			BoneTransformsTable BoneTransformsLookup;
+			std::vector<uint32_t> BoneTransformsRemap; // Staging index to merged index, filled by MergeSubmissionBuffers
+
+			std::vector<DrawInstance> DrawList;
+			std::vector<DrawInstance> SelectedMeshDrawList;
+			std::vector<DrawInstance> ShadowPassDrawList;
+
+			std::vector<DrawInstance> StaticMeshDrawList;
+			std::vector<DrawInstance> SelectedStaticMeshDrawList;
+			std::vector<DrawInstance> StaticMeshShadowPassDrawList;
 
-		//std::vector<DrawCommand> mDrawList;
-		std::map<MeshKey, DrawCommand> mDrawList;
-		std::map<MeshKey, DrawCommand> mSelectedMeshDrawList;
-		std::map<MeshKey, DrawCommand> mShadowPassDrawList;
+			std::vector<DrawInstance> StaticColliderDrawList;
+			std::vector<DrawInstance> ColliderDrawList;
+
+			uint32_t Submitted = 0;
+			uint32_t Visible = 0;
+			uint32_t ShadowCasters = 0;
+
+			void Clear();
+		};
+		std::vector<SubmissionBuffer> mSubmissionBuffers;
 
-		std::map<MeshKey, StaticDrawCommand> mStaticMeshDrawList;
-		std::map<MeshKey, StaticDrawCommand> mSelectedStaticMeshDrawList;
-		std::map<MeshKey, StaticDrawCommand> mStaticMeshShadowPassDrawList;
+		// Merged from the submission buffers
+		std::vector<DrawSubmission> mDrawSubmissions;
+		std::vector<uint32_t> mSubmissionBases;
+		std::vector<uint32_t> mTransformBases;
+
+		MeshDrawList mDrawList;
+		MeshDrawList mSelectedMeshDrawList;
+		MeshDrawList mShadowPassDrawList;
+
+		MeshDrawList mStaticMeshDrawList;
+		MeshDrawList mSelectedStaticMeshDrawList;
+		MeshDrawList mStaticMeshShadowPassDrawList;
 
 		std::map<ParticleData, TransformMapData> mParticlesTransformMap;
 		std::vector<ParticleData> mParticlesDrawList;
 
 		// Debug
-		std::map<MeshKey, StaticDrawCommand> mStaticColliderDrawList;
-		std::map<MeshKey, DrawCommand> mColliderDrawList;
+		MeshDrawList mStaticColliderDrawList;
+		MeshDrawList mColliderDrawList;
 
 		// Grid
 		Ref<Pipeline> mGridPipeline;
@@ -461,6 +521,23 @@ namespace NR
 			uint32_t Meshes = 0;
 			uint32_t Instances = 0;
 			uint32_t SavedDraws = 0;
+
+			// CPU culling, counted per submitted submesh instance
+			uint32_t VisibleInstances = 0;
+			uint32_t CulledInstances = 0;
+			uint32_t ShadowCasters = 0;
+			uint32_t CulledShadowCasters = 0;
 		} mStatistics;
+
+		struct CullingData
+		{
+			Frustum CameraFrustum;
+			Frustum CascadeFrustums[4];
+			bool CastShadows = false;
+
+			uint32_t Submitted = 0;
+			uint32_t Visible = 0;
+			uint32_t ShadowCasters = 0;
+		} mCullingData;
 	};
 }
\ No newline at end of file
@@ -2,63 +2,206 @@
 #include "ShaderCache.h"
 
 #include "NotRed/Core/Hash.h"
-#include "yaml-cpp/yaml.h"
+#include "NotRed/Core/Timer.h"
 
 namespace NR
 {
 	static const char* sShaderRegistryPath = "Resources/Cache/Shader/ShaderRegistry.cache";
 
+	// "NRSC" followed by the format version
+	static constexpr uint32_t sShaderRegistryMagic = 0x4353524E;
+	static constexpr uint32_t sShaderRegistryVersion = 1;
+
+	struct ShaderCacheData
+	{
+		std::mutex Mutex;
+		std::unordered_map<std::string, uint64_t> Registry;
+		bool Loaded = false;
+		bool Dirty = false;
+
+		uint32_t BatchDepth = 0;
+		Timer BatchTimer;
+
+		uint32_t Hits = 0;
+		uint32_t Misses = 0;
+		float HitTime = 0.0f;
+		float MissTime = 0.0f;
+	};
+
+	static ShaderCacheData sData;
+
+	namespace Utils
+	{
+		template<typename T>
+		static void WriteValue(std::ofstream& stream, const T& value)
+		{
+			stream.write((const char*)&value, sizeof(T));
+		}
+
+		template<typename T>
+		static bool ReadValue(std::ifstream& stream, T& value)
+		{
+			stream.read((char*)&value, sizeof(T));
+			return (bool)stream;
+		}
+	}
+
 	bool ShaderCache::HasChanged(const std::filesystem::path& shader, const std::string& source)
 	{
-		std::map<std::string, uint32_t> shaderCache;
-		Deserialize(shaderCache);
-		uint32_t hash = Hash::GenerateFNVHash(source.c_str());
-		if (shaderCache.find(shader.string()) == shaderCache.end() || shaderCache.at(shader.string()) != hash)
+		std::scoped_lock<std::mutex> lock(sData.Mutex);
+
+		if (!sData.Loaded)
 		{
-			shaderCache[shader.string()] = hash;
-			Serialize(shaderCache);
-			return true;
+			Deserialize(sData.Registry);
+			sData.Loaded = true;
 		}
-		return false;
+
+		const uint64_t hash = Hash::GenerateFNVHash64(source);
+		auto [it, inserted] = sData.Registry.try_emplace(shader.string(), hash);
+		if (!inserted && it->second == hash)
+		{
+			return false;
+		}
+
+		it->second = hash;
+		sData.Dirty = true;
+
+		if (sData.BatchDepth == 0)
+		{
+			Serialize(sData.Registry);
+			sData.Dirty = false;
+		}
+		return true;
 	}
 
-	void ShaderCache::Serialize(const std::map<std::string, uint32_t>& shaderCache)
+	void ShaderCache::BeginBatch()
 	{
-		YAML::Emitter out;
-		out << YAML::BeginMap;
-		out << YAML::Key << "ShaderRegistry" << YAML::BeginMap;
-		for (auto& [filepath, hash] : shaderCache)
+		std::scoped_lock<std::mutex> lock(sData.Mutex);
+		if (sData.BatchDepth++ > 0)
 		{
-			out << YAML::Key << filepath << YAML::Value << hash;
+			return;
 		}
-		out << YAML::EndMap;
-		out << YAML::EndMap;
 
-		std::ofstream fout(sShaderRegistryPath);
-		fout << out.c_str();
+		sData.BatchTimer.Reset();
+		sData.Hits = 0;
+		sData.Misses = 0;
+		sData.HitTime = 0.0f;
+		sData.MissTime = 0.0f;
 	}
-	void ShaderCache::Deserialize(std::map<std::string, uint32_t>& shaderCache)
+
+	void ShaderCache::EndBatch()
 	{
-		// Read registry
-		std::ifstream stream(sShaderRegistryPath);
+		std::scoped_lock<std::mutex> lock(sData.Mutex);
+		NR_CORE_ASSERT(sData.BatchDepth > 0, "ShaderCache::EndBatch without BeginBatch");
+		if (--sData.BatchDepth > 0)
+		{
+			return;
+		}
+
+		if (sData.Dirty)
+		{
+			Serialize(sData.Registry);
+			sData.Dirty = false;
+		}
+
+		NR_CORE_INFO("[ShaderCache] {0} shaders in {1:.2f}ms: {2} cached ({3:.2f}ms), {4} compiled ({5:.2f}ms)",
+			sData.Hits + sData.Misses, sData.BatchTimer.ElapsedMillis(), sData.Hits, sData.HitTime, sData.Misses, sData.MissTime);
+	}
+
+	void ShaderCache::RecordLoad(bool cacheHit, float milliseconds)
+	{
+		std::scoped_lock<std::mutex> lock(sData.Mutex);
+		if (cacheHit)
+		{
+			++sData.Hits;
+			sData.HitTime += milliseconds;
+		}
+		else
+		{
+			++sData.Misses;
+			sData.MissTime += milliseconds;
+		}
+	}
+
+	void ShaderCache::Serialize(const std::unordered_map<std::string, uint64_t>& shaderCache)
+	{
+		// Written next to the registry and moved over it, so a crash never leaves a half written registry behind
+		const std::filesystem::path registryPath = sShaderRegistryPath;
+		std::filesystem::path tempPath = registryPath;
+		tempPath += ".tmp";
+
+		std::filesystem::create_directories(registryPath.parent_path());
+
+		{
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+			if (!stream)
+			{
+				NR_CORE_ERROR("[ShaderCache] Could not write {0}", tempPath.string());
+				return;
+			}
+
+			Utils::WriteValue(stream, sShaderRegistryMagic);
+			Utils::WriteValue(stream, sShaderRegistryVersion);
+			Utils::WriteValue(stream, (uint32_t)shaderCache.size());
+			for (const auto& [filepath, hash] : shaderCache)
+			{
+				Utils::WriteValue(stream, (uint32_t)filepath.size());
+				stream.write(filepath.data(), filepath.size());
+				Utils::WriteValue(stream, hash);
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, registryPath, error);
+		if (error)
+		{
+			NR_CORE_ERROR("[ShaderCache] Could not replace {0}: {1}", registryPath.string(), error.message());
+		}
+	}
+
+	void ShaderCache::Deserialize(std::unordered_map<std::string, uint64_t>& shaderCache)
+	{
+		std::ifstream stream(sShaderRegistryPath, std::ios::binary);
 		if (!stream.good())
 		{
 			return;
 		}
-		std::stringstream strStream;
-		strStream << stream.rdbuf();
-		YAML::Node data = YAML::Load(strStream.str());
-		auto handles = data["ShaderRegistry"];
-		if (!handles)
+
+		uint32_t magic = 0, version = 0, count = 0;
+		if (!Utils::ReadValue(stream, magic) || magic != sShaderRegistryMagic || !Utils::ReadValue(stream, version) || version != sShaderRegistryVersion)
+		{
+			// Registries from older versions are dropped, every shader gets compiled once more
+			NR_CORE_WARN("[ShaderCache] Shader Registry is outdated, rebuilding it.");
+			return;
+		}
+
+		if (!Utils::ReadValue(stream, count))
 		{
 			NR_CORE_ERROR("[ShaderCache] Shader Registry is invalid.");
 			return;
 		}
-		for (auto entry : handles)
+
+		shaderCache.reserve(count);
+		for (uint32_t i = 0; i < count; ++i)
 		{
-			std::string path = entry.first.as<std::string>();
-			uint32_t hash = entry.second.as<uint32_t>();
+			uint32_t length = 0;
+			uint64_t hash = 0;
+			std::string path;
+
+			if (Utils::ReadValue(stream, length))
+			{
+				path.resize(length);
+				stream.read(path.data(), length);
+			}
+
+			if (!stream || !Utils::ReadValue(stream, hash))
+			{
+				NR_CORE_ERROR("[ShaderCache] Shader Registry is invalid.");
+				shaderCache.clear();
+				return;
+			}
+
 			shaderCache[path] = hash;
 		}
 	}
-}
\ No newline at end of file
+}
@@ -1,17 +1,28 @@
 #pragma once
 
 #include <filesystem>
-#include <map>
+#include <unordered_map>
 
 namespace NR
 {
+	//
+	// Registry of the source hash every cached shader binary was compiled from. It's loaded once, kept
+	// in memory and written back when a load batch ends, or right away for loads outside of a batch.
+	//
 	class ShaderCache
 	{
 	public:
+		// Returns true and records the new hash when the source differs from the one the cached binary was built from
 		static bool HasChanged(const std::filesystem::path& shader, const std::string& source);
 
+		// Batches nest, the registry is only written once the outermost batch ends
+		static void BeginBatch();
+		static void EndBatch();
+
+		static void RecordLoad(bool cacheHit, float milliseconds);
+
 	private:
-		static void Serialize(const std::map<std::string, uint32_t>& shaderCache);
-		static void Deserialize(std::map<std::string, uint32_t>& shaderCache);
+		static void Serialize(const std::unordered_map<std::string, uint64_t>& shaderCache);
+		static void Deserialize(std::unordered_map<std::string, uint64_t>& shaderCache);
 	};
-}
\ No newline at end of file
+}
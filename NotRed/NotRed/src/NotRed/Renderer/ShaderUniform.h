@@ -8,6 +8,46 @@
 
 namespace NR
 {
+	//
+	// Hashed name of a material uniform or resource. Hash it once, e.g. as a static next to the code setting it,
+	// and Material lookups become an integer map lookup instead of hashing and comparing strings every call.
+	// Produces the same value as Hash::GenerateFNVHash.
+	//
+	class MaterialPropertyID
+	{
+	public:
+		constexpr explicit MaterialPropertyID(const char* name)
+			: mHash(GenerateHash(name))
+		{
+		}
+
+		explicit MaterialPropertyID(const std::string& name)
+			: mHash(GenerateHash(name.c_str()))
+		{
+		}
+
+		constexpr uint32_t GetHash() const { return mHash; }
+
+		constexpr bool operator==(const MaterialPropertyID& other) const { return mHash == other.mHash; }
+		constexpr bool operator!=(const MaterialPropertyID& other) const { return mHash != other.mHash; }
+
+	private:
+		static constexpr uint32_t GenerateHash(const char* name)
+		{
+			// FNV-1a including the null terminator
+			uint32_t hash = 2166136261u;
+			do
+			{
+				hash ^= (uint32_t)(int8_t)*name;
+				hash *= 16777619u;
+			} while (*name++);
+			return hash;
+		}
+
+	private:
+		uint32_t mHash;
+	};
+
 	enum class ShaderDomain
 	{
 		None, Vertex, Pixel
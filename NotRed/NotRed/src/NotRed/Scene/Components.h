@@ -86,6 +86,29 @@ namespace NR
             : ParentHandle(parent) {}
     };
 
+    // Cached world-space matrix, added along with TransformComponent. Writes to the transform or parent mark it
+    // and every descendant Dirty (see Scene::MarkTransformDirty), it is rebuilt when it's read or by Scene::UpdateWorldTransforms.
+    struct alignas(16) WorldTransformComponent
+    {
+        glm::mat4 Transform = glm::mat4(1.0f);
+
+        bool Dirty = true;
+
+        WorldTransformComponent() = default;
+        WorldTransformComponent(const WorldTransformComponent& other) = default;
+    };
+
+    // Pose a rigid body is drawn at between two physics steps. Dynamic bodies get one when PhysicsScene interpolates,
+    // it is Active while the body moves. TransformComponent keeps the simulated pose, so gameplay code never sees the blend.
+    struct InterpolatedTransformComponent
+    {
+        glm::mat4 Transform = glm::mat4(1.0f);
+        bool Active = false;
+
+        InterpolatedTransformComponent() = default;
+        InterpolatedTransformComponent(const InterpolatedTransformComponent& other) = default;
+    };
+
     struct MeshComponent
     {
         AssetHandle MeshHandle;
@@ -169,10 +192,18 @@ namespace NR
         AssetHandle AnimationController;
         std::vector<UUID> BoneEntityIds;
         UUID RootMotionTarget = 0;  
-        float AnimationTime = 0.0;
+        float AnimationTime = 0.0;  // Where playback starts, the current time is in the instance
 
         bool EnableRootMotion = false;
-        bool EnableAnimation = true;
+        bool EnableAnimation = true; // Plays this entity's instance, the controller it shares has no play state
+
+        // Write the animated pose into the bone entities' transforms every frame at runtime.
+        // Rendering doesn't need it. Without it the bones are still written when something is attached to them,
+        // or when a script reads one of their transforms.
+        bool SyncBoneEntities = false;
+
+        // This entity's playback state, created by the first Scene::UpdateAnimation that plays the controller
+        AnimationInstanceHandle Instance;
     };
 
     struct TextComponent
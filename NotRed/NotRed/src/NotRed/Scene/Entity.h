@@ -69,6 +69,8 @@ namespace NR
 
 		TransformComponent& Transform() { return mScene->mRegistry.get<TransformComponent>(mEntityHandle); }
 		const glm::mat4& Transform() const { return mScene->mRegistry.get<TransformComponent>(mEntityHandle).GetTransform(); }
+		// Call after writing to Transform(), see Scene::MarkTransformDirty
+		void MarkTransformDirty() { mScene->MarkTransformDirty(mEntityHandle); }
 
 		std::string& Name() { return HasComponent<TagComponent>() ? GetComponent<TagComponent>().Tag : NoName; }
 		const std::string& Name() const { return HasComponent<TagComponent>() ? GetComponent<TagComponent>().Tag : NoName; }
@@ -106,7 +108,11 @@ namespace NR
 		UUID& GetID() { return GetComponent<IDComponent>().ID; }
 		UUID GetSceneID() { return mScene->GetID(); }
 
-		void SetParentID(UUID parent) { GetComponent<RelationshipComponent>().ParentHandle = parent; }
+		void SetParentID(UUID parent)
+		{
+			GetComponent<RelationshipComponent>().ParentHandle = parent;
+			MarkTransformDirty();
+		}
 		UUID GetParentID() const { return GetComponent<RelationshipComponent>().ParentHandle; }
 		std::vector<UUID>& Children() { return GetComponent<RelationshipComponent>().Children; }
 
@@ -1,6 +1,7 @@
 #include "nrpch.h"
 #include "Scene.h"
 
+
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -9,7 +10,6 @@
 
 // Box2D
 #include <box2d/box2d.h>
-#include <assimp/scene.h>
 
 #include "Entity.h"
 #include "Prefab.h"
@@ -32,6 +32,7 @@
 #include "NotRed/Renderer/SceneRenderer.h"
 
 #include "NotRed/Debug/Profiler.h"
+#include "NotRed/Core/JobSystem.h"
 
 // TEMP
 #include "NotRed/Core/Input.h"
@@ -49,7 +50,6 @@ namespace NR
 
 	namespace Utils 
 	{
-		glm::mat4 Mat4FromAIMatrix4x4(const aiMatrix4x4& matrix);
 		ozz::math::Float4x4 Float4x4FromMat4(const glm::mat4& mat);
 	}
 
@@ -154,6 +154,14 @@ namespace NR
 	Scene::Scene(const std::string& name, bool isEditorScene, bool initalize)
 		: mName(name), mIsEditorScene(isEditorScene)
 	{
+		// Keeps the world transform cache up to date when transforms or parents are replaced as a whole (copies, prefabs)
+		mRegistry.on_construct<TransformComponent>().connect<&Scene::TransformComponentConstruct>(this);
+		mRegistry.on_update<TransformComponent>().connect<&Scene::TransformComponentUpdate>(this);
+		mRegistry.on_update<RelationshipComponent>().connect<&Scene::TransformComponentUpdate>(this);
+
+		// Registered either way, physics actors look their scene up by ID
+		sActiveScenes[mSceneID] = this;
+
 		if (!initalize)
 			return;
 
@@ -180,8 +188,6 @@ namespace NR
 
 		mRegistry.emplace<PhysicsSceneComponent>(mSceneEntity, Ref<PhysicsScene>::Create(PhysicsManager::GetSettings()));
 
-		sActiveScenes[mSceneID] = this;
-
 		Init();
 	}
 
@@ -233,6 +239,7 @@ namespace NR
 				transform.Translation.x = position.x;
 				transform.Translation.y = position.y;
 				transform.Rotation.z = body->GetAngle();
+				MarkTransformDirty(entity);
 			}
 		}
 
@@ -243,13 +250,7 @@ namespace NR
 			if (mIsPlaying)
 			{
 				NR_PROFILE_FUNC("Scene::Update - C# Update");
-				auto view = mRegistry.view<ScriptComponent>();
-				for (auto entity : view)
-				{
-					Entity e = { entity, this };
-					if (ScriptEngine::ModuleExists(e.GetComponent<ScriptComponent>().ModuleName))
-						ScriptEngine::UpdateEntity(e, dt);
-				}
+				ScriptEngine::UpdateEntities(mSceneID, dt);
 
 				for (auto&& fn : mPostUpdateQueue)
 				{
@@ -264,6 +265,9 @@ namespace NR
 			physicsScene->Simulate(dt);
 		}
 
+		// Keeps entity queries from scripts and picking in step with what scripts and physics just moved
+		UpdateSpatialIndex(true);
+
 		{	//--- Update Audio Listener ---
 			//=============================
 			
@@ -403,6 +407,7 @@ namespace NR
 	{
 		NR_PROFILE_FUNC();
 		UpdateAnimation(dt, false);
+		UpdateSpatialIndex(false);
 	}
 
 	void Scene::RenderRuntime(Ref<SceneRenderer> renderer, float dt)
@@ -416,6 +421,8 @@ namespace NR
 		if (!cameraEntity)
 			return;
 
+		UpdateWorldTransforms();
+
 		glm::mat4 cameraViewMatrix = glm::inverse(GetWorldSpaceTransformMatrix(cameraEntity));
 		NR_CORE_ASSERT(cameraEntity, "Scene does not contain any cameras!");
 		SceneCamera& camera = cameraEntity.GetComponent<CameraComponent>();
@@ -497,62 +504,7 @@ namespace NR
 		renderer->SetScene(this);
 		renderer->BeginScene({ camera, cameraViewMatrix, camera.GetPerspectiveNearClip(), camera.GetPerspectiveFarClip(), camera.GetPerspectiveVerticalFOV() });
 
-		// Render Static Meshes
-		{
-			auto group = mRegistry.group<StaticMeshComponent>(entt::get<TransformComponent>);
-			for (auto entity : group)
-			{
-				NR_PROFILE_FUNC("Scene-SubmitStaticMesh");
-				auto [transformComponent, staticMeshComponent] = group.get<TransformComponent, StaticMeshComponent>(entity);
-				if (AssetManager::IsAssetHandleValid(staticMeshComponent.StaticMesh))
-				{
-					auto staticMesh = AssetManager::GetAsset<StaticMesh>(staticMeshComponent.StaticMesh);
-					if (staticMesh && !staticMesh->IsFlagSet(AssetFlag::Missing))
-					{
-						Entity e = Entity(entity, this);
-						glm::mat4 transform = GetWorldSpaceTransformMatrix(e);
-
-						if (mSelectedEntity == entity)
-						{
-							renderer->SubmitSelectedStaticMesh(staticMesh, staticMeshComponent.Materials, transform);
-						}
-						else
-						{
-							renderer->SubmitStaticMesh(staticMesh, staticMeshComponent.Materials, transform);
-						}
-					}
-				}
-			}
-		}
-
-		// Render Dynamic Meshes
-		{
-			auto view = mRegistry.view<MeshComponent, TransformComponent>();
-			for (auto entity : view)
-			{
-				NR_PROFILE_FUNC("Scene-SubmitDynamicMesh");
-				auto [transformComponent, meshComponent] = view.get<TransformComponent, MeshComponent>(entity);
-				if (AssetManager::IsAssetHandleValid(meshComponent.MeshHandle))
-				{
-					auto mesh = AssetManager::GetAsset<Mesh>(meshComponent.MeshHandle);
-					if (mesh && !mesh->IsFlagSet(AssetFlag::Missing))
-					{
-						Entity e = Entity(entity, this);
-
-						glm::mat4 transform = e.HasComponent<RigidBodyComponent>() ? e.Transform().GetTransform() : GetWorldSpaceTransformMatrix(e);
-						ozz::vector<ozz::math::Float4x4> boneTransforms = GetModelSpaceBoneTransforms(meshComponent.BoneEntityIds, mesh);
-						if (mSelectedEntity == entity)
-						{
-							renderer->SubmitSelectedMesh(mesh, meshComponent.SubmeshIndex, meshComponent.Materials, transform, boneTransforms);
-						}
-						else
-						{
-							renderer->SubmitMesh(mesh, meshComponent.SubmeshIndex, meshComponent.Materials, transform, boneTransforms);
-						}
-					}
-				}
-			}
-		}
+		SubmitMeshes(renderer, true);
 
 		// Render Particles
 		auto groupParticles = mRegistry.group<ParticleComponent>(entt::get<TransformComponent>);
@@ -625,6 +577,8 @@ namespace NR
 		// RENDER 3D SCENE
 		/////////////////////////////////////////////////////////////////////
 
+		UpdateWorldTransforms();
+
 		// Lighting
 		{
 			mLightEnvironment = LightEnvironment();
@@ -698,59 +652,7 @@ namespace NR
 		renderer->SetScene(this);
 		renderer->BeginScene({ editorCamera, editorCamera.GetViewMatrix(), editorCamera.GetNearClip(), editorCamera.GetFarClip(), editorCamera.GetVerticalFOV() });
 
-		// Render Static Meshes
-		{
-			auto group = mRegistry.group<StaticMeshComponent>(entt::get<TransformComponent>);
-			for (auto entity : group)
-			{
-				auto [transformComponent, staticMeshComponent] = group.get<TransformComponent, StaticMeshComponent>(entity);
-				if (AssetManager::IsAssetHandleValid(staticMeshComponent.StaticMesh))
-				{
-					auto staticMesh = AssetManager::GetAsset<StaticMesh>(staticMeshComponent.StaticMesh);
-					NR_CORE_ASSERT(staticMesh, "StaticMesh does not exist!");
-					if (staticMesh && !staticMesh->IsFlagSet(AssetFlag::Missing))
-					{
-						Entity e = Entity(entity, this);
-						glm::mat4 transform = GetWorldSpaceTransformMatrix(e);
-
-						if (mSelectedEntity == entity)
-							renderer->SubmitSelectedStaticMesh(staticMesh, staticMeshComponent.Materials, transform);
-						else
-							renderer->SubmitStaticMesh(staticMesh, staticMeshComponent.Materials, transform);
-					}
-				}
-			}
-		}
-
-		// Render Dynamic Meshes
-		{
-			auto view = mRegistry.view<MeshComponent, TransformComponent>();
-			for (auto entity : view)
-			{
-				auto [transformComponent, meshComponent] = view.get<TransformComponent, MeshComponent>(entity);
-				if (AssetManager::IsAssetHandleValid(meshComponent.MeshHandle))
-				{
-					auto mesh = AssetManager::GetAsset<Mesh>(meshComponent.MeshHandle);
-					NR_CORE_ASSERT(mesh, "Mesh does not exist!");
-					if (mesh && !mesh->IsFlagSet(AssetFlag::Missing))
-					{
-						Entity e = Entity(entity, this);
-
-						glm::mat4 transform = GetWorldSpaceTransformMatrix(e);
-						ozz::vector<ozz::math::Float4x4> boneTransforms = GetModelSpaceBoneTransforms(meshComponent.BoneEntityIds, mesh);
-
-						if (mSelectedEntity == entity)
-						{
-							renderer->SubmitSelectedMesh(mesh, meshComponent.SubmeshIndex, meshComponent.Materials, transform, boneTransforms);
-						}
-						else
-						{
-							renderer->SubmitMesh(mesh, meshComponent.SubmeshIndex, meshComponent.Materials, transform, boneTransforms);
-						}
-					}
-				}
-			}
-		}
+		SubmitMeshes(renderer, false);
 
 		// Render Particles
 		auto groupParticles = mRegistry.group<ParticleComponent>(entt::get<TransformComponent>);
@@ -880,6 +782,8 @@ namespace NR
 		// RENDER 3D SCENE
 		/////////////////////////////////////////////////////////////////////
 
+		UpdateWorldTransforms();
+
 		// Lighting
 		{
 			mLightEnvironment = LightEnvironment();
@@ -954,57 +858,7 @@ namespace NR
 		renderer->SetScene(this);
 		renderer->BeginScene({ editorCamera, editorCamera.GetViewMatrix(), editorCamera.GetNearClip(), editorCamera.GetFarClip(), editorCamera.GetVerticalFOV() });
 
-		// Render Static Meshes
-		{
-			auto group = mRegistry.group<StaticMeshComponent>(entt::get<TransformComponent>);
-			for (auto entity : group)
-			{
-				auto [transformComponent, staticMeshComponent] = group.get<TransformComponent, StaticMeshComponent>(entity);
-				if (AssetManager::IsAssetHandleValid(staticMeshComponent.StaticMesh))
-				{
-					auto staticMesh = AssetManager::GetAsset<StaticMesh>(staticMeshComponent.StaticMesh);
-					if (!staticMesh->IsFlagSet(AssetFlag::Missing))
-					{
-						Entity e = Entity(entity, this);
-						glm::mat4 transform = GetWorldSpaceTransformMatrix(e);
-
-						if (mSelectedEntity == entity)
-							renderer->SubmitSelectedStaticMesh(staticMesh, staticMeshComponent.Materials, transform);
-						else
-							renderer->SubmitStaticMesh(staticMesh, staticMeshComponent.Materials, transform);
-					}
-				}
-			}
-		}
-
-		// Render Dynamic Meshes
-		{
-			auto view = mRegistry.view<MeshComponent, TransformComponent>();
-			for (auto entity : view)
-			{
-				auto [transformComponent, meshComponent] = view.get<TransformComponent, MeshComponent>(entity);
-				if (AssetManager::IsAssetHandleValid(meshComponent.MeshHandle))
-				{
-					auto mesh = AssetManager::GetAsset<Mesh>(meshComponent.MeshHandle);
-					if (mesh && !mesh->IsFlagSet(AssetFlag::Missing))
-					{
-						Entity e = Entity(entity, this);
-
-						glm::mat4 transform = e.HasComponent<RigidBodyComponent>() ? e.Transform().GetTransform() : GetWorldSpaceTransformMatrix(e);
-						ozz::vector<ozz::math::Float4x4> boneTransforms = GetModelSpaceBoneTransforms(meshComponent.BoneEntityIds, mesh);
-
-						if (mSelectedEntity == entity)
-						{
-							renderer->SubmitSelectedMesh(mesh, meshComponent.SubmeshIndex, meshComponent.Materials, transform, boneTransforms);
-						}
-						else
-						{
-							renderer->SubmitMesh(mesh, meshComponent.SubmeshIndex, meshComponent.Materials, transform, boneTransforms);
-						}
-					}
-				}
-			}
-		}
+		SubmitMeshes(renderer, true);
 
 		auto groupParticles = mRegistry.group<ParticleComponent>(entt::get<TransformComponent>);
 		for (auto entity : groupParticles)
@@ -1056,6 +910,335 @@ namespace NR
 		}
 	}
 
+	glm::mat4 Scene::GetRenderTransformMatrix(Entity entity, bool useRigidBodyTransforms)
+	{
+		if (!useRigidBodyTransforms)
+			return GetWorldSpaceTransformMatrix(entity);
+
+		// Only scenes that interpolate have slots, the others skip the walk
+		if (!mRegistry.view<InterpolatedTransformComponent>().empty())
+		{
+			// Entities parented to a body move with it, they are drawn relative to the closest interpolated ancestor
+			for (entt::entity current = entity; current != entt::null;)
+			{
+				const auto* interpolatedTransform = mRegistry.try_get<InterpolatedTransformComponent>(current);
+				if (interpolatedTransform && interpolatedTransform->Active)
+				{
+					if (current == (entt::entity)entity)
+						return interpolatedTransform->Transform;
+
+					return interpolatedTransform->Transform * glm::inverse(GetWorldSpaceTransformMatrix(Entity(current, this))) * GetWorldSpaceTransformMatrix(entity);
+				}
+
+				// A body that isn't moving is drawn at its simulated pose, and so is everything below it
+				if (mRegistry.all_of<RigidBodyComponent>(current))
+					break;
+
+				const auto* relationship = mRegistry.try_get<RelationshipComponent>(current);
+				auto parentIt = relationship ? mEntityIDMap.find(relationship->ParentHandle) : mEntityIDMap.end();
+				current = parentIt != mEntityIDMap.end() ? (entt::entity)parentIt->second : entt::null;
+			}
+		}
+
+		if (entity.HasComponent<RigidBodyComponent>())
+			return entity.Transform().GetTransform();
+
+		return GetWorldSpaceTransformMatrix(entity);
+	}
+
+	template<typename BoundsFn>
+	const Scene::SpatialProxy* Scene::UpdateSpatialProxy(entt::entity entity, const Asset* mesh, const glm::mat4& transform, BoundsFn&& calculateBounds)
+	{
+		auto [it, inserted] = mSpatialProxies.try_emplace(entity);
+		SpatialProxy& proxy = it->second;
+		proxy.LastUpdate = mSpatialUpdateIndex;
+		proxy.Visibility = (uint8_t)MeshVisibility::None;
+
+		if (inserted)
+		{
+			proxy.Node = mSpatialTree.CreateProxy(calculateBounds(), (uint32_t)entity);
+		}
+		else if (proxy.Mesh != mesh || proxy.Transform != transform)
+		{
+			mSpatialTree.MoveProxy(proxy.Node, calculateBounds());
+		}
+
+		proxy.Mesh = mesh;
+		proxy.Transform = transform;
+		return &proxy;
+	}
+
+	void Scene::QueryEntities(const AABB& aabb, std::vector<Entity>& outEntities)
+	{
+		mSpatialTree.Query(aabb, [&](uint32_t userData)
+			{
+				const entt::entity entity = (entt::entity)userData;
+				if (mRegistry.valid(entity))
+					outEntities.emplace_back(entity, this);
+				return true;
+			});
+	}
+
+	void Scene::QueryEntities(const Frustum& frustum, std::vector<Entity>& outEntities)
+	{
+		mSpatialTree.Query(frustum, [&](uint32_t userData)
+			{
+				const entt::entity entity = (entt::entity)userData;
+				if (mRegistry.valid(entity))
+					outEntities.emplace_back(entity, this);
+				return true;
+			});
+	}
+
+	void Scene::RaycastEntities(const Ray& ray, std::vector<Entity>& outEntities)
+	{
+		mSpatialTree.Raycast(ray, [&](uint32_t userData, float)
+			{
+				const entt::entity entity = (entt::entity)userData;
+				if (mRegistry.valid(entity))
+					outEntities.emplace_back(entity, this);
+				return true;
+			});
+	}
+
+	void Scene::UpdateSpatialIndex(bool useRigidBodyTransforms)
+	{
+		NR_PROFILE_FUNC();
+
+		UpdateWorldTransforms();
+		GatherMeshes(useRigidBodyTransforms, false);
+	}
+
+	uint32_t Scene::GatherMeshes(bool useRigidBodyTransforms, bool fillCullLists)
+	{
+		// Gather every renderable mesh along with its world transform, refitting the spatial index as we go
+		++mSpatialUpdateIndex;
+		uint32_t visibilityCount = 0;
+		StaticMeshCullItem staticMeshItem;
+		MeshCullItem meshItem;
+		{
+			auto group = mRegistry.group<StaticMeshComponent>(entt::get<TransformComponent>);
+			for (auto entity : group)
+			{
+				auto& staticMeshComponent = group.get<StaticMeshComponent>(entity);
+				if (!AssetManager::IsAssetHandleValid(staticMeshComponent.StaticMesh))
+					continue;
+
+				// Meshes that are still streaming in are drawn as the placeholder
+				auto staticMesh = AssetManager::GetAssetAsync<StaticMesh>(staticMeshComponent.StaticMesh);
+				if (!staticMesh || staticMesh->IsFlagSet(AssetFlag::Missing))
+					continue;
+
+				auto& item = fillCullLists ? mStaticMeshCullList.emplace_back() : staticMeshItem;
+				item.Entity = entity;
+				item.StaticMesh = staticMesh;
+				item.Source = staticMesh->GetMeshSource().Raw();
+				item.Transform = GetRenderTransformMatrix(Entity(entity, this), useRigidBodyTransforms);
+				item.VisibilityOffset = visibilityCount;
+				item.Proxy = UpdateSpatialProxy(entity, staticMesh.Raw(), item.Transform, [&item]()
+					{
+						AABB bounds(glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+						const auto& submeshData = item.Source->GetSubmeshes();
+						for (uint32_t submeshIndex : item.StaticMesh->GetSubmeshes())
+						{
+							const AABB submeshBounds = submeshData[submeshIndex].BoundingBox.Transformed(item.Transform * submeshData[submeshIndex].Transform);
+							bounds.Min = glm::min(bounds.Min, submeshBounds.Min);
+							bounds.Max = glm::max(bounds.Max, submeshBounds.Max);
+						}
+
+						if (bounds.Min.x > bounds.Max.x)
+							return AABB(glm::vec3(item.Transform[3]), glm::vec3(item.Transform[3]));
+
+						return bounds;
+					});
+				visibilityCount += (uint32_t)staticMesh->GetSubmeshes().size();
+			}
+		}
+		{
+			auto view = mRegistry.view<MeshComponent, TransformComponent>();
+			for (auto entity : view)
+			{
+				auto& meshComponent = view.get<MeshComponent>(entity);
+				if (!AssetManager::IsAssetHandleValid(meshComponent.MeshHandle))
+					continue;
+
+				auto mesh = AssetManager::GetAssetAsync<Mesh>(meshComponent.MeshHandle);
+				if (!mesh || mesh->IsFlagSet(AssetFlag::Missing))
+					continue;
+
+				Entity e = Entity(entity, this);
+				auto& item = fillCullLists ? mMeshCullList.emplace_back() : meshItem;
+				item.Entity = entity;
+				item.Mesh = mesh;
+				item.Source = mesh->GetMeshSource().Raw();
+				item.SubmeshIndex = AssetManager::IsPlaceholderAsset(mesh, meshComponent.MeshHandle) ? 0 : meshComponent.SubmeshIndex;
+				item.Transform = GetRenderTransformMatrix(e, useRigidBodyTransforms);
+				item.Visibility = (uint8_t)MeshVisibility::All;
+				item.Proxy = UpdateSpatialProxy(entity, mesh.Raw(), item.Transform, [&item]()
+					{
+						return item.Source->GetSubmeshes()[item.SubmeshIndex].BoundingBox.Transformed(item.Transform);
+					});
+
+				// Animated meshes use the pose UpdateAnimation left in the instance, the rest is posed by its bone entities once per skeleton
+				item.BoneTransforms = nullptr;
+				if (fillCullLists && item.Source->IsRigged())
+				{
+					item.BoneTransforms = GetAnimatedBoneTransforms(meshComponent.BoneEntityIds, item.Source);
+					if (!item.BoneTransforms)
+					{
+						// A skeleton that is animated but didn't hand over its pose doesn't match this mesh, pose it from up to date bone entities
+						if (!meshComponent.BoneEntityIds.empty())
+						{
+							auto unsynced = mUnsyncedBoneEntities.find(meshComponent.BoneEntityIds[0]);
+							if (unsynced != mUnsyncedBoneEntities.end())
+							{
+								if (mBoneTransformsFallbackWarnings.insert(unsynced->second).second)
+									NR_CORE_WARN("Mesh of '{0}' doesn't match the skeleton of its animation, it is posed from the bone entities instead", e.Name());
+
+								SyncBoneEntity(meshComponent.BoneEntityIds[0]);
+							}
+						}
+
+						const uint64_t rootBone = meshComponent.BoneEntityIds.empty() ? 0 : (uint64_t)meshComponent.BoneEntityIds[0];
+						auto [it, inserted] = mBoneEntityPoses.try_emplace({ rootBone, item.Source });
+						if (inserted)
+							it->second = GetModelSpaceBoneTransforms(meshComponent.BoneEntityIds, mesh);
+
+						item.BoneTransforms = &it->second;
+					}
+				}
+			}
+		}
+
+		// Drop entities that lost their mesh or were destroyed
+		for (auto it = mSpatialProxies.begin(); it != mSpatialProxies.end();)
+		{
+			if (it->second.LastUpdate != mSpatialUpdateIndex)
+			{
+				mSpatialTree.DestroyProxy(it->second.Node);
+				it = mSpatialProxies.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		return visibilityCount;
+	}
+
+	void Scene::SubmitMeshes(Ref<SceneRenderer> renderer, bool useRigidBodyTransforms)
+	{
+		NR_PROFILE_FUNC();
+
+		mBoneEntityPoses.clear();
+		const uint32_t visibilityCount = GatherMeshes(useRigidBodyTransforms, true);
+
+		// Coarse culling of whole entities through the spatial index
+		{
+			NR_PROFILE_FUNC("Scene-QueryVisibleMeshes");
+
+			auto markVisible = [this](const Frustum& frustum, MeshVisibility visibility)
+			{
+				mSpatialTree.Query(frustum, [this, visibility](uint32_t userData)
+					{
+						mSpatialProxies.at((entt::entity)userData).Visibility |= (uint8_t)visibility;
+						return true;
+					});
+			};
+
+			markVisible(renderer->GetCameraFrustum(), MeshVisibility::Camera);
+			if (const Frustum* cascadeFrustums = renderer->GetShadowCascadeFrustums())
+			{
+				for (uint32_t i = 0; i < 4; ++i)
+					markVisible(cascadeFrustums[i], MeshVisibility::Shadow);
+			}
+		}
+
+		// Per-submesh culling and submission of the surviving entities fan out over the worker pool.
+		// Every chunk covers a contiguous range of both cull lists and records into its own submission buffer,
+		// FlushDrawList merges those in chunk order so the draw lists come out the same as a serial pass.
+		// GetSubmeshVisibility only reads state set up by BeginScene.
+		{
+			NR_PROFILE_FUNC("Scene-CullAndSubmitMeshes");
+
+			mSubmeshVisibility.resize(visibilityCount);
+			SceneRenderer* sceneRenderer = renderer.Raw();
+
+			const uint32_t chunkCount = JobSystem::GetWorkerCount() + 1;
+			sceneRenderer->ReserveSubmissionBuffers(chunkCount + 1);
+
+			JobSystem::ParallelFor(chunkCount, [&](uint32_t chunk)
+				{
+					SceneRenderer::SetThreadSubmissionBuffer(chunk + 1);
+
+					const size_t staticBegin = mStaticMeshCullList.size() * chunk / chunkCount;
+					const size_t staticEnd = mStaticMeshCullList.size() * (chunk + 1) / chunkCount;
+					for (size_t itemIndex = staticBegin; itemIndex < staticEnd; ++itemIndex)
+					{
+						StaticMeshCullItem& item = mStaticMeshCullList[itemIndex];
+
+						const auto& submeshData = item.Source->GetSubmeshes();
+						const auto& submeshes = item.StaticMesh.Raw()->GetSubmeshes();
+						uint8_t* submeshVisibility = mSubmeshVisibility.data() + item.VisibilityOffset;
+						for (size_t i = 0; i < submeshes.size(); ++i)
+						{
+							if (item.Proxy->Visibility == (uint8_t)MeshVisibility::None)
+							{
+								submeshVisibility[i] = (uint8_t)MeshVisibility::None;
+								continue;
+							}
+
+							const Submesh& submesh = submeshData[submeshes[i]];
+							submeshVisibility[i] = item.Proxy->Visibility & sceneRenderer->GetSubmeshVisibility(submesh.BoundingBox, item.Transform * submesh.Transform);
+						}
+
+						auto& staticMeshComponent = mRegistry.get<StaticMeshComponent>(item.Entity);
+						if (mSelectedEntity == item.Entity)
+							sceneRenderer->SubmitSelectedStaticMesh(std::move(item.StaticMesh), staticMeshComponent.Materials, item.Transform, nullptr, submeshVisibility);
+						else
+							sceneRenderer->SubmitStaticMesh(std::move(item.StaticMesh), staticMeshComponent.Materials, item.Transform, nullptr, submeshVisibility);
+					}
+
+					const size_t meshBegin = mMeshCullList.size() * chunk / chunkCount;
+					const size_t meshEnd = mMeshCullList.size() * (chunk + 1) / chunkCount;
+					for (size_t itemIndex = meshBegin; itemIndex < meshEnd; ++itemIndex)
+					{
+						MeshCullItem& item = mMeshCullList[itemIndex];
+
+						// Skinning moves vertices outside of the bind pose bounds
+						if (!item.Source->IsRigged())
+						{
+							if (item.Proxy->Visibility == (uint8_t)MeshVisibility::None)
+							{
+								item.Visibility = (uint8_t)MeshVisibility::None;
+							}
+							else
+							{
+								const Submesh& submesh = item.Source->GetSubmeshes()[item.SubmeshIndex];
+								item.Visibility = item.Proxy->Visibility & sceneRenderer->GetSubmeshVisibility(submesh.BoundingBox, item.Transform);
+							}
+						}
+
+						auto& meshComponent = mRegistry.get<MeshComponent>(item.Entity);
+
+						static const ozz::vector<ozz::math::Float4x4> NoBoneTransforms;
+						const ozz::vector<ozz::math::Float4x4>& boneTransforms = item.BoneTransforms ? *item.BoneTransforms : NoBoneTransforms;
+						if (mSelectedEntity == item.Entity)
+							sceneRenderer->SubmitSelectedMesh(std::move(item.Mesh), item.SubmeshIndex, meshComponent.Materials, item.Transform, boneTransforms, nullptr, item.Visibility);
+						else
+							sceneRenderer->SubmitMesh(std::move(item.Mesh), item.SubmeshIndex, meshComponent.Materials, item.Transform, boneTransforms, nullptr, item.Visibility);
+					}
+
+					SceneRenderer::SetThreadSubmissionBuffer(0);
+				}, 1, "Scene-SubmitMeshChunk");
+		}
+
+		// Don't keep the assets alive until next frame
+		mStaticMeshCullList.clear();
+		mMeshCullList.clear();
+	}
+
 	void Scene::RenderPhysicsDebug(Ref<SceneRenderer> renderer, bool runtime)
 	{
 		{
@@ -1528,6 +1711,39 @@ namespace NR
 	{
 	}
 
+	void Scene::TransformComponentConstruct(entt::registry& registry, entt::entity entity)
+	{
+		registry.emplace_or_replace<WorldTransformComponent>(entity);
+		mDirtyTransforms.push_back(entity);
+	}
+
+	void Scene::TransformComponentUpdate(entt::registry& registry, entt::entity entity)
+	{
+		MarkTransformDirty(entity);
+	}
+
+	const ozz::vector<ozz::math::Float4x4>* Scene::GetAnimatedBoneTransforms(const std::vector<UUID>& boneEntityIds, const MeshSource* meshSource) const
+	{
+		if (boneEntityIds.empty())
+			return nullptr;
+
+		auto it = mAnimatedSkeletons.find(boneEntityIds[0]);
+		if (it == mAnimatedSkeletons.end())
+			return nullptr;
+
+		const auto* anim = mRegistry.try_get<AnimationComponent>(it->second);
+		const AnimationInstance* animationInstance = anim ? anim->Instance.Get() : nullptr;
+		if (!animationInstance || !animationInstance->GetController())
+			return nullptr;
+
+		// Both lists are found by joint name, so if they match the joints are in the same order in both skeletons
+		const ozz::vector<ozz::math::Float4x4>& modelSpaceTransforms = animationInstance->GetModelSpaceTransforms();
+		if (anim->BoneEntityIds != boneEntityIds || modelSpaceTransforms.size() != (size_t)meshSource->GetSkeleton()->num_joints())
+			return nullptr;
+
+		return &modelSpaceTransforms;
+	}
+
 	ozz::vector<ozz::math::Float4x4> Scene::GetModelSpaceBoneTransforms(const std::vector<UUID>& boneEntityIds, Ref<Mesh> mesh)
 	{
 		ozz::vector<ozz::math::Float4x4> boneTransforms(boneEntityIds.size());   // Note (0x):  performance? can we avoid constructing this every frame, every mesh?
@@ -1602,85 +1818,187 @@ namespace NR
 
 	void Scene::UpdateAnimation(float dt, bool isRuntime)
 	{
+		NR_PROFILE_FUNC();
+
+		// Instances come out of a shared pool and controllers from the asset manager, so those are looked up here
+		mAnimationUpdateList.clear();
+		mAnimatedSkeletons.clear();
+		mUnsyncedBoneEntities.clear();
+
 		auto view = GetAllEntitiesWith<AnimationComponent>();
 		for (auto entity : view)
 		{
-			Entity e = { entity, this };
+			auto& anim = view.get<AnimationComponent>(entity);
+			if (!AssetManager::IsAssetHandleValid(anim.AnimationController))
+			{
+				continue;
+			}
 
-			auto& anim = e.GetComponent<AnimationComponent>();
-			if (AssetManager::IsAssetHandleValid(anim.AnimationController))
+			auto animationController = AssetManager::GetAsset<AnimationController>(anim.AnimationController);
+			AnimationInstance* animationInstance = anim.Instance.Acquire(animationController, anim.AnimationTime);
+			if (!animationInstance)
+			{
+				continue;
+			}
+
+			mAnimationUpdateList.push_back({ entity, animationInstance });
+			if (!anim.BoneEntityIds.empty())
 			{
-				auto animationController = AssetManager::GetAsset<AnimationController>(anim.AnimationController);
+				mAnimatedSkeletons[anim.BoneEntityIds[0]] = entity;
+			}
+		}
 
-				animationController->SetAnimationPlaying(anim.EnableAnimation);
-				animationController->SetAnimationTime(anim.AnimationTime);
+		// Sampling and building the model space pose only touch the instance, and are most of the cost
+		JobSystem::ParallelFor((uint32_t)mAnimationUpdateList.size(), [&](uint32_t index)
+			{
+				const AnimationUpdateItem& item = mAnimationUpdateList[index];
+				const auto& anim = mRegistry.get<AnimationComponent>(item.Entity);
+				item.Instance->Update(dt, anim.EnableAnimation, anim.EnableRootMotion);
+			}, 4, "Scene-UpdateAnimation");
 
-				auto& rootMotion = animationController->Update(dt, anim.EnableRootMotion);
-				anim.AnimationTime = animationController->GetAnimationTime();
+		for (const AnimationUpdateItem& item : mAnimationUpdateList)
+		{
+			Entity e = { item.Entity, this };
 
-				for (size_t i = 0; i < anim.BoneEntityIds.size(); ++i)
+			auto& anim = e.GetComponent<AnimationComponent>();
+			AnimationInstance* animationInstance = item.Instance;
+			const RootMotion& rootMotion = animationInstance->GetRootMotion();
+
+			// Meshes are skinned from the instance's pose (see SubmitMeshes), the bone entities only need it if something reads them.
+			// The editor always shows it on them.
+			if (!isRuntime || anim.SyncBoneEntities)
+			{
+				WriteBoneEntityTransforms(anim, *animationInstance);
+			}
+			else
+			{
+				const size_t boneCount = std::min(anim.BoneEntityIds.size(), animationInstance->GetNumJoints());
+				for (size_t i = 0; i < boneCount; ++i)
 				{
-					auto boneTransformEntity = FindEntityByID(anim.BoneEntityIds[i]);
-					if (boneTransformEntity)
-					{
-						// Note: we're assuming there is always a transform component
-						auto& transform = boneTransformEntity.GetComponent<TransformComponent>();
-						transform.Translation = animationController->GetTranslation(i);
-						transform.Rotation = glm::eulerAngles(animationController->GetRotation(i));
-						transform.Scale = animationController->GetScale(i);
-					}
+					mUnsyncedBoneEntities[anim.BoneEntityIds[i]] = item.Entity;
 				}
+			}
 
-				if (/*isRuntime &&*/ anim.EnableRootMotion)
+			if (/*isRuntime &&*/ anim.EnableRootMotion)
+			{
+				auto rootMotionEntity = FindEntityByID(anim.RootMotionTarget);
+				if (rootMotionEntity)
 				{
-					auto rootMotionEntity = FindEntityByID(anim.RootMotionTarget);
-					if (rootMotionEntity)
-					{
-						auto parentEntity = rootMotionEntity.GetParent();
-						glm::mat3 modelToWorld = GetWorldSpaceTransformMatrix(e); // glm::mat3 because don't need translation here
-						glm::mat3 worldToTarget = parentEntity ? glm::inverse(glm::mat3{ GetWorldSpaceTransformMatrix(parentEntity) }) : glm::mat3(1.0f);
+					auto parentEntity = rootMotionEntity.GetParent();
+					glm::mat3 modelToWorld = GetWorldSpaceTransformMatrix(e); // glm::mat3 because don't need translation here
+					glm::mat3 worldToTarget = parentEntity ? glm::inverse(glm::mat3{ GetWorldSpaceTransformMatrix(parentEntity) }) : glm::mat3(1.0f);
 
-						// Figure out how to apply the root motion, depending on what components the target entity has
-						auto& transform = rootMotionEntity.Transform();
-						if (mShouldSimulate && rootMotionEntity.HasComponent<CharacterControllerComponent>())
-						{
-							// 1. target entity is a physics character controller
-							//    => apply root motion to character pose
-							Ref<PhysicsController> controller = GetPhysicsScene()->GetController(rootMotionEntity);
-							NR_CORE_ASSERT(controller);
-							{
-								// note: translation is applied to the physics controller
-								//       rotation (which cannot be applied to the physics controller) is applied directly to the target entity's transform
-								glm::vec3 displacement = worldToTarget * modelToWorld * rootMotion.Translation;
-								controller->Move(displacement);
-								transform.Rotation = glm::eulerAngles(glm::quat(transform.Rotation) * rootMotion.Rotation);
-							}
-						}
-						else if (mShouldSimulate && rootMotionEntity.HasComponent<RigidBodyComponent>())
+					// Figure out how to apply the root motion, depending on what components the target entity has
+					auto& transform = rootMotionEntity.Transform();
+					if (mShouldSimulate && rootMotionEntity.HasComponent<CharacterControllerComponent>())
+					{
+						// 1. target entity is a physics character controller
+						//    => apply root motion to character pose
+						Ref<PhysicsController> controller = GetPhysicsScene()->GetController(rootMotionEntity);
+						NR_CORE_ASSERT(controller);
 						{
-							// 2. target entity is a physics rigid body.
-							//    => apply root motion as kinematic target  (or do nothing if it isnt a kinematic rigidbody. We do not support attempting to convert root motion into physics impulses)
-							//
-							const Ref<PhysicsActor>& actor = GetPhysicsScene()->GetActor(rootMotionEntity);
-							NR_CORE_ASSERT(actor);
-							if (actor->IsKinematic())
-							{
-								glm::vec3 position = transform.Translation + worldToTarget * modelToWorld * rootMotion.Translation;
-								glm::vec3 rotation = glm::eulerAngles(glm::quat(transform.Rotation) * rootMotion.Rotation);
-								actor->SetKinematicTarget(position, rotation);
-							}
+							// note: translation is applied to the physics controller
+							//       rotation (which cannot be applied to the physics controller) is applied directly to the target entity's transform
+							glm::vec3 displacement = worldToTarget * modelToWorld * rootMotion.Translation;
+							controller->Move(displacement);
+							transform.Rotation = glm::eulerAngles(glm::quat(transform.Rotation) * rootMotion.Rotation);
+							rootMotionEntity.MarkTransformDirty();
 						}
-						else
+					}
+					else if (mShouldSimulate && rootMotionEntity.HasComponent<RigidBodyComponent>())
+					{
+						// 2. target entity is a physics rigid body.
+						//    => apply root motion as kinematic target  (or do nothing if it isnt a kinematic rigidbody. We do not support attempting to convert root motion into physics impulses)
+						//
+						const Ref<PhysicsActor>& actor = GetPhysicsScene()->GetActor(rootMotionEntity);
+						NR_CORE_ASSERT(actor);
+						if (actor->IsKinematic())
 						{
-							// 3. either we aren't simulating physics, or the target entity is not a physics body
-							//    => apply root motion directly to the target entity's transform
-							transform.Translation += worldToTarget * modelToWorld * rootMotion.Translation;
-							transform.Rotation = glm::eulerAngles(glm::quat(transform.Rotation) * rootMotion.Rotation);
+							glm::vec3 position = transform.Translation + worldToTarget * modelToWorld * rootMotion.Translation;
+							glm::vec3 rotation = glm::eulerAngles(glm::quat(transform.Rotation) * rootMotion.Rotation);
+							actor->SetKinematicTarget(position, rotation);
 						}
 					}
+					else
+					{
+						// 3. either we aren't simulating physics, or the target entity is not a physics body
+						//    => apply root motion directly to the target entity's transform
+						transform.Translation += worldToTarget * modelToWorld * rootMotion.Translation;
+						transform.Rotation = glm::eulerAngles(glm::quat(transform.Rotation) * rootMotion.Rotation);
+						rootMotionEntity.MarkTransformDirty();
+					}
 				}
 			}
 		}
+
+		if (!isRuntime)
+			return;
+
+		// Things attached to a bone follow it through the entity hierarchy, so those skeletons are written right away
+		for (const AnimationUpdateItem& item : mAnimationUpdateList)
+		{
+			const auto& anim = mRegistry.get<AnimationComponent>(item.Entity);
+			if (!anim.SyncBoneEntities && !anim.BoneEntityIds.empty() && HasBoneAttachments(anim))
+				SyncBoneEntity(anim.BoneEntityIds[0]);
+		}
+	}
+
+	void Scene::SyncBoneEntity(UUID boneEntityId)
+	{
+		auto it = mUnsyncedBoneEntities.find(boneEntityId);
+		if (it == mUnsyncedBoneEntities.end())
+			return;
+
+		const entt::entity animatedEntity = it->second;
+		const auto* anim = mRegistry.valid(animatedEntity) ? mRegistry.try_get<AnimationComponent>(animatedEntity) : nullptr;
+		if (!anim)
+		{
+			mUnsyncedBoneEntities.erase(it);
+			return;
+		}
+
+		if (const AnimationInstance* animationInstance = anim->Instance.Get())
+			WriteBoneEntityTransforms(*anim, *animationInstance);
+
+		for (UUID id : anim->BoneEntityIds)
+			mUnsyncedBoneEntities.erase(id);
+	}
+
+	void Scene::WriteBoneEntityTransforms(const AnimationComponent& anim, const AnimationInstance& animationInstance)
+	{
+		const size_t boneCount = std::min(anim.BoneEntityIds.size(), animationInstance.GetNumJoints());
+		for (size_t i = 0; i < boneCount; ++i)
+		{
+			auto boneTransformEntity = FindEntityByID(anim.BoneEntityIds[i]);
+			if (boneTransformEntity)
+			{
+				// Note: we're assuming there is always a transform component
+				auto& transform = boneTransformEntity.GetComponent<TransformComponent>();
+				transform.Translation = animationInstance.GetTranslation(i);
+				transform.Rotation = glm::eulerAngles(animationInstance.GetRotation(i));
+				transform.Scale = animationInstance.GetScale(i);
+				boneTransformEntity.MarkTransformDirty();
+			}
+		}
+	}
+
+	bool Scene::HasBoneAttachments(const AnimationComponent& anim)
+	{
+		// Children of a bone that aren't bones of an animated skeleton themselves are attachments
+		for (UUID boneEntityId : anim.BoneEntityIds)
+		{
+			Entity boneEntity = FindEntityByID(boneEntityId);
+			if (!boneEntity || !boneEntity.HasComponent<RelationshipComponent>())
+				continue;
+
+			for (UUID child : boneEntity.Children())
+			{
+				if (mUnsyncedBoneEntities.find(child) == mUnsyncedBoneEntities.end())
+					return true;
+			}
+		}
+
+		return false;
 	}
 
 	void Scene::SetViewportSize(uint32_t width, uint32_t height)
@@ -1731,10 +2049,12 @@ namespace NR
 
 		entity.AddComponent<RelationshipComponent>();
 
+		NR_CORE_ASSERT(mEntityIDMap.find(idComponent.ID) == mEntityIDMap.end());
+		mEntityIDMap[idComponent.ID] = entity;
+
 		if (parent)
 			entity.SetParent(parent);
 
-		mEntityIDMap[idComponent.ID] = entity;
 		return entity;
 	}
 
@@ -1766,8 +2086,6 @@ namespace NR
 	{
 		NR_PROFILE_FUNC();
 
-		auto physicsWorld = GetPhysicsScene();
-
 		if (entity.HasComponent<ScriptComponent>())
 			ScriptEngine::ScriptComponentDestroyed(mSceneID, entity.GetID());
 
@@ -1777,7 +2095,10 @@ namespace NR
 		if (!mIsEditorScene)
 		{
 			if (entity.HasComponent<RigidBodyComponent>())
+			{
+				auto physicsWorld = GetPhysicsScene();
 				physicsWorld->RemoveActor(physicsWorld->GetActor(entity));
+			}
 
 			if (entity.HasComponent<RigidBody2DComponent>())
 			{
@@ -1807,6 +2128,7 @@ namespace NR
 				entity.GetParent().RemoveChild(entity);
 		}
 
+		mEntityIDMap.erase(entity.GetID());
 		mRegistry.destroy(entity.mEntityHandle);
 	}
 
@@ -1822,6 +2144,7 @@ namespace NR
 				if (submeshes.size() > mc.SubmeshIndex)
 				{
 					entity.Transform().SetTransform(submeshes[mc.SubmeshIndex].LocalTransform);
+					entity.MarkTransformDirty();
 				}
 			}
 		}
@@ -2023,6 +2346,7 @@ namespace NR
 		{
 			newEntity.Transform().Scale = *scale;
 		}
+		newEntity.MarkTransformDirty();
 
 		// This debug checking is not guaranteed to work - because the same type could have different type_id in different registries.
 #if _DEBUG && 0
@@ -2093,44 +2417,41 @@ namespace NR
 		return result;
 	}
 
-	void Scene::BuildMeshEntityHierarchy(Entity parent, Ref<Mesh> mesh, const void* assimpScene, void* assimpNode)
+	void Scene::BuildMeshEntityHierarchy(Entity parent, Ref<Mesh> mesh, const MeshNode& node)
 	{
-		aiScene* aScene = (aiScene*)assimpScene;
-		aiNode* node = (aiNode*)assimpNode;
+		Ref<MeshSource> meshSource = mesh->GetMeshSource();
+		const auto& nodes = meshSource->GetNodes();
 
 		// Skip empty root node
-		if (node == aScene->mRootNode && node->mNumMeshes == 0)
+		if (node.IsRoot() && node.Submeshes.empty())
 		{
-			for (uint32_t i = 0; i < node->mNumChildren; i++)
+			for (uint32_t child : node.Children)
 			{
-				BuildMeshEntityHierarchy(parent, mesh, assimpScene, node->mChildren[i]);
+				BuildMeshEntityHierarchy(parent, mesh, nodes[child]);
 			}
 
 			return;
 		}
 
-		glm::mat4 transform = Utils::Mat4FromAIMatrix4x4(node->mTransformation);
-		auto nodeName = node->mName.C_Str();
+		Entity nodeEntity = CreateChildEntity(parent, node.Name);
+		nodeEntity.Transform().SetTransform(node.LocalTransform);
+		nodeEntity.MarkTransformDirty();
 
-		Entity nodeEntity = CreateChildEntity(parent, nodeName);
-		nodeEntity.Transform().SetTransform(transform);
-
-		if (node->mNumMeshes == 1)
+		if (node.Submeshes.size() == 1)
 		{
 			// Node == Mesh in this case
-			uint32_t submeshIndex = node->mMeshes[0];
+			uint32_t submeshIndex = node.Submeshes[0];
 			auto& mc = nodeEntity.AddComponent<MeshComponent>(mesh->Handle, submeshIndex);
 
 			nodeEntity.AddComponent<MeshColliderComponent>(mesh->Handle, submeshIndex);
 			nodeEntity.AddComponent<RigidBodyComponent>();
 		}
-		else if (node->mNumMeshes > 1)
+		else if (node.Submeshes.size() > 1)
 		{
 			// Create one entity per child mesh, parented under node
-			for (uint32_t i = 0; i < node->mNumMeshes; i++)
+			for (uint32_t submeshIndex : node.Submeshes)
 			{
-				uint32_t submeshIndex = node->mMeshes[i];
-				auto meshName = aScene->mMeshes[submeshIndex]->mName.C_Str();
+				const auto& meshName = meshSource->GetSubmeshes()[submeshIndex].MeshName;
 
 				Entity childEntity = CreateChildEntity(nodeEntity, meshName);
 
@@ -2142,9 +2463,9 @@ namespace NR
 
 		}
 
-		for (uint32_t i = 0; i < node->mNumChildren; i++)
+		for (uint32_t child : node.Children)
 		{
-			BuildMeshEntityHierarchy(nodeEntity, mesh, assimpScene, node->mChildren[i]);
+			BuildMeshEntityHierarchy(nodeEntity, mesh, nodes[child]);
 		}
 	}
 
@@ -2152,8 +2473,7 @@ namespace NR
 	{
 		auto& assetData = AssetManager::GetMetadata(mesh->Handle);
 		Entity rootEntity = CreateEntity(assetData.FilePath.stem().string());
-		auto aScene = mesh->GetMeshSource()->mScene;
-		BuildMeshEntityHierarchy(rootEntity, mesh, aScene, aScene->mRootNode);
+		BuildMeshEntityHierarchy(rootEntity, mesh, mesh->GetMeshSource()->GetRootNode());
 		BuildMeshBoneEntityIds(rootEntity, rootEntity);
 		return rootEntity;
 	}
@@ -2249,17 +2569,16 @@ namespace NR
 
 	Entity Scene::FindEntityByID(UUID id)
 	{
-		NR_PROFILE_FUNC();
-
-		auto view = mRegistry.view<IDComponent>();
-		for (auto entity : view)
+		// mEntityIDMap is kept in sync by CreateEntity/CreateEntityWithID/DestroyEntity,
+		// so this is a single hash lookup instead of a walk over every IDComponent
+		auto it = mEntityIDMap.find(id);
+		if (it == mEntityIDMap.end())
 		{
-			auto& idComponent = mRegistry.get<IDComponent>(entity);
-			if (idComponent.ID == id)
-				return Entity(entity, this);
+			return Entity{};
 		}
 
-		return Entity{};
+		NR_CORE_ASSERT(mRegistry.valid(it->second.mEntityHandle), "Entity ID map is out of sync with the registry!");
+		return it->second;
 	}
 
 	void Scene::ConvertToLocalSpace(Entity entity)
@@ -2277,6 +2596,7 @@ namespace NR
 		glm::mat4 parentTransform = GetWorldSpaceTransformMatrix(parent);
 		glm::mat4 localTransform = glm::inverse(parentTransform) * transform.GetTransform();
 		Math::DecomposeTransform(localTransform, transform.Translation, transform.Rotation, transform.Scale);
+		entity.MarkTransformDirty();
 	}
 
 	void Scene::ConvertToWorldSpace(Entity entity)
@@ -2293,12 +2613,18 @@ namespace NR
 		glm::mat4 transform = GetWorldSpaceTransformMatrix(entity);
 		auto& entityTransform = entity.Transform();
 		Math::DecomposeTransform(transform, entityTransform.Translation, entityTransform.Rotation, entityTransform.Scale);
+		entity.MarkTransformDirty();
 	}
 
 	glm::mat4 Scene::GetWorldSpaceTransformMatrix(Entity entity)
 	{
 		NR_PROFILE_FUNC();
 
+		if (auto* worldTransform = mRegistry.try_get<WorldTransformComponent>(entity))
+		{
+			return ResolveWorldTransform(entity, *worldTransform);
+		}
+
 		glm::mat4 transform(1.0f);
 
 		Entity parent = FindEntityByID(entity.GetParentID());
@@ -2310,7 +2636,6 @@ namespace NR
 		return transform * entity.Transform().GetTransform();
 	}
 
-	// TODO: Definitely cache this at some point
 	TransformComponent Scene::GetWorldSpaceTransform(Entity entity)
 	{
 		NR_PROFILE_FUNC();
@@ -2322,6 +2647,105 @@ namespace NR
 		return transformComponent;
 	}
 
+	void Scene::UpdateWorldTransforms()
+	{
+		NR_PROFILE_FUNC();
+
+		for (entt::entity entity : mDirtyTransforms)
+		{
+			if (!mRegistry.valid(entity))
+			{
+				continue;
+			}
+
+			if (auto* worldTransform = mRegistry.try_get<WorldTransformComponent>(entity); worldTransform && worldTransform->Dirty)
+			{
+				ResolveWorldTransform(entity, *worldTransform);
+			}
+		}
+
+		mDirtyTransforms.clear();
+	}
+
+	const glm::mat4& Scene::ResolveWorldTransform(entt::entity entity, WorldTransformComponent& worldTransform)
+	{
+		if (!worldTransform.Dirty)
+		{
+			return worldTransform.Transform;
+		}
+
+		// Descendants of a dirty entity are dirty as well, so walk up to the closest clean ancestor
+		// and rebuild everything below it on the way back down
+		mWorldTransformStack.clear();
+		glm::mat4 parentTransform(1.0f);
+		for (entt::entity current = entity; current != entt::null;)
+		{
+			mWorldTransformStack.push_back(current);
+
+			const auto* relationship = mRegistry.try_get<RelationshipComponent>(current);
+			auto parentIt = relationship ? mEntityIDMap.find(relationship->ParentHandle) : mEntityIDMap.end();
+			current = entt::null;
+			if (parentIt != mEntityIDMap.end())
+			{
+				const entt::entity parent = parentIt->second;
+				if (auto* parentWorldTransform = mRegistry.try_get<WorldTransformComponent>(parent))
+				{
+					if (parentWorldTransform->Dirty)
+					{
+						current = parent;
+					}
+					else
+					{
+						parentTransform = parentWorldTransform->Transform;
+					}
+				}
+			}
+		}
+
+		for (auto it = mWorldTransformStack.rbegin(); it != mWorldTransformStack.rend(); ++it)
+		{
+			auto& current = mRegistry.get<WorldTransformComponent>(*it);
+			current.Transform = parentTransform * mRegistry.get<TransformComponent>(*it).GetTransform();
+			current.Dirty = false;
+			parentTransform = current.Transform;
+		}
+
+		return worldTransform.Transform;
+	}
+
+	void Scene::MarkTransformDirty(entt::entity entity)
+	{
+		// The walk stops at entities that are dirty already, their descendants have been marked with them
+		mWorldTransformStack.clear();
+		mWorldTransformStack.push_back(entity);
+		while (!mWorldTransformStack.empty())
+		{
+			const entt::entity current = mWorldTransformStack.back();
+			mWorldTransformStack.pop_back();
+
+			auto* worldTransform = mRegistry.try_get<WorldTransformComponent>(current);
+			if (!worldTransform || worldTransform->Dirty)
+			{
+				continue;
+			}
+
+			worldTransform->Dirty = true;
+			mDirtyTransforms.push_back(current);
+
+			if (const auto* relationship = mRegistry.try_get<RelationshipComponent>(current))
+			{
+				for (UUID childID : relationship->Children)
+				{
+					auto it = mEntityIDMap.find(childID);
+					if (it != mEntityIDMap.end())
+					{
+						mWorldTransformStack.push_back(it->second);
+					}
+				}
+			}
+		}
+	}
+
 	void Scene::ParentEntity(Entity entity, Entity parent)
 	{
 		NR_PROFILE_FUNC();
@@ -2379,6 +2803,9 @@ namespace NR
 	{
 		NR_PROFILE_FUNC();
 
+		// The copied material tables wouldn't get the materials that are still streaming in
+		AssetManager::FinishPendingLoads();
+
 		// Environment
 		target->mLight = mLight;
 		target->mLightMultiplier = mLightMultiplier;
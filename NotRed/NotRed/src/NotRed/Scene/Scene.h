@@ -1,5 +1,8 @@
 #pragma once
 
+#include <map>
+#include <unordered_set>
+
 #include "NotRed/Core/UUID.h"
 
 #include "NotRed/Renderer/Camera.h"
@@ -9,6 +12,8 @@
 #include "NotRed/Renderer/RenderCommandBuffer.h"
 #include "NotRed/Renderer/Renderer2D.h"
 
+#include "NotRed/Math/AABBTree.h"
+
 #include "entt/include/entt.hpp"
 
 #include "SceneCamera.h"
@@ -18,6 +23,12 @@ namespace NR
 {
 	class SceneRenderer;
 	class Prefab;
+	class Mesh;
+	class StaticMesh;
+	class MeshSource;
+	struct MeshNode;
+	class AnimationInstance;
+	struct WorldTransformComponent;
 
 	struct DirLight
 	{
@@ -61,6 +72,7 @@ namespace NR
 	using EntityMap = std::unordered_map<UUID, Entity>;
 
 	struct TransformComponent;
+	struct AnimationComponent;
 
 	class PhysicsScene;
 
@@ -136,6 +148,25 @@ namespace NR
 		glm::mat4 GetWorldSpaceTransformMatrix(Entity entity);
 		TransformComponent GetWorldSpaceTransform(Entity entity);
 
+		// Rebuilds WorldTransformComponent for every entity marked dirty since the last update. GetWorldSpaceTransformMatrix
+		// rebuilds the ones it reads in between, so the cache is valid at any point of the frame.
+		void UpdateWorldTransforms();
+		// Has to be called after writing an entity's TransformComponent in place, marks it and its descendants.
+		// Adding or replacing the component through the registry and changing the parent do this already.
+		void MarkTransformDirty(entt::entity entity);
+
+		// Transform meshes are drawn with. At runtime rigid bodies use their simulated pose, or the interpolated one between physics steps,
+		// and the entities parented to a body are drawn relative to it.
+		glm::mat4 GetRenderTransformMatrix(Entity entity, bool useRigidBodyTransforms);
+
+		// Refits the spatial index to the current mesh entities, done by the scene's update and again when it's rendered
+		void UpdateSpatialIndex(bool useRigidBodyTransforms);
+
+		// Queries against the bounds of mesh entities, see UpdateSpatialIndex
+		void QueryEntities(const AABB& aabb, std::vector<Entity>& outEntities);
+		void QueryEntities(const Frustum& frustum, std::vector<Entity>& outEntities);
+		void RaycastEntities(const Ray& ray, std::vector<Entity>& outEntities);
+
 		void ParentEntity(Entity entity, Entity parent);
 		void UnparentEntity(Entity entity, bool convertToWorldSpace = true);
 
@@ -168,6 +199,10 @@ namespace NR
 
 		void SetSceneTransitionCallback(const std::function<void(const std::string&)>& callback) { mSceneTransitionCallback = callback; }
 
+		// At runtime bone entities are only written when something needs them (AnimationComponent::SyncBoneEntities).
+		// Writes the pose of the skeleton this bone belongs to into its bone entities, call it before reading a bone's transform.
+		void SyncBoneEntity(UUID boneEntityId);
+
 	public:
 		static Ref<Scene> CreateEmpty();
 
@@ -178,8 +213,10 @@ namespace NR
 		void AudioComponentDestroy(entt::registry& registry, entt::entity entity);
 		void MeshColliderComponentConstruct(entt::registry& registry, entt::entity entity);
 		void MeshColliderComponentDestroy(entt::registry& registry, entt::entity entity);
+		void TransformComponentConstruct(entt::registry& registry, entt::entity entity);
+		void TransformComponentUpdate(entt::registry& registry, entt::entity entity);
 
-		void BuildMeshEntityHierarchy(Entity parent, Ref<Mesh> mesh, const void* assimpScene, void* assimpNode);
+		void BuildMeshEntityHierarchy(Entity parent, Ref<Mesh> mesh, const MeshNode& node);
 		void BuildMeshBoneEntityIds(Entity root, Entity entity);
 
 		template<typename Fn>
@@ -188,8 +225,13 @@ namespace NR
 			mPostUpdateQueue.emplace_back(func);
 		}
 
+		// Pose of the animation playing on the skeleton these bones belong to, nullptr if there is none or it's a different skeleton
+		const ozz::vector<ozz::math::Float4x4>* GetAnimatedBoneTransforms(const std::vector<UUID>& boneEntityIds, const MeshSource* meshSource) const;
 		ozz::vector<ozz::math::Float4x4> GetModelSpaceBoneTransforms(const std::vector<UUID>& boneEntityIds, Ref<Mesh> mesh);
 
+		// Culls and submits every StaticMeshComponent and MeshComponent, must be called between BeginScene and EndScene
+		void SubmitMeshes(Ref<SceneRenderer> renderer, bool useRigidBodyTransforms);
+
 		void UpdateAnimation(float dt, bool isRuntime);
 
 	private:
@@ -205,6 +247,79 @@ namespace NR
 
 		EntityMap mEntityIDMap;
 
+		const glm::mat4& ResolveWorldTransform(entt::entity entity, WorldTransformComponent& worldTransform);
+
+		// Entities marked since the last UpdateWorldTransforms, some might have been rebuilt or destroyed since
+		std::vector<entt::entity> mDirtyTransforms;
+		std::vector<entt::entity> mWorldTransformStack;
+
+		// Spatial index over mesh entity bounds, keyed by entity
+		struct SpatialProxy
+		{
+			int32_t Node = AABBTree::NullNode;
+			glm::mat4 Transform;
+			// The bounds change with the mesh itself as well, e.g. once it replaced its placeholder
+			const Asset* Mesh = nullptr;
+			uint32_t LastUpdate = 0;
+			uint8_t Visibility = 0;
+		};
+		// Refits the spatial index, SubmitMeshes also has it fill the cull lists. Returns the number of static submeshes.
+		uint32_t GatherMeshes(bool useRigidBodyTransforms, bool fillCullLists);
+		template<typename BoundsFn>
+		const SpatialProxy* UpdateSpatialProxy(entt::entity entity, const Asset* mesh, const glm::mat4& transform, BoundsFn&& calculateBounds);
+
+		AABBTree mSpatialTree;
+		std::unordered_map<entt::entity, SpatialProxy> mSpatialProxies;
+		uint32_t mSpatialUpdateIndex = 0;
+
+		// Scratch lists for SubmitMeshes, kept around to avoid reallocating every frame
+		struct StaticMeshCullItem
+		{
+			entt::entity Entity;
+			Ref<StaticMesh> StaticMesh;
+			const MeshSource* Source;
+			glm::mat4 Transform;
+			uint32_t VisibilityOffset;
+			const SpatialProxy* Proxy;
+		};
+		struct MeshCullItem
+		{
+			entt::entity Entity;
+			Ref<Mesh> Mesh;
+			const MeshSource* Source;
+			uint32_t SubmeshIndex;
+			glm::mat4 Transform;
+			uint8_t Visibility;
+			const SpatialProxy* Proxy;
+			const ozz::vector<ozz::math::Float4x4>* BoneTransforms;
+		};
+		std::vector<StaticMeshCullItem> mStaticMeshCullList;
+		std::vector<MeshCullItem> mMeshCullList;
+
+		// Poses of the skeletons without an animation, by root bone and mesh source. They live until the next
+		// SubmitMeshes, so every submesh of a skeleton passes the same pose and the renderer shares its palette.
+		std::map<std::pair<uint64_t, const MeshSource*>, ozz::vector<ozz::math::Float4x4>> mBoneEntityPoses;
+		std::vector<uint8_t> mSubmeshVisibility;
+
+		// Scratch list for UpdateAnimation
+		struct AnimationUpdateItem
+		{
+			entt::entity Entity;
+			AnimationInstance* Instance;
+		};
+		std::vector<AnimationUpdateItem> mAnimationUpdateList;
+
+		// Entity with the AnimationComponent posing each skeleton, by the skeleton's root bone entity
+		std::unordered_map<UUID, entt::entity> mAnimatedSkeletons;
+
+		// Entity with the AnimationComponent posing each bone entity the last UpdateAnimation didn't write, see SyncBoneEntity
+		std::unordered_map<UUID, entt::entity> mUnsyncedBoneEntities;
+		// Skeletons whose meshes couldn't be skinned from the animation directly, so the warning is only logged once
+		std::unordered_set<entt::entity> mBoneTransformsFallbackWarnings;
+
+		void WriteBoneEntityTransforms(const AnimationComponent& anim, const AnimationInstance& animationInstance);
+		bool HasBoneAttachments(const AnimationComponent& anim);
+
 		DirLight mLight;
 		float mLightMultiplier = 0.3f;
 
@@ -26,6 +26,26 @@
 
 namespace NR
 {
+	// The slot shows the placeholder material until the material has streamed in, unless something else was assigned meanwhile
+	static void SetMaterialAsync(const Ref<MaterialTable>& materialTable, uint32_t index, AssetHandle materialHandle)
+	{
+		Ref<MaterialAsset> material = AssetManager::GetAssetAsync<MaterialAsset>(materialHandle);
+		materialTable->SetMaterial(index, material);
+		if (!AssetManager::IsPlaceholderAsset(material, materialHandle))
+			return;
+
+		AssetManager::RequestAsset(materialHandle, AssetLoadPriority::Normal, [materialTable, index, material](Ref<Asset> asset)
+			{
+				if (!materialTable->HasMaterial(index) || materialTable->GetMaterial(index) != material)
+					return;
+
+				if (asset)
+					materialTable->SetMaterial(index, asset.As<MaterialAsset>());
+				else
+					materialTable->ClearMaterial(index);
+			});
+	}
+
 	SceneSerializer::SceneSerializer(const Ref<Scene>& scene)
 		: mScene(scene)
 	{
@@ -273,9 +293,10 @@ namespace NR
 				out << YAML::Key << "BoneEntities" << YAML::Value << YAML::Flow << anim.BoneEntityIds;
 			}
 			out << YAML::Key << "EnableAnimation" << YAML::Value << anim.EnableAnimation;
-			out << YAML::Key << "AnimationTime" << YAML::Value << anim.AnimationTime;
+			out << YAML::Key << "AnimationTime" << YAML::Value << (anim.Instance.Get() ? anim.Instance.Get()->GetAnimationTime() : anim.AnimationTime);
 			out << YAML::Key << "EnableRootMotion" << YAML::Value << anim.EnableRootMotion;
 			out << YAML::Key << "RootMotionTarget" << YAML::Value << anim.RootMotionTarget;
+			out << YAML::Key << "SyncBoneEntities" << YAML::Value << anim.SyncBoneEntities;
 
 			out << YAML::EndMap; // AnimationComponent
 		}
@@ -630,6 +651,9 @@ namespace NR
 
 	void SceneSerializer::Serialize(const std::string& filepath)
 	{
+		// Material slots that are still streaming in hold the placeholder until their callback ran
+		AssetManager::FinishPendingLoads();
+
 		auto entities = mScene->GetAllEntitiesWith<AnimationComponent>();
 		for (auto e : entities) 
 		{
@@ -638,6 +662,10 @@ namespace NR
 			if (anim.EnableAnimation)
 			{
 				anim.AnimationTime = 0.0f;
+				if (AnimationInstance* animationInstance = anim.Instance.Get())
+				{
+					animationInstance->SetAnimationTime(0.0f);
+				}
 			}
 		}
 		mScene->UpdateAnimation(0.0f, false);
@@ -837,6 +865,7 @@ namespace NR
 					if (metadata.Type == AssetType::Mesh)
 					{
 						component.MeshHandle = assetHandle;
+						AssetManager::RequestAsset(assetHandle);
 					}
 					else if (metadata.Type == AssetType::MeshSource)
 					{
@@ -865,7 +894,7 @@ namespace NR
 						AssetHandle materialAsset = materialEntry.second.as<AssetHandle>();
 						if (materialAsset && AssetManager::IsAssetHandleValid(materialAsset))
 						{
-							component.Materials->SetMaterial(index, AssetManager::GetAsset<MaterialAsset>(materialAsset));
+							SetMaterialAsync(component.Materials, index, materialAsset);
 						}
 					}
 				}
@@ -913,6 +942,7 @@ namespace NR
 				component.AnimationTime = component.EnableAnimation ? 0.0f : animationComponent["AnimationTime"].as<float>(component.AnimationTime);
 				component.EnableRootMotion = animationComponent["EnableRootMotion"].as<bool>(component.EnableRootMotion);
 				component.RootMotionTarget = animationComponent["RootMotionTarget"].as<uint64_t>(component.RootMotionTarget);
+				component.SyncBoneEntities = animationComponent["SyncBoneEntities"].as<bool>(component.SyncBoneEntities);
 			}
 
 			auto staticMeshComponent = entity["StaticMeshComponent"];
@@ -922,8 +952,8 @@ namespace NR
 				AssetHandle assetHandle = staticMeshComponent["AssetID"].as<uint64_t>();
 				if (AssetManager::IsAssetHandleValid(assetHandle))
 				{
-					const AssetMetadata& metadata = AssetManager::GetMetadata(assetHandle);
 					component.StaticMesh = assetHandle;
+					AssetManager::RequestAsset(assetHandle);
 				}
 
 				if (staticMeshComponent["MaterialTable"])
@@ -935,7 +965,7 @@ namespace NR
 						AssetHandle materialAsset = materialEntry.second.as<AssetHandle>();
 						if (materialAsset && AssetManager::IsAssetHandleValid(materialAsset))
 						{
-							component.Materials->SetMaterial(index, AssetManager::GetAsset<MaterialAsset>(materialAsset));
+							SetMaterialAsync(component.Materials, index, materialAsset);
 						}
 					}
 				}
@@ -31,11 +31,78 @@ namespace NR
 
 	static EntityInstanceMap sEntityInstanceMap;
 
+	// Scene update and the physics callbacks ask for every scripted entity, every frame
+	static std::unordered_map<std::string, bool> sModuleExistsCache;
+
 	static MonoMethod* GetMethod(MonoImage* image, const std::string& methodDesc);
 
 	static MonoMethod* sExceptionMethod = nullptr;
 	static MonoClass* sEntityClass = nullptr;
 
+	// Wrappers create these for every query result, so nothing is looked up by name after the core assembly is loaded
+	struct CoreTypeInfo
+	{
+		const char* Name;
+		const char* ConstructorDesc;
+		const char* ResetDesc;
+
+		MonoClass* Class = nullptr;
+		MonoMethod* Constructor = nullptr;
+		MonoMethod* Reset = nullptr;
+	};
+
+	// Indexed by ScriptCoreType
+	static std::array<CoreTypeInfo, (size_t)ScriptCoreType::Count> sCoreTypes = { {
+		{ "Entity", "NR.Entity:.ctor(ulong)", nullptr },
+		{ "Prefab", "NR.Prefab:.ctor(ulong)", nullptr },
+		{ "RaycastHit2D", "NR.RaycastHit2D:.ctor(ulong,Vector2,Vector2,single)", nullptr },
+		{ "Collider", nullptr, nullptr },
+		{ "BoxCollider", "NR.BoxCollider:.ctor(ulong,Vector3,Vector3,bool)", "NR.BoxCollider:Reset(ulong,Vector3,Vector3,bool)" },
+		{ "SphereCollider", "NR.SphereCollider:.ctor(ulong,single,bool)", "NR.SphereCollider:Reset(ulong,single,bool)" },
+		{ "CapsuleCollider", "NR.CapsuleCollider:.ctor(ulong,single,single,bool)", "NR.CapsuleCollider:Reset(ulong,single,single,bool)" },
+		{ "MeshCollider", "NR.MeshCollider:.ctor(ulong,bool,intptr,bool)", "NR.MeshCollider:Reset(ulong,bool,intptr,bool)" }
+	} };
+
+	// Objects query results are written into, owned by the engine. The ones handed out in a frame are reset and handed out again the next frame.
+	struct QueryResultPool
+	{
+		std::vector<uint32_t> Handles;
+		size_t Used = 0;
+	};
+	static std::array<QueryResultPool, (size_t)ScriptCoreType::Count> sQueryResultPools;
+
+	static void ReleaseQueryResults()
+	{
+		for (QueryResultPool& pool : sQueryResultPools)
+		{
+			for (uint32_t handle : pool.Handles)
+			{
+				mono_gchandle_free(handle);
+			}
+
+			pool.Handles.clear();
+			pool.Used = 0;
+		}
+	}
+
+#if defined(NR_PLATFORM_WINDOWS)
+	#define NR_MONO_THUNK __stdcall
+#else
+	#define NR_MONO_THUNK
+#endif
+
+	// Unmanaged thunks call the JIT compiled method directly, without mono_runtime_invoke boxing the arguments
+	using MonoInitThunk = void(NR_MONO_THUNK*)(MonoObject* instance, MonoObject** exception);
+	using MonoUpdateThunk = void(NR_MONO_THUNK*)(MonoObject* instance, float dt, MonoObject** exception);
+	using MonoContactEventsThunk = void(NR_MONO_THUNK*)(MonoObject* instance, MonoArray* otherIDs, MonoArray* contactTypes, MonoObject** exception);
+	using MonoCollision2DThunk = void(NR_MONO_THUNK*)(MonoObject* instance, uint64_t otherID, MonoObject** exception);
+
+	template<typename T>
+	static T GetThunk(MonoMethod* method)
+	{
+		return method ? (T)mono_method_get_unmanaged_thunk(method) : nullptr;
+	}
+
 	struct EntityScriptClass
 	{
 		std::string FullName;
@@ -50,14 +117,18 @@ namespace NR
 		MonoMethod* PhysicsUpdateMethod = nullptr;
 
 		// Physics
-		MonoMethod* CollisionBeginMethod = nullptr;
-		MonoMethod* CollisionEndMethod = nullptr;
-		MonoMethod* TriggerBeginMethod = nullptr;
-		MonoMethod* TriggerEndMethod = nullptr;
+		MonoMethod* ContactEventsMethod = nullptr;
 		MonoMethod* OnJointBreakMethod = nullptr;
 		MonoMethod* Collision2DBeginMethod = nullptr;
 		MonoMethod* Collision2DEndMethod = nullptr;
 
+		MonoInitThunk CreateThunk = nullptr;
+		MonoUpdateThunk UpdateThunk = nullptr;
+		MonoUpdateThunk PhysicsUpdateThunk = nullptr;
+		MonoContactEventsThunk ContactEventsThunk = nullptr;
+		MonoCollision2DThunk Collision2DBeginThunk = nullptr;
+		MonoCollision2DThunk Collision2DEndThunk = nullptr;
+
 		void InitClassMethods(MonoImage* image)
 		{
 			Constructor = GetMethod(sCoreAssemblyImage, "NR.Entity:.ctor(ulong)");
@@ -66,13 +137,17 @@ namespace NR
 			PhysicsUpdateMethod = GetMethod(image, FullName + ":FixedUpdate(single)");
 
 			// Physics (Entity class)
-			CollisionBeginMethod = GetMethod(sCoreAssemblyImage, "NR.Entity:CollisionBegin(ulong)");
-			CollisionEndMethod = GetMethod(sCoreAssemblyImage, "NR.Entity:CollisionEnd(ulong)");
-			TriggerBeginMethod = GetMethod(sCoreAssemblyImage, "NR.Entity:TriggerBegin(ulong)");
-			TriggerEndMethod = GetMethod(sCoreAssemblyImage, "NR.Entity:TriggerEnd(ulong)");			
+			ContactEventsMethod = GetMethod(sCoreAssemblyImage, "NR.Entity:ContactEvents(ulong[],int[])");
 			OnJointBreakMethod = GetMethod(sCoreAssemblyImage, "NR.Entity:JointBreak(Vector3,Vector3)");
 			Collision2DBeginMethod = GetMethod(sCoreAssemblyImage, "NR.Entity:Collision2DBegin(ulong)");
 			Collision2DEndMethod = GetMethod(sCoreAssemblyImage, "NR.Entity:Collision2DEnd(ulong)");
+
+			CreateThunk = GetThunk<MonoInitThunk>(CreateMethod);
+			UpdateThunk = GetThunk<MonoUpdateThunk>(UpdateMethod);
+			PhysicsUpdateThunk = GetThunk<MonoUpdateThunk>(PhysicsUpdateMethod);
+			ContactEventsThunk = GetThunk<MonoContactEventsThunk>(ContactEventsMethod);
+			Collision2DBeginThunk = GetThunk<MonoCollision2DThunk>(Collision2DBeginMethod);
+			Collision2DEndThunk = GetThunk<MonoCollision2DThunk>(Collision2DEndMethod);
 		}
 	};
 
@@ -234,24 +309,93 @@ namespace NR
 		return string != nullptr ? std::string(mono_string_to_utf8(string)) : "";
 	}
 
+	static void HandleException(MonoObject* exception)
+	{
+		MonoClass* exceptionClass = mono_object_get_class(exception);
+		MonoType* exceptionType = mono_class_get_type(exceptionClass);
+		const char* typeName = mono_type_get_name(exceptionType);
+		std::string message = GetStringProperty("Message", exceptionClass, exception);
+		std::string stackTrace = GetStringProperty("StackTrace", exceptionClass, exception);
+
+		NR_CONSOLE_LOG_ERROR("{0}: {1}. Stack Trace: {2}", typeName, message, stackTrace);
+
+		void* args[] = { exception };
+		mono_runtime_invoke(sExceptionMethod, nullptr, args, nullptr);
+	}
+
 	static MonoObject* CallMethod(MonoObject* object, MonoMethod* method, void** params = nullptr) noexcept
 	{
 		MonoObject* pException = nullptr;
 		MonoObject* result = mono_runtime_invoke(method, object, params, &pException);
 		if (pException)
 		{
-			MonoClass* exceptionClass = mono_object_get_class(pException);
-			MonoType* exceptionType = mono_class_get_type(exceptionClass);
-			const char* typeName = mono_type_get_name(exceptionType);
-			std::string message = GetStringProperty("Message", exceptionClass, pException);
-			std::string stackTrace = GetStringProperty("StackTrace", exceptionClass, pException);
+			HandleException(pException);
+		}
+		return result;
+	}
+
+	// Thunks report exceptions through their last argument, checking it is all a call costs when nothing is thrown
+	template<typename ThunkT, typename... Args>
+	static void CallThunk(ThunkT thunk, MonoObject* object, Args... args) noexcept
+	{
+		MonoObject* pException = nullptr;
+		thunk(object, args..., &pException);
+		if (pException)
+		{
+			HandleException(pException);
+		}
+	}
 
-			NR_CONSOLE_LOG_ERROR("{0}: {1}. Stack Trace: {2}", typeName, message, stackTrace);
+	// Instantiated scripts of each scene, packed so updating them doesn't look every entity up.
+	// Removed instances leave a null behind, the list is compacted before it is iterated next.
+	struct ActiveScriptInstances
+	{
+		std::vector<EntityInstance*> Instances;
+		bool HasRemovedInstances = false;
+	};
 
-			void* args[] = { pException };
-			MonoObject* result = mono_runtime_invoke(sExceptionMethod, nullptr, args, nullptr);
+	static std::unordered_map<UUID, ActiveScriptInstances> sActiveInstances;
+
+	static void AddActiveInstance(UUID sceneID, EntityInstance& instance)
+	{
+		if (instance.ActiveIndex != std::numeric_limits<uint32_t>::max())
+		{
+			return;
 		}
-		return result;
+
+		auto& activeInstances = sActiveInstances[sceneID];
+		instance.ActiveIndex = (uint32_t)activeInstances.Instances.size();
+		activeInstances.Instances.push_back(&instance);
+	}
+
+	static void RemoveActiveInstance(UUID sceneID, EntityInstance& instance)
+	{
+		if (instance.ActiveIndex == std::numeric_limits<uint32_t>::max())
+		{
+			return;
+		}
+
+		auto& activeInstances = sActiveInstances[sceneID];
+		activeInstances.Instances[instance.ActiveIndex] = nullptr;
+		activeInstances.HasRemovedInstances = true;
+		instance.ActiveIndex = std::numeric_limits<uint32_t>::max();
+	}
+
+	static void CompactActiveInstances(ActiveScriptInstances& activeInstances)
+	{
+		if (!activeInstances.HasRemovedInstances)
+		{
+			return;
+		}
+
+		auto& instances = activeInstances.Instances;
+		instances.erase(std::remove(instances.begin(), instances.end(), nullptr), instances.end());
+		for (uint32_t i = 0; i < instances.size(); ++i)
+		{
+			instances[i]->ActiveIndex = i;
+		}
+
+		activeInstances.HasRemovedInstances = false;
 	}
 
 	static void PrintClassMethods(MonoClass* monoClass)
@@ -298,6 +442,9 @@ namespace NR
 
 	bool ScriptEngine::LoadRuntimeAssembly(const std::string& path)
 	{
+		// Pooled objects belong to the domain that is about to be replaced
+		ReleaseQueryResults();
+
 		sCoreAssemblyPath = path;
 		if (sCurrentMonoDomain)
 		{
@@ -324,6 +471,17 @@ namespace NR
 		sExceptionMethod = GetMethod(sCoreAssemblyImage, "NR.RuntimeException:Exception(object)");
 		sEntityClass = mono_class_from_name(sCoreAssemblyImage, "NR", "Entity");
 
+		for (CoreTypeInfo& type : sCoreTypes)
+		{
+			type.Class = mono_class_from_name(sCoreAssemblyImage, "NR", type.Name);
+			type.Constructor = type.ConstructorDesc ? GetMethod(sCoreAssemblyImage, type.ConstructorDesc) : nullptr;
+			type.Reset = type.ResetDesc ? GetMethod(sCoreAssemblyImage, type.ResetDesc) : nullptr;
+			if (!type.Class)
+			{
+				NR_CORE_ERROR("[ScriptEngine] Core type NR.{0} not found", type.Name);
+			}
+		}
+
 		return true;
 	}
 
@@ -362,6 +520,7 @@ namespace NR
 
 		sAppAssembly = appAssembly;
 		sAppAssemblyImage = appAssemblyImage;
+		sModuleExistsCache.clear();
 		return true;
 	}
 
@@ -403,13 +562,17 @@ namespace NR
 
 	void ScriptEngine::Shutdown()
 	{
+		ReleaseQueryResults();
 		ShutdownMono();
 		sSceneContext = nullptr;
 		sEntityInstanceMap.clear();
+		sActiveInstances.clear();
 	}
 
 	void ScriptEngine::SceneDestruct(UUID sceneID)
 	{
+		sActiveInstances.erase(sceneID);
+
 		if (sEntityInstanceMap.find(sceneID) != sEntityInstanceMap.end())
 		{
 			sEntityInstanceMap.at(sceneID).clear();
@@ -424,6 +587,7 @@ namespace NR
 		if (!scene)
 		{
 			sEntityInstanceMap.clear();
+			sActiveInstances.clear();
 		}
 		sSceneContext = scene;
 	}
@@ -462,9 +626,9 @@ namespace NR
 		NR_PROFILE_FUNC();
 
 		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneID(), entity.GetID()).Instance;
-		if (entityInstance.ScriptClass->CreateMethod)
+		if (entityInstance.ScriptClass->CreateThunk)
 		{
-			CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->CreateMethod);
+			CallThunk(entityInstance.ScriptClass->CreateThunk, entityInstance.GetInstance());
 		}
 	}
 
@@ -473,93 +637,91 @@ namespace NR
 		NR_PROFILE_FUNC();
 		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneID(), entity.GetID()).Instance;
 		NR_PROFILE_SCOPE_DYNAMIC(entityInstance.ScriptClass->FullName.c_str());
-		if (entityInstance.ScriptClass->UpdateMethod)
+		if (entityInstance.ScriptClass->UpdateThunk)
 		{
-			void* args[] = { &dt };
-			CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->UpdateMethod, args);
+			CallThunk(entityInstance.ScriptClass->UpdateThunk, entityInstance.GetInstance(), dt);
 		}
 	}
 
-	void ScriptEngine::PhysicsUpdateEntity(Entity entity, float fixedTimeStep)
+	void ScriptEngine::UpdateEntities(UUID sceneID, float dt)
 	{
 		NR_PROFILE_FUNC();
-		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneID(), entity.GetID()).Instance;
-		if (entityInstance.ScriptClass->PhysicsUpdateMethod)
+
+		auto it = sActiveInstances.find(sceneID);
+		if (it == sActiveInstances.end())
 		{
-			void* args[] = { &fixedTimeStep };
-			CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->PhysicsUpdateMethod, args);
+			return;
 		}
-	}
 
-	void ScriptEngine::Collision2DBegin(Entity entity, Entity other)
-	{
-		NR_PROFILE_FUNC();
-		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneID(), entity.GetID()).Instance;
-		if (entityInstance.ScriptClass->Collision2DBeginMethod)
+		// Query results returned last frame can be handed out again
+		for (QueryResultPool& pool : sQueryResultPools)
 		{
-			UUID id = other.GetID();
-			void* args[] = { &id };
-			CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->Collision2DBeginMethod, args);
+			pool.Used = 0;
 		}
-	}
 
-	void ScriptEngine::Collision2DEnd(Entity entity, Entity other)
-	{
-		NR_PROFILE_FUNC();
-		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneID(), entity.GetID()).Instance;
-		if (entityInstance.ScriptClass->Collision2DEndMethod)
+		auto& activeInstances = it->second;
+		CompactActiveInstances(activeInstances);
+
+		// Scripts instantiated by an Update call are updated starting next frame
+		const size_t count = activeInstances.Instances.size();
+		for (size_t i = 0; i < count; ++i)
 		{
-			UUID id = other.GetID();
-			void* args[] = { &id };
-			CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->Collision2DEndMethod, args);
+			EntityInstance* entityInstance = activeInstances.Instances[i];
+			if (!entityInstance || !entityInstance->ScriptClass->UpdateThunk)
+			{
+				continue;
+			}
+
+			NR_PROFILE_SCOPE_DYNAMIC(entityInstance->ScriptClass->FullName.c_str());
+			CallThunk(entityInstance->ScriptClass->UpdateThunk, entityInstance->GetInstance(), dt);
 		}
 	}
 
-	void ScriptEngine::CollisionBegin(Entity entity, Entity other)
+	void ScriptEngine::PhysicsUpdateEntity(Entity entity, float fixedTimeStep)
 	{
 		NR_PROFILE_FUNC();
 		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneID(), entity.GetID()).Instance;
-		if (entityInstance.ScriptClass->CollisionBeginMethod)
+		if (entityInstance.ScriptClass->PhysicsUpdateThunk)
 		{
-			UUID id = other.GetID();
-			void* args[] = { &id };
-			CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->CollisionBeginMethod, args);
+			CallThunk(entityInstance.ScriptClass->PhysicsUpdateThunk, entityInstance.GetInstance(), fixedTimeStep);
 		}
 	}
 
-	void ScriptEngine::CollisionEnd(Entity entity, Entity other)
+	void ScriptEngine::Collision2DBegin(Entity entity, Entity other)
 	{
 		NR_PROFILE_FUNC();
 		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneID(), entity.GetID()).Instance;
-		if (entityInstance.ScriptClass->CollisionEndMethod)
+		if (entityInstance.ScriptClass->Collision2DBeginThunk)
 		{
-			UUID id = other.GetID();
-			void* args[] = { &id };
-			CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->CollisionEndMethod, args);
+			CallThunk(entityInstance.ScriptClass->Collision2DBeginThunk, entityInstance.GetInstance(), (uint64_t)other.GetID());
 		}
 	}
 
-	void ScriptEngine::TriggerBegin(Entity entity, Entity other)
+	void ScriptEngine::Collision2DEnd(Entity entity, Entity other)
 	{
 		NR_PROFILE_FUNC();
 		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneID(), entity.GetID()).Instance;
-		if (entityInstance.ScriptClass->TriggerBeginMethod)
+		if (entityInstance.ScriptClass->Collision2DEndThunk)
 		{
-			UUID id = other.GetID();
-			void* args[] = { &id };
-			CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->TriggerBeginMethod, args);
+			CallThunk(entityInstance.ScriptClass->Collision2DEndThunk, entityInstance.GetInstance(), (uint64_t)other.GetID());
 		}
 	}
 
-	void ScriptEngine::TriggerEnd(Entity entity, Entity other)
+	void ScriptEngine::ContactEvents(Entity entity, const std::vector<UUID>& others, const std::vector<ContactType>& types)
 	{
 		NR_PROFILE_FUNC();
 		EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneID(), entity.GetID()).Instance;
-		if (entityInstance.ScriptClass->TriggerEndMethod)
+		if (entityInstance.ScriptClass->ContactEventsThunk)
 		{
-			UUID id = other.GetID();
-			void* args[] = { &id };
-			CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->TriggerEndMethod, args);
+			MonoArray* otherIDs = mono_array_new(mono_domain_get(), mono_get_uint64_class(), others.size());
+			MonoArray* contactTypes = mono_array_new(mono_domain_get(), mono_get_int32_class(), types.size());
+			for (size_t i = 0; i < others.size(); ++i)
+			{
+				mono_array_set(otherIDs, uint64_t, i, others[i]);
+				mono_array_set(contactTypes, int32_t, i, (int32_t)types[i]);
+			}
+
+			CallThunk(entityInstance.ScriptClass->ContactEventsThunk, entityInstance.GetInstance(), otherIDs, contactTypes);
 		}
 	}
 
@@ -637,6 +799,48 @@ namespace NR
 		return monoClass;
 	}
 
+	MonoObject* ScriptEngine::Construct(ScriptCoreType type, void** parameters)
+	{
+		const CoreTypeInfo& info = sCoreTypes[(size_t)type];
+		NR_CORE_ASSERT(info.Class, "Core assembly isn't loaded");
+
+		MonoObject* obj = mono_object_new(mono_domain_get(), info.Class);
+		if (info.Constructor)
+		{
+			CallMethod(obj, info.Constructor, parameters);
+		}
+
+		return obj;
+	}
+
+	MonoObject* ScriptEngine::AcquireQueryResult(ScriptCoreType type, void** parameters)
+	{
+		const CoreTypeInfo& info = sCoreTypes[(size_t)type];
+		NR_CORE_ASSERT(info.Class, "Core assembly isn't loaded");
+		if (!info.Reset)
+		{
+			return Construct(type, parameters);
+		}
+
+		QueryResultPool& pool = sQueryResultPools[(size_t)type];
+		if (pool.Used < pool.Handles.size())
+		{
+			MonoObject* obj = mono_gchandle_get_target(pool.Handles[pool.Used++]);
+			CallMethod(obj, info.Reset, parameters);
+			return obj;
+		}
+
+		MonoObject* obj = Construct(type, parameters);
+		pool.Handles.push_back(mono_gchandle_new(obj, false));
+		++pool.Used;
+		return obj;
+	}
+
+	MonoClass* ScriptEngine::GetCoreClass(ScriptCoreType type)
+	{
+		return sCoreTypes[(size_t)type].Class;
+	}
+
 	bool ScriptEngine::IsEntityModuleValid(Entity entity)
 	{
 		return entity.HasComponent<ScriptComponent>() && ModuleExists(entity.GetComponent<ScriptComponent>().ModuleName);
@@ -648,9 +852,10 @@ namespace NR
 		{
 			auto& entityMap = sEntityInstanceMap.at(sceneID);
 
-			if (entityMap.find(entityID) != entityMap.end())
+			if (auto it = entityMap.find(entityID); it != entityMap.end())
 			{
-				entityMap.erase(entityID);
+				RemoveActiveInstance(sceneID, it->second.Instance);
+				entityMap.erase(it);
 			}
 		}
 	}
@@ -664,6 +869,11 @@ namespace NR
 			return false;
 		}
 
+		if (auto it = sModuleExistsCache.find(moduleName); it != sModuleExistsCache.end())
+		{
+			return it->second;
+		}
+
 		std::string NamespaceName, ClassName;
 		if (moduleName.find('.') != std::string::npos)
 		{
@@ -676,13 +886,10 @@ namespace NR
 		}
 
 		MonoClass* monoClass = mono_class_from_name(sAppAssemblyImage, NamespaceName.c_str(), ClassName.c_str());
-		if (!monoClass)
-		{
-			return false;
-		}
+		bool exists = monoClass && mono_class_is_subclass_of(monoClass, sEntityClass, 0);
 
-		auto isEntitySubclass = mono_class_is_subclass_of(monoClass, sEntityClass, 0);
-		return isEntitySubclass;
+		sModuleExistsCache[moduleName] = exists;
+		return exists;
 	}
 
 	std::string ScriptEngine::StripNamespace(const std::string& nameSpace, const std::string& moduleName)
@@ -894,6 +1101,8 @@ namespace NR
 			}
 		}
 
+		// The instance was only needed to read the field defaults
+		RemoveActiveInstance(scene->GetID(), entityInstance);
 		Destroy(entityInstance.Handle);
 	}
 
@@ -933,6 +1142,7 @@ namespace NR
 		EntityInstance& entityInstance = entityInstanceData.Instance;
 		NR_CORE_ASSERT(entityInstance.ScriptClass);
 		entityInstance.Handle = Instantiate(*entityInstance.ScriptClass);
+		AddActiveInstance(scene->GetID(), entityInstance);
 
 		void* param[] = { &id };
 		CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->Constructor, param);
@@ -1078,7 +1288,7 @@ namespace NR
 		{
 			// Create Managed Object
 			void* params[] = { mStoredValueBuffer };
-			MonoObject* obj = ScriptEngine::Construct(TypeName + ":.ctor(ulong)", true, params);
+			MonoObject* obj = ScriptEngine::Construct(Type == FieldType::Asset ? ScriptCoreType::Prefab : ScriptCoreType::Entity, params);
 			if (mMonoProperty)
 			{
 				void* data[] = { obj };
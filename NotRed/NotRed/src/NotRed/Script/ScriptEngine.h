@@ -6,6 +6,7 @@
 
 #include "NotRed/Scene/Components.h"
 #include "NotRed/Scene/Entity.h"
+#include "NotRed/Physics/3D/PhysicsTypes.h"
 
 #include "ScriptModuleField.h"
 
@@ -19,6 +20,21 @@ namespace NR
 {
 	struct EntityScriptClass;
 
+	// Core assembly types the engine creates objects of. Resolved once, when the core assembly is loaded.
+	enum class ScriptCoreType : uint32_t
+	{
+		Entity = 0,
+		Prefab,
+		RaycastHit2D,
+		Collider,
+		BoxCollider,
+		SphereCollider,
+		CapsuleCollider,
+		MeshCollider,
+
+		Count
+	};
+
 	struct EntityInstance
 	{
 		EntityScriptClass* ScriptClass = nullptr;
@@ -26,6 +42,9 @@ namespace NR
 		uint32_t Handle = 0;
 		Scene* SceneInstance = nullptr;
 
+		// Position in the scene's list of instantiated scripts
+		uint32_t ActiveIndex = std::numeric_limits<uint32_t>::max();
+
 		MonoObject* GetInstance();
 		bool IsRuntimeAvailable() const;
 	};
@@ -57,19 +76,25 @@ namespace NR
 
 		static void CreateEntity(Entity entity);
 		static void UpdateEntity(Entity entity, float dt);
+		// Updates every script instantiated in the scene, in the order they were instantiated
+		static void UpdateEntities(UUID sceneID, float dt);
 		static void PhysicsUpdateEntity(Entity entity, float fixedTimeStep);
 
 		static void Collision2DBegin(Entity entity, Entity other);
 		static void Collision2DEnd(Entity entity, Entity other);
-		static void CollisionBegin(Entity entity, Entity other);
-		static void CollisionEnd(Entity entity, Entity other);
-		static void TriggerBegin(Entity entity, Entity other);
-		static void TriggerEnd(Entity entity, Entity other);
+		// All of an entity's collision and trigger events from one physics step, in a single call
+		static void ContactEvents(Entity entity, const std::vector<UUID>& others, const std::vector<ContactType>& types);
 		static void JointBreak(Entity entity, const glm::vec3& linearForce, const glm::vec3& angularForce);
 
 		static MonoObject* Construct(const std::string& fullName, bool callConstructor = true, void** parameters = nullptr);
 		static MonoClass* GetCoreClass(const std::string& fullName);
 
+		static MonoObject* Construct(ScriptCoreType type, void** parameters = nullptr);
+		// Object of that type for a NonAlloc query result, owned by the engine. Objects handed out during a frame
+		// are reset with new results from the next frame on, scripts have to copy what they want to keep.
+		static MonoObject* AcquireQueryResult(ScriptCoreType type, void** parameters);
+		static MonoClass* GetCoreClass(ScriptCoreType type);
+
 		static bool IsEntityModuleValid(Entity entity);
 
 		static void ScriptComponentDestroyed(UUID sceneID, UUID entityID);
@@ -61,6 +61,7 @@ namespace NR
 		mono_add_internal_call("NR.Noise::PerlinNoise_Native", NR::Script::NR_Noise_PerlinNoise);
 
 		mono_add_internal_call("NR.Scene::GetEntities", NR::Script::NR_Scene_GetEntities);
+		mono_add_internal_call("NR.Scene::GetEntitiesInBox_Native", NR::Script::NR_Scene_GetEntitiesInBox);
 
 		mono_add_internal_call("NR.Physics::Raycast_Native", NR::Script::NR_Physics_Raycast);
 		mono_add_internal_call("NR.Physics::OverlapBox_Native", NR::Script::NR_Physics_OverlapBox);
@@ -102,6 +103,8 @@ namespace NR
 		mono_add_internal_call("NR.TransformComponent::SetScale_Native", NR::Script::NR_TransformComponent_SetScale);
 		mono_add_internal_call("NR.TransformComponent::GetWorldSpaceTransform_Native", NR::Script::NR_TransformComponent_GetWorldSpaceTransform);
 		mono_add_internal_call("NR.Transform::TransformMultiply_Native", NR::Script::NR_Transform_TransformMultiply);
+		mono_add_internal_call("NR.TransformView::Read_Native", NR::Script::NR_TransformView_Read);
+		mono_add_internal_call("NR.TransformView::Commit_Native", NR::Script::NR_TransformView_Commit);
 
 
 		mono_add_internal_call("NR.MeshComponent::GetMesh_Native", NR::Script::NR_MeshComponent_GetMesh);
@@ -155,6 +158,8 @@ namespace NR
 		mono_add_internal_call("NR.RigidBodyComponent::SetVelocity_Native", NR::Script::NR_RigidBodyComponent_SetVelocity);
 		mono_add_internal_call("NR.RigidBodyComponent::GetAngularVelocity_Native", NR::Script::NR_RigidBodyComponent_GetAngularVelocity);
 		mono_add_internal_call("NR.RigidBodyComponent::SetAngularVelocity_Native", NR::Script::NR_RigidBodyComponent_SetAngularVelocity);
+		mono_add_internal_call("NR.RigidBodyView::Read_Native", NR::Script::NR_RigidBodyView_Read);
+		mono_add_internal_call("NR.RigidBodyView::Commit_Native", NR::Script::NR_RigidBodyView_Commit);
 		mono_add_internal_call("NR.RigidBodyComponent::GetMaxVelocity_Native", NR::Script::NR_RigidBodyComponent_GetMaxVelocity);
 		mono_add_internal_call("NR.RigidBodyComponent::SetMaxVelocity_Native", NR::Script::NR_RigidBodyComponent_SetMaxVelocity);
 		mono_add_internal_call("NR.RigidBodyComponent::GetMaxAngularVelocity_Native", NR::Script::NR_RigidBodyComponent_GetMaxAngularVelocity);
@@ -50,6 +50,20 @@ namespace NR::Script
         return entityMap.at(entityID);
     };
 
+    // Bones of a runtime animation are only written when something asks for them
+    static inline TransformComponent& GetTransform(Entity entity)
+    {
+        ScriptEngine::GetCurrentSceneContext()->SyncBoneEntity(entity.GetID());
+        return entity.GetComponent<TransformComponent>();
+    }
+
+    // Same for writes, the entity's cached world transform and the ones of its children are rebuilt
+    static inline TransformComponent& EditTransform(Entity entity)
+    {
+        entity.MarkTransformDirty();
+        return GetTransform(entity);
+    }
+
     ////////////////////////////////////////////////////////////////
     // Math ////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////////
@@ -148,20 +162,40 @@ namespace NR::Script
         NR_CORE_ASSERT(scene, "No active scene!");
         const auto& entityMap = scene->GetEntityMap();
 
-        MonoArray* result = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass("NR.Entity"), entityMap.size());
+        MonoArray* result = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass(ScriptCoreType::Entity), entityMap.size());
 
         uint32_t index = 0;
         for (auto& [id, entity] : entityMap)
         {
             UUID uuid = id;
             void* data[] = { &uuid };
-            MonoObject* obj = ScriptEngine::Construct("NR.Entity:.ctor(ulong)", true, data);
+            MonoObject* obj = ScriptEngine::Construct(ScriptCoreType::Entity, data);
             mono_array_set(result, MonoObject*, index++, obj);
         }
 
         return result;
     }
 
+    MonoArray* NR_Scene_GetEntitiesInBox(glm::vec3* min, glm::vec3* max)
+    {
+        Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+        NR_CORE_ASSERT(scene, "No active scene!");
+
+        std::vector<Entity> entities;
+        scene->QueryEntities(AABB(*min, *max), entities);
+
+        MonoArray* result = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass(ScriptCoreType::Entity), entities.size());
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            UUID uuid = entities[i].GetID();
+            void* data[] = { &uuid };
+            MonoObject* obj = ScriptEngine::Construct(ScriptCoreType::Entity, data);
+            mono_array_set(result, MonoObject*, i, obj);
+        }
+
+        return result;
+    }
+
     bool NR_Physics_Raycast(RaycastData* inData, RaycastHit* hit)
     {
         Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
@@ -240,51 +274,56 @@ namespace NR::Script
 
         std::vector<Raycast2DResult> raycastResults = Physics2D::Raycast(scene, inData->Origin, inData->Origin + inData->Direction * inData->MaxDistance);
 
-        MonoArray* results = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass("NR.RaycastHit2D"), raycastResults.size());
+        MonoArray* results = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass(ScriptCoreType::RaycastHit2D), raycastResults.size());
         for (size_t i = 0; i < raycastResults.size(); i++)
         {
             UUID entityID = raycastResults[i].HitEntity.GetID();
-            void* data[] = {
-                &entityID
-            };
-
-            MonoObject* entity = ScriptEngine::Construct("NR.Entity:.ctor(ulong)", true, data);
-
             void* rcData[] = {
-                entity,
+                &entityID,
                 &raycastResults[i].Point,
                 &raycastResults[i].Normal,
                 &raycastResults[i].Distance
             };
 
-            MonoObject* obj = ScriptEngine::Construct("NR.RaycastHit2D:.ctor(Entity,Vector2,Vector2,single)", true, rcData);
+            MonoObject* obj = ScriptEngine::Construct(ScriptCoreType::RaycastHit2D, rcData);
             mono_array_set(results, MonoObject*, i, obj);
         }
 
         return results;
     }
 
-    // Helper function for the Overlap functions below
-    static void AddCollidersToArray(MonoArray* array, const std::array<OverlapHit, OVERLAP_MAX_COLLIDERS>& hits, uint32_t count, uint32_t arrayLength)
+    // The NonAlloc queries take their colliders from the engine's query result pool, the objects already in the array are left alone.
+    // The allocating queries return new colliders the script can keep.
+    static void SetColliderInArray(MonoArray* array, uint32_t index, ScriptCoreType type, void** data, bool pooled)
+    {
+        MonoObject* obj = pooled ? ScriptEngine::AcquireQueryResult(type, data) : ScriptEngine::Construct(type, data);
+        mono_array_set(array, MonoObject*, index, obj);
+    }
+
+    // Helper function for the Overlap functions below, returns the number of colliders written.
+    // Releases the hits, they would otherwise keep the actors alive until the next query.
+    static uint32_t AddCollidersToArray(MonoArray* array, std::array<OverlapHit, OVERLAP_MAX_COLLIDERS>& hits, uint32_t count, uint32_t arrayLength, bool pooled)
     {
         uint32_t arrayIndex = 0;
         for (uint32_t i = 0; i < count; i++)
         {
             Entity entity = hits[i].Actor->GetEntity();
+            hits[i] = {};
+
+            UUID entityID = entity.GetID();
 
             if (entity.HasComponent<BoxColliderComponent>() && arrayIndex < arrayLength)
             {
                 auto& boxCollider = entity.GetComponent<BoxColliderComponent>();
 
                 void* data[] = {
-                    &entity.GetID(),
-                    &boxCollider.IsTrigger,
+                    &entityID,
                     &boxCollider.Size,
-                    &boxCollider.Offset
+                    &boxCollider.Offset,
+                    &boxCollider.IsTrigger
                 };
 
-                MonoObject* obj = ScriptEngine::Construct("NR.BoxCollider:.ctor(ulong,bool,Vector3,Vector3)", true, data);
-                mono_array_set(array, MonoObject*, arrayIndex++, obj);
+                SetColliderInArray(array, arrayIndex++, ScriptCoreType::BoxCollider, data, pooled);
             }
 
             if (entity.HasComponent<SphereColliderComponent>() && arrayIndex < arrayLength)
@@ -292,13 +331,12 @@ namespace NR::Script
                 auto& sphereCollider = entity.GetComponent<SphereColliderComponent>();
 
                 void* data[] = {
-                    &entity.GetID(),
-                    &sphereCollider.IsTrigger,
-                    &sphereCollider.Radius
+                    &entityID,
+                    &sphereCollider.Radius,
+                    &sphereCollider.IsTrigger
                 };
 
-                MonoObject* obj = ScriptEngine::Construct("NR.SphereCollider:.ctor(ulong,bool,single)", true, data);
-                mono_array_set(array, MonoObject*, arrayIndex++, obj);
+                SetColliderInArray(array, arrayIndex++, ScriptCoreType::SphereCollider, data, pooled);
             }
 
             if (entity.HasComponent<CapsuleColliderComponent>() && arrayIndex < arrayLength)
@@ -306,31 +344,43 @@ namespace NR::Script
                 auto& capsuleCollider = entity.GetComponent<CapsuleColliderComponent>();
 
                 void* data[] = {
-                    &entity.GetID(),
-                    &capsuleCollider.IsTrigger,
+                    &entityID,
                     &capsuleCollider.Radius,
-                    &capsuleCollider.Height
+                    &capsuleCollider.Height,
+                    &capsuleCollider.IsTrigger
                 };
 
-                MonoObject* obj = ScriptEngine::Construct("NR.CapsuleCollider:.ctor(ulong,bool,single,single)", true, data);
-                mono_array_set(array, MonoObject*, arrayIndex++, obj);
+                SetColliderInArray(array, arrayIndex++, ScriptCoreType::CapsuleCollider, data, pooled);
             }
 
             if (entity.HasComponent<MeshColliderComponent>() && arrayIndex < arrayLength)
             {
                 auto& meshCollider = entity.GetComponent<MeshColliderComponent>();
 
-                Ref<Mesh>* mesh = new Ref<Mesh>(AssetManager::GetAsset<Mesh>(meshCollider.CollisionMesh));
+                // Owned by the managed Mesh, freed by its finalizer
+                void* mesh = nullptr;
+                bool isStatic = AssetManager::GetMetadata(meshCollider.CollisionMesh).Type == AssetType::StaticMesh;
+                if (isStatic)
+                {
+                    mesh = new Ref<StaticMesh>(AssetManager::GetAsset<StaticMesh>(meshCollider.CollisionMesh));
+                }
+                else
+                {
+                    mesh = new Ref<Mesh>(AssetManager::GetAsset<Mesh>(meshCollider.CollisionMesh));
+                }
+
                 void* data[] = {
-                    &entity.GetID(),
+                    &entityID,
                     &meshCollider.IsTrigger,
-                    &mesh
+                    &mesh,
+                    &isStatic
                 };
 
-                MonoObject* obj = ScriptEngine::Construct("NR.MeshHandleCollider:.ctor(ulong,bool,intptr)", true, data);
-                mono_array_set(array, MonoObject*, arrayIndex++, obj);
+                SetColliderInArray(array, arrayIndex++, ScriptCoreType::MeshCollider, data, pooled);
             }
         }
+
+        return arrayIndex;
     }
 
     static std::array<OverlapHit, OVERLAP_MAX_COLLIDERS> s_OverlapBuffer;
@@ -343,13 +393,11 @@ namespace NR::Script
         NR_CORE_ASSERT(scene->GetPhysicsScene()->IsValid());
 
         MonoArray* outColliders = nullptr;
-        memset(s_OverlapBuffer.data(), 0, OVERLAP_MAX_COLLIDERS * sizeof(OverlapHit));
-
-        uint32_t count;
+        uint32_t count = 0;
         if (scene->GetPhysicsScene()->OverlapBox(*origin, *halfSize, s_OverlapBuffer, count))
         {
-            outColliders = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass("NR.Collider"), count);
-            AddCollidersToArray(outColliders, s_OverlapBuffer, count, count);
+            outColliders = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass(ScriptCoreType::Collider), count);
+            AddCollidersToArray(outColliders, s_OverlapBuffer, count, count, false);
         }
 
         return outColliders;
@@ -362,13 +410,11 @@ namespace NR::Script
         NR_CORE_ASSERT(scene, "No active scene!");
 
         MonoArray* outColliders = nullptr;
-        memset(s_OverlapBuffer.data(), 0, OVERLAP_MAX_COLLIDERS * sizeof(OverlapHit));
-
-        uint32_t count;
+        uint32_t count = 0;
         if (scene->GetPhysicsScene()->OverlapCapsule(*origin, radius, halfHeight, s_OverlapBuffer, count))
         {
-            outColliders = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass("NR.Collider"), count);
-            AddCollidersToArray(outColliders, s_OverlapBuffer, count, count);
+            outColliders = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass(ScriptCoreType::Collider), count);
+            AddCollidersToArray(outColliders, s_OverlapBuffer, count, count, false);
         }
 
         return outColliders;
@@ -381,13 +427,11 @@ namespace NR::Script
         NR_CORE_ASSERT(scene, "No active scene!");
 
         MonoArray* outColliders = nullptr;
-        memset(s_OverlapBuffer.data(), 0, OVERLAP_MAX_COLLIDERS * sizeof(OverlapHit));
-
-        uint32_t count;
+        uint32_t count = 0;
         if (scene->GetPhysicsScene()->OverlapSphere(*origin, radius, s_OverlapBuffer, count))
         {
-            outColliders = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass("NR.Collider"), count);
-            AddCollidersToArray(outColliders, s_OverlapBuffer, count, count);
+            outColliders = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass(ScriptCoreType::Collider), count);
+            AddCollidersToArray(outColliders, s_OverlapBuffer, count, count, false);
         }
 
         return outColliders;
@@ -399,17 +443,12 @@ namespace NR::Script
         Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
         NR_CORE_ASSERT(scene, "No active scene!");
 
-        memset(s_OverlapBuffer.data(), 0, OVERLAP_MAX_COLLIDERS * sizeof(OverlapHit));
-
         const uint32_t arrayLength = (uint32_t)mono_array_length(outColliders);
 
-        uint32_t count;
+        uint32_t count = 0;
         if (scene->GetPhysicsScene()->OverlapBox(*origin, *halfSize, s_OverlapBuffer, count))
         {
-            if (count > arrayLength)
-                count = arrayLength;
-
-            AddCollidersToArray(outColliders, s_OverlapBuffer, count, arrayLength);
+            count = AddCollidersToArray(outColliders, s_OverlapBuffer, count, arrayLength, true);
         }
 
         return count;
@@ -421,16 +460,11 @@ namespace NR::Script
         Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
         NR_CORE_ASSERT(scene, "No active scene!");
 
-        memset(s_OverlapBuffer.data(), 0, OVERLAP_MAX_COLLIDERS * sizeof(OverlapHit));
-
         const uint32_t arrayLength = (uint32_t)mono_array_length(outColliders);
-        uint32_t count;
+        uint32_t count = 0;
         if (scene->GetPhysicsScene()->OverlapCapsule(*origin, radius, halfHeight, s_OverlapBuffer, count))
         {
-            if (count > arrayLength)
-                count = arrayLength;
-
-            AddCollidersToArray(outColliders, s_OverlapBuffer, count, arrayLength);
+            count = AddCollidersToArray(outColliders, s_OverlapBuffer, count, arrayLength, true);
         }
 
         return count;
@@ -442,17 +476,12 @@ namespace NR::Script
         Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
         NR_CORE_ASSERT(scene, "No active scene!");
 
-        memset(s_OverlapBuffer.data(), 0, OVERLAP_MAX_COLLIDERS * sizeof(OverlapHit));
-
         const uint32_t arrayLength = (uint32_t)mono_array_length(outColliders);
 
-        uint32_t count;
+        uint32_t count = 0;
         if (scene->GetPhysicsScene()->OverlapSphere(*origin, radius, s_OverlapBuffer, count))
         {
-            if (count > arrayLength)
-                count = arrayLength;
-
-            AddCollidersToArray(outColliders, s_OverlapBuffer, count, arrayLength);
+            count = AddCollidersToArray(outColliders, s_OverlapBuffer, count, arrayLength, true);
         }
 
         return count;
@@ -502,7 +531,7 @@ namespace NR::Script
     {
         auto entity = GetEntity(entityID);
         const auto& children = entity.Children();
-        MonoArray* result = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass("NR.Entity"), children.size());
+        MonoArray* result = mono_array_new(mono_domain_get(), ScriptEngine::GetCoreClass(ScriptCoreType::Entity), children.size());
 
         uint32_t index = 0;
         for (auto child : children)
@@ -515,7 +544,7 @@ namespace NR::Script
                 &child
             };
 
-            MonoObject* obj = ScriptEngine::Construct("NR.Entity:.ctor(ulong)", true, data);
+            MonoObject* obj = ScriptEngine::Construct(ScriptCoreType::Entity, data);
             mono_array_set(result, MonoObject*, index++, obj);
         }
 
@@ -615,25 +644,25 @@ namespace NR::Script
     void NR_TransformComponent_GetTransform(uint64_t entityID, TransformComponent* outTransform)
     {
         auto entity = GetEntity(entityID);
-        *outTransform = entity.GetComponent<TransformComponent>();
+        *outTransform = GetTransform(entity);
     }
 
     void NR_TransformComponent_SetTransform(uint64_t entityID, TransformComponent* inTransform)
     {
         auto entity = GetEntity(entityID);
-        entity.GetComponent<TransformComponent>() = *inTransform;
+        EditTransform(entity) = *inTransform;
     }
 
     void NR_TransformComponent_GetPosition(uint64_t entityID, glm::vec3* outPosition)
     {
         auto entity = GetEntity(entityID);
-        *outPosition = entity.GetComponent<TransformComponent>().Translation;
+        *outPosition = GetTransform(entity).Translation;
     }
 
     void NR_TransformComponent_SetPosition(uint64_t entityID, glm::vec3* inPosition)
     {
         auto entity = GetEntity(entityID);
-        entity.GetComponent<TransformComponent>().Translation = *inPosition;
+        EditTransform(entity).Translation = *inPosition;
 
         if (entity.HasComponent<RigidBodyComponent>())
         {
@@ -646,13 +675,13 @@ namespace NR::Script
     void NR_TransformComponent_GetRotation(uint64_t entityID, glm::vec3* outRotation)
     {
         auto entity = GetEntity(entityID);
-        *outRotation = entity.GetComponent<TransformComponent>().Rotation;
+        *outRotation = GetTransform(entity).Rotation;
     }
 
     void NR_TransformComponent_SetRotation(uint64_t entityID, glm::vec3* inRotation)
     {
         auto entity = GetEntity(entityID);
-        entity.GetComponent<TransformComponent>().Rotation = *inRotation;
+        EditTransform(entity).Rotation = *inRotation;
 
         if (entity.HasComponent<RigidBodyComponent>())
         {
@@ -665,19 +694,20 @@ namespace NR::Script
     void NR_TransformComponent_GetScale(uint64_t entityID, glm::vec3* outScale)
     {
         auto entity = GetEntity(entityID);
-        *outScale = entity.GetComponent<TransformComponent>().Scale;
+        *outScale = GetTransform(entity).Scale;
     }
 
     void NR_TransformComponent_SetScale(uint64_t entityID, glm::vec3* inScale)
     {
         auto entity = GetEntity(entityID);
-        entity.GetComponent<TransformComponent>().Scale = *inScale;
+        EditTransform(entity).Scale = *inScale;
     }
 
     void NR_TransformComponent_GetWorldSpaceTransform(uint64_t entityID, TransformComponent* outTransform)
     {
         auto entity = GetEntity(entityID);
         Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+        scene->SyncBoneEntity(entityID);
         *outTransform = scene->GetWorldSpaceTransform(entity);
     }
 
@@ -687,6 +717,84 @@ namespace NR::Script
         Math::DecomposeTransform(result, outTransform->Translation, outTransform->Rotation, outTransform->Scale);
     }
 
+    // The views below pass whole arrays across, one call per batch of entities instead of one per entity and field.
+    // Entities that don't exist (anymore) are skipped, their array elements are left as they are.
+    int32_t NR_TransformView_Read(MonoArray* entityIDs, MonoArray* outTransforms)
+    {
+        NR_PROFILE_FUNC();
+        Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+        NR_CORE_ASSERT(scene, "No active scene!");
+
+        const uintptr_t count = std::min(mono_array_length(entityIDs), mono_array_length(outTransforms));
+        const uint64_t* ids = mono_array_addr(entityIDs, uint64_t, 0);
+        TransformComponent* transforms = mono_array_addr(outTransforms, TransformComponent, 0);
+
+        int32_t readCount = 0;
+        for (uintptr_t i = 0; i < count; ++i)
+        {
+            Entity entity = scene->FindEntityByID(ids[i]);
+            if (!entity)
+            {
+                continue;
+            }
+
+            scene->SyncBoneEntity(ids[i]);
+
+            transforms[i] = entity.Transform();
+            ++readCount;
+        }
+
+        return readCount;
+    }
+
+    int32_t NR_TransformView_Commit(MonoArray* entityIDs, MonoArray* inTransforms)
+    {
+        NR_PROFILE_FUNC();
+        Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+        NR_CORE_ASSERT(scene, "No active scene!");
+        Ref<PhysicsScene> physicsScene = scene->GetPhysicsScene();
+
+        const uintptr_t count = std::min(mono_array_length(entityIDs), mono_array_length(inTransforms));
+        const uint64_t* ids = mono_array_addr(entityIDs, uint64_t, 0);
+        const TransformComponent* transforms = mono_array_addr(inTransforms, TransformComponent, 0);
+
+        int32_t writeCount = 0;
+        for (uintptr_t i = 0; i < count; ++i)
+        {
+            Entity entity = scene->FindEntityByID(ids[i]);
+            if (!entity)
+            {
+                continue;
+            }
+
+            scene->SyncBoneEntity(ids[i]);
+
+            TransformComponent& transform = entity.Transform();
+            const TransformComponent& inTransform = transforms[i];
+
+            // Same as setting Translation and Rotation one by one, the body has to be moved as well.
+            // Only done for the ones that changed, teleporting a body resets its interpolation.
+            if (entity.HasComponent<RigidBodyComponent>())
+            {
+                Ref<PhysicsActor> actor = physicsScene->GetActor(entity);
+                if (actor && transform.Translation != inTransform.Translation)
+                {
+                    actor->SetPosition(inTransform.Translation);
+                }
+                if (actor && transform.Rotation != inTransform.Rotation)
+                {
+                    actor->SetRotation(inTransform.Rotation);
+                }
+            }
+
+            transform = inTransform;
+            entity.MarkTransformDirty();
+            ++writeCount;
+        }
+
+        return writeCount;
+    }
+
     void* NR_MeshComponent_GetMesh(uint64_t entityID, bool* outIsStatic)
     {
         auto entity = GetEntity(entityID);
@@ -783,37 +891,46 @@ namespace NR::Script
         return AssetManager::IsAssetHandleValid(meshComponent.MeshHandle) && AssetManager::GetAsset<Mesh>(meshComponent.MeshHandle)->IsRigged();
     }
 
+    // Playback state is per entity, the controller asset is shared by every entity playing it
+    static AnimationInstance* GetAnimationInstance(AnimationComponent& animationComponent)
+    {
+        if (!AssetManager::IsAssetHandleValid(animationComponent.AnimationController))
+        {
+            return nullptr;
+        }
+
+        auto animationController = AssetManager::GetAsset<AnimationController>(animationComponent.AnimationController);
+        return animationComponent.Instance.Acquire(animationController, animationComponent.AnimationTime);
+    }
+
     bool NR_AnimationComponent_GetIsAnimationPlaying(uint64_t entityID)
     {
         auto entity = GetEntity(entityID);
         auto& animationComponent = entity.GetComponent<AnimationComponent>();
-        return AssetManager::IsAssetHandleValid(animationComponent.AnimationController) && AssetManager::GetAsset<AnimationController>(animationComponent.AnimationController)->IsAnimationPlaying();
+        return AssetManager::IsAssetHandleValid(animationComponent.AnimationController) && animationComponent.EnableAnimation;
     }
 
     void NR_AnimationComponent_SetIsAnimationPlaying(uint64_t entityID, bool value)
     {
         auto entity = GetEntity(entityID);
         auto& animationComponent = entity.GetComponent<AnimationComponent>();
-        if (AssetManager::IsAssetHandleValid(animationComponent.AnimationController))
-        {
-            AssetManager::GetAsset<AnimationController>(animationComponent.AnimationController)->SetAnimationPlaying(value);
-        }
+        animationComponent.EnableAnimation = value;
     }
 
     uint32_t NR_AnimationComponent_GetStateIndex(uint64_t entityID)
     {
         auto entity = GetEntity(entityID);
-        auto& animationComponent = entity.GetComponent<AnimationComponent>();
-        return AssetManager::IsAssetHandleValid(animationComponent.AnimationController) ? AssetManager::GetAsset<AnimationController>(animationComponent.AnimationController)->GetStateIndex() : 0;
+        AnimationInstance* animationInstance = GetAnimationInstance(entity.GetComponent<AnimationComponent>());
+        return animationInstance ? animationInstance->GetStateIndex() : 0;
     }
 
     void NR_AnimationComponent_SetStateIndex(uint64_t entityID, uint32_t value)
     {
         auto entity = GetEntity(entityID);
-        auto& animationComponent = entity.GetComponent<AnimationComponent>();
-        if (AssetManager::IsAssetHandleValid(animationComponent.AnimationController))
+        AnimationInstance* animationInstance = GetAnimationInstance(entity.GetComponent<AnimationComponent>());
+        if (animationInstance)
         {
-            AssetManager::GetAsset<AnimationController>(animationComponent.AnimationController)->SetStateIndex(value);
+            animationInstance->SetStateIndex(value);
         }
     }
 
@@ -836,9 +953,9 @@ namespace NR::Script
         auto entity = GetEntity(entityID);
         auto& animationComponent = entity.GetComponent<AnimationComponent>();
 
-        if (AssetManager::IsAssetHandleValid(animationComponent.AnimationController))
+        if (AnimationInstance* animationInstance = GetAnimationInstance(animationComponent))
         {
-            const auto& rootMotion = AssetManager::GetAsset<AnimationController>(animationComponent.AnimationController)->GetRootMotion();
+            const auto& rootMotion = animationInstance->GetRootMotion();
             outTransform->Translation = rootMotion.Translation;
             outTransform->Rotation = { 0.0f, acos(rootMotion.Rotation.w * 2.0), 0.0f };
         }
@@ -1227,6 +1344,80 @@ namespace NR::Script
         actor->SetAngularVelocity(*inVelocity);
     }
 
+    // Static and kinematic bodies have no velocity, like entities without a body they are skipped
+    static Ref<PhysicsActor> GetDynamicActor(Scene* scene, uint64_t entityID)
+    {
+        Entity entity = scene->FindEntityByID(entityID);
+        if (!entity || !entity.HasComponent<RigidBodyComponent>())
+        {
+            return nullptr;
+        }
+
+        Ref<PhysicsActor> actor = scene->GetPhysicsScene()->GetActor(entity);
+        if (!actor || !actor->IsDynamic() || actor->IsKinematic())
+        {
+            return nullptr;
+        }
+
+        return actor;
+    }
+
+    int32_t NR_RigidBodyView_Read(MonoArray* entityIDs, MonoArray* outLinearVelocities, MonoArray* outAngularVelocities)
+    {
+        NR_PROFILE_FUNC();
+        Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+        NR_CORE_ASSERT(scene, "No active scene!");
+
+        const uintptr_t count = std::min({ mono_array_length(entityIDs), mono_array_length(outLinearVelocities), mono_array_length(outAngularVelocities) });
+        const uint64_t* ids = mono_array_addr(entityIDs, uint64_t, 0);
+        glm::vec3* linearVelocities = mono_array_addr(outLinearVelocities, glm::vec3, 0);
+        glm::vec3* angularVelocities = mono_array_addr(outAngularVelocities, glm::vec3, 0);
+
+        int32_t readCount = 0;
+        for (uintptr_t i = 0; i < count; ++i)
+        {
+            Ref<PhysicsActor> actor = GetDynamicActor(scene.Raw(), ids[i]);
+            if (!actor)
+            {
+                continue;
+            }
+
+            linearVelocities[i] = actor->GetVelocity();
+            angularVelocities[i] = actor->GetAngularVelocity();
+            ++readCount;
+        }
+
+        return readCount;
+    }
+
+    int32_t NR_RigidBodyView_Commit(MonoArray* entityIDs, MonoArray* inLinearVelocities, MonoArray* inAngularVelocities)
+    {
+        NR_PROFILE_FUNC();
+        Ref<Scene> scene = ScriptEngine::GetCurrentSceneContext();
+        NR_CORE_ASSERT(scene, "No active scene!");
+
+        const uintptr_t count = std::min({ mono_array_length(entityIDs), mono_array_length(inLinearVelocities), mono_array_length(inAngularVelocities) });
+        const uint64_t* ids = mono_array_addr(entityIDs, uint64_t, 0);
+        const glm::vec3* linearVelocities = mono_array_addr(inLinearVelocities, glm::vec3, 0);
+        const glm::vec3* angularVelocities = mono_array_addr(inAngularVelocities, glm::vec3, 0);
+
+        int32_t writeCount = 0;
+        for (uintptr_t i = 0; i < count; ++i)
+        {
+            Ref<PhysicsActor> actor = GetDynamicActor(scene.Raw(), ids[i]);
+            if (!actor)
+            {
+                continue;
+            }
+
+            actor->SetVelocity(linearVelocities[i]);
+            actor->SetAngularVelocity(angularVelocities[i]);
+            ++writeCount;
+        }
+
+        return writeCount;
+    }
+
     float NR_RigidBodyComponent_GetMaxVelocity(uint64_t entityID)
     {
         auto entity = GetEntity(entityID);
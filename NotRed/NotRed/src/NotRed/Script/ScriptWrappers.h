@@ -38,6 +38,7 @@ namespace NR::Script
 
 		// Scene
 		MonoArray* NR_Scene_GetEntities();
+		MonoArray* NR_Scene_GetEntitiesInBox(glm::vec3* min, glm::vec3* max);
 
 		// Physics
 		struct RaycastData
@@ -99,6 +100,9 @@ namespace NR::Script
 		void NR_TransformComponent_GetWorldSpaceTransform(uint64_t entityID, TransformComponent* outTransform);
 		void NR_Transform_TransformMultiply(const TransformComponent* a, const TransformComponent* b, TransformComponent* outTransform);
 
+		int32_t NR_TransformView_Read(MonoArray* entityIDs, MonoArray* outTransforms);
+		int32_t NR_TransformView_Commit(MonoArray* entityIDs, MonoArray* inTransforms);
+
 		void* NR_MeshComponent_GetMesh(uint64_t entityID, bool* outIsStatic);
 		void NR_MeshComponent_SetMesh(uint64_t entityID, void* in, bool inIsStatic);
 		bool NR_MeshComponent_HasMaterial(uint64_t entityID, int index);
@@ -150,6 +154,8 @@ namespace NR::Script
 		void NR_RigidBodyComponent_SetVelocity(uint64_t entityID, glm::vec3* inVelocity);
 		void NR_RigidBodyComponent_GetAngularVelocity(uint64_t entityID, glm::vec3* outVelocity);
 		void NR_RigidBodyComponent_SetAngularVelocity(uint64_t entityID, glm::vec3* inVelocity);
+		int32_t NR_RigidBodyView_Read(MonoArray* entityIDs, MonoArray* outLinearVelocities, MonoArray* outAngularVelocities);
+		int32_t NR_RigidBodyView_Commit(MonoArray* entityIDs, MonoArray* inLinearVelocities, MonoArray* inAngularVelocities);
 		float NR_RigidBodyComponent_GetMaxVelocity(uint64_t entityID);
 		void NR_RigidBodyComponent_SetMaxVelocity(uint64_t entityID, float maxVelocity);
 		float NR_RigidBodyComponent_GetMaxAngularVelocity(uint64_t entityID);
@@ -70,4 +70,27 @@ namespace NR
 	private:
 		static FileSystemChangedCallbackFn sCallback;
 	};
+
+	// Read only view of a whole file mapped into memory, its pages are only read once they are touched
+	class MappedFile
+	{
+	public:
+		explicit MappedFile(const std::filesystem::path& filepath);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Empty files can't be mapped and aren't valid either
+		bool IsValid() const { return mData != nullptr; }
+
+		const byte* GetData() const { return mData; }
+		uint64_t GetSize() const { return mSize; }
+
+	private:
+		void* mFile = nullptr;
+		void* mMapping = nullptr;
+		const byte* mData = nullptr;
+		uint64_t mSize = 0;
+	};
 }
\ No newline at end of file
@@ -507,4 +507,135 @@ project "Not-Runtime"
 			'{COPY} "../NotRed/vendor/assimp/bin/Release/assimp-vc143-mtd.dll" "%{cfg.targetdir}"',
 			'{COPY} "../NotRed/vendor/mono/bin/Debug/mono-2.0-sgen.dll" "%{cfg.targetdir}"'
 		}
+
+group "Tests"
+project "Not-TestScripts"
+	location "Not-Tests/Scripts"
+	kind "SharedLib"
+	language "C#"
+
+	targetdir ("NotEditor/Resources/Scripts")
+	objdir ("NotEditor/Resources/Scripts/Intermediates")
+
+	files 
+	{
+		"Not-Tests/Scripts/Source/**.cs", 
+	}
+
+	links
+	{
+		"Not-ScriptCore"
+	}
+
+project "Not-Tests"
+	location "Not-Tests"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "off"
+	
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+	links 
+	{ 
+		"NotRed"
+	}
+
+	dependson
+	{
+		"Not-TestScripts"
+	}
+	
+	files 
+	{ 
+		"%{prj.name}/src/**.h", 
+		"%{prj.name}/src/**.cpp" 
+	}
+
+	-- The engine builds glm with [0, 1] clip space depth in its pch, the tests include glm without it
+	defines
+	{
+		"GLM_FORCE_DEPTH_ZERO_TO_ONE"
+	}
+	
+	includedirs 
+	{
+		"%{prj.name}/src",
+		"NotRed/src",
+		"NotRed/vendor",
+		"%{IncludeDir.Choc}",
+		"%{IncludeDir.Entt}",
+		"%{IncludeDir.Glm}",
+		"%{IncludeDir.ImGui}",
+		"%{IncludeDir.ImGuiNodeEditor}",
+		"%{IncludeDir.Vulkan}",
+		"%{IncludeDir.MiniAudio}",
+		"%{IncludeDir.Farbot}",
+		"%{IncludeDir.Optick}",
+		"%{IncludeDir.Yaml}",
+		"%{IncludeDir.PhysX}",
+		"%{IncludeDir.Mono}",
+		"%{IncludeDir.Ozz}"
+	}
+	postbuildcommands 
+	{
+		'{COPY} "../NotRed/vendor/NsightAftermath/lib/GFSDK_Aftermath_Lib.x64.dll" "%{cfg.targetdir}"',
+		'{COPY} "../NotRed/vendor/PhysX/win64/PhysX_64.dll" "%{cfg.targetdir}"',
+		'{COPY} "../vendor/bin/SOUL_PatchLoader.dll" "%{cfg.targetdir}"',
+		'{COPY} "../NotRed/vendor/PhysX/win64/PhysXCommon_64.dll" "%{cfg.targetdir}"',
+		'{COPY} "../NotRed/vendor/PhysX/win64/PhysXCooking_64.dll" "%{cfg.targetdir}"',
+		'{COPY} "../NotRed/vendor/PhysX/win64/PhysXFoundation_64.dll" "%{cfg.targetdir}"'
+	}
+	
+	filter "system:windows"
+		systemversion "latest"
+				
+		defines 
+		{ 
+			"NR_PLATFORM_WINDOWS"
+		}
+	
+	filter "configurations:Debug"
+		defines "NR_DEBUG"
+		symbols "on"
+		links
+		{
+			"NotRed/vendor/assimp/bin/Debug/assimp-vc143-mtd.lib"
+		}
+		postbuildcommands 
+		{
+			'{COPY} "../NotRed/vendor/assimp/bin/Debug/assimp-vc143-mtd.dll" "%{cfg.targetdir}"',
+			'{COPY} "../NotRed/vendor/mono/bin/Debug/mono-2.0-sgen.dll" "%{cfg.targetdir}"',
+			'{COPY} "../NotRed/vendor/Vulkan/win64/shaderc_sharedd.dll" "%{cfg.targetdir}"'
+		}
+				
+	filter "configurations:Release"
+		defines
+		{
+			"NR_RELEASE",
+			"NDEBUG"
+		}
+		optimize "on"
+		links
+		{
+			"NotRed/vendor/assimp/bin/Release/assimp-vc143-mt.lib"
+		}
+		postbuildcommands 
+		{
+			'{COPY} "../NotRed/vendor/assimp/bin/Release/assimp-vc143-mt.dll" "%{cfg.targetdir}"',
+			'{COPY} "../NotRed/vendor/mono/bin/Release/mono-2.0-sgen.dll" "%{cfg.targetdir}"'
+		}
+
+	filter "configurations:Dist"
+		defines "NR_DIST"
+		optimize "on"
+		links
+		{
+			"NotRed/vendor/assimp/bin/Release/assimp-vc143-mt.lib"
+		}
+		postbuildcommands 
+		{
+			'{COPY} "../NotRed/vendor/assimp/bin/Release/assimp-vc143-mt.dll" "%{cfg.targetdir}"',
+			'{COPY} "../NotRed/vendor/mono/bin/Release/mono-2.0-sgen.dll" "%{cfg.targetdir}"'
+		}
 group ""
\ No newline at end of file